@@ -330,6 +330,50 @@ bool ProcessMemoryProvider::read(uint64_t addr, void* buf, int len) const
     return nread == static_cast<ssize_t>(len);
 }
 
+void ProcessMemoryProvider::readBatch(QVector<rcx::ReadSpan>& spans) const
+{
+    // One process_vm_readv per IOV_MAX spans. The kernel stops at the first
+    // remote iovec it can't read and returns the bytes transferred so far,
+    // so walk the spans to see how far it got, retry the failing span alone
+    // through read() (which has the /proc/<pid>/mem fallback), and resume
+    // the vectored call right after it.
+    constexpr int kMaxIov = 1024;   // UIO_MAXIOV
+    struct iovec local[kMaxIov];
+    struct iovec remote[kMaxIov];
+
+    int i = 0;
+    while (i < spans.size()) {
+        int idx[kMaxIov];
+        int n = 0;
+        int j = i;
+        for (; j < spans.size() && n < kMaxIov; ++j) {
+            rcx::ReadSpan& s = spans[j];
+            s.ok = false;
+            if (m_fd < 0 || s.len <= 0) continue;
+            local[n].iov_base  = s.buf;
+            local[n].iov_len   = static_cast<size_t>(s.len);
+            remote[n].iov_base = reinterpret_cast<void*>(s.addr);
+            remote[n].iov_len  = static_cast<size_t>(s.len);
+            idx[n++] = j;
+        }
+        if (n == 0) { i = j; continue; }
+
+        ssize_t nread = process_vm_readv(m_pid, local, n, remote, n, 0);
+        size_t left = nread > 0 ? static_cast<size_t>(nread) : 0;
+        int k = 0;
+        for (; k < n; ++k) {
+            if (left < local[k].iov_len) break;
+            left -= local[k].iov_len;
+            spans[idx[k]].ok = true;
+        }
+        if (k == n) { i = j; continue; }
+
+        rcx::ReadSpan& bad = spans[idx[k]];
+        bad.ok = read(bad.addr, bad.buf, bad.len);
+        i = idx[k] + 1;
+    }
+}
+
 bool ProcessMemoryProvider::write(uint64_t addr, const void* buf, int len)
 {
     if (m_fd < 0 || !m_writable || len <= 0) return false;
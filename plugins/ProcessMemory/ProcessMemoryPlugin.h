@@ -19,6 +19,9 @@ public:
     int size() const override;
 
     // Optional overrides
+#ifdef __linux__
+    void readBatch(QVector<rcx::ReadSpan>& spans) const override;
+#endif
     bool write(uint64_t addr, const void* buf, int len) override;
     bool isWritable() const override { return m_writable; }
     QString name() const override { return m_processName; }
@@ -192,6 +192,63 @@ struct IpcClient {
         return true;
     }
 
+    /* Multi-range read.  Packs up to RCX_RPC_MAX_BATCH entries per
+       round-trip (spans larger than the data region are split) and loops
+       until every span is served.  The payload zero-fills unreadable
+       entries and only flags the request as PARTIAL, so under PARTIAL a
+       span whose returned bytes are all zero is reported !ok -- callers
+       treat that as "retry finer", which is harmless for memory that
+       genuinely reads as zero. */
+    bool readBatch(QVector<rcx::ReadSpan>& spans)
+    {
+        QMutexLocker lock(&mutex);
+        const uint32_t count = (uint32_t)spans.size();
+        QVector<uint64_t> addrs(spans.size());
+        QVector<uint32_t> lens(spans.size());
+        for (uint32_t i = 0; i < count; ++i) {
+            spans[i].ok = connected && spans[i].len > 0;
+            addrs[i]    = spans[i].addr;
+            lens[i]     = spans[i].ok ? (uint32_t)spans[i].len : 0;
+        }
+        if (!connected) return false;
+
+        auto* hdr  = static_cast<RcxRpcHeader*>(mappedView);
+        auto* data = static_cast<uint8_t*>(mappedView) + RCX_RPC_DATA_OFFSET;
+
+        uint32_t entrySpan[RCX_RPC_MAX_BATCH];
+        uint32_t span = 0, offset = 0;
+        while (uint32_t n = rcx_rpc_pack_read_batch(data, addrs.constData(),
+                                                    lens.constData(), count,
+                                                    &span, &offset, entrySpan)) {
+            hdr->command      = RPC_CMD_READ_BATCH;
+            hdr->requestCount = n;
+            hdr->status       = RCX_RPC_STATUS_OK;
+
+            if (!signalAndWait()) {
+                connected = false;
+                for (uint32_t i = entrySpan[0]; i < count; ++i)
+                    spans[i].ok = false;
+                return false;
+            }
+
+            bool partial  = (hdr->status == RCX_RPC_STATUS_PARTIAL);
+            auto* entries = reinterpret_cast<const RcxRpcReadEntry*>(data);
+            for (uint32_t k = 0; k < n; ++k) {
+                rcx::ReadSpan& s = spans[entrySpan[k]];
+                const uint8_t* src = data + entries[k].dataOffset;
+                uint32_t len = entries[k].length;
+                memcpy(static_cast<uint8_t*>(s.buf) + (entries[k].address - s.addr),
+                       src, len);
+                if (partial && s.ok) {
+                    uint32_t j = 0;
+                    while (j < len && src[j] == 0) ++j;
+                    if (j == len) s.ok = false;
+                }
+            }
+        }
+        return true;
+    }
+
     bool writeSingle(uint64_t addr, const void* buf, int len)
     {
         QMutexLocker lock(&mutex);
@@ -315,6 +372,16 @@ bool RemoteProcessProvider::read(uint64_t addr, void* buf, int len) const
     return ok;
 }
 
+void RemoteProcessProvider::readBatch(QVector<rcx::ReadSpan>& spans) const
+{
+    if (!m_connected) {
+        for (rcx::ReadSpan& s : spans) s.ok = false;
+        return;
+    }
+    if (!m_ipc->readBatch(spans))
+        const_cast<RemoteProcessProvider*>(this)->m_connected = m_ipc->connected;
+}
+
 int RemoteProcessProvider::size() const
 {
     return m_connected ? 0x10000 : 0;
@@ -25,6 +25,9 @@ public:
     bool read(uint64_t addr, void* buf, int len) const override;
     int  size() const override;
 
+    /* batched: one RPC round-trip per RCX_RPC_MAX_BATCH entries */
+    void readBatch(QVector<rcx::ReadSpan>& spans) const override;
+
     /* optional */
     bool     write(uint64_t addr, const void* buf, int len) override;
     bool     isWritable() const override { return m_connected; }
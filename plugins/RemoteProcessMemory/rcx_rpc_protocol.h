@@ -84,6 +84,54 @@ struct RcxRpcHeader {
     uint8_t  _pad[RCX_RPC_HEADER_SIZE - 52];
 };
 
+/* ── batch read packing ────────────────────────────────────────────── */
+
+/*
+ * A READ_BATCH request keeps its entry table at the start of the data
+ * region, sized for RCX_RPC_MAX_BATCH entries; response bytes follow it.
+ */
+#define RCX_RPC_BATCH_TABLE_SIZE  (RCX_RPC_MAX_BATCH * sizeof(struct RcxRpcReadEntry))
+
+/*
+ * Lay out one READ_BATCH request covering spans [*span, count), resuming
+ * *offset bytes into the first one.  Spans that don't fit the remaining
+ * data region are split; the rest go into the next request.  entrySpan[i]
+ * receives the span index entry i belongs to (its offset within the span
+ * is entries[i].address - addrs[entrySpan[i]]).  Advances *span / *offset
+ * and returns the entry count -- 0 once every span has been packed.
+ * Zero-length spans are skipped.
+ */
+static inline uint32_t rcx_rpc_pack_read_batch(uint8_t* data,
+                                               const uint64_t* addrs,
+                                               const uint32_t* lens,
+                                               uint32_t count,
+                                               uint32_t* span,
+                                               uint32_t* offset,
+                                               uint32_t* entrySpan)
+{
+    struct RcxRpcReadEntry* entries = (struct RcxRpcReadEntry*)data;
+    uint32_t n    = 0;
+    uint32_t used = (uint32_t)RCX_RPC_BATCH_TABLE_SIZE;
+
+    while (*span < count && n < RCX_RPC_MAX_BATCH && used < RCX_RPC_DATA_SIZE) {
+        uint32_t left = lens[*span] - *offset;
+        if (left == 0) { ++*span; *offset = 0; continue; }
+
+        uint32_t room = (uint32_t)RCX_RPC_DATA_SIZE - used;
+        uint32_t take = left < room ? left : room;
+
+        entries[n].address    = addrs[*span] + *offset;
+        entries[n].length     = take;
+        entries[n].dataOffset = used;
+        entrySpan[n]          = *span;
+        ++n;
+        used    += take;
+        *offset += take;
+        if (*offset == lens[*span]) { ++*span; *offset = 0; }
+    }
+    return n;
+}
+
 /* ── name formatting helpers (PID-only, no nonce) ─────────────────── */
 
 static inline void rcx_rpc_shm_name(char* buf, int n, uint32_t pid) {
@@ -196,6 +196,37 @@ struct TestIpcClient {
         return true;
     }
 
+    /* Multi-range read through rcx_rpc_pack_read_batch -- the same packing
+       the plugin's IpcClient::readBatch uses: up to RCX_RPC_MAX_BATCH
+       entries per round-trip, oversized spans split across requests. */
+    bool rpc_read_spans(const uint64_t* addrs, const uint32_t* lens,
+                        uint8_t* const* bufs, uint32_t count,
+                        int* roundTrips)
+    {
+        auto* hdr  = (RcxRpcHeader*)view;
+        auto* data = (uint8_t*)view + RCX_RPC_DATA_OFFSET;
+
+        uint32_t entrySpan[RCX_RPC_MAX_BATCH];
+        uint32_t span = 0, offset = 0;
+        while (uint32_t n = rcx_rpc_pack_read_batch(data, addrs, lens, count,
+                                                    &span, &offset, entrySpan)) {
+            hdr->command      = RPC_CMD_READ_BATCH;
+            hdr->requestCount = n;
+            hdr->status       = RCX_RPC_STATUS_OK;
+
+            if (!signalAndWait()) return false;
+            if (roundTrips) ++*roundTrips;
+
+            auto* e = (RcxRpcReadEntry*)data;
+            for (uint32_t k = 0; k < n; ++k) {
+                uint32_t i = entrySpan[k];
+                memcpy(bufs[i] + (e[k].address - addrs[i]),
+                       data + e[k].dataOffset, e[k].length);
+            }
+        }
+        return true;
+    }
+
     bool rpc_write(uint64_t addr, const void* buf, uint32_t len)
     {
         auto* hdr  = (RcxRpcHeader*)view;
@@ -454,6 +485,42 @@ int main(int argc, char** argv)
         }
     }
 
+    /* ── test: multi-range read (> MAX_BATCH spans, > data region) ── */
+    if (testBuf && testLen >= 65536) {
+        /* 300 page spans plus the whole 64 KB buffer as one span: exceeds
+           both the 256-entry cap and the 1 MB data region, so the request
+           must split across several round-trips. */
+        const uint32_t N = 300;
+        uint64_t addrs[N + 1];
+        uint32_t lens[N + 1];
+        uint8_t* bufs[N + 1];
+        uint8_t* out = (uint8_t*)malloc((size_t)N * 4096);
+        for (uint32_t i = 0; i < N; ++i) {
+            addrs[i] = testBuf + (i * 4096u) % 65536u;
+            lens[i]  = 4096;
+            bufs[i]  = out + (size_t)i * 4096;
+        }
+        const uint32_t bigLen = 65536;
+        uint8_t* big = (uint8_t*)malloc(bigLen);
+        addrs[N] = testBuf;
+        lens[N]  = bigLen;
+        bufs[N]  = big;
+
+        int trips = 0;
+        bool good = out && big && ipc.rpc_read_spans(addrs, lens, bufs, N + 1, &trips);
+        for (uint32_t i = 0; good && i < N; ++i)
+            for (uint32_t j = 4; j < 4096; ++j)   /* skip the 0xDEADBEEF patch */
+                if (bufs[i][j] != (uint8_t)(((i * 4096u) % 65536u + j) & 0xFF)) { good = false; break; }
+        for (uint32_t j = 4; good && j < bigLen; ++j)
+            if (big[j] != (uint8_t)(j & 0xFF)) good = false;
+        if (good && trips >= 2)
+            printf("  [PASS] MultiRangeRead (%u spans, %d round-trips)\n", N + 1, trips);
+        else
+            print_fail("MultiRangeRead");
+        free(out);
+        free(big);
+    }
+
     printf("\n=== Benchmarks ===\n");
 
     /* choose a valid address for benchmarking */
@@ -548,6 +615,52 @@ int main(int argc, char** argv)
             }
         }
 
+        /* ── benchmark: 2 MB refresh (512 pages), per-page vs multi-range ── */
+        if (testBuf && testLen >= 65536) {
+            const int ITERS = 200;
+            const uint32_t PAGES = 512;
+            const uint32_t PAGE  = 4096;
+
+            uint64_t addrs[PAGES];
+            uint32_t lens[PAGES];
+            uint8_t* bufs[PAGES];
+            uint8_t* outBuf = (uint8_t*)malloc((size_t)PAGES * PAGE);
+            if (!outBuf) {
+                printf("  (refresh malloc failed, skipping)\n");
+            } else {
+                for (uint32_t i = 0; i < PAGES; ++i) {
+                    addrs[i] = testBuf + (i * PAGE) % 65536;
+                    lens[i]  = PAGE;
+                    bufs[i]  = outBuf + (size_t)i * PAGE;
+                }
+                double totalMB = (double)ITERS * PAGES * PAGE / (1024.0 * 1024.0);
+
+                auto t0 = std::chrono::high_resolution_clock::now();
+                for (int it = 0; it < ITERS; ++it)
+                    for (uint32_t i = 0; i < PAGES; ++i)
+                        ipc.rpc_read(addrs[i], bufs[i], PAGE);
+                auto t1 = std::chrono::high_resolution_clock::now();
+                double usSingle = (double)std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+
+                int trips = 0;
+                t0 = std::chrono::high_resolution_clock::now();
+                for (int it = 0; it < ITERS; ++it)
+                    ipc.rpc_read_spans(addrs, lens, bufs, PAGES, &trips);
+                t1 = std::chrono::high_resolution_clock::now();
+                double usBatch = (double)std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count();
+
+                printf("  Refresh 2 MB (%u x %u B):\n", PAGES, PAGE);
+                printf("    Iterations : %d\n", ITERS);
+                printf("    Per-page   : %d round-trips/tick, %.2f MB/s, %.2f us/tick\n",
+                       (int)PAGES, totalMB / (usSingle / 1e6), usSingle / ITERS);
+                printf("    Multi-range: %d round-trips/tick, %.2f MB/s, %.2f us/tick\n",
+                       trips / ITERS, totalMB / (usBatch / 1e6), usBatch / ITERS);
+                printf("    Speedup    : %.1fx\n", usSingle / usBatch);
+
+                free(outBuf);
+            }
+        }
+
         /* ── benchmark: write 4 KB ── */
         if (testBuf && testLen >= 4096) {
             const int ITERS = 10000;
@@ -1,4 +1,5 @@
 #include "addressparser.h"
+#include <QVarLengthArray>
 
 namespace rcx {
 
@@ -34,33 +35,36 @@ namespace rcx {
 // Module names with extensions (e.g. "client.dll") are scanned as one token.
 // Pure hex-digit words (e.g. "DEAD") are treated as hex literals.
 
+// The parser only emits code: literals, operators and callback sites
+// become AddressProgram instructions in evaluation order, and
+// AddressProgram::run() does the arithmetic, reads and lookups. Syntax
+// errors are reported by the parse; failed reads and lookups by the run.
+
 class ExpressionParser {
+    using Op = AddressProgram::Op;
+
 public:
-    ExpressionParser(const QString& input, const AddressParserCallbacks* callbacks)
-        : m_input(input), m_callbacks(callbacks) {}
+    ExpressionParser(const QString& input, AddressProgram& out)
+        : m_input(input), m_out(out) {}
 
-    AddressParseResult parse() {
+    bool parse() {
         skipSpaces();
         if (atEnd())
-            return error("empty expression");
+            return fail("empty expression");
 
-        uint64_t value = 0;
-        if (!parseBitwiseOr(value))
-            return error(m_error);
+        if (!parseBitwiseOr())
+            return false;
 
         skipSpaces();
         if (!atEnd())
-            return error(QStringLiteral("unexpected '%1'").arg(m_input[m_pos]));
-
-        return {true, value, {}, -1};
+            return fail(QStringLiteral("unexpected '%1'").arg(m_input[m_pos]));
+        return true;
     }
 
 private:
     const QString& m_input;
-    const AddressParserCallbacks* m_callbacks;
+    AddressProgram& m_out;
     int m_pos = 0;
-    QString m_error;
-    int m_errorPos = 0;
 
     // ── Helpers ──
 
@@ -75,16 +79,29 @@ private:
             m_pos++;
     }
 
-    AddressParseResult error(const QString& msg) const {
-        return {false, 0, msg, m_errorPos};
+    bool fail(const QString& msg) {
+        m_out.m_error = msg;
+        m_out.m_errorPos = m_pos;
+        return false;
     }
 
-    bool fail(const QString& msg) {
-        m_error = msg;
-        m_errorPos = m_pos;
+    bool failAt(int pos, const QString& msg) {
+        m_out.m_error = msg;
+        m_out.m_errorPos = pos;
         return false;
     }
 
+    // Runtime failures report the position just past their operand, as
+    // the old evaluate-while-parsing code did.
+    void emitOp(Op op, uint64_t arg = 0) {
+        m_out.m_code.append({op, m_pos, arg});
+    }
+
+    void emitName(Op op, const QString& name) {
+        m_out.m_code.append({op, m_pos, uint64_t(m_out.m_names.size())});
+        m_out.m_names.append(name);
+    }
+
     bool expect(QChar ch) {
         skipSpaces();
         if (peek() != ch)
@@ -110,59 +127,56 @@ private:
     // ── Recursive descent parsing ──
 
     // bitwiseOr = bitwiseXor ('|' bitwiseXor)*
-    bool parseBitwiseOr(uint64_t& result) {
-        if (!parseBitwiseXor(result))
+    bool parseBitwiseOr() {
+        if (!parseBitwiseXor())
             return false;
         for (;;) {
             skipSpaces();
             if (peek() != '|')
                 break;
             advance();
-            uint64_t rhs = 0;
-            if (!parseBitwiseXor(rhs))
+            if (!parseBitwiseXor())
                 return false;
-            result |= rhs;
+            emitOp(Op::Or);
         }
         return true;
     }
 
     // bitwiseXor = bitwiseAnd ('^' bitwiseAnd)*
-    bool parseBitwiseXor(uint64_t& result) {
-        if (!parseBitwiseAnd(result))
+    bool parseBitwiseXor() {
+        if (!parseBitwiseAnd())
             return false;
         for (;;) {
             skipSpaces();
             if (peek() != '^')
                 break;
             advance();
-            uint64_t rhs = 0;
-            if (!parseBitwiseAnd(rhs))
+            if (!parseBitwiseAnd())
                 return false;
-            result ^= rhs;
+            emitOp(Op::Xor);
         }
         return true;
     }
 
     // bitwiseAnd = shift ('&' shift)*
-    bool parseBitwiseAnd(uint64_t& result) {
-        if (!parseShift(result))
+    bool parseBitwiseAnd() {
+        if (!parseShift())
             return false;
         for (;;) {
             skipSpaces();
             if (peek() != '&')
                 break;
             advance();
-            uint64_t rhs = 0;
-            if (!parseShift(rhs))
+            if (!parseShift())
                 return false;
-            result &= rhs;
+            emitOp(Op::And);
         }
         return true;
     }
 
     // shift = expr (('<<' | '>>') expr)*
-    bool parseShift(uint64_t& result) {
-        if (!parseExpression(result))
+    bool parseShift() {
+        if (!parseExpression())
             return false;
         for (;;) {
             skipSpaces();
@@ -174,17 +188,16 @@ private:
                 break;
             bool isLeft = (c == '<');
             advance(); advance(); // skip << or >>
-            uint64_t rhs = 0;
-            if (!parseExpression(rhs))
+            if (!parseExpression())
                 return false;
-            result = isLeft ? (result << rhs) : (result >> rhs);
+            emitOp(isLeft ? Op::Shl : Op::Shr);
         }
         return true;
     }
 
     // expr = term (('+' | '-') term)*
-    bool parseExpression(uint64_t& result) {
-        if (!parseTerm(result))
+    bool parseExpression() {
+        if (!parseTerm())
             return false;
 
         for (;;) {
@@ -194,18 +207,17 @@ private:
                 break;
             advance();
 
-            uint64_t rhs = 0;
-            if (!parseTerm(rhs))
+            if (!parseTerm())
                 return false;
 
-            result = (op == '+') ? result + rhs : result - rhs;
+            emitOp(op == '+' ? Op::Add : Op::Sub);
         }
         return true;
     }
 
     // term = unary (('*' | '/') unary)*
-    bool parseTerm(uint64_t& result) {
-        if (!parseUnary(result))
+    bool parseTerm() {
+        if (!parseUnary())
             return false;
 
         for (;;) {
@@ -215,60 +227,51 @@ private:
                 break;
             advance();
 
-            uint64_t rhs = 0;
-            if (!parseUnary(rhs))
+            if (!parseUnary())
                 return false;
 
-            if (op == '*') {
-                result *= rhs;
-            } else {
-                if (rhs == 0)
-                    return fail("division by zero");
-                result /= rhs;
-            }
+            emitOp(op == '*' ? Op::Mul : Op::Div);
         }
         return true;
     }
 
     // unary = '-' unary | '~' unary | atom
-    bool parseUnary(uint64_t& result) {
+    bool parseUnary() {
         skipSpaces();
         if (peek() == '-') {
             advance();
-            uint64_t inner = 0;
-            if (!parseUnary(inner))
+            if (!parseUnary())
                 return false;
-            result = static_cast<uint64_t>(-static_cast<int64_t>(inner));
+            emitOp(Op::Neg);
             return true;
         }
         if (peek() == '~') {
             advance();
-            uint64_t inner = 0;
-            if (!parseUnary(inner))
+            if (!parseUnary())
                 return false;
-            result = ~inner;
+            emitOp(Op::Not);
             return true;
         }
-        return parseAtom(result);
+        return parseAtom();
     }
 
     // atom = '[' bitwiseOr ']' | '<' name '>' | '(' bitwiseOr ')' | identifier | hexLiteral
-    bool parseAtom(uint64_t& result) {
+    bool parseAtom() {
         skipSpaces();
         if (atEnd())
             return fail("unexpected end of expression");
 
         QChar ch = peek();
 
-        if (ch == '[') return parseDereference(result);
-        if (ch == '<') return parseModuleName(result);
-        if (ch == '(') return parseGrouping(result);
+        if (ch == '[') return parseDereference();
+        if (ch == '<') return parseModuleName();
+        if (ch == '(') return parseGrouping();
 
         // Try identifier before hex — identifiers start with [a-zA-Z_]
         if (isIdentStart(ch))
-            return parseIdentifierOrHex(result);
+            return parseIdentifierOrHex();
 
-        return parseHexNumber(result);
+        return parseHexNumber();
     }
 
     // Identifier or hex literal disambiguation.
@@ -276,7 +279,7 @@ private:
     // Otherwise → backtrack and parse as hex number.
     // WinDbg-style "module!symbol" is scanned as a single identifier token.
     // If the identifier is followed by '(', try to parse as a built-in function call.
-    bool parseIdentifierOrHex(uint64_t& result) {
+    bool parseIdentifierOrHex() {
         int start = m_pos;
         bool hasNonHex = false;
 
@@ -320,86 +323,49 @@ private:
         if (!hasNonHex) {
             // Pure hex digits (e.g. "DEAD") — backtrack, parse as hex
             m_pos = start;
-            return parseHexNumber(result);
+            return parseHexNumber();
         }
 
         // Check for function call syntax: identifier '(' args ')'
         skipSpaces();
         if (peek() == '(')
-            return parseFunctionCall(token, result);
+            return parseFunctionCall(token);
 
-        // It's an identifier — resolve via callback
-        if (!m_callbacks || !m_callbacks->resolveIdentifier) {
-            result = 0;
-            return true;
-        }
-
-        bool ok = false;
-        result = m_callbacks->resolveIdentifier(token, &ok);
-        if (!ok)
-            return fail(QStringLiteral("unknown identifier '%1'").arg(token));
+        // It's an identifier — resolved via callback at run time
+        emitName(Op::Ident, token);
         return true;
     }
 
     // Built-in function call: vtop(pid, va), cr3(pid), phys(addr)
-    bool parseFunctionCall(const QString& name, uint64_t& result) {
+    bool parseFunctionCall(const QString& name) {
         advance(); // skip '('
 
         if (name == QStringLiteral("vtop")) {
             // vtop(pid, virtualAddress) → physical address
-            uint64_t pid = 0;
-            if (!parseBitwiseOr(pid)) return false;
+            if (!parseBitwiseOr()) return false;
             skipSpaces();
             if (peek() != ',')
                 return fail("vtop() requires 2 arguments: vtop(pid, va)");
             advance(); // skip ','
-            uint64_t va = 0;
-            if (!parseBitwiseOr(va)) return false;
+            if (!parseBitwiseOr()) return false;
             if (!expect(')')) return false;
-
-            if (!m_callbacks || !m_callbacks->vtop) {
-                result = 0;
-                return true;
-            }
-            bool ok = false;
-            result = m_callbacks->vtop((uint32_t)pid, va, &ok);
-            if (!ok)
-                return fail(QStringLiteral("vtop(0x%1, 0x%2) failed")
-                    .arg(pid, 0, 16).arg(va, 0, 16));
+            emitOp(Op::Vtop);
             return true;
         }
 
         if (name == QStringLiteral("cr3")) {
             // cr3(pid) → CR3 value
-            uint64_t pid = 0;
-            if (!parseBitwiseOr(pid)) return false;
+            if (!parseBitwiseOr()) return false;
             if (!expect(')')) return false;
-
-            if (!m_callbacks || !m_callbacks->cr3) {
-                result = 0;
-                return true;
-            }
-            bool ok = false;
-            result = m_callbacks->cr3((uint32_t)pid, &ok);
-            if (!ok)
-                return fail(QStringLiteral("cr3(%1) failed").arg(pid));
+            emitOp(Op::Cr3);
             return true;
         }
 
         if (name == QStringLiteral("phys")) {
             // phys(addr) → read 8 bytes from physical address
-            uint64_t addr = 0;
-            if (!parseBitwiseOr(addr)) return false;
+            if (!parseBitwiseOr()) return false;
             if (!expect(')')) return false;
-
-            if (!m_callbacks || !m_callbacks->physRead) {
-                result = 0;
-                return true;
-            }
-            bool ok = false;
-            result = m_callbacks->physRead(addr, &ok);
-            if (!ok)
-                return fail(QStringLiteral("phys(0x%1) failed").arg(addr, 0, 16));
+            emitOp(Op::Phys);
             return true;
         }
 
@@ -407,30 +373,20 @@ private:
     }
 
     // '[' bitwiseOr ']' — read the pointer value at the computed address
-    bool parseDereference(uint64_t& result) {
+    bool parseDereference() {
         advance(); // skip '['
 
-        uint64_t address = 0;
-        if (!parseBitwiseOr(address))
+        if (!parseBitwiseOr())
             return false;
         if (!expect(']'))
             return false;
 
-        // Without a callback, just return 0 (syntax-check mode)
-        if (!m_callbacks || !m_callbacks->readPointer) {
-            result = 0;
-            return true;
-        }
-
-        bool ok = false;
-        result = m_callbacks->readPointer(address, &ok);
-        if (!ok)
-            return fail(QStringLiteral("failed to read memory at 0x%1").arg(address, 0, 16));
+        emitOp(Op::Deref);
         return true;
     }
 
     // '<' moduleName '>' — resolve a module's base address (e.g. <Program.exe>)
-    bool parseModuleName(uint64_t& result) {
+    bool parseModuleName() {
         advance(); // skip '<'
 
         int nameStart = m_pos;
@@ -445,29 +401,20 @@ private:
         if (name.isEmpty())
             return fail("empty module name");
 
-        // Without a callback, just return 0 (syntax-check mode)
-        if (!m_callbacks || !m_callbacks->resolveModule) {
-            result = 0;
-            return true;
-        }
-
-        bool ok = false;
-        result = m_callbacks->resolveModule(name, &ok);
-        if (!ok)
-            return fail(QStringLiteral("module '%1' not found").arg(name));
+        emitName(Op::Module, name);
         return true;
     }
 
     // '(' bitwiseOr ')' — parenthesized sub-expression for grouping
-    bool parseGrouping(uint64_t& result) {
+    bool parseGrouping() {
         advance(); // skip '('
-        if (!parseBitwiseOr(result))
+        if (!parseBitwiseOr())
             return false;
         return expect(')');
     }
 
     // Hex number with optional "0x" prefix. All literals are base-16.
-    bool parseHexNumber(uint64_t& result) {
+    bool parseHexNumber() {
         skipSpaces();
         if (atEnd())
             return fail("unexpected end of expression");
@@ -485,24 +432,214 @@ private:
         while (!atEnd() && isHexDigit(peek()))
             advance();
 
-        if (m_pos == digitsStart) {
-            m_errorPos = start;
-            return fail("expected hex number");
-        }
+        if (m_pos == digitsStart)
+            return failAt(start, "expected hex number");
 
         QString digits = m_input.mid(digitsStart, m_pos - digitsStart);
         bool ok = false;
-        result = digits.toULongLong(&ok, 16);
-        if (!ok) {
-            m_errorPos = start;
-            return fail("invalid hex number");
-        }
+        uint64_t value = digits.toULongLong(&ok, 16);
+        if (!ok)
+            return failAt(start, "invalid hex number");
+        emitOp(Op::Push, value);
         return true;
     }
 };
 
+// ── Compiled program ───────────────────────────────────────────────────
+
+bool AddressProgram::dereferences() const {
+    for (const Insn& in : m_code)
+        if (in.op == Op::Deref) return true;
+    return false;
+}
+
+bool AddressProgram::usesPaging() const {
+    for (const Insn& in : m_code)
+        if (in.op == Op::Vtop || in.op == Op::Cr3 || in.op == Op::Phys) return true;
+    return false;
+}
+
+bool AddressProgram::bindNames(const AddressParserCallbacks& cb, QString* error) {
+    m_namesBound = false;
+    m_values.fill(0, m_names.size());
+    for (const Insn& in : m_code) {
+        if (in.op != Op::Module && in.op != Op::Ident) continue;
+        const QString& name = m_names[int(in.arg)];
+        const bool module = (in.op == Op::Module);
+        const auto& resolve = module ? cb.resolveModule : cb.resolveIdentifier;
+        bool ok = false;
+        if (resolve)
+            m_values[int(in.arg)] = resolve(name, &ok);
+        if (!ok) {
+            if (error)
+                *error = module ? QStringLiteral("module '%1' not found").arg(name)
+                                : QStringLiteral("unknown identifier '%1'").arg(name);
+            return false;
+        }
+    }
+    m_namesBound = true;
+    return true;
+}
+
+AddressParseResult AddressProgram::run(const AddressParserCallbacks* cb,
+                                       QVector<uint64_t>* derefs) const
+{
+    if (!m_ok)
+        return {false, 0, m_error, m_errorPos};
+
+    auto fail = [](const Insn& in, const QString& msg) -> AddressParseResult {
+        return {false, 0, msg, in.pos};
+    };
+
+    // Every operator pops what its operands pushed, so the stack never
+    // gets deeper than the formula's nesting.
+    QVarLengthArray<uint64_t, 16> stack;
+    for (const Insn& in : m_code) {
+        switch (in.op) {
+        case Op::Push:
+            stack.append(in.arg);
+            break;
+
+        case Op::Module:
+        case Op::Ident: {
+            const bool module = (in.op == Op::Module);
+            const QString& name = m_names[int(in.arg)];
+            if (m_namesBound) {
+                stack.append(m_values[int(in.arg)]);
+                break;
+            }
+            const auto* resolve = !cb ? nullptr
+                                : module ? &cb->resolveModule : &cb->resolveIdentifier;
+            // Without a callback, just return 0 (syntax-check mode)
+            if (!resolve || !*resolve) {
+                stack.append(0);
+                break;
+            }
+            bool ok = false;
+            uint64_t v = (*resolve)(name, &ok);
+            if (!ok)
+                return fail(in, module ? QStringLiteral("module '%1' not found").arg(name)
+                                       : QStringLiteral("unknown identifier '%1'").arg(name));
+            stack.append(v);
+            break;
+        }
+
+        case Op::Deref: {
+            uint64_t& top = stack.last();
+            const uint64_t address = top;
+            if (derefs) derefs->append(address);
+            if (!cb || !cb->readPointer) {
+                top = 0;
+                break;
+            }
+            bool ok = false;
+            top = cb->readPointer(address, &ok);
+            if (!ok)
+                return fail(in, QStringLiteral("failed to read memory at 0x%1").arg(address, 0, 16));
+            break;
+        }
+
+        case Op::Neg:
+            stack.last() = static_cast<uint64_t>(-static_cast<int64_t>(stack.last()));
+            break;
+        case Op::Not:
+            stack.last() = ~stack.last();
+            break;
+
+        case Op::Add: case Op::Sub: case Op::Mul: case Op::Div:
+        case Op::And: case Op::Or:  case Op::Xor: case Op::Shl: case Op::Shr: {
+            const uint64_t rhs = stack.takeLast();
+            uint64_t& lhs = stack.last();
+            switch (in.op) {
+            case Op::Add: lhs += rhs; break;
+            case Op::Sub: lhs -= rhs; break;
+            case Op::Mul: lhs *= rhs; break;
+            case Op::Div:
+                if (rhs == 0)
+                    return fail(in, QStringLiteral("division by zero"));
+                lhs /= rhs;
+                break;
+            case Op::And: lhs &= rhs; break;
+            case Op::Or:  lhs |= rhs; break;
+            case Op::Xor: lhs ^= rhs; break;
+            case Op::Shl: lhs <<= rhs; break;
+            case Op::Shr: lhs >>= rhs; break;
+            default: break;
+            }
+            break;
+        }
+
+        case Op::Vtop: {
+            const uint64_t va = stack.takeLast();
+            uint64_t& top = stack.last();
+            const uint64_t pid = top;
+            if (!cb || !cb->vtop) {
+                top = 0;
+                break;
+            }
+            bool ok = false;
+            top = cb->vtop((uint32_t)pid, va, &ok);
+            if (!ok)
+                return fail(in, QStringLiteral("vtop(0x%1, 0x%2) failed")
+                    .arg(pid, 0, 16).arg(va, 0, 16));
+            break;
+        }
+
+        case Op::Cr3: {
+            uint64_t& top = stack.last();
+            const uint64_t pid = top;
+            if (!cb || !cb->cr3) {
+                top = 0;
+                break;
+            }
+            bool ok = false;
+            top = cb->cr3((uint32_t)pid, &ok);
+            if (!ok)
+                return fail(in, QStringLiteral("cr3(%1) failed").arg(pid));
+            break;
+        }
+
+        case Op::Phys: {
+            uint64_t& top = stack.last();
+            const uint64_t addr = top;
+            if (!cb || !cb->physRead) {
+                top = 0;
+                break;
+            }
+            bool ok = false;
+            top = cb->physRead(addr, &ok);
+            if (!ok)
+                return fail(in, QStringLiteral("phys(0x%1) failed").arg(addr, 0, 16));
+            break;
+        }
+        }
+    }
+    return {true, stack.last(), {}, -1};
+}
+
 // ── Public API ─────────────────────────────────────────────────────────
 
+// WinDbg displays 64-bit addresses with backtick separators for readability,
+// e.g. "00007ff6`1a2b3c4d". Strip them so users can paste directly.
+// Also remove ' in case user uses it
+static QString stripSeparators(const QString& formula) {
+    QString cleaned = formula;
+    cleaned.remove('`');
+    cleaned.remove('\'');
+    return cleaned;
+}
+
+AddressProgram AddressParser::compile(const QString& formula)
+{
+    AddressProgram prog;
+    const QString cleaned = stripSeparators(formula);
+    ExpressionParser parser(cleaned, prog);
+    prog.m_ok = parser.parse();
+    if (!prog.m_ok)
+        prog.m_code.clear();
+    return prog;
+}
+
 AddressParseResult AddressParser::evaluate(const QString& formula, int ptrSize,
                                            const AddressParserCallbacks* cb)
 {
@@ -510,30 +647,18 @@ AddressParseResult AddressParser::evaluate(const QString& formula, int ptrSize,
     // the parser itself doesn't need it directly.
     Q_UNUSED(ptrSize);
 
-    // WinDbg displays 64-bit addresses with backtick separators for readability,
-    // e.g. "00007ff6`1a2b3c4d". Strip them so users can paste directly.
-    // Also remove ' in case user uses it
-    QString cleaned = formula;
-    cleaned.remove('`');
-    cleaned.remove('\'');
-
-    ExpressionParser parser(cleaned, cb);
-    return parser.parse();
+    return compile(formula).run(cb);
 }
 
 QString AddressParser::validate(const QString& formula)
 {
-    QString cleaned = formula;
-    cleaned.remove('`');
-    cleaned.remove('\'');
-    cleaned = cleaned.trimmed();
+    QString cleaned = stripSeparators(formula).trimmed();
     if (cleaned.isEmpty())
         return QStringLiteral("empty");
 
-    // Parse with no callbacks — modules, dereferences, identifiers succeed but return 0.
+    // Run with no callbacks — modules, dereferences, identifiers succeed but return 0.
     // This checks syntax only.
-    ExpressionParser parser(cleaned, nullptr);
-    auto result = parser.parse();
+    auto result = compile(cleaned).run();
     return result.ok ? QString() : result.error;
 }
 
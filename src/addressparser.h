@@ -1,5 +1,7 @@
 #pragma once
 #include <QString>
+#include <QStringList>
+#include <QVector>
 #include <cstdint>
 #include <functional>
 
@@ -23,11 +25,67 @@ struct AddressParserCallbacks {
     std::function<uint64_t(uint64_t physAddr, bool* ok)>          physRead;
 };
 
+// A formula parsed once into a flat postfix program. Re-running it costs
+// one pass over a few instructions instead of a re-parse, so a live base
+// like "[[<game.exe>+0x1A0]+0x30]" can be re-evaluated every refresh tick.
+class AddressProgram {
+public:
+    // Compiled without a syntax error. A failed program's error()/errorPos()
+    // are what evaluate() would have reported.
+    bool ok() const { return m_ok; }
+    const QString& error() const { return m_error; }
+    int errorPos() const { return m_errorPos; }
+
+    // Reads memory ('[...]'), so its value can move while attached.
+    bool dereferences() const;
+    // Calls vtop()/cr3()/phys().
+    bool usesPaging() const;
+
+    // Resolve every <module> and identifier through cb now and keep the
+    // values, so later runs only need readPointer. Module bases don't move
+    // while attached; re-bind after attaching elsewhere. False (first
+    // failure in *error) if any name didn't resolve.
+    bool bindNames(const AddressParserCallbacks& cb, QString* error = nullptr);
+    bool namesBound() const { return m_namesBound; }
+
+    // Evaluate. Unbound names go through cb; with no cb (or a missing
+    // callback) they and dereferences read as 0. Every address dereferenced
+    // is appended to *derefs, in evaluation order.
+    AddressParseResult run(const AddressParserCallbacks* cb = nullptr,
+                           QVector<uint64_t>* derefs = nullptr) const;
+
+private:
+    friend class ExpressionParser;
+    friend class AddressParser;
+
+    enum class Op : uint8_t {
+        Push, Module, Ident, Deref,
+        Neg, Not,
+        Add, Sub, Mul, Div, And, Or, Xor, Shl, Shr,
+        Vtop, Cr3, Phys,
+    };
+    struct Insn {
+        Op       op;
+        int      pos;   // source position, for runtime errors
+        uint64_t arg;   // Push: the literal; Module/Ident: index into m_names
+    };
+
+    QVector<Insn>     m_code;
+    QStringList       m_names;
+    QVector<uint64_t> m_values;   // bound name values, parallel to m_names
+    bool              m_namesBound = false;
+    bool              m_ok = false;
+    QString           m_error;
+    int               m_errorPos = -1;
+};
+
 class AddressParser {
 public:
     static AddressParseResult evaluate(const QString& formula, int ptrSize = 8,
                                        const AddressParserCallbacks* cb = nullptr);
     static QString validate(const QString& formula);
+    // Parse once for repeated runs; see AddressProgram.
+    static AddressProgram compile(const QString& formula);
 };
 
 } // namespace rcx
@@ -3,9 +3,11 @@
 #include "addressparser.h"
 #include "profiler.h"
 #include "rtti.h"
+#include "diffutil.h"
 #include "providers/provider.h"
 #include <QRegularExpression>
 #include <algorithm>
+#include <atomic>
 #include <numeric>
 
 namespace rcx {
@@ -15,7 +17,7 @@ namespace rcx {
 // the expression parser. Tests leave it nullptr (no-op).
 void (*g_rttiDiscoveryHook)(const QString& name, uint64_t address,
                              const QString& moduleName) = nullptr;
-QString (*g_nameLookupHook)(uint64_t address, const Provider* active) = nullptr;
+QString (*g_nameLookupHook)(uint64_t address, const std::shared_ptr<Provider>& active) = nullptr;
 void (*g_namesChangedHook)() = nullptr;
 
 namespace {
@@ -91,14 +93,25 @@ struct ComposeState {
     SymbolLookupFn     symbolLookup;             // optional PDB symbol lookup callback
     QVector<bool>      siblingStack;             // per-depth: true = more siblings follow at this level
     uint64_t           currentPtrBase = 0;      // absolute addr of current pointer expansion target
+    ComposeWindow      window;                   // lines to materialize in huge containers
+    int                placeholderLines = 0;
 
-    // ── RTTI auto-detect cache (per compose pass) ──
+    // True when `lines` rows emitted next would all fall outside the window.
+    bool outsideWindow(int lines) const {
+        return window.first >= 0
+            && (currentLine + lines <= window.first || currentLine > window.last);
+    }
+
+    // ── RTTI auto-detect cache ──
     // Module list is fetched lazily on first vtable candidate. walkRtti()
     // results are memoized — both successes (avoid re-walk) and failures
-    // (avoid re-trying every refresh on the same arbitrary 8-byte word).
+    // (avoid re-trying every refresh on the same arbitrary 8-byte word) —
+    // in the caller's long-lived cache when compose() was given one, else
+    // in localRtti for this pass only. Failed reads always go to localRtti.
     bool                              rttiModulesCached = false;
     QVector<Provider::ModuleEntry>    rttiModules;
-    QHash<uint64_t, RttiInfo>         rttiCache;
+    RttiCache                         localRtti;
+    RttiCache*                        rttiCache = &localRtti;
 
     // ── Type-hint memo (per compose pass) ──
     // inferTypes() is a pure function of (bytes,len); within one compose pass an
@@ -110,9 +123,12 @@ struct ComposeState {
     struct TypeHintResult { bool has = false; QString hint; QVector<NodeKind> kinds; };
     QHash<uint64_t, TypeHintResult>   typeHintCache;
 
-    // Precomputed for O(1) lookups
-    QHash<uint64_t, QVector<int>> childMap;
-    mutable QSet<uint64_t>        childMapSorted;  // tracks which entries are sorted
+    // Children by offset: a private copy of the tree's CSR child index
+    // (NodeTree::childIndex), each row sorted in place the first time it's
+    // composed. One flat array, so spans into it stay valid all pass.
+    const NodeTree::ChildIndex*   childIndex = nullptr;
+    QVector<int>                  sortedKids;
+    QVector<bool>                 rowSorted;
     QVector<int64_t>              absOffsets;  // indexed by node index
 
     // Per-scope column widths (containerId -> width for direct children)
@@ -252,22 +268,24 @@ static inline uint64_t resolveAddr(const ComposeState& state,
 }
 
 
-static const QVector<int>& childIndices(ComposeState& state, uint64_t parentId) {
-    static const QVector<int> kEmpty;
-    auto it = state.childMap.find(parentId);
-    if (it == state.childMap.end()) return kEmpty;
+static NodeTree::ChildSpan childIndices(ComposeState& state, uint64_t parentId) {
+    const NodeTree::ChildIndex& ci = *state.childIndex;
+    auto it = ci.row.constFind(parentId);
+    if (it == ci.row.constEnd()) return {};
+    const int r = *it;
+    int* b = state.sortedKids.data() + ci.start.at(r);
+    int* e = state.sortedKids.data() + ci.start.at(r + 1);
     // Lazy sort: only sort children on first access
-    if (!state.childMapSorted.contains(parentId)) {
-        auto& children = it.value();
-        std::sort(children.begin(), children.end(), [&](int a, int b) {
-            return state.absOffsets[a] < state.absOffsets[b];
+    if (!state.rowSorted[r]) {
+        std::sort(b, e, [&](int x, int y) {
+            return state.absOffsets[x] < state.absOffsets[y];
         });
-        state.childMapSorted.insert(parentId);
+        state.rowSorted[r] = true;
     }
-    return it.value();
+    return {b, e};
 }
 
-// Resolve RTTI for a candidate vtable address, cached per compose pass.
+// Resolve RTTI for a candidate vtable address through state.rttiCache.
 // Module enumeration runs at most once per pass; values that don't land
 // inside any known module short-circuit before walkRtti is even called.
 // Negative results (ok=false) are cached too — prevents the parser from
@@ -278,15 +296,18 @@ static const QVector<int>& childIndices(ComposeState& state, uint64_t parentId)
 // enumerating method addresses, which is all the inline hint needs.
 static const RttiInfo& rttiForVtable(ComposeState& state, const Provider& prov,
                                      uint64_t candidateAddr) {
-    auto it = state.rttiCache.find(candidateAddr);
-    if (it != state.rttiCache.end()) return it.value();
-
     if (!state.rttiModulesCached) {
         // modulesCached() persists across refreshes (per Provider instance),
-        // so the module syscall doesn't re-run every compose pass.
+        // so the module syscall doesn't re-run every compose pass. Entries
+        // resolved against a different module list are dropped here.
         state.rttiModules = prov.modulesCached();
         state.rttiModulesCached = true;
+        state.rttiCache->syncModules(prov);
     }
+    if (const RttiInfo* hit = state.rttiCache->find(candidateAddr))
+        return *hit;
+    if (const RttiInfo* hit = state.localRtti.find(candidateAddr))
+        return *hit;
 
     RttiInfo info;  // ok=false default — caches negative results
     bool inModule = false;
@@ -301,8 +322,11 @@ static const RttiInfo& rttiForVtable(ComposeState& state, const Provider& prov,
         // most C++ class instances on Linux/macOS, and any Reclass.exe
         // self-attach (Reclass is MinGW-built) hit this path.
         info = walkRtti(prov, candidateAddr, /*ptrSize=*/8, /*maxVtableSlots=*/0);
-        if (!info.ok)
+        if (!info.ok) {
+            const bool msvcReadFailed = info.readFailed;
             info = walkRttiItanium(prov, candidateAddr, /*ptrSize=*/8, /*maxVtableSlots=*/0);
+            if (!info.ok) info.readFailed |= msvcReadFailed;
+        }
         if (info.ok && !info.demangledName.isEmpty() && g_rttiDiscoveryHook) {
             // Surface the discovery in the unified Symbols panel + make it
             // resolve in the expression parser. The hook is set by the
@@ -311,7 +335,10 @@ static const RttiInfo& rttiForVtable(ComposeState& state, const Provider& prov,
                                 info.moduleName);
         }
     }
-    return state.rttiCache.insert(candidateAddr, info).value();
+    // A walk cut short by an unreadable page may succeed next tick; keep
+    // it for this pass only instead of pinning it until the modules change.
+    RttiCache& cache = info.readFailed ? state.localRtti : *state.rttiCache;
+    return cache.insert(candidateAddr, info);
 }
 
 void composeLeaf(ComposeState& state, const NodeTree& tree,
@@ -402,6 +429,7 @@ void composeLeaf(ComposeState& state, const NodeTree& tree,
         lm.foldLevel       = computeFoldLevel(depth, false);
         lm.effectiveTypeW  = lineTypeW;
         lm.effectiveNameW  = nameW;
+        lm.fmtTypeW        = typeW;
         lm.pointerTargetName = ptrTargetName;
 
         // Set byte count for hex preview lines (used for per-byte change highlighting)
@@ -655,6 +683,34 @@ void composeLeaf(ComposeState& state, const NodeTree& tree,
     }
 }
 
+// Stand-in for a row of a huge container that lies outside state.window:
+// same line count, depth and fold level as the real row, but nothing is
+// read or formatted. The controller recomposes once the viewport gets
+// near it.
+void composePlaceholder(ComposeState& state, int nodeIdx, uint64_t nodeId,
+                        NodeKind kind, int depth, uint64_t addr, int lines,
+                        int arrayElementIdx = -1, uint64_t parentAddr = 0) {
+    for (int sub = 0; sub < lines; sub++) {
+        LineMeta lm;
+        lm.nodeIdx         = nodeIdx;
+        lm.nodeId          = nodeId;
+        lm.subLine         = sub;
+        lm.depth           = depth;
+        lm.isContinuation  = sub > 0;
+        lm.lineKind        = sub > 0 ? LineKind::Continuation : LineKind::Field;
+        lm.nodeKind        = kind;
+        lm.offsetAddr      = addr;
+        lm.ptrBase         = state.currentPtrBase;
+        lm.parentAddr      = parentAddr;
+        lm.foldLevel       = computeFoldLevel(depth, false);
+        lm.isArrayElement  = arrayElementIdx >= 0;
+        lm.arrayElementIdx = arrayElementIdx;
+        lm.isPlaceholder   = true;
+        state.emitLine(fmt::indent(depth), std::move(lm));
+    }
+    state.placeholderLines += lines;
+}
+
 // Forward declarations (base/rootId default to 0 = use precomputed offsets)
 void composeNode(ComposeState& state, const NodeTree& tree,
                  const Provider& prov, int nodeIdx, int depth,
@@ -891,8 +947,7 @@ void composeParent(ComposeState& state, const NodeTree& tree,
             return;
         }
 
-        const QVector<int>& allChildren = childIndices(state, node.id);
-        const QVector<int>& regular     = allChildren;
+        const NodeTree::ChildSpan regular = childIndices(state, node.id);
 
         int childDepth = depth + 1;
 
@@ -902,9 +957,15 @@ void composeParent(ComposeState& state, const NodeTree& tree,
             int elemSize = sizeForKind(node.elementKind);
             int eTW = state.effectiveTypeW(node.id);
             int eNW = state.effectiveNameW(node.id);
+            const bool virtualize = node.arrayLen >= kVirtualizeMinRows;
             for (int i = 0; i < node.arrayLen; i++) {
                 state.setTreeSibling(childDepth, i < node.arrayLen - 1);
                 uint64_t elemAddr = absAddr + (uint64_t)i * elemSize;
+                if (virtualize && state.outsideWindow(1)) {
+                    composePlaceholder(state, nodeIdx, node.id, node.elementKind, childDepth,
+                                       elemAddr, 1, i, absAddr);
+                    continue;
+                }
 
                 // Type override: "float[0]", "uint32_t[1]", etc.
                 QString elemTypeStr = fmt::typeNameRaw(node.elementKind)
@@ -934,6 +995,7 @@ void composeParent(ComposeState& state, const NodeTree& tree,
                 bool elemOverflow = state.compactColumns && elemTypeStr.size() > eTW;
                 lm.effectiveTypeW = elemOverflow ? elemTypeStr.size() : eTW;
                 lm.effectiveNameW = eNW;
+                lm.fmtTypeW       = eTW;
 
                 state.emitLine(fmt::fmtNodeLine(elem, prov, elemAddr, childDepth, 0,
                                                 {}, eTW, eNW, elemTypeStr,
@@ -947,7 +1009,7 @@ void composeParent(ComposeState& state, const NodeTree& tree,
             && node.elementKind == NodeKind::Struct && node.refId != 0) {
             int refIdx = tree.indexOfId(node.refId);
             if (refIdx >= 0) {
-                int elemSize = tree.structSpan(node.refId, &state.childMap);
+                int elemSize = tree.structSpan(node.refId);
                 if (elemSize <= 0) elemSize = 1;
                 for (int i = 0; i < node.arrayLen; i++) {
                     state.setTreeSibling(childDepth, i < node.arrayLen - 1);
@@ -964,7 +1026,7 @@ void composeParent(ComposeState& state, const NodeTree& tree,
         if (node.kind == NodeKind::Struct && regular.isEmpty() && node.refId != 0) {
             int refIdx = tree.indexOfId(node.refId);
             if (refIdx >= 0) {
-                const QVector<int>& refChildren = childIndices(state, node.refId);
+                const NodeTree::ChildSpan refChildren = childIndices(state, node.refId);
                 // Use the referenced struct's scope widths (children come from there)
                 uint64_t refScopeId = node.refId;
                 for (int rci = 0; rci < refChildren.size(); rci++) {
@@ -1006,11 +1068,26 @@ void composeParent(ComposeState& state, const NodeTree& tree,
 
         // For arrays, render children as condensed (no header/footer for struct elements)
         bool childrenAreArrayElements = (node.kind == NodeKind::Array);
+        const bool virtualize = regular.size() >= kVirtualizeMinRows;
         int elementIdx = 0;
         for (int ri = 0; ri < regular.size(); ri++) {
             int childIdx = regular[ri];
             bool hasMore = (ri < regular.size() - 1);
             state.setTreeSibling(childDepth, hasMore);
+            if (virtualize) {
+                // Only plain leaves have a line count known without composing.
+                const Node& child = tree.nodes[childIdx];
+                const bool leaf = child.kind != NodeKind::Struct && child.kind != NodeKind::Array
+                    && !((child.kind == NodeKind::Pointer32 || child.kind == NodeKind::Pointer64)
+                         && child.refId != 0);
+                const int lines = linesForKind(child.kind);
+                if (leaf && state.outsideWindow(lines)) {
+                    if (childrenAreArrayElements) elementIdx++;
+                    composePlaceholder(state, childIdx, child.id, child.kind, childDepth,
+                                       resolveAddr(state, tree, childIdx, base, rootId), lines);
+                    continue;
+                }
+            }
             // Pass this container's id as the scope for children (for per-scope widths)
             // For array elements, also pass the element index for [N] separator
             composeNode(state, tree, prov, childIdx, childDepth, base, rootId,
@@ -1031,7 +1108,7 @@ void composeParent(ComposeState& state, const NodeTree& tree,
         lm.isRootHeader = isRootHeader;  // root footer: flush left (no fold prefix)
         lm.foldLevel  = computeFoldLevel(depth, false);
         lm.markerMask = 0;
-        int sz = tree.structSpan(node.id, &state.childMap);
+        int sz = tree.structSpan(node.id);
         lm.offsetText = fmt::fmtOffsetMargin(absAddr + sz, false, state.offsetHexDigits);
         lm.offsetAddr = absAddr + sz;
         lm.ptrBase    = state.currentPtrBase;
@@ -1063,7 +1140,7 @@ void composeNode(ComposeState& state, const NodeTree& tree,
             ptrTypeOverride += QStringLiteral(" rva");
 
         // Check if this pointer has materialized children (from materializeRefChildren)
-        const QVector<int>& ptrChildren = childIndices(state, node.id);
+        const NodeTree::ChildSpan ptrChildren = childIndices(state, node.id);
         bool hasMaterialized = !ptrChildren.isEmpty();
 
         // Force collapsed if this refId is already being virtually expanded
@@ -1326,15 +1403,24 @@ void composeNode(ComposeState& state, const NodeTree& tree,
     }
 }
 
+// Source for ComposeResult::revision. Editors only compare revisions for
+// equality, so a process-wide counter is enough.
+std::atomic<uint64_t> g_composeRevision{0};
+
+uint64_t nextComposeRevision() { return ++g_composeRevision; }
+
 } // anonymous namespace
 
 ComposeResult compose(const NodeTree& tree, const Provider& prov, uint64_t viewRootId,
                       bool compactColumns, bool treeLines, bool braceWrap,
                       bool typeHints, bool showComments,
                       SymbolLookupFn symbolLookup,
-                      bool showRtti, bool showEnumChips) {
+                      bool showRtti, bool showEnumChips,
+                      RttiCache* rttiCache, ComposeWindow window) {
     PROFILE_SCOPE("compose");
     ComposeState state;
+    if (rttiCache) state.rttiCache = rttiCache;
+    state.window = window;
     state.compactColumns = compactColumns;
     state.treeLines = treeLines;
     state.braceWrap = braceWrap;
@@ -1344,11 +1430,12 @@ ComposeResult compose(const NodeTree& tree, const Provider& prov, uint64_t viewR
     state.showEnumChips = showEnumChips;
     state.symbolLookup = std::move(symbolLookup);
 
-    // Precompute parent→children map
-    for (int i = 0; i < tree.nodes.size(); i++)
-        state.childMap[tree.nodes[i].parentId].append(i);
-
-    // Children are sorted lazily on first access in childIndices()
+    // Parent→children comes from the tree's persistent index (rebuilt only
+    // when the tree changes shape); children are sorted lazily on first
+    // access in childIndices()
+    state.childIndex = &tree.childIndex();
+    state.sortedKids = state.childIndex->kids;
+    state.rowSorted.fill(false, state.childIndex->start.size());
 
     // Pre-allocate output buffers (estimate ~3 lines per node, ~80 chars per line)
     state.meta.reserve(tree.nodes.size() * 3);
@@ -1367,18 +1454,20 @@ ComposeResult compose(const NodeTree& tree, const Provider& prov, uint64_t viewR
                 state.absOffsets[i] = tree.nodes[i].offset;
         {
             QVector<int> bfsQueue;
-            for (int i : state.childMap.value(0)) {
+            for (int i : tree.children(0)) {
                 bfsQueue.append(i);
                 visited[i] = true;
             }
+            // Each child's offset is fixed when it's queued — its parent is
+            // the node being expanded, so no id lookup per node.
             int front = 0;
             while (front < bfsQueue.size()) {
                 int idx = bfsQueue[front++];
-                int pi = tree.indexOfId(tree.nodes[idx].parentId);
-                state.absOffsets[idx] = (pi >= 0 ? state.absOffsets[pi] : 0)
-                                      + tree.nodes[idx].offset;
-                for (int ci : state.childMap.value(tree.nodes[idx].id)) {
-                    if (!visited[ci]) { visited[ci] = true; bfsQueue.append(ci); }
+                for (int ci : tree.children(tree.nodes[idx].id)) {
+                    if (visited[ci]) continue;
+                    visited[ci] = true;
+                    state.absOffsets[ci] = state.absOffsets[idx] + tree.nodes[ci].offset;
+                    bfsQueue.append(ci);
                 }
             }
             // Any node still unvisited is either an orphan (parentId points to
@@ -1392,7 +1481,7 @@ ComposeResult compose(const NodeTree& tree, const Provider& prov, uint64_t viewR
                     QVector<int> q; q.append(i);
                     while (!q.isEmpty()) {
                         int p = q.takeLast();
-                        for (int ci : state.childMap.value(tree.nodes[p].id)) {
+                        for (int ci : tree.children(tree.nodes[p].id)) {
                             if (visited[ci]) continue;
                             visited[ci] = true;
                             state.absOffsets[ci] = state.absOffsets[p] + tree.nodes[ci].offset;
@@ -1461,7 +1550,7 @@ ComposeResult compose(const NodeTree& tree, const Provider& prov, uint64_t viewR
         int scopeMaxType = kMinTypeW;
         int scopeMaxName = kMinNameW;
 
-        for (int childIdx : state.childMap.value(container.id)) {
+        for (int childIdx : tree.children(container.id)) {
             const Node& child = tree.nodes[childIdx];
             // Skip struct children — pointer headers shouldn't inflate sibling widths
             if (child.kind == NodeKind::Struct)
@@ -1475,7 +1564,7 @@ ComposeResult compose(const NodeTree& tree, const Provider& prov, uint64_t viewR
         // Primitive arrays with no tree children: account for synthesized element types
         // e.g. "uint32_t[0]", "uint32_t[99]" — longest index determines width
         if (container.kind == NodeKind::Array
-            && state.childMap.value(container.id).isEmpty()
+            && tree.children(container.id).isEmpty()
             && container.elementKind != NodeKind::Struct
             && container.elementKind != NodeKind::Array
             && container.arrayLen > 0) {
@@ -1493,7 +1582,7 @@ ComposeResult compose(const NodeTree& tree, const Provider& prov, uint64_t viewR
     {
         int rootMaxType = kMinTypeW;
         int rootMaxName = kMinNameW;
-        for (int childIdx : state.childMap.value(0)) {
+        for (int childIdx : tree.children(0)) {
             const Node& child = tree.nodes[childIdx];
             // Skip struct children — pointer headers shouldn't inflate sibling widths
             if (child.kind == NodeKind::Struct)
@@ -1544,7 +1633,7 @@ ComposeResult compose(const NodeTree& tree, const Provider& prov, uint64_t viewR
         state.emitLine(QStringLiteral("{"), std::move(braceLm));
     }
 
-    const QVector<int>& roots = childIndices(state, 0);
+    const NodeTree::ChildSpan roots = childIndices(state, 0);
 
     {
         PROFILE_SCOPE("compose.walk-nodes");
@@ -1562,9 +1651,190 @@ ComposeResult compose(const NodeTree& tree, const Provider& prov, uint64_t viewR
     cr.layout     = LayoutInfo{state.typeW, state.nameW, state.offsetHexDigits, tree.baseAddress, treeLines};
     cr.maxLineLen = state.maxLineLen;
     cr.lineStarts = std::move(state.lineStarts);
+    cr.revision   = nextComposeRevision();
+    cr.placeholderLines = state.placeholderLines;
     return cr;
 }
 
+bool recomposeChanged(ComposeResult& result, const NodeTree& tree, const Provider& prov,
+                      const ChangeBitmap& changed,
+                      bool compactColumns, bool typeHints, bool showComments,
+                      SymbolLookupFn symbolLookup,
+                      bool showRtti, bool showEnumChips,
+                      RttiCache* rttiCache) {
+    PROFILE_SCOPE("compose.incremental");
+    // Read through const views so a bail-out never detaches shared data.
+    const QVector<LineMeta>& meta   = result.meta;
+    const QVector<int>&      starts = result.lineStarts;
+    const QString&           text   = result.text;
+    const int n = meta.size();
+    if (n == 0 || starts.size() != n || result.revision == 0)
+        return false;
+
+    // Scratch state: composeLeaf only needs the formatting switches; the
+    // per-scope widths come from each row's own LineMeta.
+    ComposeState state;
+    if (rttiCache) state.rttiCache = rttiCache;
+    state.compactColumns  = compactColumns;
+    state.typeHints       = typeHints;
+    state.showComments    = showComments;
+    state.symbolLookup    = std::move(symbolLookup);
+    state.showRtti        = showRtti;
+    state.showEnumChips   = showEnumChips;
+    state.offsetHexDigits = result.layout.offsetHexDigits;
+
+    auto dirty = [&](uint64_t addr, int size) {
+        return size > 0 && changed.anyInRange((int64_t)addr, (int64_t)addr + size);
+    };
+    auto lineEnd = [&](int line) {
+        return line + 1 < n ? starts[line + 1] - 1 : (int)text.size();
+    };
+    // Keep the line's fold prefix + indent (tree connectors included) and
+    // swap in the re-formatted body behind it.
+    auto splice = [&](int line, const QString& body) {
+        const int keep = kFoldCol + meta[line].depth * kTreeIndent;
+        return text.mid(starts[line], keep) + body.mid(meta[line].depth * kTreeIndent);
+    };
+
+    struct Patch { int line; QString text; LineMeta meta; };
+    QVector<Patch> patches;
+
+    for (int i = 0; i < n; ++i) {
+        const LineMeta& lm = meta[i];
+        if (lm.nodeIdx < 0 || lm.isPlaceholder || isSyntheticLine(lm)) continue;
+        if (lm.nodeIdx >= tree.nodes.size() || tree.nodes[lm.nodeIdx].id != lm.nodeId)
+            return false;
+        const Node& node = tree.nodes[lm.nodeIdx];
+
+        if (lm.isArrayElement) {
+            // Synthesized primitive array element (see composeParent).
+            const int elemSize = sizeForKind(node.elementKind);
+            if (lm.fmtTypeW < 0 || !dirty(lm.offsetAddr, elemSize)) continue;
+            Node elem;
+            elem.kind     = node.elementKind;
+            elem.offset   = node.offset + lm.arrayElementIdx * elemSize;
+            elem.parentId = node.id;
+            elem.id       = 0;
+            const QString elemTypeStr = fmt::typeNameRaw(node.elementKind)
+                                      + QStringLiteral("[%1]").arg(lm.arrayElementIdx);
+            patches.append({i, splice(i, fmt::fmtNodeLine(elem, prov, lm.offsetAddr, lm.depth, 0,
+                                                          {}, lm.fmtTypeW, lm.effectiveNameW,
+                                                          elemTypeStr, compactColumns)),
+                            lm});
+            continue;
+        }
+        if (lm.isMemberLine) {
+            // Enum members are static text; bitfield members show their bits.
+            if (node.isBitfield() && dirty(lm.offsetAddr, sizeForKind(node.elementKind)))
+                return false;
+            continue;
+        }
+        if (lm.fmtTypeW < 0) {
+            // Structural row. Headers, footers and braces carry no values —
+            // except a typed pointer's fold header, whose value decides what
+            // (and whether anything) is expanded underneath it.
+            if (lm.foldHead && (node.kind == NodeKind::Pointer32 || node.kind == NodeKind::Pointer64)
+                && dirty(lm.offsetAddr, node.byteSize()))
+                return false;
+            continue;
+        }
+
+        // composeLeaf row: re-run it for the whole node once, at subLine 0.
+        if (lm.subLine != 0) continue;
+        const int numLines = linesForKind(node.kind);
+        if (i + numLines > n) return false;
+        int size = node.byteSize();
+        if (size <= 0) size = sizeForKind(node.kind);
+        // A primitive pointer shows "-> <target value>", which lives outside
+        // its own bytes — always re-read it.
+        const bool derefs = (node.kind == NodeKind::Pointer32 || node.kind == NodeKind::Pointer64)
+                         && node.ptrDepth > 0 && node.refId == 0
+                         && isValidPrimitivePtrTarget(node.elementKind);
+        if (!derefs && !dirty(lm.offsetAddr, size)) {
+            i += numLines - 1;
+            continue;
+        }
+
+        state.text.clear();
+        state.meta.clear();
+        state.lineStarts.clear();
+        state.currentLine    = 0;
+        state.typeW          = lm.fmtTypeW;
+        state.nameW          = lm.effectiveNameW;
+        state.currentPtrBase = lm.ptrBase;
+        composeLeaf(state, tree, prov, lm.nodeIdx, lm.depth, lm.offsetAddr, /*scopeId=*/0);
+        if (state.meta.size() != numLines) return false;
+
+        for (int sub = 0; sub < numLines; ++sub) {
+            const int line = i + sub;
+            const int from = state.lineStarts[sub] + kFoldCol;
+            const int to   = sub + 1 < numLines ? state.lineStarts[sub + 1] - 1
+                                                : (int)state.text.size();
+            LineMeta nm = std::move(state.meta[sub]);
+            // Context composeLeaf can't see from the scratch state.
+            nm.parentAddr = meta[line].parentAddr;
+            nm.heatLevel  = meta[line].heatLevel;
+            patches.append({line, splice(line, state.text.mid(from, to - from)), std::move(nm)});
+        }
+        i += numLines - 1;
+    }
+
+    // Nothing can fail past this point — apply the patches.
+    QVector<QPair<int, int>> changedLines;
+    bool sameLength = true;
+    for (const Patch& p : patches) {
+        if (p.text.size() != lineEnd(p.line) - starts[p.line]) sameLength = false;
+    }
+    if (sameLength) {
+        for (const Patch& p : patches) {
+            const int start = starts[p.line];
+            if (text.mid(start, p.text.size()) == p.text) continue;
+            result.text.replace(start, p.text.size(), p.text);
+            if (!changedLines.isEmpty() && changedLines.last().second == p.line - 1)
+                changedLines.last().second = p.line;
+            else
+                changedLines.append({p.line, p.line});
+        }
+    } else {
+        // Line lengths moved: rebuild the text and shift lineStarts in one pass.
+        QString rebuilt;
+        rebuilt.reserve(result.text.size() + 64 * patches.size());
+        int copied = 0, shift = 0, next = 0;
+        for (int line = 0; line < n; ++line) {
+            const int oldStart = starts[line];
+            result.lineStarts[line] = oldStart + shift;
+            if (next >= patches.size() || patches[next].line != line) continue;
+            const Patch& p = patches[next++];
+            const int oldLen = lineEnd(line) - oldStart;   // lineEnd() reads the next, unshifted start
+            rebuilt.append(text.constData() + copied, oldStart - copied);
+            rebuilt.append(p.text);
+            copied = oldStart + oldLen;
+            shift += p.text.size() - oldLen;
+            if (text.mid(oldStart, oldLen) == p.text) continue;
+            if (!changedLines.isEmpty() && changedLines.last().second == line - 1)
+                changedLines.last().second = line;
+            else
+                changedLines.append({line, line});
+        }
+        rebuilt.append(text.constData() + copied, text.size() - copied);
+        result.text = std::move(rebuilt);
+    }
+
+    for (Patch& p : patches) {
+        // Longest line only grows here; a shrink leaves a little extra
+        // scroll width until the next full compose.
+        int len = p.text.size();
+        while (len > 0 && p.text[len - 1] == ' ') --len;
+        if (len > result.maxLineLen) result.maxLineLen = len;
+        result.meta[p.line] = std::move(p.meta);
+    }
+
+    result.baseRevision = result.revision;
+    result.revision     = nextComposeRevision();
+    result.changedLines = std::move(changedLines);
+    return true;
+}
+
 QSet<uint64_t> NodeTree::normalizePreferAncestors(const QSet<uint64_t>& ids) const {
     QSet<uint64_t> result;
     for (uint64_t id : ids) {
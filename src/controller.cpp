@@ -8,6 +8,8 @@
 #include "commontypes.h"
 #include "clipboard.h"
 #include "diffutil.h"
+#include "rcxb.h"
+#include "providers/mapped_file_provider.h"
 #include <cmath>
 #include <cstring>
 #include "providerregistry.h"
@@ -20,6 +22,7 @@
 #include <QSplitter>
 #include <QFile>
 #include <QFileInfo>
+#include <QSaveFile>
 #include <QDir>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -39,6 +42,7 @@
 #include <QMessageBox>
 #include <QSettings>
 #include <QRegularExpression>
+#include <QVarLengthArray>
 #include <QtConcurrent/QtConcurrentRun>
 #include <limits>
 
@@ -167,73 +171,329 @@ RcxDocument::RcxDocument(QObject* parent)
     connect(&undoStack, &QUndoStack::cleanChanged, this, [this](bool clean) {
         modified = !clean;
     });
+    connect(&m_saveWatcher, &QFutureWatcher<QString>::finished,
+            this, &RcxDocument::finishSave);
+    connect(&m_drainWatcher, &QFutureWatcher<QVector<QVector<Node>>>::finished,
+            this, [this]() { finishDeferredLoad(/*notify=*/true); });
+}
+
+RcxDocument::~RcxDocument() {
+    // A write in flight holds its own copy of the tree; let it land.
+    m_saveWatcher.waitForFinished();
+    m_drainWatcher.waitForFinished();
+}
+
+void RcxDocument::appendClassBody(const QVector<Node>& body) {
+    tree.nodes.reserve(tree.nodes.size() + body.size());
+    for (const Node& n : body) tree.nodes.append(n);
+}
+
+bool RcxDocument::ensureClassLoaded(uint64_t nodeId) {
+    if (m_deferred.isEmpty()) return false;
+    bool loaded = false;
+    QVector<uint64_t> pending{nodeId};
+    QSet<uint64_t> seen;
+    while (!pending.isEmpty()) {
+        // Climb to the class root. References almost always name a root;
+        // one into a body that isn't decoded yet waits for the drain.
+        uint64_t cur = pending.takeLast();
+        for (int guard = 0; cur != 0 && guard < 64; ++guard) {
+            const int idx = tree.indexOfId(cur);
+            if (idx < 0 || tree.nodes[idx].parentId == 0) break;
+            cur = tree.nodes[idx].parentId;
+        }
+        if (seen.contains(cur)) continue;
+        seen.insert(cur);
+        auto it = m_deferred.find(cur);
+        if (it == m_deferred.end()) continue;
+        const QVector<Node> body = m_rcxb->readClassBody(it.value());
+        m_deferred.erase(it);
+        appendClassBody(body);
+        tree.invalidateIdCache();
+        for (const Node& n : body)
+            if (n.refId) pending.append(n.refId);
+        loaded = true;
+    }
+    if (loaded) tree.touch();
+    if (m_deferred.isEmpty()) dropDeferred();
+    return loaded;
+}
+
+void RcxDocument::ensureFullyLoaded() {
+    if (m_deferred.isEmpty()) return;
+    if (m_drainWatcher.isRunning()) m_drainWatcher.waitForFinished();
+    // The caller refreshes after its own change; no documentChanged here.
+    finishDeferredLoad(/*notify=*/false);
+}
+
+// Appends every body still deferred: the drain's, or decoded here if the
+// drain never ran. Classes ensureClassLoaded took meanwhile are skipped.
+void RcxDocument::finishDeferredLoad(bool notify) {
+    if (m_deferred.isEmpty()) return;
+    QVector<QVector<Node>> bodies;
+    QVector<uint64_t> roots;
+    if (m_drainWatcher.isFinished() && !m_drainWatcher.isCanceled()
+        && m_drainWatcher.future().resultCount() > 0) {
+        bodies = m_drainWatcher.result();
+        roots = m_drainRoots;
+    }
+    for (int i = 0; i < roots.size() && i < bodies.size(); ++i) {
+        if (!m_deferred.remove(roots[i])) continue;
+        appendClassBody(bodies[i]);
+    }
+    if (!m_deferred.isEmpty()) {
+        QVector<int> classes;
+        roots.clear();
+        for (auto it = m_deferred.constBegin(); it != m_deferred.constEnd(); ++it) {
+            roots.append(it.key());
+            classes.append(it.value());
+        }
+        bodies = m_rcxb->readClassBodies(classes);
+        for (const QVector<Node>& body : bodies) appendClassBody(body);
+    }
+    dropDeferred();
+    tree.invalidateIdCache();
+    tree.touch();
+    auto vr = tree.validate(/*repair=*/true);
+    if (!vr.clean())
+        qWarning() << "[load] tree validation:" << filePath << vr.summary();
+    if (notify) emit documentChanged();
+}
+
+void RcxDocument::dropDeferred() {
+    m_deferred.clear();
+    m_drainRoots.clear();
+    m_rcxb.reset();   // a running drain holds its own reference
 }
 
 ComposeResult RcxDocument::compose(uint64_t viewRootId, bool compactColumns,
                                    bool treeLines, bool braceWrap, bool typeHints,
                                    bool showComments,
-                                   SymbolLookupFn symbolLookup) const {
+                                   SymbolLookupFn symbolLookup,
+                                   ComposeWindow window) const {
     return rcx::compose(tree, *provider, viewRootId, compactColumns, treeLines, braceWrap, typeHints,
-                        showComments, std::move(symbolLookup));
+                        showComments, std::move(symbolLookup), /*showRtti=*/true,
+                        /*showEnumChips=*/true, /*rttiCache=*/nullptr, window);
 }
 
-bool RcxDocument::save(const QString& path) {
-    QJsonObject json = tree.toJson();
+namespace {
 
-    // Save type aliases
-    if (!typeAliases.isEmpty()) {
+// The bytes save() writes to `path`: the extension picks the format, and
+// load() tells them apart by content. Pure function of its arguments, so
+// it runs on a pool thread against a snapshot.
+QByteArray encodeProject(const NodeTree& tree, const QHash<NodeKind, QString>& aliases,
+                         const QString& path, QJsonObject extras) {
+    if (!aliases.isEmpty()) {
         QJsonObject aliasObj;
-        for (auto it = typeAliases.begin(); it != typeAliases.end(); ++it)
+        for (auto it = aliases.begin(); it != aliases.end(); ++it)
             aliasObj[kindToString(it.key())] = it.value();
-        json["typeAliases"] = aliasObj;
+        extras["typeAliases"] = aliasObj;
     }
+    if (path.endsWith(QStringLiteral(".rcxb"), Qt::CaseInsensitive))
+        return encodeRcxb(tree, extras);
+    QJsonObject json = tree.toJson();
+    for (auto it = extras.begin(); it != extras.end(); ++it)
+        json.insert(it.key(), it.value());
+    return QJsonDocument(json).toJson(QJsonDocument::Indented);
+}
 
-    QJsonDocument jdoc(json);
-    QFile file(path);
+// QSaveFile: the previous file stays intact until the new one is complete,
+// so a crash mid-write can't leave a truncated project behind. Returns the
+// error, empty on success.
+QString writeProjectFile(const QString& path, const QByteArray& bytes) {
+    QSaveFile file(path);
     if (!file.open(QIODevice::WriteOnly))
+        return file.errorString();
+    if (file.write(bytes) != bytes.size()) {
+        const QString err = file.errorString();
+        file.cancelWriting();
+        return err;
+    }
+    if (!file.commit())
+        return file.errorString();
+    return {};
+}
+
+} // namespace
+
+bool RcxDocument::save(const QString& path) {
+    waitForSave();
+    ensureFullyLoaded();
+    // Stamped like a shadow, so a journal left behind by a crash replays
+    // only what came after this write.
+    QJsonObject extras;
+    extras["journalSeq"] = QString::number(journal.seq());
+    const QString err = writeProjectFile(path, encodeProject(tree, typeAliases, path, extras));
+    if (!err.isEmpty()) {
+        qWarning().noquote() << "[save]" << path << "failed:" << err;
         return false;
-    file.write(jdoc.toJson(QJsonDocument::Indented));
+    }
     filePath = path;
     undoStack.setClean();
     modified = false;
+    m_unjournaledEdits = false;
+    // The file now holds every edit: no recovery state left to keep.
+    retargetJournal(path);
+    journal.reset();
+    QFile::remove(path + QStringLiteral(".autosave"));
     return true;
 }
 
+void RcxDocument::saveInBackground(const QString& path) {
+    waitForSave();   // one write per document at a time
+    ensureFullyLoaded();
+    retargetJournal(path);
+    filePath = path;
+    undoStack.setClean();
+    modified = false;
+
+    PendingSave job;
+    job.path = path;
+    job.journalSeq = journal.seq();
+    job.cleanIndex = undoStack.cleanIndex();
+    // A crash between the commit and the compaction in finishSave() leaves
+    // entries the file already has in the journal: the stamp skips them.
+    QJsonObject extras;
+    extras["journalSeq"] = QString::number(job.journalSeq);
+    startWrite(job, extras);
+}
+
+bool RcxDocument::autosaveInBackground() {
+    if (isSaving() || filePath.isEmpty()) return false;
+    ensureFullyLoaded();
+    PendingSave job;
+    job.path = filePath + QStringLiteral(".autosave");
+    job.shadow = true;
+    job.journalSeq = journal.seq();
+    QJsonObject extras;
+    extras["journalSeq"] = QString::number(job.journalSeq);
+    startWrite(job, extras);
+    return true;
+}
+
+void RcxDocument::startWrite(const PendingSave& job, const QJsonObject& extras) {
+    m_pendingSave = job;
+    m_pendingSave->unjournaled = m_unjournaledEdits;
+    m_unjournaledEdits = false;   // edits made during the write set it again
+    // Copying the tree shares its node storage; the first edit after this
+    // detaches the UI's copy, never the worker's.
+    m_saveWatcher.setFuture(QtConcurrent::run(
+        [snapshot = tree, aliases = typeAliases, path = job.path, extras]() {
+            return writeProjectFile(path, encodeProject(snapshot, aliases, path, extras));
+        }));
+}
+
+void RcxDocument::finishSave() {
+    if (!m_pendingSave) return;   // already handled by waitForSave()
+    const PendingSave job = *m_pendingSave;
+    m_pendingSave.reset();
+    const QString err = m_saveWatcher.future().result();
+
+    if (err.isEmpty()) {
+        // The file covers the journal up to the snapshot; edits made while
+        // it was being written stay journaled.
+        journal.compact(job.journalSeq);
+        if (!job.shadow)
+            QFile::remove(job.path + QStringLiteral(".autosave"));
+    } else {
+        qWarning().noquote() << (job.shadow ? "[autosave]" : "[save]")
+                             << job.path << "failed:" << err;
+        m_unjournaledEdits |= job.unjournaled;
+        // Nothing reached disk: unless the user moved the clean point
+        // since, the document isn't saved after all.
+        if (!job.shadow && undoStack.cleanIndex() == job.cleanIndex)
+            undoStack.resetClean();
+    }
+    if (!job.shadow)
+        emit saveFinished(job.path, err.isEmpty(), err);
+}
+
+bool RcxDocument::waitForSave(QString* errorMsg) {
+    if (!m_pendingSave) return true;
+    m_saveWatcher.waitForFinished();
+    const QString err = m_saveWatcher.future().result();
+    finishSave();
+    if (errorMsg) *errorMsg = err;
+    return err.isEmpty();
+}
+
+// Saving under a new name starts a new journal next to the new file; the
+// old file's journal described edits that now live elsewhere.
+void RcxDocument::retargetJournal(const QString& path) {
+    const QString journalPath = path + QStringLiteral(".journal");
+    if (journal.path() == journalPath) return;
+    journal.reset();
+    journal.open(journalPath);
+}
+
 bool RcxDocument::load(const QString& path) {
     PROFILE_SCOPE("RcxDocument::load");
     QFile file(path);
     if (!file.open(QIODevice::ReadOnly))
         return false;
-    QByteArray bytes;
-    {
-        PROFILE_SCOPE("RcxDocument::load.read");
-        bytes = file.readAll();
-    }
 
-    // Empty file → fresh empty project (legitimate edge case: a brand-new
-    // .rcx the user just touched). Any non-empty file MUST parse as JSON;
-    // otherwise we'd silently swallow raw binaries (e.g. a .png picked
-    // through "All Files (*)") and present them as a "struct NoName"
-    // placeholder, which looks like a bug to the user.
-    QJsonParseError jerr;
-    QJsonDocument jdoc;
-    {
-        PROFILE_SCOPE("RcxDocument::load.json-parse");
-        jdoc = bytes.isEmpty()
-            ? QJsonDocument(QJsonObject{})
-            : QJsonDocument::fromJson(bytes, &jerr);
-    }
-    if (jdoc.isNull() || !jdoc.isObject()) {
-        qWarning().noquote() << "[load]" << path << "isn't a Reclass project ("
-                             << (jdoc.isNull() ? jerr.errorString()
-                                               : QStringLiteral("not a JSON object"))
-                             << ") — refuse rather than show Untitled placeholder";
-        return false;
-    }
+    // Whatever the previous load still had deferred belongs to that tree.
+    m_drainWatcher.waitForFinished();
+    dropDeferred();
+
+    QJsonObject root;
+    if (isRcxb(file.peek(4))) {
+        // Binary project: mapped, and only the class roots decoded now.
+        file.close();
+        auto reader = std::make_shared<RcxbReader>();
+        QString err;
+        if (!reader->open(path, &err)) {
+            qWarning().noquote() << "[load]" << path << "isn't a readable .rcxb ("
+                                 << err << ")";
+            return false;
+        }
+        undoStack.clear();
+        root = reader->meta();
+        PROFILE_SCOPE("RcxDocument::load.tree-from-rcxb");
+        tree = reader->readSkeleton();
+        for (int c = 0; c < reader->classCount(); ++c)
+            m_deferred.insert(reader->classInfo(c).id, c);
+        if (!m_deferred.isEmpty()) {
+            m_rcxb = reader;
+            QVector<int> classes;
+            for (auto it = m_deferred.constBegin(); it != m_deferred.constEnd(); ++it) {
+                m_drainRoots.append(it.key());
+                classes.append(it.value());
+            }
+            m_drainWatcher.setFuture(QtConcurrent::run([reader, classes]() {
+                return reader->readClassBodies(classes);
+            }));
+        }
+    } else {
+        QByteArray bytes;
+        {
+            PROFILE_SCOPE("RcxDocument::load.read");
+            bytes = file.readAll();
+        }
 
-    undoStack.clear();
-    QJsonObject root = jdoc.object();
-    {
+        // Empty file → fresh empty project (legitimate edge case: a brand-new
+        // .rcx the user just touched). Any non-empty file MUST parse as JSON;
+        // otherwise we'd silently swallow raw binaries (e.g. a .png picked
+        // through "All Files (*)") and present them as a "struct NoName"
+        // placeholder, which looks like a bug to the user.
+        QJsonParseError jerr;
+        QJsonDocument jdoc;
+        {
+            PROFILE_SCOPE("RcxDocument::load.json-parse");
+            jdoc = bytes.isEmpty()
+                ? QJsonDocument(QJsonObject{})
+                : QJsonDocument::fromJson(bytes, &jerr);
+        }
+        if (jdoc.isNull() || !jdoc.isObject()) {
+            qWarning().noquote() << "[load]" << path << "isn't a Reclass project ("
+                                 << (jdoc.isNull() ? jerr.errorString()
+                                                   : QStringLiteral("not a JSON object"))
+                                 << ") — refuse rather than show Untitled placeholder";
+            return false;
+        }
+
+        undoStack.clear();
+        root = jdoc.object();
         PROFILE_SCOPE("RcxDocument::load.tree-from-json");
         tree = NodeTree::fromJson(root);
     }
@@ -300,6 +560,8 @@ bool RcxDocument::load(const QString& path) {
         }
     }
 
+    m_loadJournalSeq = root["journalSeq"].toString().toULongLong();
+
     filePath = path;
     modified = false;
     emit documentChanged();
@@ -308,17 +570,40 @@ bool RcxDocument::load(const QString& path) {
 
 void RcxDocument::loadData(const QString& binaryPath) {
     PROFILE_SCOPE("RcxDocument::loadData(path)");
-    QFile file(binaryPath);
-    if (!file.open(QIODevice::ReadOnly))
-        return;
-    undoStack.clear();
-    provider = std::make_shared<BufferProvider>(
-        file.readAll(), QFileInfo(binaryPath).fileName());
+    // Map rather than read: a multi-GB dump opens instantly and past the
+    // 2 GB a QByteArray can hold. Files that can't be mapped (empty, a
+    // pipe) still load into memory.
+    auto mapped = std::make_shared<MappedFileProvider>(binaryPath);
+    if (mapped->isMapped()) {
+        undoStack.clear();
+        provider = std::move(mapped);
+    } else {
+        QFile file(binaryPath);
+        if (!file.open(QIODevice::ReadOnly))
+            return;
+        undoStack.clear();
+        provider = std::make_shared<BufferProvider>(
+            file.readAll(), QFileInfo(binaryPath).fileName());
+    }
     dataPath = binaryPath;
     tree.baseAddress = 0;
     emit documentChanged();
 }
 
+bool RcxDocument::saveData(QString* errorMsg) {
+    auto* mapped = dynamic_cast<MappedFileProvider*>(provider.get());
+    if (!mapped) {
+        if (errorMsg) *errorMsg = QStringLiteral("Source is not a mapped file");
+        return false;
+    }
+    return mapped->save(errorMsg);
+}
+
+bool RcxDocument::hasUnsavedData() const {
+    auto* mapped = dynamic_cast<MappedFileProvider*>(provider.get());
+    return mapped && mapped->isDirty();
+}
+
 void RcxDocument::loadData(const QByteArray& data) {
     PROFILE_SCOPE("RcxDocument::loadData(bytes)");
     undoStack.clear();
@@ -344,12 +629,18 @@ static bool isTransientCommand(const Command& cmd) {
     return std::holds_alternative<cmd::WriteBytes>(cmd);
 }
 
+// Applied commands are journaled as they happen so a crash loses nothing
+// between autosaves.
 void RcxCommand::undo() {
-    if (!m_ctrl->applyCommand(m_cmd, true) && !isTransientCommand(m_cmd))
+    if (m_ctrl->applyCommand(m_cmd, true))
+        m_ctrl->document()->journal.append(m_cmd, true);
+    else if (!isTransientCommand(m_cmd))
         setObsolete(true);
 }
 void RcxCommand::redo() {
-    if (!m_ctrl->applyCommand(m_cmd, false) && !isTransientCommand(m_cmd))
+    if (m_ctrl->applyCommand(m_cmd, false))
+        m_ctrl->document()->journal.append(m_cmd, false);
+    else if (!isTransientCommand(m_cmd))
         setObsolete(true);
 }
 
@@ -411,11 +702,14 @@ RcxController::~RcxController() {
         m_refreshWatcher->cancel();
         m_refreshWatcher->waitForFinished();
     }
+    m_sampler.reset();
 
     m_snapshotProv.reset();
 }
 
 void RcxController::resetProvider() {
+    stopRecording();
+    m_sampler.reset();
     m_snapshotProv.reset();
 }
 
@@ -665,6 +959,8 @@ void RcxController::addByteSubmenu(QMenu& menu, RcxEditor* editor) {
 }
 
 void RcxController::connectEditor(RcxEditor* editor) {
+    connect(editor, &RcxEditor::viewportScrolled,
+            this, &RcxController::onEditorScrolled);
     connect(editor, &RcxEditor::marginClicked,
             this, [this, editor](int margin, int line, Qt::KeyboardModifiers mods) {
         handleMarginClick(editor, margin, line, mods);
@@ -1895,7 +2191,6 @@ void RcxController::setTrackValues(bool on) {
     if (!on) {
         m_valueHistory.clear();
         m_lastValueAddr.clear();
-        m_lastValueBytes.clear();
         for (auto& lm : m_lastResult.meta)
             lm.heatLevel = 0;
         refresh();
@@ -1906,19 +2201,124 @@ void RcxController::resetChangeTracking() {
     m_changedOffsets.clear();
     m_valueHistory.clear();
     m_lastValueAddr.clear();
-    m_lastValueBytes.clear();
     m_prevPages.clear();
     m_valueTrackCooldown = 5; // suppress tracking for ~1s
     for (auto& lm : m_lastResult.meta)
         lm.heatLevel = 0;
 }
 
+// Column encoding for a recorded field: integers delta-encode, floats and
+// everything wider than a machine word are stored as-is.
+static SeriesEncoding seriesEncodingFor(NodeKind k) {
+    switch (k) {
+    case NodeKind::Int8: case NodeKind::Int16: case NodeKind::Int32: case NodeKind::Int64:
+        return SeriesEncoding::Signed;
+    case NodeKind::UInt8: case NodeKind::UInt16: case NodeKind::UInt32: case NodeKind::UInt64:
+    case NodeKind::Hex8: case NodeKind::Hex16: case NodeKind::Hex32: case NodeKind::Hex64:
+    case NodeKind::Bool:
+    case NodeKind::Pointer32: case NodeKind::Pointer64:
+    case NodeKind::FuncPtr32: case NodeKind::FuncPtr64:
+        return SeriesEncoding::Unsigned;
+    case NodeKind::Float: case NodeKind::Double:
+        return SeriesEncoding::Float;
+    default:
+        return SeriesEncoding::Raw;
+    }
+}
+
+bool RcxController::startRecording(const QVector<uint64_t>& nodeIds, const QString& path,
+                                   int intervalMs, QString* err) {
+    stopRecording();
+    if (!m_doc->provider || !m_doc->provider->isValid()) {
+        if (err) *err = QStringLiteral("No data source attached.");
+        return false;
+    }
+
+    QVector<SeriesRecorder::Field> fields;
+    for (uint64_t id : nodeIds) {
+        int idx = m_doc->tree.indexOfId(id);
+        if (idx < 0) {
+            if (err) *err = QStringLiteral("Node %1 not found.").arg(id);
+            return false;
+        }
+        const Node& node = m_doc->tree.nodes[idx];
+        int sz = node.byteSize();
+        if (node.kind == NodeKind::Struct || node.kind == NodeKind::Array || sz <= 0) {
+            if (err) *err = QStringLiteral("Node %1 (%2) is not a value field.").arg(id).arg(node.name);
+            return false;
+        }
+        // Prefer the composed address (right for pointer-expanded nodes).
+        bool found = false;
+        uint64_t addr = 0;
+        for (const auto& lm : m_lastResult.meta) {
+            if (lm.nodeId == id && lm.lineKind == LineKind::Field && !isSyntheticLine(lm)) {
+                addr = lm.offsetAddr;
+                found = true;
+                break;
+            }
+        }
+        if (!found) addr = m_doc->tree.absoluteAddress(idx);
+
+        SeriesRecorder::Field f;
+        f.column.nodeId   = id;
+        f.column.name     = node.name;
+        f.column.encoding = seriesEncodingFor(node.kind);
+        f.column.width    = sz;
+        f.addr            = addr;
+        f.bigEndian       = node.bigEndian;
+        fields.append(f);
+    }
+
+    auto rec = std::make_shared<SeriesRecorder>();
+    if (!rec->start(path, fields, err)) return false;
+    m_recorder = std::move(rec);
+    m_lastRecordingPath = path;
+    m_recordEpochUs = QDateTime::currentMSecsSinceEpoch() * 1000;
+    m_recordClock.start();
+
+    // A timed recording reads the live provider on its own thread; doing
+    // that from a UI timer would put a synchronous read on every slot.
+    if (intervalMs > 0)
+        m_recordThread = std::make_unique<SeriesRecordThread>(
+            m_recorder, m_doc->provider, qint64(intervalMs) * 1000, m_recordEpochUs);
+    hookSamplerRecorder();
+    return true;
+}
+
+void RcxController::stopRecording() {
+    if (m_sampler) m_sampler->setPassHook({});
+    m_recordThread.reset();   // joins: no sample in flight after this
+    m_recorder.reset();       // writes the final partial block
+}
+
+// A tick-driven recording follows the page sampler when one runs: every
+// pass is recorded on the sampler thread, not just the frames the UI
+// takes, and the UI thread never samples.
+void RcxController::hookSamplerRecorder() {
+    if (!m_sampler) return;
+    if (!m_recorder || m_recordThread) {
+        m_sampler->setPassHook({});
+        return;
+    }
+    m_sampler->setPassHook([rec = m_recorder](const Provider& pages, qint64 timeUs) {
+        rec->sample(pages, timeUs);
+    });
+}
+
+void RcxController::sampleRecording(const Provider& prov) {
+    if (!isRecording()) return;
+    m_recorder->sample(prov, m_recordEpochUs + m_recordClock.nsecsElapsed() / 1000);
+}
+
 void RcxController::refresh() {
     PROFILE_SCOPE("refresh");
     // Bracket compose with thread-local doc pointer for type name resolution.
     // RAII guard restores the previous value on scope exit — safe against any
     // exception compose might throw.
     ComposeDocGuard composeGuard(m_doc);
+    // The viewed class and what it references, if an .rcxb load deferred them.
+    if (m_viewRootId != 0 && m_doc->hasDeferredClasses())
+        m_doc->ensureClassLoaded(m_viewRootId);
 
     // Build symbol lookup callback. The unified NameRegistry aggregates
     // every registered NameProvider (PDB + RTTI + bookmarks + future
@@ -1935,52 +2335,74 @@ void RcxController::refresh() {
     // they still get symbol annotations, just without demangling.
     SymbolLookupFn symLookup;
     if (m_doc->provider) {
-        auto* prov = m_doc->provider.get();
-        symLookup = [prov](uint64_t addr) -> QString {
+        symLookup = [prov = m_doc->provider](uint64_t addr) -> QString {
             if (g_nameLookupHook) return g_nameLookupHook(addr, prov);
-            return SymbolStore::instance().getSymbolForAddress(addr, prov);
+            return SymbolStore::instance().getSymbolForAddress(addr, prov.get());
         };
     }
 
+    // Value-only tick over an unchanged layout: re-format just the rows
+    // whose bytes moved. Anything structural falls back to a full compose.
+    ComposeKey key;
+    key.generation  = m_doc->tree.generation();
+    key.viewRootId  = m_viewRootId;
+    key.baseAddress = m_doc->tree.baseAddress;
+    key.flags = (m_compactColumns ? 1 : 0) | (m_treeLines ? 2 : 0) | (m_braceWrap ? 4 : 0)
+              | (m_typeHints ? 8 : 0) | (m_showComments ? 16 : 0) | (m_showRtti ? 32 : 0)
+              | (m_showEnumChips ? 64 : 0) | (m_snapshotProv ? 128 : 0);
+    // The window only matters while the last result still has placeholder
+    // rows; a fully materialized result stays valid wherever we scroll.
+    const ComposeWindow window = composeWindow();
+    bool incremental = false;
+    if (m_valueTick && m_snapshotProv && key == m_composedKey
+        && (m_lastResult.placeholderLines == 0 || window == m_composedWindow)) {
+        incremental = rcx::recomposeChanged(m_lastResult, m_doc->tree, *m_snapshotProv,
+                                            m_changedOffsets, m_compactColumns, m_typeHints,
+                                            m_showComments, symLookup, m_showRtti,
+                                            m_showEnumChips, &m_rttiCache);
+    }
+
     // Compose against snapshot provider if active, otherwise real provider
-    if (m_snapshotProv)
-        m_lastResult = rcx::compose(m_doc->tree, *m_snapshotProv, m_viewRootId, m_compactColumns, m_treeLines, m_braceWrap, m_typeHints, m_showComments, symLookup, m_showRtti, m_showEnumChips);
-    else
-        m_lastResult = m_doc->compose(m_viewRootId, m_compactColumns, m_treeLines, m_braceWrap, m_typeHints, m_showComments, symLookup);
+    if (incremental) {
+        // Patched in place — drop the previous tick's change marks.
+        for (auto& lm : m_lastResult.meta) {
+            lm.dataChanged = false;
+            lm.changedByteIndices.clear();
+        }
+    } else if (m_snapshotProv) {
+        m_lastResult = rcx::compose(m_doc->tree, *m_snapshotProv, m_viewRootId, m_compactColumns, m_treeLines, m_braceWrap, m_typeHints, m_showComments, symLookup, m_showRtti, m_showEnumChips, &m_rttiCache, window);
+        m_composedWindow = window;
+    } else {
+        m_lastResult = m_doc->compose(m_viewRootId, m_compactColumns, m_treeLines, m_braceWrap, m_typeHints, m_showComments, symLookup, window);
+        m_composedWindow = window;
+    }
+    m_composedKey = key;
 
     // Mark lines whose node data changed since last refresh
     if (!m_changedOffsets.isEmpty()) {
-        // Build childMap once for structSpan lookups (avoids O(N) cache rebuilds per call)
-        QHash<uint64_t, QVector<int>> childMap;
-        for (int i = 0; i < m_doc->tree.nodes.size(); i++)
-            childMap[m_doc->tree.nodes[i].parentId].append(i);
-
+        // structSpan walks the tree's cached CSR child index, which is only
+        // rebuilt when the tree changes, not on every value tick.
         for (auto& lm : m_lastResult.meta) {
             if (lm.nodeIdx < 0 || lm.nodeIdx >= m_doc->tree.nodes.size()) continue;
-            // Use compose's precomputed absolute address (avoids per-line parent-chain walk)
-            int64_t offset = (int64_t)(lm.offsetAddr - m_doc->tree.baseAddress);
+            if (lm.isPlaceholder) continue;
+            // Use compose's precomputed absolute address (avoids per-line
+            // parent-chain walk); the page diff keys changes the same way.
+            int64_t offset = (int64_t)lm.offsetAddr;
             const Node& node = m_doc->tree.nodes[lm.nodeIdx];
 
             if (isHexPreview(node.kind)) {
                 // Per-byte tracking for hex preview nodes
-                int lineOff = 0;
-                int byteCount = lm.lineByteCount;
-                for (int b = 0; b < byteCount; b++) {
-                    if (m_changedOffsets.contains(offset + lineOff + b)) {
-                        lm.changedByteIndices.append(b);
-                        lm.dataChanged = true;
-                    }
-                }
+                m_changedOffsets.forEachInRange(offset, offset + lm.lineByteCount,
+                                                [&](int64_t b) {
+                    lm.changedByteIndices.append(int(b - offset));
+                    lm.dataChanged = true;
+                });
             } else {
                 // Use structSpan for containers (byteSize returns 0 for Array-of-Struct)
                 int sz = (node.kind == NodeKind::Struct || node.kind == NodeKind::Array)
-                    ? m_doc->tree.structSpan(node.id, &childMap) : node.byteSize();
-                for (int64_t b = offset; b < offset + sz; b++) {
-                    if (m_changedOffsets.contains(b)) {
-                        lm.dataChanged = true;
-                        break;
-                    }
-                }
+                    ? m_doc->tree.structSpan(node.id) : node.byteSize();
+                if (m_changedOffsets.anyInRange(offset, offset + sz))
+                    lm.dataChanged = true;
             }
         }
     }
@@ -1998,7 +2420,7 @@ void RcxController::refresh() {
         if (m_trackValues && prov && m_valueTrackCooldown <= 0) {
             for (auto& lm : m_lastResult.meta) {
                 if (lm.nodeIdx < 0 || lm.nodeIdx >= m_doc->tree.nodes.size()) continue;
-                if (isSyntheticLine(lm) || lm.isContinuation) continue;
+                if (isSyntheticLine(lm) || lm.isContinuation || lm.isPlaceholder) continue;
                 if (lm.lineKind != LineKind::Field) continue;
 
                 const Node& node = m_doc->tree.nodes[lm.nodeIdx];
@@ -2011,64 +2433,75 @@ void RcxController::refresh() {
                 // Use the absolute address from compose (correct for pointer-expanded nodes)
                 uint64_t addr = lm.offsetAddr;
                 int sz = node.byteSize();
-                if (sz <= 0 || !prov->isReadable(addr, sz)) continue;
-
-                QString val = fmt::readValue(node, *prov, addr, lm.subLine);
-                if (!val.isEmpty()) {
-                    // Clear stale history if this node's effective address changed
-                    // (e.g. viewRoot switch, pointer expand/collapse, MCP restructure)
-                    auto addrIt = m_lastValueAddr.find(lm.nodeId);
-                    if (addrIt != m_lastValueAddr.end() && addrIt.value() != addr) {
-                        m_valueHistory.remove(lm.nodeId);
-                        m_lastValueBytes.remove(lm.nodeId);
+                if (sz <= 0) continue;
+
+                // A primitive pointer that dereferences its target displays
+                // "-> <value>", so its meaningful value lives at *ptr, not in
+                // the pointer's own bytes. Mirrors readValueImpl's deref
+                // condition exactly (format.cpp Pointer64 case): Pointer32
+                // never dereferences and a null pointer shows "nullptr".
+                const bool derefKind = node.kind == NodeKind::Pointer64
+                    && node.ptrDepth > 0 && node.refId == 0
+                    && isValidPrimitivePtrTarget(node.elementKind);
+
+                // Clear stale history if this node's effective address changed
+                // (e.g. viewRoot switch, pointer expand/collapse, MCP restructure)
+                auto addrIt = m_lastValueAddr.find(lm.nodeId);
+                auto histIt = m_valueHistory.find(lm.nodeId);
+                if (addrIt != m_lastValueAddr.end() && addrIt.value() != addr) {
+                    if (histIt != m_valueHistory.end()) {
+                        m_valueHistory.erase(histIt);
+                        histIt = m_valueHistory.end();
                     }
-                    m_lastValueAddr[lm.nodeId] = addr;
-
-                    // Change-detection keys on the underlying RAW BYTES, not the
-                    // formatted display string. Reformatting identical bytes —
-                    // Hex64 "0x0" -> Pointer64 "nullptr", an endianness/RVA flag
-                    // toggle, etc. — must NOT count as a value change. Keying on
-                    // the string lit up the heatmap and fired the previous-values
-                    // popup on those no-op reformats (user: "nullptr and 0 are the
-                    // same value underneath, it's annoying").
-                    //
-                    // Exception: a primitive pointer that DEREFERENCES its target
-                    // displays "-> <value>", so its meaningful value lives at
-                    // *ptr, not in the pointer's own bytes. For those we keep
-                    // string-based detection so a target-memory change still
-                    // registers even when the pointer itself is fixed.
-                    //
-                    // This must mirror readValueImpl's deref condition EXACTLY
-                    // (format.cpp Pointer64 case): only a *non-null Pointer64*
-                    // with ptrDepth>0 + a valid primitive target dereferences.
-                    // Pointer32 NEVER dereferences (always shows the address), and
-                    // a null pointer shows "nullptr" (no deref) — both belong on
-                    // the byte path. Including Pointer32 / null here would wrongly
-                    // route them to string-detection and re-expose the very
-                    // format-only-firing bug this guard fixes.
-                    bool derefsTarget = false;
-                    if (node.kind == NodeKind::Pointer64
-                        && node.ptrDepth > 0 && node.refId == 0
-                        && isValidPrimitivePtrTarget(node.elementKind)) {
-                        derefsTarget = (prov->readU64(addr) != 0);
+                    addrIt.value() = addr;
+                } else if (addrIt == m_lastValueAddr.end()) {
+                    m_lastValueAddr.insert(lm.nodeId, addr);
+                }
+
+                // On a value-only tick every snapshot page was diffed, so a
+                // field with no changed byte still holds its newest sample.
+                // Deref targets may sit outside the snapshot; always re-read.
+                if (m_valueTick && !derefKind && histIt != m_valueHistory.end()
+                    && histIt->count > 0) {
+                    if (!m_changedOffsets.anyInRange((int64_t)addr, (int64_t)addr + sz)) {
+                        lm.heatLevel = histIt->heatLevel();
+                        continue;
                     }
+                }
 
-                    bool shouldRecord;
-                    if (derefsTarget) {
-                        // record()'s internal string dedup decides.
-                        shouldRecord = true;
-                    } else {
-                        QByteArray rawBytes = prov->readBytes(addr, sz);
-                        auto bytesIt = m_lastValueBytes.find(lm.nodeId);
-                        shouldRecord = (bytesIt == m_lastValueBytes.end()
-                                        || bytesIt.value() != rawBytes);
-                        if (shouldRecord)
-                            m_lastValueBytes[lm.nodeId] = rawBytes;
+                if (!prov->isReadable(addr, sz)) continue;
+
+                // Change detection keys on the RAW BYTES, not a formatted
+                // string: reformatting identical bytes — Hex64 "0x0" ->
+                // Pointer64 "nullptr", an endianness/RVA flag toggle — must
+                // NOT count as a value change (user: "nullptr and 0 are the
+                // same value underneath, it's annoying").
+                uint64_t readAddr = addr;
+                int readLen = sz;
+                uint8_t flags = 0;
+                if (derefKind) {
+                    uint64_t target = prov->readU64(addr);
+                    if (target != 0) {
+                        for (int d = 1; d < node.ptrDepth && target != 0; d++)
+                            target = prov->isReadable(target, 8) ? prov->readU64(target) : 0;
+                        Node tmp;
+                        tmp.kind = node.elementKind;
+                        tmp.strLen = node.strLen;
+                        int tsz = tmp.byteSize();
+                        if (target != 0 && tsz > 0 && prov->isReadable(target, tsz)) {
+                            readAddr = target;
+                            readLen = tsz;
+                            flags = ValueHistory::kDeref;
+                        }
                     }
-                    if (shouldRecord)
-                        m_valueHistory[lm.nodeId].record(val);
-                    lm.heatLevel = m_valueHistory[lm.nodeId].heatLevel();
                 }
+
+                QVarLengthArray<uint8_t, 64> raw(readLen);
+                if (!prov->read(readAddr, raw.data(), readLen)) continue;
+                if (histIt == m_valueHistory.end())
+                    histIt = m_valueHistory.insert(lm.nodeId, ValueHistory());
+                histIt->record(raw.constData(), readLen, flags);
+                lm.heatLevel = histIt->heatLevel();
             }
         }
     }
@@ -2679,6 +3112,7 @@ void RcxController::insertNodeAbove(int beforeIdx, NodeKind kind, const QString&
 
 void RcxController::removeNode(int nodeIdx) {
     if (nodeIdx < 0 || nodeIdx >= m_doc->tree.nodes.size()) return;
+    m_doc->ensureFullyLoaded();   // the subtree below must be complete
     const Node& node = m_doc->tree.nodes[nodeIdx];
     uint64_t nodeId = node.id;
     uint64_t parentId = node.parentId;
@@ -2992,6 +3426,9 @@ bool RcxController::writeSelectedBytesToFile(uint64_t addr, int n,
 }
 
 bool RcxController::applyCommand(const Command& command, bool isUndo) {
+    // Reads are lazy, edits aren't: no command runs against a tree with
+    // class bodies still deferred.
+    m_doc->ensureFullyLoaded();
     auto& tree = m_doc->tree;
     bool success = true;
     // Every command that reaches here mutates tree state in some way (the
@@ -3009,7 +3446,6 @@ bool RcxController::applyCommand(const Command& command, bool isUndo) {
     auto clearNodeHistory = [&](uint64_t id) {
         m_valueHistory.remove(id);
         m_lastValueAddr.remove(id);
-        m_lastValueBytes.remove(id);
     };
 
     auto clearHistoryForAdjs = [&](const QVector<cmd::OffsetAdj>& adjs) {
@@ -3227,6 +3663,22 @@ bool RcxController::applyCommand(const Command& command, bool isUndo) {
     return success;
 }
 
+int RcxController::replayJournal(const QVector<JournalEntry>& entries) {
+    const bool wasSuppressed = m_suppressRefresh;
+    m_suppressRefresh = true;
+    int applied = 0;
+    for (const JournalEntry& e : entries)
+        if (applyCommand(e.cmd, e.undo)) ++applied;
+    m_suppressRefresh = wasSuppressed;
+    if (applied > 0) {
+        // No undo index matches this state: stays modified until saved.
+        m_doc->undoStack.resetClean();
+        m_doc->modified = true;
+        refresh();
+    }
+    return applied;
+}
+
 void RcxController::setNodeValue(int nodeIdx, int subLine, const QString& text,
                                   bool isAscii, uint64_t resolvedAddr) {
     if (nodeIdx < 0 || nodeIdx >= m_doc->tree.nodes.size()) return;
@@ -5091,6 +5543,39 @@ void RcxController::showContextMenu(RcxEditor* editor, int line, int nodeIdx,
             refresh();
             for (auto* ed : m_editors) ed->dismissHistoryPopup();
         });
+
+        trackMenu->addSeparator();
+        if (isRecording()) {
+            trackMenu->addAction(QStringLiteral("Stop Recording (%1 samples)")
+                                     .arg(m_recorder->rows()),
+                                 [this]() {
+                stopRecording();
+                emit statusHint(QStringLiteral("Recording saved to %1").arg(m_lastRecordingPath));
+            });
+        } else if (hasNode) {
+            QVector<uint64_t> ids;
+            for (uint64_t sel : m_selIds) {
+                uint64_t id = baseNodeIdFromSelId(sel);
+                if (!ids.contains(id)) ids.append(id);
+            }
+            if (ids.isEmpty()) ids.append(m_doc->tree.nodes[nodeIdx].id);
+            trackMenu->addAction(QStringLiteral("Record Selected Fields..."), [this, ids]() {
+                QString path = QFileDialog::getSaveFileName(
+                    qobject_cast<QWidget*>(parent()),
+                    QStringLiteral("Record Fields"),
+                    QStringLiteral("recording.rcxts"),
+                    QStringLiteral("Reclass Recording (*.rcxts);;All Files (*)"));
+                if (path.isEmpty()) return;
+                QString err;
+                if (!startRecording(ids, path, 0, &err)) {
+                    ThemedMessageBox::warn(qobject_cast<QWidget*>(parent()),
+                        QStringLiteral("Recording Failed"), err);
+                    return;
+                }
+                emit statusHint(QStringLiteral("Recording %1 field(s) to %2")
+                                    .arg(ids.size()).arg(path));
+            });
+        }
     }
 
     // ── Kernel paging menu items ──
@@ -5209,6 +5694,7 @@ void RcxController::showContextMenu(RcxEditor* editor, int line, int nodeIdx,
 }
 
 void RcxController::batchRemoveNodes(const QVector<int>& nodeIndices) {
+    m_doc->ensureFullyLoaded();
     QSet<uint64_t> idSet;
     for (int idx : nodeIndices) {
         if (idx >= 0 && idx < m_doc->tree.nodes.size())
@@ -6730,6 +7216,15 @@ void RcxController::setRefreshInterval(int ms) {
     applyAdaptiveInterval();
 }
 
+void RcxController::setSamplerRate(int hz) {
+    hz = qBound(0, hz, PageSampler::kMaxHz);
+    if (hz == m_samplerHz) return;
+    m_samplerHz = hz;
+    // The next tick starts a sampler at the new rate (or goes back to
+    // timer-driven reads); its first frame diffs against m_prevPages.
+    m_sampler.reset();
+}
+
 void RcxController::applyAdaptiveInterval() {
     if (!m_refreshTimer) return;
     int target;
@@ -6805,17 +7300,21 @@ void RcxController::setShowEnumChips(bool v) {
 }
 
 void RcxController::setupAutoRefresh() {
-    int ms = QSettings("Reclass", "Reclass").value("refreshMs", kDefaultRefreshMs).toInt();
+    QSettings settings("Reclass", "Reclass");
+    int ms = settings.value("refreshMs", kDefaultRefreshMs).toInt();
+    ValueHistory::setDefaultCapacity(settings.value("valueHistoryCapacity",
+                                                    ValueHistory::kDefaultCapacity).toInt());
     m_refreshIntervalBaseMs = qMax(1, ms);
     m_refreshIntervalMaxMs  = qMax(m_refreshIntervalBaseMs, 1500);
     m_refreshIntervalBlurMs = qMax(m_refreshIntervalBaseMs, 1500);
+    m_samplerHz = qBound(0, settings.value("samplerHz", 0).toInt(), PageSampler::kMaxHz);
     m_refreshTimer = new QTimer(this);
     m_refreshTimer->setInterval(m_refreshIntervalBaseMs);
     connect(m_refreshTimer, &QTimer::timeout, this, &RcxController::onRefreshTick);
     m_refreshTimer->start();
 
-    m_refreshWatcher = new QFutureWatcher<PageMap>(this);
-    connect(m_refreshWatcher, &QFutureWatcher<PageMap>::finished,
+    m_refreshWatcher = new QFutureWatcher<RefreshRead>(this);
+    connect(m_refreshWatcher, &QFutureWatcher<RefreshRead>::finished,
             this, &RcxController::onReadComplete);
 }
 
@@ -6875,6 +7374,31 @@ void RcxController::collectPointerRanges(
     }
 }
 
+// Re-run a compiled base formula against the pages a refresh just read.
+// Pointers inside the batch cost nothing; one outside it (the chain moved
+// onto a page it hadn't read before) is read directly, or fails when
+// there's no provider to read it from. Names must already be bound.
+static AddressParseResult runBaseChain(const Provider* prov, const AddressProgram& prog,
+                                       const SnapshotProvider::PageMap& pages, int ptrSize,
+                                       QVector<uint64_t>* chain) {
+    constexpr uint64_t kPage = 4096;
+    AddressParserCallbacks cbs;
+    cbs.readPointer = [&](uint64_t addr, bool* ok) -> uint64_t {
+        uint64_t val = 0;
+        const uint64_t page = addr & ~(kPage - 1);
+        const int off = int(addr - page);
+        auto it = pages.constFind(page);
+        if (it != pages.constEnd() && off + ptrSize <= it->size()) {
+            std::memcpy(&val, it->constData() + off, ptrSize);
+            *ok = true;
+        } else {
+            *ok = prov && prov->read(addr, &val, ptrSize);
+        }
+        return val;
+    };
+    return prog.run(&cbs, chain);
+}
+
 void RcxController::onRefreshTick() {
     // Liveness-flip detection runs BEFORE the early-returns below: when
     // a process exits its provider transitions to !isValid(), and we
@@ -6976,13 +7500,75 @@ void RcxController::onRefreshTick() {
                     // Speedup 2: stable backstage page → re-read at half rate.
                     int stab = m_pageStability.value(p, 0);
                     bool isStable = (stab >= kStabilityThreshold);
-                    if (isStable && (m_tickCount & 1ULL)) continue;
+                    // The sampler keeps one page set across ticks; flipping
+                    // pages in and out would cost it their diffs.
+                    if (isStable && (m_tickCount & 1ULL) && m_samplerHz == 0) continue;
                 }
             }
             requestPages.insert(p);
         }
     }
 
+    // A base formula that dereferences memory ("[[<game.exe>+0x1A0]+0x30]")
+    // is re-run every tick: the pages its last run read ride along in this
+    // batch, so following the chain normally costs no extra reads.
+    rebuildBaseProgram();
+    const bool followBase = m_baseProgram.ok();
+    auto requestChainPages = [&]() {
+        const uint64_t ptrSize = uint64_t(m_doc->tree.pointerSize);
+        for (uint64_t a : m_baseChain) {
+            requestPages.insert(a & kPageMask);
+            requestPages.insert((a + ptrSize - 1) & kPageMask);
+        }
+    };
+    if (followBase) requestChainPages();
+
+    if (m_samplerHz > 0) {
+        // The sampler thread reads on its own clock; this tick only
+        // retargets it and ingests the newest frame it published.
+        if (!m_sampler || m_sampler->provider() != m_doc->provider) {
+            m_sampler = std::make_unique<PageSampler>(m_doc->provider, m_samplerHz);
+            m_samplerSeenSeq = 0;
+            hookSamplerRecorder();
+        }
+        // The pass hook reads recorded fields out of the sampled pages.
+        if (m_recorder && !m_recordThread) {
+            for (const auto& f : m_recorder->fields()) {
+                requestPages.insert(f.addr & kPageMask);
+                requestPages.insert((f.addr + uint64_t(f.column.width) - 1) & kPageMask);
+            }
+        }
+        m_sampler->setTarget(QVector<uint64_t>(requestPages.constBegin(), requestPages.constEnd()),
+                             samplerWatches());
+        if (!m_sampler->take()) return;
+
+        PageSampler::Frame& frame = m_sampler->frame();
+        bool baseMoved = false;
+        if (followBase) {
+            // Follow the chain through the sampled pages only; a hop onto
+            // a page the sampler hasn't read fails here, and its address
+            // joins the target so a later pass reads it.
+            QVector<uint64_t> chain;
+            const AddressParseResult r = runBaseChain(nullptr, m_baseProgram, frame.pages,
+                                                      m_doc->tree.pointerSize, &chain);
+            if (!chain.isEmpty()) m_baseChain = chain;
+            if (r.ok && r.value != 0 && r.value != m_doc->tree.baseAddress) {
+                m_doc->tree.baseAddress = r.value;
+                baseMoved = true;
+                // Retarget now: the next pass reads the struct where it
+                // moved instead of waiting for the next tick.
+                for (uint64_t p = r.value & kPageMask; p < r.value + uint64_t(extent); p += kPageSize)
+                    requestPages.insert(p);
+                requestChainPages();
+                m_sampler->setTarget(QVector<uint64_t>(requestPages.constBegin(),
+                                                       requestPages.constEnd()),
+                                     samplerWatches());
+            }
+        }
+        ingestSamplerFrame(frame, baseMoved);
+        return;
+    }
+
     if (requestPages.isEmpty()) {
         // Nothing to read this tick (everything is stable + off-screen,
         // or every page is permanent). Treat as zero-change for the
@@ -6996,26 +7582,78 @@ void RcxController::onRefreshTick() {
     m_readInFlight = true;
     m_readGen = m_refreshGen;
 
+    // Sorted + coalesced into runs of adjacent pages and handed to the
+    // provider as one readBatch() — a 2 MB struct is a handful of spans
+    // (one vectored syscall on Linux) instead of 512 separate reads.
     auto prov = m_doc->provider;
     QVector<uint64_t> pageList(requestPages.constBegin(), requestPages.constEnd());
-    m_refreshWatcher->setFuture(QtConcurrent::run([prov, pageList]() -> PageMap {
-        PageMap pages;
-        pages.reserve(pageList.size());
-        for (uint64_t p : pageList) {
-            pages[p] = prov->readBytes(p, static_cast<int>(kPageSize));
+    const AddressProgram chain = followBase ? m_baseProgram : AddressProgram();
+    const uint64_t base = m_doc->tree.baseAddress;
+    const int ptrSize = m_doc->tree.pointerSize;
+    m_refreshWatcher->setFuture(QtConcurrent::run(
+            [prov, pageList, chain, base, extent, ptrSize]() -> RefreshRead {
+        RefreshRead out;
+        out.pages = readPagesCoalesced(*prov, pageList);
+        if (!chain.ok()) return out;
+
+        // A chain that fails or lands on null is mid-reallocation; keep
+        // the old base until it resolves again.
+        const AddressParseResult r = runBaseChain(prov.get(), chain, out.pages, ptrSize, &out.chain);
+        if (!r.ok || r.value == 0 || r.value == base) return out;
+        out.baseMoved = true;
+        out.base = r.value;
+
+        // Fetch the struct at its new address in this same job, so the
+        // tick that sees the move also shows it.
+        constexpr uint64_t kPage = 4096;
+        QVector<uint64_t> more;
+        for (uint64_t p = r.value & ~(kPage - 1); p < r.value + uint64_t(extent); p += kPage)
+            if (!out.pages.contains(p)) more.append(p);
+        if (!more.isEmpty()) {
+            const PageMap extra = readPagesCoalesced(*prov, more);
+            for (auto it = extra.constBegin(); it != extra.constEnd(); ++it)
+                out.pages.insert(it.key(), it.value());
         }
-        return pages;
+        return out;
     }));
 }
 
+void RcxController::rebuildBaseProgram() {
+    const QString& formula = m_doc->tree.baseAddressFormula;
+    if (m_baseProgramBuilt && formula == m_baseProgramFormula) return;
+    m_baseProgramBuilt = true;
+    m_baseProgramFormula = formula;
+    m_baseProgram = AddressProgram();
+    m_baseChain.clear();
+    if (formula.isEmpty() || !m_doc->provider) return;
+
+    // Only formulas that read memory can move. Kernel paging calls stay
+    // with the one-shot evaluation on attach.
+    AddressProgram prog = AddressParser::compile(formula);
+    if (!prog.ok() || !prog.dereferences() || prog.usesPaging()) return;
+
+    AddressParserCallbacks cbs;
+    auto* prov = m_doc->provider.get();
+    cbs.resolveModule = [prov](const QString& name, bool* ok) -> uint64_t {
+        uint64_t base = prov->symbolToAddress(name);
+        *ok = (base != 0);
+        return base;
+    };
+    cbs.resolveIdentifier = [prov](const QString& name, bool* ok) -> uint64_t {
+        return SymbolStore::instance().resolve(name, prov, ok);
+    };
+    if (prog.bindNames(cbs))
+        m_baseProgram = prog;
+}
+
 void RcxController::onReadComplete() {
     m_readInFlight = false;
 
     if (m_readGen != m_refreshGen) return;
 
-    PageMap newPages;
+    RefreshRead read;
     try {
-        newPages = m_refreshWatcher->result();
+        read = m_refreshWatcher->result();
     } catch (const std::exception& e) {
         qWarning() << "[Refresh] async read threw:" << e.what();
         m_lastReadOk = false;
@@ -7025,7 +7663,56 @@ void RcxController::onReadComplete() {
         m_lastReadOk = false;
         return;
     }
+    // The formula may have been edited while the read was out.
+    const bool sameFormula = m_baseProgram.ok()
+        && m_doc->tree.baseAddressFormula == m_baseProgramFormula;
+    if (sameFormula && !read.chain.isEmpty())
+        m_baseChain = read.chain;
+    // Following the formula isn't an edit: no undo entry, the formula
+    // itself is what the user set.
+    const bool baseMoved = sameFormula && read.baseMoved;
+    if (baseMoved)
+        m_doc->tree.baseAddress = read.base;
+    ingestPages(read.pages, nullptr, baseMoved);
+}
 
+QVector<PageSampler::Watch> RcxController::samplerWatches() const {
+    // Fields that already have a history, at the address it was taken
+    // from. Deref histories follow a pointer the sampler can't chase.
+    QVector<PageSampler::Watch> out;
+    if (!m_trackValues) return out;
+    out.reserve(m_valueHistory.size());
+    for (auto it = m_valueHistory.constBegin(); it != m_valueHistory.constEnd(); ++it) {
+        const ValueHistory& h = it.value();
+        if (h.count == 0 || (h.at(0).flags & ValueHistory::kDeref)) continue;
+        auto addrIt = m_lastValueAddr.constFind(it.key());
+        if (addrIt == m_lastValueAddr.constEnd()) continue;
+        out.append({it.key(), addrIt.value(), h.width()});
+    }
+    return out;
+}
+
+void RcxController::ingestSamplerFrame(PageSampler::Frame& frame, bool baseMoved) {
+    // Values the sampler saw between ticks go into the histories first;
+    // the refresh below then records the current value after them (or
+    // dedups it against the last one).
+    if (m_trackValues && m_valueTrackCooldown <= 0) {
+        for (auto it = frame.watches.constBegin(); it != frame.watches.constEnd(); ++it) {
+            auto hist = m_valueHistory.find(it.key());
+            if (hist == m_valueHistory.end()) continue;
+            const uint64_t addr = m_lastValueAddr.value(it.key());
+            for (const auto& s : it.value()) {
+                if (s.seq <= m_samplerSeenSeq || s.addr != addr) continue;
+                hist->record(s.bytes.constData(), int(s.bytes.size()), 0, s.timeUs / 1000);
+            }
+        }
+    }
+    m_samplerSeenSeq = frame.seq;
+    ingestPages(frame.pages, &frame.changed, baseMoved);
+}
+
+void RcxController::ingestPages(const PageMap& newPages, const ChangeBitmap* extraChanged,
+                                bool baseMoved) {
     // All-zero guard: if page 0 is all zeros and we already have data, discard
     if (!m_prevPages.isEmpty() && newPages.contains(0)) {
         const QByteArray& p0 = newPages.value(0);
@@ -7052,6 +7739,7 @@ void RcxController::onReadComplete() {
     m_changedOffsets.clear();
     bool anyChanged = false;
     bool firstSnapshot = m_prevPages.isEmpty();
+    bool sawNewPage = false;
     for (auto it = newPages.constBegin(); it != newPages.constEnd(); ++it) {
         uint64_t pageAddr = it.key();
         const QByteArray& newPage = it.value();
@@ -7061,6 +7749,7 @@ void RcxController::onReadComplete() {
             // at zero. Don't fold it into "anyChanged"; first-sight isn't
             // a value mutation.
             m_pageStability[pageAddr] = 0;
+            sawNewPage = true;
             continue;
         }
         const QByteArray& oldPage = oldIt.value();
@@ -7078,6 +7767,12 @@ void RcxController::onReadComplete() {
                                              m_pageStability.value(pageAddr, 0) + 1);
         }
     }
+    // Bytes that moved and moved back between two UI ticks don't show in
+    // the diff above; the sampler reports them.
+    if (extraChanged && !extraChanged->isEmpty() && !firstSnapshot) {
+        m_changedOffsets.merge(*extraChanged);
+        anyChanged = true;
+    }
 
     // Adaptive: count consecutive ticks with zero observed change.
     if (anyChanged) {
@@ -7107,10 +7802,20 @@ void RcxController::onReadComplete() {
     // after m_snapshotProv exists, otherwise the helper early-returns.
     classifyPermanentPages(newPages);
 
+    // Tick-driven recording samples every successful read, changed or not,
+    // so the series has a row per tick. Under the sampler its pass hook
+    // already recorded every pass.
+    if (m_recorder && !m_recordThread && !m_sampler)
+        sampleRecording(*m_snapshotProv);
+
     // Compose only when something actually changed (or this is the
     // first snapshot — there's nothing on screen yet).
-    if (anyChanged || firstSnapshot) {
+    if (anyChanged || firstSnapshot || baseMoved) {
+        // A page seen for the first time has no diff, so its bytes may
+        // differ from what the last compose read — not a value-only tick.
+        m_valueTick = !firstSnapshot && !sawNewPage && !baseMoved;
         refresh();
+        m_valueTick = false;
     }
     m_changedOffsets.clear();
 }
@@ -7149,6 +7854,43 @@ RcxController::viewportAddressRange() const {
     return QPair<uint64_t, uint64_t>{lo, hi};
 }
 
+ComposeWindow RcxController::composeWindow() const {
+    ComposeWindow w;
+    for (auto* editor : m_editors) {
+        if (!editor || !editor->scintilla()) continue;
+        auto* sci = editor->scintilla();
+        int firstVis = sci->firstVisibleLine();
+        int onScreen = (int)sci->SendScintilla(QsciScintillaBase::SCI_LINESONSCREEN);
+        int first = (int)sci->SendScintilla(QsciScintillaBase::SCI_DOCLINEFROMVISIBLE, firstVis);
+        int last  = (int)sci->SendScintilla(QsciScintillaBase::SCI_DOCLINEFROMVISIBLE,
+                                            firstVis + onScreen);
+        first = qMax(0, first - kComposeOverscan);
+        last += kComposeOverscan;
+        if (w.first < 0) { w.first = first; w.last = last; }
+        else { w.first = qMin(w.first, first); w.last = qMax(w.last, last); }
+    }
+    return w;
+}
+
+void RcxController::onEditorScrolled() {
+    if (m_lastResult.placeholderLines == 0 || m_windowRefreshQueued) return;
+    // Recompose once an editor gets within half the overscan of a
+    // placeholder row, so real rows are in place before they scroll in.
+    const ComposeWindow want = composeWindow();
+    const int reach = kComposeOverscan / 2;
+    const int lo = qMax(0, want.first + reach);
+    const int hi = qMin((int)m_lastResult.meta.size() - 1, want.last - reach);
+    bool needed = false;
+    for (int i = lo; i <= hi && !needed; ++i)
+        needed = m_lastResult.meta[i].isPlaceholder;
+    if (!needed) return;
+    m_windowRefreshQueued = true;
+    QTimer::singleShot(0, this, [this]() {
+        m_windowRefreshQueued = false;
+        refresh();
+    });
+}
+
 // ── Speedup 4: classify pages whose region is read-only module memory ──
 void RcxController::classifyPermanentPages(const PageMap& fresh) {
     if (!m_snapshotProv || !m_doc->provider) return;
@@ -7206,14 +7948,22 @@ int RcxController::computeDataExtent() const {
 }
 
 void RcxController::resetSnapshot() {
+    // The recorded addresses belong to the old source.
+    stopRecording();
+    m_sampler.reset();
+    m_samplerSeenSeq = 0;
     m_refreshGen++;
     m_readInFlight = false;
+    // Module bases are per-attach; re-bind the formula on the next tick.
+    m_baseProgramBuilt = false;
+    m_baseProgram = AddressProgram();
+    m_baseChain.clear();
     m_snapshotProv.reset();
     m_prevPages.clear();
     m_changedOffsets.clear();
+    m_rttiCache.clear();
     m_valueHistory.clear();
     m_lastValueAddr.clear();
-    m_lastValueBytes.clear();
     // Speedup-related state — module identity and page stability are
     // both per-attach. Switching processes (resetProvider →
     // resetSnapshot) must drop these or stale data leaks across.
@@ -7285,7 +8035,7 @@ void RcxController::addBookmark(const QString& name, const QString& formula) {
     b.addressFormula = formula.trimmed();
     if (b.name.isEmpty() || b.addressFormula.isEmpty()) return;
     m_doc->tree.bookmarks.append(b);
-    m_doc->modified = true;
+    m_doc->markUnjournaledEdit();
     emit m_doc->documentChanged();
 }
 
@@ -7293,7 +8043,7 @@ void RcxController::removeBookmark(int idx) {
     auto& bms = m_doc->tree.bookmarks;
     if (idx < 0 || idx >= bms.size()) return;
     bms.remove(idx);
-    m_doc->modified = true;
+    m_doc->markUnjournaledEdit();
     emit m_doc->documentChanged();
 }
 
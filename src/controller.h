@@ -1,13 +1,20 @@
 #pragma once
 #include "core.h"
+#include "addressparser.h"
 #include "editor.h"
 #include "providers/snapshot_provider.h"
+#include "diffutil.h"
+#include "rtti.h"
+#include "timeseries.h"
+#include "pagesampler.h"
+#include "journal.h"
 #include <QObject>
 #include <QUndoStack>
 #include <QUndoCommand>
 #include <QTimer>
 #include <QFutureWatcher>
 #include <QPointer>
+#include <QElapsedTimer>
 #include <QPair>
 #include <QJsonArray>
 #include <memory>
@@ -16,6 +23,7 @@
 namespace rcx {
 
 class RcxController;
+class RcxbReader;
 class TypeSelectorPopup;
 class SourceChooserPopup;
 class HexToolbarPopup;
@@ -28,6 +36,7 @@ class RcxDocument : public QObject {
     Q_OBJECT
 public:
     explicit RcxDocument(QObject* parent = nullptr);
+    ~RcxDocument() override;
 
     NodeTree                   tree;
     std::shared_ptr<Provider>  provider;
@@ -60,6 +69,13 @@ public:
     // logged via qWarning for console post-mortem). Zero on clean trees /
     // freshly-created docs.
     int                        m_loadOverlapCount = 0;
+    // "journalSeq" of the most recent load(): the last journal entry an
+    // autosave shadow already contains. Zero for ordinary project files.
+    uint64_t                   m_loadJournalSeq = 0;
+    // Every undo / redo applied since the last full write, appended as it
+    // happens (see journal.h). Opened on "<file>.journal" by save() and by
+    // MainWindow after an open; closed for untitled documents.
+    CommandJournal             journal;
 
     QString resolveTypeName(NodeKind kind) const {
         auto it = typeAliases.find(kind);
@@ -72,14 +88,74 @@ public:
     ComposeResult compose(uint64_t viewRootId = 0, bool compactColumns = false,
                           bool treeLines = false, bool braceWrap = false,
                           bool typeHints = false, bool showComments = true,
-                          SymbolLookupFn symbolLookup = {}) const;
+                          SymbolLookupFn symbolLookup = {},
+                          ComposeWindow window = {}) const;
     bool save(const QString& path);
+    // save() without the wait: the tree is snapshotted here (a copy-on-
+    // write copy, so O(1)) and encoded and written on the thread pool.
+    // The document counts as saved from the snapshot on; if the write
+    // fails it goes back to modified. saveFinished reports the outcome.
+    // Waits for a write already in flight first.
+    void saveInBackground(const QString& path);
+    // Background write of the recovery shadow "<file>.autosave", stamped
+    // with the journal seq it covers; the journal is compacted past it
+    // once written. False (nothing started) if a write is in flight or
+    // the document has no file.
+    bool autosaveInBackground();
+    bool isSaving() const { return m_pendingSave.has_value(); }
+    // An edit that bypasses the undo stack (bookmarks, type aliases) never
+    // reaches the journal: only a full write — the shadow or a save — can
+    // recover it, so the autosave must not skip the document until then.
+    void markUnjournaledEdit() { modified = true; m_unjournaledEdits = true; }
+    bool hasUnjournaledEdits() const { return m_unjournaledEdits; }
+    // Block until the in-flight write, if any, finishes. False (with a
+    // message) if it failed.
+    bool waitForSave(QString* errorMsg = nullptr);
     bool load(const QString& path);
+    // An .rcxb load puts the class roots in the tree and defers their
+    // bodies: a class's members are decoded when it's opened or referenced
+    // (ensureClassLoaded), and the rest on the thread pool right after the
+    // load. Edits and writes need the whole tree first (ensureFullyLoaded).
+    bool hasDeferredClasses() const { return !m_deferred.isEmpty(); }
+    // Decodes the class holding `nodeId` and every deferred class its
+    // members reference, transitively. False if nothing was deferred.
+    bool ensureClassLoaded(uint64_t nodeId);
+    void ensureFullyLoaded();
     void loadData(const QString& binaryPath);
     void loadData(const QByteArray& data);
+    // Write byte edits made to a mapped file source back to disk; edits
+    // stay in memory until then. False (with a message) for other sources.
+    bool saveData(QString* errorMsg = nullptr);
+    bool hasUnsavedData() const;
 
 signals:
     void documentChanged();
+    // An explicit save's write finished; errorMsg is empty on success.
+    void saveFinished(const QString& path, bool ok, const QString& errorMsg);
+
+private:
+    struct PendingSave {
+        QString  path;
+        bool     shadow = false;
+        uint64_t journalSeq = 0;   // journal entries the write covers
+        int      cleanIndex = -1;  // undo index marked clean at the snapshot
+        bool     unjournaled = false;  // the snapshot took unjournaled edits
+    };
+    void startWrite(const PendingSave& job, const QJsonObject& extra);
+    void finishSave();
+    void retargetJournal(const QString& path);
+    void appendClassBody(const QVector<Node>& body);
+    void finishDeferredLoad(bool notify);
+    void dropDeferred();
+
+    QFutureWatcher<QString>    m_saveWatcher;   // result: error, empty on success
+    std::optional<PendingSave> m_pendingSave;
+    bool                       m_unjournaledEdits = false;
+
+    std::shared_ptr<RcxbReader> m_rcxb;        // mapped while bodies are deferred
+    QHash<uint64_t, int>        m_deferred;    // class root id → class index
+    QVector<uint64_t>           m_drainRoots;  // what m_drainWatcher decodes, in order
+    QFutureWatcher<QVector<QVector<Node>>> m_drainWatcher;
 };
 
 // ── Undo command ──
@@ -187,6 +263,11 @@ public:
     // RcxCommand::undo/redo — use this to mark the command obsolete so the
     // undo stack stays consistent with the actual data.
     bool applyCommand(const Command& cmd, bool isUndo);
+    // Crash recovery: re-applies journal entries read back from disk.
+    // They bypass the undo stack (the history before them is gone), so
+    // the document is left modified until the next save. Returns how
+    // many applied.
+    int replayJournal(const QVector<JournalEntry>& entries);
     void refresh();
     void applyTypePopupResult(TypePopupMode mode, int nodeIdx, const TypeEntry& entry, const QString& fullText);
     uint64_t findOrCreateStructByName(const QString& typeName, int depth = 0);
@@ -232,6 +313,10 @@ public:
     RcxDocument* document() const { return m_doc; }
     void setEditorFont(const QString& fontName);
     void setRefreshInterval(int ms);
+    // Fixed-rate sampling on a dedicated thread; 0 reads on the refresh
+    // timer instead. The timer then only picks up the sampler's newest frame.
+    void setSamplerRate(int hz);
+    int  samplerRate() const { return m_samplerHz; }
     void setCompactColumns(bool v);
     void setTreeLines(bool v);
     void setBraceWrap(bool v);
@@ -274,6 +359,19 @@ public:
     void setTrackValues(bool on);
     void resetChangeTracking();
 
+    // Field recording: samples the given leaf nodes into an append-only
+    // columnar file (timeseries.h) on every refresh tick (intervalMs == 0;
+    // every pass of the page sampler when it runs) or every intervalMs on
+    // a recorder thread reading the live provider.
+    bool startRecording(const QVector<uint64_t>& nodeIds, const QString& path,
+                        int intervalMs = 0, QString* err = nullptr);
+    void stopRecording();
+    bool isRecording() const { return m_recorder && m_recorder->isRecording(); }
+    // Writes buffered rows so a SeriesReader sees everything sampled so far.
+    bool flushRecording() { return isRecording() && m_recorder->flush(); }
+    const SeriesRecorder* recorder() const { return m_recorder.get(); }
+    QString lastRecordingPath() const { return m_lastRecordingPath; }
+
     // Cross-tab type visibility: point at the project's full document list
     void setProjectDocuments(QVector<RcxDocument*>* docs) { m_projectDocs = docs; }
 
@@ -287,6 +385,7 @@ public:
     int  idleTicks()          const { return m_idleTicks; }
     int  pageStability(uint64_t pageAddr) const { return m_pageStability.value(pageAddr & ~uint64_t(4095), 0); }
     const SnapshotProvider* snapshotProv() const { return m_snapshotProv.get(); }
+    const PageSampler* sampler() const { return m_sampler.get(); }
 
     // Tri-state status of the active data source (status-bar badge): None = no
     // source; Static = a non-live file source (fully read); Live = reading;
@@ -326,7 +425,7 @@ private:
     bool               m_braceWrap = false;
     bool               m_typeHints = false;
     bool               m_showComments = false;
-    bool               m_showRtti = false;         // auto-RTTI scan default OFF (expensive on module-heavy targets; View menu opts in)
+    bool               m_showRtti = true;          // auto-RTTI chips (walks are memoized in m_rttiCache)
     bool               m_showEnumChips = true;     // chip toggle, default ON
     bool               m_readOnlyOverride = false; // tutorial safety; see header
     uint64_t           m_viewRootId = 0;
@@ -362,28 +461,83 @@ private:
 
     // ── Auto-refresh state ──
     using PageMap = QHash<uint64_t, QByteArray>;
+    // What one refresh tick's worker brings back: the pages, and where a
+    // dereferencing base formula points now when that moved.
+    struct RefreshRead {
+        PageMap           pages;
+        bool              baseMoved = false;
+        uint64_t          base = 0;
+        QVector<uint64_t> chain;   // addresses the formula read, if run
+    };
     QTimer*         m_refreshTimer = nullptr;
-    QFutureWatcher<PageMap>* m_refreshWatcher = nullptr;
+    QFutureWatcher<RefreshRead>* m_refreshWatcher = nullptr;
     std::unique_ptr<SnapshotProvider> m_snapshotProv;
     PageMap         m_prevPages;
     // Latches the "discarding all-zero page-0" debug log so a sustained
     // unreadable-page condition doesn't flood the console at refresh
     // tick rate. Cleared the first time we get a real read through.
     bool            m_loggedAllZeroPage0 = false;
-    QSet<int64_t>   m_changedOffsets;
+    ChangeBitmap    m_changedOffsets;   // bytes changed by the last read tick
+    // Vtable → RTTI results across refresh ticks. Dropped on re-attach
+    // (resetSnapshot) and by compose itself when the module list changes.
+    RttiCache       m_rttiCache;
+    // Set by onReadComplete around refresh() when every page it diffed was
+    // already in the snapshot: m_changedOffsets then accounts for every
+    // byte that moved, so refresh() may patch m_lastResult in place via
+    // recomposeChanged(). m_composedKey is what m_lastResult was composed
+    // against; any mismatch forces a full compose.
+    bool            m_valueTick = false;
+    struct ComposeKey {
+        quint64  generation = 0;
+        uint64_t viewRootId = 0;
+        uint64_t baseAddress = 0;
+        int      flags = -1;
+        bool operator==(const ComposeKey& o) const {
+            return generation == o.generation && viewRootId == o.viewRootId
+                && baseAddress == o.baseAddress && flags == o.flags;
+        }
+    };
+    ComposeKey      m_composedKey;
+    // Lines of huge containers to materialize: what the editors show plus
+    // kComposeOverscan on each side. m_composedWindow is what m_lastResult
+    // used; a scroll that nears its placeholder rows queues a recompose.
+    static constexpr int kComposeOverscan = 512;
+    ComposeWindow   m_composedWindow;
+    bool            m_windowRefreshQueued = false;
+    ComposeWindow   composeWindow() const;
+    void            onEditorScrolled();
     QHash<uint64_t, ValueHistory> m_valueHistory;
+    std::shared_ptr<SeriesRecorder> m_recorder;
+    std::unique_ptr<SeriesRecordThread> m_recordThread;   // null = sample on refresh ticks
+    QElapsedTimer   m_recordClock;
+    qint64          m_recordEpochUs = 0;
+    QString         m_lastRecordingPath;
+    void            sampleRecording(const Provider& prov);
+    void            hookSamplerRecorder();
     QHash<uint64_t, uint64_t> m_lastValueAddr;  // nodeId → last offsetAddr used for value recording
-    // nodeId → raw bytes of the last sampled value. Change-detection keys on
-    // this (not the formatted display string) so a no-op reformat of identical
-    // bytes — Hex64 "0x0" → Pointer64 "nullptr", endianness/RVA toggle — doesn't
-    // register as a value change and spuriously light the heatmap / fire the
-    // previous-values popup.
-    QHash<uint64_t, QByteArray> m_lastValueBytes;
     bool            m_trackValues = true;
     int             m_valueTrackCooldown = 0; // suppress value recording for N refresh cycles after clear
     uint64_t        m_refreshGen = 0;
     uint64_t        m_readGen = 0;
     bool            m_readInFlight = false;
+    // tree.baseAddressFormula compiled with its module bases bound, when
+    // it dereferences memory. Each tick's worker re-runs it against the
+    // pages it just read (m_baseChain: the addresses the last run read,
+    // fetched in the same batch as the struct) and follows the base when
+    // the chain moves. Rebuilt when the formula changes; dropped with the
+    // snapshot.
+    AddressProgram  m_baseProgram;
+    QString         m_baseProgramFormula;
+    bool            m_baseProgramBuilt = false;
+    QVector<uint64_t> m_baseChain;
+    void            rebuildBaseProgram();
+    // Sampler thread (setSamplerRate). Created on the first tick with
+    // pages to read; dropped whenever the provider or snapshot resets.
+    std::unique_ptr<PageSampler> m_sampler;
+    int             m_samplerHz = 0;
+    quint64         m_samplerSeenSeq = 0;   // newest pass already ingested
+    QVector<PageSampler::Watch> samplerWatches() const;
+    void            ingestSamplerFrame(PageSampler::Frame& frame, bool baseMoved = false);
 
     // ── Refresh speedups (memory-source-only optimizations) ──
     // Per-page stability counter: increments every tick a page's bytes
@@ -446,6 +600,12 @@ private:
     void setupAutoRefresh();
     void onRefreshTick();
     void onReadComplete();
+    // Diff freshly read pages against the snapshot, merge them in and
+    // recompose if anything moved. `extraChanged` adds bytes the sampler
+    // saw change in passes between UI ticks; `baseMoved` forces the
+    // recompose when the base followed its formula to new pages.
+    void ingestPages(const PageMap& newPages, const ChangeBitmap* extraChanged = nullptr,
+                     bool baseMoved = false);
     int  computeDataExtent() const;
     // Byte range covered by visible lines across all attached editors,
     // expressed as [absStart, absEnd). Returns std::nullopt when no
@@ -9,8 +9,10 @@
 #include <QSet>
 #include <cstdint>
 #include <array>
+#include <cstring>
 #include <memory>
 #include <variant>
+#include <vector>
 #include <QDateTime>
 
 #include "providers/provider.h"
@@ -225,28 +227,52 @@ struct BitfieldMember {
     uint8_t bitWidth  = 1;  // number of bits (1..64)
 };
 
+// ── String interning ──
+
+// Collapses equal strings onto one implicitly-shared buffer. Files spell the
+// same field names, type names and keywords out once per node ("Flink",
+// "Reserved", "class" ...), so a tree built from one without this holds a
+// separate allocation for every occurrence. Only needed while building;
+// the strings stay shared after the interner is gone.
+class StringInterner {
+    QSet<QString> m_strings;
+public:
+    QString intern(const QString& s) {
+        if (s.isEmpty()) return QString();
+        auto it = m_strings.constFind(s);
+        if (it != m_strings.constEnd()) return *it;
+        m_strings.insert(s);
+        return s;
+    }
+    int size() const { return m_strings.size(); }
+};
+
 // ── Node ──
 
 struct Node {
+    // Scalars first, widest to narrowest: the tree walks (compose's BFS,
+    // structSpan, validate) only read these, and packed together they fill
+    // one cache line instead of being strung out between the strings —
+    // and the padding the old interleaving cost is gone.
     uint64_t id         = 0;
-    NodeKind kind       = NodeKind::Hex8;
-    QString  name;
-    QString  structTypeName;  // Struct/Array: optional type name (e.g., "IMAGE_DOS_HEADER")
-    QString  classKeyword;    // "struct", "class", or "enum" (empty = "struct")
     uint64_t parentId   = 0;   // 0 = root (no parent)
+    uint64_t refId      = 0;       // Pointer32/64: id of Struct to expand at *ptr
     int      offset     = 0;
-    bool     isRelative = false;   // Pointer: target = base + value (RVA) instead of absolute
     int      arrayLen   = 1;   // Array: element count
     int      strLen     = 64;
-    bool     collapsed  = true;
-    uint64_t refId      = 0;       // Pointer32/64: id of Struct to expand at *ptr
-    NodeKind elementKind = NodeKind::UInt8;  // Array: element type; Pointer with ptrDepth>0: target type
     int      ptrDepth   = 0;   // Pointer: 0=struct/void ptr, 1=primitive*, 2=primitive**
     int      viewIndex  = 0;   // Array: current view offset (transient)
+    NodeKind kind       = NodeKind::Hex8;
+    NodeKind elementKind = NodeKind::UInt8;  // Array: element type; Pointer with ptrDepth>0: target type
+    bool     isRelative = false;   // Pointer: target = base + value (RVA) instead of absolute
+    bool     collapsed  = true;
+    bool     bigEndian  = false;   // Scalar value is big-endian (swap on display/parse)
+    QString  name;
+    QString  structTypeName;  // Struct/Array: optional type name (e.g., "IMAGE_DOS_HEADER")
+    QString  classKeyword;    // "struct", "class", or "enum" (empty = "struct")
     QVector<QPair<QString, int64_t>> enumMembers; // Enum: name→value pairs
     QVector<BitfieldMember> bitfieldMembers;       // Bitfield: per-bit member definitions
     QString  comment;          // User annotation (displayed as "// text" in comment column)
-    bool     bigEndian  = false;   // Scalar value is big-endian (swap on display/parse)
 
     // Leaf-only byte size. Returns 0 for Struct (container, unless it's a
     // bitfield which has a fixed container size) and Array-of-Struct/Array
@@ -325,13 +351,18 @@ struct Node {
             o["bigEndian"] = true;
         return o;
     }
-    static Node fromJson(const QJsonObject& o) {
+    // `strings` (optional) shares the text fields with every other node
+    // read through the same interner.
+    static Node fromJson(const QJsonObject& o, StringInterner* strings = nullptr) {
+        auto str = [strings](const QJsonValue& v) {
+            return strings ? strings->intern(v.toString()) : v.toString();
+        };
         Node n;
         n.id        = o["id"].toString("0").toULongLong();
         n.kind      = kindFromString(o["kind"].toString());
-        n.name      = o["name"].toString();
-        n.structTypeName = o["structTypeName"].toString();
-        n.classKeyword = o["classKeyword"].toString();
+        n.name      = str(o["name"]);
+        n.structTypeName = str(o["structTypeName"]);
+        n.classKeyword = str(o["classKeyword"]);
         n.parentId  = o["parentId"].toString("0").toULongLong();
         n.offset    = o["offset"].toInt(0);
         n.isRelative = o["isRelative"].toBool(false);
@@ -345,7 +376,7 @@ struct Node {
             QJsonArray arr = o["enumMembers"].toArray();
             for (const auto& v : arr) {
                 QJsonObject em = v.toObject();
-                n.enumMembers.emplaceBack(em["name"].toString(),
+                n.enumMembers.emplaceBack(str(em["name"]),
                                         em["value"].toString("0").toLongLong());
             }
         }
@@ -354,13 +385,13 @@ struct Node {
             for (const auto& v : arr) {
                 QJsonObject bm = v.toObject();
                 BitfieldMember m;
-                m.name = bm["name"].toString();
+                m.name = str(bm["name"]);
                 m.bitOffset = (uint8_t)qBound(0, bm["bitOffset"].toInt(0), 255);
                 m.bitWidth = (uint8_t)qBound(1, bm["bitWidth"].toInt(1), 64);
                 n.bitfieldMembers.append(m);
             }
         }
-        n.comment = o["comment"].toString();
+        n.comment = str(o["comment"]);
         n.bigEndian = o["bigEndian"].toBool(false);
         return n;
     }
@@ -407,7 +438,7 @@ extern void (*g_rttiDiscoveryHook)(const QString& name, uint64_t address,
 // NameRegistry so controller.cpp can label addresses from any registered
 // source (PDB / RTTI / bookmarks / plugin). Tests leave nullptr; the
 // controller falls back to SymbolStore directly when this is null.
-extern QString (*g_nameLookupHook)(uint64_t address, const Provider* active);
+extern QString (*g_nameLookupHook)(uint64_t address, const std::shared_ptr<Provider>& active);
 
 // Named-source-changed nudge — main.cpp wires this to NameRegistry's
 // emitChanged() so that "Bookmark this address..." in the editor refreshes
@@ -432,7 +463,38 @@ struct NodeTree {
     QVector<Bookmark> bookmarks;       // user-named addresses
     uint64_t      m_nextId    = 1;
     mutable QHash<uint64_t, int> m_idCache;
-    mutable QHash<uint64_t, QVector<int>> m_childCache;
+
+    // Children of every parent, in node order, packed CSR-style: row r's
+    // node indices are kids[start[r] .. start[r+1]). One flat array instead
+    // of a QVector per container, so walking a 500k-node tree stays in
+    // contiguous memory and building it is two passes with no per-parent
+    // allocation. Built on first use and kept until invalidateIdCache().
+    //
+    // addNode() doesn't rebuild: the one row it changes is copied into
+    // `spill` (contiguous again, so spans still work) and the CSR arrays are
+    // rebuilt once spilled rows hold a sizable share of the tree. That keeps
+    // importers that interleave addNode with childrenOf at O(1) amortized.
+    struct ChildIndex {
+        QHash<uint64_t, int>          row;    // parentId → row
+        QVector<int>                  start;  // rows + 1 entries
+        QVector<int>                  kids;
+        QHash<uint64_t, QVector<int>> spill;  // parentId → whole child list
+        int                           spilled = 0;
+        bool                          built = false;
+    };
+    mutable ChildIndex m_children;
+
+    // Non-owning view of one parent's children. Valid until the tree's
+    // shape next changes (addNode, removal, invalidateIdCache).
+    struct ChildSpan {
+        const int* b = nullptr;
+        const int* e = nullptr;
+        const int* begin() const { return b; }
+        const int* end() const { return e; }
+        int  size() const { return int(e - b); }
+        bool isEmpty() const { return b == e; }
+        int  operator[](int i) const { return b[i]; }
+    };
     // Bumped on every structural mutation (add/remove/parent change). Caches
     // keyed on this counter (generator output, type popup entries, etc.) can
     // skip rebuilds when the tree hasn't changed shape between refreshes.
@@ -448,8 +510,16 @@ struct NodeTree {
         nodes.append(copy);
         if (!m_idCache.isEmpty())
             m_idCache[copy.id] = idx;
-        if (!m_childCache.isEmpty())
-            m_childCache[copy.parentId].append(idx);
+        if (m_children.built) {
+            auto it = m_children.spill.find(copy.parentId);
+            if (it == m_children.spill.end()) {
+                const ChildSpan row = csrRow(copy.parentId);
+                it = m_children.spill.insert(copy.parentId, QVector<int>(row.begin(), row.end()));
+                m_children.spilled += row.size();
+            }
+            it->append(idx);
+            ++m_children.spilled;
+        }
         ++m_generation;
         return idx;
     }
@@ -457,7 +527,12 @@ struct NodeTree {
     // Reserve a unique ID atomically (for use before pushing undo commands)
     uint64_t reserveId() { return m_nextId++; }
 
-    void invalidateIdCache() const { m_idCache.clear(); m_childCache.clear(); }
+    void invalidateIdCache() const {
+        m_idCache.clear();
+        m_children.built = false;
+        m_children.spill.clear();
+        m_children.spilled = 0;
+    }
     // For mutators that change tree shape (parentId, offsets, kind, structTypeName,
     // refId — anything the generator/popup-cache fingerprints). Caller is responsible
     // for invoking this; controller's applyCommand path bumps where needed.
@@ -496,32 +571,44 @@ struct NodeTree {
         }
         invalidateIdCache();
 
+        // Parent links resolved to indices once. Passes 2 and 3 then walk
+        // this flat array instead of doing a hash lookup per step.
+        QVector<int> parentIdx(nodes.size());
+        for (int i = 0; i < nodes.size(); i++)
+            parentIdx[i] = nodes[i].parentId == 0 ? -1 : indexOfId(nodes[i].parentId);
+
         // Pass 2: orphan detection — parentId points to nonexistent node
         for (int i = 0; i < nodes.size(); i++) {
             Node& n = nodes[i];
-            if (n.parentId != 0 && indexOfId(n.parentId) < 0) {
+            if (n.parentId != 0 && parentIdx[i] < 0) {
                 r.orphans++;
                 if (repair) n.parentId = 0;
             }
         }
-        invalidateIdCache();
 
-        // Pass 3: cycle detection — walk parent chain from each node
+        // Pass 3: cycle detection — follow parent links, colouring nodes as
+        // on the current path (1) or known to reach a root (2). Meeting a
+        // 1 means the path looped back on itself; each node is walked
+        // once, so this is O(N) where a per-node chain walk was O(N·depth).
+        QVector<uint8_t> state(nodes.size(), 0);
+        QVector<int> path;
         for (int i = 0; i < nodes.size(); i++) {
-            QSet<uint64_t> visited;
+            path.clear();
             int cur = i;
-            while (cur >= 0 && cur < nodes.size()) {
-                uint64_t nid = nodes[cur].id;
-                if (visited.contains(nid)) {
-                    // Cycle. Break by re-rooting the offending node.
-                    r.cycles++;
-                    if (repair) nodes[cur].parentId = 0;
-                    break;
+            while (cur >= 0 && state[cur] == 0) {
+                state[cur] = 1;
+                path.append(cur);
+                cur = parentIdx[cur];
+            }
+            if (cur >= 0 && state[cur] == 1) {
+                // Cycle. Break by re-rooting the node the walk came back to.
+                r.cycles++;
+                if (repair) {
+                    nodes[cur].parentId = 0;
+                    parentIdx[cur] = -1;
                 }
-                visited.insert(nid);
-                if (nodes[cur].parentId == 0) break;
-                cur = indexOfId(nodes[cur].parentId);
             }
+            for (int p : path) state[p] = 2;
         }
         invalidateIdCache();
         return r;
@@ -548,7 +635,7 @@ struct NodeTree {
         QVector<OverlapPair> out;
         if (nodes.isEmpty()) return out;
 
-        // Build child map once. childrenOf() lazily fills m_childCache;
+        // Build child map once. children() lazily fills m_children;
         // we want the same data without the mutable cache side effect
         // (this is a const method).
         QHash<uint64_t, QVector<int>> childMap;
@@ -610,12 +697,68 @@ struct NodeTree {
         return m_idCache.value(id, -1);
     }
 
+    // Children of `parentId` (0 = the roots) as node indices, in node order.
+    ChildSpan children(uint64_t parentId) const {
+        if (!m_children.built || m_children.spilled > m_children.kids.size() / 4 + 64)
+            buildChildIndex();
+        if (!m_children.spill.isEmpty()) {
+            auto it = m_children.spill.constFind(parentId);
+            if (it != m_children.spill.constEnd())
+                return {it->constData(), it->constData() + it->size()};
+        }
+        return csrRow(parentId);
+    }
+
+    // Owning copy of children(), for callers that mutate the tree while
+    // iterating.
     QVector<int> childrenOf(uint64_t parentId) const {
-        if (m_childCache.isEmpty() && !nodes.isEmpty()) {
-            for (int i = 0; i < nodes.size(); i++)
-                m_childCache[nodes[i].parentId].append(i);
+        const ChildSpan kids = children(parentId);
+        return QVector<int>(kids.begin(), kids.end());
+    }
+
+    // The index with any spilled rows folded back in, for walkers that
+    // want the raw CSR arrays (compose keeps a sorted copy of them).
+    const ChildIndex& childIndex() const {
+        if (!m_children.built || !m_children.spill.isEmpty())
+            buildChildIndex();
+        return m_children;
+    }
+
+    ChildSpan csrRow(uint64_t parentId) const {
+        auto it = m_children.row.constFind(parentId);
+        if (it == m_children.row.constEnd()) return {};
+        const int* kids = m_children.kids.constData();
+        return {kids + m_children.start.at(*it), kids + m_children.start.at(*it + 1)};
+    }
+
+    // Counting sort of node indices by parent: count per row, prefix-sum
+    // into row starts, then scatter in node order.
+    void buildChildIndex() const {
+        ChildIndex& c = m_children;
+        const int n = nodes.size();
+        c.row.clear();
+        c.spill.clear();
+        c.spilled = 0;
+        QVector<int> rowOf(n);
+        QVector<int> counts;
+        for (int i = 0; i < n; i++) {
+            auto it = c.row.find(nodes[i].parentId);
+            if (it == c.row.end()) {
+                it = c.row.insert(nodes[i].parentId, counts.size());
+                counts.append(0);
+            }
+            rowOf[i] = *it;
+            counts[*it]++;
         }
-        return m_childCache.value(parentId);
+        c.start.resize(counts.size() + 1);
+        c.start[0] = 0;
+        for (int r = 0; r < counts.size(); r++)
+            c.start[r + 1] = c.start[r] + counts[r];
+        c.kids.resize(n);
+        QVector<int> fill(c.start.begin(), c.start.end() - 1);
+        for (int i = 0; i < n; i++)
+            c.kids[fill[rowOf[i]]++] = i;
+        c.built = true;
     }
 
     // Inverse of fieldPath: resolve a dot-path back to a node id. Returns 0
@@ -682,13 +825,7 @@ struct NodeTree {
     QVector<int> subtreeIndices(uint64_t nodeId) const {
         int idx = indexOfId(nodeId);
         if (idx < 0) return {};
-        // Reuse cached childMap instead of rebuilding from scratch each call
-        if (m_childCache.isEmpty() && !nodes.isEmpty()) {
-            for (int i = 0; i < nodes.size(); i++)
-                m_childCache[nodes[i].parentId].append(i);
-        }
-        const auto& childMap = m_childCache;
-        // BFS with visited guard
+        // DFS over the cached child index, with a visited guard
         QVector<int> result;
         QSet<uint64_t> visited;
         QVector<uint64_t> stack;
@@ -697,7 +834,7 @@ struct NodeTree {
         visited.insert(nodeId);
         while (!stack.isEmpty()) {
             uint64_t pid = stack.takeLast();
-            for (int ci : childMap.value(pid)) {
+            for (int ci : children(pid)) {
                 uint64_t cid = nodes[ci].id;
                 if (!visited.contains(cid)) {
                     visited.insert(cid);
@@ -780,7 +917,14 @@ struct NodeTree {
             return declaredSize;
 
         int maxEnd = 0;
-        QVector<int> kids = childMap ? childMap->value(structId) : childrenOf(structId);
+        QVector<int> mapped;
+        ChildSpan kids;
+        if (childMap) {
+            mapped = childMap->value(structId);
+            kids = {mapped.constData(), mapped.constData() + mapped.size()};
+        } else {
+            kids = children(structId);
+        }
         for (int ci : kids) {
             const Node& c = nodes[ci];
             int sz = (c.kind == NodeKind::Struct || c.kind == NodeKind::Array)
@@ -800,7 +944,9 @@ struct NodeTree {
     QSet<uint64_t> normalizePreferAncestors(const QSet<uint64_t>& ids) const;
     QSet<uint64_t> normalizePreferDescendants(const QSet<uint64_t>& ids) const;
 
-    QJsonObject toJson() const {
+    // Everything but the node list. Shared by the JSON form and the binary
+    // .rcxb one (rcxb.h), which stores the nodes as records instead.
+    QJsonObject headerJson() const {
         QJsonObject o;
         o["baseAddress"] = QString::number(baseAddress, 16);
         if (!baseAddressFormula.isEmpty())
@@ -810,9 +956,6 @@ struct NodeTree {
         if (pointerSize != 8)
             o["pointerSize"] = pointerSize;
         o["nextId"]      = QString::number(m_nextId);
-        QJsonArray arr;
-        for (const auto& n : nodes) arr.append(n.toJson());
-        o["nodes"] = arr;
         if (!bookmarks.isEmpty()) {
             QJsonArray ba;
             for (const auto& b : bookmarks) ba.append(b.toJson());
@@ -821,24 +964,38 @@ struct NodeTree {
         return o;
     }
 
+    void readHeaderJson(const QJsonObject& o) {
+        baseAddress = o["baseAddress"].toString("400000").toULongLong(nullptr, 16);
+        baseAddressFormula = o["baseAddressFormula"].toString();
+        initialClass       = o["initialClass"].toString();
+        pointerSize = o["pointerSize"].toInt(8);
+        m_nextId    = o["nextId"].toString("1").toULongLong();
+        QJsonArray ba = o["bookmarks"].toArray();
+        bookmarks.clear();
+        bookmarks.reserve(ba.size());
+        for (const auto& v : ba)
+            bookmarks.append(Bookmark::fromJson(v.toObject()));
+    }
+
+    QJsonObject toJson() const {
+        QJsonObject o = headerJson();
+        QJsonArray arr;
+        for (const auto& n : nodes) arr.append(n.toJson());
+        o["nodes"] = arr;
+        return o;
+    }
+
     static NodeTree fromJson(const QJsonObject& o) {
         NodeTree t;
-        t.baseAddress = o["baseAddress"].toString("400000").toULongLong(nullptr, 16);
-        t.baseAddressFormula = o["baseAddressFormula"].toString();
-        t.initialClass       = o["initialClass"].toString();
-        t.pointerSize = o["pointerSize"].toInt(8);
-        t.m_nextId    = o["nextId"].toString("1").toULongLong();
+        t.readHeaderJson(o);
         QJsonArray arr = o["nodes"].toArray();
         t.nodes.reserve(arr.size());
+        StringInterner strings;
         for (const auto& v : arr) {
-            Node n = Node::fromJson(v.toObject());
+            Node n = Node::fromJson(v.toObject(), &strings);
             t.nodes.append(n);
             if (n.id >= t.m_nextId) t.m_nextId = n.id + 1;
         }
-        QJsonArray ba = o["bookmarks"].toArray();
-        t.bookmarks.reserve(ba.size());
-        for (const auto& v : ba)
-            t.bookmarks.append(Bookmark::fromJson(v.toObject()));
         return t;
     }
 
@@ -873,31 +1030,92 @@ inline QStringList rootClassNames(const NodeTree& tree) {
 }
 
 // ── Value History (ring buffer for heatmap) ──
+//
+// Records the raw bytes of each distinct value a field takes, not its
+// display string: the refresh tick only copies bytes, and the popup and
+// node.history format samples on demand against the node's current type
+// (fmt::historyValue). Samples sit in one flat per-field arena whose stride
+// is the value width (16 bytes or fewer for every scalar kind); the arena
+// doubles up to `capacity` and then wraps, so a field that changes every
+// tick stops allocating once its ring is full and a field that never
+// changes costs a single slot.
 
 struct ValueHistory {
-    static constexpr int kCapacity = 10;
-    std::array<QString, kCapacity> values;
-    std::array<qint64, kCapacity> timestamps{};  // msec since epoch
+    static constexpr int kDefaultCapacity = 1024;
+    // Sample flag: the bytes are a dereferenced primitive pointer's target
+    // (displayed "-> value"), not the field's own bytes.
+    static constexpr uint8_t kDeref = 0x1;
+
+    struct Sample {
+        const uint8_t* bytes;
+        int            len;
+        uint8_t        flags;
+        qint64         msec;    // msec since epoch
+    };
+
+    // Capacity given to histories created without an explicit one.
+    static int defaultCapacity() { return s_defaultCapacity; }
+    static void setDefaultCapacity(int n) { s_defaultCapacity = qBound(2, n, 1 << 20); }
+
+    ValueHistory() : m_capacity(s_defaultCapacity) {}
+    explicit ValueHistory(int capacity) : m_capacity(qBound(2, capacity, 1 << 20)) {}
+
     int count = 0;   // total unique values recorded
-    int head  = 0;   // next write position in ring
 
-    void record(const QString& v) {
+    // Appends the value unless it equals the newest sample (same bytes and
+    // flags). Returns true when a sample was recorded. A width change with
+    // unchanged flags means the node was retyped; the old samples can't be
+    // formatted as the new type, so the ring restarts. A width change that
+    // comes with a flag change is a primitive pointer moving between null
+    // (its own bytes) and dereferenced (its target's): still the same
+    // field, so the samples stay and the arena widens if it has to.
+    bool record(const void* data, int len, uint8_t flags = 0,
+                qint64 msec = QDateTime::currentMSecsSinceEpoch()) {
+        if (len <= 0) return false;
         if (count > 0) {
-            int last = (head + kCapacity - 1) % kCapacity;
-            if (values[last] == v) return;  // no change
+            int last = (m_head + m_slots - 1) % m_slots;
+            if (m_flags[last] == flags) {
+                if (m_lens[last] != len)
+                    clear();
+                else if (memcmp(m_bytes.data() + size_t(last) * m_width, data, len) == 0)
+                    return false;
+            }
         }
-        values[head] = v;
-        timestamps[head] = QDateTime::currentMSecsSinceEpoch();
-        head = (head + 1) % kCapacity;
+        if (len > m_width) widen(len);
+        if (m_head == m_slots) {
+            if (m_slots < m_capacity) {
+                // Not wrapped yet (wrapping only starts at full capacity),
+                // so samples are contiguous in [0, m_head) and survive growth.
+                m_slots = qMin(m_capacity, qMax(4, m_slots * 2));
+                m_bytes.resize(size_t(m_slots) * m_width);
+                m_times.resize(m_slots);
+                m_flags.resize(m_slots);
+                m_lens.resize(m_slots);
+            } else {
+                m_head = 0;
+            }
+        }
+        memcpy(m_bytes.data() + size_t(m_head) * m_width, data, len);
+        m_times[m_head] = msec;
+        m_flags[m_head] = flags;
+        m_lens[m_head]  = len;
+        m_head++;
         if (count < INT_MAX) count++;
+        return true;
     }
 
+    // Keeps the arena; only drops the samples.
     void clear() {
         count = 0;
-        head = 0;
+        m_head = 0;
     }
 
-    int uniqueCount() const { return qMin(count, kCapacity); }
+    int capacity() const { return m_capacity; }
+    // Width of the newest sample (the arena stride when empty).
+    int width() const {
+        return count > 0 ? m_lens[(m_head + m_slots - 1) % m_slots] : m_width;
+    }
+    int uniqueCount() const { return qMin(count, m_capacity); }
 
     // 0=static, 1=cold(2 unique), 2=warm(3-4), 3=hot(5+)
     int heatLevel() const {
@@ -907,29 +1125,48 @@ struct ValueHistory {
         return 3;
     }
 
-    QString last() const {
-        if (count == 0) return {};
-        return values[(head + kCapacity - 1) % kCapacity];
+    // i = 0 is the newest sample; i < uniqueCount().
+    Sample at(int i) const {
+        int idx = (m_head + m_slots - 1 - i) % m_slots;
+        return {m_bytes.data() + size_t(idx) * m_width, m_lens[idx], m_flags[idx], m_times[idx]};
     }
 
     // Iterate from oldest to newest (up to uniqueCount entries)
     template<typename Fn>
     void forEach(Fn&& fn) const {
-        int n = uniqueCount();
-        int start = (head + kCapacity - n) % kCapacity;
-        for (int i = 0; i < n; i++)
-            fn(values[(start + i) % kCapacity]);
+        for (int i = uniqueCount() - 1; i >= 0; i--)
+            fn(at(i));
     }
 
-    // Iterate with timestamps from newest to oldest
+    // Iterate from newest to oldest, stopping after `limit` samples when
+    // limit >= 0 (the popup only shows the recent end of a deep ring).
     template<typename Fn>
-    void forEachWithTime(Fn&& fn) const {
+    void forEachWithTime(Fn&& fn, int limit = -1) const {
         int n = uniqueCount();
-        for (int i = 0; i < n; i++) {
-            int idx = (head + kCapacity - 1 - i) % kCapacity;
-            fn(values[idx], timestamps[idx]);
-        }
+        if (limit >= 0) n = qMin(n, limit);
+        for (int i = 0; i < n; i++)
+            fn(at(i));
+    }
+
+private:
+    // Re-lay the arena at a wider stride, keeping every slot's bytes.
+    void widen(int width) {
+        std::vector<uint8_t> bytes(size_t(m_slots) * width);
+        for (int i = 0; i < m_slots; ++i)
+            memcpy(bytes.data() + size_t(i) * width, m_bytes.data() + size_t(i) * m_width, m_width);
+        m_bytes.swap(bytes);
+        m_width = width;
     }
+
+    static inline int s_defaultCapacity = kDefaultCapacity;
+    int m_capacity;
+    int m_width = 0;   // arena stride: the widest sample kept
+    int m_slots = 0;   // allocated samples, <= m_capacity
+    int m_head  = 0;   // next write position in ring
+    std::vector<uint8_t> m_bytes;
+    std::vector<qint64>  m_times;
+    std::vector<uint8_t> m_flags;
+    std::vector<int>     m_lens;
 };
 
 // ── LineMeta ──
@@ -1057,9 +1294,13 @@ struct LineMeta {
     int      lineByteCount  = 0;     // Hex preview: actual data byte count on this line
     int      effectiveTypeW = 14;  // Per-line type column width used for rendering
     int      effectiveNameW = 22;  // Per-line name column width used for rendering
+    int      fmtTypeW       = -1;  // typeW handed to fmtNodeLine before compact overflow
+                                   // widening (-1 = line not built by fmtNodeLine); lets
+                                   // recomposeChanged() re-format the row on its own
     QString  pointerTargetName;    // Resolved target type name for Pointer32/64 (empty = "void")
     bool     isArrayElement  = false;  // true for synthesized primitive array element lines
     bool     isMemberLine   = false;  // true for enum member / bitfield member lines
+    bool     isPlaceholder  = false;  // stand-in row outside the compose window (see ComposeWindow)
     int      braceCol       = -1;      // Column of trailing '{' on header lines (-1 = none); avoids per-char IPC scan
     uint64_t parentAddr     = 0;       // Absolute address of enclosing container (for relative offset display)
 
@@ -1137,6 +1378,17 @@ struct ComposeResult {
     //   texts in O(1) instead of re-splitting on '\n'.
     int                maxLineLen = 0;
     QVector<int>       lineStarts;
+    // Every compose()/recomposeChanged() stamps a fresh revision. An
+    // incremental result also names the revision it patched and the
+    // [first, last] line ranges whose text changed, so an editor still
+    // showing baseRevision can rewrite just those rows. baseRevision 0
+    // means a full compose — diff the whole text.
+    uint64_t           revision = 0;
+    uint64_t           baseRevision = 0;
+    QVector<QPair<int, int>> changedLines;
+    // Rows emitted as placeholders (LineMeta::isPlaceholder); 0 when the
+    // whole document was materialized.
+    int                placeholderLines = 0;
 };
 
 // ── Command ──
@@ -1550,6 +1802,8 @@ namespace fmt {
     QString indent(int depth);
     QString readValue(const Node& node, const Provider& prov,
                       uint64_t addr, int subLine);
+    QString historyValue(const Node& node, const ValueHistory::Sample& sample,
+                         int subLine = 0);
     QString editableValue(const Node& node, const Provider& prov,
                           uint64_t addr, int subLine);
     QByteArray parseValue(NodeKind kind, const QString& text, bool* ok);
@@ -1570,11 +1824,46 @@ namespace fmt {
 // or empty string if no symbol matches. Used for PDB symbol annotations on rows.
 using SymbolLookupFn = std::function<QString(uint64_t addr)>;
 
+class RttiCache;
+
+// Output lines [first, last] that must be fully composed. Containers with
+// at least kVirtualizeMinRows rows (primitive array elements, leaf
+// children of a struct) emit placeholder rows outside it: same line
+// count, depth and fold level, but no value read and no formatting, so
+// scrolling and folding stay correct while a 200k-element array costs a
+// blank line per element. first < 0 composes everything.
+struct ComposeWindow {
+    int first = -1;
+    int last  = -1;
+    bool operator==(const ComposeWindow& o) const { return first == o.first && last == o.last; }
+};
+inline constexpr int kVirtualizeMinRows = 4096;
+
+// rttiCache: long-lived vtable → RTTI memo (see rtti.h); null = per pass.
 ComposeResult compose(const NodeTree& tree, const Provider& prov, uint64_t viewRootId = 0,
                       bool compactColumns = false, bool treeLines = false,
                       bool braceWrap = false, bool typeHints = false,
                       bool showComments = true,
                       SymbolLookupFn symbolLookup = {},
-                      bool showRtti = true, bool showEnumChips = true);
+                      bool showRtti = true, bool showEnumChips = true,
+                      RttiCache* rttiCache = nullptr,
+                      ComposeWindow window = {});
+
+class ChangeBitmap;
+
+// Value-only tick: re-format, in place, just the rows of `result` whose
+// bytes are set in `changed` (absolute addresses, as diffPageInto fills it).
+// `result` must come from compose() over the same tree generation, view
+// root and options, read through `prov`. Returns false — leaving `result`
+// untouched — when a changed byte could move lines (pointer values,
+// bitfields) or the tree no longer matches; the caller then composes
+// from scratch.
+bool recomposeChanged(ComposeResult& result, const NodeTree& tree, const Provider& prov,
+                      const ChangeBitmap& changed,
+                      bool compactColumns = false, bool typeHints = false,
+                      bool showComments = true,
+                      SymbolLookupFn symbolLookup = {},
+                      bool showRtti = true, bool showEnumChips = true,
+                      RttiCache* rttiCache = nullptr);
 
 } // namespace rcx
@@ -7,10 +7,18 @@
 // byte highlight). The naive version was a per-byte compare; on big pages
 // that are mostly unchanged it's pure overhead. diffPageInto() compares 8
 // bytes at a time and only descends to per-byte work inside words that
-// actually differ. The output (a membership set of absolute offsets) is
-// byte-identical to the naive loop — see test_refresh_speedups fuzz test.
+// actually differ. The output is byte-identical to the naive loop — see
+// test_refresh_speedups fuzz test.
+//
+// The controller collects into a ChangeBitmap: one bit per byte, 512 bytes
+// per 4 KB page. A changed word becomes an 8-bit mask with a multiply
+// instead of up to eight hash inserts, and refresh() marks a line with a
+// few word tests instead of a hash lookup per byte of its span. The QSet
+// overload stays as the reference the tests and benchmark compare against.
 
+#include <QHash>
 #include <QSet>
+#include <array>
 #include <cstdint>
 #include <cstring>
 #if defined(_MSC_VER)
@@ -30,6 +38,125 @@ inline int detail_ctz64(uint64_t x) {
 #endif
 }
 
+inline int detail_popcount64(uint64_t x) {
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt64(x));
+#else
+    return __builtin_popcountll(x);
+#endif
+}
+
+// Bit k set ⇔ byte k of `x` is non-zero. Folds each byte onto its low bit,
+// then gathers the eight low bits into the top byte; the multiplier's terms
+// land on distinct bit positions, so nothing carries.
+inline uint32_t detail_nonZeroByteMask(uint64_t x) {
+    x |= x >> 4;
+    x |= x >> 2;
+    x |= x >> 1;
+    x &= 0x0101010101010101ULL;
+    return static_cast<uint32_t>((x * 0x0102040810204080ULL) >> 56);
+}
+
+// Changed-byte set over an offset space, stored as a bitmap per 4 KB page.
+// Pages appear on first write; an all-quiet tick allocates nothing.
+class ChangeBitmap {
+public:
+    static constexpr int     kPageShift = 12;
+    static constexpr int64_t kPageSize  = int64_t(1) << kPageShift;
+    static constexpr int     kWords     = int(kPageSize / 64);   // 512 bytes
+
+    bool isEmpty() const { return m_pages.isEmpty(); }
+    void clear()         { m_pages.clear(); }
+
+    void set(int64_t off) {
+        page(off >> kPageShift)[size_t(off & (kPageSize - 1)) >> 6]
+            |= uint64_t(1) << (off & 63);
+    }
+
+    // Set bit k for every bit k of `mask` (the low 8): bytes off..off+7.
+    void setByteMask(int64_t off, uint32_t mask) {
+        if ((off & 7) == 0) {
+            page(off >> kPageShift)[size_t(off & (kPageSize - 1)) >> 6]
+                |= uint64_t(mask & 0xFF) << (off & 63);
+            return;
+        }
+        for (; mask; mask &= mask - 1)
+            set(off + detail_ctz64(mask));
+    }
+
+    bool test(int64_t off) const {
+        auto it = m_pages.constFind(off >> kPageShift);
+        return it != m_pages.constEnd()
+            && ((*it)[size_t(off & (kPageSize - 1)) >> 6] >> (off & 63) & 1);
+    }
+
+    // Any changed byte in [lo, hi)? One hash probe per page touched and a
+    // masked test per 64-byte word.
+    bool anyInRange(int64_t lo, int64_t hi) const {
+        bool any = false;
+        scan(lo, hi, [&](int64_t, uint64_t) { any = true; return false; });
+        return any;
+    }
+
+    // Call fn(offset) for each changed byte in [lo, hi), ascending.
+    template <typename Fn>
+    void forEachInRange(int64_t lo, int64_t hi, Fn fn) const {
+        scan(lo, hi, [&](int64_t wordBase, uint64_t bits) {
+            for (; bits; bits &= bits - 1)
+                fn(wordBase + detail_ctz64(bits));
+            return true;
+        });
+    }
+
+    // OR every byte set in `o` into this map.
+    void merge(const ChangeBitmap& o) {
+        for (auto it = o.m_pages.constBegin(); it != o.m_pages.constEnd(); ++it) {
+            uint64_t* dst = page(it.key());
+            for (int w = 0; w < kWords; ++w) dst[w] |= (*it)[size_t(w)];
+        }
+    }
+
+    int count() const {
+        int n = 0;
+        for (const Page& p : m_pages)
+            for (uint64_t w : p) n += detail_popcount64(w);
+        return n;
+    }
+
+private:
+    using Page = std::array<uint64_t, kWords>;
+
+    uint64_t* page(int64_t index) {
+        auto it = m_pages.find(index);
+        if (it == m_pages.end()) it = m_pages.insert(index, Page{});
+        return it->data();
+    }
+
+    // Walk the non-zero words of [lo, hi), masked to the range; fn(base of
+    // the word, bits) returns false to stop.
+    template <typename Fn>
+    void scan(int64_t lo, int64_t hi, Fn fn) const {
+        while (lo < hi) {
+            const int64_t pageIdx  = lo >> kPageShift;
+            const int64_t pageBase = pageIdx << kPageShift;
+            const int64_t end      = hi < pageBase + kPageSize ? hi : pageBase + kPageSize;
+            auto it = m_pages.constFind(pageIdx);
+            if (it != m_pages.constEnd()) {
+                for (int64_t w = lo & ~int64_t(63); w < end; w += 64) {
+                    uint64_t bits = (*it)[size_t(w - pageBase) >> 6];
+                    if (!bits) continue;
+                    if (w < lo)       bits &= ~uint64_t(0) << (lo - w);
+                    if (end - w < 64) bits &= ~(~uint64_t(0) << (end - w));
+                    if (bits && !fn(w, bits)) return;
+                }
+            }
+            lo = end;
+        }
+    }
+
+    QHash<int64_t, Page> m_pages;   // key: offset >> kPageShift
+};
+
 // Insert pageAddr + i into `out` for every i in [0, len) where
 // oldP[i] != newP[i]. Returns true if any byte differed.
 //
@@ -66,4 +193,28 @@ inline bool diffPageInto(QSet<int64_t>& out, uint64_t pageAddr,
     return changed;
 }
 
+// Same diff into a ChangeBitmap: each differing word is reduced to a byte
+// mask and OR'd into the page bitmap whole.
+inline bool diffPageInto(ChangeBitmap& out, uint64_t pageAddr,
+                         const char* oldP, const char* newP, int len) {
+    bool changed = false;
+    const int64_t base = static_cast<int64_t>(pageAddr);
+    int i = 0;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t a, b;
+        std::memcpy(&a, oldP + i, 8);
+        std::memcpy(&b, newP + i, 8);
+        if (a == b) continue;
+        changed = true;
+        out.setByteMask(base + i, detail_nonZeroByteMask(a ^ b));
+    }
+    for (; i < len; ++i) {
+        if (oldP[i] != newP[i]) {
+            out.set(base + i);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
 } // namespace rcx
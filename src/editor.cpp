@@ -226,6 +226,7 @@ static QWidget* buildTextBodyWidget(const QString& body, const QFont& font,
 // - A thin separator inserted between the newest row and the rest so
 //   the eye can lock onto "current vs previous" at a glance.
 static QWidget* buildValueHistoryBody(const ValueHistory& hist,
+                                       const Node& node, int subLine,
                                        const QFont& font, const Theme& theme,
                                        QWidget* parent,
                                        bool showButtons = false,
@@ -290,13 +291,16 @@ static QWidget* buildValueHistoryBody(const ValueHistory& hist,
 
     // Pre-collect entries so we can compute pairwise deltas. forEachWithTime
     // streams newest → oldest, so entries[0] is current and entries[N-1]
-    // is the oldest visible.
+    // is the oldest visible. The ring holds raw bytes and can be ~1000
+    // deep; only the recent end is formatted and shown.
+    static constexpr int kMaxRows = 64;
     struct Entry { QString v; qint64 msec; std::optional<int64_t> num; };
     QVector<Entry> entries;
-    entries.reserve(hist.uniqueCount());
-    hist.forEachWithTime([&](const QString& v, qint64 msec) {
-        entries.append({v, msec, tryParseAsInt(v)});
-    });
+    entries.reserve(qMin(hist.uniqueCount(), kMaxRows));
+    hist.forEachWithTime([&](const ValueHistory::Sample& sample) {
+        QString v = fmt::historyValue(node, sample, subLine);
+        entries.append({v, sample.msec, tryParseAsInt(v)});
+    }, kMaxRows);
 
     // Build occurrence count map so we can tag repeats. Ring dedups
     // consecutive duplicates at record(), but a value that flips back
@@ -350,7 +354,7 @@ static QWidget* buildValueHistoryBody(const ValueHistory& hist,
     hoverBg.setAlpha(70);  // distinctly stronger than the zebra stripe
                            // so the hovered row visibly pops out
 
-    const int unique = hist.uniqueCount();
+    const int unique = entries.size();
 
     // Body header — "5 entries · 3 unique · since 12m ago". Compact,
     // italic, in textMuted. The 3-part summary covers: (a) ring depth,
@@ -901,18 +905,19 @@ static QWidget* buildValueHistoryBody(const ValueHistory& hist,
         }
     }
 
-    // Ring-overflow indicator. ValueHistory caps at kCapacity entries;
-    // when `count` exceeds that, earlier values are silently dropped.
-    // Surface the drop count so the user knows "10 visible isn't the
-    // whole story". Keeps the user's mental model honest — without
-    // this, the popup looks like a complete log when it's actually a
-    // sliding window.
+    // Overflow indicator. Only the newest kMaxRows samples are listed,
+    // and the ring itself evicts past its capacity; surface what's not
+    // shown so the user knows the visible rows aren't the whole story.
+    // Keeps the user's mental model honest — without this, the popup
+    // looks like a complete log when it's actually a sliding window.
     if (hist.count > unique) {
-        int discarded = hist.count - unique;
-        auto* overflow = new QLabel(
-            QStringLiteral("+ %1 earlier value%2 discarded")
-                .arg(discarded).arg(discarded == 1 ? "" : "s"),
-            container);
+        int hidden    = hist.count - unique;
+        int discarded = hist.count - hist.uniqueCount();
+        QString text = QStringLiteral("+ %1 earlier value%2")
+            .arg(hidden).arg(hidden == 1 ? "" : "s");
+        if (discarded > 0)
+            text += QStringLiteral(" (%1 discarded)").arg(discarded);
+        auto* overflow = new QLabel(text, container);
         QFont smallFont = font;
         smallFont.setPointSizeF(qMax(7.0, font.pointSizeF() - 1.0));
         smallFont.setItalic(true);
@@ -924,10 +929,10 @@ static QWidget* buildValueHistoryBody(const ValueHistory& hist,
         // understands WHY values are dropped (instead of assuming
         // a bug). Always shows total recorded — handy stat.
         overflow->setToolTip(QStringLiteral(
-            "ValueHistory is a %1-entry ring buffer.\n"
-            "Total recorded for this node: %2.\n"
+            "ValueHistory is a %1-entry ring buffer; the newest %2 are listed.\n"
+            "Total recorded for this node: %3.\n"
             "Older values are evicted as new ones arrive.")
-            .arg(ValueHistory::kCapacity).arg(hist.count));
+            .arg(hist.capacity()).arg(kMaxRows).arg(hist.count));
         vbox->addWidget(overflow);
     }
 
@@ -993,8 +998,8 @@ static QWidget* buildValueHistoryBody(const ValueHistory& hist,
 // kHostRows = 8 fits the cap on every preview:
 //   - HexDump / Disasm: capped at 6 lines via capLines()
 //   - StructTarget:     capped at 5 lines
-//   - ValueHistory:     ring of 10 entries, but typical visible run
-//                       is < 8; remainder clips internally
+//   - ValueHistory:     lists up to 64 recent entries, but typical
+//                       visible run is < 8; remainder scrolls internally
 //
 // 8 means even the busiest preview sits without scrolling under most
 // conditions, and the popup never shrinks below a comfortable read.
@@ -1432,12 +1437,12 @@ public:
         auto it = ctx.history->find(lm.nodeId);
         return it != ctx.history->end() && it->uniqueCount() > 1;
     }
-    QWidget* widget(const LineMeta& lm, const Node& /*node*/,
+    QWidget* widget(const LineMeta& lm, const Node& node,
                     const HoverContext& ctx, QWidget* parent) override {
         if (!ctx.history) return nullptr;
         auto it = ctx.history->find(lm.nodeId);
         if (it == ctx.history->end()) return nullptr;
-        return buildValueHistoryBody(*it, ctx.editorFont, *ctx.theme, parent,
+        return buildValueHistoryBody(*it, node, lm.subLine, ctx.editorFont, *ctx.theme, parent,
                                      ctx.editMode, ctx.onValueSet);
     }
 };
@@ -1826,6 +1831,7 @@ RcxEditor::RcxEditor(QWidget* parent) : QWidget(parent) {
     // deceleration, etc.) so the highlight tracks whatever is under the cursor.
     connect(m_sci->verticalScrollBar(), &QScrollBar::valueChanged,
             this, [this]() {
+        emit viewportScrolled();
         if (m_editState.active || !m_hoverInside) return;
         m_lastHoverPos = m_sci->viewport()->mapFromGlobal(QCursor::pos());
         m_hoverInside = m_sci->viewport()->rect().contains(m_lastHoverPos);
@@ -2488,6 +2494,64 @@ void RcxEditor::applyTheme(const Theme& theme) {
     }
 }
 
+bool RcxEditor::patchChangedLines(const ComposeResult& result, long& byteStart, long& byteLen) {
+    const int n = result.meta.size();
+    const long sciLines = m_sci->SendScintilla(QsciScintillaBase::SCI_GETLINECOUNT);
+    if (sciLines != n || m_prevMeta.size() != n || result.lineStarts.size() != n)
+        return false;
+    // Line 0 is the command row — updateCommandRow owns it, compose never
+    // reports it.
+    for (const auto& r : result.changedLines)
+        if (r.first < 1 || r.second < r.first || r.second >= n) return false;
+
+    auto newLineEnd = [&](int line) {
+        return line + 1 < n ? result.lineStarts[line + 1] - 1 : (int)result.text.size();
+    };
+    // m_prevText is the base text except for line 0, which
+    // setCommandRowText rewrites in place; every later row sits shifted by
+    // that length difference.
+    const int prevLine0End = m_prevText.indexOf('\n');
+    if (prevLine0End < 0) return false;
+    const int line0Shift = prevLine0End - newLineEnd(0);
+
+    m_sci->setReadOnly(false);
+    for (const auto& r : result.changedLines) {
+        const int newStart = result.lineStarts[r.first];
+        const QString seg = result.text.mid(newStart, newLineEnd(r.second) - newStart);
+        // Ranges ascend, so every row above this one already matches the
+        // new text and the shift stays line0Shift.
+        const int oldStart = newStart + line0Shift;
+        int oldEnd = oldStart;
+        for (int line = r.first; line <= r.second; ++line) {
+            if (line > r.first) ++oldEnd;  // step over the '\n'
+            while (oldEnd < m_prevText.size() && m_prevText[oldEnd] != '\n') ++oldEnd;
+        }
+        m_prevText.replace(oldStart, oldEnd - oldStart, seg);
+
+        const QByteArray utf8 = seg.toUtf8();
+        long from = m_sci->SendScintilla(QsciScintillaBase::SCI_POSITIONFROMLINE,
+                                         (unsigned long)r.first);
+        long to   = m_sci->SendScintilla(QsciScintillaBase::SCI_GETLINEENDPOSITION,
+                                         (unsigned long)r.second);
+        m_sci->SendScintilla(QsciScintillaBase::SCI_SETTARGETSTART, from);
+        m_sci->SendScintilla(QsciScintillaBase::SCI_SETTARGETEND, to);
+        m_sci->SendScintilla(QsciScintillaBase::SCI_REPLACETARGET,
+                             (uintptr_t)utf8.size(), utf8.constData());
+    }
+    m_sci->setReadOnly(true);
+
+    byteStart = 0;
+    byteLen = 0;
+    if (!result.changedLines.isEmpty()) {
+        byteStart = m_sci->SendScintilla(QsciScintillaBase::SCI_POSITIONFROMLINE,
+                                         (unsigned long)result.changedLines.first().first);
+        byteLen = m_sci->SendScintilla(QsciScintillaBase::SCI_GETLINEENDPOSITION,
+                                       (unsigned long)result.changedLines.last().second)
+                - byteStart;
+    }
+    return true;
+}
+
 void RcxEditor::applyDocument(const ComposeResult& result) {
     PROFILE_SCOPE("applyDocument");
     // Silently deactivate inline edit (no signal — refresh is already happening)
@@ -2536,7 +2600,16 @@ void RcxEditor::applyDocument(const ComposeResult& result) {
         // Falls back to full setText only when the diff covers >50% of
         // the document or the previous text was empty.
         const QString& newText = result.text;
-        if (!m_prevText.isEmpty()
+        // Incremental compose already knows which rows it rewrote — skip
+        // the whole-text diff when we're still showing its base.
+        bool linePatched = false;
+        if (result.baseRevision != 0 && result.baseRevision == m_prevRevision
+            && !m_prevText.isEmpty()) {
+            PROFILE_SCOPE("applyDocument.linePatch");
+            linePatched = patchChangedLines(result, patchByteStart, patchByteLen);
+            didPatch = linePatched;
+        }
+        if (!linePatched && !m_prevText.isEmpty()
             && m_prevText.size() > 0 && newText.size() > 0) {
             PROFILE_SCOPE("applyDocument.diff");
             const int oldN = m_prevText.size();
@@ -2642,7 +2715,9 @@ void RcxEditor::applyDocument(const ComposeResult& result) {
             // line 0 with the proper text.
             m_lastCommandRowText.clear();
         }
-        m_prevText = newText;
+        if (!linePatched)
+            m_prevText = newText;
+        m_prevRevision = result.revision;
         m_lastApplyWasPatch = didPatch;
     }
 
@@ -2707,6 +2782,7 @@ void RcxEditor::applyDocument(const ComposeResult& result) {
                 && a.isArrayHeader == b.isArrayHeader
                 && a.isArrayElement == b.isArrayElement
                 && a.isMemberLine == b.isMemberLine
+                && a.isPlaceholder == b.isPlaceholder
                 && a.heatLevel == b.heatLevel
                 && a.chips.size() == b.chips.size()
                 && std::equal(a.chips.cbegin(), a.chips.cend(), b.chips.cbegin(),
@@ -4617,6 +4693,7 @@ RcxEditor::EndEditInfo RcxEditor::endInlineEdit() {
     // bug). Clearing prevText forces fullReplace on the next refresh —
     // one extra setText per edit, which is bounded and worth it.
     m_prevText.clear();
+    m_prevRevision = 0;
     EndEditInfo info{m_editState.nodeIdx, m_editState.subLine, m_editState.target};
     m_editState.active = false;
     // Clear IND_EDIT_BOUNDS + reset byte-range state if this was a
@@ -6526,7 +6603,7 @@ bool RcxEditor::beginInlineEdit(EditTarget target, int line, int col) {
             m_sci->getCursorPosition(&line, &c);
         }
         auto* lm = metaForLine(line);
-        if (!lm) return false;
+        if (!lm || lm->isPlaceholder) return false;
         // Reject lines that don't support type editing
         if (lm->nodeIdx < 0) return false;              // CommandRow etc.
         if (lm->lineKind == LineKind::Footer) return false;
@@ -6577,7 +6654,7 @@ bool RcxEditor::beginInlineEdit(EditTarget target, int line, int col) {
         m_sci->getCursorPosition(&line, &col);
     }
     auto* lm = metaForLine(line);
-    if (!lm) return false;
+    if (!lm || lm->isPlaceholder) return false;  // placeholder: not composed yet
     // Allow nodeIdx=-1 only for CommandRow editing (command bar)
     if (lm->nodeIdx < 0 && !(lm->lineKind == LineKind::CommandRow &&
         (target == EditTarget::BaseAddress || target == EditTarget::Source
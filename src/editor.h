@@ -189,6 +189,9 @@ signals:
     // the composed text so a minimap (or any passive mirror) can copy it
     // without polling.
     void documentApplied(const QString& text);
+    // Vertical scroll moved. The controller recomposes when the viewport
+    // nears placeholder rows of a virtualized container.
+    void viewportScrolled();
     void quickTypeChangeRequested(int nodeIdx, NodeKind targetKind);
     void cycleSameSizeTypeRequested(int nodeIdx, int direction);  // -1=prev, +1=next
     void moveNodeRequested(int nodeIdx, int direction);  // -1=up, +1=down
@@ -258,6 +261,9 @@ private:
     // append/edit case.
     QString           m_prevText;
     QVector<LineMeta> m_prevMeta;
+    // ComposeResult::revision of the last applied result; an incremental
+    // result based on it can patch its changedLines directly.
+    uint64_t          m_prevRevision = 0;
     // Tracks whether the last applyDocument took the patch path (cheap, no
     // marker loss outside the patched range) or the full-replace path
     // (which wipes all markers). applySelectionOverlay uses this together
@@ -485,6 +491,10 @@ private:
     // CURRENT font + zoom. Must be re-run on zoom changes or the larger
     // glyphs overflow the fixed pixel width and the offset gets clipped.
     void updateOffsetMarginWidth();
+    // Rewrite only result.changedLines (Scintilla + m_prevText). Returns
+    // false without touching anything when the document doesn't line up
+    // with the result's base; the caller then diffs the full text.
+    bool patchChangedLines(const ComposeResult& result, long& byteStart, long& byteLen);
 
     // Optional [first, last] line range. When set (>=0), the per-line pass
     // operates only on those lines; markers/indicators on lines outside
@@ -521,6 +521,27 @@ QString readValue(const Node& node, const Provider& prov,
     return readValueImpl(node, prov, addr, subLine, ValueMode::Display);
 }
 
+// Formats a recorded ValueHistory sample as readValue would have shown it
+// at record time, using the node's current type.
+QString historyValue(const Node& node, const ValueHistory::Sample& sample,
+                     int subLine) {
+    BufferProvider prov(QByteArray(reinterpret_cast<const char*>(sample.bytes),
+                                   sample.len));
+    if (sample.flags & ValueHistory::kDeref) {
+        Node tmp;
+        tmp.kind = node.elementKind;
+        tmp.strLen = node.strLen;
+        return QStringLiteral("-> ") + readValueImpl(tmp, prov, 0, 0, ValueMode::Display);
+    }
+    if (node.kind == NodeKind::Pointer64 && node.ptrDepth > 0) {
+        // The pointer's own bytes: never chase them into the sample buffer.
+        Node tmp = node;
+        tmp.ptrDepth = 0;
+        return readValueImpl(tmp, prov, 0, subLine, ValueMode::Display);
+    }
+    return readValueImpl(node, prov, 0, subLine, ValueMode::Display);
+}
+
 // ── Full node line ──
 
 QString fmtNodeLine(const Node& node, const Provider& prov,
@@ -0,0 +1,230 @@
+#include "elf_symbols.h"
+#include <QFile>
+#include <algorithm>
+#include <cstring>
+
+namespace rcx {
+
+// Minimal ELF structures (no <elf.h> dependency, so this builds on Windows)
+#pragma pack(push, 1)
+struct Elf32Ehdr {
+    uint8_t  e_ident[16];
+    uint16_t e_type, e_machine;
+    uint32_t e_version, e_entry, e_phoff, e_shoff, e_flags;
+    uint16_t e_ehsize, e_phentsize, e_phnum, e_shentsize, e_shnum, e_shstrndx;
+};
+struct Elf64Ehdr {
+    uint8_t  e_ident[16];
+    uint16_t e_type, e_machine;
+    uint32_t e_version;
+    uint64_t e_entry, e_phoff, e_shoff;
+    uint32_t e_flags;
+    uint16_t e_ehsize, e_phentsize, e_phnum, e_shentsize, e_shnum, e_shstrndx;
+};
+struct Elf32Phdr {
+    uint32_t p_type, p_offset, p_vaddr, p_paddr, p_filesz, p_memsz, p_flags, p_align;
+};
+struct Elf64Phdr {
+    uint32_t p_type, p_flags;
+    uint64_t p_offset, p_vaddr, p_paddr, p_filesz, p_memsz, p_align;
+};
+struct Elf32Shdr {
+    uint32_t sh_name, sh_type, sh_flags, sh_addr, sh_offset, sh_size,
+             sh_link, sh_info, sh_addralign, sh_entsize;
+};
+struct Elf64Shdr {
+    uint32_t sh_name, sh_type;
+    uint64_t sh_flags, sh_addr, sh_offset, sh_size;
+    uint32_t sh_link, sh_info;
+    uint64_t sh_addralign, sh_entsize;
+};
+struct Elf32Sym {
+    uint32_t st_name, st_value, st_size;
+    uint8_t  st_info, st_other;
+    uint16_t st_shndx;
+};
+struct Elf64Sym {
+    uint32_t st_name;
+    uint8_t  st_info, st_other;
+    uint16_t st_shndx;
+    uint64_t st_value, st_size;
+};
+#pragma pack(pop)
+
+struct Elf32 { using Ehdr = Elf32Ehdr; using Phdr = Elf32Phdr; using Shdr = Elf32Shdr; using Sym = Elf32Sym; };
+struct Elf64 { using Ehdr = Elf64Ehdr; using Phdr = Elf64Phdr; using Shdr = Elf64Shdr; using Sym = Elf64Sym; };
+
+static constexpr uint8_t  kElfClass32   = 1;
+static constexpr uint8_t  kElfClass64   = 2;
+static constexpr uint8_t  kElfDataLsb   = 1;
+static constexpr uint32_t kPtLoad       = 1;
+static constexpr uint32_t kShtSymtab    = 2;
+static constexpr uint32_t kShtDynsym    = 11;
+static constexpr uint16_t kShnUndef     = 0;
+static constexpr uint16_t kShnLoReserve = 0xff00;   // ABS, COMMON, XINDEX...
+static constexpr uint8_t  kSttObject    = 1;
+static constexpr uint8_t  kSttFunc      = 2;
+static constexpr uint8_t  kSttGnuIfunc  = 10;
+static constexpr uint8_t  kStbLocal     = 0;
+static constexpr uint64_t kPageMask     = ~uint64_t(0xfff);
+
+static bool inBounds(qint64 size, uint64_t off, uint64_t len) {
+    return off <= uint64_t(size) && len <= uint64_t(size) - off;
+}
+
+template <typename T>
+static T readAt(const uchar* data, uint64_t off) {
+    T v;
+    std::memcpy(&v, data + off, sizeof(T));
+    return v;
+}
+
+namespace {
+struct RawSym {
+    uint64_t value;
+    uint64_t size;
+    const char* name;
+    int nameLen;
+    bool local;
+};
+} // namespace
+
+template <typename E>
+static bool collect(const uchar* data, qint64 size, uint64_t* loadBias,
+                    std::vector<RawSym>* out, QString* errorMsg) {
+    using Ehdr = typename E::Ehdr;
+    using Phdr = typename E::Phdr;
+    using Shdr = typename E::Shdr;
+    using Sym  = typename E::Sym;
+
+    if (!inBounds(size, 0, sizeof(Ehdr))) {
+        if (errorMsg) *errorMsg = QStringLiteral("Truncated ELF header");
+        return false;
+    }
+    const Ehdr eh = readAt<Ehdr>(data, 0);
+
+    // /proc/<pid>/maps reports the module at its lowest PT_LOAD page; RVAs
+    // are taken relative to the same point so base + rva is the live VA.
+    uint64_t bias = ~uint64_t(0);
+    if (eh.e_phentsize == sizeof(Phdr)
+        && inBounds(size, eh.e_phoff, uint64_t(eh.e_phnum) * sizeof(Phdr))) {
+        for (int i = 0; i < eh.e_phnum; ++i) {
+            const Phdr ph = readAt<Phdr>(data, eh.e_phoff + uint64_t(i) * sizeof(Phdr));
+            if (ph.p_type == kPtLoad) bias = std::min<uint64_t>(bias, ph.p_vaddr & kPageMask);
+        }
+    }
+    *loadBias = (bias == ~uint64_t(0)) ? 0 : bias;
+
+    if (eh.e_shentsize != sizeof(Shdr)
+        || !inBounds(size, eh.e_shoff, uint64_t(eh.e_shnum) * sizeof(Shdr))) {
+        if (errorMsg) *errorMsg = QStringLiteral("No readable section headers");
+        return false;
+    }
+    auto section = [&](uint32_t i) {
+        return readAt<Shdr>(data, eh.e_shoff + uint64_t(i) * sizeof(Shdr));
+    };
+
+    for (uint32_t s = 0; s < eh.e_shnum; ++s) {
+        const Shdr sh = section(s);
+        if (sh.sh_type != kShtSymtab && sh.sh_type != kShtDynsym) continue;
+        if (sh.sh_link >= eh.e_shnum || sh.sh_entsize != sizeof(Sym)) continue;
+        if (!inBounds(size, sh.sh_offset, sh.sh_size)) continue;
+        const Shdr strs = section(sh.sh_link);
+        if (!inBounds(size, strs.sh_offset, strs.sh_size)) continue;
+        const char* strBase = reinterpret_cast<const char*>(data + strs.sh_offset);
+
+        const uint64_t count = sh.sh_size / sizeof(Sym);
+        for (uint64_t i = 1; i < count; ++i) {   // entry 0 is the null symbol
+            const Sym sym = readAt<Sym>(data, sh.sh_offset + i * sizeof(Sym));
+            const uint8_t type = sym.st_info & 0xf;
+            if (type != kSttFunc && type != kSttObject && type != kSttGnuIfunc) continue;
+            if (sym.st_shndx == kShnUndef || sym.st_shndx >= kShnLoReserve) continue;
+            if (sym.st_value < *loadBias || sym.st_name >= strs.sh_size) continue;
+            const char* name = strBase + sym.st_name;
+            const void* nul = std::memchr(name, 0, size_t(strs.sh_size - sym.st_name));
+            if (!nul || nul == name) continue;
+            out->push_back({sym.st_value, sym.st_size, name,
+                            int(static_cast<const char*>(nul) - name),
+                            (sym.st_info >> 4) == kStbLocal});
+        }
+    }
+    return true;
+}
+
+int ElfSymbols::find(uint64_t rva) const {
+    auto it = std::upper_bound(syms.begin(), syms.end(), rva,
+                               [](uint64_t r, const Sym& s) { return r < s.rva; });
+    if (it == syms.begin()) return -1;
+    --it;
+    if (rva - it->rva >= std::max<uint64_t>(it->size, 1)) return -1;
+    return int(it - syms.begin());
+}
+
+std::shared_ptr<const ElfSymbols> parseElfSymbols(const uchar* data, qint64 size,
+                                                  QString* errorMsg) {
+    if (!data || size < 16 || std::memcmp(data, "\x7f" "ELF", 4) != 0) {
+        if (errorMsg) *errorMsg = QStringLiteral("Not an ELF file");
+        return nullptr;
+    }
+    if (data[5] != kElfDataLsb) {
+        if (errorMsg) *errorMsg = QStringLiteral("Big-endian ELF is not supported");
+        return nullptr;
+    }
+
+    uint64_t bias = 0;
+    std::vector<RawSym> raw;
+    bool ok = false;
+    if (data[4] == kElfClass64)      ok = collect<Elf64>(data, size, &bias, &raw, errorMsg);
+    else if (data[4] == kElfClass32) ok = collect<Elf32>(data, size, &bias, &raw, errorMsg);
+    else if (errorMsg)               *errorMsg = QStringLiteral("Unknown ELF class");
+    if (!ok) return nullptr;
+
+    // .symtab repeats most of .dynsym; for aliases (memcpy / __memcpy_avx...)
+    // prefer a global name, then the shorter one.
+    std::sort(raw.begin(), raw.end(), [](const RawSym& a, const RawSym& b) {
+        if (a.value != b.value) return a.value < b.value;
+        if (a.local != b.local) return !a.local;
+        if (a.nameLen != b.nameLen) return a.nameLen < b.nameLen;
+        return std::strcmp(a.name, b.name) < 0;
+    });
+
+    auto out = std::make_shared<ElfSymbols>();
+    for (size_t i = 0; i < raw.size(); ++i) {
+        if (i > 0 && raw[i].value == raw[i - 1].value) continue;
+        const RawSym& r = raw[i];
+        out->syms.push_back({r.value - bias,
+                             uint32_t(std::min<uint64_t>(r.size, UINT32_MAX)),
+                             uint32_t(out->names.size())});
+        out->names.append(r.name, r.nameLen);
+        out->names.append('\0');
+    }
+    out->syms.shrink_to_fit();
+    out->names.squeeze();
+    return out;
+}
+
+std::shared_ptr<const ElfSymbols> loadElfSymbols(const QString& path, QString* errorMsg) {
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        if (errorMsg) *errorMsg = f.errorString();
+        return nullptr;
+    }
+    // Check the magic before mapping: most paths a Windows target reports
+    // are PE files, and mapping them just to reject them is wasted work.
+    char magic[4] = {};
+    if (f.read(magic, 4) != 4 || std::memcmp(magic, "\x7f" "ELF", 4) != 0) {
+        if (errorMsg) *errorMsg = QStringLiteral("Not an ELF file");
+        return nullptr;
+    }
+    const qint64 size = f.size();
+    uchar* data = f.map(0, size);
+    if (!data) {
+        if (errorMsg) *errorMsg = f.errorString();
+        return nullptr;
+    }
+    auto result = parseElfSymbols(data, size, errorMsg);
+    f.unmap(data);
+    return result;
+}
+
+} // namespace rcx
@@ -0,0 +1,44 @@
+#pragma once
+#include <QByteArray>
+#include <QString>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace rcx {
+
+// Function and object symbols of one ELF module, sorted by RVA (the
+// symbol's address minus the module's lowest PT_LOAD page, i.e. relative
+// to the base /proc/<pid>/maps reports for it). Names live in one
+// NUL-separated pool so a libc-sized table stays a few hundred KB.
+struct ElfSymbols {
+    struct Sym {
+        uint64_t rva;
+        uint32_t size;      // 0 = unknown (only the exact address resolves)
+        uint32_t nameOff;   // into `names`
+    };
+    std::vector<Sym> syms;  // ascending rva, one entry per address
+    QByteArray names;
+
+    // Index of the symbol whose [rva, rva + max(size, 1)) holds `rva`,
+    // or -1.
+    int find(uint64_t rva) const;
+
+    const char* nameAt(int i) const { return names.constData() + syms[size_t(i)].nameOff; }
+    QString nameStringAt(int i) const { return QString::fromUtf8(nameAt(i)); }
+};
+
+// Parse .symtab and .dynsym out of an in-memory ELF image (32- or 64-bit,
+// little-endian). Undefined, absolute and TLS symbols are skipped; where
+// several names share an address the global one wins. Returns nullptr and
+// sets errorMsg if the image isn't an ELF file it can read.
+std::shared_ptr<const ElfSymbols> parseElfSymbols(const uchar* data, qint64 size,
+                                                  QString* errorMsg = nullptr);
+
+// Memory-map `path` and parse it. The mapping is released before this
+// returns; the table keeps only the symbols it indexed. Safe to call off
+// the GUI thread.
+std::shared_ptr<const ElfSymbols> loadElfSymbols(const QString& path,
+                                                 QString* errorMsg = nullptr);
+
+} // namespace rcx
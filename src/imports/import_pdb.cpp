@@ -1,13 +1,20 @@
 #include "import_pdb.h"
 
-#ifdef _WIN32
-
-#include <windows.h>
 #include <QFile>
+#include <QFileInfo>
 #include <QHash>
 #include <QPair>
 #include <QSet>
+#include <QThread>
 #include <QDebug>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 // ── RawPDB headers ──
 #include "PDB.h"
@@ -22,35 +29,28 @@
 namespace rcx {
 
 // ── Memory-mapped file (mirrors ExampleMemoryMappedFile) ──
+// QFile::map rather than CreateFileMapping so the importer builds on every
+// platform raw_pdb does; the mapping lives as long as the QFile.
 
 struct MappedFile {
-    HANDLE hFile = INVALID_HANDLE_VALUE;
-    HANDLE hMapping = nullptr;
+    QFile file;
     const void* base = nullptr;
     size_t size = 0;
 
     bool open(const QString& path) {
-        hFile = CreateFileW(reinterpret_cast<const wchar_t*>(path.utf16()),
-                            GENERIC_READ, FILE_SHARE_READ, nullptr,
-                            OPEN_EXISTING, FILE_ATTRIBUTE_READONLY, nullptr);
-        if (hFile == INVALID_HANDLE_VALUE) return false;
-
-        hMapping = CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
-        if (!hMapping) { close(); return false; }
-
-        base = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+        file.setFileName(path);
+        if (!file.open(QIODevice::ReadOnly)) return false;
+        const qint64 len = file.size();
+        if (len <= 0) { close(); return false; }
+        base = file.map(0, len);
         if (!base) { close(); return false; }
-
-        BY_HANDLE_FILE_INFORMATION info;
-        if (!GetFileInformationByHandle(hFile, &info)) { close(); return false; }
-        size = (static_cast<size_t>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+        size = static_cast<size_t>(len);
         return true;
     }
 
     void close() {
-        if (base) { UnmapViewOfFile(base); base = nullptr; }
-        if (hMapping) { CloseHandle(hMapping); hMapping = nullptr; }
-        if (hFile != INVALID_HANDLE_VALUE) { CloseHandle(hFile); hFile = INVALID_HANDLE_VALUE; }
+        if (base) { file.unmap(const_cast<uchar*>(static_cast<const uchar*>(base))); base = nullptr; }
+        file.close();
         size = 0;
     }
 
@@ -1060,27 +1060,41 @@ PdbSymbolResult extractPdbSymbols(const QString& pdbPath, QString* errorMsg) {
     return result;
 }
 
-// ── Public API: enumeratePdbTypes ──
+// ── Worker threads ──
+// TPI enumeration and selected-type import split their work across
+// threads once there is enough of it. Both only read the mapped file and
+// the TypeTable, which never change after PdbFile::open.
 
-QVector<PdbTypeInfo> enumeratePdbTypes(const QString& pdbPath, QString* errorMsg) {
-    PdbFile pdb;
-    if (!pdb.open(pdbPath, errorMsg)) return {};
+static int workerCountFor(int items, int minItemsPerWorker) {
+    const int byWork = items / qMax(1, minItemsPerWorker);
+    return qBound(1, qMin(byWork, QThread::idealThreadCount()), 16);
+}
 
-    const TypeTable& tt = *pdb.typeTable;
-    QVector<PdbTypeInfo> result;
+// Runs fn(worker) for workers 1..n-1 on their own threads and worker 0 on
+// the caller, then joins.
+template <typename Fn>
+static void runWorkers(int workers, Fn&& fn) {
+    std::vector<std::thread> helpers;
+    helpers.reserve(size_t(workers - 1));
+    for (int w = 1; w < workers; w++)
+        helpers.emplace_back([&fn, w]() { fn(w); });
+    fn(0);
+    for (auto& t : helpers) t.join();
+}
 
-    // Diagnostics: distinguish "TPI stream is empty (stripped public PDB)"
-    // from "TPI has records but none are UDTs we recognise" from "all the
-    // UDTs are forward-declarations". Microsoft's public symbol server
-    // ships most user-mode DLLs (advapi32, kernel32, …) with their TPI
-    // stripped, so loading them yields 0 types and that's expected — the
-    // diagnostic clarifies why.
-    const uint32_t firstTi = tt.firstIndex();
-    const uint32_t lastTi  = tt.lastIndex();
+// ── Public API: enumeratePdbTypes ──
+
+namespace {
+struct EnumeratePart {
+    QVector<PdbTypeInfo> types;
     int skippedNonUdt = 0;
     int skippedFwd = 0;
     int skippedAnon = 0;
+};
+} // namespace
 
+static void enumerateRange(const TypeTable& tt, uint32_t firstTi, uint32_t lastTi,
+                           EnumeratePart* out) {
     for (uint32_t ti = firstTi; ti < lastTi; ti++) {
         const auto* rec = tt.get(ti);
         if (!rec) continue;
@@ -1089,7 +1103,7 @@ QVector<PdbTypeInfo> enumeratePdbTypes(const QString& pdbPath, QString* errorMsg
                       rec->header.kind == TRK::LF_CLASS ||
                       rec->header.kind == TRK::LF_UNION);
         bool isEnum = (rec->header.kind == TRK::LF_ENUM);
-        if (!isUDT && !isEnum) { skippedNonUdt++; continue; }
+        if (!isUDT && !isEnum) { out->skippedNonUdt++; continue; }
 
         const char* name = nullptr;
         uint16_t fieldCount = 0;
@@ -1097,7 +1111,7 @@ QVector<PdbTypeInfo> enumeratePdbTypes(const QString& pdbPath, QString* errorMsg
         uint64_t size = 0;
 
         if (isEnum) {
-            if (rec->data.LF_ENUM.property.fwdref) { skippedFwd++; continue; }
+            if (rec->data.LF_ENUM.property.fwdref) { out->skippedFwd++; continue; }
             fieldCount = rec->data.LF_ENUM.count;
             name = rec->data.LF_ENUM.name;
             // Size from underlying type
@@ -1109,7 +1123,7 @@ QVector<PdbTypeInfo> enumeratePdbTypes(const QString& pdbPath, QString* errorMsg
                 size = 4;
             }
         } else if (rec->header.kind == TRK::LF_UNION) {
-            if (rec->data.LF_UNION.property.fwdref) { skippedFwd++; continue; }
+            if (rec->data.LF_UNION.property.fwdref) { out->skippedFwd++; continue; }
             isUnion = true;
             fieldCount = rec->data.LF_UNION.count;
             const char* sizeData = rec->data.LF_UNION.data;
@@ -1117,16 +1131,16 @@ QVector<PdbTypeInfo> enumeratePdbTypes(const QString& pdbPath, QString* errorMsg
             size = leafValue(sizeData, sizeKind);
             name = leafName(sizeData, sizeKind);
         } else {
-            if (rec->data.LF_CLASS.property.fwdref) { skippedFwd++; continue; }
+            if (rec->data.LF_CLASS.property.fwdref) { out->skippedFwd++; continue; }
             fieldCount = rec->data.LF_CLASS.count;
             const char* sizeData = rec->data.LF_CLASS.data;
             size = leafValue(sizeData, rec->data.LF_CLASS.lfEasy.kind);
             name = leafName(sizeData, rec->data.LF_CLASS.lfEasy.kind);
         }
 
-        if (!name || name[0] == '\0') { skippedAnon++; continue; }
+        if (!name || name[0] == '\0') { out->skippedAnon++; continue; }
         // Skip anonymous types with compiler-generated names
-        if (name[0] == '<') { skippedAnon++; continue; }
+        if (name[0] == '<') { out->skippedAnon++; continue; }
 
         PdbTypeInfo info;
         info.typeIndex = ti;
@@ -1135,14 +1149,52 @@ QVector<PdbTypeInfo> enumeratePdbTypes(const QString& pdbPath, QString* errorMsg
         info.childCount = fieldCount;
         info.isUnion = isUnion;
         info.isEnum = isEnum;
-        result.append(info);
+        out->types.append(info);
+    }
+}
+
+QVector<PdbTypeInfo> enumeratePdbTypes(const QString& pdbPath, QString* errorMsg) {
+    PdbFile pdb;
+    if (!pdb.open(pdbPath, errorMsg)) return {};
+
+    const TypeTable& tt = *pdb.typeTable;
+
+    // Diagnostics: distinguish "TPI stream is empty (stripped public PDB)"
+    // from "TPI has records but none are UDTs we recognise" from "all the
+    // UDTs are forward-declarations". Microsoft's public symbol server
+    // ships most user-mode DLLs (advapi32, kernel32, …) with their TPI
+    // stripped, so loading them yields 0 types and that's expected — the
+    // diagnostic clarifies why.
+    const uint32_t firstTi = tt.firstIndex();
+    const uint32_t lastTi  = tt.lastIndex();
+    const uint32_t tpiRange = (lastTi > firstTi) ? (lastTi - firstTi) : 0;
+
+    // Contiguous type-index ranges, one per worker, concatenated in order
+    // so the result matches a single pass.
+    const int workers = workerCountFor(int(qMin<uint32_t>(tpiRange, INT_MAX)), 16384);
+    std::vector<EnumeratePart> parts(size_t(workers));
+    runWorkers(workers, [&](int w) {
+        const uint32_t from = firstTi + uint32_t(uint64_t(tpiRange) * w / workers);
+        const uint32_t to   = firstTi + uint32_t(uint64_t(tpiRange) * (w + 1) / workers);
+        enumerateRange(tt, from, to, &parts[size_t(w)]);
+    });
+
+    QVector<PdbTypeInfo> result;
+    int total = 0;
+    for (const auto& part : parts) total += part.types.size();
+    result.reserve(total);
+    int skippedNonUdt = 0, skippedFwd = 0, skippedAnon = 0;
+    for (const auto& part : parts) {
+        result += part.types;
+        skippedNonUdt += part.skippedNonUdt;
+        skippedFwd += part.skippedFwd;
+        skippedAnon += part.skippedAnon;
     }
 
     int enumCount = 0;
     for (const auto& r : result)
         if (r.isEnum) enumCount++;
 
-    const uint32_t tpiRange = (lastTi > firstTi) ? (lastTi - firstTi) : 0;
     if (tpiRange == 0) {
         qDebug() << "[PDB] enumeratePdbTypes:" << pdbPath
                  << "— TPI stream is empty (stripped public PDB —"
@@ -1153,7 +1205,8 @@ QVector<PdbTypeInfo> enumeratePdbTypes(const QString& pdbPath, QString* errorMsg
         qDebug() << "[PDB] enumeratePdbTypes:" << result.size() << "types,"
                  << enumCount << "enums  (TPI range" << tpiRange
                  << "records: skipped" << skippedNonUdt << "non-UDT,"
-                 << skippedFwd << "fwdref," << skippedAnon << "anon)";
+                 << skippedFwd << "fwdref," << skippedAnon << "anon,"
+                 << workers << "threads)";
     }
 
     return result;
@@ -1161,6 +1214,98 @@ QVector<PdbTypeInfo> enumeratePdbTypes(const QString& pdbPath, QString* errorMsg
 
 // ── Public API: importPdbSelected ──
 
+// Imports one selected type into ctx, counting enum dispatches for the
+// summary log.
+static void importSelectedType(PdbCtx& ctx, uint32_t ti, int* enumDispatched, int* enumCreated) {
+    const auto* rec = ctx.tt->get(ti);
+    if (rec && rec->header.kind == TRK::LF_ENUM) {
+        (*enumDispatched)++;
+        uint64_t id = ctx.importEnum(ti);
+        if (id != 0) (*enumCreated)++;
+        else qDebug() << "[PDB] importEnum FAILED for typeIndex" << ti;
+    } else {
+        ctx.importUDT(ti);
+    }
+}
+
+namespace {
+// One import thread's private context and the blocks of the selection it
+// claimed, with where each block's nodes start in its tree.
+struct ImportWorker {
+    PdbCtx ctx;
+    QVector<QPair<int, int>> blocks;   // (block index, first node index)
+    int enumDispatched = 0;
+    int enumCreated = 0;
+};
+} // namespace
+
+// Stitches the workers' trees together in selection order. A type pulled
+// in by several workers (a shared dependency like _LIST_ENTRY) is kept
+// once, at its first occurrence, and refIds to the other copies are
+// pointed at it — the same tree a single PdbCtx would have produced, up
+// to the order of dependency roots.
+static NodeTree mergeImportWorkers(std::vector<ImportWorker>& ws, int blockCount) {
+    struct Piece { int worker = -1; int begin = 0; int end = 0; };
+    QVector<Piece> pieces(blockCount);
+    for (int w = 0; w < int(ws.size()); w++) {
+        const auto& blocks = ws[size_t(w)].blocks;
+        for (int k = 0; k < blocks.size(); k++) {
+            const int end = (k + 1 < blocks.size()) ? blocks[k + 1].second
+                                                    : int(ws[size_t(w)].ctx.tree.nodes.size());
+            pieces[blocks[k].first] = Piece{w, blocks[k].second, end};
+        }
+    }
+
+    NodeTree out;
+    QHash<uint32_t, uint64_t> rootByType;            // typeIndex → merged id
+    std::vector<QHash<uint64_t, uint64_t>> remap(ws.size());   // worker id → merged id
+    std::vector<QSet<uint64_t>> dropped(ws.size());
+    std::vector<QHash<uint64_t, uint32_t>> typeOf(ws.size());  // worker root id → typeIndex
+    for (size_t w = 0; w < ws.size(); w++)
+        for (auto it = ws[w].ctx.typeCache.cbegin(); it != ws[w].ctx.typeCache.cend(); ++it)
+            typeOf[w].insert(it.value(), it.key());
+
+    for (const Piece& p : pieces) {
+        if (p.worker < 0) continue;
+        const size_t w = size_t(p.worker);
+        const auto& nodes = ws[w].ctx.tree.nodes;
+        for (int i = p.begin; i < p.end; i++) {
+            const Node& n = nodes[i];
+            if (n.parentId == 0) {
+                const uint32_t ti = typeOf[w].value(n.id, 0);
+                auto it = ti ? rootByType.constFind(ti) : rootByType.cend();
+                if (it != rootByType.cend()) {
+                    remap[w].insert(n.id, it.value());
+                    dropped[w].insert(n.id);
+                    continue;
+                }
+                const uint64_t id = out.reserveId();
+                if (ti) rootByType.insert(ti, id);
+                remap[w].insert(n.id, id);
+            } else if (dropped[w].contains(n.parentId)) {
+                dropped[w].insert(n.id);
+            } else {
+                remap[w].insert(n.id, out.reserveId());
+            }
+        }
+    }
+
+    for (const Piece& p : pieces) {
+        if (p.worker < 0) continue;
+        const size_t w = size_t(p.worker);
+        const auto& nodes = ws[w].ctx.tree.nodes;
+        for (int i = p.begin; i < p.end; i++) {
+            if (dropped[w].contains(nodes[i].id)) continue;
+            Node copy = nodes[i];
+            copy.id = remap[w].value(copy.id);
+            if (copy.parentId != 0) copy.parentId = remap[w].value(copy.parentId);
+            if (copy.refId != 0) copy.refId = remap[w].value(copy.refId);
+            out.addNode(copy);
+        }
+    }
+    return out;
+}
+
 NodeTree importPdbSelected(const QString& pdbPath,
                            const QVector<uint32_t>& typeIndices,
                            QString* errorMsg,
@@ -1168,42 +1313,113 @@ NodeTree importPdbSelected(const QString& pdbPath,
     PdbFile pdb;
     if (!pdb.open(pdbPath, errorMsg)) return {};
 
-    PdbCtx ctx;
-    ctx.tt = pdb.typeTable;
-
-    int total = typeIndices.size();
+    const int total = typeIndices.size();
+    const int workers = workerCountFor(total, 64);
     int enumDispatched = 0, enumCreated = 0;
-    for (int i = 0; i < total; i++) {
-        uint32_t ti = typeIndices[i];
-        const auto* rec = pdb.typeTable->get(ti);
-        if (rec && rec->header.kind == TRK::LF_ENUM) {
-            enumDispatched++;
-            uint64_t id = ctx.importEnum(ti);
-            if (id != 0) enumCreated++;
-            else qDebug() << "[PDB] importEnum FAILED for typeIndex" << ti;
-        } else {
-            ctx.importUDT(ti);
+    NodeTree tree;
+    bool cancelled = false;
+
+    if (workers <= 1) {
+        PdbCtx ctx;
+        ctx.tt = pdb.typeTable;
+        for (int i = 0; i < total; i++) {
+            importSelectedType(ctx, typeIndices[i], &enumDispatched, &enumCreated);
+            if (progressCb && !progressCb(i + 1, total)) {
+                cancelled = true;
+                break;
+            }
+        }
+        tree = std::move(ctx.tree);
+    } else {
+        // Workers claim small blocks of the selection in order, each into
+        // its own PdbCtx; the fwdref → definition index is built once and
+        // shared read-only. progressCb stays on the calling thread: worker
+        // 0 reports between its own types, then polls until the rest finish.
+        constexpr int kBlock = 16;
+        const int blockCount = (total + kBlock - 1) / kBlock;
+        PdbCtx seed;
+        seed.tt = pdb.typeTable;
+        seed.buildUdtDefinitionIndex();
+        std::vector<ImportWorker> ws(size_t(workers));
+        for (auto& w : ws) {
+            w.ctx.tt = pdb.typeTable;
+            w.ctx.structDefByName = seed.structDefByName;
+            w.ctx.unionDefByName = seed.unionDefByName;
+            w.ctx.udtDefIndexBuilt = true;
         }
-        if (progressCb && !progressCb(i + 1, total)) {
-            if (errorMsg) *errorMsg = QStringLiteral("Import cancelled");
-            return ctx.tree; // return partial result
+
+        std::atomic<int> nextBlock{0};
+        std::atomic<int> done{0};
+        std::atomic<bool> cancel{false};
+        std::mutex lock;
+        std::condition_variable helperExited;
+        int helpersRunning = workers - 1;
+        int reported = 0;
+        auto report = [&]() {
+            const int d = done.load();
+            if (d == reported || !progressCb) return;
+            reported = d;
+            if (!progressCb(d, total)) cancel = true;
+        };
+
+        runWorkers(workers, [&](int wi) {
+            ImportWorker& me = ws[size_t(wi)];
+            while (!cancel) {
+                const int b = nextBlock.fetch_add(1);
+                if (b >= blockCount) break;
+                me.blocks.append({b, int(me.ctx.tree.nodes.size())});
+                const int end = qMin(total, (b + 1) * kBlock);
+                for (int i = b * kBlock; i < end && !cancel; i++) {
+                    importSelectedType(me.ctx, typeIndices[i],
+                                       &me.enumDispatched, &me.enumCreated);
+                    done++;
+                    if (wi == 0) report();
+                }
+            }
+            if (wi == 0) {
+                std::unique_lock<std::mutex> lk(lock);
+                while (helpersRunning > 0) {
+                    helperExited.wait_for(lk, std::chrono::milliseconds(20));
+                    lk.unlock();
+                    report();
+                    lk.lock();
+                }
+            } else {
+                std::lock_guard<std::mutex> lk(lock);
+                helpersRunning--;
+                helperExited.notify_one();
+            }
+        });
+        report();
+        cancelled = cancel;
+
+        for (const auto& w : ws) {
+            enumDispatched += w.enumDispatched;
+            enumCreated += w.enumCreated;
         }
+        tree = mergeImportWorkers(ws, blockCount);
+    }
+
+    if (cancelled) {
+        if (errorMsg) *errorMsg = QStringLiteral("Import cancelled");
+        return tree; // return partial result
     }
 
     // Count enum nodes in tree
     int enumNodes = 0;
-    for (const auto& n : ctx.tree.nodes)
+    for (const auto& n : tree.nodes)
         if (n.classKeyword == QLatin1String("enum")) enumNodes++;
     qDebug() << "[PDB] importPdbSelected:" << total << "types,"
              << enumDispatched << "enum dispatches,"
              << enumCreated << "enum created,"
              << enumNodes << "enum nodes in tree,"
-             << ctx.tree.nodes.size() << "total nodes";
+             << tree.nodes.size() << "total nodes,"
+             << workers << "threads";
 
-    if (ctx.tree.nodes.isEmpty()) {
+    if (tree.nodes.isEmpty()) {
         if (errorMsg) *errorMsg = QStringLiteral("No types imported");
     }
-    return ctx.tree;
+    return tree;
 }
 
 // ── Public API: importPdb (legacy) ──
@@ -1375,37 +1591,3 @@ NodeTree importTypeForSymbol(const QString& pdbPath,
 }
 
 } // namespace rcx
-
-#else // !_WIN32
-
-namespace rcx {
-
-PdbSymbolResult extractPdbSymbols(const QString&, QString* errorMsg) {
-    if (errorMsg) *errorMsg = QStringLiteral("PDB import requires Windows");
-    return {};
-}
-
-QVector<PdbTypeInfo> enumeratePdbTypes(const QString&, QString* errorMsg) {
-    if (errorMsg) *errorMsg = QStringLiteral("PDB import requires Windows");
-    return {};
-}
-
-NodeTree importPdbSelected(const QString&, const QVector<uint32_t>&,
-                           QString* errorMsg, ProgressCb) {
-    if (errorMsg) *errorMsg = QStringLiteral("PDB import requires Windows");
-    return {};
-}
-
-NodeTree importPdb(const QString&, const QString&, QString* errorMsg) {
-    if (errorMsg) *errorMsg = QStringLiteral("PDB import requires Windows");
-    return {};
-}
-
-NodeTree importTypeForSymbol(const QString&, uint32_t, QString*, QString* errorMsg) {
-    if (errorMsg) *errorMsg = QStringLiteral("PDB import requires Windows");
-    return {};
-}
-
-} // namespace rcx
-
-#endif
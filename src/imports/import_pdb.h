@@ -35,12 +35,16 @@ struct PdbTypeInfo {
 };
 
 // Phase 1: Enumerate all UDT types in the PDB (fast scan, no recursive import).
+// Large TPI streams are scanned on several threads; the result is in
+// type-index order either way.
 QVector<PdbTypeInfo> enumeratePdbTypes(const QString& pdbPath,
                                        QString* errorMsg = nullptr);
 
 // Phase 2: Import selected types with full recursive child types.
-// progressCb is called with (current, total) for each top-level type;
-// return false from the callback to cancel the import.
+// Large selections are split across threads. progressCb is always called
+// on the calling thread with (done, total) as types complete — once per
+// type when single-threaded, as often as it polls otherwise; return false
+// from the callback to cancel the import.
 using ProgressCb = std::function<bool(int current, int total)>;
 NodeTree importPdbSelected(const QString& pdbPath,
                            const QVector<uint32_t>& typeIndices,
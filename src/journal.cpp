@@ -0,0 +1,301 @@
+#include "journal.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSaveFile>
+
+namespace rcx {
+
+namespace {
+
+// 64-bit ids and addresses go through strings, as in the project format:
+// a JSON double can't hold them exactly.
+QString u64(uint64_t v) { return QString::number(v); }
+uint64_t toU64(const QJsonValue& v) { return v.toString(QStringLiteral("0")).toULongLong(); }
+
+QJsonArray adjsToJson(const QVector<cmd::OffsetAdj>& adjs) {
+    QJsonArray a;
+    for (const auto& adj : adjs)
+        a.append(QJsonArray{u64(adj.nodeId), adj.oldOffset, adj.newOffset});
+    return a;
+}
+
+QVector<cmd::OffsetAdj> adjsFromJson(const QJsonValue& v) {
+    QVector<cmd::OffsetAdj> adjs;
+    for (const auto& e : v.toArray()) {
+        const QJsonArray t = e.toArray();
+        adjs.append(cmd::OffsetAdj{toU64(t.at(0)), t.at(1).toInt(), t.at(2).toInt()});
+    }
+    return adjs;
+}
+
+QJsonObject nodeToJson(const Node& n) { return n.toJson(); }
+
+// Node::fromJson always loads collapsed; a replayed node keeps its state.
+Node nodeFromJson(const QJsonValue& v) {
+    const QJsonObject o = v.toObject();
+    Node n = Node::fromJson(o);
+    n.collapsed = o.value(QStringLiteral("collapsed")).toBool(true);
+    return n;
+}
+
+QJsonArray membersToJson(const QVector<QPair<QString, int64_t>>& members) {
+    QJsonArray a;
+    for (const auto& m : members)
+        a.append(QJsonArray{m.first, QString::number(m.second)});
+    return a;
+}
+
+QVector<QPair<QString, int64_t>> membersFromJson(const QJsonValue& v) {
+    QVector<QPair<QString, int64_t>> members;
+    for (const auto& e : v.toArray()) {
+        const QJsonArray t = e.toArray();
+        members.emplaceBack(t.at(0).toString(), t.at(1).toString().toLongLong());
+    }
+    return members;
+}
+
+QString hex(const QByteArray& b) { return QString::fromLatin1(b.toHex()); }
+QByteArray unhex(const QJsonValue& v) { return QByteArray::fromHex(v.toString().toLatin1()); }
+
+} // namespace
+
+QJsonObject commandToJson(const Command& command) {
+    QJsonObject o;
+    std::visit([&](auto&& c) {
+        using T = std::decay_t<decltype(c)>;
+        if constexpr (std::is_same_v<T, cmd::ChangeKind>) {
+            o["op"] = "ChangeKind";
+            o["id"] = u64(c.nodeId);
+            o["old"] = kindToString(c.oldKind);
+            o["new"] = kindToString(c.newKind);
+            o["adjs"] = adjsToJson(c.offAdjs);
+        } else if constexpr (std::is_same_v<T, cmd::Rename>) {
+            o["op"] = "Rename";
+            o["id"] = u64(c.nodeId);
+            o["old"] = c.oldName;
+            o["new"] = c.newName;
+        } else if constexpr (std::is_same_v<T, cmd::Collapse>) {
+            o["op"] = "Collapse";
+            o["id"] = u64(c.nodeId);
+            o["old"] = c.oldState;
+            o["new"] = c.newState;
+        } else if constexpr (std::is_same_v<T, cmd::Insert>) {
+            o["op"] = "Insert";
+            o["node"] = nodeToJson(c.node);
+            o["adjs"] = adjsToJson(c.offAdjs);
+        } else if constexpr (std::is_same_v<T, cmd::Remove>) {
+            o["op"] = "Remove";
+            o["id"] = u64(c.nodeId);
+            QJsonArray sub;
+            for (const Node& n : c.subtree)
+                sub.append(nodeToJson(n));
+            o["subtree"] = sub;
+            o["adjs"] = adjsToJson(c.offAdjs);
+        } else if constexpr (std::is_same_v<T, cmd::ChangeBase>) {
+            o["op"] = "ChangeBase";
+            o["old"] = u64(c.oldBase);
+            o["new"] = u64(c.newBase);
+            o["oldFormula"] = c.oldFormula;
+            o["newFormula"] = c.newFormula;
+        } else if constexpr (std::is_same_v<T, cmd::WriteBytes>) {
+            o["op"] = "WriteBytes";
+            o["addr"] = u64(c.addr);
+            o["old"] = hex(c.oldBytes);
+            o["new"] = hex(c.newBytes);
+        } else if constexpr (std::is_same_v<T, cmd::ChangeArrayMeta>) {
+            o["op"] = "ChangeArrayMeta";
+            o["id"] = u64(c.nodeId);
+            o["oldKind"] = kindToString(c.oldElementKind);
+            o["newKind"] = kindToString(c.newElementKind);
+            o["oldLen"] = c.oldArrayLen;
+            o["newLen"] = c.newArrayLen;
+        } else if constexpr (std::is_same_v<T, cmd::ChangePointerRef>) {
+            o["op"] = "ChangePointerRef";
+            o["id"] = u64(c.nodeId);
+            o["old"] = u64(c.oldRefId);
+            o["new"] = u64(c.newRefId);
+        } else if constexpr (std::is_same_v<T, cmd::ChangeStructTypeName>) {
+            o["op"] = "ChangeStructTypeName";
+            o["id"] = u64(c.nodeId);
+            o["old"] = c.oldName;
+            o["new"] = c.newName;
+        } else if constexpr (std::is_same_v<T, cmd::ChangeClassKeyword>) {
+            o["op"] = "ChangeClassKeyword";
+            o["id"] = u64(c.nodeId);
+            o["old"] = c.oldKeyword;
+            o["new"] = c.newKeyword;
+        } else if constexpr (std::is_same_v<T, cmd::ChangeOffset>) {
+            o["op"] = "ChangeOffset";
+            o["id"] = u64(c.nodeId);
+            o["old"] = c.oldOffset;
+            o["new"] = c.newOffset;
+        } else if constexpr (std::is_same_v<T, cmd::ChangeEnumMembers>) {
+            o["op"] = "ChangeEnumMembers";
+            o["id"] = u64(c.nodeId);
+            o["old"] = membersToJson(c.oldMembers);
+            o["new"] = membersToJson(c.newMembers);
+        } else if constexpr (std::is_same_v<T, cmd::ToggleRelative>) {
+            o["op"] = "ToggleRelative";
+            o["id"] = u64(c.nodeId);
+            o["old"] = c.oldVal;
+            o["new"] = c.newVal;
+        } else if constexpr (std::is_same_v<T, cmd::ToggleBigEndian>) {
+            o["op"] = "ToggleBigEndian";
+            o["id"] = u64(c.nodeId);
+            o["old"] = c.oldVal;
+            o["new"] = c.newVal;
+        } else if constexpr (std::is_same_v<T, cmd::ChangeComment>) {
+            o["op"] = "ChangeComment";
+            o["id"] = u64(c.nodeId);
+            o["old"] = c.oldComment;
+            o["new"] = c.newComment;
+        }
+    }, command);
+    return o;
+}
+
+bool commandFromJson(const QJsonObject& o, Command* out) {
+    const QString op = o.value(QStringLiteral("op")).toString();
+    const uint64_t id = toU64(o["id"]);
+    if (op == QLatin1String("ChangeKind")) {
+        *out = cmd::ChangeKind{id, kindFromString(o["old"].toString()),
+                               kindFromString(o["new"].toString()), adjsFromJson(o["adjs"])};
+    } else if (op == QLatin1String("Rename")) {
+        *out = cmd::Rename{id, o["old"].toString(), o["new"].toString()};
+    } else if (op == QLatin1String("Collapse")) {
+        *out = cmd::Collapse{id, o["old"].toBool(), o["new"].toBool()};
+    } else if (op == QLatin1String("Insert")) {
+        if (!o["node"].isObject()) return false;
+        *out = cmd::Insert{nodeFromJson(o["node"]), adjsFromJson(o["adjs"])};
+    } else if (op == QLatin1String("Remove")) {
+        QVector<Node> subtree;
+        for (const auto& v : o["subtree"].toArray())
+            subtree.append(nodeFromJson(v));
+        *out = cmd::Remove{id, subtree, adjsFromJson(o["adjs"])};
+    } else if (op == QLatin1String("ChangeBase")) {
+        *out = cmd::ChangeBase{toU64(o["old"]), toU64(o["new"]),
+                               o["oldFormula"].toString(), o["newFormula"].toString()};
+    } else if (op == QLatin1String("WriteBytes")) {
+        *out = cmd::WriteBytes{toU64(o["addr"]), unhex(o["old"]), unhex(o["new"])};
+    } else if (op == QLatin1String("ChangeArrayMeta")) {
+        *out = cmd::ChangeArrayMeta{id, kindFromString(o["oldKind"].toString()),
+                                    kindFromString(o["newKind"].toString()),
+                                    o["oldLen"].toInt(1), o["newLen"].toInt(1)};
+    } else if (op == QLatin1String("ChangePointerRef")) {
+        *out = cmd::ChangePointerRef{id, toU64(o["old"]), toU64(o["new"])};
+    } else if (op == QLatin1String("ChangeStructTypeName")) {
+        *out = cmd::ChangeStructTypeName{id, o["old"].toString(), o["new"].toString()};
+    } else if (op == QLatin1String("ChangeClassKeyword")) {
+        *out = cmd::ChangeClassKeyword{id, o["old"].toString(), o["new"].toString()};
+    } else if (op == QLatin1String("ChangeOffset")) {
+        *out = cmd::ChangeOffset{id, o["old"].toInt(), o["new"].toInt()};
+    } else if (op == QLatin1String("ChangeEnumMembers")) {
+        *out = cmd::ChangeEnumMembers{id, membersFromJson(o["old"]), membersFromJson(o["new"])};
+    } else if (op == QLatin1String("ToggleRelative")) {
+        *out = cmd::ToggleRelative{id, o["old"].toBool(), o["new"].toBool()};
+    } else if (op == QLatin1String("ToggleBigEndian")) {
+        *out = cmd::ToggleBigEndian{id, o["old"].toBool(), o["new"].toBool()};
+    } else if (op == QLatin1String("ChangeComment")) {
+        *out = cmd::ChangeComment{id, o["old"].toString(), o["new"].toString()};
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// ── CommandJournal ──
+
+void CommandJournal::open(const QString& path, uint64_t seqFloor) {
+    close();
+    m_path = path;
+    m_pending = 0;
+    m_failed = false;
+    m_seq = qMax(m_seq, seqFloor);
+    // Pick up where an existing journal (one being recovered) left off.
+    const QVector<JournalEntry> existing = read(path);
+    if (!existing.isEmpty()) {
+        m_seq = qMax(m_seq, existing.last().seq);
+        m_pending = existing.size();
+    }
+}
+
+void CommandJournal::close() {
+    if (m_file.isOpen()) m_file.close();
+    m_path.clear();
+    m_pending = 0;
+}
+
+void CommandJournal::reset() {
+    if (m_file.isOpen()) m_file.close();
+    if (!m_path.isEmpty()) QFile::remove(m_path);
+    m_pending = 0;
+    m_failed = false;
+}
+
+bool CommandJournal::append(const Command& command, bool isUndo) {
+    if (m_path.isEmpty() || std::holds_alternative<cmd::WriteBytes>(command))
+        return true;
+    if (!m_file.isOpen()) {
+        m_file.setFileName(m_path);
+        if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+            m_failed = true;
+            return false;
+        }
+    }
+    QJsonObject line;
+    line["seq"] = u64(m_seq + 1);
+    line["undo"] = isUndo;
+    line["cmd"] = commandToJson(command);
+    const QByteArray bytes = QJsonDocument(line).toJson(QJsonDocument::Compact) + '\n';
+    if (m_file.write(bytes) != bytes.size() || !m_file.flush()) {
+        m_failed = true;
+        return false;
+    }
+    ++m_seq;
+    ++m_pending;
+    return true;
+}
+
+bool CommandJournal::compact(uint64_t upTo) {
+    if (m_path.isEmpty() || m_pending == 0) return true;
+    const QVector<JournalEntry> keep = read(m_path, upTo);
+    if (keep.size() == m_pending) return true;
+    if (m_file.isOpen()) m_file.close();
+    m_pending = 0;
+    if (keep.isEmpty())
+        return QFile::remove(m_path) || !QFile::exists(m_path);
+
+    // Rewrite the survivors atomically; a crash here leaves the old
+    // journal, whose extra entries the recorded seq already skips.
+    QSaveFile out(m_path);
+    if (!out.open(QIODevice::WriteOnly)) return false;
+    for (const JournalEntry& e : keep) {
+        QJsonObject line;
+        line["seq"] = u64(e.seq);
+        line["undo"] = e.undo;
+        line["cmd"] = commandToJson(e.cmd);
+        out.write(QJsonDocument(line).toJson(QJsonDocument::Compact) + '\n');
+    }
+    if (!out.commit()) return false;
+    m_pending = keep.size();
+    return true;
+}
+
+QVector<JournalEntry> CommandJournal::read(const QString& path, uint64_t after) {
+    QVector<JournalEntry> entries;
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) return entries;
+    while (!f.atEnd()) {
+        const QByteArray line = f.readLine();
+        if (!line.endsWith('\n')) break;   // torn by a crash mid-append
+        const QJsonObject o = QJsonDocument::fromJson(line).object();
+        JournalEntry e;
+        e.seq = toU64(o["seq"]);
+        e.undo = o["undo"].toBool();
+        if (e.seq == 0 || !commandFromJson(o["cmd"].toObject(), &e.cmd)) break;
+        if (e.seq > after) entries.append(std::move(e));
+    }
+    return entries;
+}
+
+} // namespace rcx
@@ -0,0 +1,78 @@
+#pragma once
+#include "core.h"
+#include <QFile>
+#include <QJsonObject>
+
+namespace rcx {
+
+// ── Edit journal ──
+//
+// Append-only log of the undo commands applied to a document since its last
+// full write, kept next to the project as "<file>.journal". Autosave appends
+// one line per command instead of rewriting the whole project every minute;
+// recovery loads the last full write and re-applies the lines after it.
+//
+// Each line is compact JSON: {"seq": n, "undo": bool, "cmd": {...}}. seq
+// increases across the document's lifetime, so a full write records the
+// seq it covers and recovery skips lines at or below it. A line torn by a
+// crash mid-append is ignored along with anything after it.
+//
+// WriteBytes commands aren't journaled: they edit the attached source, not
+// the project, and replaying them into a live process after a crash is the
+// last thing anyone wants.
+
+QJsonObject commandToJson(const Command& cmd);
+// False for unknown ops or a malformed object; *out is untouched then.
+bool commandFromJson(const QJsonObject& o, Command* out);
+
+struct JournalEntry {
+    uint64_t seq  = 0;
+    bool     undo = false;
+    Command  cmd;
+};
+
+class CommandJournal {
+public:
+    CommandJournal() = default;
+    CommandJournal(const CommandJournal&) = delete;
+    CommandJournal& operator=(const CommandJournal&) = delete;
+
+    // Journal into `path`. An existing file is kept and appended to (seq
+    // continues past its last entry); nothing is created until the first
+    // append. Closes any previous file first. `seqFloor` is the seq the
+    // loaded project file is stamped with: numbering never restarts below
+    // it, or recovery would skip the new entries as already saved.
+    void open(const QString& path, uint64_t seqFloor = 0);
+    void close();
+    // Delete the file; journaling carries on into a fresh one.
+    void reset();
+    bool isOpen() const { return !m_path.isEmpty(); }
+    const QString& path() const { return m_path; }
+
+    // Append and flush one applied command. No-op (true) when closed or
+    // for WriteBytes; false if the write failed.
+    bool append(const Command& command, bool isUndo);
+    // An append failed since open(): the file no longer has every edit.
+    bool failed() const { return m_failed; }
+
+    // seq of the newest entry (0 before the first).
+    uint64_t seq() const { return m_seq; }
+    // Entries in the file right now.
+    int pending() const { return m_pending; }
+
+    // Drop entries with seq <= upTo, once a full write covers them. The
+    // file is removed when nothing is left.
+    bool compact(uint64_t upTo);
+
+    // Entries in `path` with seq > after, in order.
+    static QVector<JournalEntry> read(const QString& path, uint64_t after = 0);
+
+private:
+    QString  m_path;
+    QFile    m_file;
+    uint64_t m_seq = 0;
+    int      m_pending = 0;
+    bool     m_failed = false;
+};
+
+} // namespace rcx
@@ -58,6 +58,8 @@
 #include <QVBoxLayout>
 #include <QDialog>
 #include <QProgressDialog>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
 #include <Qsci/qsciscintilla.h>
 #include <Qsci/qscilexercpp.h>
 #include "code_highlight.h"
@@ -83,6 +85,7 @@
 #include "names/name_registry.h"
 #include "names/pdb_name_provider.h"
 #include "names/pdb_type_provider.h"
+#include "names/elf_name_provider.h"
 #include "names/rtti_name_provider.h"
 #include "names/bookmark_name_provider.h"
 #ifdef _WIN32
@@ -1218,7 +1221,7 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
     m_mcp = new McpBridge(this, this);
 
     // Register built-in NameProviders. Order = priority for reverse-lookup
-    // (PDB symbols > PDB types > RTTI > Bookmarks). Plugins can register
+    // (PDB symbols > PDB types > ELF symbols > RTTI > Bookmarks). Plugins can register
     // more later. Splitting PDB symbols vs PDB types into two providers
     // gives each a distinct filter chip + accent color in the Symbols
     // panel — addresses the "no visual difference between a PDB function
@@ -1228,6 +1231,8 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
             std::make_shared<rcx::PdbNameProvider>());
         rcx::NameRegistry::instance().registerProvider(
             std::make_shared<rcx::PdbTypeProvider>());
+        rcx::NameRegistry::instance().registerProvider(
+            std::make_shared<rcx::ElfNameProvider>());
         rcx::NameRegistry::instance().registerProvider(
             std::shared_ptr<rcx::RttiNameProvider>(&rcx::RttiNameProvider::instance(),
                 [](rcx::RttiNameProvider*){ /* singleton — don't delete */ }));
@@ -1243,7 +1248,7 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
                                    const QString& moduleName) {
         rcx::RttiNameProvider::instance().push(name, address, moduleName);
     };
-    rcx::g_nameLookupHook = [](uint64_t addr, const rcx::Provider* active) {
+    rcx::g_nameLookupHook = [](uint64_t addr, const std::shared_ptr<rcx::Provider>& active) {
         return rcx::NameRegistry::instance().nameFor(addr, active);
     };
     rcx::g_namesChangedHook = []() {
@@ -1358,6 +1363,7 @@ void MainWindow::createMenus() {
     file->addSeparator();
     Qt5Qt6AddAction(file, "&Save", QKeySequence::Save, makeIcon(":/vsicons/save.svg"), this, &MainWindow::saveFile);
     Qt5Qt6AddAction(file, "Save &As...", QKeySequence::SaveAs, makeIcon(":/vsicons/save-as.svg"), this, &MainWindow::saveFileAs);
+    Qt5Qt6AddAction(file, "Save Source &Data", QKeySequence::UnknownKey, QIcon(), this, &MainWindow::saveData);
     file->addSeparator();
     auto* importMenu = file->addMenu("&Import");
     Qt5Qt6AddAction(importMenu, "From &Source...", QKeySequence::UnknownKey, QIcon(), this, &MainWindow::importFromSource);
@@ -1678,18 +1684,16 @@ void MainWindow::createMenus() {
     // RcxController::setTypeHints API survives as a no-op so saved
     // settings / MCP clients don't break, but there's no UI exposure.
 
-    // Auto-RTTI walks every non-null pointer/Hex64 candidate's vtable -> RTTI
-    // chain (several cross-process reads each) on EVERY refresh — rttiForVtable's
-    // cache is per-compose-pass, so it re-walks from scratch every tick. On a
-    // module-heavy target (DayZ etc.) that's hundreds of reads per refresh and
-    // makes the view barely usable. OFF by default; opt in here when you want
-    // the {RTTI: ClassName} chips and can afford the per-refresh scan cost.
+    // Auto-RTTI walks each non-null pointer/Hex64 candidate's vtable -> RTTI
+    // chain (several cross-process reads) once; the controller's RttiCache
+    // keeps the result, negative ones included, across refresh ticks until
+    // the module list changes or the target is re-attached. A steady view
+    // costs a hash lookup per candidate, so the chips are on by default.
     auto* actRttiChips = hints->addAction(QStringLiteral("Auto-detect RTTI"));
     actRttiChips->setToolTip(QStringLiteral(
-        "Show {RTTI: ClassName} chips by walking pointer vtables — scans every "
-        "refresh, can lag on module-heavy targets"));
+        "Show {RTTI: ClassName} chips by walking pointer vtables"));
     actRttiChips->setCheckable(true);
-    actRttiChips->setChecked(settings.value("showRttiChips", false).toBool());
+    actRttiChips->setChecked(settings.value("showRttiChips", true).toBool());
     connect(actRttiChips, &QAction::triggered, this, [this](bool checked) {
         QSettings("Reclass", "Reclass").setValue("showRttiChips", checked);
         for (auto& tab : m_tabs)
@@ -3691,7 +3695,7 @@ QDockWidget* MainWindow::createTab(RcxDocument* doc) {
     ctrl->setBraceWrap(QSettings("Reclass", "Reclass").value("braceWrap", false).toBool());
     ctrl->setTypeHints(QSettings("Reclass", "Reclass").value("typeHints", false).toBool());
     ctrl->setShowComments(QSettings("Reclass", "Reclass").value("showComments", false).toBool());
-    ctrl->setShowRtti(QSettings("Reclass", "Reclass").value("showRttiChips", false).toBool());
+    ctrl->setShowRtti(QSettings("Reclass", "Reclass").value("showRttiChips", true).toBool());
     ctrl->setShowEnumChips(QSettings("Reclass", "Reclass").value("showEnumChips", true).toBool());
 
     // Give every controller the shared document list for cross-tab type visibility
@@ -5210,6 +5214,22 @@ void MainWindow::saveFileAs() {
     project_save(nullptr, true);
 }
 
+// Byte edits to a mapped file source live in memory until this writes
+// them back; File > Save only writes the .rcx definition.
+void MainWindow::saveData() {
+    auto* tab = activeTab();
+    if (!tab) return;
+    if (!tab->doc->hasUnsavedData()) {
+        setAppStatus(QStringLiteral("No unsaved edits to the source data"));
+        return;
+    }
+    QString err;
+    if (tab->doc->saveData(&err))
+        setAppStatus(QStringLiteral("Saved edits to ") + tab->doc->dataPath);
+    else
+        setAppStatus(QStringLiteral("Saving source data failed: ") + err);
+}
+
 void MainWindow::closeFile() {
     project_close();
 }
@@ -6134,6 +6154,7 @@ void MainWindow::showOptionsDialog(int initialPage) {
         : false;
     current.autoStartMcp = QSettings("Reclass", "Reclass").value("autoStartMcp", true).toBool();
     current.refreshMs = QSettings("Reclass", "Reclass").value("refreshMs", rcx::kDefaultRefreshMs).toInt();
+    current.samplerHz = QSettings("Reclass", "Reclass").value("samplerHz", 0).toInt();
     current.generatorAsserts = QSettings("Reclass", "Reclass").value("generatorAsserts", false).toBool();
     current.braceWrap = QSettings("Reclass", "Reclass").value("braceWrap", false).toBool();
 
@@ -6170,6 +6191,12 @@ void MainWindow::showOptionsDialog(int initialPage) {
             tab.ctrl->setRefreshInterval(r.refreshMs);
     }
 
+    if (r.samplerHz != current.samplerHz) {
+        QSettings("Reclass", "Reclass").setValue("samplerHz", r.samplerHz);
+        for (auto& tab : m_tabs)
+            tab.ctrl->setSamplerRate(r.samplerHz);
+    }
+
     if (r.generatorAsserts != current.generatorAsserts)
         QSettings("Reclass", "Reclass").setValue("generatorAsserts", r.generatorAsserts);
 
@@ -7073,30 +7100,25 @@ void MainWindow::importPdb() {
         "PDB Files (*.pdb);;All Files (*)");
     if (pdbPath.isEmpty()) return;
 
-    int symCount = loadPdbAndCacheTypes(pdbPath);
-    rebuildSymbols();
-    if (m_symbolsDock) m_symbolsDock->show();
-
-    // Count the types that were just loaded so the status reflects whether
-    // this PDB was stripped of TPI data (typical for MS user-mode public
-    // PDBs like advapi32) or carries real type definitions (ntdll, ntos,
-    // private builds).
-    int typeCount = 0;
-    QString baseName = QFileInfo(pdbPath).completeBaseName();
-    QString canonical = rcx::SymbolStore::instance().resolveAlias(baseName);
-    if (const auto* set = rcx::SymbolStore::instance().moduleData(canonical))
-        typeCount = set->types.size();
-
-    QString fname = QFileInfo(pdbPath).fileName();
-    if (typeCount > 0) {
-        setAppStatus(QStringLiteral("Loaded %1 symbols + %2 types from %3 — "
-                                    "right-click a type to import")
-            .arg(symCount).arg(typeCount).arg(fname));
-    } else {
-        setAppStatus(QStringLiteral("Loaded %1 symbols from %2 "
-                                    "(public PDB — no type info)")
-            .arg(symCount).arg(fname));
-    }
+    const QString fname = QFileInfo(pdbPath).fileName();
+    loadPdbAndCacheTypes(pdbPath, [this, fname](int symCount, int typeCount) {
+        if (m_symbolsDock) m_symbolsDock->show();
+
+        // Report whether this PDB was stripped of TPI data (typical for MS
+        // user-mode public PDBs like advapi32) or carries real type
+        // definitions (ntdll, ntos, private builds).
+        if (symCount == 0) {
+            setAppStatus(QStringLiteral("No symbols loaded from %1").arg(fname));
+        } else if (typeCount > 0) {
+            setAppStatus(QStringLiteral("Loaded %1 symbols + %2 types from %3 — "
+                                        "right-click a type to import")
+                .arg(symCount).arg(typeCount).arg(fname));
+        } else {
+            setAppStatus(QStringLiteral("Loaded %1 symbols from %2 "
+                                        "(public PDB — no type info)")
+                .arg(symCount).arg(fname));
+        }
+    });
 }
 
 // ── Type Aliases Dialog ──
@@ -7218,7 +7240,7 @@ void MainWindow::showTypeAliasesDialog() {
     }
 
     tab->doc->typeAliases = newAliases;
-    tab->doc->modified = true;
+    tab->doc->markUnjournaledEdit();
     tab->ctrl->refresh();
     updateWindowTitle();
 }
@@ -7341,50 +7363,62 @@ QDockWidget* MainWindow::project_open(const QString& path) {
     if (filePath.isEmpty()) {
         filePath = QFileDialog::getOpenFileName(this,
             "Open Definition", {},
-            "Reclass (*.rcx)"
+            "Reclass (*.rcx *.rcxb)"
             ";;All (*)");
         if (filePath.isEmpty()) return nullptr;
     }
 
-    // Recovery: if a fresher .autosave shadow exists next to the target,
-    // ask whether to restore. We delete the .autosave file in either case
-    // — if the user declines, the next normal save sequence will reclaim
-    // the slot anyway, and keeping a stale shadow would re-trigger the
-    // prompt forever.
+    // Recovery: edits that never reached the file live in two places — the
+    // .autosave shadow (a full copy written now and then) and the .journal
+    // (every command since the last full write, appended as it happened).
+    // If either is there, ask whether to restore: the shadow, when fresher
+    // than the file, is loaded in its place, then the journal entries it
+    // doesn't cover are replayed on top. Declining deletes both — keeping
+    // them would re-trigger the prompt forever.
     //
     // restoredFromAutosave preserves the original target path so a
     // subsequent Ctrl+S writes back to foo.rcx, NOT foo.rcx.autosave.
     // Without this fixup `doc->filePath` would carry the .autosave
     // path forward and Save would never restore the user's real file.
     QString originalPath;
+    const QString journalPath = filePath + QStringLiteral(".journal");
+    bool replayJournal = false;
     {
         QString shadow = filePath + QStringLiteral(".autosave");
         QFileInfo origInfo(filePath);
         QFileInfo shadowInfo(shadow);
-        if (shadowInfo.exists() && shadowInfo.isFile()
-            && shadowInfo.lastModified() > origInfo.lastModified()) {
+        QFileInfo journalInfo(journalPath);
+        const bool freshShadow = shadowInfo.exists() && shadowInfo.isFile()
+            && shadowInfo.lastModified() > origInfo.lastModified();
+        const bool hasJournal = journalInfo.isFile() && journalInfo.size() > 0;
+        if (freshShadow || hasJournal) {
             // Show the full absolute path so the user can verify
             // exactly which file (and which shadow) the prompt refers
             // to before agreeing — important when the same basename
             // exists in multiple places.
+            const QFileInfo& recovery = freshShadow ? shadowInfo : journalInfo;
             bool restore = ThemedMessageBox::confirm(this,
                 QStringLiteral("Restore Autosave?"),
                 QStringLiteral(
-                    "A more recent autosave exists for this file.\n\n"
+                    "Unsaved edits to this file were recovered.\n\n"
                     "Original:\n  %1\n  modified %2\n\n"
                     "Autosave:\n  %3\n  modified %4\n\n"
-                    "Open the autosave instead?")
+                    "Restore the unsaved edits?")
                     .arg(origInfo.absoluteFilePath())
                     .arg(QLocale().toString(origInfo.lastModified(), QLocale::ShortFormat))
-                    .arg(shadowInfo.absoluteFilePath())
-                    .arg(QLocale().toString(shadowInfo.lastModified(), QLocale::ShortFormat)),
+                    .arg(recovery.absoluteFilePath())
+                    .arg(QLocale().toString(recovery.lastModified(), QLocale::ShortFormat)),
                 QStringLiteral("Restore"),
                 QStringLiteral("Open original"));
             if (restore) {
-                originalPath = filePath;
-                filePath = shadow;
+                if (freshShadow) {
+                    originalPath = filePath;
+                    filePath = shadow;
+                }
+                replayJournal = hasJournal;
             } else {
                 QFile::remove(shadow);
+                QFile::remove(journalPath);
             }
         }
     }
@@ -7473,6 +7507,14 @@ QDockWidget* MainWindow::project_open(const QString& path) {
       closeAllDocDocks();
       dock = createTab(doc);
     }
+    // Replay journaled edits the loaded file doesn't have yet (a restored
+    // shadow records how far it got), then keep journaling into it.
+    if (replayJournal) {
+        const auto entries = CommandJournal::read(journalPath, doc->m_loadJournalSeq);
+        const int applied = m_tabs[dock].ctrl->replayJournal(entries);
+        qInfo().nospace() << "[recovery] replayed " << applied << " journaled edit(s)";
+    }
+    doc->journal.open(journalPath, doc->m_loadJournalSeq);
     rebuildWorkspaceModel();
     addRecentFile(filePath);
 
@@ -7501,28 +7543,38 @@ bool MainWindow::project_save(QDockWidget* dock, bool saveAs) {
     if (!dock || !m_tabs.contains(dock)) return false;
     auto& tab = m_tabs[dock];
 
-    QString savedPath;
-    if (saveAs || tab.doc->filePath.isEmpty()) {
-        QString path = QFileDialog::getSaveFileName(this,
-            "Save Definition", {}, "Reclass (*.rcx);;JSON (*.json)");
-        if (path.isEmpty()) return false;
-        tab.doc->save(path);
-        addRecentFile(path);
-        savedPath = path;
-    } else {
-        tab.doc->save(tab.doc->filePath);
-        addRecentFile(tab.doc->filePath);
-        savedPath = tab.doc->filePath;
-    }
-    // Drop the autosave shadow on a real save — the user's explicit save
-    // is the authoritative version, no need to keep the recovery copy.
-    if (!savedPath.isEmpty())
-        QFile::remove(savedPath + QStringLiteral(".autosave"));
+    QString savedPath = tab.doc->filePath;
+    if (saveAs || savedPath.isEmpty()) {
+        savedPath = QFileDialog::getSaveFileName(this,
+            "Save Definition", {},
+            "Reclass (*.rcx);;Reclass binary (*.rcxb);;JSON (*.json)");
+        if (savedPath.isEmpty()) return false;
+    }
+    // Encoding and writing happen on the pool; the doc reads as saved from
+    // here on and onDocSaveFinished reports a failure. A successful write
+    // drops the autosave shadow and the journal it covers.
+    connect(tab.doc, &RcxDocument::saveFinished, this,
+            &MainWindow::onDocSaveFinished, Qt::UniqueConnection);
+    tab.doc->saveInBackground(savedPath);
+    addRecentFile(savedPath);
     updateWindowTitle();
     rebuildWorkspaceModel();
     return true;
 }
 
+void MainWindow::onDocSaveFinished(const QString& path, bool ok, const QString& errorMsg) {
+    if (ok) {
+        setAppStatus(QStringLiteral("Saved %1").arg(QFileInfo(path).fileName()));
+        return;
+    }
+    // The doc flipped back to modified; show that before the dialog.
+    updateWindowTitle();
+    rebuildWorkspaceModel();
+    ThemedMessageBox::warn(this,
+        QStringLiteral("Save Failed"),
+        QStringLiteral("Couldn't save %1:\n%2").arg(path, errorMsg));
+}
+
 void MainWindow::project_close(QDockWidget* dock) {
     if (!dock) dock = m_activeDocDock;
     if (!dock) return;
@@ -9065,40 +9117,73 @@ void MainWindow::createSymbolsDock() {
     }
 }
 
-int MainWindow::loadPdbAndCacheTypes(const QString& pdbPath) {
-    QString symErr;
-    auto result = rcx::extractPdbSymbols(pdbPath, &symErr);
-    if (result.symbols.isEmpty()) return 0;
+namespace {
+struct PdbLoadResult {
+    rcx::PdbSymbolResult symbols;
+    QVector<rcx::PdbTypeInfo> types;
+};
+} // namespace
+
+void MainWindow::loadPdbAndCacheTypes(const QString& pdbPath,
+                                      std::function<void(int, int)> done) {
+    // Parsing a kernel PDB (ntkrnlmp: ~100 MB, tens of thousands of TPI
+    // records) took seconds on the UI thread. Both passes now run on the
+    // pool; SymbolStore is only touched back here on the GUI thread.
+    const QString fname = QFileInfo(pdbPath).fileName();
+    setAppStatus(QStringLiteral("Loading symbols from %1...").arg(fname));
+
+    auto* watcher = new QFutureWatcher<PdbLoadResult>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, pdbPath, done]() {
+        watcher->deleteLater();
+        const PdbLoadResult r = watcher->result();
+        const auto& result = r.symbols;
+        int count = 0;
+        if (!result.symbols.isEmpty()) {
+            QVector<QPair<QString, uint32_t>> pairs;
+            QHash<QString, uint32_t> typeIndices;
+            pairs.reserve(result.symbols.size());
+            for (const auto& s : result.symbols) {
+                pairs.emplaceBack(s.name, s.rva);
+                if (s.typeIndex != 0)
+                    typeIndices.insert(s.name, s.typeIndex);
+            }
 
-    QVector<QPair<QString, uint32_t>> pairs;
-    QHash<QString, uint32_t> typeIndices;
-    pairs.reserve(result.symbols.size());
-    for (const auto& s : result.symbols) {
-        pairs.emplaceBack(s.name, s.rva);
-        if (s.typeIndex != 0)
-            typeIndices.insert(s.name, s.typeIndex);
-    }
+            count = rcx::SymbolStore::instance().addModule(
+                result.moduleName, pdbPath, pairs);
+            if (!typeIndices.isEmpty())
+                rcx::SymbolStore::instance().addModuleTypeIndices(
+                    result.moduleName, typeIndices);
 
-    int count = rcx::SymbolStore::instance().addModule(
-        result.moduleName, pdbPath, pairs);
-    if (!typeIndices.isEmpty())
-        rcx::SymbolStore::instance().addModuleTypeIndices(
-            result.moduleName, typeIndices);
+            // Standalone TPI types — populates the unified Symbols panel with the
+            // struct/enum definitions even when no symbol names them. Right-click
+            // a type row → "Import type" pulls it into the active document.
+            if (!r.types.isEmpty())
+                rcx::SymbolStore::instance().addModuleTypes(result.moduleName, r.types);
 
-    // Standalone TPI types — populates the unified Symbols panel with the
-    // struct/enum definitions even when no symbol names them. Right-click
-    // a type row → "Import type" pulls it into the active document.
-    QString typeErr;
-    auto types = rcx::enumeratePdbTypes(pdbPath, &typeErr);
-    if (!types.isEmpty()) {
-        std::sort(types.begin(), types.end(), [](const auto& a, const auto& b) {
+            rcx::NameRegistry::instance().emitChanged();
+            rebuildSymbols();
+        }
+        if (done) done(count, int(r.types.size()));
+    });
+
+    watcher->setFuture(QtConcurrent::run([this, pdbPath, fname]() {
+        PdbLoadResult r;
+        QString symErr;
+        r.symbols = rcx::extractPdbSymbols(pdbPath, &symErr);
+        if (r.symbols.symbols.isEmpty()) return r;
+
+        QMetaObject::invokeMethod(this, [this, fname, n = r.symbols.symbols.size()]() {
+            setAppStatus(QStringLiteral("Loaded %1 symbols from %2, reading types...")
+                .arg(n).arg(fname));
+        }, Qt::QueuedConnection);
+
+        QString typeErr;
+        r.types = rcx::enumeratePdbTypes(pdbPath, &typeErr);
+        std::sort(r.types.begin(), r.types.end(), [](const auto& a, const auto& b) {
             return a.name.compare(b.name, Qt::CaseInsensitive) < 0;
         });
-        rcx::SymbolStore::instance().addModuleTypes(result.moduleName, types);
-    }
-
-    rcx::NameRegistry::instance().emitChanged();
-    return count;
+        return r;
+    }));
 }
 
 // ── Bookmarks dock ──
@@ -9371,36 +9456,65 @@ void MainWindow::bulkImportTypesUI(const QVector<rcx::NamedAddress>& entries) {
         if (!tab) return;
     }
 
-    int totalImported = 0;
-    for (auto it = byPdb.constBegin(); it != byPdb.constEnd(); ++it) {
-        QString err;
-        rcx::NodeTree importedTree = rcx::importPdbSelected(it.key(), it.value(), &err);
-        if (importedTree.nodes.isEmpty()) continue;
-
-        auto& tree = tab->doc->tree;
-        tab->ctrl->setSuppressRefresh(true);
-        tab->doc->undoStack.beginMacro(QStringLiteral("Import PDB types"));
-        QHash<uint64_t, uint64_t> idMap;
-        for (const auto& node : importedTree.nodes) idMap[node.id] = tree.reserveId();
-        for (const auto& node : importedTree.nodes) {
-            rcx::Node copy = node;
-            copy.id = idMap.value(node.id, node.id);
-            copy.parentId = idMap.value(node.parentId, node.parentId);
-            if (copy.refId != 0)
-                copy.refId = idMap.value(node.refId, node.refId);
-            tab->doc->undoStack.push(new rcx::RcxCommand(tab->ctrl, rcx::cmd::Insert{copy}));
-        }
-        tab->doc->undoStack.endMacro();
-        tab->ctrl->setSuppressRefresh(false);
-
-        int rootStructs = 0;
-        for (const auto& n : importedTree.nodes)
-            if (n.parentId == 0 && n.kind == rcx::NodeKind::Struct) rootStructs++;
-        totalImported += rootStructs;
-    }
-    tab->ctrl->refresh();
-    rebuildWorkspaceModel();
-    setAppStatus(QStringLiteral("Imported %1 types into current project").arg(totalImported));
+    // importPdbSelected resolves every dependency of the selection and can
+    // take seconds on a kernel PDB, so it runs on the pool like the PDB
+    // load; the trees are inserted back here on the GUI thread.
+    int typeCount = 0;
+    for (const auto& indices : byPdb) typeCount += indices.size();
+    setAppStatus(QStringLiteral("Importing %1 types...").arg(typeCount));
+
+    QPointer<QDockWidget> dockGuard = m_activeDocDock;
+    auto* watcher = new QFutureWatcher<QVector<rcx::NodeTree>>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, dockGuard]() {
+        watcher->deleteLater();
+        const QVector<rcx::NodeTree> trees = watcher->result();
+        if (!dockGuard || !m_tabs.contains(dockGuard)) {
+            setAppStatus(QStringLiteral("Import cancelled: the target tab was closed"));
+            return;
+        }
+        TabState* tab = &m_tabs[dockGuard];
+
+        int totalImported = 0;
+        for (const rcx::NodeTree& importedTree : trees) {
+            if (importedTree.nodes.isEmpty()) continue;
+
+            auto& tree = tab->doc->tree;
+            tab->ctrl->setSuppressRefresh(true);
+            tab->doc->undoStack.beginMacro(QStringLiteral("Import PDB types"));
+            QHash<uint64_t, uint64_t> idMap;
+            for (const auto& node : importedTree.nodes) idMap[node.id] = tree.reserveId();
+            for (const auto& node : importedTree.nodes) {
+                rcx::Node copy = node;
+                copy.id = idMap.value(node.id, node.id);
+                copy.parentId = idMap.value(node.parentId, node.parentId);
+                if (copy.refId != 0)
+                    copy.refId = idMap.value(node.refId, node.refId);
+                tab->doc->undoStack.push(new rcx::RcxCommand(tab->ctrl, rcx::cmd::Insert{copy}));
+            }
+            tab->doc->undoStack.endMacro();
+            tab->ctrl->setSuppressRefresh(false);
+
+            int rootStructs = 0;
+            for (const auto& n : importedTree.nodes)
+                if (n.parentId == 0 && n.kind == rcx::NodeKind::Struct) rootStructs++;
+            totalImported += rootStructs;
+        }
+        tab->ctrl->refresh();
+        rebuildWorkspaceModel();
+        setAppStatus(QStringLiteral("Imported %1 types into current project").arg(totalImported));
+    });
+
+    watcher->setFuture(QtConcurrent::run([byPdb]() {
+        QVector<rcx::NodeTree> trees;
+        trees.reserve(byPdb.size());
+        for (auto it = byPdb.constBegin(); it != byPdb.constEnd(); ++it) {
+            QString err;
+            trees.append(rcx::importPdbSelected(it.key(), it.value(), &err));
+            if (trees.last().nodes.isEmpty())
+                qDebug() << "[PDB] import failed for" << it.key() << err;
+        }
+        return trees;
+    }));
 }
 
 void MainWindow::downloadSymbolsForProcess() {
@@ -9833,23 +9947,33 @@ int MainWindow::loadDockSize(QDockWidget* dock, int fallback) const {
 }
 
 void MainWindow::autosaveAllModifiedDocs() {
-    // Walk every open doc once (multiple tabs can share a doc — dedup) and
-    // shadow-save any that have unsaved changes AND a known filePath. We
-    // do NOT clear doc->modified — this is a recovery snapshot, not a real
-    // save. A real saveFile / saveFileAs removes the .autosave file.
+    // Edits already reach disk one command at a time through each doc's
+    // journal. The timer only folds a long journal into a fresh .autosave
+    // shadow, so recovery doesn't replay thousands of lines — or writes
+    // the shadow every tick for a doc whose journal stopped working or
+    // that holds edits the journal never sees (bookmarks, type aliases).
+    // Walk every open doc once (multiple tabs can share a doc — dedup);
+    // untitled docs have nowhere to put either. The shadow is written on
+    // the pool from a snapshot and doesn't clear doc->modified — it's a
+    // recovery copy, not a real save.
+    constexpr int kJournalFoldThreshold = 500;
     QSet<RcxDocument*> seen;
-    int wrote = 0;
+    int started = 0;
     for (auto it = m_tabs.constBegin(); it != m_tabs.constEnd(); ++it) {
         RcxDocument* doc = it.value().doc;
         if (seen.contains(doc)) continue;
         seen.insert(doc);
         if (!doc->modified) continue;
         if (doc->filePath.isEmpty()) continue;
-        if (doc->save(doc->filePath + QStringLiteral(".autosave")))
-            ++wrote;
+        if (doc->journal.isOpen() && !doc->journal.failed()
+            && !doc->hasUnjournaledEdits()
+            && doc->journal.pending() < kJournalFoldThreshold)
+            continue;
+        if (doc->autosaveInBackground())
+            ++started;
     }
-    if (wrote > 0)
-        qInfo().nospace() << "[autosave] wrote " << wrote << " shadow copy(ies)";
+    if (started > 0)
+        qInfo().nospace() << "[autosave] writing " << started << " shadow copy(ies)";
 }
 
 void MainWindow::addRecentFile(const QString& path) {
@@ -10177,8 +10301,24 @@ void MainWindow::closeEvent(QCloseEvent* event) {
                 return;
             }
         }
+        // Saves write in the background; don't quit under them. A failed
+        // one has already been reported through onDocSaveFinished.
+        for (RcxDocument* doc : saved) {
+            if (!doc->waitForSave()) {
+                event->ignore();
+                return;
+            }
+        }
+    } else {
+        // Discard: the user dropped these edits, so drop their recovery
+        // files too rather than offer them back on the next open.
+        for (RcxDocument* doc : dirtyDocs) {
+            doc->waitForSave();
+            doc->journal.reset();
+            if (!doc->filePath.isEmpty())
+                QFile::remove(doc->filePath + QStringLiteral(".autosave"));
+        }
     }
-    // Discard → fall through and accept
     event->accept();
 }
 
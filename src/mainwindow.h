@@ -54,6 +54,7 @@ private slots:
     void openFile();
     void saveFile();
     void saveFileAs();
+    void saveData();
     void closeFile();
 
     void addNode();
@@ -84,6 +85,7 @@ private slots:
     void showValidateDialog();
     void showFindFieldDialog();
     void autosaveAllModifiedDocs();
+    void onDocSaveFinished(const QString& path, bool ok, const QString& errorMsg);
     void editTheme();
     void showOptionsDialog();
     void showOptionsDialog(int initialPage);
@@ -461,8 +463,11 @@ private:
     // call before the dock has been built (no-op when m_unifiedSymbols is null).
     void rebuildSymbols();
     void downloadSymbolsForProcess();
-    // Load PDB symbols + typeIndices into SymbolStore. Returns symbol count.
-    int loadPdbAndCacheTypes(const QString& pdbPath);
+    // Load PDB symbols + typeIndices + TPI types into SymbolStore. Parsing
+    // runs on a worker thread with progress in the status bar; `done` gets
+    // the symbol and type counts once the store has been updated.
+    void loadPdbAndCacheTypes(const QString& pdbPath,
+                              std::function<void(int symbols, int types)> done = {});
     // Import one type from a PDB file into the active document by typeIndex.
     // Mirrors the MCP symbols.importType path.
     void importTypeFromPdbUI(const QString& pdbPath, uint32_t typeIndex,
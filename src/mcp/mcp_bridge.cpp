@@ -5,13 +5,19 @@
 #include "generator.h"
 #include "mainwindow.h"
 #include "scanner.h"
+#include "pointerscan.h"
 #include "symbolstore.h"
 #include "imports/import_pdb.h"
 #include "imports/import_source.h"
 #include "typeinfer.h"
+#include "timeseries.h"
 #include "themes/thememanager.h"
 #include <QCoreApplication>
+#include <QDir>
+#include <QEventLoop>
 #include <QFile>
+#include <QFileInfo>
+#include <QLabel>
 #include <QSettings>
 #include <QTimer>
 #include <QDebug>
@@ -672,7 +678,8 @@ QJsonObject McpBridge::handleToolsList(const QJsonValue& id) {
     // 9. node.history
     tools.append(QJsonObject{
         {"name", "node.history"},
-        {"description", "Returns timestamped value change history (up to 10 entries) for specified nodes. "
+        {"description", "Returns timestamped value change history (newest first, up to the ring capacity — "
+                        "1024 values per node by default; pass limit to trim) for specified nodes. "
                         "Use this to detect what changed after an in-game event — no need to manually snapshot memory. "
                         "Each node returns: entries[] with {value, timestamp}, heatLevel (0=static to 3=hot), "
                         "and uniqueCount. Heat level 3 means the field is actively changing. "
@@ -683,12 +690,77 @@ QJsonObject McpBridge::handleToolsList(const QJsonValue& id) {
                 {"nodeIds", QJsonObject{{"type", "array"},
                     {"items", QJsonObject{{"type", "string"}}},
                     {"description", "Array of node IDs to get history for."}}},
+                {"limit", QJsonObject{{"type", "integer"},
+                    {"description", "Max entries per node, newest first. Omit for the whole ring."}}},
+                {"tabIndex", QJsonObject{{"type", "integer"},
+                    {"description", "MDI tab index. Omit for active tab."}}}
+            }},
+            {"required", QJsonArray{"nodeIds"}}
+        }}
+    });
+
+    // 9b. record.start / record.stop / record.query — columnar field recording
+    tools.append(QJsonObject{
+        {"name", "record.start"},
+        {"description", "Start recording value fields to an append-only columnar file (.rcxts): "
+                        "one row per sample with a microsecond timestamp and every field's raw value. "
+                        "Samples on every refresh tick by default, or on a dedicated recorder thread (intervalMs, "
+                        "e.g. 5 = 200 Hz) reading the live source. Data streams to disk in blocks, so "
+                        "minutes of high-rate capture don't grow memory. Replaces any running recording."},
+        {"inputSchema", QJsonObject{
+            {"type", "object"},
+            {"properties", QJsonObject{
+                {"nodeIds", QJsonObject{{"type", "array"},
+                    {"items", QJsonObject{{"type", "string"}}},
+                    {"description", "Leaf (non-struct, non-array) node IDs to record."}}},
+                {"path", QJsonObject{{"type", "string"},
+                    {"description", "Output file. Omit for a timestamped file in the temp directory."}}},
+                {"intervalMs", QJsonObject{{"type", "integer"},
+                    {"description", "Sampling period in ms; 0 (default) = every refresh tick."}}},
                 {"tabIndex", QJsonObject{{"type", "integer"},
                     {"description", "MDI tab index. Omit for active tab."}}}
             }},
             {"required", QJsonArray{"nodeIds"}}
         }}
     });
+    tools.append(QJsonObject{
+        {"name", "record.stop"},
+        {"description", "Stop the running recording and return its path, row count and size."},
+        {"inputSchema", QJsonObject{
+            {"type", "object"},
+            {"properties", QJsonObject{
+                {"tabIndex", QJsonObject{{"type", "integer"},
+                    {"description", "MDI tab index. Omit for active tab."}}}
+            }}
+        }}
+    });
+    tools.append(QJsonObject{
+        {"name", "record.query"},
+        {"description", "Read a recording (the running or last one by default). Returns raw rows when the "
+                        "range holds at most maxPoints rows, otherwise per-field time buckets with "
+                        "min/max/last. Times are microseconds since the Unix epoch. "
+                        "Pass csvPath to export the range as CSV instead."},
+        {"inputSchema", QJsonObject{
+            {"type", "object"},
+            {"properties", QJsonObject{
+                {"path", QJsonObject{{"type", "string"},
+                    {"description", "Recording file. Omit for the tab's running or last recording."}}},
+                {"nodeIds", QJsonObject{{"type", "array"},
+                    {"items", QJsonObject{{"type", "string"}}},
+                    {"description", "Fields to return. Omit for all recorded fields."}}},
+                {"fromUs", QJsonObject{{"type", "integer"},
+                    {"description", "Range start (inclusive). Omit for the first sample."}}},
+                {"toUs", QJsonObject{{"type", "integer"},
+                    {"description", "Range end (inclusive). Omit for the last sample."}}},
+                {"maxPoints", QJsonObject{{"type", "integer"},
+                    {"description", "Row / bucket budget per field (default 200, max 10000)."}}},
+                {"csvPath", QJsonObject{{"type", "string"},
+                    {"description", "Export the range to this CSV file instead of returning data."}}},
+                {"tabIndex", QJsonObject{{"type", "integer"},
+                    {"description", "MDI tab index. Omit for active tab."}}}
+            }}
+        }}
+    });
 
     // 10. scanner.scan
     tools.append(QJsonObject{
@@ -1015,6 +1087,40 @@ QJsonObject McpBridge::handleToolsList(const QJsonValue& id) {
         }}
     });
 
+    // analysis.pointer_scan
+    tools.append(QJsonObject{
+        {"name", "analysis.pointer_scan"},
+        {"description", "Find static pointer paths to a dynamic address: module-relative chains like "
+                        "'[[<game.exe>+0x1A0]+0x30]+0x8' that still reach the object after it moves. "
+                        "The reverse of analysis.pointer_chain. Save with savePath, then after the game "
+                        "restarts scan the object's new address with intersectWith to keep only the paths "
+                        "that survived. Paths are valid base-address formulas. Runs on the scanner "
+                        "panel's engine (one scan at a time; its Stop aborts it) and stops after 2 "
+                        "minutes with the paths found so far."},
+        {"inputSchema", QJsonObject{
+            {"type", "object"},
+            {"properties", QJsonObject{
+                {"address", QJsonObject{{"type", "string"},
+                    {"description", "Target address (hex string, e.g. '0x1F3A4B20008')."}}},
+                {"maxDepth", QJsonObject{{"type", "integer"},
+                    {"description", "Most dereferences per path (default 4, max 8)."}}},
+                {"maxOffset", QJsonObject{{"type", "integer"},
+                    {"description", "Largest offset after each dereference (default 0x1000, max 0x10000)."}}},
+                {"maxResults", QJsonObject{{"type", "integer"},
+                    {"description", "Stop after this many paths (default 100000)."}}},
+                {"limit", QJsonObject{{"type", "integer"},
+                    {"description", "Paths to list in the reply, shortest first (default 50)."}}},
+                {"savePath", QJsonObject{{"type", "string"},
+                    {"description", "Write every path (after intersecting) to this JSON file."}}},
+                {"intersectWith", QJsonObject{{"type", "string"},
+                    {"description", "A file from an earlier savePath; keep only paths found in both."}}},
+                {"tabIndex", QJsonObject{{"type", "integer"},
+                    {"description", "MDI tab index (0-based). Omit for active tab."}}}
+            }},
+            {"required", QJsonArray{"address"}}
+        }}
+    });
+
     // analysis.find_overlaps
     tools.append(QJsonObject{
         {"name", "analysis.find_overlaps"},
@@ -1188,6 +1294,9 @@ QJsonObject McpBridge::handleToolsCall(const QJsonValue& id, const QJsonObject&
     else if (toolName == "ui.action")      result = toolUiAction(args);
     else if (toolName == "tree.search")   result = toolTreeSearch(args);
     else if (toolName == "node.history")  result = toolNodeHistory(args);
+    else if (toolName == "record.start")  result = toolRecordStart(args);
+    else if (toolName == "record.stop")   result = toolRecordStop(args);
+    else if (toolName == "record.query")  result = toolRecordQuery(args);
     else if (toolName == "scanner.scan")  result = toolScannerScan(args);
     else if (toolName == "scanner.scan_pattern") result = toolScannerScanPattern(args);
     else if (toolName == "scanner.rescan")  result = toolScannerRescan(args);
@@ -1202,6 +1311,7 @@ QJsonObject McpBridge::handleToolsCall(const QJsonValue& id, const QJsonObject&
     else if (toolName == "analysis.infer_types") result = toolAnalysisInferTypes(args);
     else if (toolName == "analysis.import_header") result = toolAnalysisImportHeader(args);
     else if (toolName == "analysis.pointer_chain") result = toolAnalysisPointerChain(args);
+    else if (toolName == "analysis.pointer_scan")  result = toolAnalysisPointerScan(args);
     else if (toolName == "analysis.find_overlaps") result = toolAnalysisFindOverlaps(args);
     else if (toolName == "analysis.field_path")    result = toolAnalysisFieldPath(args);
     else if (toolName == "analysis.tree_summary")  result = toolAnalysisTreeSummary(args);
@@ -1267,6 +1377,13 @@ QString McpBridge::resolvePlaceholder(const QString& ref,
 // Smart tab resolution
 // ════════════════════════════════════════════════════════════════════
 
+// Tools read and edit the whole tree: class bodies an .rcxb load deferred
+// are decoded before a tool sees the document.
+static MainWindow::TabState* fullyLoaded(MainWindow::TabState* t) {
+    if (t && t->doc) t->doc->ensureFullyLoaded();
+    return t;
+}
+
 MainWindow::TabState* McpBridge::resolveTab(const QJsonObject& args, int* resolvedIndex) {
     if (resolvedIndex) *resolvedIndex = -1;
 
@@ -1274,7 +1391,7 @@ MainWindow::TabState* McpBridge::resolveTab(const QJsonObject& args, int* resolv
     if (args.contains("tabIndex")) {
         int idx = (int)parseInteger(args.value("tabIndex"));
         auto* t = m_mainWindow->tabByIndex(idx);
-        if (t) { if (resolvedIndex) *resolvedIndex = idx; return t; }
+        if (t) { if (resolvedIndex) *resolvedIndex = idx; return fullyLoaded(t); }
     }
 
     // 2) Active sub-window (user clicked on it)
@@ -1285,13 +1402,13 @@ MainWindow::TabState* McpBridge::resolveTab(const QJsonObject& args, int* resolv
                 if (m_mainWindow->tabByIndex(i) == t) { *resolvedIndex = i; break; }
             }
         }
-        return t;
+        return fullyLoaded(t);
     }
 
     // 3) Fall back to first available tab
     if (m_mainWindow->tabCount() > 0) {
         t = m_mainWindow->tabByIndex(0);
-        if (t) { if (resolvedIndex) *resolvedIndex = 0; return t; }
+        if (t) { if (resolvedIndex) *resolvedIndex = 0; return fullyLoaded(t); }
     }
 
     // 4) No tabs at all — auto-create a project
@@ -1333,7 +1450,7 @@ QJsonObject McpBridge::toolProjectState(const QJsonObject& args) {
         provInfo["name"] = doc->provider->name();
         provInfo["writable"] = doc->provider->isWritable();
         provInfo["live"] = doc->provider->isLive();
-        provInfo["size"] = doc->provider->size();
+        provInfo["size"] = (qint64)doc->provider->extent();
         provInfo["kind"] = doc->provider->kind();
     }
     state["provider"] = provInfo;
@@ -2016,8 +2133,7 @@ QJsonObject McpBridge::toolHexRead(const QJsonObject& args) {
 
             // Pointer-likeness
             uint64_t base = tab->doc->tree.baseAddress;
-            int provSize = prov->size();
-            if (v >= base && v < base + (uint64_t)provSize)
+            if (v >= base && v - base < prov->extent())
                 dump += "ptr?: LIKELY (within provider range)\n";
         }
         // String-likeness
@@ -2321,19 +2437,25 @@ QJsonObject McpBridge::toolNodeHistory(const QJsonObject& args) {
     if (requestedIds.isEmpty())
         return makeTextResult("nodeIds array is required.", true);
 
+    const int limit = args.value("limit").toInt(-1);
+    const NodeTree& tree = tab->doc->tree;
+
     QJsonObject result;
     for (const auto& idVal : requestedIds) {
         QString idStr = idVal.toString();
         uint64_t nodeId = idStr.toULongLong();
         auto it = histMap.find(nodeId);
+        int nodeIdx = tree.indexOfId(nodeId);
         QJsonArray entries;
-        if (it != histMap.end()) {
-            it->forEachWithTime([&](const QString& val, qint64 msec) {
+        if (it != histMap.end() && nodeIdx >= 0) {
+            // Samples are raw bytes; format them against the node's type now.
+            const Node& node = tree.nodes[nodeIdx];
+            it->forEachWithTime([&](const ValueHistory::Sample& sample) {
                 QJsonObject entry;
-                entry.insert(QStringLiteral("value"), val);
-                entry.insert(QStringLiteral("timestamp"), msec);
+                entry.insert(QStringLiteral("value"), fmt::historyValue(node, sample));
+                entry.insert(QStringLiteral("timestamp"), sample.msec);
                 entries.append(entry);
-            });
+            }, limit);
         }
         QJsonObject nodeResult;
         nodeResult.insert(QStringLiteral("entries"), entries);
@@ -2345,6 +2467,159 @@ QJsonObject McpBridge::toolNodeHistory(const QJsonObject& args) {
         QJsonDocument(result).toJson(QJsonDocument::Compact)));
 }
 
+// ════════════════════════════════════════════════════════════════════
+// Tool: record.start / record.stop / record.query — field recordings
+// ════════════════════════════════════════════════════════════════════
+
+QJsonObject McpBridge::toolRecordStart(const QJsonObject& args) {
+    auto* tab = resolveTab(args);
+    if (!tab) return makeTextResult("No active tab.", true);
+
+    QVector<uint64_t> ids;
+    for (const auto& v : args.value("nodeIds").toArray())
+        ids.append(v.toString().toULongLong());
+    if (ids.isEmpty())
+        return makeTextResult("nodeIds array is required.", true);
+
+    QString path = args.value("path").toString();
+    if (path.isEmpty())
+        path = QDir::temp().filePath(QStringLiteral("reclass_%1.rcxts")
+            .arg(QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd_HHmmss"))));
+    int intervalMs = qMax(0, args.value("intervalMs").toInt(0));
+
+    QString err;
+    if (!tab->ctrl->startRecording(ids, path, intervalMs, &err))
+        return makeTextResult(QStringLiteral("Recording failed: %1").arg(err), true);
+
+    QJsonObject out;
+    out.insert(QStringLiteral("path"), path);
+    out.insert(QStringLiteral("fields"), ids.size());
+    out.insert(QStringLiteral("intervalMs"), intervalMs);
+    return makeTextResult(QString::fromUtf8(QJsonDocument(out).toJson(QJsonDocument::Compact)));
+}
+
+QJsonObject McpBridge::toolRecordStop(const QJsonObject& args) {
+    auto* tab = resolveTab(args);
+    if (!tab) return makeTextResult("No active tab.", true);
+    if (!tab->ctrl->isRecording())
+        return makeTextResult("No recording is running.", true);
+
+    qint64 rows = tab->ctrl->recorder()->rows();
+    tab->ctrl->stopRecording();
+    QString path = tab->ctrl->lastRecordingPath();
+
+    QJsonObject out;
+    out.insert(QStringLiteral("path"), path);
+    out.insert(QStringLiteral("rows"), rows);
+    out.insert(QStringLiteral("bytes"), QFileInfo(path).size());
+    return makeTextResult(QString::fromUtf8(QJsonDocument(out).toJson(QJsonDocument::Compact)));
+}
+
+QJsonObject McpBridge::toolRecordQuery(const QJsonObject& args) {
+    auto* tab = resolveTab(args);
+    QString path = args.value("path").toString();
+    if (path.isEmpty()) {
+        if (!tab) return makeTextResult("No active tab.", true);
+        path = tab->ctrl->lastRecordingPath();
+        if (path.isEmpty()) return makeTextResult("No recording; pass path.", true);
+        tab->ctrl->flushRecording();
+    }
+
+    SeriesReader reader;
+    QString err;
+    if (!reader.open(path, &err))
+        return makeTextResult(QStringLiteral("Cannot read %1: %2").arg(path, err), true);
+
+    QVector<int> cols;
+    const QJsonArray idArr = args.value("nodeIds").toArray();
+    for (const auto& v : idArr) {
+        int c = reader.columnIndex(v.toString().toULongLong());
+        if (c < 0)
+            return makeTextResult(QStringLiteral("Node %1 is not in this recording.")
+                                      .arg(v.toString()), true);
+        cols.append(c);
+    }
+    if (cols.isEmpty())
+        for (int c = 0; c < reader.columns().size(); c++) cols.append(c);
+
+    const qint64 fromUs = args.contains("fromUs")
+        ? qint64(args.value("fromUs").toDouble()) : reader.firstUs();
+    const qint64 toUs = args.contains("toUs")
+        ? qint64(args.value("toUs").toDouble()) : reader.lastUs();
+    const int maxPoints = qBound(1, args.value("maxPoints").toInt(200), 10000);
+
+    QString csvPath = args.value("csvPath").toString();
+    if (!csvPath.isEmpty()) {
+        if (!exportSeriesCsv(reader, csvPath, fromUs, toUs, &err))
+            return makeTextResult(QStringLiteral("CSV export failed: %1").arg(err), true);
+        return makeTextResult(QStringLiteral("Exported to %1").arg(csvPath));
+    }
+
+    QJsonObject out;
+    out.insert(QStringLiteral("path"), path);
+    out.insert(QStringLiteral("rows"), reader.rowCount());
+    out.insert(QStringLiteral("firstUs"), double(reader.firstUs()));
+    out.insert(QStringLiteral("lastUs"), double(reader.lastUs()));
+
+    // Count the rows in range first; decoding is cheap next to JSON.
+    qint64 inRange = 0;
+    reader.forEachRow(fromUs, toUs, [&](qint64, const uint8_t*) {
+        return ++inRange <= maxPoints;
+    });
+
+    auto cellValue = [&](int c, const uint8_t* row) -> QJsonValue {
+        if (reader.columns()[c].encoding == SeriesEncoding::Raw)
+            return QString::fromLatin1(QByteArray(
+                reinterpret_cast<const char*>(reader.columnBytes(c, row)),
+                reader.columns()[c].width).toHex());
+        return reader.numericValue(c, row);
+    };
+
+    QJsonObject fields;
+    if (inRange <= maxPoints) {
+        QJsonArray times;
+        QVector<QJsonArray> values(cols.size());
+        reader.forEachRow(fromUs, toUs, [&](qint64 t, const uint8_t* row) {
+            times.append(double(t));
+            for (int i = 0; i < cols.size(); i++)
+                values[i].append(cellValue(cols[i], row));
+            return true;
+        });
+        out.insert(QStringLiteral("mode"), QStringLiteral("raw"));
+        out.insert(QStringLiteral("t"), times);
+        for (int i = 0; i < cols.size(); i++) {
+            const auto& col = reader.columns()[cols[i]];
+            QJsonObject f;
+            f.insert(QStringLiteral("name"), col.name);
+            f.insert(QStringLiteral("values"), values[i]);
+            fields.insert(QString::number(col.nodeId), f);
+        }
+    } else {
+        out.insert(QStringLiteral("mode"), QStringLiteral("buckets"));
+        for (int c : cols) {
+            const auto& col = reader.columns()[c];
+            QJsonObject f;
+            f.insert(QStringLiteral("name"), col.name);
+            if (col.encoding == SeriesEncoding::Raw) {
+                f.insert(QStringLiteral("error"), QStringLiteral("raw column; use csvPath"));
+            } else {
+                QJsonArray buckets;
+                for (const auto& b : downsampleSeries(reader, c, fromUs, toUs, maxPoints)) {
+                    buckets.append(QJsonArray{double(b.fromUs), double(b.toUs), b.count,
+                                              b.min, b.max, b.last});
+                }
+                f.insert(QStringLiteral("buckets"), buckets);
+                f.insert(QStringLiteral("bucketFormat"),
+                         QStringLiteral("[fromUs, toUs, count, min, max, last]"));
+            }
+            fields.insert(QString::number(col.nodeId), f);
+        }
+    }
+    out.insert(QStringLiteral("fields"), fields);
+    return makeTextResult(QString::fromUtf8(QJsonDocument(out).toJson(QJsonDocument::Compact)));
+}
+
+// ════════════════════════════════════════════════════════════════════
 // TOOL: scanner.scan
 // ════════════════════════════════════════════════════════════════════
 
@@ -2410,14 +2685,22 @@ static ScanCondition scanConditionFromString(const QString& s, bool* ok = nullpt
 
 // Build a structured, paged text response over a scan result set. scanId is the
 // panel's scan generation (so the agent can detect a set that changed under it).
-static QString buildScanPage(ScannerPanel* panel, const QVector<ScanResult>& results,
+static QString buildScanPage(ScannerPanel* panel, const ScanResultStore& results,
                              int offset, int limit, bool capped, const QString& header) {
     const int total = results.size();
     offset = qMax(0, offset);
     limit  = qBound(1, limit, 500);
     QString msg = header;
     msg += QStringLiteral("\nscanId=%1  total=%2  capped=%3")
-        .arg(panel->scanGeneration()).arg(total).arg(capped ? QStringLiteral("true") : QStringLiteral("false"));
+        .arg(panel->scanGeneration()).arg(results.candidateCount())
+        .arg(capped ? QStringLiteral("true") : QStringLiteral("false"));
+    // Snapshot-backed sets carry no address list to page through yet.
+    if (results.isSnapshot()) {
+        msg += QStringLiteral("  snapshot=true\n(candidates are held in a disk snapshot; "
+                              "narrow with scanner.rescan until fewer than %1 remain to list them)")
+            .arg(results.snapshot()->threshold());
+        return msg;
+    }
     if (total == 0) {
         msg += QStringLiteral("\n(no results)");
         return msg;
@@ -2428,14 +2711,16 @@ static QString buildScanPage(ScannerPanel* panel, const QVector<ScanResult>& res
     }
     int end = qMin(total, offset + limit);
     msg += QStringLiteral("\nshowing [%1, %2):").arg(offset).arg(end);
+    // Only the requested page is read out of the store.
     for (int i = offset; i < end; i++) {
-        const ScanResult& r = results[i];
-        msg += QStringLiteral("\n  0x%1").arg(r.address, 16, 16, QChar('0'));
-        QString val = panel->formatValuePublic(r.scanValue);
+        msg += QStringLiteral("\n  0x%1").arg(results.address(i), 16, 16, QChar('0'));
+        QString val = panel->formatValuePublic(results.value(i));
         if (!val.isEmpty()) msg += QStringLiteral("  = %1").arg(val);
-        if (!r.previousValue.isEmpty())
-            msg += QStringLiteral("  (prev %1)").arg(panel->formatValuePublic(r.previousValue));
-        if (!r.regionModule.isEmpty()) msg += QStringLiteral("  [%1]").arg(r.regionModule);
+        const QByteArray prev = results.previousValue(i);
+        if (!prev.isEmpty())
+            msg += QStringLiteral("  (prev %1)").arg(panel->formatValuePublic(prev));
+        const QString module = results.regionModule(i);
+        if (!module.isEmpty()) msg += QStringLiteral("  [%1]").arg(module);
     }
     if (end < total)
         msg += QStringLiteral("\n  ... %1 more (use offset=%2 to page)").arg(total - end).arg(end);
@@ -2475,10 +2760,10 @@ QJsonObject McpBridge::toolScannerScan(const QJsonObject& args) {
         return makeTextResult(regErr, true);
 
     ValueType vt = valueTypeFromString(valueTypeStr);
-    QVector<ScanResult> results = panel->runValueScanAndWait(
+    ScanResultStore results = panel->runValueScanAndWait(
         vt, cond, value, value2, filterExec, filterWrite, skipSys, constrainRegions);
 
-    bool capped = results.size() >= 10000000 ||
+    bool capped = (!results.isSnapshot() && results.size() >= 10000000) ||
                   (cond != ScanCondition::UnknownValue && results.size() >= 50000);
     QString header = QStringLiteral("Scan %1 (%2)")
         .arg(valueTypeStr.isEmpty() ? QStringLiteral("float") : valueTypeStr, condStr);
@@ -2511,15 +2796,15 @@ QJsonObject McpBridge::toolScannerRescan(const QJsonObject& args) {
                                   .arg(sid).arg(panel->scanGeneration()), true);
     }
 
-    int before = panel->results().size();
+    const qint64 before = panel->results().candidateCount();
     QString value  = args.value("value").toString();
     QString value2 = args.value("value2").toString();
     QString delta  = args.value("delta").toString();
     int offset = args.value("offset").toInt(0);
     int limit  = args.value("limit").toInt(50);
 
-    QVector<ScanResult> narrowed = panel->runRescanAndWait(cond, value, value2, delta);
-    QString header = QStringLiteral("Rescan %1: %2 -> %3").arg(condStr).arg(before).arg(narrowed.size());
+    ScanResultStore narrowed = panel->runRescanAndWait(cond, value, value2, delta);
+    QString header = QStringLiteral("Rescan %1: %2 -> %3").arg(condStr).arg(before).arg(narrowed.candidateCount());
     return makeTextResult(buildScanPage(panel, narrowed, offset, limit, false, header));
 }
 
@@ -2529,7 +2814,7 @@ QJsonObject McpBridge::toolScannerResults(const QJsonObject& args) {
     ScannerPanel* panel = m_mainWindow->m_scannerPanel;
     if (!panel) return makeTextResult("Scanner panel not available", true);
 
-    const QVector<ScanResult>& results = panel->results();
+    const ScanResultStore& results = panel->results();
     if (results.isEmpty())
         return makeTextResult("No current scan results. Run scanner.scan first.", true);
 
@@ -2551,7 +2836,7 @@ QJsonObject McpBridge::toolScannerResults(const QJsonObject& args) {
             int shown = 0;
             const int kMaxWindows = 8;  // bound output
             for (int i = o; i < end && shown < kMaxWindows; i++, shown++) {
-                uint64_t base = results[i].address;
+                uint64_t base = results.address(i);
                 uint64_t backBytes = (uint64_t)(floatWindow / 2) * 4;
                 uint64_t start = base >= backBytes ? base - backBytes : base;
                 QByteArray buf(floatWindow * 4, '\0');
@@ -2593,22 +2878,23 @@ QJsonObject McpBridge::toolScannerFindMatrix(const QJsonObject& args) {
     if (!regErr.isEmpty())
         return makeTextResult(regErr, true);
 
-    QVector<ScanResult> results = panel->runMatrixScanAndWait(
+    ScanResultStore results = panel->runMatrixScanAndWait(
         mp, filterExec, filterWrite, skipSys, maxCand, constrainRegions);
 
     QString msg = QStringLiteral("find_matrix: %1 candidate(s) (scanId=%2). Then move/rotate the camera "
                                  "and scanner.rescan condition=changed to confirm the LIVE matrix.")
         .arg(results.size()).arg(panel->scanGeneration());
-    int shown = 0;
-    for (const ScanResult& r : results) {
-        if (shown++ >= 16) {
+    for (int i = 0; i < results.size(); i++) {
+        if (i >= 16) {
             msg += QStringLiteral("\n  ... %1 more").arg(results.size() - 16);
             break;
         }
-        msg += QStringLiteral("\n  0x%1  score=%2").arg(r.address, 0, 16).arg(r.matchScore);
-        if (!r.regionModule.isEmpty()) msg += QStringLiteral("  [%1]").arg(r.regionModule);
-        if (r.scanValue.size() >= 64) {
-            const float* f = reinterpret_cast<const float*>(r.scanValue.constData());
+        msg += QStringLiteral("\n  0x%1  score=%2").arg(results.address(i), 0, 16).arg(results.matchScore(i));
+        const QString module = results.regionModule(i);
+        if (!module.isEmpty()) msg += QStringLiteral("  [%1]").arg(module);
+        if (results.valueLength(i) >= 64) {
+            float f[16];
+            memcpy(f, results.valueData(i), sizeof(f));
             for (int row = 0; row < 4; row++) {
                 msg += QStringLiteral("\n      [%1 %2 %3 %4]")
                     .arg((double)f[row*4+0], 0, 'g', 5).arg((double)f[row*4+1], 0, 'g', 5)
@@ -2649,7 +2935,7 @@ QJsonObject McpBridge::toolScannerScanPattern(const QJsonObject& args) {
         return makeTextResult("No provider on this tab — the scan did not run. Use source_switch to attach to a process (or open a file), then run the pattern scan again. If you already ran source_switch, ensure the tab that was switched is the one used (e.g. pass tabIndex: 0 for the first tab).", true);
     }
 
-    QVector<ScanResult> results = panel->runPatternScanAndWait(provider, pattern, filterExec, filterWrite, constrainRegions);
+    ScanResultStore results = panel->runPatternScanAndWait(provider, pattern, filterExec, filterWrite, constrainRegions);
 
     QString msg = QStringLiteral("Pattern scan (%1): %2 result(s).")
         .arg(pattern)
@@ -2664,9 +2950,10 @@ QJsonObject McpBridge::toolScannerScanPattern(const QJsonObject& args) {
     if (!results.isEmpty()) {
         msg += QStringLiteral("\nFirst addresses:");
         for (int i = 0; i < qMin(results.size(), showAddrs); i++) {
-            msg += QStringLiteral("\n  0x%1").arg(results[i].address, 16, 16, QChar('0'));
-            if (!results[i].regionModule.isEmpty())
-                msg += QStringLiteral(" (%1)").arg(results[i].regionModule);
+            msg += QStringLiteral("\n  0x%1").arg(results.address(i), 16, 16, QChar('0'));
+            const QString module = results.regionModule(i);
+            if (!module.isEmpty())
+                msg += QStringLiteral(" (%1)").arg(module);
         }
         if (results.size() > showAddrs)
             msg += QStringLiteral("\n  ... and %1 more").arg(results.size() - showAddrs);
@@ -3292,6 +3579,80 @@ QJsonObject McpBridge::toolAnalysisPointerChain(const QJsonObject& args) {
     return makeTextResult(output);
 }
 
+// ════════════════════════════════════════════════════════════════════
+// TOOL: analysis.pointer_scan — static paths to a dynamic address
+// ════════════════════════════════════════════════════════════════════
+
+QJsonObject McpBridge::toolAnalysisPointerScan(const QJsonObject& args) {
+    auto* tab = resolveTab(args);
+    if (!tab) return makeTextResult("No active tab", true);
+
+    std::shared_ptr<rcx::Provider> provider = tab->doc->provider;
+    if (!provider) return makeTextResult("No provider", true);
+    if (!args.contains("address")) return makeTextResult("Missing 'address'", true);
+
+    PointerScanRequest req;
+    req.target      = (uint64_t)parseInteger(args.value("address"));
+    req.maxDepth    = qBound(1, (int)parseInteger(args.value("maxDepth"), 4), 8);
+    req.maxOffset   = qBound(0, (int)parseInteger(args.value("maxOffset"), 0x1000), 0x10000);
+    req.maxResults  = qBound(1, (int)parseInteger(args.value("maxResults"), 100000), 1000000);
+    req.pointerSize = tab->doc->tree.pointerSize;
+    const int limit = qBound(1, (int)parseInteger(args.value("limit"), 50), 1000);
+
+    // Load the earlier session first: a bad path should fail before the scan.
+    PointerScanResult previous;
+    const QString intersectWith = args.value("intersectWith").toString();
+    if (!intersectWith.isEmpty()) {
+        QFile f(intersectWith);
+        if (!f.open(QIODevice::ReadOnly))
+            return makeTextResult(QStringLiteral("Cannot open '%1'").arg(intersectWith), true);
+        QString err;
+        if (!PointerScanResult::fromJson(QJsonDocument::fromJson(f.readAll()).object(), &previous, &err))
+            return makeTextResult(QStringLiteral("'%1': %2").arg(intersectWith, err), true);
+    }
+
+    // Seconds on a big process: the scanner panel's engine runs it on its
+    // pool and region cache, and the panel's Stop aborts it like any scan.
+    ScannerPanel* panel = m_mainWindow->m_scannerPanel;
+    if (!panel) return makeTextResult("Scanner panel not available", true);
+    PointerScanResult result = panel->runPointerScanAndWait(provider, req);
+    if (result.maxDepth == 0)   // never started: busy or refused
+        return makeTextResult(QStringLiteral("Pointer scan not started: %1")
+            .arg(panel->statusLabel()->text()), true);
+    const PointerScanStats stats = result.stats;
+    const int found = result.paths.size();
+    if (!intersectWith.isEmpty())
+        result = PointerScanResult::intersect(previous, result);
+
+    QString output = QStringLiteral("Pointer scan 0x%1 (depth <= %2, offset <= 0x%3): %4 paths")
+        .arg(QString::number(req.target, 16).toUpper()).arg(req.maxDepth)
+        .arg(QString::number(req.maxOffset, 16).toUpper()).arg(found);
+    if (stats.capped)
+        output += QStringLiteral(" — CAPPED at maxResults; lower maxDepth/maxOffset");
+    if (stats.aborted)
+        output += QStringLiteral(" — STOPPED early (aborted or timed out); paths are partial");
+    output += QStringLiteral("\n%1 pointers mapped in %2 ms, search %3 ms (%4 addresses expanded)\n")
+        .arg(stats.pointers).arg(stats.mapMs).arg(stats.searchMs).arg(stats.nodesExpanded);
+    if (!intersectWith.isEmpty())
+        output += QStringLiteral("Intersected with %1 saved paths: %2 kept\n")
+            .arg(previous.paths.size()).arg(result.paths.size());
+
+    for (int i = 0; i < result.paths.size() && i < limit; i++)
+        output += QStringLiteral("  %1\n").arg(result.paths[i].formula());
+    if (result.paths.size() > limit)
+        output += QStringLiteral("  ... %1 more\n").arg(result.paths.size() - limit);
+
+    const QString savePath = args.value("savePath").toString();
+    if (!savePath.isEmpty()) {
+        QFile f(savePath);
+        if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+            return makeTextResult(output + QStringLiteral("Cannot write '%1'").arg(savePath), true);
+        f.write(QJsonDocument(result.toJson()).toJson(QJsonDocument::Compact));
+        output += QStringLiteral("Saved %1 paths to %2\n").arg(result.paths.size()).arg(savePath);
+    }
+    return makeTextResult(output);
+}
+
 // ════════════════════════════════════════════════════════════════════
 // TOOL: analysis.find_overlaps — detect sibling-overlap bugs
 // ════════════════════════════════════════════════════════════════════
@@ -81,6 +81,9 @@ private:
     QJsonObject toolUiAction(const QJsonObject& args);
     QJsonObject toolTreeSearch(const QJsonObject& args);
     QJsonObject toolNodeHistory(const QJsonObject& args);
+    QJsonObject toolRecordStart(const QJsonObject& args);
+    QJsonObject toolRecordStop(const QJsonObject& args);
+    QJsonObject toolRecordQuery(const QJsonObject& args);
     QJsonObject toolScannerScan(const QJsonObject& args);
     QJsonObject toolScannerScanPattern(const QJsonObject& args);
     QJsonObject toolScannerRescan(const QJsonObject& args);
@@ -97,6 +100,7 @@ private:
     QJsonObject toolAnalysisInferTypes(const QJsonObject& args);
     QJsonObject toolAnalysisImportHeader(const QJsonObject& args);
     QJsonObject toolAnalysisPointerChain(const QJsonObject& args);
+    QJsonObject toolAnalysisPointerScan(const QJsonObject& args);
     QJsonObject toolAnalysisFindOverlaps(const QJsonObject& args);
     QJsonObject toolAnalysisFieldPath(const QJsonObject& args);
     QJsonObject toolAnalysisTreeSummary(const QJsonObject& args);
@@ -14,7 +14,7 @@ uint32_t BookmarkNameProvider::accent() const {
 }
 
 static uint64_t evaluateFormula(const QString& formula, const Provider* prov,
-                                int ptrSize) {
+                                int ptrSize, const SymbolStore::Snapshot& symbols) {
     AddressParserCallbacks cbs;
     if (prov) {
         cbs.resolveModule = [prov](const QString& name, bool* ok) -> uint64_t {
@@ -27,8 +27,8 @@ static uint64_t evaluateFormula(const QString& formula, const Provider* prov,
             *ok = prov->read(addr, &v, ptrSize);
             return v;
         };
-        cbs.resolveIdentifier = [prov](const QString& name, bool* ok) -> uint64_t {
-            return SymbolStore::instance().resolve(name, prov, ok);
+        cbs.resolveIdentifier = [prov, &symbols](const QString& name, bool* ok) -> uint64_t {
+            return symbols.resolve(name, prov, ok);
         };
     }
     auto result = AddressParser::evaluate(formula, ptrSize ? ptrSize : 8, &cbs);
@@ -41,16 +41,53 @@ QVector<NamedAddress> BookmarkNameProvider::entries(const Provider* active) cons
     if (!ctrl || !ctrl->document()) return out;
     const auto& bms = ctrl->document()->tree.bookmarks;
     int ptrSize = ctrl->document()->tree.pointerSize;
+    const auto symbols = SymbolStore::instance().snapshot();
     for (const auto& b : bms) {
         NamedAddress n;
         n.name = b.name;
-        n.address = evaluateFormula(b.addressFormula, active, ptrSize);
+        n.address = evaluateFormula(b.addressFormula, active, ptrSize, symbols);
         n.kind = QStringLiteral("bookmark");
         out.append(std::move(n));
     }
     return out;
 }
 
+// The bookmarks and symbols are snapshotted here; the formulas are
+// evaluated on the pool, keyed by bookmark index, each time the registry
+// probes. Spans follow whatever the latest probe found.
+NameProvider::SpanJob BookmarkNameProvider::spanJob(const Provider* /*active*/) const {
+    SpanJob job;
+    auto* ctrl = m_fn ? m_fn() : nullptr;
+    QVector<Bookmark> bms;
+    int ptrSize = 8;
+    if (ctrl && ctrl->document()) {
+        bms = ctrl->document()->tree.bookmarks;
+        ptrSize = ctrl->document()->tree.pointerSize;
+    }
+    job.bases = [bms, ptrSize, symbols = SymbolStore::instance().snapshot()](const Provider* prov) {
+        QHash<QString, uint64_t> addrs;
+        for (int i = 0; i < bms.size(); ++i)
+            addrs.insert(QString::number(i),
+                         evaluateFormula(bms[i].addressFormula, prov, ptrSize, symbols));
+        return addrs;
+    };
+    job.spans = [bms](const Provider*, const QHash<QString, uint64_t>& addrs) {
+        QVector<NameSpan> out;
+        for (int i = 0; i < bms.size(); ++i) {
+            const Bookmark& b = bms[i];
+            const uint64_t a = addrs.value(QString::number(i));
+            if (a == 0 || b.name.isEmpty()) continue;
+            NameSpan s;
+            s.lo = a;
+            s.hi = a + 1;
+            s.name = b.name;
+            out.append(std::move(s));
+        }
+        return out;
+    };
+    return job;
+}
+
 bool BookmarkNameProvider::add(const QString& name, uint64_t address) {
     auto* ctrl = m_fn ? m_fn() : nullptr;
     if (!ctrl) return false;
@@ -26,6 +26,10 @@ public:
     uint32_t accent() const override;
 
     QVector<NamedAddress> entries(const Provider* active) const override;
+    // Formulas can dereference live memory, so their evaluation is the
+    // job's base probe: NameRegistry rechecks it and rebuilds when a
+    // bookmark's address moves.
+    SpanJob spanJob(const Provider* active) const override;
     bool supportsAdd() const override { return true; }
     bool add(const QString& name, uint64_t address) override;
     bool supportsRemove() const override { return true; }
@@ -0,0 +1,145 @@
+#include "elf_name_provider.h"
+#include "name_registry.h"
+#include "symbol_demangle.h"
+#include "imports/elf_symbols.h"
+#include "providers/provider.h"
+#include "themes/thememanager.h"
+#include <QColor>
+#include <QMutexLocker>
+#include <QtConcurrent/QtConcurrentRun>
+#include <algorithm>
+#include <cstring>
+
+namespace rcx {
+
+ElfNameProvider::ElfNameProvider() : m_state(std::make_shared<State>()) {}
+
+uint32_t ElfNameProvider::accent() const {
+    return ThemeManager::instance().current().syntaxPreproc.rgba();
+}
+
+int ElfNameProvider::loadedCount() const {
+    QMutexLocker lock(&m_state->lock);
+    int n = 0;
+    for (const auto& t : m_state->tables)
+        if (t) ++n;
+    return n;
+}
+
+QVector<ElfNameProvider::Module> ElfNameProvider::modules(const Provider* active) const {
+    QVector<Module> out;
+    if (!active) return out;
+    QStringList queue;
+    {
+        QMutexLocker lock(&m_state->lock);
+        for (const auto& m : active->modulesCached()) {
+            if (m.fullPath.isEmpty()) continue;
+            auto it = m_state->tables.constFind(m.fullPath);
+            if (it == m_state->tables.constEnd()) {
+                m_state->tables.insert(m.fullPath, nullptr);
+                queue.append(m.fullPath);
+            } else if (*it) {
+                out.append({m.name, m.base, *it});
+            }
+        }
+    }
+    if (queue.isEmpty()) return out;
+
+    // One job per batch: a fresh attach queues every module at once, and a
+    // single registry nudge at the end means a single index rebuild.
+    QFuture<void> job = QtConcurrent::run([state = m_state, queue]() {
+        bool any = false;
+        for (const QString& path : queue) {
+            auto syms = loadElfSymbols(path);
+            if (syms && syms->syms.empty()) syms.reset();   // stripped
+            any |= bool(syms);
+            QMutexLocker lock(&state->lock);
+            state->tables.insert(path, std::move(syms));
+        }
+        if (any)
+            QMetaObject::invokeMethod(&NameRegistry::instance(), []() {
+                NameRegistry::instance().emitChanged();
+            }, Qt::QueuedConnection);
+    });
+    Q_UNUSED(job);
+    return out;
+}
+
+QVector<NamedAddress> ElfNameProvider::entries(const Provider* active) const {
+    QVector<NamedAddress> out;
+    for (const Module& m : modules(active)) {
+        const ElfSymbols& t = *m.syms;
+        out.reserve(out.size() + int(t.syms.size()));
+        for (int i = 0; i < int(t.syms.size()); ++i) {
+            NamedAddress n;
+            n.name = t.nameStringAt(i);
+            n.displayName = humanizeSymbolName(n.name);
+            n.address = m.base + t.syms[size_t(i)].rva;
+            n.size = t.syms[size_t(i)].size;
+            n.kind = QStringLiteral("symbol");
+            n.meta = m.name;
+            out.append(std::move(n));
+        }
+    }
+    return out;
+}
+
+// "module!symbol" or "module!symbol+0xN" within the symbol's st_size,
+// matching the PDB provider's format so tooltips read the same on both.
+QString ElfNameProvider::nameFor(uint64_t addr, const Provider* active) const {
+    if (addr == 0) return {};
+    for (const Module& m : modules(active)) {
+        if (addr < m.base) continue;
+        const int i = m.syms->find(addr - m.base);
+        if (i < 0) continue;
+        const QString sym = m.syms->nameStringAt(i);
+        const QString human = humanizeSymbolName(sym);
+        QString out = m.name + QLatin1Char('!') + (human.isEmpty() ? sym : human);
+        const uint64_t disp = addr - m.base - m.syms->syms[size_t(i)].rva;
+        if (disp) out += QStringLiteral("+0x") + QString::number(disp, 16);
+        return out;
+    }
+    return {};
+}
+
+// The module list is snapshotted here with each table's shared_ptr; the
+// "module!symbol" names are built on the pool. Bases come from that list
+// and can't move under one Provider, so there's no base probe.
+NameProvider::SpanJob ElfNameProvider::spanJob(const Provider* active) const {
+    SpanJob job;
+    job.spans = [mods = modules(active)](const Provider*, const QHash<QString, uint64_t>&) {
+        QVector<NameSpan> out;
+        for (const Module& m : mods) {
+            out.reserve(out.size() + int(m.syms->syms.size()));
+            for (int i = 0; i < int(m.syms->syms.size()); ++i) {
+                const auto& s = m.syms->syms[size_t(i)];
+                NameSpan span;
+                span.lo = m.base + s.rva;
+                span.hi = span.lo + std::max<uint64_t>(s.size, 1);
+                span.name = m.name + QLatin1Char('!') + m.syms->nameStringAt(i);
+                span.withOffset = true;
+                span.humanize = true;
+                out.append(std::move(span));
+            }
+        }
+        return out;
+    };
+    return job;
+}
+
+// Accepts "module!symbol" or a bare symbol (first module that has it).
+uint64_t ElfNameProvider::addressFor(const QString& name, const Provider* active) const {
+    if (name.isEmpty()) return 0;
+    const int bang = name.indexOf(QLatin1Char('!'));
+    const QString module = bang < 0 ? QString() : name.left(bang);
+    const QByteArray sym = (bang < 0 ? name : name.mid(bang + 1)).toUtf8();
+    for (const Module& m : modules(active)) {
+        if (!module.isEmpty() && m.name.compare(module, Qt::CaseInsensitive) != 0) continue;
+        for (int i = 0; i < int(m.syms->syms.size()); ++i)
+            if (std::strcmp(m.syms->nameAt(i), sym.constData()) == 0)
+                return m.base + m.syms->syms[size_t(i)].rva;
+    }
+    return 0;
+}
+
+} // namespace rcx
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "name_provider.h"
+#include <QHash>
+#include <QMutex>
+#include <memory>
+
+namespace rcx {
+
+struct ElfSymbols;
+
+// .symtab / .dynsym names for the ELF modules of the active target — the
+// Linux counterpart of PdbNameProvider, which never applies to ELF.
+//
+// Tables are loaded lazily: the first call that sees a module path it
+// hasn't met (NameRegistry's index build or the Symbols panel, right after
+// attach) queues it for a pool thread that maps the file and builds a
+// sorted RVA index. When the batch lands the registry is nudged, so the
+// names appear without anyone waiting on a parse. Addresses are
+// module base (from the active provider's module list) + RVA, so a table
+// stays valid across re-attaches and ASLR.
+class ElfNameProvider : public NameProvider {
+public:
+    ElfNameProvider();
+
+    QString id() const override { return QStringLiteral("elf-symbols"); }
+    QString displayName() const override { return QStringLiteral("ELF Symbols"); }
+    uint32_t accent() const override;
+
+    QVector<NamedAddress> entries(const Provider* active) const override;
+    QString  nameFor(uint64_t addr, const Provider* active) const override;
+    SpanJob  spanJob(const Provider* active) const override;
+    uint64_t addressFor(const QString& name, const Provider* active) const override;
+
+    // Tables loaded so far, keyed by module path; for tests.
+    int loadedCount() const;
+
+private:
+    struct Module {
+        QString  name;      // "libc.so.6"
+        uint64_t base = 0;
+        std::shared_ptr<const ElfSymbols> syms;
+    };
+    // Active modules with a loaded table; queues loads for the rest.
+    QVector<Module> modules(const Provider* active) const;
+
+    // Shared with the loader jobs, which may outlive the provider.
+    struct State {
+        QMutex lock;
+        // nullptr while queued, or for files that aren't readable ELF
+        QHash<QString, std::shared_ptr<const ElfSymbols>> tables;
+    };
+    std::shared_ptr<State> m_state;
+};
+
+} // namespace rcx
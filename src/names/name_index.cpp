@@ -0,0 +1,87 @@
+#include "name_index.h"
+#include <algorithm>
+#include <queue>
+
+namespace rcx {
+
+// "module!mangled" → "module!readable"; the raw name when `fn` has no
+// better form.
+static QString humanizedName(const QString& name, NameIndex::HumanizeFn fn) {
+    const int bang = name.indexOf(QLatin1Char('!'));
+    const QString sym = bang < 0 ? name : name.mid(bang + 1);
+    const QString h = fn(sym);
+    if (h.isEmpty()) return name;
+    return bang < 0 ? h : name.left(bang + 1) + h;
+}
+
+std::shared_ptr<const NameIndex> NameIndex::build(
+        const QVector<QVector<NameSpan>>& spansByRank, HumanizeFn humanize) {
+    auto idx = std::make_shared<NameIndex>();
+
+    struct Iv { uint64_t lo, hi; int rank; int entry; };
+    std::vector<Iv> ivs;
+    int total = 0;
+    for (const auto& spans : spansByRank) total += int(spans.size());
+    ivs.reserve(size_t(total));
+    idx->m_entries.reserve(total);
+
+    for (int r = 0; r < spansByRank.size(); ++r) {
+        for (const NameSpan& s : spansByRank[r]) {
+            if (s.hi <= s.lo || s.name.isEmpty()) continue;
+            Entry e;
+            e.addr = s.lo;
+            e.withOffset = s.withOffset;
+            e.name = (s.humanize && humanize) ? humanizedName(s.name, humanize) : s.name;
+            ivs.push_back({s.lo, s.hi, r, int(idx->m_entries.size())});
+            idx->m_entries.append(std::move(e));
+        }
+    }
+    std::sort(ivs.begin(), ivs.end(), [](const Iv& a, const Iv& b) {
+        return a.lo != b.lo ? a.lo < b.lo : a.rank < b.rank;
+    });
+
+    // Sweep the starts in order with the live spans in a heap whose top is
+    // the winner: lowest rank, then the latest start. Each step emits one
+    // segment up to the winner's end or the next start, whichever is
+    // first; spans that ended are dropped lazily as they reach the top.
+    auto loses = [&ivs](int a, int b) {
+        if (ivs[a].rank != ivs[b].rank) return ivs[a].rank > ivs[b].rank;
+        if (ivs[a].lo != ivs[b].lo) return ivs[a].lo < ivs[b].lo;
+        return ivs[a].entry > ivs[b].entry;   // same start: the first listed
+    };
+    std::priority_queue<int, std::vector<int>, decltype(loses)> live(loses);
+    size_t next = 0;
+    uint64_t cur = 0;
+    while (next < ivs.size() || !live.empty()) {
+        if (live.empty()) cur = ivs[next].lo;
+        while (next < ivs.size() && ivs[next].lo <= cur) live.push(int(next++));
+        while (!live.empty() && ivs[live.top()].hi <= cur) live.pop();
+        if (live.empty()) continue;
+
+        const Iv& win = ivs[live.top()];
+        uint64_t end = win.hi;
+        if (next < ivs.size() && ivs[next].lo < end) end = ivs[next].lo;
+        if (!idx->m_lo.empty() && idx->m_hi.back() == cur
+            && idx->m_entry.back() == win.entry) {
+            idx->m_hi.back() = end;
+        } else {
+            idx->m_lo.push_back(cur);
+            idx->m_hi.push_back(end);
+            idx->m_entry.push_back(win.entry);
+        }
+        cur = end;
+    }
+    return idx;
+}
+
+QString NameIndex::nameFor(uint64_t addr) const {
+    auto it = std::upper_bound(m_lo.begin(), m_lo.end(), addr);
+    if (it == m_lo.begin()) return {};
+    const size_t seg = size_t(it - m_lo.begin()) - 1;
+    if (addr >= m_hi[seg]) return {};
+    const Entry& e = m_entries[m_entry[seg]];
+    if (!e.withOffset || addr == e.addr) return e.name;
+    return e.name + QStringLiteral("+0x") + QString::number(addr - e.addr, 16);
+}
+
+} // namespace rcx
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace rcx {
+
+// An address range a NameProvider answers reverse lookups for with one
+// name. An exact-match entry is a one-byte span; a symbol that also names
+// the bytes after it ("module!Func+0x12") spans up to the next symbol.
+struct NameSpan {
+    uint64_t lo = 0;          // first address (the symbol's own address)
+    uint64_t hi = 0;          // one past the last address
+    QString  name;
+    bool     withOffset = false;   // past `lo`, answer "name+0xN"
+    bool     humanize   = false;   // demangle the part after "module!" at build
+};
+
+// Immutable, sorted address → name index over several providers' spans.
+//
+// build() resolves overlaps once: a lower rank (earlier provider) wins,
+// and within one rank the span starting closest below the address wins
+// (the first listed, for equal starts).
+// The result is a flat array of disjoint segments, so nameFor() is one
+// binary search with no locks — the index never changes once built, and
+// owners publish a new one by swapping a shared_ptr.
+class NameIndex {
+public:
+    using HumanizeFn = QString (*)(const QString&);
+
+    // spansByRank[r] holds rank r's spans. `humanize` is applied to spans
+    // marked so (returning empty keeps the raw name). Safe to call off the
+    // GUI thread: it only touches its arguments.
+    static std::shared_ptr<const NameIndex> build(
+        const QVector<QVector<NameSpan>>& spansByRank, HumanizeFn humanize = nullptr);
+
+    QString nameFor(uint64_t addr) const;
+
+    int  segmentCount() const { return int(m_lo.size()); }
+    bool isEmpty() const { return m_lo.empty(); }
+
+private:
+    struct Entry {
+        uint64_t addr = 0;
+        QString  name;
+        bool     withOffset = false;
+    };
+    std::vector<uint64_t> m_lo;      // segment starts, ascending
+    std::vector<uint64_t> m_hi;      // segment ends (exclusive)
+    std::vector<int>      m_entry;   // segment → m_entries
+    QVector<Entry>        m_entries;
+};
+
+} // namespace rcx
@@ -9,6 +9,28 @@ QString NameProvider::nameFor(uint64_t addr, const Provider* active) const {
     return {};
 }
 
+NameProvider::SpanJob NameProvider::spanJob(const Provider* active) const {
+    SpanJob job;
+    job.spans = [list = entries(active)](const Provider*, const QHash<QString, uint64_t>&) {
+        QVector<NameSpan> out;
+        for (const auto& e : list) {
+            if (e.address == 0 || e.name.isEmpty()) continue;
+            NameSpan s;
+            s.lo = e.address;
+            s.hi = e.address + 1;
+            s.name = e.name;
+            out.append(std::move(s));
+        }
+        return out;
+    };
+    return job;
+}
+
+QVector<NameSpan> NameProvider::nameSpans(const Provider* active) const {
+    const SpanJob job = spanJob(active);
+    return job.spans(active, job.bases ? job.bases(active) : QHash<QString, uint64_t>());
+}
+
 uint64_t NameProvider::addressFor(const QString& name, const Provider* active) const {
     if (name.isEmpty()) return 0;
     for (const auto& e : entries(active))
@@ -1,8 +1,11 @@
 #pragma once
 
+#include "name_index.h"
+#include <QHash>
 #include <QString>
 #include <QVector>
 #include <cstdint>
+#include <functional>
 
 namespace rcx {
 
@@ -64,6 +67,28 @@ public:
     virtual QString  nameFor(uint64_t addr, const Provider* active) const;
     virtual uint64_t addressFor(const QString& name, const Provider* active) const;
 
+    // The address ranges nameFor() answers, for NameRegistry's shared
+    // index, as work for a pool thread. spanJob() itself runs on the GUI
+    // thread and should only take a snapshot (implicitly shared copies);
+    // module-base lookups and building names belong in the functions,
+    // which may read `active` but must not touch GUI state. NameIndex::build
+    // then sorts and demangles on the same pool thread.
+    struct SpanJob {
+        // The live addresses the spans are laid out at — module bases by
+        // module name, a bookmark formula's current target — far cheaper
+        // than spans(), so the registry reruns it to notice one moving.
+        // Unset when the spans don't depend on live memory.
+        std::function<QHash<QString, uint64_t>(const Provider* active)> bases;
+        std::function<QVector<NameSpan>(const Provider* active,
+                                        const QHash<QString, uint64_t>& bases)> spans;
+    };
+    // Default: a one-byte span per entries() address, matching the default
+    // nameFor(); entries() is read here. Override alongside a custom nameFor().
+    virtual SpanJob spanJob(const Provider* active) const;
+
+    // spanJob() run to completion on the calling thread.
+    QVector<NameSpan> nameSpans(const Provider* active) const;
+
     // Write API. Returns true if this provider can persist a user-created
     // entry (BookmarkNameProvider does; PDB/RTTI providers do not).
     virtual bool supportsAdd() const { return false; }
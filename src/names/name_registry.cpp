@@ -1,4 +1,6 @@
 #include "name_registry.h"
+#include "symbol_demangle.h"
+#include <QtConcurrent/QtConcurrentRun>
 
 namespace rcx {
 
@@ -7,6 +9,12 @@ NameRegistry& NameRegistry::instance() {
     return r;
 }
 
+NameRegistry::NameRegistry() {
+    // Any provider change makes every index stale; the next lookup for a
+    // source falls back to asking providers directly and starts a rebuild.
+    connect(this, &NameRegistry::providersChanged, this, [this]() { ++m_indexGen; });
+}
+
 void NameRegistry::registerProvider(std::shared_ptr<NameProvider> p) {
     if (!p) return;
     // Replace if a provider with the same id already exists (idempotent).
@@ -32,10 +40,17 @@ void NameRegistry::unregisterProvider(const QString& id) {
     }
 }
 
-QString NameRegistry::nameFor(uint64_t addr, const Provider* active) const {
+QString NameRegistry::nameFor(uint64_t addr, const std::shared_ptr<Provider>& active) const {
     if (addr == 0) return {};
+    IndexSlot& slot = indexSlot(active);
+    if (slot.index && slot.builtGen == m_indexGen) {
+        if (slot.checked.hasExpired(kBaseRecheckMs))
+            probeBases(active, slot);
+        return slot.index->nameFor(addr);
+    }
+    scheduleIndexBuild(active, slot);
     for (const auto& p : m_providers) {
-        QString s = p->nameFor(addr, active);
+        QString s = p->nameFor(addr, active.get());
         if (!s.isEmpty()) return s;
     }
     return {};
@@ -50,6 +65,89 @@ uint64_t NameRegistry::addressFor(const QString& name, const Provider* active) c
     return 0;
 }
 
+bool NameRegistry::indexReadyFor(const Provider* active) const {
+    const auto it = m_indexes.constFind(active);
+    return it != m_indexes.cend() && (*it)->index && (*it)->builtGen == m_indexGen;
+}
+
+bool NameRegistry::indexBuilding(const Provider* active) const {
+    const auto it = m_indexes.constFind(active);
+    return it != m_indexes.cend() && (*it)->watcher && (*it)->watcher->isRunning();
+}
+
+NameRegistry::IndexSlot& NameRegistry::indexSlot(const std::shared_ptr<Provider>& active) const {
+    auto it = m_indexes.find(active.get());
+    if (it != m_indexes.end() && (!active || !(*it)->provider.expired()))
+        return **it;
+    // New source, or a freed one's address reused: drop every slot whose
+    // provider is gone while we're at it.
+    for (auto d = m_indexes.begin(); d != m_indexes.end();) {
+        if (d.key() && (*d)->provider.expired()) d = m_indexes.erase(d);
+        else ++d;
+    }
+    auto slot = std::make_shared<IndexSlot>();
+    slot->provider = active;
+    m_indexes.insert(active.get(), slot);
+    return *slot;
+}
+
+void NameRegistry::scheduleIndexBuild(const std::shared_ptr<Provider>& active,
+                                      IndexSlot& slot) const {
+    // A build for an older generation finishes first; the lookup after it
+    // sees the mismatch and schedules again.
+    if (slot.watcher && slot.watcher->isRunning()) return;
+    slot.pendingJobs.clear();
+    slot.pendingJobs.reserve(m_providers.size());
+    for (const auto& p : m_providers)
+        slot.pendingJobs.append(p->spanJob(active.get()));
+    slot.pendingGen = m_indexGen;
+    startJob(active, slot, false);
+}
+
+void NameRegistry::probeBases(const std::shared_ptr<Provider>& active, IndexSlot& slot) const {
+    if (slot.watcher && slot.watcher->isRunning()) return;
+    slot.pendingJobs = slot.jobs;
+    slot.pendingGen = slot.builtGen;
+    startJob(active, slot, true);
+}
+
+void NameRegistry::startJob(const std::shared_ptr<Provider>& active, IndexSlot& slot,
+                            bool probe) const {
+    slot.checked.start();
+    if (!slot.watcher) {
+        slot.watcher = std::make_unique<QFutureWatcher<BuiltIndex>>();
+        IndexSlot* s = &slot;   // the slot owns the watcher, so outlives it
+        connect(slot.watcher.get(), &QFutureWatcherBase::finished,
+                this, [this, s]() { onIndexBuilt(*s); });
+    }
+    const auto old = probe ? slot.bases : QVector<QHash<QString, uint64_t>>();
+    slot.watcher->setFuture(QtConcurrent::run(
+        [active, jobs = slot.pendingJobs, old, probe]() {
+            BuiltIndex out;
+            out.bases.reserve(jobs.size());
+            for (const auto& job : jobs)
+                out.bases.append(job.bases ? job.bases(active.get())
+                                           : QHash<QString, uint64_t>());
+            if (probe && out.bases == old) return out;
+            QVector<QVector<NameSpan>> spans;
+            spans.reserve(jobs.size());
+            for (int i = 0; i < jobs.size(); ++i)
+                spans.append(jobs[i].spans(active.get(), out.bases[i]));
+            out.index = NameIndex::build(spans, &humanizeSymbolName);
+            return out;
+        }));
+}
+
+void NameRegistry::onIndexBuilt(IndexSlot& slot) const {
+    BuiltIndex built = slot.watcher->result();
+    if (!built.index) return;   // a probe that found every base in place
+    slot.index = std::move(built.index);
+    slot.bases = std::move(built.bases);
+    slot.jobs = std::move(slot.pendingJobs);
+    slot.builtGen = slot.pendingGen;
+    slot.pendingJobs.clear();
+}
+
 void NameRegistry::emitChanged() {
     emit providersChanged();
 }
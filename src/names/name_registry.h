@@ -1,6 +1,10 @@
 #pragma once
 
 #include "name_provider.h"
+#include "name_index.h"
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QHash>
 #include <QObject>
 #include <QVector>
 #include <memory>
@@ -26,19 +30,64 @@ public:
     // Aggregated reverse lookup over every registered provider, in
     // registration order. First non-empty answer wins. Used by status
     // bar / tooltips / expression parser.
-    QString  nameFor(uint64_t addr, const Provider* active) const;
+    //
+    // Answered from a NameIndex of every provider's spans, one per data
+    // source so tabs on different targets don't evict each other. Until
+    // `active`'s index exists (and after providersChanged) each provider is
+    // asked in turn while it builds in the background; the build holds a
+    // reference to `active`. GUI thread only.
+    QString  nameFor(uint64_t addr, const std::shared_ptr<Provider>& active) const;
     uint64_t addressFor(const QString& name, const Provider* active) const;
 
     // Providers call this when their underlying data shifts so listeners
     // (e.g. the Symbols panel) can refresh.
     void emitChanged();
 
+    // Index state, for tests and diagnostics.
+    bool indexReadyFor(const Provider* active) const;
+    bool indexBuilding(const Provider* active) const;
+
 signals:
     void providersChanged();
 
 private:
-    NameRegistry() = default;
+    NameRegistry();
+
+    // What a pool job hands back: the module bases each provider's spans
+    // were laid out at and the index over them. `index` is null when a
+    // base probe found nothing moved.
+    struct BuiltIndex {
+        std::shared_ptr<const NameIndex>  index;
+        QVector<QHash<QString, uint64_t>> bases;   // by provider rank
+    };
+    // One data source's index. Only providersChanged or a module base
+    // moving rebuilds it; the bases are probed on the pool at most every
+    // kBaseRecheckMs, reusing the snapshot jobs the index was built from.
+    struct IndexSlot {
+        std::weak_ptr<Provider>            provider;   // expired: key reused, start over
+        std::shared_ptr<const NameIndex>   index;
+        QVector<QHash<QString, uint64_t>>  bases;      // ...as `index` was built
+        QVector<NameProvider::SpanJob>     jobs;       // ...by these
+        quint64                            builtGen = 0;
+        QVector<NameProvider::SpanJob>     pendingJobs;
+        quint64                            pendingGen = 0;
+        QElapsedTimer                      checked;
+        std::unique_ptr<QFutureWatcher<BuiltIndex>> watcher;
+    };
+    static constexpr int kBaseRecheckMs = 1000;
+
+    IndexSlot& indexSlot(const std::shared_ptr<Provider>& active) const;
+    // Spans are snapshotted here on the GUI thread (spanJob()); the base
+    // lookups, span building, sort and demangling run on the pool.
+    void scheduleIndexBuild(const std::shared_ptr<Provider>& active, IndexSlot& slot) const;
+    void probeBases(const std::shared_ptr<Provider>& active, IndexSlot& slot) const;
+    void startJob(const std::shared_ptr<Provider>& active, IndexSlot& slot, bool probe) const;
+    void onIndexBuilt(IndexSlot& slot) const;
+
     QVector<std::shared_ptr<NameProvider>> m_providers;
+
+    mutable QHash<const Provider*, std::shared_ptr<IndexSlot>> m_indexes;
+    mutable quint64 m_indexGen = 0;   // bumped by providersChanged
 };
 
 } // namespace rcx
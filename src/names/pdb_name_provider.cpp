@@ -80,6 +80,21 @@ QString PdbNameProvider::nameFor(uint64_t addr, const Provider* active) const {
     return prefix + (humanized.isEmpty() ? sym : humanized) + suffix;
 }
 
+// Same spans SymbolStore's own index uses, marked for demangling so the
+// registry's index answers what nameFor() would. Module bases are what
+// moves under a live target, so they're the job's base probe.
+NameProvider::SpanJob PdbNameProvider::spanJob(const Provider* /*active*/) const {
+    SpanJob job;
+    const auto modules = SymbolStore::instance().modulesSnapshot();
+    job.bases = [modules](const Provider* prov) {
+        return prov ? SymbolStore::moduleBases(modules, prov) : QHash<QString, uint64_t>();
+    };
+    job.spans = [modules](const Provider*, const QHash<QString, uint64_t>& bases) {
+        return SymbolStore::spansAt(modules, bases, /*humanize=*/true);
+    };
+    return job;
+}
+
 uint64_t PdbNameProvider::addressFor(const QString& name, const Provider* active) const {
     // Try the qualified form first ("module!symbol") then bare symbol via
     // SymbolStore's own resolver, which does the same work and accepts both.
@@ -15,6 +15,7 @@ public:
 
     QVector<NamedAddress> entries(const Provider* active) const override;
     QString  nameFor(uint64_t addr, const Provider* active) const override;
+    SpanJob  spanJob(const Provider* active) const override;
     uint64_t addressFor(const QString& name, const Provider* active) const override;
 };
 
@@ -2,6 +2,7 @@
 #include "rtti.h"  // demangleRttiName + demangleItaniumName
 
 #ifdef Q_OS_WIN
+#  include <QMutex>
 #  include <windows.h>
 #  include <dbghelp.h>
 #endif
@@ -35,6 +36,10 @@ QString humanizeSymbolName(const QString& mangled) {
     if (!trimmed.startsWith(QLatin1Char('?'))) return {};
     QByteArray utf8 = trimmed.toUtf8();
     char buf[2048];
+    // DbgHelp is single-threaded, and NameRegistry demangles while it
+    // builds its index on a pool thread.
+    static QMutex dbghelpLock;
+    QMutexLocker lock(&dbghelpLock);
     const DWORD flags = UNDNAME_NAME_ONLY
                       | UNDNAME_NO_ACCESS_SPECIFIERS
                       | UNDNAME_NO_THISTYPE
@@ -91,6 +91,23 @@ OptionsDialog::OptionsDialog(const OptionsResult& current, QWidget* parent)
     refreshDesc->setContentsMargins(0, 0, 0, 0);
     refreshLayout->addRow(refreshDesc);
 
+    m_samplerSpin = new QSpinBox;
+    m_samplerSpin->setRange(0, 10000);
+    m_samplerSpin->setSingleStep(100);
+    m_samplerSpin->setValue(current.samplerHz);
+    m_samplerSpin->setSuffix(" Hz");
+    m_samplerSpin->setSpecialValueText("Off");
+    m_samplerSpin->setObjectName("samplerSpin");
+    refreshLayout->addRow("Sampler:", m_samplerSpin);
+
+    auto* samplerDesc = new QLabel(
+        "Reads live memory on a background thread at this fixed rate. The view still "
+        "updates on the interval above, but change highlighting and value history see "
+        "every sample. Default: Off.");
+    samplerDesc->setWordWrap(true);
+    samplerDesc->setContentsMargins(0, 0, 0, 0);
+    refreshLayout->addRow(samplerDesc);
+
     generalLayout->addWidget(refreshGroup);
 
     // Visual Experience group box
@@ -227,6 +244,7 @@ OptionsResult OptionsDialog::result() const {
     r.showIcon = m_showIconCheck->isChecked();
     r.autoStartMcp = m_autoMcpCheck->isChecked();
     r.refreshMs = m_refreshSpin->value();
+    r.samplerHz = m_samplerSpin->value();
     r.generatorAsserts = m_assertCheck->isChecked();
     r.braceWrap = m_braceWrapCheck->isChecked();
     return r;
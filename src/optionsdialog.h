@@ -17,6 +17,7 @@ struct OptionsResult {
     bool    showIcon = false;
     bool    autoStartMcp = true;
     int     refreshMs = 660;
+    int     samplerHz = 0;     // 0 = sample on the refresh interval
     bool    generatorAsserts = false;
     bool    braceWrap = false;
 };
@@ -42,6 +43,7 @@ private:
     QCheckBox*      m_showIconCheck  = nullptr;
     QCheckBox*      m_autoMcpCheck   = nullptr;
     QSpinBox*       m_refreshSpin    = nullptr;
+    QSpinBox*       m_samplerSpin    = nullptr;
     QCheckBox*      m_assertCheck    = nullptr;
     QCheckBox*      m_braceWrapCheck = nullptr;
 
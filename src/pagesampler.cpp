@@ -0,0 +1,154 @@
+#include "pagesampler.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QMutexLocker>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace rcx {
+
+namespace {
+
+constexpr uint64_t kPageSize = 4096;
+
+// Copy [addr, addr+len) out of a page map; false when a page is missing.
+bool readFromPages(const PageSampler::PageMap& pages, uint64_t addr, int len,
+                   QByteArray& out) {
+    out.resize(len);
+    char* dst = out.data();
+    while (len > 0) {
+        const uint64_t page = addr & ~(kPageSize - 1);
+        auto it = pages.constFind(page);
+        if (it == pages.constEnd()) return false;
+        const int off = int(addr - page);
+        const int chunk = qMin(len, int(kPageSize) - off);
+        if (off + chunk > it->size()) return false;
+        memcpy(dst, it->constData() + off, size_t(chunk));
+        dst += chunk;
+        addr += uint64_t(chunk);
+        len -= chunk;
+    }
+    return true;
+}
+
+} // namespace
+
+PageSampler::PageSampler(std::shared_ptr<Provider> prov, int hz)
+    : m_prov(std::move(prov))
+    , m_hz(qBound(1, hz, kMaxHz))
+{
+    m_thread = std::thread([this]() { run(); });
+}
+
+PageSampler::~PageSampler() {
+    m_stop.store(true, std::memory_order_relaxed);
+    if (m_thread.joinable()) m_thread.join();
+}
+
+void PageSampler::setTarget(QVector<uint64_t> pages, QVector<Watch> watches) {
+    std::sort(pages.begin(), pages.end());
+    QMutexLocker lock(&m_targetMutex);
+    if (pages == m_targetPages && watches == m_targetWatches) return;
+    m_targetPages = std::move(pages);
+    m_targetWatches = std::move(watches);
+    m_targetGen.fetch_add(1, std::memory_order_release);
+}
+
+void PageSampler::setPassHook(PassHook hook) {
+    QMutexLocker lock(&m_hookMutex);
+    m_hook.swap(hook);
+}
+
+void PageSampler::run() {
+    using Clock = std::chrono::steady_clock;
+    const auto period = std::chrono::microseconds(1000000 / m_hz);
+    const qint64 epochUs = QDateTime::currentMSecsSinceEpoch() * 1000;
+    const auto start = Clock::now();
+    auto next = start;
+    while (!m_stop.load(std::memory_order_relaxed)) {
+        const auto now = Clock::now();
+        pass(epochUs + std::chrono::duration_cast<std::chrono::microseconds>(now - start).count());
+        // A pass that overran its slot starts the next one immediately
+        // instead of bursting to catch up.
+        next += period;
+        if (next < now) next = now;
+        std::this_thread::sleep_until(next);
+    }
+}
+
+void PageSampler::pass(qint64 timeUs) {
+    const quint64 gen = m_targetGen.load(std::memory_order_acquire);
+    if (gen != m_seenGen) {
+        QMutexLocker lock(&m_targetMutex);
+        m_seenGen = m_targetGen.load(std::memory_order_relaxed);
+        // A watch that moved or resized starts a new value sequence.
+        QHash<uint64_t, QByteArray> kept;
+        for (const Watch& w : m_targetWatches) {
+            auto it = m_lastWatch.constFind(w.key);
+            if (it != m_lastWatch.constEnd() && m_watches.contains(w))
+                kept.insert(w.key, *it);
+        }
+        m_lastWatch.swap(kept);
+        m_pages = m_targetPages;
+        m_watches = m_targetWatches;
+    }
+    if (m_pages.isEmpty()) return;
+
+    PageMap fresh;
+    try {
+        fresh = readPagesCoalesced(*m_prov, m_pages);
+    } catch (const std::exception& e) {
+        qWarning() << "[Sampler] read threw:" << e.what();
+        return;
+    } catch (...) {
+        qWarning() << "[Sampler] read threw unknown exception";
+        return;
+    }
+
+    {
+        QMutexLocker lock(&m_hookMutex);
+        if (m_hook) m_hook(SnapshotProvider(nullptr, fresh, 0), timeUs);
+    }
+
+    // The UI took the last frame: it has seen everything folded so far.
+    if (!m_frames.hasFresh()) {
+        m_accChanged.clear();
+        m_accWatches.clear();
+        m_accPasses = 0;
+    }
+
+    ++m_seq;
+    for (auto it = fresh.constBegin(); it != fresh.constEnd(); ++it) {
+        auto old = m_prev.constFind(it.key());
+        if (old == m_prev.constEnd()) continue;
+        diffPageInto(m_accChanged, it.key(), old->constData(), it->constData(),
+                     qMin(old->size(), it->size()));
+    }
+
+    QByteArray value;
+    for (const Watch& w : m_watches) {
+        if (w.len <= 0 || !readFromPages(fresh, w.addr, w.len, value)) continue;
+        auto last = m_lastWatch.find(w.key);
+        if (last != m_lastWatch.end() && *last == value) continue;
+        auto& seq = m_accWatches[w.key];
+        if (seq.size() >= kMaxWatchSamples) seq.removeFirst();
+        seq.append({m_seq, timeUs, w.addr, value});
+        if (last != m_lastWatch.end()) *last = value;
+        else m_lastWatch.insert(w.key, value);
+    }
+    ++m_accPasses;
+    m_prev = fresh;
+
+    Frame& f = m_frames.back();
+    f.seq = m_seq;
+    f.timeUs = timeUs;
+    f.passes = m_accPasses;
+    f.pages = std::move(fresh);
+    f.changed = m_accChanged;
+    f.watches = m_accWatches;
+    m_frames.publish();
+    m_passCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace rcx
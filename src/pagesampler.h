@@ -0,0 +1,123 @@
+#pragma once
+#include "providers/snapshot_provider.h"
+#include "diffutil.h"
+#include "triplebuffer.h"
+#include <QMutex>
+#include <QVector>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+
+namespace rcx {
+
+// ── Fixed-rate page sampler ──
+//
+// Live refresh normally reads on the UI timer, so the sample rate is
+// whatever the UI thread can sustain. A PageSampler owns a thread that
+// reads the controller's page set at a fixed rate instead and publishes
+// each pass through a TripleBuffer: the UI takes only the newest frame,
+// on its own schedule, and never blocks the sampler.
+//
+// Passes the UI didn't take aren't lost. Each frame carries the bytes that
+// changed in every pass since the UI's previous take, and the successive
+// values of a small set of watched fields, so change highlighting and
+// value history see every sample rather than the ones the UI caught. When
+// a take races a pass, the next frame may repeat the previous frame's
+// changes; watch samples carry their pass number so the UI can drop
+// repeats.
+
+class PageSampler {
+public:
+    using PageMap = SnapshotProvider::PageMap;
+
+    static constexpr int kMaxHz = 10000;
+    static constexpr int kMaxWatchSamples = 256;   // per watch, per frame
+
+    // A field whose every distinct value is kept between frames.
+    struct Watch {
+        uint64_t key  = 0;   // caller's id (the controller uses node ids)
+        uint64_t addr = 0;
+        int      len  = 0;
+        bool operator==(const Watch& o) const {
+            return key == o.key && addr == o.addr && len == o.len;
+        }
+    };
+    struct WatchSample {
+        quint64    seq    = 0;   // pass that read it
+        qint64     timeUs = 0;
+        uint64_t   addr   = 0;
+        QByteArray bytes;
+    };
+
+    struct Frame {
+        quint64      seq    = 0;   // pass that read `pages`
+        qint64       timeUs = 0;   // µs since epoch at the end of that pass
+        int          passes = 0;   // passes folded in since the previous take
+        PageMap      pages;        // newest bytes of every sampled page
+        ChangeBitmap changed;      // addresses changed in any folded pass
+        QHash<uint64_t, QVector<WatchSample>> watches;   // oldest first
+    };
+
+    // Starts sampling `prov` at `hz` (clamped to 1..kMaxHz). Nothing is
+    // read until setTarget() supplies pages.
+    PageSampler(std::shared_ptr<Provider> prov, int hz);
+    ~PageSampler();   // stops and joins the thread
+    PageSampler(const PageSampler&) = delete;
+    PageSampler& operator=(const PageSampler&) = delete;
+
+    // UI side. Replaces the page and watch sets for subsequent passes;
+    // a no-op when both are unchanged.
+    void setTarget(QVector<uint64_t> pages, QVector<Watch> watches);
+
+    // UI side. True when a pass completed since the last take; frame()
+    // then holds it until the next take.
+    bool   take() { return m_frames.take(); }
+    Frame& frame() { return m_frames.front(); }
+
+    // Runs on the sampler thread after every pass with a view of the pages
+    // that pass read, for consumers that need each sample rather than the
+    // frames the UI takes (field recording). Replacing or clearing the hook
+    // waits for a call in flight.
+    using PassHook = std::function<void(const Provider& pages, qint64 timeUs)>;
+    void setPassHook(PassHook hook);
+
+    int hz() const { return m_hz; }
+    const std::shared_ptr<Provider>& provider() const { return m_prov; }
+    quint64 passCount() const { return m_passCount.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+    void pass(qint64 timeUs);
+
+    std::shared_ptr<Provider> m_prov;
+    const int                 m_hz;
+
+    // Target handoff: the UI writes under the mutex and bumps the
+    // generation; the sampler takes the lock only when it moved.
+    QMutex                m_targetMutex;
+    QVector<uint64_t>     m_targetPages;
+    QVector<Watch>        m_targetWatches;
+    std::atomic<quint64>  m_targetGen{0};
+
+    QMutex                m_hookMutex;
+    PassHook              m_hook;
+
+    // Sampler-thread state.
+    quint64               m_seenGen = 0;
+    QVector<uint64_t>     m_pages;
+    QVector<Watch>        m_watches;
+    PageMap               m_prev;
+    QHash<uint64_t, QByteArray> m_lastWatch;   // key → value at the previous pass
+    ChangeBitmap          m_accChanged;        // since the UI's previous take
+    QHash<uint64_t, QVector<WatchSample>> m_accWatches;
+    int                   m_accPasses = 0;
+    quint64               m_seq = 0;
+    std::atomic<quint64>  m_passCount{0};
+
+    TripleBuffer<Frame>   m_frames;
+    std::atomic<bool>     m_stop{false};
+    std::thread           m_thread;   // last: starts once the rest is built
+};
+
+} // namespace rcx
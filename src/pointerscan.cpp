@@ -0,0 +1,470 @@
+#include "pointerscan.h"
+#include <QtConcurrent>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QHash>
+#include <QSet>
+#include <QThread>
+#include <QThreadPool>
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+
+namespace rcx {
+
+namespace {
+
+// Chunk each map worker reads and sorts at a time.
+constexpr uint64_t kMapChunk = 1 << 20;
+constexpr int kPage = 4096;
+// Frontier addresses a search worker claims at a time.
+constexpr int kSearchBlock = 64;
+
+struct Span {
+    uint64_t lo, hi;   // [lo, hi)
+    int      module;   // index into the module table, -1 = not static
+};
+
+// Index of the span holding v in a sorted, non-overlapping list, or -1.
+int findSpan(const std::vector<Span>& spans, uint64_t v) {
+    auto it = std::upper_bound(spans.begin(), spans.end(), v,
+        [](uint64_t x, const Span& s) { return x < s.lo; });
+    if (it == spans.begin()) return -1;
+    --it;
+    return v < it->hi ? int(it - spans.begin()) : -1;
+}
+
+// Readable regions as sorted spans, adjacent ones merged. The fallback for
+// providers without a region list matches ScanEngine::runScan.
+std::vector<Span> readableSpans(const Provider& prov, const QVector<MemoryRegion>& regions) {
+    std::vector<Span> spans;
+    for (const MemoryRegion& r : regions)
+        if (r.readable && r.size > 0)
+            spans.push_back({r.base, r.base + r.size, -1});
+    if (regions.isEmpty() && prov.extent() > 0)
+        spans.push_back({0, (uint64_t)prov.extent(), -1});
+    std::sort(spans.begin(), spans.end(),
+              [](const Span& a, const Span& b) { return a.lo < b.lo; });
+    std::vector<Span> merged;
+    for (const Span& s : spans) {
+        if (!merged.empty() && s.lo <= merged.back().hi)
+            merged.back().hi = qMax(merged.back().hi, s.hi);
+        else
+            merged.push_back(s);
+    }
+    return merged;
+}
+
+int workersFor(QThreadPool* pool, size_t units) {
+    return pool ? (int)qBound<size_t>(1, (size_t)QThread::idealThreadCount(), units) : 1;
+}
+
+// Runs work(w) for w in [0, workerCount): 0 on the calling thread, the
+// rest on `pool`. The calling thread always takes part, so a scan that is
+// itself a task on the same pool can't end up waiting on itself.
+template <class F>
+void runWorkers(QThreadPool* pool, int workerCount, F& work) {
+    QVector<QFuture<void>> helpers;
+    for (int w = 1; w < workerCount; ++w)
+        helpers.append(QtConcurrent::run(pool, [&work, w]() { work(w); }));
+    work(0);
+    for (auto& f : helpers) f.waitForFinished();
+}
+
+bool aborted(const std::atomic<bool>* abort) {
+    return abort && abort->load(std::memory_order_relaxed);
+}
+
+QString hex(uint64_t v) {
+    return QStringLiteral("0x") + QString::number(v, 16).toUpper();
+}
+
+QString signedHex(int64_t v) {
+    return v < 0 ? QStringLiteral("-") + hex(0 - (uint64_t)v) : hex((uint64_t)v);
+}
+
+QString pathKey(const PointerPath& p) {
+    QString key = p.module.toLower() + QStringLiteral("|") + QString::number(p.moduleOffset, 16);
+    for (int64_t o : p.offsets)
+        key += QStringLiteral("|") + QString::number(o);
+    return key;
+}
+
+} // namespace
+
+// ── PointerPath ──
+
+QString PointerPath::formula() const {
+    QString f = QStringLiteral("<") + module + QStringLiteral(">+") + hex(moduleOffset);
+    for (int64_t o : offsets) {
+        f = QStringLiteral("[") + f + QStringLiteral("]");
+        if (o > 0)      f += QStringLiteral("+") + hex((uint64_t)o);
+        else if (o < 0) f += QStringLiteral("-") + hex(0 - (uint64_t)o);
+    }
+    return f;
+}
+
+bool PointerPath::operator==(const PointerPath& o) const {
+    return moduleOffset == o.moduleOffset && offsets == o.offsets
+        && module.compare(o.module, Qt::CaseInsensitive) == 0;
+}
+
+// ── PointerScanResult ──
+
+QJsonObject PointerScanResult::toJson() const {
+    QJsonArray arr;
+    for (const PointerPath& p : paths) {
+        QJsonArray offs;
+        for (int64_t o : p.offsets)
+            offs.append(signedHex(o));
+        arr.append(QJsonObject{
+            {"module", p.module},
+            {"offset", hex(p.moduleOffset)},
+            {"offsets", offs},
+        });
+    }
+    QJsonObject o;
+    o["format"]      = QStringLiteral("rcx-pointerscan");
+    o["version"]     = 1;
+    o["target"]      = hex(target);   // u64 as a string: JSON numbers stop at 2^53
+    o["pointerSize"] = pointerSize;
+    o["maxDepth"]    = maxDepth;
+    o["maxOffset"]   = maxOffset;
+    o["paths"]       = arr;
+    return o;
+}
+
+bool PointerScanResult::fromJson(const QJsonObject& o, PointerScanResult* out,
+                                 QString* errorMsg) {
+    auto fail = [errorMsg](const QString& msg) {
+        if (errorMsg) *errorMsg = msg;
+        return false;
+    };
+    if (o.value("format").toString() != QLatin1String("rcx-pointerscan"))
+        return fail(QStringLiteral("Not a pointer scan file"));
+    if (o.value("version").toInt() != 1)
+        return fail(QStringLiteral("Unsupported pointer scan version %1")
+                        .arg(o.value("version").toInt()));
+
+    PointerScanResult r;
+    bool ok = false;
+    r.target = o.value("target").toString().toULongLong(&ok, 0);
+    if (!ok) return fail(QStringLiteral("Bad target address"));
+    r.pointerSize = o.value("pointerSize").toInt(8);
+    r.maxDepth    = o.value("maxDepth").toInt();
+    r.maxOffset   = o.value("maxOffset").toInt();
+
+    const QJsonArray arr = o.value("paths").toArray();
+    r.paths.reserve(arr.size());
+    for (int i = 0; i < arr.size(); ++i) {
+        const QJsonObject po = arr.at(i).toObject();
+        PointerPath p;
+        p.module = po.value("module").toString();
+        p.moduleOffset = po.value("offset").toString().toULongLong(&ok, 0);
+        if (p.module.isEmpty() || !ok)
+            return fail(QStringLiteral("Bad path %1").arg(i));
+        const QJsonArray offs = po.value("offsets").toArray();
+        for (const QJsonValue& v : offs) {
+            p.offsets.append(v.toString().toLongLong(&ok, 0));
+            if (!ok) return fail(QStringLiteral("Bad offset in path %1").arg(i));
+        }
+        r.paths.append(p);
+    }
+    *out = r;
+    return true;
+}
+
+PointerScanResult PointerScanResult::intersect(const PointerScanResult& a,
+                                               const PointerScanResult& b) {
+    QSet<QString> inB;
+    inB.reserve(b.paths.size());
+    for (const PointerPath& p : b.paths)
+        inB.insert(pathKey(p));
+
+    // b's header: it is usually the newer session, and its target is the
+    // address the surviving paths lead to right now.
+    PointerScanResult r = b;
+    r.paths.clear();
+    r.stats = PointerScanStats{};
+    for (const PointerPath& p : a.paths)
+        if (inB.contains(pathKey(p)))
+            r.paths.append(p);
+    return r;
+}
+
+// ── PointerMap ──
+
+const PointerMap::Entry* PointerMap::lowerBound(uint64_t v) const {
+    return std::lower_bound(begin(), end(), v,
+        [](const Entry& e, uint64_t x) { return e.value < x; });
+}
+
+PointerMap PointerMap::build(const Provider& prov, const QVector<MemoryRegion>& regions,
+                             int pointerSize, int alignment, QThreadPool* pool,
+                             const std::atomic<bool>* abort,
+                             const std::function<void(int)>& progress) {
+    PointerMap map;
+    const int ptr = pointerSize == 4 ? 4 : 8;
+    const uint64_t align = alignment > 0 ? (uint64_t)alignment : (uint64_t)ptr;
+
+    const std::vector<Span> spans = readableSpans(prov, regions);
+    if (spans.empty()) return map;
+    const uint64_t lowest = spans.front().lo;
+    const uint64_t highest = spans.back().hi;
+
+    struct Unit { uint64_t addr, len; };
+    std::vector<Unit> units;
+    uint64_t totalBytes = 0;
+    for (const Span& s : spans) {
+        for (uint64_t a = s.lo; a < s.hi; a += kMapChunk)
+            units.push_back({a, qMin(kMapChunk, s.hi - a)});
+        totalBytes += s.hi - s.lo;
+    }
+
+    // Each unit fills its own slot, sorted by value; no locks on the hot path.
+    std::vector<std::vector<Entry>> unitEntries(units.size());
+    std::atomic<size_t> nextUnit{0};
+    std::atomic<uint64_t> doneBytes{0};
+    std::atomic<int> lastPct{-1};
+
+    auto work = [&](int) {
+        // Reads overshoot by ptr-1 so a slot straddling the chunk end is
+        // still seen whole (clipped to the span, which already is merged).
+        std::vector<uint8_t> buf(kMapChunk + ptr);
+        for (;;) {
+            if (aborted(abort)) return;
+            const size_t u = nextUnit.fetch_add(1);
+            if (u >= units.size()) return;
+            const Unit unit = units[u];
+            const Span& span = spans[findSpan(spans, unit.addr)];
+            const uint64_t readLen = qMin<uint64_t>(unit.len + ptr - 1, span.hi - unit.addr);
+
+            if (!prov.read(unit.addr, buf.data(), (int)readLen)) {
+                // A chunk that fails as a whole may still be mostly mapped
+                // (a guard page in the middle); retry it page by page and
+                // zero the pages that stay unreadable.
+                for (uint64_t off = 0; off < readLen; off += kPage) {
+                    const int n = (int)qMin<uint64_t>(kPage, readLen - off);
+                    if (!prov.read(unit.addr + off, buf.data() + off, n))
+                        std::memset(buf.data() + off, 0, n);
+                }
+            }
+
+            std::vector<Entry>& out = unitEntries[u];
+            const uint64_t first = (unit.addr + align - 1) / align * align;
+            for (uint64_t off = first - unit.addr; off < unit.len && off + ptr <= readLen; off += align) {
+                uint64_t v = 0;
+                if (ptr == 8) std::memcpy(&v, buf.data() + off, 8);
+                else { uint32_t v32; std::memcpy(&v32, buf.data() + off, 4); v = v32; }
+                // Most values (counters, floats, flags) fail the range check
+                // before paying for the binary search.
+                if (v < lowest || v >= highest || findSpan(spans, v) < 0) continue;
+                out.push_back({v, unit.addr + off});
+            }
+            std::sort(out.begin(), out.end(), [](const Entry& a, const Entry& b) {
+                return a.value != b.value ? a.value < b.value : a.addr < b.addr;
+            });
+
+            const uint64_t done = doneBytes.fetch_add(unit.len) + unit.len;
+            if (progress) {
+                const int pct = (int)(done * 100 / totalBytes);
+                int prev = lastPct.load();
+                while (pct > prev)
+                    if (lastPct.compare_exchange_weak(prev, pct)) { progress(pct); break; }
+            }
+        }
+    };
+    runWorkers(pool, workersFor(pool, units.size()), work);
+    if (aborted(abort)) return map;
+
+    // k-way merge of the sorted units. Ties break on the slot address, so
+    // the map comes out the same regardless of which worker read what.
+    size_t total = 0;
+    for (const auto& v : unitEntries) total += v.size();
+    map.m_entries.reserve(total);
+    struct Head { size_t unit, idx; };
+    auto later = [&unitEntries](const Head& a, const Head& b) {
+        const Entry& x = unitEntries[a.unit][a.idx];
+        const Entry& y = unitEntries[b.unit][b.idx];
+        return x.value != y.value ? x.value > y.value : x.addr > y.addr;
+    };
+    std::vector<Head> heap;
+    for (size_t u = 0; u < unitEntries.size(); ++u)
+        if (!unitEntries[u].empty()) heap.push_back({u, 0});
+    std::make_heap(heap.begin(), heap.end(), later);
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        Head& h = heap.back();
+        map.m_entries.push_back(unitEntries[h.unit][h.idx]);
+        if (++h.idx < unitEntries[h.unit].size()) {
+            std::push_heap(heap.begin(), heap.end(), later);
+        } else {
+            std::vector<Entry>().swap(unitEntries[h.unit]);
+            heap.pop_back();
+        }
+    }
+    return map;
+}
+
+// ── Reverse search ──
+
+PointerScanResult findPointerPaths(const PointerMap& map,
+                                   const QVector<MemoryRegion>& regions,
+                                   const PointerScanRequest& req,
+                                   QThreadPool* pool,
+                                   const std::atomic<bool>* abort) {
+    QElapsedTimer timer;
+    timer.start();
+
+    PointerScanResult result;
+    result.target      = req.target;
+    result.pointerSize = req.pointerSize == 4 ? 4 : 8;
+    result.maxDepth    = qMax(1, req.maxDepth);
+    result.maxOffset   = qMax(0, req.maxOffset);
+    result.stats.pointers = map.size();
+    const uint64_t maxOffset = (uint64_t)result.maxOffset;
+    const int maxResults = qMax(1, req.maxResults);
+
+    // Module images: base = lowest region carrying the name.
+    QVector<QString> moduleNames;
+    QVector<uint64_t> moduleBases;
+    QHash<QString, int> moduleIndex;
+    std::vector<Span> statics;
+    for (const MemoryRegion& r : regions) {
+        if (r.moduleName.isEmpty() || r.size == 0) continue;
+        const QString key = r.moduleName.toLower();
+        auto it = moduleIndex.find(key);
+        if (it == moduleIndex.end()) {
+            it = moduleIndex.insert(key, moduleNames.size());
+            moduleNames.append(r.moduleName);
+            moduleBases.append(r.base);
+        } else {
+            moduleBases[*it] = qMin(moduleBases[*it], r.base);
+        }
+        statics.push_back({r.base, r.base + r.size, *it});
+    }
+    std::sort(statics.begin(), statics.end(),
+              [](const Span& a, const Span& b) { return a.lo < b.lo; });
+
+    // Search tree: each node reaches its parent as *addr + offset.
+    struct Node {
+        uint64_t addr;
+        int      parent;
+        int64_t  offset;
+    };
+    struct Hit {
+        uint64_t slot;
+        int      node;
+        int64_t  offset;
+        int      module;
+    };
+    std::vector<Node> nodes{{req.target, -1, 0}};
+    std::unordered_set<uint64_t> seen{req.target};
+    std::vector<int> level{0};
+
+    for (int depth = 1; depth <= result.maxDepth && !level.empty(); ++depth) {
+        if (aborted(abort)) break;
+        const bool last = depth == result.maxDepth;
+
+        // Workers read `nodes` and `level` and write only their own
+        // buffers; the merge below runs on this thread alone.
+        std::atomic<size_t> nextBlock{0};
+        const int workerCount = workersFor(pool, (level.size() + kSearchBlock - 1) / kSearchBlock);
+        std::vector<std::vector<Hit>> workerHits(workerCount);
+        std::vector<std::vector<Node>> workerNext(workerCount);
+
+        auto work = [&](int w) {
+            std::vector<Hit>& hits = workerHits[w];
+            std::vector<Node>& next = workerNext[w];
+            for (;;) {
+                if (aborted(abort)) return;
+                const size_t b = nextBlock.fetch_add(1);
+                const size_t lo = b * kSearchBlock;
+                if (lo >= level.size()) return;
+                const size_t hi = qMin(level.size(), lo + kSearchBlock);
+                for (size_t i = lo; i < hi; ++i) {
+                    const int n = level[i];
+                    const uint64_t a = nodes[n].addr;
+                    const uint64_t from = a >= maxOffset ? a - maxOffset : 0;
+                    for (const PointerMap::Entry* e = map.lowerBound(from);
+                         e != map.end() && e->value <= a; ++e) {
+                        const int64_t off = (int64_t)(a - e->value);
+                        const int s = findSpan(statics, e->addr);
+                        if (s >= 0)
+                            hits.push_back({e->addr, n, off, statics[s].module});
+                        else if (!last)
+                            next.push_back({e->addr, n, off});
+                    }
+                }
+            }
+        };
+        runWorkers(pool, workerCount, work);
+        result.stats.nodesExpanded += (qint64)level.size();
+        if (aborted(abort)) break;
+
+        // Blocks were claimed in whatever order the threads ran; sort so
+        // the output is the same on every run.
+        std::vector<Hit> hits;
+        std::vector<Node> next;
+        for (auto& v : workerHits) hits.insert(hits.end(), v.begin(), v.end());
+        for (auto& v : workerNext) next.insert(next.end(), v.begin(), v.end());
+        std::sort(hits.begin(), hits.end(), [](const Hit& a, const Hit& b) {
+            return a.node != b.node ? a.node < b.node : a.slot < b.slot;
+        });
+        std::sort(next.begin(), next.end(), [](const Node& a, const Node& b) {
+            return a.parent != b.parent ? a.parent < b.parent : a.addr < b.addr;
+        });
+
+        for (const Hit& h : hits) {
+            if (result.paths.size() >= maxResults) {
+                result.stats.capped = true;
+                break;
+            }
+            PointerPath p;
+            p.module = moduleNames[h.module];
+            p.moduleOffset = h.slot - moduleBases[h.module];
+            p.offsets.reserve(depth);
+            p.offsets.append(h.offset);
+            for (int n = h.node; nodes[n].parent >= 0; n = nodes[n].parent)
+                p.offsets.append(nodes[n].offset);
+            result.paths.append(p);
+        }
+        if (result.stats.capped) break;
+
+        std::vector<int> nextLevel;
+        for (const Node& n : next) {
+            if (!seen.insert(n.addr).second) continue;
+            nextLevel.push_back(int(nodes.size()));
+            nodes.push_back(n);
+        }
+        level.swap(nextLevel);
+    }
+
+    result.stats.searchMs = (int)timer.elapsed();
+    return result;
+}
+
+PointerScanResult scanPointerPaths(const Provider& prov,
+                                   const QVector<MemoryRegion>& regions,
+                                   const PointerScanRequest& req,
+                                   QThreadPool* pool,
+                                   const std::atomic<bool>* abort,
+                                   const std::function<void(int)>& progress) {
+    QElapsedTimer timer;
+    timer.start();
+    // The map is nearly all of the work; the search reports the last step.
+    std::function<void(int)> mapProgress;
+    if (progress)
+        mapProgress = [&progress](int pct) { progress(pct * 9 / 10); };
+    const PointerMap map = PointerMap::build(prov, regions, req.pointerSize,
+                                             req.alignment, pool, abort, mapProgress);
+    const int mapMs = (int)timer.elapsed();
+
+    PointerScanResult result = findPointerPaths(map, regions, req, pool, abort);
+    result.stats.mapMs = mapMs;
+    result.stats.aborted = aborted(abort);
+    if (progress && !result.stats.aborted) progress(100);
+    return result;
+}
+
+} // namespace rcx
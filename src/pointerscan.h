@@ -0,0 +1,132 @@
+#pragma once
+#include "providers/provider.h"
+#include <QJsonObject>
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+class QThreadPool;
+
+namespace rcx {
+
+// ── Pointer scan ──
+//
+// Finds static paths to a dynamic address: "[[<game.exe>+0x1A0]+0x30]+0x8"
+// still reaches the player object after the game reallocates it or
+// restarts, where the raw address doesn't.
+//
+// Two phases. One pass over readable memory builds a PointerMap of every
+// aligned pointer-sized value that lands inside a readable region, sorted
+// by value. A reverse breadth-first search then starts at the target: for
+// each address A on the current level, every map entry whose value is in
+// [A - maxOffset, A] is a pointer that reaches A through one offset. An
+// entry inside a module image ends a path (module-relative, so it survives
+// a restart); any other entry joins the next level, up to maxDepth.
+//
+// Each heap address is expanded once, at the shallowest depth that finds
+// it, so the search stays linear in the map rather than in the number of
+// paths through it. Static hits are not deduplicated; every static pointer
+// reaching the frontier is its own path.
+
+struct PointerScanRequest {
+    uint64_t target     = 0;
+    int      maxDepth   = 5;       // dereferences per path
+    int      maxOffset  = 0x1000;  // largest offset added after a dereference
+    int      pointerSize = 8;      // 4 for 32-bit targets
+    int      alignment  = 0;       // pointer slot stride; 0 = pointerSize
+    int      maxResults = 100000;
+};
+
+// A path from a module-relative static slot to the target. Evaluated as
+// x = module + moduleOffset; then for each o in offsets: x = *x + o.
+struct PointerPath {
+    QString           module;
+    uint64_t          moduleOffset = 0;
+    QVector<int64_t>  offsets;
+
+    // The path as a base-address formula ("[[<game.exe>+0x1A0]+0x30]+0x8"),
+    // in AddressParser syntax.
+    QString formula() const;
+    bool operator==(const PointerPath& o) const;
+};
+
+struct PointerScanStats {
+    qint64 pointers      = 0;   // entries in the pointer map
+    qint64 nodesExpanded = 0;   // heap addresses searched backwards
+    int    mapMs         = 0;
+    int    searchMs      = 0;
+    bool   capped        = false;   // stopped at maxResults
+    bool   aborted       = false;   // stopped by the abort flag; paths are partial
+};
+
+struct PointerScanResult {
+    uint64_t             target = 0;
+    int                  pointerSize = 8;
+    int                  maxDepth = 0;
+    int                  maxOffset = 0;
+    QVector<PointerPath> paths;   // shortest first
+    PointerScanStats     stats;
+
+    // Saved between sessions: a path that reaches the object in two runs
+    // of the game is far more likely to be the real one.
+    QJsonObject toJson() const;
+    static bool fromJson(const QJsonObject& o, PointerScanResult* out,
+                         QString* errorMsg = nullptr);
+    // Paths present in both results. Module names compare case-insensitively.
+    static PointerScanResult intersect(const PointerScanResult& a,
+                                       const PointerScanResult& b);
+};
+
+// ── Pointer map ──
+//
+// Every pointer found in one pass, sorted by the value it holds. One
+// 16-byte entry per pointer and no per-entry allocation, so a few tens of
+// millions of pointers fit comfortably; std::vector for the same reason as
+// ScanResultStore (Qt 5 containers stop at 2 GB).
+class PointerMap {
+public:
+    struct Entry {
+        uint64_t value;   // what the slot points at
+        uint64_t addr;    // where the slot is
+    };
+
+    // Read every readable region in `regions` and keep aligned values that
+    // fall inside one of them. Chunks are read and sorted in parallel on
+    // `pool` (the calling thread works too); null = calling thread only.
+    // `progress` gets 0..100 from whichever thread finished a chunk.
+    static PointerMap build(const Provider& prov, const QVector<MemoryRegion>& regions,
+                            int pointerSize, int alignment = 0,
+                            QThreadPool* pool = nullptr,
+                            const std::atomic<bool>* abort = nullptr,
+                            const std::function<void(int)>& progress = {});
+
+    qint64 size() const { return (qint64)m_entries.size(); }
+    bool   isEmpty() const { return m_entries.empty(); }
+    const Entry* begin() const { return m_entries.data(); }
+    const Entry* end() const { return m_entries.data() + m_entries.size(); }
+    // First entry whose value is >= v.
+    const Entry* lowerBound(uint64_t v) const;
+
+private:
+    std::vector<Entry> m_entries;
+};
+
+// Reverse search over a built map. Static slots are those inside regions
+// with a module name; a module's base is its lowest region.
+PointerScanResult findPointerPaths(const PointerMap& map,
+                                   const QVector<MemoryRegion>& regions,
+                                   const PointerScanRequest& req,
+                                   QThreadPool* pool = nullptr,
+                                   const std::atomic<bool>* abort = nullptr);
+
+// Both phases.
+PointerScanResult scanPointerPaths(const Provider& prov,
+                                   const QVector<MemoryRegion>& regions,
+                                   const PointerScanRequest& req,
+                                   QThreadPool* pool = nullptr,
+                                   const std::atomic<bool>* abort = nullptr,
+                                   const std::function<void(int)>& progress = {});
+
+} // namespace rcx
@@ -0,0 +1,187 @@
+#pragma once
+#include "provider.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QReadWriteLock>
+#include <climits>
+
+namespace rcx {
+
+// File source backed by a read-only mapping of the whole file.
+//
+// Opening costs one mmap / MapViewOfFile regardless of size, so a 6 GB dump
+// is addressable at once and the OS pages it in on demand. Reads copy
+// straight out of the mapping and directData() hands the scanner the mapped
+// bytes themselves.
+//
+// Edits never touch the file until save(): write() copies each page it
+// touches into a private overlay and patches the copy, and reads consult the
+// overlay for those pages. save() writes the dirty pages back through a
+// second handle — the mapping is shared, so it shows the new bytes without
+// being remapped, and pointers a running scan holds stay valid.
+class MappedFileProvider : public Provider {
+    QString       m_path;
+    QString       m_name;
+    QFile         m_file;
+    const uchar*  m_map  = nullptr;
+    uint64_t      m_size = 0;
+
+    // page-aligned offset → edited copy of that page (short for the tail)
+    QHash<uint64_t, QByteArray> m_dirty;
+    // Guards m_dirty: the scanner reads from pool threads while the UI
+    // thread writes.
+    mutable QReadWriteLock m_lock;
+
+    static constexpr uint64_t kPageSize = 4096;
+    static constexpr uint64_t kPageMask = ~(kPageSize - 1);
+
+    bool inRange(uint64_t addr, uint64_t len) const {
+        return addr <= m_size && len <= m_size - addr;
+    }
+
+public:
+    explicit MappedFileProvider(const QString& path)
+        : m_path(path)
+        , m_name(QFileInfo(path).fileName())
+        , m_file(path) {
+        if (!m_file.open(QIODevice::ReadOnly)) return;
+        const qint64 n = m_file.size();
+        if (n <= 0) return;   // nothing to map; isMapped() stays false
+        m_map = m_file.map(0, n);
+        if (m_map) m_size = (uint64_t)n;
+    }
+
+    ~MappedFileProvider() override {
+        if (m_map) m_file.unmap(const_cast<uchar*>(m_map));
+    }
+
+    MappedFileProvider(const MappedFileProvider&) = delete;
+    MappedFileProvider& operator=(const MappedFileProvider&) = delete;
+
+    // False if the file couldn't be opened or mapped (empty, a pipe, no
+    // address space left); callers fall back to BufferProvider.
+    bool isMapped() const { return m_map != nullptr; }
+    const QString& path() const { return m_path; }
+
+    int size() const override { return (int)qMin<uint64_t>(m_size, INT_MAX); }
+    uint64_t extent() const override { return m_size; }
+
+    bool read(uint64_t addr, void* buf, int len) const override {
+        if (len <= 0 || !inRange(addr, (uint64_t)len)) return false;
+        QReadLocker lock(&m_lock);
+        if (m_dirty.isEmpty()) {
+            std::memcpy(buf, m_map + addr, (size_t)len);
+            return true;
+        }
+        char* out = static_cast<char*>(buf);
+        uint64_t cur = addr;
+        const uint64_t end = addr + (uint64_t)len;
+        while (cur < end) {
+            const uint64_t page = cur & kPageMask;
+            const size_t chunk = (size_t)(qMin(end, page + kPageSize) - cur);
+            auto it = m_dirty.constFind(page);
+            const char* src = it != m_dirty.constEnd()
+                ? it->constData() + (cur - page)
+                : reinterpret_cast<const char*>(m_map) + cur;
+            std::memcpy(out, src, chunk);
+            out += chunk;
+            cur += chunk;
+        }
+        return true;
+    }
+
+    bool isWritable() const override { return m_map != nullptr; }
+
+    bool write(uint64_t addr, const void* buf, int len) override {
+        if (len <= 0 || !inRange(addr, (uint64_t)len)) return false;
+        QWriteLocker lock(&m_lock);
+        const char* in = static_cast<const char*>(buf);
+        uint64_t cur = addr;
+        const uint64_t end = addr + (uint64_t)len;
+        while (cur < end) {
+            const uint64_t page = cur & kPageMask;
+            const uint64_t pageEnd = qMin(m_size, page + kPageSize);
+            const size_t chunk = (size_t)(qMin(end, pageEnd) - cur);
+            auto it = m_dirty.find(page);
+            if (it == m_dirty.end())
+                it = m_dirty.insert(page, QByteArray(reinterpret_cast<const char*>(m_map) + page,
+                                                     (int)(pageEnd - page)));
+            std::memcpy(it->data() + (cur - page), in, chunk);
+            in += chunk;
+            cur += chunk;
+        }
+        return true;
+    }
+
+    // Mapped bytes for ranges with no pending edits; edited pages only
+    // exist in the overlay, so those go through read().
+    const uint8_t* directData(uint64_t addr, uint64_t len) const override {
+        if (!m_map || len == 0 || !inRange(addr, len)) return nullptr;
+        QReadLocker lock(&m_lock);
+        if (!m_dirty.isEmpty()) {
+            // Walk whichever is shorter: the dirty set or the pages in range.
+            const uint64_t first = addr & kPageMask;
+            const uint64_t last = (addr + len - 1) & kPageMask;
+            if ((uint64_t)m_dirty.size() <= (last - first) / kPageSize + 1) {
+                for (auto it = m_dirty.constBegin(); it != m_dirty.constEnd(); ++it)
+                    if (it.key() >= first && it.key() <= last) return nullptr;
+            } else {
+                for (uint64_t p = first; p <= last; p += kPageSize)
+                    if (m_dirty.contains(p)) return nullptr;
+            }
+        }
+        return m_map + addr;
+    }
+
+    // Edits made since open / the last save().
+    bool isDirty() const {
+        QReadLocker lock(&m_lock);
+        return !m_dirty.isEmpty();
+    }
+
+    // Write the edited pages into the file. The overlay is kept on failure
+    // so nothing is lost and the save can be retried.
+    bool save(QString* errorMsg = nullptr) {
+        QWriteLocker lock(&m_lock);
+        if (m_dirty.isEmpty()) return true;
+        QFile out(m_path);
+        if (!out.open(QIODevice::ReadWrite)) {
+            if (errorMsg) *errorMsg = out.errorString();
+            return false;
+        }
+        for (auto it = m_dirty.constBegin(); it != m_dirty.constEnd(); ++it) {
+            if (!out.seek((qint64)it.key())
+                || out.write(it.value()) != it.value().size()) {
+                if (errorMsg) *errorMsg = out.errorString();
+                return false;
+            }
+        }
+        if (!out.flush()) {
+            if (errorMsg) *errorMsg = out.errorString();
+            return false;
+        }
+        m_dirty.clear();
+        return true;
+    }
+
+    QString name() const override { return m_name; }
+    QString kind() const override { return QStringLiteral("File"); }
+
+    // One region spanning the whole file, named like BufferProvider's so
+    // the scanner's Module column reads the same for either.
+    QVector<MemoryRegion> enumerateRegions() const override {
+        if (!m_map) return {};
+        MemoryRegion r;
+        r.base       = 0;
+        r.size       = m_size;
+        r.readable   = true;
+        r.writable   = true;
+        r.executable = false;
+        r.moduleName = m_name;
+        r.type       = RegionType::Mapped;
+        return { r };
+    }
+};
+
+} // namespace rcx
@@ -28,6 +28,17 @@ struct MemoryRegion {
     RegionType type       = RegionType::Private;
 };
 
+// One destination span for Provider::readBatch(). The caller owns `buf`
+// (at least `len` bytes); readBatch() fills it and sets `ok` per span.
+// A span that fails is left untouched — callers decide whether to zero it
+// or retry at a finer granularity.
+struct ReadSpan {
+    uint64_t addr = 0;
+    void*    buf  = nullptr;
+    int      len  = 0;
+    bool     ok   = false;
+};
+
 struct VtopResult {
     uint64_t physical = 0;
     uint64_t pml4e = 0, pdpte = 0, pde = 0, pte = 0;
@@ -50,6 +61,34 @@ public:
     }
     virtual bool isWritable() const { return false; }
 
+    // Addressable length in bytes. size() is an int and tops out at 2 GB;
+    // providers backed by something bigger (a mapped multi-GB dump) report
+    // the real length here and a clamped size(). Bounds checks and the
+    // scanner's fallback region use this. Default: size().
+    virtual uint64_t extent() const {
+        const int n = size();
+        return n > 0 ? (uint64_t)n : 0;
+    }
+
+    // Stable pointer to [addr, addr+len) when the bytes already sit in this
+    // process (a file mapping), so bulk consumers like the scanner can work
+    // on them in place instead of copying through read(). The view is
+    // read-only and stays valid for the provider's lifetime; it may go stale
+    // after a write(). nullptr means "use read()". Default: nullptr.
+    virtual const uint8_t* directData(uint64_t addr, uint64_t len) const {
+        Q_UNUSED(addr); Q_UNUSED(len);
+        return nullptr;
+    }
+
+    // Read many spans in one call. The live-refresh pipeline feeds this
+    // sorted, coalesced runs of adjacent pages so a provider that can
+    // vector its I/O (process_vm_readv, an RPC batch command) pays one
+    // round-trip per tick instead of one per page. Default: loop read().
+    virtual void readBatch(QVector<ReadSpan>& spans) const {
+        for (ReadSpan& s : spans)
+            s.ok = (s.len > 0) && read(s.addr, s.buf, s.len);
+    }
+
     // Human-readable label for this source.
     // Examples: "notepad.exe", "dump.bin", "tcp://10.0.0.1:1337"
     virtual QString name() const { return {}; }
@@ -89,7 +128,7 @@ public:
 
     // Enumerate committed/readable memory regions.
     // Used by the scan engine to know what address ranges to scan.
-    // Default: returns empty (scan engine falls back to [0, size())).
+    // Default: returns empty (scan engine falls back to [0, extent())).
     virtual QVector<MemoryRegion> enumerateRegions() const { return {}; }
 
     // Process Environment Block address (x64 PEB VA in target process).
@@ -139,8 +178,8 @@ public:
 
     virtual bool isReadable(uint64_t addr, int len) const {
         if (len <= 0) return (len == 0);
-        uint64_t ulen = (uint64_t)len;
-        return addr <= (uint64_t)size() && ulen <= (uint64_t)size() - addr;
+        const uint64_t ulen = (uint64_t)len, n = extent();
+        return addr <= n && ulen <= n - addr;
     }
 
     template<typename T>
@@ -178,6 +217,8 @@ private:
     // then reads these cache members where the plugin stored the subclass's
     // own data → garbage QVector<ModuleEntry> → access violation the first
     // time modulesCached() runs (RTTI module resolution during compose).
+    // The same goes for the vtable: a new virtual (extent(), directData())
+    // shifts every slot after it.
     // If you add/remove/reorder members here, EVERY provider plugin must be
     // rebuilt. The build enforces this via add_dependencies(Reclass <plugins>)
     // in CMakeLists.txt so a partial app-only build can't ship a stale plugin.
@@ -2,6 +2,7 @@
 #include "provider.h"
 #include <QHash>
 #include <QSet>
+#include <algorithm>
 #include <memory>
 
 namespace rcx {
@@ -176,4 +177,73 @@ public:
     const QSet<uint64_t>& permanentPages() const { return m_permanentPages; }
 };
 
+// Read a set of page addresses for the async refresh through one
+// Provider::readBatch() call. Pages are sorted and adjacent ones coalesced
+// into a single span (capped at kMaxRunPages so one bad run can't cost a
+// huge retry). A run that fails as a whole is retried page-by-page in a
+// second batch, so a single unmapped page never blanks its readable
+// neighbours; pages that still fail read as zeros, like readBytes().
+inline SnapshotProvider::PageMap readPagesCoalesced(const Provider& prov,
+                                                    QVector<uint64_t> pages) {
+    constexpr uint64_t kPageSize = 4096;
+    constexpr int kMaxRunPages = 256;   // 1 MB per span
+
+    std::sort(pages.begin(), pages.end());
+    pages.erase(std::unique(pages.begin(), pages.end()), pages.end());
+
+    struct Run { uint64_t addr; int count; };
+    QVector<Run> runs;
+    for (uint64_t p : pages) {
+        if (!runs.isEmpty()) {
+            Run& r = runs.last();
+            if (r.count < kMaxRunPages && r.addr + uint64_t(r.count) * kPageSize == p) {
+                ++r.count;
+                continue;
+            }
+        }
+        runs.append({p, 1});
+    }
+
+    QVector<QByteArray> bufs(runs.size());
+    QVector<ReadSpan> spans(runs.size());
+    for (int i = 0; i < runs.size(); ++i) {
+        bufs[i] = QByteArray(runs[i].count * int(kPageSize), Qt::Uninitialized);
+        spans[i] = {runs[i].addr, bufs[i].data(), bufs[i].size(), false};
+    }
+    prov.readBatch(spans);
+
+    SnapshotProvider::PageMap out;
+    out.reserve(pages.size());
+    QVector<ReadSpan> retry;
+    QVector<QByteArray> retryBufs;
+    for (int i = 0; i < runs.size(); ++i) {
+        const Run& r = runs[i];
+        if (spans[i].ok) {
+            if (r.count == 1) {
+                out.insert(r.addr, std::move(bufs[i]));
+                continue;
+            }
+            for (int k = 0; k < r.count; ++k)
+                out.insert(r.addr + uint64_t(k) * kPageSize,
+                           bufs[i].mid(k * int(kPageSize), int(kPageSize)));
+        } else if (r.count == 1) {
+            out.insert(r.addr, QByteArray(int(kPageSize), '\0'));
+        } else {
+            for (int k = 0; k < r.count; ++k) {
+                retryBufs.append(QByteArray(int(kPageSize), Qt::Uninitialized));
+                retry.append({r.addr + uint64_t(k) * kPageSize,
+                              retryBufs.last().data(), int(kPageSize), false});
+            }
+        }
+    }
+    if (!retry.isEmpty()) {
+        prov.readBatch(retry);
+        for (int i = 0; i < retry.size(); ++i) {
+            if (!retry[i].ok) retryBufs[i].fill('\0');
+            out.insert(retry[i].addr, std::move(retryBufs[i]));
+        }
+    }
+    return out;
+}
+
 } // namespace rcx
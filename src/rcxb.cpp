@@ -0,0 +1,488 @@
+#include "rcxb.h"
+#include <QJsonDocument>
+#include <QtEndian>
+#include <cstring>
+#include <vector>
+
+namespace rcx {
+
+namespace {
+
+constexpr char     kMagic[4] = {'R', 'C', 'X', 'B'};
+constexpr uint32_t kVersion = 1;
+constexpr int      kHeaderBytes = 112;
+constexpr int      kNodeBytes   = 72;
+constexpr int      kEnumBytes   = 12;
+constexpr int      kBitBytes    = 6;
+constexpr int      kClassBytes  = 12;
+
+// Node record field offsets.
+enum : int {
+    N_Id = 0, N_Parent = 8, N_Ref = 16,
+    N_Name = 24, N_Type = 28, N_Keyword = 32, N_Comment = 36,
+    N_Offset = 40, N_ArrayLen = 44, N_StrLen = 48,
+    N_Kind = 52, N_ElemKind = 53, N_PtrDepth = 54, N_Flags = 55,
+    N_Extras = 56, N_EnumCount = 60, N_BitCount = 64,
+};
+enum : uint8_t { F_Relative = 1, F_BigEndian = 2 };
+
+// Header field offsets: u64 offset/size pairs after magic, version, kindCount.
+enum : int {
+    H_Version = 4, H_KindCount = 8,
+    H_MetaOff = 16, H_MetaLen = 24,
+    H_StrOff = 32, H_StrLen = 40,
+    H_NodeOff = 48, H_NodeCount = 56,
+    H_ExtraOff = 64, H_ExtraLen = 72,
+    H_ClassOff = 80, H_ClassCount = 88,
+    H_MemberOff = 96, H_MemberCount = 104,
+};
+
+template <typename T>
+void putLE(std::vector<uint8_t>& out, T v) {
+    uint8_t b[sizeof(T)];
+    qToLittleEndian(v, b);
+    out.insert(out.end(), b, b + sizeof(T));
+}
+
+template <typename T>
+void setLE(std::vector<uint8_t>& out, size_t at, T v) {
+    qToLittleEndian(v, out.data() + at);
+}
+
+template <typename T>
+T getLE(const uchar* p) { return qFromLittleEndian<T>(p); }
+
+void alignTo8(std::vector<uint8_t>& out) {
+    out.resize((out.size() + 7) & ~size_t(7), 0);
+}
+
+struct StringTable {
+    QHash<QString, uint32_t> ids;
+    std::vector<uint32_t>    offsets{0};
+    QByteArray               bytes;
+
+    StringTable() { add(QString()); }
+
+    uint32_t add(const QString& s) {
+        auto it = ids.constFind(s);
+        if (it != ids.constEnd()) return *it;
+        const uint32_t id = uint32_t(offsets.size() - 1);
+        ids.insert(s, id);
+        bytes.append(s.toUtf8());
+        offsets.push_back(uint32_t(bytes.size()));
+        return id;
+    }
+};
+
+// Index into `nodes` of the parentId == 0 ancestor of each node, or -1 for
+// nodes under a missing parent or in a cycle (those load, but belong to no
+// class).
+std::vector<int> rootsOf(const NodeTree& tree) {
+    const int n = tree.nodes.size();
+    QHash<uint64_t, int> byId;
+    byId.reserve(n);
+    for (int i = 0; i < n; ++i) byId.insert(tree.nodes[i].id, i);
+
+    constexpr int kUnknown = -2;
+    std::vector<int> root(size_t(n), kUnknown);
+    std::vector<int> path;
+    for (int i = 0; i < n; ++i) {
+        int cur = i;
+        int found = -1;
+        path.clear();
+        while (true) {
+            if (root[size_t(cur)] != kUnknown) { found = root[size_t(cur)]; break; }
+            if (int(path.size()) > n) break;   // cycle
+            path.push_back(cur);
+            const uint64_t pid = tree.nodes[cur].parentId;
+            if (pid == 0) { found = cur; break; }
+            auto it = byId.constFind(pid);
+            if (it == byId.constEnd()) break;
+            cur = *it;
+        }
+        for (int p : path) root[size_t(p)] = found;
+    }
+    return root;
+}
+
+} // namespace
+
+QByteArray encodeRcxb(const NodeTree& tree, const QJsonObject& meta) {
+    StringTable strs;
+    for (const KindMeta& k : kKindMeta) strs.add(QString::fromLatin1(k.name));
+    const uint32_t kindCount = uint32_t(std::size(kKindMeta));
+
+    QJsonObject metaObj = meta;
+    const QJsonObject header = tree.headerJson();
+    for (auto it = header.begin(); it != header.end(); ++it) metaObj.insert(it.key(), it.value());
+    metaObj.remove(QStringLiteral("nodes"));
+    const QByteArray metaJson = QJsonDocument(metaObj).toJson(QJsonDocument::Compact);
+
+    const int n = tree.nodes.size();
+    std::vector<uint8_t> nodes;
+    nodes.reserve(size_t(n) * kNodeBytes);
+    std::vector<uint8_t> extras;
+    for (const Node& node : tree.nodes) {
+        const size_t at = nodes.size();
+        nodes.resize(at + kNodeBytes, 0);
+        setLE<uint64_t>(nodes, at + N_Id, node.id);
+        setLE<uint64_t>(nodes, at + N_Parent, node.parentId);
+        setLE<uint64_t>(nodes, at + N_Ref, node.refId);
+        setLE<uint32_t>(nodes, at + N_Name, strs.add(node.name));
+        setLE<uint32_t>(nodes, at + N_Type, strs.add(node.structTypeName));
+        setLE<uint32_t>(nodes, at + N_Keyword, strs.add(node.classKeyword));
+        setLE<uint32_t>(nodes, at + N_Comment, strs.add(node.comment));
+        setLE<int32_t>(nodes, at + N_Offset, node.offset);
+        setLE<int32_t>(nodes, at + N_ArrayLen, node.arrayLen);
+        setLE<int32_t>(nodes, at + N_StrLen, node.strLen);
+        nodes[at + N_Kind] = uint8_t(node.kind);
+        nodes[at + N_ElemKind] = uint8_t(node.elementKind);
+        nodes[at + N_PtrDepth] = uint8_t(node.ptrDepth);
+        nodes[at + N_Flags] = uint8_t((node.isRelative ? F_Relative : 0)
+                                      | (node.bigEndian ? F_BigEndian : 0));
+        if (node.enumMembers.isEmpty() && node.bitfieldMembers.isEmpty()) continue;
+        setLE<uint32_t>(nodes, at + N_Extras, uint32_t(extras.size()));
+        setLE<uint32_t>(nodes, at + N_EnumCount, uint32_t(node.enumMembers.size()));
+        setLE<uint32_t>(nodes, at + N_BitCount, uint32_t(node.bitfieldMembers.size()));
+        for (const auto& m : node.enumMembers) {
+            putLE<uint32_t>(extras, strs.add(m.first));
+            putLE<int64_t>(extras, m.second);
+        }
+        for (const auto& m : node.bitfieldMembers) {
+            putLE<uint32_t>(extras, strs.add(m.name));
+            extras.push_back(m.bitOffset);
+            extras.push_back(m.bitWidth);
+        }
+    }
+
+    // Class index: each root struct with its subtree's record indices.
+    const std::vector<int> root = rootsOf(tree);
+    QHash<int, int> classOf;   // root record → class number
+    std::vector<int> classRoots;
+    for (int i = 0; i < n; ++i) {
+        const Node& node = tree.nodes[i];
+        if (node.parentId == 0 && node.kind == NodeKind::Struct) {
+            classOf.insert(i, int(classRoots.size()));
+            classRoots.push_back(i);
+        }
+    }
+    std::vector<std::vector<uint32_t>> members(classRoots.size());
+    for (int i = 0; i < n; ++i) {
+        auto it = classOf.constFind(root[size_t(i)]);
+        if (it != classOf.constEnd()) members[size_t(*it)].push_back(uint32_t(i));
+    }
+    std::vector<uint8_t> classes, memberIdx;
+    for (size_t c = 0; c < classRoots.size(); ++c) {
+        putLE<uint32_t>(classes, uint32_t(classRoots[c]));
+        putLE<uint32_t>(classes, uint32_t(memberIdx.size() / 4));
+        putLE<uint32_t>(classes, uint32_t(members[c].size()));
+        for (uint32_t m : members[c]) putLE<uint32_t>(memberIdx, m);
+    }
+
+    std::vector<uint8_t> strings;
+    putLE<uint32_t>(strings, uint32_t(strs.offsets.size() - 1));
+    for (uint32_t off : strs.offsets) putLE<uint32_t>(strings, off);
+    strings.insert(strings.end(), strs.bytes.constData(), strs.bytes.constData() + strs.bytes.size());
+
+    std::vector<uint8_t> out(kHeaderBytes, 0);
+    std::memcpy(out.data(), kMagic, sizeof(kMagic));
+    setLE<uint32_t>(out, H_Version, kVersion);
+    setLE<uint32_t>(out, H_KindCount, kindCount);
+    auto section = [&out](int offField, const uint8_t* data, size_t len) {
+        alignTo8(out);
+        setLE<uint64_t>(out, offField, uint64_t(out.size()));
+        out.insert(out.end(), data, data + len);
+    };
+    section(H_MetaOff, reinterpret_cast<const uint8_t*>(metaJson.constData()), size_t(metaJson.size()));
+    setLE<uint64_t>(out, H_MetaLen, uint64_t(metaJson.size()));
+    section(H_StrOff, strings.data(), strings.size());
+    setLE<uint64_t>(out, H_StrLen, uint64_t(strings.size()));
+    section(H_NodeOff, nodes.data(), nodes.size());
+    setLE<uint64_t>(out, H_NodeCount, uint64_t(n));
+    section(H_ExtraOff, extras.data(), extras.size());
+    setLE<uint64_t>(out, H_ExtraLen, uint64_t(extras.size()));
+    section(H_ClassOff, classes.data(), classes.size());
+    setLE<uint64_t>(out, H_ClassCount, uint64_t(classRoots.size()));
+    section(H_MemberOff, memberIdx.data(), memberIdx.size());
+    setLE<uint64_t>(out, H_MemberCount, uint64_t(memberIdx.size() / 4));
+    return QByteArray(reinterpret_cast<const char*>(out.data()), int(out.size()));
+}
+
+bool isRcxb(const QByteArray& head) {
+    return head.size() >= int(sizeof(kMagic))
+        && std::memcmp(head.constData(), kMagic, sizeof(kMagic)) == 0;
+}
+
+// ── Reader ──
+
+bool RcxbReader::open(const QString& path, QString* err) {
+    close();
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        if (err) *err = m_file.errorString();
+        return false;
+    }
+    const qint64 size = m_file.size();
+    m_map = size > 0 ? m_file.map(0, size) : nullptr;
+    if (!m_map) {
+        if (err) *err = size > 0 ? m_file.errorString() : QStringLiteral("Empty file");
+        close();
+        return false;
+    }
+    m_data = m_map;
+    m_size = uint64_t(size);
+    if (!validate(err)) { close(); return false; }
+    return true;
+}
+
+bool RcxbReader::openBytes(const QByteArray& bytes, QString* err) {
+    close();
+    m_bytes = bytes;
+    m_data = reinterpret_cast<const uchar*>(m_bytes.constData());
+    m_size = uint64_t(m_bytes.size());
+    if (!validate(err)) { close(); return false; }
+    return true;
+}
+
+void RcxbReader::close() {
+    if (m_map) m_file.unmap(m_map);
+    m_map = nullptr;
+    if (m_file.isOpen()) m_file.close();
+    m_bytes.clear();
+    m_data = nullptr;
+    m_size = 0;
+    m_nodeCount = m_classCount = m_memberCount = m_strCount = 0;
+    m_kinds.clear();
+}
+
+bool RcxbReader::validate(QString* err) {
+    auto fail = [err](const char* what) {
+        if (err) *err = QString::fromLatin1(what);
+        return false;
+    };
+    if (m_size < uint64_t(kHeaderBytes) || std::memcmp(m_data, kMagic, sizeof(kMagic)) != 0)
+        return fail("Not a Reclass binary project");
+    if (getLE<uint32_t>(m_data + H_Version) != kVersion)
+        return fail("Unsupported .rcxb version");
+
+    auto u64 = [this](int at) { return getLE<uint64_t>(m_data + at); };
+    // Each section must lie inside the file; `count * unit` is checked
+    // against the remaining size so it can't overflow.
+    auto inFile = [this](uint64_t off, uint64_t count, uint64_t unit) {
+        return off <= m_size && count <= (m_size - off) / unit;
+    };
+    m_kindCount = getLE<uint32_t>(m_data + H_KindCount);
+    m_metaOff = u64(H_MetaOff);     m_metaLen = u64(H_MetaLen);
+    m_strOff = u64(H_StrOff);       m_strLen = u64(H_StrLen);
+    m_nodeOff = u64(H_NodeOff);     m_nodeCount = u64(H_NodeCount);
+    m_extraOff = u64(H_ExtraOff);   m_extraLen = u64(H_ExtraLen);
+    m_classOff = u64(H_ClassOff);   m_classCount = u64(H_ClassCount);
+    m_memberOff = u64(H_MemberOff); m_memberCount = u64(H_MemberCount);
+    if (!inFile(m_metaOff, m_metaLen, 1) || !inFile(m_strOff, m_strLen, 1)
+        || !inFile(m_nodeOff, m_nodeCount, kNodeBytes) || !inFile(m_extraOff, m_extraLen, 1)
+        || !inFile(m_classOff, m_classCount, kClassBytes)
+        || !inFile(m_memberOff, m_memberCount, 4)
+        || m_nodeCount > uint64_t(INT_MAX) || m_classCount > uint64_t(INT_MAX))
+        return fail("Truncated .rcxb section table");
+
+    if (m_strLen < 8) return fail("Truncated .rcxb string table");
+    m_strCount = getLE<uint32_t>(m_data + m_strOff);
+    if ((m_strLen - 4) / 4 < m_strCount + 1 || m_strCount <= m_kindCount)
+        return fail("Truncated .rcxb string table");
+
+    m_kinds.resize(int(m_kindCount));
+    for (uint32_t k = 0; k < m_kindCount; ++k)
+        m_kinds[int(k)] = kindFromString(string(1 + k));
+    return true;
+}
+
+QString RcxbReader::string(uint32_t id) const {
+    if (id == 0 || id >= m_strCount) return {};
+    const uchar* offs = m_data + m_strOff + 4;
+    const uint64_t bytesOff = 4 + 4 * (m_strCount + 1);
+    const uint32_t from = getLE<uint32_t>(offs + 4 * id);
+    const uint32_t to = getLE<uint32_t>(offs + 4 * (id + 1));
+    if (from > to || bytesOff + to > m_strLen) return {};
+    return QString::fromUtf8(reinterpret_cast<const char*>(m_data + m_strOff + bytesOff + from),
+                             int(to - from));
+}
+
+QJsonObject RcxbReader::meta() const {
+    if (!m_data) return {};
+    const QByteArray json = QByteArray::fromRawData(
+        reinterpret_cast<const char*>(m_data + m_metaOff), int(m_metaLen));
+    return QJsonDocument::fromJson(json).object();
+}
+
+// Field clamps match Node::fromJson, so a hand-edited or damaged file
+// can't produce a node the JSON loader would have refused.
+Node RcxbReader::decodeNode(uint32_t index, const QVector<QString>* strings) const {
+    const uchar* r = m_data + m_nodeOff + uint64_t(index) * kNodeBytes;
+    auto str = [&](uint32_t id) {
+        if (strings) return id < uint32_t(strings->size()) ? strings->at(int(id)) : QString();
+        return string(id);
+    };
+    auto kind = [this](uint8_t k) {
+        return k < m_kinds.size() ? m_kinds[k] : NodeKind::Hex8;
+    };
+
+    Node n;
+    n.id          = getLE<uint64_t>(r + N_Id);
+    n.parentId    = getLE<uint64_t>(r + N_Parent);
+    n.refId       = getLE<uint64_t>(r + N_Ref);
+    n.name        = str(getLE<uint32_t>(r + N_Name));
+    n.structTypeName = str(getLE<uint32_t>(r + N_Type));
+    n.classKeyword = str(getLE<uint32_t>(r + N_Keyword));
+    n.comment     = str(getLE<uint32_t>(r + N_Comment));
+    n.offset      = getLE<int32_t>(r + N_Offset);
+    n.arrayLen    = qBound(1, getLE<int32_t>(r + N_ArrayLen), kMaxArrayLen);
+    n.strLen      = qBound(1, getLE<int32_t>(r + N_StrLen), 1000000);
+    n.kind        = kind(r[N_Kind]);
+    n.elementKind = kind(r[N_ElemKind]);
+    n.ptrDepth    = qBound(0, int(r[N_PtrDepth]), 2);
+    n.isRelative  = r[N_Flags] & F_Relative;
+    n.bigEndian   = r[N_Flags] & F_BigEndian;
+    n.collapsed   = true;
+
+    const uint64_t enumCount = getLE<uint32_t>(r + N_EnumCount);
+    const uint64_t bitCount = getLE<uint32_t>(r + N_BitCount);
+    if (enumCount || bitCount) {
+        const uint64_t at = getLE<uint32_t>(r + N_Extras);
+        if (at <= m_extraLen
+            && enumCount * kEnumBytes + bitCount * kBitBytes <= m_extraLen - at) {
+            const uchar* p = m_data + m_extraOff + at;
+            n.enumMembers.reserve(int(enumCount));
+            for (uint64_t i = 0; i < enumCount; ++i, p += kEnumBytes)
+                n.enumMembers.emplaceBack(str(getLE<uint32_t>(p)), getLE<int64_t>(p + 4));
+            n.bitfieldMembers.reserve(int(bitCount));
+            for (uint64_t i = 0; i < bitCount; ++i, p += kBitBytes) {
+                BitfieldMember m;
+                m.name = str(getLE<uint32_t>(p));
+                m.bitOffset = p[4];
+                m.bitWidth = uint8_t(qBound(1, int(p[5]), 64));
+                n.bitfieldMembers.append(m);
+            }
+        }
+    }
+    return n;
+}
+
+RcxbReader::ClassInfo RcxbReader::classInfo(int i) const {
+    ClassInfo info;
+    if (i < 0 || uint64_t(i) >= m_classCount) return info;
+    const uchar* c = m_data + m_classOff + uint64_t(i) * kClassBytes;
+    const uint32_t rootIdx = getLE<uint32_t>(c);
+    if (rootIdx >= m_nodeCount) return info;
+    const uchar* r = m_data + m_nodeOff + uint64_t(rootIdx) * kNodeBytes;
+    info.id = getLE<uint64_t>(r + N_Id);
+    info.name = string(getLE<uint32_t>(r + N_Type));
+    if (info.name.isEmpty()) info.name = string(getLE<uint32_t>(r + N_Name));
+    info.nodeCount = int(getLE<uint32_t>(c + 8));
+    return info;
+}
+
+int RcxbReader::findClass(const QString& name) const {
+    for (int i = 0; i < classCount(); ++i)
+        if (classInfo(i).name == name) return i;
+    return -1;
+}
+
+QVector<Node> RcxbReader::readClass(int i) const {
+    QVector<Node> out;
+    if (i < 0 || uint64_t(i) >= m_classCount) return out;
+    const uchar* c = m_data + m_classOff + uint64_t(i) * kClassBytes;
+    const uint64_t first = getLE<uint32_t>(c + 4);
+    const uint64_t count = getLE<uint32_t>(c + 8);
+    if (first > m_memberCount || count > m_memberCount - first) return out;
+    out.reserve(int(count));
+    for (uint64_t k = 0; k < count; ++k) {
+        const uint32_t idx = getLE<uint32_t>(m_data + m_memberOff + 4 * (first + k));
+        if (idx < m_nodeCount) out.append(decodeNode(idx, nullptr));
+    }
+    return out;
+}
+
+QVector<QString> RcxbReader::decodeStrings() const {
+    // Names repeat heavily (field names, type names), so decode each string
+    // once and let the nodes share it.
+    QVector<QString> strings(int(m_strCount));
+    for (uint32_t s = 1; s < m_strCount; ++s) strings[int(s)] = string(s);
+    return strings;
+}
+
+bool RcxbReader::bodyRecords(int i, QVector<uint32_t>& out) const {
+    out.clear();
+    if (i < 0 || uint64_t(i) >= m_classCount) return false;
+    const uchar* c = m_data + m_classOff + uint64_t(i) * kClassBytes;
+    const uint32_t rootIdx = getLE<uint32_t>(c);
+    const uint64_t first = getLE<uint32_t>(c + 4);
+    const uint64_t count = getLE<uint32_t>(c + 8);
+    if (first > m_memberCount || count > m_memberCount - first) return false;
+    out.reserve(int(count));
+    for (uint64_t k = 0; k < count; ++k) {
+        const uint32_t idx = getLE<uint32_t>(m_data + m_memberOff + 4 * (first + k));
+        if (idx < m_nodeCount && idx != rootIdx) out.append(idx);
+    }
+    return true;
+}
+
+QVector<Node> RcxbReader::readClassBody(int i) const {
+    QVector<Node> out;
+    QVector<uint32_t> records;
+    if (!bodyRecords(i, records)) return out;
+    out.reserve(records.size());
+    for (uint32_t idx : records) out.append(decodeNode(idx, nullptr));
+    return out;
+}
+
+QVector<QVector<Node>> RcxbReader::readClassBodies(const QVector<int>& classes) const {
+    QVector<QVector<Node>> out(classes.size());
+    if (!m_data) return out;
+    const QVector<QString> strings = decodeStrings();
+    QVector<uint32_t> records;
+    for (int c = 0; c < classes.size(); ++c) {
+        if (!bodyRecords(classes[c], records)) continue;
+        QVector<Node>& body = out[c];
+        body.reserve(records.size());
+        for (uint32_t idx : records) body.append(decodeNode(idx, &strings));
+    }
+    return out;
+}
+
+NodeTree RcxbReader::readTree() const {
+    NodeTree t;
+    if (!m_data) return t;
+    t.readHeaderJson(meta());
+
+    const QVector<QString> strings = decodeStrings();
+    t.nodes.reserve(int(m_nodeCount));
+    for (uint64_t i = 0; i < m_nodeCount; ++i) {
+        t.nodes.append(decodeNode(uint32_t(i), &strings));
+        const uint64_t id = t.nodes.last().id;
+        if (id >= t.m_nextId) t.m_nextId = id + 1;
+    }
+    return t;
+}
+
+NodeTree RcxbReader::readSkeleton() const {
+    NodeTree t;
+    if (!m_data) return t;
+    t.readHeaderJson(meta());
+
+    // Only record indices and ids are touched here; strings are decoded
+    // per node, for the few nodes that stay.
+    std::vector<bool> inBody(size_t(m_nodeCount), false);
+    QVector<uint32_t> records;
+    for (int c = 0; c < classCount(); ++c) {
+        bodyRecords(c, records);
+        for (uint32_t idx : records) inBody[idx] = true;
+    }
+    for (uint64_t i = 0; i < m_nodeCount; ++i) {
+        const uint64_t id = getLE<uint64_t>(m_data + m_nodeOff + i * kNodeBytes + N_Id);
+        if (id >= t.m_nextId) t.m_nextId = id + 1;
+        if (!inBody[size_t(i)]) t.nodes.append(decodeNode(uint32_t(i), nullptr));
+    }
+    return t;
+}
+
+} // namespace rcx
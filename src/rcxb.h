@@ -0,0 +1,106 @@
+#pragma once
+#include "core.h"
+#include <QFile>
+#include <QJsonObject>
+
+namespace rcx {
+
+// ── Binary project format (.rcxb) ──
+//
+// The same project a .rcx holds, laid out so loading is a walk over
+// fixed-size records instead of a JSON parse plus a Node per JSON object.
+// Layout (little-endian, every section 8-byte aligned):
+//
+//   header   "RCXB", u32 version, u32 kindCount, then u64 offset/size pairs
+//   meta     compact JSON: every project key except "nodes" — the tree's
+//            header (NodeTree::headerJson) plus document keys such as
+//            typeAliases and savedSources
+//   strings  u32 count, u32 offsets[count + 1], UTF-8 bytes. String 0 is "",
+//            strings 1..kindCount name the NodeKinds that node records index,
+//            so reordering the enum doesn't invalidate old files
+//   nodes    72-byte records in tree order; names are string ids
+//   extras   enum members (u32 name, i64 value) and bitfield members
+//            (u32 name, u8 bitOffset, u8 bitWidth) the records point into
+//   classes  one entry per root struct: u32 root record, u32 first member,
+//            u32 member count
+//   members  u32 record indices — each class's subtree, in tree order
+//
+// JSON → .rcxb → JSON gives back the same project. The class index lets a
+// reader pull one class out of a mapped file without decoding the others:
+// RcxDocument::load takes readSkeleton() and decodes each class body when
+// the class is first opened or referenced (RcxDocument::ensureClassLoaded).
+
+// Serializes `tree` and the project-level keys in `meta` (anything besides
+// the tree that a project file carries).
+QByteArray encodeRcxb(const NodeTree& tree, const QJsonObject& meta = {});
+
+// True if `head` (at least the first 4 bytes of a file) is an .rcxb header.
+bool isRcxb(const QByteArray& head);
+
+class RcxbReader {
+public:
+    struct ClassInfo {
+        uint64_t id = 0;
+        QString  name;        // structTypeName, else the node name
+        int      nodeCount = 0;
+    };
+
+    RcxbReader() = default;
+    ~RcxbReader() { close(); }
+    RcxbReader(const RcxbReader&) = delete;
+    RcxbReader& operator=(const RcxbReader&) = delete;
+
+    // Maps `path` and validates the section table. Nothing is decoded yet.
+    bool open(const QString& path, QString* err = nullptr);
+    // Same over bytes already in memory; the reader keeps a reference.
+    bool openBytes(const QByteArray& bytes, QString* err = nullptr);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+
+    QJsonObject meta() const;
+    int nodeCount() const { return int(m_nodeCount); }
+    int classCount() const { return int(m_classCount); }
+    ClassInfo classInfo(int i) const;
+    // Index of the class named `name` (see ClassInfo::name), or -1.
+    int findClass(const QString& name) const;
+
+    // The class's root and its whole subtree, in tree order.
+    QVector<Node> readClass(int i) const;
+    // The class's subtree without its root: what readSkeleton() leaves out.
+    QVector<Node> readClassBody(int i) const;
+    // readClassBody() for each of `classes`, sharing one decoded string
+    // table. Safe on a pool thread while nothing closes the reader.
+    QVector<QVector<Node>> readClassBodies(const QVector<int>& classes) const;
+    // Every node, meta applied: the NodeTree the JSON form would load.
+    NodeTree readTree() const;
+    // readTree() minus the class bodies: class roots and nodes that belong
+    // to no class, in record order. New ids start past every record in the
+    // file, so bodies decoded later can't collide with them.
+    NodeTree readSkeleton() const;
+
+private:
+    bool validate(QString* err);
+    QString string(uint32_t id) const;
+    Node decodeNode(uint32_t index, const QVector<QString>* strings) const;
+    QVector<QString> decodeStrings() const;
+    // Record indices of class i's members, root excluded; false if the
+    // index entry is out of range.
+    bool bodyRecords(int i, QVector<uint32_t>& out) const;
+
+    QFile        m_file;
+    uchar*       m_map = nullptr;
+    QByteArray   m_bytes;
+    const uchar* m_data = nullptr;
+    uint64_t     m_size = 0;
+
+    uint32_t m_kindCount = 0;
+    uint64_t m_metaOff = 0, m_metaLen = 0;
+    uint64_t m_strOff = 0, m_strLen = 0, m_strCount = 0;
+    uint64_t m_nodeOff = 0, m_nodeCount = 0;
+    uint64_t m_extraOff = 0, m_extraLen = 0;
+    uint64_t m_classOff = 0, m_classCount = 0;
+    uint64_t m_memberOff = 0, m_memberCount = 0;
+    QVector<NodeKind> m_kinds;   // stored kind index → NodeKind
+};
+
+} // namespace rcx
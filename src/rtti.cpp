@@ -36,6 +36,33 @@ OwningModule findOwningModule(const Provider& prov, uint64_t addr) {
     return out;
 }
 
+// ── Cross-pass cache ──
+
+const RttiInfo& RttiCache::insert(uint64_t vtableAddr, const RttiInfo& info) {
+    if (m_entries.size() >= kMaxEntries)
+        m_entries.clear();
+    return m_entries.insert(vtableAddr, info).value();
+}
+
+void RttiCache::syncModules(const Provider& prov) {
+    // Bases and sizes are what module membership is decided on; names
+    // can't change without one of them changing too.
+    uint64_t key = 0xCBF29CE484222325ULL;
+    for (const auto& m : prov.modulesCached()) {
+        key = (key ^ m.base) * 0x100000001B3ULL;
+        key = (key ^ m.size) * 0x100000001B3ULL;
+    }
+    if (m_keyed && key == m_moduleKey) return;
+    m_entries.clear();
+    m_moduleKey = key;
+    m_keyed = true;
+}
+
+void RttiCache::clear() {
+    m_entries.clear();
+    m_keyed = false;
+}
+
 // ── Demangler ──
 
 QString demangleRttiName(const QString& mangled) {
@@ -133,6 +160,7 @@ RttiInfo walkRtti(const Provider& prov, uint64_t vtableAddr,
     }
     if (!ok || colAddr == 0) {
         info.error = QStringLiteral("could not read meta pointer at vtable[-1]");
+        info.readFailed = !ok;
         return info;
     }
     info.completeLocator = colAddr;
@@ -163,6 +191,7 @@ RttiInfo walkRtti(const Provider& prov, uint64_t vtableAddr,
     uint32_t sig = readU32At(prov, colAddr + 0x00, &sig_ok);
     if (!sig_ok) {
         info.error = QStringLiteral("could not read COL signature");
+        info.readFailed = true;
         return info;
     }
     if (sig != 0 && sig != 1) {
@@ -178,6 +207,7 @@ RttiInfo walkRtti(const Provider& prov, uint64_t vtableAddr,
     uint32_t chdField = readU32At(prov, colAddr + 0x10, &chd_ok);
     if (!td_ok || !chd_ok) {
         info.error = QStringLiteral("could not read COL TypeDescriptor / CHD fields");
+        info.readFailed = true;
         return info;
     }
 
@@ -206,6 +236,7 @@ RttiInfo walkRtti(const Provider& prov, uint64_t vtableAddr,
     uint32_t bcaField = readU32At(prov, chdAddr + 0x0C, &bca_ok);
     if (!nb_ok || !bca_ok) {
         info.error = QStringLiteral("could not read CHD");
+        info.readFailed = true;
         return info;
     }
     if (numBases > 256) {
@@ -377,6 +408,7 @@ RttiInfo walkRttiItanium(const Provider& prov, uint64_t vtableAddr,
     }
     if (!ok || tiAddr == 0) {
         info.error = QStringLiteral("could not read type_info pointer at vtable[-1]");
+        info.readFailed = !ok;
         return info;
     }
 
@@ -420,12 +452,14 @@ RttiInfo walkRttiItanium(const Provider& prov, uint64_t vtableAddr,
     if (pointerSize == 8) {
         if (!prov.read(tiAddr, &tiVtable, 8)) {
             info.error = QStringLiteral("could not read type_info vtable ptr");
+            info.readFailed = true;
             return info;
         }
     } else {
         uint32_t v = 0;
         if (!prov.read(tiAddr, &v, 4)) {
             info.error = QStringLiteral("could not read type_info vtable ptr");
+            info.readFailed = true;
             return info;
         }
         tiVtable = v;
@@ -441,12 +475,14 @@ RttiInfo walkRttiItanium(const Provider& prov, uint64_t vtableAddr,
     if (pointerSize == 8) {
         if (!prov.read(nameAddr, &namePtr, 8)) {
             info.error = QStringLiteral("could not read __name pointer");
+            info.readFailed = true;
             return info;
         }
     } else {
         uint32_t v = 0;
         if (!prov.read(nameAddr, &v, 4)) {
             info.error = QStringLiteral("could not read __name pointer");
+            info.readFailed = true;
             return info;
         }
         namePtr = v;
@@ -1,6 +1,7 @@
 #pragma once
 #include <QString>
 #include <QVector>
+#include <QHash>
 #include <cstdint>
 
 namespace rcx {
@@ -42,6 +43,8 @@ struct RttiVirtualMethod {
 struct RttiInfo {
     bool     ok = false;
     QString  error;
+    bool     readFailed = false;  // ok=false because a read failed, not because
+                                  // the bytes aren't RTTI; may walk next time
     QString  abi;                 // "MSVC" / "Itanium" — empty when ok=false
     uint64_t vtableAddress = 0;
     uint64_t imageBase = 0;       // module that owns the COL (MSVC) / type_info (Itanium)
@@ -104,4 +107,40 @@ struct OwningModule {
 };
 OwningModule findOwningModule(const Provider& prov, uint64_t addr);
 
+// Vtable → RttiInfo memo that outlives a compose pass. The chain a vtable
+// leads to lives in module image memory, so once walked (successfully or
+// not) it stays walked for as long as the module list is the same. The
+// controller owns one per view and passes it to every compose; without it
+// compose keeps a throwaway cache per pass and re-walks every tick.
+//
+// syncModules() runs once per pass: when the provider's module list no
+// longer matches the one the entries were resolved against (a module was
+// loaded or unloaded and Provider::invalidateModuleCache() re-enumerated,
+// or the target was re-attached) every entry is dropped. Negative entries
+// — arbitrary qwords that happen to land inside a module — are what keep
+// the cache large on busy targets, so it is also cleared outright past
+// kMaxEntries instead of growing for the life of the session.
+//
+// Only settled answers belong here: a walk that failed on a read
+// (RttiInfo::readFailed — a page not yet committed or paged out) is kept
+// for the current pass only, so the next tick walks it again.
+class RttiCache {
+public:
+    static constexpr int kMaxEntries = 1 << 16;
+
+    const RttiInfo* find(uint64_t vtableAddr) const {
+        auto it = m_entries.constFind(vtableAddr);
+        return it == m_entries.constEnd() ? nullptr : &it.value();
+    }
+    const RttiInfo& insert(uint64_t vtableAddr, const RttiInfo& info);
+    void syncModules(const Provider& prov);
+    void clear();
+    int  size() const { return m_entries.size(); }
+
+private:
+    QHash<uint64_t, RttiInfo> m_entries;
+    uint64_t m_moduleKey = 0;      // fingerprint of the resolving module list
+    bool     m_keyed = false;
+};
+
 } // namespace rcx
@@ -0,0 +1,458 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+// Vectorized inner loops for the first-scan matchers in scanner.cpp.
+//
+// Every kernel answers the same question: "starting at `from` and stepping
+// by `alignment`, which is the first position i <= `last` that matches?"
+// and returns -1 when none does. The caller guarantees the buffer holds the
+// full match window at every such position (i.e. last + width <= len).
+//
+// Each kernel has a scalar version — the reference semantics, identical to
+// the loops scanner.cpp ran before these existed — plus SSE2 and AVX2
+// versions picked at runtime from cpuSimdLevel(). The vector versions test
+// one 16/32-byte block per iteration, keep only lanes that sit on the
+// alignment grid, and hand the block-misaligned tail back to the scalar
+// loop. Shapes a vector version can't express (alignment not dividing the
+// block, 64-bit integer compares on plain SSE2) fall through to scalar.
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define RCX_SCAN_X86 1
+#include <immintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#if defined(RCX_SCAN_X86) && (defined(__GNUC__) || defined(__clang__))
+#define RCX_TARGET_SSE2 __attribute__((target("sse2")))
+#define RCX_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define RCX_TARGET_SSE2
+#define RCX_TARGET_AVX2
+#endif
+
+namespace rcx {
+
+enum class SimdLevel { Scalar, SSE2, AVX2 };
+
+// Lane types the range kernel understands (4- and 8-byte little-endian).
+enum class LaneType { I32, U32, F32, I64, U64, F64 };
+
+// Typed-constant predicates of the first scan. NaN handling matches
+// compareTyped: NaN is never Greater/Less, and always inside Between.
+enum class RangeOp { Greater, Less, Between };
+
+inline int laneWidth(LaneType t) {
+    return (t == LaneType::I32 || t == LaneType::U32 || t == LaneType::F32) ? 4 : 8;
+}
+
+namespace detail {
+
+inline SimdLevel detectSimdLevel() {
+#if !defined(RCX_SCAN_X86)
+    return SimdLevel::Scalar;
+#elif defined(_MSC_VER)
+    int r[4];
+    __cpuid(r, 0);
+    if (r[0] < 7) return SimdLevel::SSE2;
+    __cpuid(r, 1);
+    const bool osxsave = (r[2] >> 27) & 1;
+    const bool avx     = (r[2] >> 28) & 1;
+    if (!osxsave || !avx) return SimdLevel::SSE2;
+    if ((_xgetbv(0) & 6) != 6) return SimdLevel::SSE2;   // OS saves YMM state
+    __cpuidex(r, 7, 0);
+    return ((r[1] >> 5) & 1) ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#endif
+}
+
+inline int lowBit(uint32_t m) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long idx;
+    _BitScanForward(&idx, m);
+    return (int)idx;
+#else
+    return __builtin_ctz(m);
+#endif
+}
+
+// Movemask bits for the lanes of one block that land on the alignment grid
+// (lane k starts k * laneBytes into the block; the block start is on-grid).
+inline uint32_t gridMask(int lanes, int laneBytes, int alignment) {
+    uint32_t m = 0;
+    for (int k = 0; k < lanes; ++k)
+        if ((k * laneBytes) % alignment == 0) m |= 1u << k;
+    return m;
+}
+
+inline bool maskedEqual(const uint8_t* d, const uint8_t* pat, const uint8_t* msk, int n) {
+    for (int j = 0; j < n; j++)
+        if ((d[j] & msk[j]) != (pat[j] & msk[j])) return false;
+    return true;
+}
+
+// The two pattern bytes the masked kernel pre-filters on: first and last
+// fully-specified byte, else first and last partially-masked one. Returns
+// false when every byte is a wildcard.
+inline bool pickAnchors(const uint8_t* msk, int n, int* a1, int* a2) {
+    *a1 = *a2 = -1;
+    for (int j = 0; j < n; j++)
+        if (msk[j] == 0xFF) { if (*a1 < 0) *a1 = j; *a2 = j; }
+    if (*a1 >= 0) return true;
+    for (int j = 0; j < n; j++)
+        if (msk[j]) { if (*a1 < 0) *a1 = j; *a2 = j; }
+    return *a1 >= 0;
+}
+
+template <typename T>
+inline int findInRangeScalarT(const uint8_t* d, int from, int last, int alignment,
+                              RangeOp op, const uint8_t* lo, const uint8_t* hi) {
+    T l, h{};
+    memcpy(&l, lo, sizeof(T));
+    if (op == RangeOp::Between) memcpy(&h, hi, sizeof(T));
+    for (int i = from; i <= last; i += alignment) {
+        T v;
+        memcpy(&v, d + i, sizeof(T));
+        bool ok;
+        if (op == RangeOp::Greater)   ok = v > l;
+        else if (op == RangeOp::Less) ok = v < l;
+        else                          ok = !(v < l) && !(v > h);
+        if (ok) return i;
+    }
+    return -1;
+}
+
+} // namespace detail
+
+// Cached CPU probe; SSE2 is the x86-64 baseline, AVX2 needs CPU + OS support.
+inline SimdLevel cpuSimdLevel() {
+    static const SimdLevel level = detail::detectSimdLevel();
+    return level;
+}
+
+// ── Aligned equality: `width` (4 or 8) exact bytes, alignment % width == 0 ──
+
+inline int findEqualScalar(const uint8_t* d, int from, int last, int alignment,
+                           const uint8_t* pat, int width) {
+    for (int i = from; i <= last; i += alignment)
+        if (memcmp(d + i, pat, width) == 0) return i;
+    return -1;
+}
+
+// ── Masked signature: (d[j] & msk[j]) == (pat[j] & msk[j]) for all j ──
+
+inline int findMaskedScalar(const uint8_t* d, int from, int last, int alignment,
+                            const uint8_t* pat, const uint8_t* msk, int patLen) {
+    for (int i = from; i <= last; i += alignment)
+        if (detail::maskedEqual(d + i, pat, msk, patLen)) return i;
+    return -1;
+}
+
+// ── Typed range: value at i compared against lo (and hi for Between) ──
+
+inline int findInRangeScalar(const uint8_t* d, int from, int last, int alignment,
+                             LaneType t, RangeOp op, const uint8_t* lo, const uint8_t* hi) {
+    switch (t) {
+    case LaneType::I32: return detail::findInRangeScalarT<int32_t>(d, from, last, alignment, op, lo, hi);
+    case LaneType::U32: return detail::findInRangeScalarT<uint32_t>(d, from, last, alignment, op, lo, hi);
+    case LaneType::F32: return detail::findInRangeScalarT<float>(d, from, last, alignment, op, lo, hi);
+    case LaneType::I64: return detail::findInRangeScalarT<int64_t>(d, from, last, alignment, op, lo, hi);
+    case LaneType::U64: return detail::findInRangeScalarT<uint64_t>(d, from, last, alignment, op, lo, hi);
+    case LaneType::F64: return detail::findInRangeScalarT<double>(d, from, last, alignment, op, lo, hi);
+    }
+    return -1;
+}
+
+#ifdef RCX_SCAN_X86
+
+// ── SSE2 ──
+
+RCX_TARGET_SSE2
+inline int findEqualSse2(const uint8_t* d, int from, int last, int alignment,
+                         const uint8_t* pat, int width) {
+    if (alignment % width || 16 % alignment)
+        return findEqualScalar(d, from, last, alignment, pat, width);
+    const uint32_t grid = detail::gridMask(16 / width, width, alignment);
+    uint32_t lo32, hi32 = 0;
+    memcpy(&lo32, pat, 4);
+    if (width == 8) memcpy(&hi32, pat + 4, 4);
+    const __m128i needle = (width == 4)
+        ? _mm_set1_epi32((int)lo32)
+        : _mm_set_epi32((int)hi32, (int)lo32, (int)hi32, (int)lo32);
+    int i = from;
+    for (; i + 16 - width <= last; i += 16) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(d + i)), needle);
+        uint32_t m;
+        if (width == 4) {
+            m = (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(eq));
+        } else {
+            // No 64-bit compare in SSE2: a qword matches when both dwords do.
+            eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+            m = (uint32_t)_mm_movemask_pd(_mm_castsi128_pd(eq));
+        }
+        m &= grid;
+        if (m) return i + detail::lowBit(m) * width;
+    }
+    return findEqualScalar(d, i, last, alignment, pat, width);
+}
+
+RCX_TARGET_SSE2
+inline int findMaskedSse2(const uint8_t* d, int from, int last, int alignment,
+                          const uint8_t* pat, const uint8_t* msk, int patLen) {
+    int a1, a2;
+    if (16 % alignment || !detail::pickAnchors(msk, patLen, &a1, &a2))
+        return findMaskedScalar(d, from, last, alignment, pat, msk, patLen);
+    const uint32_t grid = detail::gridMask(16, 1, alignment);
+    const __m128i m1 = _mm_set1_epi8((char)msk[a1]);
+    const __m128i v1 = _mm_set1_epi8((char)(pat[a1] & msk[a1]));
+    const __m128i m2 = _mm_set1_epi8((char)msk[a2]);
+    const __m128i v2 = _mm_set1_epi8((char)(pat[a2] & msk[a2]));
+    int i = from;
+    for (; i + 15 <= last; i += 16) {
+        __m128i e1 = _mm_cmpeq_epi8(_mm_and_si128(_mm_loadu_si128((const __m128i*)(d + i + a1)), m1), v1);
+        __m128i e2 = _mm_cmpeq_epi8(_mm_and_si128(_mm_loadu_si128((const __m128i*)(d + i + a2)), m2), v2);
+        uint32_t m = (uint32_t)_mm_movemask_epi8(_mm_and_si128(e1, e2)) & grid;
+        while (m) {
+            int k = detail::lowBit(m);
+            if (detail::maskedEqual(d + i + k, pat, msk, patLen)) return i + k;
+            m &= m - 1;
+        }
+    }
+    return findMaskedScalar(d, i, last, alignment, pat, msk, patLen);
+}
+
+RCX_TARGET_SSE2
+inline int findInRangeSse2(const uint8_t* d, int from, int last, int alignment,
+                           LaneType t, RangeOp op, const uint8_t* lo, const uint8_t* hi) {
+    const int w = laneWidth(t);
+    if (t == LaneType::I64 || t == LaneType::U64 || alignment % w || 16 % alignment)
+        return findInRangeScalar(d, from, last, alignment, t, op, lo, hi);
+    const int lanes = 16 / w;
+    const uint32_t all  = (1u << lanes) - 1;
+    const uint32_t grid = detail::gridMask(lanes, w, alignment);
+    int i = from;
+    if (t == LaneType::F32) {
+        float l, h = 0;
+        memcpy(&l, lo, 4);
+        if (op == RangeOp::Between) memcpy(&h, hi, 4);
+        const __m128 L = _mm_set1_ps(l), H = _mm_set1_ps(h);
+        for (; i + 16 - w <= last; i += 16) {
+            __m128 v = _mm_loadu_ps((const float*)(d + i));
+            uint32_t m;
+            if (op == RangeOp::Greater)   m = (uint32_t)_mm_movemask_ps(_mm_cmpgt_ps(v, L));
+            else if (op == RangeOp::Less) m = (uint32_t)_mm_movemask_ps(_mm_cmplt_ps(v, L));
+            else m = ~(uint32_t)_mm_movemask_ps(_mm_or_ps(_mm_cmplt_ps(v, L), _mm_cmpgt_ps(v, H))) & all;
+            m &= grid;
+            if (m) return i + detail::lowBit(m) * w;
+        }
+    } else if (t == LaneType::F64) {
+        double l, h = 0;
+        memcpy(&l, lo, 8);
+        if (op == RangeOp::Between) memcpy(&h, hi, 8);
+        const __m128d L = _mm_set1_pd(l), H = _mm_set1_pd(h);
+        for (; i + 16 - w <= last; i += 16) {
+            __m128d v = _mm_loadu_pd((const double*)(d + i));
+            uint32_t m;
+            if (op == RangeOp::Greater)   m = (uint32_t)_mm_movemask_pd(_mm_cmpgt_pd(v, L));
+            else if (op == RangeOp::Less) m = (uint32_t)_mm_movemask_pd(_mm_cmplt_pd(v, L));
+            else m = ~(uint32_t)_mm_movemask_pd(_mm_or_pd(_mm_cmplt_pd(v, L), _mm_cmpgt_pd(v, H))) & all;
+            m &= grid;
+            if (m) return i + detail::lowBit(m) * w;
+        }
+    } else {
+        // Unsigned compares ride the signed instruction with the sign bit flipped.
+        const uint32_t bias = (t == LaneType::U32) ? 0x80000000u : 0u;
+        uint32_t l, h = 0;
+        memcpy(&l, lo, 4);
+        if (op == RangeOp::Between) memcpy(&h, hi, 4);
+        const __m128i B = _mm_set1_epi32((int)bias);
+        const __m128i L = _mm_set1_epi32((int)(l ^ bias));
+        const __m128i H = _mm_set1_epi32((int)(h ^ bias));
+        for (; i + 16 - w <= last; i += 16) {
+            __m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(d + i)), B);
+            __m128i r;
+            if (op == RangeOp::Greater)   r = _mm_cmpgt_epi32(v, L);
+            else if (op == RangeOp::Less) r = _mm_cmpgt_epi32(L, v);
+            else r = _mm_or_si128(_mm_cmpgt_epi32(L, v), _mm_cmpgt_epi32(v, H));
+            uint32_t m = (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(r));
+            if (op == RangeOp::Between) m = ~m & all;
+            m &= grid;
+            if (m) return i + detail::lowBit(m) * w;
+        }
+    }
+    return findInRangeScalar(d, i, last, alignment, t, op, lo, hi);
+}
+
+// ── AVX2 ──
+
+RCX_TARGET_AVX2
+inline int findEqualAvx2(const uint8_t* d, int from, int last, int alignment,
+                         const uint8_t* pat, int width) {
+    if (alignment % width || 32 % alignment)
+        return findEqualScalar(d, from, last, alignment, pat, width);
+    const uint32_t grid = detail::gridMask(32 / width, width, alignment);
+    uint32_t lo32;
+    uint64_t q64 = 0;
+    memcpy(&lo32, pat, 4);
+    if (width == 8) memcpy(&q64, pat, 8);
+    const __m256i needle = (width == 4) ? _mm256_set1_epi32((int)lo32)
+                                        : _mm256_set1_epi64x((long long)q64);
+    int i = from;
+    for (; i + 32 - width <= last; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(d + i));
+        uint32_t m = (width == 4)
+            ? (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, needle)))
+            : (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(v, needle)));
+        m &= grid;
+        if (m) return i + detail::lowBit(m) * width;
+    }
+    return findEqualScalar(d, i, last, alignment, pat, width);
+}
+
+RCX_TARGET_AVX2
+inline int findMaskedAvx2(const uint8_t* d, int from, int last, int alignment,
+                          const uint8_t* pat, const uint8_t* msk, int patLen) {
+    int a1, a2;
+    if (32 % alignment || !detail::pickAnchors(msk, patLen, &a1, &a2))
+        return findMaskedScalar(d, from, last, alignment, pat, msk, patLen);
+    const uint32_t grid = detail::gridMask(32, 1, alignment);
+    const __m256i m1 = _mm256_set1_epi8((char)msk[a1]);
+    const __m256i v1 = _mm256_set1_epi8((char)(pat[a1] & msk[a1]));
+    const __m256i m2 = _mm256_set1_epi8((char)msk[a2]);
+    const __m256i v2 = _mm256_set1_epi8((char)(pat[a2] & msk[a2]));
+    int i = from;
+    for (; i + 31 <= last; i += 32) {
+        __m256i e1 = _mm256_cmpeq_epi8(_mm256_and_si256(_mm256_loadu_si256((const __m256i*)(d + i + a1)), m1), v1);
+        __m256i e2 = _mm256_cmpeq_epi8(_mm256_and_si256(_mm256_loadu_si256((const __m256i*)(d + i + a2)), m2), v2);
+        uint32_t m = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(e1, e2)) & grid;
+        while (m) {
+            int k = detail::lowBit(m);
+            if (detail::maskedEqual(d + i + k, pat, msk, patLen)) return i + k;
+            m &= m - 1;
+        }
+    }
+    return findMaskedScalar(d, i, last, alignment, pat, msk, patLen);
+}
+
+RCX_TARGET_AVX2
+inline int findInRangeAvx2(const uint8_t* d, int from, int last, int alignment,
+                           LaneType t, RangeOp op, const uint8_t* lo, const uint8_t* hi) {
+    const int w = laneWidth(t);
+    if (alignment % w || 32 % alignment)
+        return findInRangeScalar(d, from, last, alignment, t, op, lo, hi);
+    const int lanes = 32 / w;
+    const uint32_t all  = (1u << lanes) - 1;
+    const uint32_t grid = detail::gridMask(lanes, w, alignment);
+    int i = from;
+    if (t == LaneType::F32) {
+        float l, h = 0;
+        memcpy(&l, lo, 4);
+        if (op == RangeOp::Between) memcpy(&h, hi, 4);
+        const __m256 L = _mm256_set1_ps(l), H = _mm256_set1_ps(h);
+        for (; i + 32 - w <= last; i += 32) {
+            __m256 v = _mm256_loadu_ps((const float*)(d + i));
+            uint32_t m;
+            if (op == RangeOp::Greater)   m = (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(v, L, _CMP_GT_OQ));
+            else if (op == RangeOp::Less) m = (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(v, L, _CMP_LT_OQ));
+            else m = ~(uint32_t)_mm256_movemask_ps(_mm256_or_ps(_mm256_cmp_ps(v, L, _CMP_LT_OQ),
+                                                               _mm256_cmp_ps(v, H, _CMP_GT_OQ))) & all;
+            m &= grid;
+            if (m) return i + detail::lowBit(m) * w;
+        }
+    } else if (t == LaneType::F64) {
+        double l, h = 0;
+        memcpy(&l, lo, 8);
+        if (op == RangeOp::Between) memcpy(&h, hi, 8);
+        const __m256d L = _mm256_set1_pd(l), H = _mm256_set1_pd(h);
+        for (; i + 32 - w <= last; i += 32) {
+            __m256d v = _mm256_loadu_pd((const double*)(d + i));
+            uint32_t m;
+            if (op == RangeOp::Greater)   m = (uint32_t)_mm256_movemask_pd(_mm256_cmp_pd(v, L, _CMP_GT_OQ));
+            else if (op == RangeOp::Less) m = (uint32_t)_mm256_movemask_pd(_mm256_cmp_pd(v, L, _CMP_LT_OQ));
+            else m = ~(uint32_t)_mm256_movemask_pd(_mm256_or_pd(_mm256_cmp_pd(v, L, _CMP_LT_OQ),
+                                                               _mm256_cmp_pd(v, H, _CMP_GT_OQ))) & all;
+            m &= grid;
+            if (m) return i + detail::lowBit(m) * w;
+        }
+    } else if (w == 4) {
+        const uint32_t bias = (t == LaneType::U32) ? 0x80000000u : 0u;
+        uint32_t l, h = 0;
+        memcpy(&l, lo, 4);
+        if (op == RangeOp::Between) memcpy(&h, hi, 4);
+        const __m256i B = _mm256_set1_epi32((int)bias);
+        const __m256i L = _mm256_set1_epi32((int)(l ^ bias));
+        const __m256i H = _mm256_set1_epi32((int)(h ^ bias));
+        for (; i + 32 - w <= last; i += 32) {
+            __m256i v = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(d + i)), B);
+            __m256i r;
+            if (op == RangeOp::Greater)   r = _mm256_cmpgt_epi32(v, L);
+            else if (op == RangeOp::Less) r = _mm256_cmpgt_epi32(L, v);
+            else r = _mm256_or_si256(_mm256_cmpgt_epi32(L, v), _mm256_cmpgt_epi32(v, H));
+            uint32_t m = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(r));
+            if (op == RangeOp::Between) m = ~m & all;
+            m &= grid;
+            if (m) return i + detail::lowBit(m) * w;
+        }
+    } else {
+        const uint64_t bias = (t == LaneType::U64) ? 0x8000000000000000ull : 0ull;
+        uint64_t l, h = 0;
+        memcpy(&l, lo, 8);
+        if (op == RangeOp::Between) memcpy(&h, hi, 8);
+        const __m256i B = _mm256_set1_epi64x((long long)bias);
+        const __m256i L = _mm256_set1_epi64x((long long)(l ^ bias));
+        const __m256i H = _mm256_set1_epi64x((long long)(h ^ bias));
+        for (; i + 32 - w <= last; i += 32) {
+            __m256i v = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(d + i)), B);
+            __m256i r;
+            if (op == RangeOp::Greater)   r = _mm256_cmpgt_epi64(v, L);
+            else if (op == RangeOp::Less) r = _mm256_cmpgt_epi64(L, v);
+            else r = _mm256_or_si256(_mm256_cmpgt_epi64(L, v), _mm256_cmpgt_epi64(v, H));
+            uint32_t m = (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(r));
+            if (op == RangeOp::Between) m = ~m & all;
+            m &= grid;
+            if (m) return i + detail::lowBit(m) * w;
+        }
+    }
+    return findInRangeScalar(d, i, last, alignment, t, op, lo, hi);
+}
+
+#endif // RCX_SCAN_X86
+
+// ── Dispatch ──
+
+inline int findEqual(const uint8_t* d, int from, int last, int alignment,
+                     const uint8_t* pat, int width, SimdLevel level) {
+#ifdef RCX_SCAN_X86
+    if (level == SimdLevel::AVX2) return findEqualAvx2(d, from, last, alignment, pat, width);
+    if (level == SimdLevel::SSE2) return findEqualSse2(d, from, last, alignment, pat, width);
+#endif
+    (void)level;
+    return findEqualScalar(d, from, last, alignment, pat, width);
+}
+
+inline int findMasked(const uint8_t* d, int from, int last, int alignment,
+                      const uint8_t* pat, const uint8_t* msk, int patLen, SimdLevel level) {
+#ifdef RCX_SCAN_X86
+    if (level == SimdLevel::AVX2) return findMaskedAvx2(d, from, last, alignment, pat, msk, patLen);
+    if (level == SimdLevel::SSE2) return findMaskedSse2(d, from, last, alignment, pat, msk, patLen);
+#endif
+    (void)level;
+    return findMaskedScalar(d, from, last, alignment, pat, msk, patLen);
+}
+
+inline int findInRange(const uint8_t* d, int from, int last, int alignment,
+                       LaneType t, RangeOp op, const uint8_t* lo, const uint8_t* hi,
+                       SimdLevel level) {
+#ifdef RCX_SCAN_X86
+    if (level == SimdLevel::AVX2) return findInRangeAvx2(d, from, last, alignment, t, op, lo, hi);
+    if (level == SimdLevel::SSE2) return findInRangeSse2(d, from, last, alignment, t, op, lo, hi);
+#endif
+    (void)level;
+    return findInRangeScalar(d, from, last, alignment, t, op, lo, hi);
+}
+
+} // namespace rcx
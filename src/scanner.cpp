@@ -1,32 +1,412 @@
 #include "scanner.h"
+#include "scankernels.h"
 #include <QtConcurrent>
 #include <QMetaObject>
+#include <QMetaMethod>
 #include <QElapsedTimer>
 #include <QDebug>
 #include <QSet>
 #include <QFileInfo>
+#include <QDir>
+#include <QMutex>
+#include <QThread>
+#include <climits>
 #include <cstring>
 #include <cmath>
 #include <algorithm>
 
 namespace rcx {
 
-// Format a result's region context — used at every place we set
-// ScanResult.regionModule. For module-mapped regions, returns
-// "modulename.dll+0xOFFSET" so the user can see the in-module offset
-// (matches the windbg/IDA mental model). For unnamed regions (heap,
-// anonymous mappings, file-provider synthetic regions), returns an
-// empty string — the populateTable code only shows the Module column
-// when at least one result has a non-empty value, so an unnamed-region
-// scan won't get a useless column at all.
-static QString formatRegionContext(const MemoryRegion& region, uint64_t address) {
-    if (region.moduleName.isEmpty()) return QString();
-    uint64_t off = (address >= region.base) ? (address - region.base) : 0;
+// Format a result's region context — what ScanResult.regionModule holds.
+// For module-mapped regions, returns "modulename.dll+0xOFFSET" so the user
+// can see the in-module offset (matches the windbg/IDA mental model). For
+// unnamed regions (heap, anonymous mappings, file-provider synthetic
+// regions), returns an empty string — the populateTable code only shows
+// the Module column when at least one result has a non-empty value, so an
+// unnamed-region scan won't get a useless column at all.
+static QString formatRegionContext(const QString& moduleName, uint64_t base, uint64_t address) {
+    if (moduleName.isEmpty()) return QString();
+    uint64_t off = (address >= base) ? (address - base) : 0;
     return QStringLiteral("%1+0x%2")
-        .arg(region.moduleName)
+        .arg(moduleName)
         .arg(off, 0, 16);
 }
 
+// ── ScanResultStore ──
+
+ScanResultStore::ScanResultStore()
+    : d(new Data)
+{
+}
+
+ScanResultStore::ScanResultStore(int valueWidth)
+    : d(new Data)
+{
+    d->width = qBound(0, valueWidth, 0xFFFF);
+}
+
+QByteArray ScanResultStore::previousValue(int i) const {
+    if (d->prevLens.empty() || d->prevLens[i] == 0) return QByteArray();
+    return QByteArray(d->prev.data() + (size_t)i * d->width, d->prevLens[i]);
+}
+
+int ScanResultStore::regionOf(int i) const {
+    const auto& runs = d->runs;
+    auto it = std::upper_bound(runs.begin(), runs.end(), i,
+        [](int row, const RegionRun& r) { return row < r.first; });
+    return it == runs.begin() ? -1 : std::prev(it)->region;
+}
+
+QString ScanResultStore::regionModule(int i) const {
+    const int r = regionOf(i);
+    if (r < 0) return QString();
+    const Region& reg = d->regions.at(r);
+    return reg.literal ? reg.name : formatRegionContext(reg.name, reg.base, d->addrs[i]);
+}
+
+bool ScanResultStore::hasModules() const {
+    for (const RegionRun& run : d->runs)
+        if (run.region >= 0 && !d->regions.at(run.region).name.isEmpty())
+            return true;
+    return false;
+}
+
+ScanResult ScanResultStore::at(int i) const {
+    ScanResult r;
+    r.address       = address(i);
+    r.regionModule  = regionModule(i);
+    r.scanValue     = value(i);
+    r.previousValue = previousValue(i);
+    r.matchScore    = matchScore(i);
+    return r;
+}
+
+void ScanResultStore::reserve(int n) {
+    d->addrs.reserve(n);
+    d->values.reserve((size_t)n * d->width);
+}
+
+void ScanResultStore::clear() {
+    const int width = d->width;
+    d = new Data;
+    d->width = width;
+}
+
+int ScanResultStore::internRegion(const QString& moduleName, uint64_t base) {
+    Region r;
+    r.name = moduleName;
+    r.base = base;
+    return internRegion(r);
+}
+
+int ScanResultStore::internRegion(const Region& r) {
+    // Unnamed regions format to "" — no table entry needed.
+    if (r.name.isEmpty()) return -1;
+    const QString key = r.literal
+        ? QStringLiteral("\x01") + r.name
+        : QStringLiteral("%1@%2").arg(r.name).arg(r.base, 0, 16);
+    auto it = d->regionIndex.constFind(key);
+    if (it != d->regionIndex.constEnd()) return it.value();
+    const int idx = d->regions.size();
+    d->regions.append(r);
+    d->regionIndex.insert(key, idx);
+    return idx;
+}
+
+void ScanResultStore::ensureLens() {
+    if (d->lens.empty())
+        d->lens.assign(d->addrs.size(), (uint16_t)d->width);
+}
+
+void ScanResultStore::ensurePrevious() {
+    if (!d->prevLens.empty() || d->addrs.empty()) return;
+    d->prev.assign(d->addrs.size() * (size_t)d->width, 0);
+    d->prevLens.assign(d->addrs.size(), 0);
+}
+
+void ScanResultStore::appendRow(uint64_t address, const char* value, int len, int region,
+                                int score, const char* prev, int prevLen) {
+    Data* x = d.data();
+    const int row = (int)x->addrs.size();
+    const int w = x->width;
+    if (x->runs.empty() ? region >= 0 : x->runs.back().region != region)
+        x->runs.push_back({row, region});
+
+    // Length and score columns only exist once some row needs them.
+    len = qBound(0, len, w);
+    if (len != w || !x->lens.empty()) {
+        x->lens.resize(row, (uint16_t)w);
+        x->lens.push_back((uint16_t)len);
+    }
+    if (score != 0 || !x->scores.empty()) {
+        x->scores.resize(row, 0);
+        x->scores.push_back(score);
+    }
+
+    x->addrs.push_back(address);
+    const size_t at = x->values.size();
+    x->values.resize(at + w);
+    if (len > 0) memcpy(x->values.data() + at, value, len);
+
+    prevLen = qBound(0, prevLen, w);
+    if (prevLen > 0) ensurePrevious();
+    if (!x->prevLens.empty()) {
+        if (x->prevLens.size() < x->addrs.size()) {
+            x->prev.resize(x->prev.size() + w);
+            x->prevLens.push_back(0);
+        }
+        x->prevLens[row] = (uint16_t)prevLen;
+        if (prevLen > 0) memcpy(x->prev.data() + (size_t)row * w, prev, prevLen);
+    }
+}
+
+void ScanResultStore::append(uint64_t address, const char* value, int len, int region, int score) {
+    appendRow(address, value, len, region, score, nullptr, 0);
+}
+
+void ScanResultStore::append(const ScanResult& r) {
+    // Recover module+base from the "name+0xOFF" label so rows from the same
+    // module share one region entry; anything else is kept verbatim.
+    int region = -1;
+    if (!r.regionModule.isEmpty()) {
+        Region reg;
+        reg.name = r.regionModule;
+        reg.literal = true;
+        const int plus = r.regionModule.lastIndexOf(QStringLiteral("+0x"));
+        bool ok = false;
+        const uint64_t off = plus > 0 ? r.regionModule.mid(plus + 3).toULongLong(&ok, 16) : 0;
+        if (ok && off <= r.address) {
+            reg.name = r.regionModule.left(plus);
+            reg.base = r.address - off;
+            reg.literal = false;
+        }
+        region = internRegion(reg);
+    }
+    appendRow(r.address, r.scanValue.constData(), r.scanValue.size(), region,
+              r.matchScore, r.previousValue.constData(), r.previousValue.size());
+}
+
+void ScanResultStore::append(const ScanResultStore& other, int first, int n) {
+    if (n <= 0) return;
+    // Hold a reference so appending a store to itself reads the old block.
+    const ScanResultStore src = other;
+    const Data* o = src.d.constData();
+    const int ow = o->width;
+    reserve(size() + n);
+
+    QVector<int> remap(o->regions.size(), INT_MIN);
+    auto run = std::upper_bound(o->runs.begin(), o->runs.end(), first,
+        [](int row, const RegionRun& r) { return row < r.first; });
+    int region = run == o->runs.begin() ? -1 : std::prev(run)->region;
+    for (int i = first; i < first + n; ++i) {
+        while (run != o->runs.end() && run->first <= i)
+            region = (run++)->region;
+        int mine = -1;
+        if (region >= 0) {
+            if (remap[region] == INT_MIN) remap[region] = internRegion(o->regions.at(region));
+            mine = remap[region];
+        }
+        const int prevLen = o->prevLens.empty() ? 0 : o->prevLens[i];
+        appendRow(o->addrs[i], o->values.data() + (size_t)i * ow,
+                  o->lens.empty() ? ow : o->lens[i], mine,
+                  o->scores.empty() ? 0 : o->scores[i],
+                  prevLen ? o->prev.data() + (size_t)i * ow : nullptr, prevLen);
+    }
+}
+
+void ScanResultStore::setValue(int i, const char* data, int len) {
+    Data* x = d.data();
+    len = qBound(0, len, x->width);
+    char* slot = x->values.data() + (size_t)i * x->width;
+    if (len > 0) memcpy(slot, data, len);
+    memset(slot + len, 0, x->width - len);
+    if (len != x->width) ensureLens();
+    if (!x->lens.empty()) x->lens[i] = (uint16_t)len;
+}
+
+void ScanResultStore::fillValues(const QByteArray& v) {
+    Data* x = d.data();
+    x->width = qMin((int)v.size(), 0xFFFF);
+    const size_t rows = x->addrs.size();
+    x->values.resize(rows * x->width);
+    x->values.shrink_to_fit();
+    for (size_t i = 0; i < rows; ++i)
+        memcpy(x->values.data() + i * x->width, v.constData(), x->width);
+    std::vector<uint16_t>().swap(x->lens);
+    std::vector<char>().swap(x->prev);
+    std::vector<uint16_t>().swap(x->prevLens);
+}
+
+void ScanResultStore::clearPrevious() {
+    if (d->prevLens.empty()) return;
+    std::vector<char>().swap(d->prev);
+    std::vector<uint16_t>().swap(d->prevLens);
+}
+
+void ScanResultStore::setValueWidth(int width) {
+    width = qBound(0, width, 0xFFFF);
+    if (width == d->width) return;
+    Data* x = d.data();
+    const size_t rows = x->addrs.size();
+    const int ow = x->width;
+    std::vector<char> values(rows * width, 0);
+    bool shortValue = false;
+    for (size_t i = 0; i < rows; ++i) {
+        int len = x->lens.empty() ? ow : x->lens[i];
+        len = qMin(len, width);
+        memcpy(values.data() + i * width, x->values.data() + i * ow, len);
+        if (!x->lens.empty()) x->lens[i] = (uint16_t)len;
+        shortValue |= len != width;
+    }
+    x->values.swap(values);
+    x->width = width;
+    if (!shortValue)
+        std::vector<uint16_t>().swap(x->lens);
+    else if (x->lens.empty())
+        x->lens.assign(rows, (uint16_t)qMin(ow, width));
+    std::vector<char>().swap(x->prev);
+    std::vector<uint16_t>().swap(x->prevLens);
+}
+
+void ScanResultStore::compact(const char* keep) {
+    Data* x = d.data();
+    const int rows = (int)x->addrs.size();
+    const int w = x->width;
+    std::vector<RegionRun> runs;
+    auto run = x->runs.begin();
+    int region = -1;
+    int kept = 0;
+    for (int i = 0; i < rows; ++i) {
+        while (run != x->runs.end() && run->first <= i)
+            region = (run++)->region;
+        if (!keep[i]) continue;
+        if (runs.empty() ? region >= 0 : runs.back().region != region)
+            runs.push_back({kept, region});
+        if (kept != i) {
+            x->addrs[kept] = x->addrs[i];
+            memcpy(x->values.data() + (size_t)kept * w, x->values.data() + (size_t)i * w, w);
+            if (!x->lens.empty())   x->lens[kept]   = x->lens[i];
+            if (!x->scores.empty()) x->scores[kept] = x->scores[i];
+            if (!x->prevLens.empty()) {
+                memcpy(x->prev.data() + (size_t)kept * w, x->prev.data() + (size_t)i * w, w);
+                x->prevLens[kept] = x->prevLens[i];
+            }
+        }
+        ++kept;
+    }
+    if (kept == rows) return;
+    // A narrowing pass usually drops most rows — hand the memory back.
+    auto shrink = [](auto& v, size_t n) {
+        if (v.empty()) return;
+        v.resize(n);
+        v.shrink_to_fit();
+    };
+    shrink(x->addrs, kept);
+    shrink(x->values, (size_t)kept * w);
+    shrink(x->lens, kept);
+    shrink(x->scores, kept);
+    shrink(x->prev, (size_t)kept * w);
+    shrink(x->prevLens, kept);
+    x->runs.swap(runs);
+}
+
+void ScanResultStore::sortByScore() {
+    const int rows = size();
+    if (rows < 2 || d->scores.empty()) return;
+    std::vector<int> order(rows);
+    for (int i = 0; i < rows; ++i) order[i] = i;
+    const std::vector<int>& scores = d->scores;
+    std::stable_sort(order.begin(), order.end(),
+                     [&scores](int a, int b) { return scores[a] > scores[b]; });
+    ScanResultStore sorted(d->width);
+    sorted.reserve(rows);
+    for (int i : order) sorted.append(*this, i, 1);
+    *this = sorted;
+}
+
+QVector<ScanResult> ScanResultStore::toVector() const {
+    QVector<ScanResult> out;
+    out.reserve(size());
+    for (int i = 0; i < size(); ++i)
+        out.append(at(i));
+    return out;
+}
+
+ScanResultStore ScanResultStore::fromVector(const QVector<ScanResult>& v) {
+    int width = 0;
+    for (const ScanResult& r : v)
+        width = qMax(width, (int)qMax(r.scanValue.size(), r.previousValue.size()));
+    ScanResultStore store(width);
+    store.reserve(v.size());
+    for (const ScanResult& r : v)
+        store.append(r);
+    return store;
+}
+
+size_t ScanResultStore::columnBytes() const {
+    return d->addrs.capacity() * sizeof(uint64_t)
+         + d->values.capacity()
+         + d->lens.capacity() * sizeof(uint16_t)
+         + d->prev.capacity()
+         + d->prevLens.capacity() * sizeof(uint16_t)
+         + d->scores.capacity() * sizeof(int)
+         + d->runs.capacity() * sizeof(RegionRun);
+}
+
+ScanResultStore ScanResultStore::fromSnapshot(std::shared_ptr<ScanSnapshot> snapshot) {
+    ScanResultStore store(snapshot ? snapshot->valueSize() : 0);
+    store.d->snapshot = std::move(snapshot);
+    return store;
+}
+
+// ── ScanSnapshot ──
+
+std::shared_ptr<ScanSnapshot> ScanSnapshot::create(QVector<Region> regions, int alignment,
+                                                   int valueSize, int threshold,
+                                                   QString* errorMsg) {
+    std::shared_ptr<ScanSnapshot> snap(new ScanSnapshot);
+    snap->m_alignment = qMax(1, alignment);
+    snap->m_valueSize = qMax(1, valueSize);
+    snap->m_threshold = threshold;
+
+    // Region bytes first, then the bitmaps, so a sequential pass over the
+    // data never strides across mask pages.
+    qint64 offset = 0;
+    for (Region& r : regions) {
+        r.slots = r.size >= (uint64_t)snap->m_valueSize
+                ? (qint64)((r.size - snap->m_valueSize) / snap->m_alignment) + 1 : 0;
+        r.candidates = r.slots;
+        r.dataOffset = offset;
+        offset += (qint64)r.size;
+        snap->m_candidates += r.slots;
+    }
+    for (Region& r : regions) {
+        r.maskOffset = offset;
+        offset += (r.slots + 7) / 8;
+    }
+    snap->m_regions = std::move(regions);
+    snap->m_fileSize = offset;
+
+    auto fail = [&](const QString& why) -> std::shared_ptr<ScanSnapshot> {
+        if (errorMsg) *errorMsg = why;
+        return nullptr;
+    };
+    snap->m_file.setFileTemplate(QDir::tempPath() + QStringLiteral("/reclass_snapshot_XXXXXX"));
+    if (!snap->m_file.open())
+        return fail(QStringLiteral("Cannot create snapshot file: %1").arg(snap->m_file.errorString()));
+    if (offset == 0)
+        return snap;
+    // resize() extends sparsely: pages the scan never writes (unreadable
+    // chunks, skipped regions) cost no disk.
+    if (!snap->m_file.resize(offset))
+        return fail(QStringLiteral("Cannot size snapshot file to %1 bytes: %2")
+                        .arg(offset).arg(snap->m_file.errorString()));
+    snap->m_map = snap->m_file.map(0, offset);
+    if (!snap->m_map)
+        return fail(QStringLiteral("Cannot map snapshot file: %1").arg(snap->m_file.errorString()));
+    return snap;
+}
+
 // ── System module skip list ──
 // Hard-coded set of well-known Windows + Qt + CRT DLLs and the same set of
 // libs on Linux/macOS. Used by ScanRequest::skipSystemModules to drop matches
@@ -468,10 +848,9 @@ int valueSizeForType(ValueType type) {
 
 // ── Typed comparison for rescan conditions ──
 
-static int compareTyped(const QByteArray& a, const QByteArray& b, ValueType vt) {
-    const char* da = a.constData();
-    const char* db = b.constData();
-    int sz = qMin(a.size(), b.size());
+// Raw-pointer form so rescan can compare straight out of the read buffer.
+static int compareTyped(const char* da, int sa, const char* db, int sb, ValueType vt) {
+    int sz = qMin(sa, sb);
 
     switch (vt) {
     case ValueType::Int8:
@@ -511,16 +890,365 @@ static int compareTyped(const QByteArray& a, const QByteArray& b, ValueType vt)
     return memcmp(da, db, sz);
 }
 
+static int compareTyped(const QByteArray& a, const QByteArray& b, ValueType vt) {
+    return compareTyped(a.constData(), a.size(), b.constData(), b.size(), vt);
+}
+
+// ── Rescan predicate ──
+//
+// One rescan condition, resolved once per pass. Listed rescans and
+// snapshot rescans both run every candidate through it, so the two modes
+// can't drift apart on what "Changed" or "IncreasedBy" means.
+struct RescanFilter {
+    ScanCondition condition = ScanCondition::ExactValue;
+    ValueType     valueType = ValueType::Int32;
+    int           readSize = 4;
+    QByteArray    pattern, mask, pattern2;
+
+    bool hasExactFilter = false;
+    bool hasComparison  = false;
+    bool hasTypedConst  = false;
+    bool hasDelta       = false;
+    bool needsFilter    = false;
+
+    RescanFilter(ScanCondition cond, ValueType vt, int size, const QByteArray& pat,
+                 const QByteArray& msk, const QByteArray& pat2)
+        : condition(cond), valueType(vt), readSize(size)
+        , pattern(pat), mask(msk), pattern2(pat2)
+    {
+        hasExactFilter = !pattern.isEmpty() && condition == ScanCondition::ExactValue;
+        hasComparison = (condition == ScanCondition::Changed ||
+                         condition == ScanCondition::Unchanged ||
+                         condition == ScanCondition::Increased ||
+                         condition == ScanCondition::Decreased);
+        hasTypedConst = (condition == ScanCondition::BiggerThan ||
+                         condition == ScanCondition::SmallerThan ||
+                         condition == ScanCondition::Between);
+        hasDelta      = (condition == ScanCondition::IncreasedBy ||
+                         condition == ScanCondition::DecreasedBy);
+        needsFilter = hasExactFilter || hasComparison || hasTypedConst || hasDelta;
+    }
+
+    // Does the value just read (`cur`, readSize bytes) survive against the
+    // value it had last pass (`prev`, prevLen bytes; 0 = none)?
+    bool operator()(const char* cur, const char* prev, int prevLen) const {
+        bool hit = !needsFilter;   // if no filter, all match
+        const int patLen = pattern.size();
+        const char* fPat = pattern.constData();
+        const char* fMsk = mask.constData();
+
+        // Apply exact-value filter
+        if (hasExactFilter && readSize >= patLen) {
+            bool ok = true;
+            for (int k = 0; k < patLen; k++) {
+                if ((cur[k] & fMsk[k]) != (fPat[k] & fMsk[k])) {
+                    ok = false;
+                    break;
+                }
+            }
+            hit = ok;
+        }
+
+        // Apply comparison-based filter
+        if (hasComparison && prevLen > 0) {
+            int cmp = compareTyped(cur, readSize, prev, prevLen, valueType);
+            switch (condition) {
+            case ScanCondition::Changed:   hit = (cmp != 0); break;
+            case ScanCondition::Unchanged: hit = (cmp == 0); break;
+            case ScanCondition::Increased: hit = (cmp > 0);  break;
+            case ScanCondition::Decreased: hit = (cmp < 0);  break;
+            default: break;
+            }
+        }
+
+        // Typed const compare (BiggerThan / SmallerThan / Between).
+        // pattern carries the lower bound (or sole bound); pattern2
+        // carries the upper bound for Between.
+        if (hasTypedConst && !pattern.isEmpty()) {
+            int cmpLo = compareTyped(cur, readSize, fPat, patLen, valueType);
+            if (condition == ScanCondition::BiggerThan)
+                hit = (cmpLo > 0);
+            else if (condition == ScanCondition::SmallerThan)
+                hit = (cmpLo < 0);
+            else if (condition == ScanCondition::Between
+                     && !pattern2.isEmpty()) {
+                int cmpHi = compareTyped(cur, readSize, pattern2.constData(),
+                                         pattern2.size(), valueType);
+                hit = (cmpLo >= 0 && cmpHi <= 0);
+            }
+        }
+
+        // Delta compare (IncreasedBy / DecreasedBy). Only meaningful when
+        // a previous value exists; first scan can't satisfy this.
+        if (hasDelta && prevLen > 0 && !pattern.isEmpty()) {
+            // Compute previous + delta (or - delta) and compare element-wise.
+            // We only need exact byte match against the typed addition.
+            int sz = qMin(prevLen, patLen);
+            if (readSize >= sz) {
+                bool ok = false;
+                auto addAndCheck = [&](auto sample) {
+                    using T = decltype(sample);
+                    if (sz < (int)sizeof(T)) return;
+                    T before{}, delta{}, now{};
+                    memcpy(&before, prev,             sizeof(T));
+                    memcpy(&delta,  fPat,             sizeof(T));
+                    memcpy(&now,    cur,              sizeof(T));
+                    T expected = (condition == ScanCondition::IncreasedBy)
+                                 ? T(before + delta) : T(before - delta);
+                    ok = (now == expected);
+                };
+                switch (valueType) {
+                case ValueType::Int8:   addAndCheck(int8_t{});   break;
+                case ValueType::UInt8:  addAndCheck(uint8_t{});  break;
+                case ValueType::Int16:  addAndCheck(int16_t{});  break;
+                case ValueType::UInt16: addAndCheck(uint16_t{}); break;
+                case ValueType::Int32:  addAndCheck(int32_t{});  break;
+                case ValueType::UInt32: addAndCheck(uint32_t{}); break;
+                case ValueType::Int64:  addAndCheck(int64_t{});  break;
+                case ValueType::UInt64: addAndCheck(uint64_t{}); break;
+                case ValueType::Float:  addAndCheck(float{});    break;
+                case ValueType::Double: addAndCheck(double{});   break;
+                default: break;
+                }
+                hit = ok;
+            }
+        }
+        return hit;
+    }
+};
+
+// ── First-scan work partitioning ──
+//
+// runScan() cuts every accepted region into the same chunk grid the old
+// single-threaded loop walked (2 MB reads, pattern-length overlap, the
+// advance re-aligned to the scan alignment) and hands the chunks out to a
+// thread pool. Each chunk collects its hits into its own buffer; merging
+// the buffers in chunk order reproduces the sequential result order, so
+// output is identical to a one-thread scan regardless of scheduling.
+
+namespace {
+
+// Everything the per-chunk matcher needs, resolved once per scan.
+struct ScanPlan {
+    ScanCondition cond = ScanCondition::ExactValue;
+    ValueType     valueType = ValueType::Int32;
+    bool        isCapture = false;
+    bool        isTypedConst = false;
+    bool        isMatrix = false;
+    bool        bmhEligible = false;
+    int         patternLen = 0;
+    int         valSize = 0;
+    int         alignment = 1;
+    int         maxResults = 0;
+    const char* pat = nullptr;
+    const char* msk = nullptr;
+    QByteArray  lo, hi;            // typed-const bounds (pattern / pattern2)
+    MatrixScanParams matrixParams;
+
+    // Vector kernel selection (scankernels.h)
+    SimdLevel   simd = SimdLevel::Scalar;
+    bool        laneEqual = false;   // exact 4/8-byte value on a lane-aligned grid
+    bool        rangeLanes = false;  // typed-const over a 4/8-byte numeric type
+    LaneType    laneType = LaneType::I32;
+    RangeOp     rangeOp = RangeOp::Greater;
+};
+
+// One chunk of the grid: read [addr, addr + readLen) and credit `advance`
+// bytes to progress (readLen minus the overlap the next chunk re-reads).
+struct ScanUnit {
+    int      region  = 0;
+    uint64_t addr    = 0;
+    int      readLen = 0;
+    uint64_t advance = 0;
+};
+
+// Stop check polled by the matcher: user abort, or a chunk past the point
+// where earlier chunks already filled maxResults.
+struct ScanStop {
+    const std::atomic<bool>* abort;
+    const std::atomic<int>*  cutoff;
+    int                      unit;
+    bool operator()() const {
+        return abort->load(std::memory_order_relaxed)
+            || unit > cutoff->load(std::memory_order_relaxed);
+    }
+};
+
+// Progress from several workers at once: only the caller that moves the
+// shared percentage forward emits it, so the UI sees a monotonic stream.
+void advanceProgress(QObject* engine, std::atomic<int>& lastPct, int pct) {
+    int prev = lastPct.load();
+    while (pct > prev) {
+        if (lastPct.compare_exchange_weak(prev, pct)) {
+            QMetaObject::invokeMethod(engine, "progress",
+                Qt::QueuedConnection, Q_ARG(int, pct));
+            return;
+        }
+    }
+}
+
+// Inner-loop stop check: every kAbortStride iterations, peek the flags.
+// 4096 stride at alignment=1 = ~4 KB per check, well under 1 ms even
+// at 50 MB/s read rate. Larger alignments naturally check less often.
+constexpr int kAbortStride = 4096;
+
+// Match one chunk. Returns false when stopped early (abort / cutoff);
+// also returns once `out` reaches maxResults — later hits in this chunk
+// can never make it into the merged result.
+bool matchChunk(const ScanPlan& p, const MemoryRegion& region,
+                uint64_t chunkAddr, const char* data, int readLen,
+                ScanResultStore& out, const ScanStop& stop)
+{
+    const int scanEnd = readLen - p.patternLen;
+    const int alignment = p.alignment;
+    const int reg = out.internRegion(region.moduleName, region.base);
+
+    if (p.isMatrix) {
+        // Score each 64-byte / 4-aligned window as a 4x4 affine view
+        // matrix. The float-validity gate rejects almost every window,
+        // so this stays close to a normal aligned scan in cost.
+        // Snap the first window to an ABSOLUTE 4-aligned address. A
+        // custom 'regions' constraint can give an unaligned regStart;
+        // without this snap every window would be misaligned and a
+        // genuinely 4-aligned matrix is never tested.
+        int iStart = (int)(((uint64_t)alignment - (chunkAddr % alignment)) % alignment);
+        for (int i = iStart; i <= scanEnd; i += alignment) {
+            if ((i & (kAbortStride - 1)) == 0 && stop())
+                return false;
+            MatrixScanResult mr = scoreMatrixWindow(
+                reinterpret_cast<const uint8_t*>(data + i), p.matrixParams);
+            if (mr.score >= p.matrixParams.minScore) {
+                out.append(chunkAddr + (uint64_t)i, data + i, 64, reg, mr.score);
+                if (out.size() >= p.maxResults)
+                    return true;
+            }
+        }
+    } else if (p.isCapture) {
+        // Capture every aligned address (UnknownValue + comparison
+        // conditions seed the result list this way; rescan filters
+        // against the captured bytes later).
+        for (int i = 0; i <= scanEnd; i += alignment) {
+            if ((i & (kAbortStride - 1)) == 0 && stop())
+                return false;
+            out.append(chunkAddr + (uint64_t)i, data + i, p.valSize, reg);
+            if (out.size() >= p.maxResults)
+                return true;
+        }
+    } else if (p.isTypedConst && p.rangeLanes) {
+        // 4/8-byte numeric compare against the constant, block at a time.
+        const uint8_t* d = reinterpret_cast<const uint8_t*>(data);
+        const uint8_t* lo = reinterpret_cast<const uint8_t*>(p.lo.constData());
+        const uint8_t* hi = reinterpret_cast<const uint8_t*>(p.hi.constData());
+        for (int i = 0; ; ) {
+            if (stop()) return false;
+            int hit = findInRange(d, i, scanEnd, alignment, p.laneType, p.rangeOp,
+                                  lo, hi, p.simd);
+            if (hit < 0) break;
+            out.append(chunkAddr + (uint64_t)hit, data + hit, p.valSize, reg);
+            if (out.size() >= p.maxResults)
+                return true;
+            i = hit + alignment;
+        }
+    } else if (p.isTypedConst) {
+        // Inline typed compare: BiggerThan / SmallerThan / Between.
+        // Reuses compareTyped so we get the same numeric semantics as
+        // rescan filters.
+        for (int i = 0; i <= scanEnd; i += alignment) {
+            if ((i & (kAbortStride - 1)) == 0 && stop())
+                return false;
+            const char* val = data + i;
+            int cmpLo = compareTyped(val, p.valSize, p.lo.constData(), p.lo.size(), p.valueType);
+            bool ok = false;
+            if (p.cond == ScanCondition::BiggerThan)       ok = (cmpLo > 0);
+            else if (p.cond == ScanCondition::SmallerThan) ok = (cmpLo < 0);
+            else if (p.cond == ScanCondition::Between && !p.hi.isEmpty()) {
+                int cmpHi = compareTyped(val, p.valSize, p.hi.constData(), p.hi.size(), p.valueType);
+                ok = (cmpLo >= 0 && cmpHi <= 0);
+            }
+            if (ok) {
+                out.append(chunkAddr + (uint64_t)i, val, p.valSize, reg);
+                if (out.size() >= p.maxResults)
+                    return true;
+            }
+        }
+    } else if (p.bmhEligible) {
+        // BMH path: no wildcards, alignment 1, pattern ≥4 bytes.
+        int searchFrom = 0;
+        while (searchFrom <= scanEnd) {
+            if (stop()) return false;
+            int hit = ScanEngine::bmhFind(data + searchFrom, readLen - searchFrom,
+                                          p.pat, p.patternLen);
+            if (hit < 0) break;
+            int absI = searchFrom + hit;
+            if (absI > scanEnd) break;
+            out.append(chunkAddr + (uint64_t)absI, data + absI, qMin(16, readLen - absI), reg);
+            if (out.size() >= p.maxResults)
+                return true;
+            searchFrom = absI + 1;
+        }
+    } else {
+        // Aligned / masked matcher (handles wildcards + alignment > 1).
+        // Exact 4/8-byte values on a lane grid compare whole lanes; anything
+        // else pre-filters on two anchor bytes and verifies candidates.
+        const uint8_t* d = reinterpret_cast<const uint8_t*>(data);
+        const uint8_t* pat = reinterpret_cast<const uint8_t*>(p.pat);
+        const uint8_t* msk = reinterpret_cast<const uint8_t*>(p.msk);
+        for (int i = 0; ; ) {
+            if (stop()) return false;
+            int hit = p.laneEqual
+                ? findEqual(d, i, scanEnd, alignment, pat, p.patternLen, p.simd)
+                : findMasked(d, i, scanEnd, alignment, pat, msk, p.patternLen, p.simd);
+            if (hit < 0) break;
+            out.append(chunkAddr + (uint64_t)hit, data + hit, qMin(16, readLen - hit), reg);
+            if (out.size() >= p.maxResults)
+                return true;
+            i = hit + alignment;
+        }
+    }
+    return true;
+}
+
+// A chunk that fails to read as a whole may still be mostly mapped (a guard
+// page in the middle); re-read it page by page, zero the pages that stay
+// unreadable and record them in `holes` as [begin, end) offsets into `dst`.
+// Returns the number of unreadable bytes.
+uint64_t readByPages(const Provider* prov, uint64_t addr, char* dst, int len,
+                     QVector<QPair<int, int>>* holes = nullptr) {
+    constexpr uint64_t kPage = 4096;
+    uint64_t failed = 0;
+    for (int off = 0; off < len; ) {
+        const int n = (int)qMin<uint64_t>(kPage - ((addr + off) & (kPage - 1)),
+                                          (uint64_t)(len - off));
+        if (!prov->read(addr + off, dst + off, n)) {
+            memset(dst + off, 0, n);
+            failed += n;
+            if (holes) {
+                if (!holes->isEmpty() && holes->last().second == off)
+                    holes->last().second = off + n;
+                else
+                    holes->append({off, off + n});
+            }
+        }
+        off += n;
+    }
+    return failed;
+}
+
+} // namespace
+
 // ── Scan engine ──
 
 ScanEngine::ScanEngine(QObject* parent)
     : QObject(parent)
 {
     qRegisterMetaType<QVector<ScanResult>>("QVector<rcx::ScanResult>");
+    qRegisterMetaType<ScanResultStore>("rcx::ScanResultStore");
+    qRegisterMetaType<PointerScanResult>("rcx::PointerScanResult");
 }
 
 bool ScanEngine::isRunning() const {
-    return m_watcher && m_watcher->isRunning();
+    return (m_watcher && m_watcher->isRunning())
+        || (m_pointerWatcher && m_pointerWatcher->isRunning());
 }
 
 void ScanEngine::abort() {
@@ -544,16 +1272,22 @@ void ScanEngine::start(std::shared_ptr<Provider> provider, const ScanRequest& re
     }
 
     m_abort.store(false);
+    // A fresh ring per scan: batches a previous scan left undrained must
+    // not leak into this one.
+    m_stream.reset();
+    if (req.streamBatchRows > 0)
+        m_stream.reset(new SpscRing<ScanResultStore>((size_t)qMax(1, req.streamQueueDepth)));
 
-    auto* watcher = new QFutureWatcher<QVector<ScanResult>>(this);
+    auto* watcher = new QFutureWatcher<ScanResultStore>(this);
     m_watcher = watcher;
 
-    connect(watcher, &QFutureWatcher<QVector<ScanResult>>::finished, this, [this, watcher]() {
+    connect(watcher, &QFutureWatcher<ScanResultStore>::finished, this, [this, watcher]() {
         auto results = watcher->result();
         watcher->deleteLater();
         if (m_watcher == watcher)
             m_watcher = nullptr;
-        emit finished(results);
+        drainStream();   // every partialResults lands before resultsReady
+        emitFinished(results, false);
     });
 
     watcher->setFuture(QtConcurrent::run([this, provider, req]() {
@@ -561,13 +1295,75 @@ void ScanEngine::start(std::shared_ptr<Provider> provider, const ScanRequest& re
     }));
 }
 
-QVector<ScanResult> ScanEngine::runScan(std::shared_ptr<Provider> prov,
-                                         const ScanRequest& req)
+void ScanEngine::startPointerScan(std::shared_ptr<Provider> provider,
+                                  const PointerScanRequest& req) {
+    if (isRunning()) return;
+    if (!provider) {
+        emit error(QStringLiteral("No source attached"));
+        return;
+    }
+    if (req.maxDepth < 1 || req.maxOffset < 0) {
+        emit error(QStringLiteral("Pointer scan needs a depth of at least 1"));
+        return;
+    }
+
+    m_abort.store(false);
+    auto* watcher = new QFutureWatcher<PointerScanResult>(this);
+    m_pointerWatcher = watcher;
+
+    connect(watcher, &QFutureWatcher<PointerScanResult>::finished, this, [this, watcher]() {
+        const PointerScanResult result = watcher->result();
+        watcher->deleteLater();
+        if (m_pointerWatcher == watcher)
+            m_pointerWatcher = nullptr;
+        emit pointerScanFinished(result);
+    });
+
+    watcher->setFuture(QtConcurrent::run([this, provider, req]() {
+        QVector<MemoryRegion> regions;
+        if (m_cachedProvider == provider.get() && !m_cachedRegions.isEmpty()) {
+            regions = m_cachedRegions;
+        } else {
+            regions = provider->enumerateRegions();
+            m_cachedRegions  = regions;
+            m_cachedProvider = provider.get();
+        }
+        // The map pass already hands out each percent once.
+        return scanPointerPaths(*provider, regions, req, &m_pool, &m_abort, [this](int pct) {
+            QMetaObject::invokeMethod(this, "progress", Qt::QueuedConnection, Q_ARG(int, pct));
+        });
+    }));
+}
+
+void ScanEngine::drainStream() {
+    // Clear the flag before popping: a batch pushed after the last pop
+    // queues a new drain instead of waiting for one that already ran.
+    m_drainQueued.store(false);
+    if (!m_stream) return;
+    ScanResultStore batch;
+    while (m_stream->pop(batch))
+        emit partialResults(batch);
+}
+
+void ScanEngine::emitFinished(const ScanResultStore& results, bool rescan) {
+    if (rescan) {
+        emit rescanResultsReady(results);
+        if (isSignalConnected(QMetaMethod::fromSignal(&ScanEngine::rescanFinished)))
+            emit rescanFinished(results.toVector());
+    } else {
+        emit resultsReady(results);
+        if (isSignalConnected(QMetaMethod::fromSignal(&ScanEngine::finished)))
+            emit finished(results.toVector());
+    }
+}
+
+ScanResultStore ScanEngine::runScan(std::shared_ptr<Provider> prov,
+                                     const ScanRequest& req)
 {
     QElapsedTimer timer;
     timer.start();
 
-    QVector<ScanResult> results;
+    ScanResultStore results;
     const ScanCondition cond = req.condition;
     // Compare-against-previous conditions on a first scan have no baseline,
     // so they're treated as raw capture of every aligned address. Rescan
@@ -617,7 +1413,7 @@ QVector<ScanResult> ScanEngine::runScan(std::shared_ptr<Provider> prov,
     if (regions.isEmpty()) {
         MemoryRegion fallback;
         fallback.base = 0;
-        fallback.size = (uint64_t)prov->size();
+        fallback.size = prov->extent();
         fallback.readable = true;
         fallback.writable = true;
         fallback.executable = true;  // unknown; include so filters don't exclude the only region
@@ -630,6 +1426,9 @@ QVector<ScanResult> ScanEngine::runScan(std::shared_ptr<Provider> prov,
     const char* msk = isCapture ? nullptr : req.mask.constData();
     const int alignment = isMatrix ? 4 : qMax(1, req.alignment);
     const int valSize = (isCapture || isTypedConst) ? req.valueSize : patternLen;
+    // Value arena stride: the bytes each hit caches. Pattern hits keep a
+    // 16-byte preview, clipped at the chunk end.
+    const int valueWidth = isMatrix ? 64 : ((isCapture || isTypedConst) ? valSize : 16);
     const bool hasRange = (req.startAddress != 0 || req.endAddress != 0) &&
                            req.endAddress > req.startAddress;
 
@@ -714,9 +1513,51 @@ QVector<ScanResult> ScanEngine::runScan(std::shared_ptr<Provider> prov,
 
     if (totalBytes == 0) return results;
 
-    uint64_t scannedBytes = 0;
-    uint64_t failedBytes = 0;
-    int lastPct = -1;
+    ScanPlan plan;
+    plan.cond         = cond;
+    plan.valueType    = req.valueType;
+    plan.isCapture    = isCapture;
+    plan.isTypedConst = isTypedConst;
+    plan.isMatrix     = isMatrix;
+    plan.bmhEligible  = bmhEligible;
+    plan.patternLen   = patternLen;
+    plan.valSize      = valSize;
+    plan.alignment    = alignment;
+    plan.maxResults   = req.maxResults;
+    plan.pat          = pat;
+    plan.msk          = msk;
+    plan.lo           = req.pattern;
+    plan.hi           = req.pattern2;
+    plan.matrixParams = req.matrixParams;
+
+    // Vector kernels: pick the CPU's widest level once per scan.
+    plan.simd = cpuSimdLevel();
+    if (!isCapture && !isTypedConst && !isMatrix && !bmhEligible
+        && (patternLen == 4 || patternLen == 8) && alignment % patternLen == 0) {
+        plan.laneEqual = true;
+        for (int j = 0; j < patternLen; j++)
+            if ((unsigned char)msk[j] != 0xFF) { plan.laneEqual = false; break; }
+    }
+    if (isTypedConst) {
+        bool numeric = true;
+        switch (req.valueType) {
+        case ValueType::Int32:  plan.laneType = LaneType::I32; break;
+        case ValueType::UInt32: plan.laneType = LaneType::U32; break;
+        case ValueType::Float:  plan.laneType = LaneType::F32; break;
+        case ValueType::Int64:  plan.laneType = LaneType::I64; break;
+        case ValueType::UInt64: plan.laneType = LaneType::U64; break;
+        case ValueType::Double: plan.laneType = LaneType::F64; break;
+        default: numeric = false; break;
+        }
+        plan.rangeOp = (cond == ScanCondition::BiggerThan)  ? RangeOp::Greater
+                     : (cond == ScanCondition::SmallerThan) ? RangeOp::Less
+                                                            : RangeOp::Between;
+        // Short constants fall back to compareTyped's memcmp semantics, and a
+        // Between without an upper bound never matches — both stay scalar.
+        const int w = numeric ? laneWidth(plan.laneType) : 0;
+        plan.rangeLanes = numeric && valSize == w && plan.lo.size() >= w
+                       && (plan.rangeOp != RangeOp::Between || plan.hi.size() >= w);
+    }
 
     // Adaptive chunk sizing — tiny regions get one read; huge ones get 2 MB
     // chunks so the read syscall amortizes well. The legacy 256 KB was a
@@ -724,10 +1565,17 @@ QVector<ScanResult> ScanEngine::runScan(std::shared_ptr<Provider> prov,
     constexpr int kChunkBig = 2 * 1024 * 1024;
     constexpr int kChunkMin = 64 * 1024;
 
+    // Lay out the chunk grid up front. The grid only depends on region
+    // sizes, so precomputing it is what lets chunks run out of order.
+    QVector<ScanUnit> units;
+    uint64_t tinyBytes = 0;    // regions shorter than the pattern: counted, not read
+    int maxChunk = 0;
+    // Capture scans also lay out the snapshot they'd use if the target is big.
+    QVector<ScanSnapshot::Region> snapRegions;
+    QVector<int> snapIndex(regions.size(), -1);
+    qint64 totalSlots = 0;
     for (int regionIndex = 0; regionIndex < regions.size(); ++regionIndex) {
         const auto& region = regions[regionIndex];
-        if (m_abort.load()) break;
-
         if (!regionAccepted(region)) continue;
 
         // Clip region to requested address range
@@ -745,188 +1593,265 @@ QVector<ScanResult> ScanEngine::runScan(std::shared_ptr<Provider> prov,
         if (regSize == 0) continue;
 
         if ((uint64_t)patternLen > regSize) {
-            scannedBytes += regSize;
+            tinyBytes += regSize;
             continue;
         }
 
+        if (isCapture) {
+            ScanSnapshot::Region sr;
+            sr.base       = regStart;
+            sr.size       = regSize;
+            sr.moduleName = region.moduleName;
+            sr.moduleBase = region.base;
+            snapIndex[regionIndex] = snapRegions.size();
+            snapRegions.append(sr);
+            totalSlots += (qint64)((regSize - patternLen) / alignment) + 1;
+        }
+
         const int overlap = patternLen - 1;
         // Adaptive: cap big regions at 2 MB; tiny regions get one read.
         uint64_t targetChunk = qMin((uint64_t)kChunkBig, regSize);
         if (regSize < (uint64_t)kChunkMin) targetChunk = regSize;
-        QByteArray chunk(targetChunk, Qt::Uninitialized);
-        uint64_t regOffset = regStart - region.base; // offset within provider region
-
-        // Inner-loop abort check: every kAbortStride iterations, peek the flag.
-        // 4096 stride at alignment=1 = ~4 KB per check, well under 1 ms even
-        // at 50 MB/s read rate. Larger alignments naturally check less often.
-        constexpr int kAbortStride = 4096;
+        maxChunk = qMax(maxChunk, (int)targetChunk);
 
         for (uint64_t off = 0; off < regSize; ) {
-            if (m_abort.load()) break;
-
             uint64_t remaining = regSize - off;
-            int readLen = (int)qMin((uint64_t)chunk.size(), remaining);
-
-            if (!prov->read(regStart + off, chunk.data(), readLen)) {
-                // Skip unreadable chunk; track for status-line surfacing.
-                failedBytes += readLen;
-                qDebug() << "[scan] read failed region" << regionIndex << "addr" << Qt::showbase << Qt::hex
-                         << (region.base + off) << "base" << region.base << "off" << off << "len" << readLen << Qt::dec;
-                off += readLen;
-                scannedBytes += readLen;
-                continue;
-            }
-
-            int scanEnd = readLen - patternLen;
-            const char* data = chunk.constData();
-
-            if (isMatrix) {
-                // Score each 64-byte / 4-aligned window as a 4x4 affine view
-                // matrix. The float-validity gate rejects almost every window,
-                // so this stays close to a normal aligned scan in cost.
-                const MatrixScanParams& mp = req.matrixParams;
-                // Snap the first window to an ABSOLUTE 4-aligned address. A
-                // custom 'regions' constraint can give an unaligned regStart;
-                // without this snap every window would be misaligned and a
-                // genuinely 4-aligned matrix is never tested.
-                int iStart = (int)(((uint64_t)alignment - ((regStart + off) % alignment)) % alignment);
-                for (int i = iStart; i <= scanEnd; i += alignment) {
-                    if ((i & (kAbortStride - 1)) == 0 && m_abort.load())
-                        goto done;
-                    MatrixScanResult mr = scoreMatrixWindow(
-                        reinterpret_cast<const uint8_t*>(data + i), mp);
-                    if (mr.score >= mp.minScore) {
-                        ScanResult r;
-                        r.address = regStart + off + (uint64_t)i;
-                        r.regionModule = formatRegionContext(region, r.address);
-                        r.scanValue = QByteArray(data + i, 64);
-                        r.matchScore = mr.score;
-                        results.append(r);
-                        if (results.size() >= req.maxResults)
-                            goto done;
-                    }
-                }
-            } else if (isCapture) {
-                // Capture every aligned address (UnknownValue + comparison
-                // conditions seed the result list this way; rescan filters
-                // against the captured bytes later).
-                for (int i = 0; i <= scanEnd; i += alignment) {
-                    if ((i & (kAbortStride - 1)) == 0 && m_abort.load())
-                        goto done;
-                    ScanResult r;
-                    r.address = regStart + off + (uint64_t)i;
-                    r.regionModule = formatRegionContext(region, r.address);
-                    r.scanValue = QByteArray(data + i, valSize);
-                    results.append(r);
-
-                    if (results.size() >= req.maxResults)
-                        goto done;
-                }
-            } else if (isTypedConst) {
-                // Inline typed compare: BiggerThan / SmallerThan / Between.
-                // Reuses compareTyped so we get the same numeric semantics as
-                // rescan filters.
-                QByteArray loBuf = req.pattern;
-                QByteArray hiBuf = req.pattern2;
-                for (int i = 0; i <= scanEnd; i += alignment) {
-                    if ((i & (kAbortStride - 1)) == 0 && m_abort.load())
-                        goto done;
-                    QByteArray val(data + i, valSize);
-                    int cmpLo = compareTyped(val, loBuf, req.valueType);
-                    bool ok = false;
-                    if (cond == ScanCondition::BiggerThan)       ok = (cmpLo > 0);
-                    else if (cond == ScanCondition::SmallerThan) ok = (cmpLo < 0);
-                    else if (cond == ScanCondition::Between && !hiBuf.isEmpty()) {
-                        int cmpHi = compareTyped(val, hiBuf, req.valueType);
-                        ok = (cmpLo >= 0 && cmpHi <= 0);
-                    }
-                    if (ok) {
-                        ScanResult r;
-                        r.address = regStart + off + (uint64_t)i;
-                        r.regionModule = formatRegionContext(region, r.address);
-                        r.scanValue = std::move(val);
-                        results.append(r);
-                        if (results.size() >= req.maxResults)
-                            goto done;
-                    }
-                }
-            } else if (bmhEligible) {
-                // BMH path: no wildcards, alignment 1, pattern ≥4 bytes.
-                int searchFrom = 0;
-                while (searchFrom <= scanEnd) {
-                    if (m_abort.load()) goto done;
-                    int hit = bmhFind(data + searchFrom, readLen - searchFrom,
-                                       pat, patternLen);
-                    if (hit < 0) break;
-                    int absI = searchFrom + hit;
-                    if (absI > scanEnd) break;
-                    ScanResult r;
-                    r.address = regStart + off + (uint64_t)absI;
-                    r.regionModule = formatRegionContext(region, r.address);
-                    r.scanValue = QByteArray(data + absI, qMin(16, readLen - absI));
-                    results.append(r);
-                    if (results.size() >= req.maxResults)
-                        goto done;
-                    searchFrom = absI + 1;
-                }
-            } else {
-                // Naive aligned matcher (handles wildcards + alignment > 1).
-                for (int i = 0; i <= scanEnd; i += alignment) {
-                    if ((i & (kAbortStride - 1)) == 0 && m_abort.load())
-                        goto done;
-                    bool match = true;
-                    for (int j = 0; j < patternLen; j++) {
-                        if ((data[i + j] & msk[j]) != (pat[j] & msk[j])) {
-                            match = false;
-                            break;
-                        }
-                    }
-                    if (match) {
-                        ScanResult r;
-                        r.address = regStart + off + (uint64_t)i;
-                        r.regionModule = formatRegionContext(region, r.address);
-                        r.scanValue = QByteArray(data + i, qMin(16, readLen - i));
-                        results.append(r);
-
-                        if (results.size() >= req.maxResults)
-                            goto done;
-                    }
-                }
-            }
+            int readLen = (int)qMin(targetChunk, remaining);
 
             // Advance with overlap to catch patterns that straddle chunks.
             // Skip overlap on the final chunk -- nothing follows to overlap into.
             uint64_t advance;
             if ((uint64_t)readLen >= remaining)
                 advance = remaining;  // last chunk, no overlap needed
-             else if (readLen > overlap) {
-                  advance = (uint64_t)(readLen - overlap);
-                  if (alignment > 1) {
-                      uint64_t nextOff = off + advance;
-                      uint64_t aligned = ((nextOff + alignment - 1) / alignment) * alignment;
-                      advance = aligned - off;
-                  }
+            else if (readLen > overlap) {
+                advance = (uint64_t)(readLen - overlap);
+                if (alignment > 1) {
+                    uint64_t nextOff = off + advance;
+                    uint64_t aligned = ((nextOff + alignment - 1) / alignment) * alignment;
+                    advance = aligned - off;
+                }
             }
             else
                 advance = 1; // prevent infinite loop on tiny regions
-            scannedBytes += advance;
+
+            units.append({regionIndex, regStart + off, readLen, advance});
             off += advance;
+        }
+    }
 
-            // Throttled progress
-            int pct = (int)(scannedBytes * 100 / totalBytes);
-            if (pct > 100) pct = 100;
-            if (pct != lastPct) {
-                lastPct = pct;
-                QMetaObject::invokeMethod(this, "progress",
-                    Qt::QueuedConnection, Q_ARG(int, pct));
+    const int unitCount = units.size();
+
+    // A capture over at least snapshotThreshold slots keeps the bytes, not
+    // a list: each chunk copies the span it owns into the mapped file and
+    // nothing is matched. If the file can't be made, list as usual.
+    std::shared_ptr<ScanSnapshot> snap;
+    if (isCapture && !isMatrix && req.snapshotThreshold > 0
+        && totalSlots >= req.snapshotThreshold) {
+        QString err;
+        snap = ScanSnapshot::create(snapRegions, alignment, valSize,
+                                    req.snapshotThreshold, &err);
+        if (snap)
+            qDebug() << "[scan] snapshot mode:" << totalSlots << "slots,"
+                     << (snap->fileSize() / 1024) << "KB file";
+        else
+            qDebug() << "[scan] snapshot unavailable, listing instead:" << err;
+    }
+
+    QVector<ScanResultStore> unitResults(snap ? 0 : unitCount, ScanResultStore(valueWidth));
+    // Workers touch only their own slot; take the raw array up front so no
+    // thread goes through QVector's detach check concurrently.
+    ScanResultStore* unitOut = unitResults.data();
+
+    // Result cap across workers: once the chunks [0, k] — in grid order —
+    // hold maxResults hits between them, nothing past k can reach the
+    // merged output, so `cutoff` drops to k and later chunks stop early.
+    std::atomic<int> cutoff{INT_MAX};
+    QMutex prefixMutex;
+    QVector<char> unitDone(unitCount, 0);
+    int prefixDone = 0;
+    int prefixHits = 0;
+
+    // Streaming rides the same prefix walk: each unit that joins the
+    // in-order prefix is copied into `pending`, which is cut into a batch
+    // when it is full or the interval has passed. The very first hits go
+    // out immediately so a long scan shows something at once. Cut batches
+    // queue in `outbox` under prefixMutex; publish() pushes them, oldest
+    // first, under pushMutex alone, which makes the ring's producer side
+    // single-threaded. A full ring under streamBlockWhenFull stalls only
+    // the workers that have a batch to publish, never the prefix walk.
+    bool streaming = !snap && !isMatrix && req.streamBatchRows > 0 && m_stream;
+    ScanResultStore pending(valueWidth);
+    QVector<ScanResultStore> outbox;
+    QMutex pushMutex;
+    bool publishedAny = false;
+    QElapsedTimer sinceBatch;
+    sinceBatch.start();
+    auto cutBatch = [&]() {   // under prefixMutex
+        if (!streaming || pending.isEmpty()) return;
+        outbox.append(std::move(pending));
+        pending = ScanResultStore(valueWidth);
+        publishedAny = true;
+        sinceBatch.restart();
+    };
+    auto publish = [&]() {    // without prefixMutex
+        QMutexLocker push(&pushMutex);
+        for (;;) {
+            ScanResultStore batch(valueWidth);
+            {
+                QMutexLocker lock(&prefixMutex);
+                if (!streaming || outbox.isEmpty()) return;
+                batch = std::move(outbox.first());
+                outbox.removeFirst();
             }
+            while (!m_stream->push(std::move(batch))) {
+                if (!req.streamBlockWhenFull || m_abort.load()) {
+                    // The UI fell behind; the final result still has every row.
+                    qDebug() << "[scan] stream queue full, streaming stopped";
+                    QMutexLocker lock(&prefixMutex);
+                    streaming = false;
+                    outbox.clear();
+                    pending = ScanResultStore(valueWidth);
+                    return;
+                }
+                QThread::msleep(1);
+            }
+            if (!m_drainQueued.exchange(true))
+                QMetaObject::invokeMethod(this, "drainStream", Qt::QueuedConnection);
         }
+    };
+
+    std::atomic<int>      nextUnit{0};
+    std::atomic<uint64_t> progressBytes{tinyBytes};
+    std::atomic<int>      lastPct{-1};
+
+    auto worker = [&](ScanStats& st) {
+        QByteArray chunk;
+        for (;;) {
+            const int u = nextUnit.fetch_add(1);
+            if (u >= unitCount || u > cutoff.load() || m_abort.load()) break;
+            const ScanUnit& unit = units.at(u);
+            const MemoryRegion& region = regions.at(unit.region);
+
+            // Mapped sources are matched in place; everything else is
+            // copied into the chunk buffer first.
+            const char* bytes = reinterpret_cast<const char*>(
+                prov->directData(unit.addr, (uint64_t)unit.readLen));
+            if (!bytes) {
+                if (chunk.isEmpty()) chunk = QByteArray(maxChunk, Qt::Uninitialized);
+                if (prov->read(unit.addr, chunk.data(), unit.readLen)) {
+                    bytes = chunk.constData();
+                } else if (snap) {
+                    // Keep the readable pages of a partly mapped chunk; only
+                    // the pages that stay unreadable are lost.
+                    const uint64_t failed = readByPages(prov, unit.addr, chunk.data(), unit.readLen);
+                    if (failed < (uint64_t)unit.readLen) {
+                        bytes = chunk.constData();
+                        st.bytesFailed += failed;
+                        qDebug() << "[scan] partial read region" << unit.region << "addr" << Qt::showbase
+                                 << Qt::hex << unit.addr << "len" << unit.readLen << Qt::dec
+                                 << "unreadable" << failed;
+                    }
+                }
+            }
+
+            if (!bytes) {
+                // Skip unreadable chunk; track for status-line surfacing.
+                st.bytesFailed += unit.readLen;
+                qDebug() << "[scan] read failed region" << unit.region << "addr" << Qt::showbase << Qt::hex
+                         << unit.addr << "base" << region.base << "len" << unit.readLen << Qt::dec;
+            } else if (snap) {
+                // Copy only the bytes this chunk owns; the overlap belongs to
+                // the next one. Unreadable pages stay zero (sparse) in the
+                // file, as a failed rescan read would leave them.
+                const int r = snapIndex[unit.region];
+                const uint64_t off = unit.addr - snap->regions().at(r).base;
+                memcpy(snap->data(r) + off, bytes,
+                       (size_t)qMin<uint64_t>(unit.advance, unit.readLen));
+            } else if (!matchChunk(plan, region, unit.addr, bytes,
+                                   unit.readLen, unitOut[u],
+                                   ScanStop{&m_abort, &cutoff, u})) {
+                continue;   // aborted or past the cutoff — no progress credit
+            }
+            st.bytesScanned += unit.advance;
+
+            if (!snap) {
+                bool cut = false;
+                {
+                    QMutexLocker lock(&prefixMutex);
+                    unitDone[u] = 1;
+                    while (prefixDone < unitCount && unitDone[prefixDone]
+                           && cutoff.load() == INT_MAX) {
+                        const ScanResultStore& part = unitOut[prefixDone];
+                        if (streaming)
+                            pending.append(part, 0, qMin(part.size(), req.maxResults - prefixHits));
+                        prefixHits += part.size();
+                        if (prefixHits >= req.maxResults)
+                            cutoff.store(prefixDone);
+                        ++prefixDone;
+                    }
+                    if (streaming && !pending.isEmpty()
+                        && (!publishedAny || pending.size() >= req.streamBatchRows
+                            || sinceBatch.elapsed() >= req.streamIntervalMs)) {
+                        cutBatch();
+                        cut = true;
+                    }
+                }
+                if (cut) publish();
+            }
+
+            uint64_t done = progressBytes.fetch_add(unit.advance) + unit.advance;
+            advanceProgress(this, lastPct, (int)qMin<uint64_t>(100, done * 100 / totalBytes));
+        }
+    };
+
+    // The scan thread itself is worker 0; the rest come from the engine's
+    // own pool so nested waits can't starve QtConcurrent's global pool.
+    const int workerCount = qBound(1, QThread::idealThreadCount(), qMax(1, unitCount));
+    QVector<ScanStats> workerStats(workerCount);
+    ScanStats* statSlots = workerStats.data();
+    QVector<QFuture<void>> helpers;
+    for (int w = 1; w < workerCount; ++w)
+        helpers.append(QtConcurrent::run(&m_pool, [&worker, statSlots, w]() {
+            worker(statSlots[w]);
+        }));
+    worker(statSlots[0]);
+    for (auto& f : helpers) f.waitForFinished();
+    if (!m_abort.load()) {
+        // The tail, so the batches add up to the final set.
+        {
+            QMutexLocker lock(&prefixMutex);
+            cutBatch();
+        }
+        publish();
     }
 
-done:
-    qDebug() << "[scan] done:" << results.size() << "results in" << timer.elapsed() << "ms"
+    uint64_t scannedBytes = tinyBytes;
+    uint64_t failedBytes = 0;
+    for (const ScanStats& st : workerStats) {
+        scannedBytes += st.bytesScanned;
+        failedBytes  += st.bytesFailed;
+    }
+
+    // Merge in grid order — the exact sequence a single-threaded walk
+    // would have appended — and trim to the cap. A snapshot is the result
+    // as-is, unless the scan was aborted part way through its copy.
+    results = ScanResultStore(valueWidth);
+    if (snap && !m_abort.load())
+        results = ScanResultStore::fromSnapshot(snap);
+    for (int u = 0; u < unitResults.size() && results.size() < req.maxResults; ++u) {
+        const ScanResultStore& part = unitResults.at(u);
+        int take = qMin(part.size(), req.maxResults - results.size());
+        if (results.isEmpty() && take == part.size()) {
+            results = part;
+            continue;
+        }
+        results.append(part, 0, take);
+    }
+
+    qDebug() << "[scan] done:" << results.candidateCount() << "results in" << timer.elapsed() << "ms"
              << " scanned:" << (scannedBytes / 1024) << "KB"
-             << " failed:" << (failedBytes / 1024) << "KB";
+             << " failed:" << (failedBytes / 1024) << "KB"
+             << " chunks:" << unitCount << " workers:" << workerCount;
     ScanStats stats;
     stats.regionsScanned = acceptedRegions;
     stats.bytesScanned   = scannedBytes;
@@ -948,17 +1873,23 @@ done:
 
     // Matrix mode: rank best candidates first so the top result is the most
     // matrix-like window.
-    if (isMatrix && results.size() > 1) {
-        std::sort(results.begin(), results.end(),
-                  [](const ScanResult& a, const ScanResult& b) {
-                      return a.matchScore > b.matchScore;
-                  });
-    }
+    if (isMatrix && results.size() > 1)
+        results.sortByScore();
     return results;
 }
 
 void ScanEngine::startRescan(std::shared_ptr<Provider> provider,
-                              QVector<ScanResult> results, int readSize,
+                              const QVector<ScanResult>& results, int readSize,
+                              ScanCondition condition, ValueType valueType,
+                              const QByteArray& filterPattern,
+                              const QByteArray& filterMask,
+                              const QByteArray& filterPattern2) {
+    startRescan(std::move(provider), ScanResultStore::fromVector(results), readSize,
+                condition, valueType, filterPattern, filterMask, filterPattern2);
+}
+
+void ScanEngine::startRescan(std::shared_ptr<Provider> provider,
+                              ScanResultStore results, int readSize,
                               ScanCondition condition, ValueType valueType,
                               const QByteArray& filterPattern,
                               const QByteArray& filterMask,
@@ -967,15 +1898,15 @@ void ScanEngine::startRescan(std::shared_ptr<Provider> provider,
 
     m_abort.store(false);
 
-    auto* watcher = new QFutureWatcher<QVector<ScanResult>>(this);
+    auto* watcher = new QFutureWatcher<ScanResultStore>(this);
     m_watcher = watcher;
 
-    connect(watcher, &QFutureWatcher<QVector<ScanResult>>::finished, this, [this, watcher]() {
+    connect(watcher, &QFutureWatcher<ScanResultStore>::finished, this, [this, watcher]() {
         auto results = watcher->result();
         watcher->deleteLater();
         if (m_watcher == watcher)
             m_watcher = nullptr;
-        emit rescanFinished(results);
+        emitFinished(results, true);
     });
 
     watcher->setFuture(QtConcurrent::run(
@@ -987,193 +1918,381 @@ void ScanEngine::startRescan(std::shared_ptr<Provider> provider,
         }));
 }
 
-QVector<ScanResult> ScanEngine::runRescan(std::shared_ptr<Provider> prov,
-                                           QVector<ScanResult> results, int readSize,
-                                           ScanCondition condition, ValueType valueType,
-                                           const QByteArray& filterPattern,
-                                           const QByteArray& filterMask,
-                                           const QByteArray& filterPattern2) {
+ScanResultStore ScanEngine::runRescan(std::shared_ptr<Provider> prov,
+                                       ScanResultStore results, int readSize,
+                                       ScanCondition condition, ValueType valueType,
+                                       const QByteArray& filterPattern,
+                                       const QByteArray& filterMask,
+                                       const QByteArray& filterPattern2) {
     QElapsedTimer timer;
     timer.start();
 
+    if (!prov) return results;
+    const RescanFilter filter(condition, valueType, readSize,
+                              filterPattern, filterMask, filterPattern2);
+    if (results.isSnapshot())
+        return runSnapshotRescan(std::move(prov), std::move(results), filter);
+
     int total = results.size();
-    if (total == 0 || !prov) return results;
-
-    bool hasExactFilter = !filterPattern.isEmpty() && condition == ScanCondition::ExactValue;
-    bool hasComparison = (condition == ScanCondition::Changed ||
-                          condition == ScanCondition::Unchanged ||
-                          condition == ScanCondition::Increased ||
-                          condition == ScanCondition::Decreased);
-    bool hasTypedConst = (condition == ScanCondition::BiggerThan ||
-                          condition == ScanCondition::SmallerThan ||
-                          condition == ScanCondition::Between);
-    bool hasDelta      = (condition == ScanCondition::IncreasedBy ||
-                          condition == ScanCondition::DecreasedBy);
-    bool needsFilter = hasExactFilter || hasComparison || hasTypedConst || hasDelta;
+    if (total == 0) return results;
+    const bool needsFilter = filter.needsFilter;
 
     qDebug() << "[rescan] start:" << total << "results, readSize:" << readSize
              << "condition:" << (int)condition
-             << "exactFilter:" << (hasExactFilter ? "yes" : "no")
-             << "comparison:" << (hasComparison ? "yes" : "no");
-
-    // Save previous values
-    for (auto& r : results)
-        r.previousValue = r.scanValue;
-
-    // Sort indices by address for sequential chunked reads
-    QVector<int> order(total);
-    for (int i = 0; i < total; i++) order[i] = i;
-    std::sort(order.begin(), order.end(), [&results](int a, int b) {
-        return results[a].address < results[b].address;
-    });
+             << "exactFilter:" << (filter.hasExactFilter ? "yes" : "no")
+             << "comparison:" << (filter.hasComparison ? "yes" : "no");
+
+    // Values are re-read at readSize, so restride the arena to match, then
+    // give every row a previous-value slot. Both detach the store from the
+    // caller's copy once, here, before any worker touches a column.
+    results.setValueWidth(readSize);
+    results.ensurePrevious();
+    ScanResultStore::Data* col = results.d.data();
+    const uint64_t* addrs = col->addrs.data();
+
+    // Visit results in address order for sequential chunked reads. A first
+    // scan already yields ascending addresses, so the index is only built
+    // (and sorted) when an edit or a loaded file broke the order.
+    std::vector<int> order;
+    if (!std::is_sorted(addrs, addrs + total)) {
+        order.resize(total);
+        for (int i = 0; i < total; i++) order[i] = i;
+        std::sort(order.begin(), order.end(),
+                  [addrs](int a, int b) { return addrs[a] < addrs[b]; });
+    }
+    const int* sorted = order.empty() ? nullptr : order.data();
+    auto rowAt = [sorted](int j) { return sorted ? sorted[j] : j; };
 
+    // Group into spans of at most kChunk bytes, one read each.
     constexpr int kChunk = 256 * 1024;
-    int updated = 0;
-    int lastPct = -1;
-    int chunks = 0;
-    uint64_t totalBytesRead = 0;
-    int i = 0;
-
-    // Track which results matched (by original index)
-    QVector<bool> matched(total, !needsFilter); // if no filter, all match
-
-    while (i < total && !m_abort.load()) {
-        uint64_t spanBase = results[order[i]].address;
+    struct Span { int first; int last; uint64_t base; int len; };
+    QVector<Span> spans;
+    int maxSpan = 0;
+    for (int i = 0; i < total; ) {
+        uint64_t spanBase = addrs[rowAt(i)];
         int spanEnd = i;
 
         // Extend span while next result fits in the same chunk
         while (spanEnd + 1 < total) {
-            uint64_t endAddr = results[order[spanEnd + 1]].address + readSize;
+            uint64_t endAddr = addrs[rowAt(spanEnd + 1)] + readSize;
             if (endAddr - spanBase > (uint64_t)kChunk) break;
             spanEnd++;
         }
 
-        uint64_t spanLast = results[order[spanEnd]].address;
-        int chunkLen = (int)(spanLast + readSize - spanBase);
-        QByteArray chunk(chunkLen, '\0');
-        prov->read(spanBase, chunk.data(), chunkLen);
-
-        for (int j = i; j <= spanEnd; j++) {
-            int idx = order[j];
-            auto& r = results[idx];
-            int off = (int)(r.address - spanBase);
-            r.scanValue = chunk.mid(off, readSize);
-
-            // Apply exact-value filter
-            if (hasExactFilter) {
-                int patLen = filterPattern.size();
-                if (r.scanValue.size() >= patLen) {
-                    bool ok = true;
-                    const char* data = r.scanValue.constData();
-                    const char* pat  = filterPattern.constData();
-                    const char* msk  = filterMask.constData();
-                    for (int k = 0; k < patLen; k++) {
-                        if ((data[k] & msk[k]) != (pat[k] & msk[k])) {
-                            ok = false;
-                            break;
-                        }
-                    }
-                    matched[idx] = ok;
-                }
-            }
+        int len = (int)(addrs[rowAt(spanEnd)] + readSize - spanBase);
+        spans.append({i, spanEnd, spanBase, len});
+        maxSpan = qMax(maxSpan, len);
+        i = spanEnd + 1;
+    }
+    const int spanCount = spans.size();
 
-            // Apply comparison-based filter
-            if (hasComparison && !r.previousValue.isEmpty()) {
-                int cmp = compareTyped(r.scanValue, r.previousValue, valueType);
-                switch (condition) {
-                case ScanCondition::Changed:   matched[idx] = (cmp != 0); break;
-                case ScanCondition::Unchanged: matched[idx] = (cmp == 0); break;
-                case ScanCondition::Increased: matched[idx] = (cmp > 0);  break;
-                case ScanCondition::Decreased: matched[idx] = (cmp < 0);  break;
-                default: break;
-                }
-            }
+    // Track which results matched (by original index)
+    QVector<char> matched(total, !needsFilter); // if no filter, all match
+
+    // Workers write disjoint rows through raw column pointers — no detach
+    // checks racing across threads.
+    const int width = col->width;
+    char* values = col->values.data();
+    uint16_t* lens = col->lens.empty() ? nullptr : col->lens.data();
+    char* prevValues = col->prev.data();
+    uint16_t* prevLens = col->prevLens.data();
+    char* hit = matched.data();
+
+    // Evaluate one result against the bytes just read, in place. Nothing
+    // allocates: the value slot is compared where it sits, then rolled into
+    // the previous-value column for survivors.
+    auto evaluate = [&](int idx, const char* cur) {
+        char* slot = values + (size_t)idx * width;
+        const int prevLen = lens ? lens[idx] : width;
+        hit[idx] = filter(cur, slot, prevLen);
+
+        // Survivors roll the value into the previous column. Dropped
+        // results are compacted away, so they skip the update entirely.
+        if (!hit[idx]) return;
+        memcpy(prevValues + (size_t)idx * width, slot, prevLen);
+        prevLens[idx] = (uint16_t)prevLen;
+        memcpy(slot, cur, width);
+        if (lens) lens[idx] = (uint16_t)width;
+    };
 
-            // Typed const compare (BiggerThan / SmallerThan / Between).
-            // filterPattern carries the lower bound (or sole bound);
-            // filterPattern2 carries the upper bound for Between.
-            if (hasTypedConst && !filterPattern.isEmpty()) {
-                int cmpLo = compareTyped(r.scanValue, filterPattern, valueType);
-                if (condition == ScanCondition::BiggerThan)
-                    matched[idx] = (cmpLo > 0);
-                else if (condition == ScanCondition::SmallerThan)
-                    matched[idx] = (cmpLo < 0);
-                else if (condition == ScanCondition::Between
-                         && !filterPattern2.isEmpty()) {
-                    int cmpHi = compareTyped(r.scanValue, filterPattern2, valueType);
-                    matched[idx] = (cmpLo >= 0 && cmpHi <= 0);
-                }
+    std::atomic<int> nextSpan{0};
+    std::atomic<int> updated{0};
+    std::atomic<int> lastPct{-1};
+    std::atomic<uint64_t> totalBytesRead{0};
+
+    // Each worker keeps two buffers: while it compares span k out of one,
+    // the read of its next span k' fills the other on m_ioPool.
+    auto worker = [&]() {
+        QByteArray bufs[2] = {QByteArray(maxSpan, Qt::Uninitialized),
+                              QByteArray(maxSpan, Qt::Uninitialized)};
+        // Where span k's bytes end up: the mapping itself for sources that
+        // offer it (nothing to fetch), else the buffer being filled.
+        const char* ready[2] = {nullptr, nullptr};
+        auto startRead = [&](int k, int into) {
+            const Span sp = spans.at(k);
+            if (const uint8_t* direct = prov->directData(sp.base, (uint64_t)sp.len)) {
+                ready[into] = reinterpret_cast<const char*>(direct);
+                return QFuture<void>();
             }
-
-            // Delta compare (IncreasedBy / DecreasedBy). Only meaningful when
-            // a previous value exists; first scan can't satisfy this.
-            if (hasDelta && !r.previousValue.isEmpty()
-                && !filterPattern.isEmpty()) {
-                // Compute previous + delta (or - delta) and compare element-wise.
-                // We only need exact byte match against the typed addition.
-                int sz = qMin(r.previousValue.size(), filterPattern.size());
-                if (r.scanValue.size() >= sz) {
-                    bool ok = false;
-                    auto addAndCheck = [&](auto sample) {
-                        using T = decltype(sample);
-                        if (sz < (int)sizeof(T)) return;
-                        T prev{}, delta{}, cur{};
-                        memcpy(&prev,  r.previousValue.constData(), sizeof(T));
-                        memcpy(&delta, filterPattern.constData(),    sizeof(T));
-                        memcpy(&cur,   r.scanValue.constData(),      sizeof(T));
-                        T expected = (condition == ScanCondition::IncreasedBy)
-                                     ? T(prev + delta) : T(prev - delta);
-                        ok = (cur == expected);
-                    };
-                    switch (valueType) {
-                    case ValueType::Int8:   addAndCheck(int8_t{});   break;
-                    case ValueType::UInt8:  addAndCheck(uint8_t{});  break;
-                    case ValueType::Int16:  addAndCheck(int16_t{});  break;
-                    case ValueType::UInt16: addAndCheck(uint16_t{}); break;
-                    case ValueType::Int32:  addAndCheck(int32_t{});  break;
-                    case ValueType::UInt32: addAndCheck(uint32_t{}); break;
-                    case ValueType::Int64:  addAndCheck(int64_t{});  break;
-                    case ValueType::UInt64: addAndCheck(uint64_t{}); break;
-                    case ValueType::Float:  addAndCheck(float{});    break;
-                    case ValueType::Double: addAndCheck(double{});   break;
-                    default: break;
-                    }
-                    matched[idx] = ok;
+            char* dst = bufs[into].data();
+            ready[into] = dst;
+            return QtConcurrent::run(&m_ioPool, [prov, sp, dst]() {
+                if (!prov->read(sp.base, dst, sp.len)) {
+                    memset(dst, 0, sp.len);
                 }
+            });
+        };
+
+        int cur = nextSpan.fetch_add(1);
+        if (cur >= spanCount || m_abort.load()) return;
+        int slot = 0;
+        QFuture<void> pending = startRead(cur, slot);
+        for (;;) {
+            pending.waitForFinished();
+            int nxt = m_abort.load() ? spanCount : nextSpan.fetch_add(1);
+            if (nxt < spanCount)
+                pending = startRead(nxt, slot ^ 1);
+
+            const Span& sp = spans.at(cur);
+            const char* data = ready[slot];
+            for (int j = sp.first; j <= sp.last; j++) {
+                const int idx = rowAt(j);
+                evaluate(idx, data + (addrs[idx] - sp.base));
             }
-        }
 
-        chunks++;
-        totalBytesRead += chunkLen;
-        updated += (spanEnd - i + 1);
-        i = spanEnd + 1;
+            totalBytesRead.fetch_add(sp.len);
+            int done = updated.fetch_add(sp.last - sp.first + 1) + (sp.last - sp.first + 1);
+            advanceProgress(this, lastPct, (int)((int64_t)done * 100 / total));
 
-        int pct = updated * 100 / total;
-        if (pct != lastPct) {
-            lastPct = pct;
-            QMetaObject::invokeMethod(this, "progress",
-                Qt::QueuedConnection, Q_ARG(int, pct));
+            if (nxt >= spanCount) break;
+            cur = nxt;
+            slot ^= 1;
         }
-    }
+    };
+
+    const int workerCount = qBound(1, QThread::idealThreadCount(), spanCount);
+    QVector<QFuture<void>> helpers;
+    for (int w = 1; w < workerCount; ++w)
+        helpers.append(QtConcurrent::run(&m_pool, worker));
+    worker();
+    for (auto& f : helpers) f.waitForFinished();
 
-    // Filter out non-matching results
+    const int chunks = qMin(nextSpan.load(), spanCount);
+
+    // Filter out non-matching results — compacted in place, original order.
     if (needsFilter) {
-        QVector<ScanResult> filtered;
-        filtered.reserve(total);
-        for (int k = 0; k < total; k++) {
-            if (matched[k])
-                filtered.append(std::move(results[k]));
-        }
-        qDebug() << "[rescan] done:" << filtered.size() << "/" << total
+        results.compact(matched.constData());
+        const int kept = results.size();
+        qDebug() << "[rescan] done:" << kept << "/" << total
                  << "matched in" << timer.elapsed() << "ms |" << chunks
-                 << "chunks," << (totalBytesRead / 1024) << "KB read";
-        return filtered;
+                 << "chunks," << (totalBytesRead.load() / 1024) << "KB read |"
+                 << workerCount << "workers";
+        return results;
     }
 
-    qDebug() << "[rescan] done:" << updated << "/" << total << "results in"
+    qDebug() << "[rescan] done:" << updated.load() << "/" << total << "results in"
              << timer.elapsed() << "ms |" << chunks << "chunks,"
-             << (totalBytesRead / 1024) << "KB read";
+             << (totalBytesRead.load() / 1024) << "KB read |" << workerCount << "workers";
     return results;
 }
 
+// ── Snapshot rescan ──
+//
+// Walks the previous snapshot slot by slot: each candidate is compared
+// against its captured bytes, and every chunk's live bytes go into a fresh
+// snapshot together with the survivor bitmap. Chunks cover a multiple of 8
+// slots, so each owns whole bitmap bytes and workers never share one.
+// While the survivors stay under the threshold they're also collected as
+// rows; if the pass ends below it, those rows are the result and the new
+// file is dropped.
+ScanResultStore ScanEngine::runSnapshotRescan(std::shared_ptr<Provider> prov,
+                                              ScanResultStore results,
+                                              const RescanFilter& filter) {
+    QElapsedTimer timer;
+    timer.start();
+
+    const std::shared_ptr<ScanSnapshot> old = results.snapshot();
+    const int align = old->alignment();
+    const int vs = old->valueSize();
+    const qint64 threshold = old->threshold();
+    // Slot geometry is fixed at capture, so values compare at its width.
+    RescanFilter f = filter;
+    f.readSize = vs;
+
+    // Regions that ran out of candidates drop out of the next file.
+    QVector<ScanSnapshot::Region> regs;
+    QVector<int> oldIndex;
+    for (int r = 0; r < old->regions().size(); ++r) {
+        const ScanSnapshot::Region& o = old->regions().at(r);
+        if (o.candidates == 0) continue;
+        ScanSnapshot::Region nr;
+        nr.base       = o.base;
+        nr.size       = o.size;
+        nr.moduleName = o.moduleName;
+        nr.moduleBase = o.moduleBase;
+        regs.append(nr);
+        oldIndex.append(r);
+    }
+
+    QString err;
+    std::shared_ptr<ScanSnapshot> snap = ScanSnapshot::create(regs, align, vs, threshold, &err);
+    if (!snap) {
+        QMetaObject::invokeMethod(this, "error", Qt::QueuedConnection, Q_ARG(QString, err));
+        return results;
+    }
+
+    qDebug() << "[rescan] snapshot start:" << old->candidateCount() << "candidates,"
+             << regs.size() << "regions, condition:" << (int)f.condition;
+
+    struct SlotUnit { int region; qint64 first; qint64 last; };   // [first, last)
+    constexpr int kChunkBig = 2 * 1024 * 1024;
+    const qint64 slotsPerUnit = qMax<qint64>(8, (kChunkBig / align) & ~qint64(7));
+    QVector<SlotUnit> units;
+    uint64_t totalBytes = 0;
+    for (int r = 0; r < snap->m_regions.size(); ++r) {
+        const qint64 slots = snap->m_regions[r].slots;
+        for (qint64 s = 0; s < slots; s += slotsPerUnit)
+            units.append({r, s, qMin(slots, s + slotsPerUnit)});
+        totalBytes += snap->m_regions[r].size;
+    }
+    const int unitCount = units.size();
+
+    QVector<ScanResultStore> parts(unitCount, ScanResultStore(vs));
+    QVector<qint64> unitHits(unitCount, 0);
+    ScanResultStore* partOut = parts.data();
+    qint64* hitOut = unitHits.data();
+
+    std::atomic<int>      nextUnit{0};
+    std::atomic<qint64>   survivors{0};
+    std::atomic<bool>     overflow{threshold <= 0};
+    std::atomic<uint64_t> progressBytes{0};
+    std::atomic<uint64_t> bytesRead{0};
+    std::atomic<uint64_t> bytesFailed{0};
+    std::atomic<int>      lastPct{-1};
+
+    auto worker = [&]() {
+        QByteArray buf;
+        QVector<QPair<int, int>> holes;
+        for (;;) {
+            const int u = nextUnit.fetch_add(1);
+            if (u >= unitCount || m_abort.load()) break;
+            const SlotUnit& unit = units.at(u);
+            const int oldR = oldIndex[unit.region];
+            const ScanSnapshot::Region& reg = snap->regions().at(unit.region);
+
+            // Bytes this chunk owns in the file, and the span it must read
+            // so its last slot has a whole value.
+            const uint64_t from = (uint64_t)unit.first * align;
+            const bool tail = unit.last == reg.slots;
+            const uint64_t ownEnd = tail ? reg.size : (uint64_t)unit.last * align;
+            const uint64_t readEnd = tail ? reg.size
+                : qMax(ownEnd, (uint64_t)(unit.last - 1) * align + vs);
+            const int readLen = (int)(readEnd - from);
+
+            bool any = old->m_dense;
+            const uchar* oldMask = old->mask(oldR);
+            for (qint64 b = unit.first >> 3; !any && b < (unit.last + 7) >> 3; ++b)
+                any = oldMask[b] != 0;
+            if (any) {
+                const char* cur = reinterpret_cast<const char*>(
+                    prov->directData(reg.base + from, (uint64_t)readLen));
+                holes.clear();
+                if (!cur) {
+                    if (buf.size() < readLen) buf.resize(readLen);
+                    if (!prov->read(reg.base + from, buf.data(), readLen)) {
+                        const uint64_t failed =
+                            readByPages(prov, reg.base + from, buf.data(), readLen, &holes);
+                        bytesFailed.fetch_add(failed);
+                    }
+                    cur = buf.constData();
+                }
+                bytesRead.fetch_add(readLen);
+
+                const char* prev = reinterpret_cast<const char*>(old->data(oldR));
+                uchar* mask = snap->mask(unit.region);
+                ScanResultStore& part = partOut[u];
+                const int label = part.internRegion(reg.moduleName, reg.moduleBase);
+                bool collect = !overflow.load(std::memory_order_relaxed);
+                qint64 hits = 0;
+                int hole = 0;
+                for (qint64 s = unit.first; s < unit.last; ++s) {
+                    if (!old->m_dense && !((oldMask[s >> 3] >> (s & 7)) & 1)) continue;
+                    // A value touching an unreadable page has no current
+                    // value to test; drop it rather than compare zeros.
+                    const int at = (int)((s - unit.first) * align);
+                    while (hole < holes.size() && holes[hole].second <= at) ++hole;
+                    if (hole < holes.size() && holes[hole].first < at + vs) continue;
+                    const char* now = cur + (size_t)at;
+                    const char* was = prev + (size_t)s * align;
+                    if (!f(now, was, vs)) continue;
+                    mask[s >> 3] |= uchar(1u << (s & 7));
+                    ++hits;
+                    if (!collect) continue;
+                    if (survivors.load(std::memory_order_relaxed) + hits >= threshold) {
+                        overflow.store(true);
+                        collect = false;
+                        part.clear();
+                        continue;
+                    }
+                    part.appendRow(reg.base + (uint64_t)s * align, now, vs, label, 0, was, vs);
+                }
+                memcpy(snap->data(unit.region) + from, cur, (size_t)(ownEnd - from));
+                hitOut[u] = hits;
+                if (survivors.fetch_add(hits) + hits >= threshold)
+                    overflow.store(true);
+                if (overflow.load()) part.clear();
+            }
+
+            uint64_t done = progressBytes.fetch_add(ownEnd - from) + (ownEnd - from);
+            advanceProgress(this, lastPct, (int)qMin<uint64_t>(100, done * 100 / qMax<uint64_t>(1, totalBytes)));
+        }
+    };
+
+    const int workerCount = qBound(1, QThread::idealThreadCount(), qMax(1, unitCount));
+    QVector<QFuture<void>> helpers;
+    for (int w = 1; w < workerCount; ++w)
+        helpers.append(QtConcurrent::run(&m_pool, worker));
+    worker();
+    for (auto& fut : helpers) fut.waitForFinished();
+
+    if (m_abort.load()) {
+        qDebug() << "[rescan] snapshot aborted, keeping previous candidates";
+        return results;
+    }
+
+    ScanStats stats;
+    stats.regionsScanned = regs.size();
+    stats.bytesScanned   = bytesRead.load();
+    stats.bytesFailed    = bytesFailed.load();
+    stats.msElapsed      = (int)timer.elapsed();
+    QMetaObject::invokeMethod(this, "scanStats",
+        Qt::QueuedConnection, Q_ARG(rcx::ScanStats, stats));
+
+    // create() seeded every slot as a candidate; replace with survivors.
+    qint64 total = 0;
+    for (ScanSnapshot::Region& r : snap->m_regions) r.candidates = 0;
+    for (int u = 0; u < unitCount; ++u) {
+        snap->m_regions[units[u].region].candidates += unitHits[u];
+        total += unitHits[u];
+    }
+
+    if (total < threshold) {
+        ScanResultStore listed(vs);
+        listed.reserve((int)total);
+        for (const ScanResultStore& part : parts)
+            listed.append(part, 0, part.size());
+        qDebug() << "[rescan] snapshot done:" << listed.size() << "/" << old->candidateCount()
+                 << "listed in" << timer.elapsed() << "ms |"
+                 << (bytesRead.load() / 1024) << "KB read |" << (bytesFailed.load() / 1024) << "KB unreadable |" << workerCount << "workers";
+        return listed;
+    }
+
+    snap->m_dense = false;
+    snap->m_candidates = total;
+    qDebug() << "[rescan] snapshot done:" << total << "/" << old->candidateCount()
+             << "kept in snapshot in" << timer.elapsed() << "ms |"
+             << (bytesRead.load() / 1024) << "KB read |" << (bytesFailed.load() / 1024) << "KB unreadable |" << workerCount << "workers";
+    return ScanResultStore::fromSnapshot(snap);
+}
+
 } // namespace rcx
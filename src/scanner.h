@@ -1,13 +1,20 @@
 #pragma once
 #include "providers/provider.h"
 #include "matrixscan.h"
+#include "pointerscan.h"
+#include "spscring.h"
 #include <QObject>
 #include <QByteArray>
 #include <QString>
 #include <QVector>
+#include <QHash>
+#include <QSharedData>
+#include <QTemporaryFile>
 #include <QFutureWatcher>
+#include <QThreadPool>
 #include <atomic>
 #include <memory>
+#include <vector>
 
 namespace rcx {
 
@@ -59,6 +66,27 @@ struct ScanRequest {
     int alignment  = 1;             // 1 = every byte, 4 = dword, 8 = qword
     int maxResults = 50000;
 
+    // Capture scans (UnknownValue and the compare-against-previous
+    // conditions): once the target holds at least this many aligned slots,
+    // keep a memory-mapped snapshot of the region bytes instead of listing
+    // every address (see ScanSnapshot). maxResults does not apply then.
+    // Rescans list survivors explicitly once fewer than this remain.
+    // 0 = always list.
+    int snapshotThreshold = 0;
+
+    // Partial-result streaming for listed first scans: hits are published
+    // as partialResults() batches, in final-result order, once a batch holds
+    // streamBatchRows hits or streamIntervalMs has passed since the last
+    // one. Batches wait in a ring of streamQueueDepth slots until the GUI
+    // thread drains it; when the ring is full, streamBlockWhenFull stalls
+    // the scan workers until it drains (memory stays bounded by the ring),
+    // otherwise streaming stops for the rest of the scan. The finished
+    // result set is complete either way. 0 = no streaming.
+    int  streamBatchRows    = 0;
+    int  streamIntervalMs   = 100;
+    int  streamQueueDepth   = 16;
+    bool streamBlockWhenFull = false;
+
     ScanCondition condition = ScanCondition::ExactValue;
     int valueSize = 4;              // bytes per value (for unknown scans)
     ValueType valueType = ValueType::Int32;  // typed compares (BiggerThan/Between/etc.)
@@ -90,11 +118,221 @@ struct ScanResult {
     int        matchScore = 0;  // 0..100 for scored scans (matrix mode); 0 otherwise
 };
 
+// ── Unknown-value snapshot ──
+//
+// An unknown-value first scan has one candidate per aligned slot, so a
+// large target yields hundreds of millions of them. Listing them is the
+// wrong representation. A snapshot instead copies the scanned regions into
+// a memory-mapped temporary file. A candidate's address is implicit: its
+// region base plus slot * alignment. Each rescan compares live memory
+// against the mapped bytes and writes a new snapshot holding the current
+// bytes plus a survivor bitmap (1 bit per slot). Resident memory is bounded
+// by the page cache, not by the size of the target.
+//
+// Snapshots are written once, by the pass that creates them, and are
+// read-only afterwards.
+class ScanSnapshot {
+public:
+    struct Region {
+        uint64_t base = 0;         // first snapshotted address
+        uint64_t size = 0;
+        QString  moduleName;       // "module+0xOFF" labels, relative to moduleBase
+        uint64_t moduleBase = 0;
+        qint64   slots = 0;        // aligned positions with a full value in range
+        qint64   candidates = 0;
+        qint64   dataOffset = 0;   // file offsets, filled in by create()
+        qint64   maskOffset = 0;
+    };
+
+    // Lays out [region bytes...][survivor bitmaps...] in a temporary file and
+    // maps it. Slot counts are derived from alignment/valueSize; every slot
+    // starts out a candidate. Returns nullptr if the file can't be created,
+    // sized or mapped.
+    static std::shared_ptr<ScanSnapshot> create(QVector<Region> regions, int alignment,
+                                                int valueSize, int threshold,
+                                                QString* errorMsg = nullptr);
+
+    int    alignment() const { return m_alignment; }
+    int    valueSize() const { return m_valueSize; }
+    // Rescans materialize an explicit result list below this many survivors.
+    int    threshold() const { return m_threshold; }
+    qint64 candidateCount() const { return m_candidates; }
+    qint64 fileSize() const { return m_fileSize; }
+    const QVector<Region>& regions() const { return m_regions; }
+
+    const uchar* data(int region) const { return m_map + m_regions.at(region).dataOffset; }
+    const uchar* mask(int region) const { return m_map + m_regions.at(region).maskOffset; }
+    bool isCandidate(int region, qint64 slot) const {
+        return m_dense || ((mask(region)[slot >> 3] >> (slot & 7)) & 1);
+    }
+
+private:
+    friend class ScanEngine;
+    ScanSnapshot() = default;
+    uchar* data(int region) { return m_map + m_regions.at(region).dataOffset; }
+    uchar* mask(int region) { return m_map + m_regions.at(region).maskOffset; }
+
+    QTemporaryFile  m_file;
+    uchar*          m_map = nullptr;
+    qint64          m_fileSize = 0;
+    QVector<Region> m_regions;
+    int    m_alignment = 1;
+    int    m_valueSize = 4;
+    int    m_threshold = 0;
+    qint64 m_candidates = 0;
+    bool   m_dense = true;     // no bitmap yet: every slot is a candidate
+};
+
+// ── Columnar result set ──
+//
+// What the engine actually hands around. A ScanResult per hit costs a
+// QString plus two QByteArray headers and heap blocks (~100 B before any
+// payload); an unknown-value first scan over a few GB of memory produces
+// hundreds of millions of hits. The store keeps one column per field
+// instead: a flat address array, a fixed-width value arena, and a region
+// index that is interned once per region and run-length encoded by row.
+// An Int32 capture costs 12 bytes a hit (address + value), 18 once a
+// rescan adds the previous-value column.
+//
+// Columns are std::vector rather than QVector so a store can grow past
+// Qt 5's 2 GB container limit. The column block is implicitly shared:
+// copies (undo snapshots, queued signal arguments) are O(1) and the first
+// write detaches.
+//
+// ScanResult stays as the row type — at()/operator[]/iteration build one
+// lazily, so code that only shows a page of rows never materializes the
+// rest.
+class ScanResultStore {
+public:
+    ScanResultStore();
+    explicit ScanResultStore(int valueWidth);
+
+    int  size() const    { return (int)d->addrs.size(); }
+    int  count() const   { return size(); }
+    bool isEmpty() const { return d->addrs.empty() && candidateCount() == 0; }
+    // Fixed arena stride. Values shorter than the stride (a BMH hit near a
+    // chunk end, a short loaded value) keep their own length.
+    int  valueWidth() const { return d->width; }
+    bool hasPrevious() const { return !d->prevLens.empty(); }
+    bool hasScores() const   { return !d->scores.empty(); }
+
+    // Snapshot-backed sets (large capture scans) have no explicit rows:
+    // size() is 0 and the candidates live in the snapshot until a rescan
+    // narrows them below its threshold.
+    static ScanResultStore fromSnapshot(std::shared_ptr<ScanSnapshot> snapshot);
+    bool   isSnapshot() const { return d->snapshot != nullptr; }
+    const std::shared_ptr<ScanSnapshot>& snapshot() const { return d->snapshot; }
+    qint64 candidateCount() const {
+        return d->snapshot ? d->snapshot->candidateCount() : (qint64)d->addrs.size();
+    }
+
+    // ── Lazy accessors ──
+    uint64_t    address(int i) const { return d->addrs[i]; }
+    const char* valueData(int i) const { return d->values.data() + (size_t)i * d->width; }
+    int         valueLength(int i) const { return d->lens.empty() ? d->width : d->lens[i]; }
+    QByteArray  value(int i) const { return QByteArray(valueData(i), valueLength(i)); }
+    QByteArray  previousValue(int i) const;
+    // previousData(i) is only valid when previousLength(i) > 0.
+    const char* previousData(int i) const { return d->prev.data() + (size_t)i * d->width; }
+    int         previousLength(int i) const { return d->prevLens.empty() ? 0 : d->prevLens[i]; }
+    // "module+0xOFF" for hits in a named module, empty otherwise. Formatted
+    // on demand from the interned region; never stored per hit.
+    QString     regionModule(int i) const;
+    int         matchScore(int i) const { return d->scores.empty() ? 0 : d->scores[i]; }
+    // True when at least one row falls inside a named module.
+    bool        hasModules() const;
+    ScanResult  at(int i) const;
+    ScanResult  operator[](int i) const { return at(i); }
+    ScanResult  first() const { return at(0); }
+
+    // Read-only row iteration (rows are built on dereference).
+    class const_iterator {
+    public:
+        const_iterator(const ScanResultStore* s, int i) : m_s(s), m_i(i) {}
+        ScanResult operator*() const { return m_s->at(m_i); }
+        const_iterator& operator++() { ++m_i; return *this; }
+        bool operator==(const const_iterator& o) const { return m_i == o.m_i; }
+        bool operator!=(const const_iterator& o) const { return m_i != o.m_i; }
+    private:
+        const ScanResultStore* m_s;
+        int m_i;
+    };
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const   { return const_iterator(this, size()); }
+
+    // ── Building ──
+    void reserve(int n);
+    void clear();
+    // Returns the index to pass to append() for hits inside this region.
+    int  internRegion(const QString& moduleName, uint64_t base);
+    void append(uint64_t address, const char* value, int len, int region = -1, int score = 0);
+    void append(const ScanResult& r);
+    // Append rows [first, first + n) of another store, re-interning its
+    // regions into this one.
+    void append(const ScanResultStore& other, int first, int n);
+
+    // ── In-place edits ──
+    void setAddress(int i, uint64_t address) { d->addrs[i] = address; }
+    void setValue(int i, const char* data, int len);
+    void setValue(int i, const QByteArray& v) { setValue(i, v.constData(), v.size()); }
+    // Same value on every row (exact-value first scans cache the pattern).
+    void fillValues(const QByteArray& v);
+    void clearPrevious();
+    // Restride the value arena. Values are clipped to the new width; the
+    // previous-value column is dropped.
+    void setValueWidth(int width);
+    // Keep rows whose keep[i] is non-zero, in order.
+    void compact(const char* keep);
+    // Stable, best score first (matrix candidates).
+    void sortByScore();
+
+    QVector<ScanResult> toVector() const;
+    static ScanResultStore fromVector(const QVector<ScanResult>& v);
+
+    // Bytes held by the columns (not counting the region table).
+    size_t columnBytes() const;
+
+private:
+    friend class ScanEngine;
+
+    struct Region {
+        QString  name;
+        uint64_t base = 0;
+        bool     literal = false;  // name is the whole label (fromVector)
+    };
+    struct RegionRun {
+        int first;   // first row of the run
+        int region;  // -1 = no module
+    };
+    struct Data : QSharedData {
+        int width = 0;
+        std::vector<uint64_t>  addrs;
+        std::vector<char>      values;    // width bytes per row
+        std::vector<uint16_t>  lens;      // empty: every value is `width` bytes
+        std::vector<char>      prev;      // empty: no previous values yet
+        std::vector<uint16_t>  prevLens;  // sized with prev; 0 = no previous
+        std::vector<int>       scores;    // empty: unscored scan
+        std::vector<RegionRun> runs;      // ascending `first`
+        QVector<Region>        regions;
+        QHash<QString, int>    regionIndex;
+        std::shared_ptr<ScanSnapshot> snapshot;
+    };
+
+    int  regionOf(int i) const;
+    int  internRegion(const Region& r);
+    void appendRow(uint64_t address, const char* value, int len, int region,
+                   int score, const char* prev, int prevLen);
+    void ensureLens();
+    void ensurePrevious();
+
+    QSharedDataPointer<Data> d;
+};
+
 // Statistics emitted from a scan — surfaced in the status line.
 struct ScanStats {
     int      regionsScanned = 0;
     uint64_t bytesScanned   = 0;
-    uint64_t bytesFailed    = 0;   // sum of unreadable chunk sizes
+    uint64_t bytesFailed    = 0;   // bytes on pages that stayed unreadable
     int      msElapsed      = 0;
 };
 
@@ -119,6 +357,8 @@ int valueSizeForType(ValueType type);
 
 // ── Scan engine ──
 
+struct RescanFilter;   // per-value rescan predicate (scanner.cpp)
+
 class ScanEngine : public QObject {
     Q_OBJECT
 public:
@@ -126,22 +366,43 @@ public:
 
     void start(std::shared_ptr<Provider> provider, const ScanRequest& req);
     void startRescan(std::shared_ptr<Provider> provider,
-                     QVector<ScanResult> results, int readSize,
+                     ScanResultStore results, int readSize,
+                     ScanCondition condition = ScanCondition::ExactValue,
+                     ValueType valueType = ValueType::Int32,
+                     const QByteArray& filterPattern = {},
+                     const QByteArray& filterMask = {},
+                     const QByteArray& filterPattern2 = {});
+    void startRescan(std::shared_ptr<Provider> provider,
+                     const QVector<ScanResult>& results, int readSize,
                      ScanCondition condition = ScanCondition::ExactValue,
                      ValueType valueType = ValueType::Int32,
                      const QByteArray& filterPattern = {},
                      const QByteArray& filterMask = {},
                      const QByteArray& filterPattern2 = {});
+    // Pointer-path scan (pointerscan.h) for req.target, on this engine's
+    // worker pool and region cache. Shares progress(), error() and abort()
+    // with value scans; only one of either runs at a time.
+    void startPointerScan(std::shared_ptr<Provider> provider, const PointerScanRequest& req);
     void abort();
     bool isRunning() const;
 
 signals:
     void progress(int percent);
+    // A streamed batch of a running first scan (ScanRequest::streamBatchRows).
+    // Batches arrive in order and before resultsReady; the rows they hold
+    // are the leading rows of the final result set.
+    void partialResults(rcx::ScanResultStore batch);
+    void resultsReady(rcx::ScanResultStore results);
+    void rescanResultsReady(rcx::ScanResultStore results);
+    // Row-vector forms of the two signals above. Only emitted when something
+    // is connected — materializing a large store as ScanResults is exactly
+    // the cost the store exists to avoid.
     void finished(QVector<ScanResult> results);
     void rescanFinished(QVector<ScanResult> results);
     void error(QString message);
     void scanStats(rcx::ScanStats stats);
     void regionsResolved(int count, qulonglong totalBytes);
+    void pointerScanFinished(rcx::PointerScanResult result);
 
 public:
     // Test/inspection helper: well-known system DLLs that "Skip system DLLs"
@@ -159,16 +420,37 @@ public:
     void invalidateRegionCache();
 
 private:
-    QVector<ScanResult> runScan(std::shared_ptr<Provider> prov, const ScanRequest& req);
-    QVector<ScanResult> runRescan(std::shared_ptr<Provider> prov,
-                                   QVector<ScanResult> results, int readSize,
-                                   ScanCondition condition, ValueType valueType,
-                                   const QByteArray& filterPattern,
-                                   const QByteArray& filterMask,
-                                   const QByteArray& filterPattern2 = {});
+    ScanResultStore runScan(std::shared_ptr<Provider> prov, const ScanRequest& req);
+    ScanResultStore runRescan(std::shared_ptr<Provider> prov,
+                               ScanResultStore results, int readSize,
+                               ScanCondition condition, ValueType valueType,
+                               const QByteArray& filterPattern,
+                               const QByteArray& filterMask,
+                               const QByteArray& filterPattern2 = {});
+    ScanResultStore runSnapshotRescan(std::shared_ptr<Provider> prov,
+                                      ScanResultStore results,
+                                      const RescanFilter& filter);
+    void emitFinished(const ScanResultStore& results, bool rescan);
+    Q_INVOKABLE void drainStream();
 
     std::atomic<bool> m_abort{false};
-    QFutureWatcher<QVector<ScanResult>>* m_watcher = nullptr;
+    QFutureWatcher<ScanResultStore>* m_watcher = nullptr;
+    QFutureWatcher<PointerScanResult>* m_pointerWatcher = nullptr;
+
+    // Streamed batches of the running scan. Workers push under the prefix
+    // mutex (one producer at a time) and the GUI thread pops in
+    // drainStream(); m_drainQueued coalesces the wake-ups so a slow UI sees
+    // one queued call, not one per batch.
+    std::unique_ptr<SpscRing<ScanResultStore>> m_stream;
+    std::atomic<bool> m_drainQueued{false};
+
+    // Helper threads for runScan's chunk workers. Private so the scan
+    // thread (itself a global-pool task) never waits on work queued
+    // behind it in the same pool.
+    QThreadPool m_pool;
+    // Prefetch reads issued by runRescan workers. Reads never wait on
+    // anything, so a worker blocking on its prefetch can't deadlock here.
+    QThreadPool m_ioPool;
 
     // Region cache — keyed by raw provider pointer + a generation counter the
     // owning controller bumps on attach. enumerateRegions() is not free on
@@ -180,4 +462,6 @@ private:
 } // namespace rcx
 
 Q_DECLARE_METATYPE(QVector<rcx::ScanResult>)
+Q_DECLARE_METATYPE(rcx::ScanResultStore)
 Q_DECLARE_METATYPE(rcx::ScanStats)
+Q_DECLARE_METATYPE(rcx::PointerScanResult)
@@ -1,7 +1,11 @@
 #include "scannerpanel.h"
 #include "addressparser.h"
 #include "themes/thememanager.h"
+#include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <numeric>
+#include <type_traits>
 #include <QElapsedTimer>
 #include <QDebug>
 #include <QVBoxLayout>
@@ -32,17 +36,26 @@
 
 namespace rcx {
 
-// Forward declaration: defined later — used by lambdas in the constructor
-// that translate sortable-table rows back to m_results indices.
-static int rowToResultIdx(QTableWidget* tbl, int row);
-
-// Forward declaration: numeric delta helper used by populateTable for the
+// Forward declaration: numeric delta helper used by ScanResultModel for the
 // Previous → Δ column. Defined lower in the file alongside formatValue.
 struct DeltaInfo { QString text; int direction = 0; bool ok = false; };
 static DeltaInfo computeDelta(ValueType vt,
                               const QByteArray& prev,
                               const QByteArray& cur);
 
+// Unknown-value scans over at least this many slots are held in a disk
+// snapshot (ScanSnapshot) until a Next Scan narrows them below it.
+static constexpr int kSnapshotThreshold = 1000000;
+
+// First scans stream their leading hits into the table as they're found:
+// a batch every kStreamBatchRows hits or kStreamIntervalMs, whichever
+// comes first. The engine holds at most kStreamQueueDepth batches for us
+// and stalls its workers beyond that, so a busy UI can't make it buffer
+// without bound.
+static constexpr int kStreamBatchRows   = 4096;
+static constexpr int kStreamIntervalMs  = 100;
+static constexpr int kStreamQueueDepth  = 8;
+
 // ── FilterChip ──
 // Drop-in replacement for QCheckBox that paints in the same flat-pip style
 // as the type-chooser CategoryChip. Derives from QCheckBox so the panel's
@@ -102,12 +115,12 @@ protected:
 };
 
 // ── EmptyResultsTable ──
-// QTableWidget with a centered placeholder painted when row count is 0.
+// QTableView with a centered placeholder painted when row count is 0.
 // Clearer than a blank gray rectangle which the user might misread as
 // "the panel is broken".
-class EmptyResultsTable : public QTableWidget {
+class EmptyResultsTable : public QTableView {
 public:
-    using QTableWidget::QTableWidget;
+    using QTableView::QTableView;
     QString placeholder = QStringLiteral(
         "Set scan criteria above and click First Scan to begin.");
     // [iter 48] Optional secondary line that names the keyboard shortcut.
@@ -116,8 +129,8 @@ public:
         "Tip — press Enter inside the value field, or Ctrl+Return anywhere.");
 protected:
     void paintEvent(QPaintEvent* e) override {
-        QTableWidget::paintEvent(e);
-        if (rowCount() != 0) return;
+        QTableView::paintEvent(e);
+        if (model() && model()->rowCount() != 0) return;
         // Shared two-line placeholder (primary CTA + dimmer hint), clipped to
         // the viewport with word-wrap. See widgets/empty_overlay.h.
         paintEmptyOverlay(viewport(), font(), placeholder, hint);
@@ -243,6 +256,370 @@ public:
     }
 };
 
+// ── ScanResultModel ──
+
+// Stable sort of `rows` (result indices) by a per-result key. Keys that fail
+// to decode (short value, NaN, no module) sort after every valid key in both
+// directions, so blanks stay at the bottom whichever way the arrow points.
+template <typename K, typename KeyFn>
+static void sortRowsBy(std::vector<int>& rows, Qt::SortOrder order, KeyFn keyOf) {
+    struct Entry { K key; int result; bool ok; };
+    std::vector<Entry> e(rows.size());
+    for (size_t i = 0; i < rows.size(); i++) {
+        e[i].result = rows[i];
+        e[i].ok = keyOf(rows[i], e[i].key);
+    }
+    const bool desc = (order == Qt::DescendingOrder);
+    std::stable_sort(e.begin(), e.end(), [desc](const Entry& a, const Entry& b) {
+        if (a.ok != b.ok) return a.ok;
+        if (!a.ok) return false;
+        return desc ? b.key < a.key : a.key < b.key;
+    });
+    for (size_t i = 0; i < rows.size(); i++) rows[i] = e[i].result;
+}
+
+template <typename T, typename BytesFn>
+static void sortRowsTyped(std::vector<int>& rows, Qt::SortOrder order, BytesFn bytesOf) {
+    sortRowsBy<T>(rows, order, [&](int i, T& k) {
+        const char* p = nullptr;
+        int n = 0;
+        bytesOf(i, p, n);
+        if (n < (int)sizeof(T)) return false;
+        memcpy(&k, p, sizeof(T));
+        if constexpr (std::is_floating_point_v<T>) return !std::isnan(k);
+        return true;
+    });
+}
+
+// Raw-byte key for signature results — lexicographic, shorter prefix first.
+struct ByteKey {
+    const char* p = nullptr;
+    int n = 0;
+    bool operator<(const ByteKey& o) const {
+        const int c = memcmp(p, o.p, (size_t)qMin(n, o.n));
+        return c ? c < 0 : n < o.n;
+    }
+};
+
+ScanResultModel::ScanResultModel(const ScanResultStore* store, Formatter format,
+                                 QObject* parent)
+    : QAbstractTableModel(parent)
+    , m_store(store)
+    , m_format(std::move(format))
+{
+}
+
+void ScanResultModel::resetRows(ValueType valueType, bool numeric,
+                                bool showPrevious, bool showModule) {
+    beginResetModel();
+    m_valueType    = valueType;
+    m_numeric      = numeric;
+    m_showPrevious = showPrevious;
+    m_showModule   = showModule;
+    m_rows         = {};
+    m_rowOf        = {};
+    m_natural      = true;
+    m_naturalRows  = m_store->size();
+    m_filter.clear();
+    m_sortColumn   = -1;
+    m_sortOrder    = Qt::AscendingOrder;
+    endResetModel();
+}
+
+void ScanResultModel::refreshValues() {
+    const int rows = rowCount();
+    if (rows > 0)
+        emit dataChanged(index(0, 1), index(rows - 1, columnCount() - 1));
+}
+
+void ScanResultModel::refreshResult(int resultIndex) {
+    const int row = rowOfResult(resultIndex);
+    if (row >= 0 && row < rowCount())
+        emit dataChanged(index(row, 0), index(row, columnCount() - 1));
+}
+
+void ScanResultModel::appendRows(int count) {
+    const int n = m_store->size();
+    const int first = n - count;
+    if (count <= 0 || first < 0) return;
+    if (m_natural) {
+        if (n <= m_naturalRows) return;
+        beginInsertRows({}, m_naturalRows, n - 1);
+        m_naturalRows = n;
+        endInsertRows();
+        return;
+    }
+    std::vector<int> added;
+    for (int r = first; r < n; r++)
+        if (matchesFilter(r)) added.push_back(r);
+    if (added.empty()) return;
+    const int at = (int)m_rows.size();
+    beginInsertRows({}, at, at + (int)added.size() - 1);
+    m_rows.insert(m_rows.end(), added.begin(), added.end());
+    m_rowOf = {};
+    endInsertRows();
+}
+
+bool ScanResultModel::matchesFilter(int result) const {
+    if (m_filter.isEmpty()) return true;
+    const int cols = columnCount();
+    for (int c = 0; c < cols; c++)
+        if (cellText(result, c).contains(m_filter, Qt::CaseInsensitive))
+            return true;
+    return false;
+}
+
+int ScanResultModel::setFilter(const QString& text) {
+    beginResetModel();
+    m_filter = text;
+    m_rowOf  = {};
+    if (text.isEmpty() && m_sortColumn < 0) {
+        m_rows        = {};
+        m_natural     = true;
+        m_naturalRows = m_store->size();
+    } else {
+        const int n = m_store->size();
+        std::vector<int> rows;
+        if (text.isEmpty()) rows.reserve(n);
+        for (int r = 0; r < n; r++)
+            if (matchesFilter(r)) rows.push_back(r);
+        if (m_sortColumn >= 0) orderRows(rows);
+        m_rows    = std::move(rows);
+        m_natural = false;
+    }
+    endResetModel();
+    return rowCount();
+}
+
+int ScanResultModel::resultIndex(int row) const {
+    if (row < 0 || row >= rowCount()) return -1;
+    return m_natural ? row : m_rows[row];
+}
+
+int ScanResultModel::rowOfResult(int result) const {
+    if (result < 0) return -1;
+    if (m_natural) return result < m_naturalRows ? result : -1;
+    if (m_rowOf.empty()) {
+        m_rowOf.assign(m_store->size(), -1);
+        for (size_t r = 0; r < m_rows.size(); r++) m_rowOf[m_rows[r]] = (int)r;
+    }
+    return result < (int)m_rowOf.size() ? m_rowOf[result] : -1;
+}
+
+void ScanResultModel::setHeaderFont(const QFont& font) {
+    m_headerFont = font;
+    emit headerDataChanged(Qt::Horizontal, 0, columnCount() - 1);
+}
+
+int ScanResultModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid()) return 0;
+    return m_natural ? m_naturalRows : (int)m_rows.size();
+}
+
+int ScanResultModel::columnCount(const QModelIndex& parent) const {
+    if (parent.isValid()) return 0;
+    return 2 + (m_showPrevious ? 1 : 0) + (m_showModule ? 1 : 0);
+}
+
+int ScanResultModel::deltaDirection(int result) const {
+    if (!m_showPrevious || m_store->previousLength(result) == 0) return 0;
+    return computeDelta(m_valueType, m_store->previousValue(result),
+                        m_store->value(result)).direction;
+}
+
+QString ScanResultModel::cellText(int result, int column) const {
+    if (column == 0) {
+        // WinDbg backtick format: 00000000`00000000.
+        QString hex = QStringLiteral("%1").arg(m_store->address(result), 16, 16,
+                                               QLatin1Char('0')).toUpper();
+        hex.insert(8, '`');
+        return hex;
+    }
+    if (column == 1)
+        return m_format(m_store->value(result));
+    if (column == previousColumn()) {
+        // Just the prior value, de-emphasized, with a direction glyph so the
+        // up/down move reads without color (color-blind safe). This cell is
+        // read-only, so the glyph can't corrupt an edit the way it would in
+        // the Value cell. e.g. "↑ 46" = value rose from 46.
+        const QByteArray prev = m_store->previousValue(result);
+        if (prev.isEmpty()) return QString();
+        QString text = m_format(prev);
+        const int dir = deltaDirection(result);
+        if (dir > 0)      text = QStringLiteral("↑ ") + text;
+        else if (dir < 0) text = QStringLiteral("↓ ") + text;
+        return text;
+    }
+    if (column == moduleColumn())
+        return m_store->regionModule(result);
+    return QString();
+}
+
+QVariant ScanResultModel::data(const QModelIndex& index, int role) const {
+    const int result = index.isValid() ? resultIndex(index.row()) : -1;
+    if (result < 0) return {};
+    const int col = index.column();
+    switch (role) {
+    case Qt::DisplayRole:
+    case Qt::EditRole:
+        return cellText(result, col);
+    case Qt::UserRole:
+        return result;
+    case Qt::TextAlignmentRole:
+        // Numeric values read far better right-aligned — digits line up by
+        // magnitude. Signature/hex byte strings stay left-aligned.
+        if (col == 1 || col == previousColumn())
+            return int(m_numeric ? (Qt::AlignRight | Qt::AlignVCenter)
+                                 : (Qt::AlignLeft  | Qt::AlignVCenter));
+        return {};
+    case Qt::ForegroundRole: {
+        // Value = the CURRENT value, tinted when it moved vs the previous
+        // scan; Previous is reference only and stays dim.
+        const auto& t = ThemeManager::instance().current();
+        if (col == previousColumn()) return QBrush(t.textDim);
+        if (col == 1) {
+            const int dir = deltaDirection(result);
+            if (dir > 0) return QBrush(t.indDataChanged);   // increase
+            if (dir < 0) return QBrush(t.markerPtr);        // decrease
+        }
+        return {};
+    }
+    default:
+        return {};
+    }
+}
+
+bool ScanResultModel::setData(const QModelIndex& index, const QVariant& value, int role) {
+    if (role != Qt::EditRole || !(flags(index) & Qt::ItemIsEditable)) return false;
+    const int result = resultIndex(index.row());
+    if (result < 0) return false;
+    emit cellEdited(result, index.column(), value.toString());
+    return true;
+}
+
+QVariant ScanResultModel::headerData(int section, Qt::Orientation orientation,
+                                     int role) const {
+    if (orientation != Qt::Horizontal) return {};
+    if (role == Qt::FontRole) return m_headerFont;
+    // Header tooltips advertise the click-to-sort affordance — sortable
+    // headers are easy to miss when they look like read-only labels.
+    const bool tip = (role == Qt::ToolTipRole);
+    if (role != Qt::DisplayRole && !tip) return {};
+    if (section == 0)
+        return tip ? QStringLiteral("Click to sort by address. Shift+click for reverse order.")
+                   : QStringLiteral("Address");
+    if (section == 1)
+        return tip ? QStringLiteral("Click to sort by current value. Double-click a cell to edit it.")
+                   : QStringLiteral("Value");
+    if (section == previousColumn())
+        return tip ? QStringLiteral("The value at the previous scan (for reference, de-emphasized). "
+                                    "The current Value to the left is tinted and arrowed ↑/↓ to "
+                                    "show which way it moved.")
+                   : QStringLiteral("Previous");
+    if (section == moduleColumn())
+        return tip ? QStringLiteral("Module (DLL/exe) the address falls inside, when known.")
+                   : QStringLiteral("Module");
+    return {};
+}
+
+Qt::ItemFlags ScanResultModel::flags(const QModelIndex& index) const {
+    if (!index.isValid()) return Qt::NoItemFlags;
+    Qt::ItemFlags f = Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+    if (index.column() <= 1) f |= Qt::ItemIsEditable;   // address expression / value write
+    return f;
+}
+
+void ScanResultModel::sort(int column, Qt::SortOrder order) {
+    if (column >= columnCount()) column = -1;
+    if (column < 0 && m_sortColumn < 0) return;   // already in scan order
+
+    emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+    const QModelIndexList before = persistentIndexList();
+    std::vector<int> heldResults;
+    heldResults.reserve(before.size());
+    for (const QModelIndex& i : before) heldResults.push_back(resultIndex(i.row()));
+
+    m_sortColumn = column;
+    m_sortOrder  = order;
+    m_rowOf      = {};
+    if (column < 0 && m_filter.isEmpty()) {
+        if (!m_natural) m_naturalRows = (int)m_rows.size();
+        m_rows    = {};
+        m_natural = true;
+    } else {
+        if (m_natural) {
+            m_rows.resize(m_naturalRows);
+            std::iota(m_rows.begin(), m_rows.end(), 0);
+            m_natural = false;
+        }
+        orderRows(m_rows);
+    }
+
+    if (!before.isEmpty()) {
+        QModelIndexList after;
+        after.reserve(before.size());
+        for (qsizetype k = 0; k < before.size(); k++) {
+            const int row = rowOfResult(heldResults[k]);
+            after.append(row < 0 ? QModelIndex() : this->index(row, before[k].column()));
+        }
+        changePersistentIndexList(before, after);
+    }
+    emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
+
+void ScanResultModel::orderRows(std::vector<int>& rows) const {
+    const ScanResultStore& s = *m_store;
+    const int col = m_sortColumn;
+    if (col < 0) {
+        std::sort(rows.begin(), rows.end());
+        return;
+    }
+    if (col == 0) {
+        sortRowsBy<uint64_t>(rows, m_sortOrder, [&s](int i, uint64_t& k) {
+            k = s.address(i);
+            return true;
+        });
+        return;
+    }
+    if (col == moduleColumn()) {
+        sortRowsBy<QString>(rows, m_sortOrder, [&s](int i, QString& k) {
+            k = s.regionModule(i);
+            return !k.isEmpty();
+        });
+        return;
+    }
+    const bool prev = (col == previousColumn());
+    auto bytesOf = [&s, prev](int i, const char*& p, int& n) {
+        n = prev ? s.previousLength(i) : s.valueLength(i);
+        p = n <= 0 ? nullptr : (prev ? s.previousData(i) : s.valueData(i));
+    };
+    if (!m_numeric) {
+        sortRowsBy<ByteKey>(rows, m_sortOrder, [&](int i, ByteKey& k) {
+            bytesOf(i, k.p, k.n);
+            return k.n > 0;
+        });
+        return;
+    }
+    switch (m_valueType) {
+    case ValueType::Int8:   sortRowsTyped<int8_t>(rows, m_sortOrder, bytesOf);   break;
+    case ValueType::UInt8:  sortRowsTyped<uint8_t>(rows, m_sortOrder, bytesOf);  break;
+    case ValueType::Int16:  sortRowsTyped<int16_t>(rows, m_sortOrder, bytesOf);  break;
+    case ValueType::UInt16: sortRowsTyped<uint16_t>(rows, m_sortOrder, bytesOf); break;
+    case ValueType::Int32:  sortRowsTyped<int32_t>(rows, m_sortOrder, bytesOf);  break;
+    case ValueType::UInt32: sortRowsTyped<uint32_t>(rows, m_sortOrder, bytesOf); break;
+    case ValueType::Int64:  sortRowsTyped<int64_t>(rows, m_sortOrder, bytesOf);  break;
+    case ValueType::UInt64: sortRowsTyped<uint64_t>(rows, m_sortOrder, bytesOf); break;
+    case ValueType::Float:  sortRowsTyped<float>(rows, m_sortOrder, bytesOf);    break;
+    case ValueType::Double: sortRowsTyped<double>(rows, m_sortOrder, bytesOf);   break;
+    default:
+        sortRowsBy<ByteKey>(rows, m_sortOrder, [&](int i, ByteKey& k) {
+            bytesOf(i, k.p, k.n);
+            return k.n > 0;
+        });
+        break;
+    }
+}
+
 ScannerPanel::ScannerPanel(QWidget* parent)
     : QWidget(parent)
     , m_engine(new ScanEngine(this))
@@ -691,8 +1068,13 @@ ScannerPanel::ScannerPanel(QWidget* parent)
     resultsContent->addWidget(m_truncBanner);
 
     // ── Results table ──
-    m_resultTable = new QTableWidget(this);
-    m_resultTable->setColumnCount(2);
+    // The view reads straight from m_results through ScanResultModel; no
+    // per-cell items are built, so a scan of any size populates instantly.
+    m_resultTable = new QTableView(this);
+    m_resultModel = new ScanResultModel(&m_results,
+        [this](const QByteArray& bytes) { return formatValue(bytes); }, this);
+    m_resultModel->setHeaderFont(m_resultTable->font());
+    m_resultTable->setModel(m_resultModel);
     m_resultTable->horizontalHeader()->hide();
     m_resultTable->verticalHeader()->hide();
     m_resultTable->horizontalHeader()->setSectionResizeMode(0, QHeaderView::Interactive);
@@ -705,6 +1087,10 @@ ScannerPanel::ScannerPanel(QWidget* parent)
     // which column they're sorted by — invisible-by-default sort is one of
     // the most common "is this even sortable?" usability traps.
     m_resultTable->horizontalHeader()->setSortIndicatorShown(true);
+    // Header clicks sort through ScanResultModel::sort (a row permutation).
+    // Section -1 = no sort column, i.e. the order the scan produced.
+    m_resultTable->setSortingEnabled(true);
+    m_resultTable->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
     m_resultTable->setSelectionBehavior(QAbstractItemView::SelectRows);
     // Multi-select so users can batch Delete / Copy / Add-as-nodes against
     // groups of hits. Single-select mode forced one-row-at-a-time everything.
@@ -894,9 +1280,9 @@ ScannerPanel::ScannerPanel(QWidget* parent)
             this, &ScannerPanel::onGoToAddress);
     connect(m_copyBtn, &QPushButton::clicked,
             this, &ScannerPanel::onCopyAddress);
-    connect(m_resultTable, &QTableWidget::cellDoubleClicked,
+    connect(m_resultTable, &QTableView::doubleClicked,
             this, &ScannerPanel::onResultDoubleClicked);
-    connect(m_resultTable, &QTableWidget::cellChanged,
+    connect(m_resultModel, &ScanResultModel::cellEdited,
             this, &ScannerPanel::onCellEdited);
 
     // ── Keyboard shortcuts (panel-scoped) ──
@@ -955,21 +1341,24 @@ ScannerPanel::ScannerPanel(QWidget* parent)
     QWidget::setTabOrder(m_undoBtn, m_newScanBtn);
     QWidget::setTabOrder(m_newScanBtn, m_resultTable);
     QWidget::setTabOrder(m_resultTable, m_resultFilter);
-    connect(m_resultTable, &QTableWidget::itemSelectionChanged, this, [this]() {
-        bool hasSel = !m_resultTable->selectedItems().isEmpty();
+    auto syncSelectionButtons = [this]() {
+        bool hasSel = m_resultTable->selectionModel()->hasSelection();
         // [iter 32] Hide Go to / Copy entirely when no selection — empty
         // disabled buttons looked like dead UI; hidden makes the row
         // visually empty until there's something to act on.
         m_gotoBtn->setVisible(hasSel);
         m_copyBtn->setVisible(hasSel);
-    });
+    };
+    connect(m_resultTable->selectionModel(), &QItemSelectionModel::selectionChanged,
+            this, syncSelectionButtons);
+    // A model reset drops the selection without a selectionChanged signal.
+    connect(m_resultModel, &QAbstractItemModel::modelReset, this, syncSelectionButtons);
     // [iter 33] Initial state: no selection ⇒ buttons hidden.
     m_gotoBtn->setVisible(false);
     m_copyBtn->setVisible(false);
 
     connect(m_resultTable, &QWidget::customContextMenuRequested, this, [this](const QPoint& pos) {
-        int row = m_resultTable->rowAt(pos.y());
-        int idxResolved = rowToResultIdx(m_resultTable, row);
+        int idxResolved = m_resultModel->resultIndex(m_resultTable->indexAt(pos).row());
         if (idxResolved < 0 || idxResolved >= m_results.size()) return;
         const int row_actual_index = idxResolved;
         QMenu menu;
@@ -987,14 +1376,14 @@ ScannerPanel::ScannerPanel(QWidget* parent)
         auto* chosen = menu.exec(m_resultTable->viewport()->mapToGlobal(pos));
         if (chosen == copyAddr) {
             QString addr = QStringLiteral("0x%1")
-                .arg(m_results[row_actual_index].address, 0, 16, QLatin1Char('0')).toUpper();
+                .arg(m_results.address(row_actual_index), 0, 16, QLatin1Char('0')).toUpper();
             QApplication::clipboard()->setText(addr);
             m_statusLabel->setText(QStringLiteral("Copied: %1").arg(addr));
         } else if (chosen == copyVal) {
-            QApplication::clipboard()->setText(formatValue(m_results[row_actual_index].scanValue));
+            QApplication::clipboard()->setText(formatValue(m_results.value(row_actual_index)));
             m_statusLabel->setText(QStringLiteral("Copied value"));
         } else if (chosen == goTo) {
-            emit goToAddress(m_results[row_actual_index].address);
+            emit goToAddress(m_results.address(row_actual_index));
         } else if (chosen == changeAll) {
             QString hint = m_lastScanMode == 0
                 ? QStringLiteral("hex bytes (e.g. 90 90 90)")
@@ -1051,13 +1440,14 @@ ScannerPanel::ScannerPanel(QWidget* parent)
 
             int wrote = 0;
             int readSize = (m_lastScanMode == 1) ? valueSize() : 16;
-            for (auto& r : m_results) {
-                if (prov->writeBytes(r.address, bytes)) {
-                    r.scanValue = prov->readBytes(r.address, readSize);
+            for (int i = 0; i < m_results.size(); i++) {
+                const uint64_t addr = m_results.address(i);
+                if (prov->writeBytes(addr, bytes)) {
+                    m_results.setValue(i, prov->readBytes(addr, readSize));
                     ++wrote;
                 }
             }
-            populateTable(m_resultTable->columnCount() > 2);
+            m_resultModel->refreshValues();
             m_statusLabel->setText(QStringLiteral("Wrote to %1/%2 addresses")
                 .arg(wrote).arg(m_results.size()));
         }
@@ -1066,9 +1456,11 @@ ScannerPanel::ScannerPanel(QWidget* parent)
     connect(m_engine, &ScanEngine::progress, this, [this](int pct) {
         m_progressBar->setValue(pct);
     });
-    connect(m_engine, &ScanEngine::finished,
+    connect(m_engine, &ScanEngine::partialResults,
+            this, &ScannerPanel::onScanPartial);
+    connect(m_engine, &ScanEngine::resultsReady,
             this, &ScannerPanel::onScanFinished);
-    connect(m_engine, &ScanEngine::rescanFinished,
+    connect(m_engine, &ScanEngine::rescanResultsReady,
             this, &ScannerPanel::onRescanFinished);
     connect(m_engine, &ScanEngine::error, this, [this](const QString& msg) {
         // [iter 56] Prefix engine errors with a unicode warning glyph so
@@ -1216,6 +1608,7 @@ void ScannerPanel::setEditorFont(const QFont& font) {
     // Header row uses its own QFont — propagate so column titles match the
     // monospaced editor font instead of the system Sans default.
     m_resultTable->horizontalHeader()->setFont(font);
+    m_resultModel->setHeaderFont(font);
     // Re-render the breadcrumb so its embedded font-family CSS picks up
     // the new font (QLabel's RichText path ignores QFont — see
     // updateStageLabel for the fontCss embedding).
@@ -1336,6 +1729,13 @@ void ScannerPanel::onScanClicked() {
     }
     m_lastPattern = req.pattern;
 
+    req.streamBatchRows     = kStreamBatchRows;
+    req.streamIntervalMs    = kStreamIntervalMs;
+    req.streamQueueDepth    = kStreamQueueDepth;
+    req.streamBlockWhenFull = true;
+    m_streamingScan = true;
+    m_streamedAny   = false;
+
     // First-scan path always resets the workflow stage to 1.
     m_scanGeneration = 1;
     m_lastResultCount = 0;
@@ -1395,8 +1795,10 @@ ScanRequest ScannerPanel::buildRequest() {
         req.valueType = vt;
 
         if (cond == ScanCondition::UnknownValue) {
-            // No pattern needed — capture all aligned addresses
+            // No pattern needed — capture all aligned addresses; past
+            // kSnapshotThreshold the engine keeps a disk snapshot instead.
             req.maxResults = 10000000;
+            req.snapshotThreshold = kSnapshotThreshold;
         } else if (cond == ScanCondition::BiggerThan
                 || cond == ScanCondition::SmallerThan
                 || cond == ScanCondition::Between) {
@@ -1450,10 +1852,10 @@ ScanRequest ScannerPanel::buildRequest() {
     return req;
 }
 
-QVector<ScanResult> ScannerPanel::runValueScanAndWait(ValueType valueType, const QString& value,
-                                                      bool filterExecutable, bool filterWritable,
-                                                      const QVector<AddressRange>& constrainRegions) {
-    QVector<ScanResult> results;
+ScanResultStore ScannerPanel::runValueScanAndWait(ValueType valueType, const QString& value,
+                                                  bool filterExecutable, bool filterWritable,
+                                                  const QVector<AddressRange>& constrainRegions) {
+    ScanResultStore results;
     QString err;
     ScanRequest req;
     if (!serializeValue(valueType, value, req.pattern, req.mask, &err)) {
@@ -1483,7 +1885,7 @@ QVector<ScanResult> ScannerPanel::runValueScanAndWait(ValueType valueType, const
     m_statusLabel->setText(QStringLiteral("Scanning..."));
 
     QEventLoop loop;
-    connect(m_engine, &ScanEngine::finished, this, [&results, &loop](const QVector<ScanResult>& r) {
+    connect(m_engine, &ScanEngine::resultsReady, this, [&results, &loop](const ScanResultStore& r) {
         results = r;
         loop.quit();
     }, Qt::SingleShotConnection);
@@ -1493,18 +1895,18 @@ QVector<ScanResult> ScannerPanel::runValueScanAndWait(ValueType valueType, const
     return results;
 }
 
-QVector<ScanResult> ScannerPanel::runPatternScanAndWait(const QString& pattern,
-                                                        bool filterExecutable, bool filterWritable,
-                                                        const QVector<AddressRange>& constrainRegions) {
+ScanResultStore ScannerPanel::runPatternScanAndWait(const QString& pattern,
+                                                    bool filterExecutable, bool filterWritable,
+                                                    const QVector<AddressRange>& constrainRegions) {
     auto provider = m_providerGetter ? m_providerGetter() : nullptr;
     return runPatternScanAndWait(provider, pattern, filterExecutable, filterWritable, constrainRegions);
 }
 
-QVector<ScanResult> ScannerPanel::runPatternScanAndWait(std::shared_ptr<Provider> provider,
-                                                        const QString& pattern,
-                                                        bool filterExecutable, bool filterWritable,
-                                                        const QVector<AddressRange>& constrainRegions) {
-    QVector<ScanResult> results;
+ScanResultStore ScannerPanel::runPatternScanAndWait(std::shared_ptr<Provider> provider,
+                                                    const QString& pattern,
+                                                    bool filterExecutable, bool filterWritable,
+                                                    const QVector<AddressRange>& constrainRegions) {
+    ScanResultStore results;
     QString err;
     ScanRequest req;
     if (!parseSignature(pattern, req.pattern, req.mask, &err)) {
@@ -1532,7 +1934,7 @@ QVector<ScanResult> ScannerPanel::runPatternScanAndWait(std::shared_ptr<Provider
     m_statusLabel->setText(QStringLiteral("Scanning..."));
 
     QEventLoop loop;
-    connect(m_engine, &ScanEngine::finished, this, [&results, &loop](const QVector<ScanResult>& r) {
+    connect(m_engine, &ScanEngine::resultsReady, this, [&results, &loop](const ScanResultStore& r) {
         results = r;
         loop.quit();
     }, Qt::SingleShotConnection);
@@ -1542,13 +1944,13 @@ QVector<ScanResult> ScannerPanel::runPatternScanAndWait(std::shared_ptr<Provider
     return results;
 }
 
-QVector<ScanResult> ScannerPanel::runValueScanAndWait(ValueType valueType, ScanCondition condition,
-                                                      const QString& value, const QString& value2,
-                                                      bool filterExecutable, bool filterWritable,
-                                                      bool skipSystemModules,
-                                                      const QVector<AddressRange>& constrainRegions,
-                                                      int timeoutMs) {
-    QVector<ScanResult> results;
+ScanResultStore ScannerPanel::runValueScanAndWait(ValueType valueType, ScanCondition condition,
+                                                  const QString& value, const QString& value2,
+                                                  bool filterExecutable, bool filterWritable,
+                                                  bool skipSystemModules,
+                                                  const QVector<AddressRange>& constrainRegions,
+                                                  int timeoutMs) {
+    ScanResultStore results;
     QString err;
     ScanRequest req;
     req.valueType = valueType;
@@ -1571,6 +1973,7 @@ QVector<ScanResult> ScannerPanel::runValueScanAndWait(ValueType valueType, ScanC
 
     if (req.condition == ScanCondition::UnknownValue) {
         req.maxResults = 10000000;   // capture all aligned addresses
+        req.snapshotThreshold = kSnapshotThreshold;
     } else if (req.condition == ScanCondition::BiggerThan ||
                req.condition == ScanCondition::SmallerThan ||
                req.condition == ScanCondition::Between) {
@@ -1618,7 +2021,7 @@ QVector<ScanResult> ScannerPanel::runValueScanAndWait(ValueType valueType, ScanC
 
     bool timedOut = false;
     QEventLoop loop;
-    connect(m_engine, &ScanEngine::finished, this, [&results, &loop](const QVector<ScanResult>& r) {
+    connect(m_engine, &ScanEngine::resultsReady, this, [&results, &loop](const ScanResultStore& r) {
         results = r;
         loop.quit();
     }, Qt::SingleShotConnection);
@@ -1639,9 +2042,65 @@ QVector<ScanResult> ScannerPanel::runValueScanAndWait(ValueType valueType, ScanC
     return results;
 }
 
-QVector<ScanResult> ScannerPanel::runRescanAndWait(ScanCondition condition, const QString& value,
-                                                   const QString& value2, const QString& delta,
-                                                   int timeoutMs) {
+PointerScanResult ScannerPanel::runPointerScanAndWait(std::shared_ptr<Provider> provider,
+                                                      const PointerScanRequest& req,
+                                                      int timeoutMs) {
+    PointerScanResult result;
+    if (!provider) {
+        m_statusLabel->setText(QStringLiteral("No provider (attach to a process or open a file first)"));
+        return result;
+    }
+    if (m_engine->isRunning()) {
+        m_statusLabel->setText(QStringLiteral("Scan already in progress"));
+        return result;
+    }
+
+    m_progressBar->setValue(0);
+    m_progressBar->show();
+    m_statusLabel->setText(QStringLiteral("Pointer scan for 0x%1...")
+        .arg(QString::number(req.target, 16).toUpper()));
+
+    bool failed = false;
+    bool timedOut = false;
+    QEventLoop loop;
+    auto done = connect(m_engine, &ScanEngine::pointerScanFinished, this,
+        [&result, &loop](const PointerScanResult& r) {
+            result = r;
+            loop.quit();
+        }, Qt::SingleShotConnection);
+    // The engine's error() handler has already put the message in the status line.
+    auto refused = connect(m_engine, &ScanEngine::error, this, [&failed, &loop]() {
+        failed = true;
+        loop.quit();
+    }, Qt::SingleShotConnection);
+    QTimer timer;
+    timer.setSingleShot(true);
+    connect(&timer, &QTimer::timeout, this, [this, &timedOut]() {
+        timedOut = true;
+        m_engine->abort();   // the search stops and pointerScanFinished brings the partial paths
+    });
+    timer.start(qMax(1000, timeoutMs));
+    m_engine->startPointerScan(provider, req);
+    if (!failed) loop.exec();
+    timer.stop();
+    disconnect(done);
+    disconnect(refused);
+    m_progressBar->hide();
+
+    if (failed) return {};
+    if (timedOut)
+        m_statusLabel->setText(QStringLiteral("Pointer scan timed out — %1 partial path(s)")
+            .arg(result.paths.size()));
+    else
+        m_statusLabel->setText(QStringLiteral("Pointer scan: %1 path(s)%2")
+            .arg(result.paths.size())
+            .arg(result.stats.aborted ? QStringLiteral(" (stopped)") : QString()));
+    return result;
+}
+
+ScanResultStore ScannerPanel::runRescanAndWait(ScanCondition condition, const QString& value,
+                                               const QString& value2, const QString& delta,
+                                               int timeoutMs) {
     if (m_results.isEmpty()) {
         m_statusLabel->setText(QStringLiteral("No current scan to narrow"));
         return m_results;
@@ -1663,7 +2122,7 @@ QVector<ScanResult> ScannerPanel::runRescanAndWait(ScanCondition condition, cons
     // bytes 48-59 — not just the first float. This is the find_matrix ->
     // rescan-changed "confirm the live matrix" flow.
     const bool matrixResults =
-        (m_lastScanMode == 0 && !m_results.isEmpty() && m_results[0].scanValue.size() == 64);
+        (m_lastScanMode == 0 && !m_results.isEmpty() && m_results.valueLength(0) == 64);
     if (matrixResults)
         readSize = 64;
     ScanCondition cond = condition;
@@ -1700,7 +2159,7 @@ QVector<ScanResult> ScannerPanel::runRescanAndWait(ScanCondition condition, cons
 
     if (!filterPattern.isEmpty())
         m_lastPattern = filterPattern;
-    m_preRescanCount  = m_results.size();
+    m_preRescanCount  = m_results.candidateCount();
     m_lastResultCount = m_preRescanCount;
     m_scanGeneration  = qMax(2, m_scanGeneration + 1);
     pushUndoSnapshot();   // so an over-narrowing rescan can be rolled back
@@ -1709,7 +2168,7 @@ QVector<ScanResult> ScannerPanel::runRescanAndWait(ScanCondition condition, cons
 
     bool timedOut = false;
     QEventLoop loop;
-    connect(m_engine, &ScanEngine::rescanFinished, this, [&loop](const QVector<ScanResult>&) {
+    connect(m_engine, &ScanEngine::rescanResultsReady, this, [&loop](const ScanResultStore&) {
         loop.quit();
     }, Qt::SingleShotConnection);
     QTimer timer;
@@ -1730,12 +2189,12 @@ QVector<ScanResult> ScannerPanel::runRescanAndWait(ScanCondition condition, cons
     return m_results;
 }
 
-QVector<ScanResult> ScannerPanel::runMatrixScanAndWait(const MatrixScanParams& params,
-                                                       bool filterExecutable, bool filterWritable,
-                                                       bool skipSystemModules, int maxCandidates,
-                                                       const QVector<AddressRange>& constrainRegions,
-                                                       int timeoutMs) {
-    QVector<ScanResult> results;
+ScanResultStore ScannerPanel::runMatrixScanAndWait(const MatrixScanParams& params,
+                                                   bool filterExecutable, bool filterWritable,
+                                                   bool skipSystemModules, int maxCandidates,
+                                                   const QVector<AddressRange>& constrainRegions,
+                                                   int timeoutMs) {
+    ScanResultStore results;
     ScanRequest req;
     req.matrixScan        = true;
     req.matrixParams      = params;
@@ -1768,7 +2227,7 @@ QVector<ScanResult> ScannerPanel::runMatrixScanAndWait(const MatrixScanParams& p
 
     bool timedOut = false;
     QEventLoop loop;
-    connect(m_engine, &ScanEngine::finished, this, [&results, &loop](const QVector<ScanResult>& r) {
+    connect(m_engine, &ScanEngine::resultsReady, this, [&results, &loop](const ScanResultStore& r) {
         results = r;
         loop.quit();
     }, Qt::SingleShotConnection);
@@ -1788,7 +2247,25 @@ QVector<ScanResult> ScannerPanel::runMatrixScanAndWait(const MatrixScanParams& p
     return results;
 }
 
-void ScannerPanel::onScanFinished(QVector<ScanResult> results) {
+// A streamed batch of the running First Scan. The first one replaces the
+// previous list; the rest are appended, so the table fills while the scan
+// is still walking memory. onScanFinished swaps in the complete set.
+void ScannerPanel::onScanPartial(ScanResultStore batch) {
+    if (!m_streamingScan || batch.isEmpty()) return;
+    if (!m_streamedAny) {
+        m_streamedAny = true;
+        m_results = batch;
+        populateTable(false);
+    } else {
+        m_results.append(batch, 0, batch.size());
+        m_resultModel->appendRows(batch.size());
+    }
+    m_statusLabel->setText(QStringLiteral("%1 found so far…")
+        .arg(QLocale().toString(m_results.size())));
+}
+
+void ScannerPanel::onScanFinished(ScanResultStore results) {
+    m_streamingScan = false;
     m_scanBtn->setText(QStringLiteral("&First Scan"));
     // [iter 44] Drop the cancel-style mark so the button paints as a
     // primary action again.
@@ -1800,11 +2277,9 @@ void ScannerPanel::onScanFinished(QVector<ScanResult> results) {
     // Bytes are cached by the engine during scan.
     // Value mode (exact): override with exact search pattern (engine caches raw chunk bytes).
     // Unknown mode: keep engine-captured bytes as-is (they're the baseline).
-    for (auto& r : m_results) {
-        r.previousValue.clear();
-        if (m_lastScanMode == 1 && m_lastCondition == ScanCondition::ExactValue)
-            r.scanValue = m_lastPattern;
-    }
+    m_results.clearPrevious();
+    if (m_lastScanMode == 1 && m_lastCondition == ScanCondition::ExactValue)
+        m_results.fillValues(m_lastPattern);
 
     m_updateBtn->setEnabled(!m_results.isEmpty());
     // Reset becomes available after ANY completed first scan (even a 0-result
@@ -1821,7 +2296,7 @@ void ScannerPanel::onScanFinished(QVector<ScanResult> results) {
     }
     updateModuleColumnVisibility();
 
-    int n = m_results.size();
+    const qint64 n = m_results.candidateCount();
     // [iter 30] Format result counts with thousands separators using the
     // current locale — "47,832" reads instantly versus "47832".
     QLocale loc;
@@ -1834,155 +2309,51 @@ void ScannerPanel::onScanFinished(QVector<ScanResult> results) {
             .arg(nFmt).arg(n == 1 ? "" : "s"));
     }
     updateStageLabel();
+    updateTruncationBanner();
+
+    // Apply any active result-filter text to the freshly populated rows.
+    if (!m_resultFilter->text().isEmpty()) applyResultFilter();
+}
 
-    // Truncation banner — populateTable caps display at 10K rows; tell the
-    // user explicitly so they don't think a large scan completed empty.
-    constexpr int kMaxRows = 10000;
-    if (n > kMaxRows) {
+// Truncation banner — every listed result is shown, but a snapshot-backed
+// set has no rows at all until it's narrowed; tell the user explicitly so
+// they don't think a large scan completed empty.
+void ScannerPanel::updateTruncationBanner() {
+    QLocale loc;
+    const qint64 n = m_results.candidateCount();
+    if (m_results.isSnapshot()) {
         m_truncBanner->setText(QStringLiteral(
-            "Showing the first %1 of %2 results (all %2 are scanned) — "
-            "narrow with Next Scan or the filter box.")
-            .arg(loc.toString(kMaxRows)).arg(nFmt));
+            "%1 candidates are held in a disk snapshot — narrow with Next Scan; "
+            "addresses are listed once fewer than %2 remain.")
+            .arg(loc.toString(n)).arg(loc.toString(m_results.snapshot()->threshold())));
         m_truncBanner->setVisible(true);
     } else {
         m_truncBanner->setVisible(false);
     }
-
-    // Apply any active result-filter text to the freshly populated rows.
-    if (!m_resultFilter->text().isEmpty()) applyResultFilter();
 }
 
 void ScannerPanel::populateTable(bool showPrevious) {
-    constexpr int kMaxRows = 10000;
-
     // [iter 42] Filter widget toggles enabled state with the result list.
     m_resultFilter->setEnabled(!m_results.isEmpty());
 
-    m_resultTable->blockSignals(true);
-    // Sorting must be off while we mutate cells, otherwise Qt re-sorts mid-fill
-    // and our row-index → result-index mapping breaks.
-    m_resultTable->setSortingEnabled(false);
-
     // Module column appears only when at least one result has a module name.
-    bool anyModule = false;
-    for (const auto& r : m_results) {
-        if (!r.regionModule.isEmpty()) { anyModule = true; break; }
-    }
-    int baseCols = showPrevious ? 3 : 2;
-    int cols = baseCols + (anyModule ? 1 : 0);
-    m_resultTable->setColumnCount(cols);
-    int displayCount = qMin(m_results.size(), kMaxRows);
-    m_resultTable->setRowCount(displayCount);
+    const bool anyModule = m_results.hasModules();
+
+    // Cells are formatted by the model on demand, so this is constant-time
+    // in the result count. The reset restores default section sizes; carry
+    // the address column's width across it.
+    auto* hdr = m_resultTable->horizontalHeader();
+    const int addrWidth = m_resultTable->columnWidth(0);
+    m_resultModel->resetRows(m_lastValueType, m_lastScanMode != 0,
+                             showPrevious, anyModule);
+    m_resultTable->setColumnWidth(0, addrWidth);
+    // Keep whatever column the user sorted by across scans.
+    m_resultModel->sort(hdr->sortIndicatorSection(), hdr->sortIndicatorOrder());
 
     // Always re-show the headers when the column set changes — they were
     // hidden by default but become useful for sorting once the user has
     // multiple result kinds in play.
-    m_resultTable->horizontalHeader()->setVisible(anyModule || showPrevious);
-    // [iter 51] Header items get tooltips advertising the click-to-sort
-    // affordance — sortable headers are easy to miss when their visual
-    // chrome is identical to read-only label rows.
-    auto makeHeader = [this](const QString& title, const QString& tip) {
-        auto* h = new QTableWidgetItem(title);
-        // Set the font on the header ITEM (FontRole) — applying a stylesheet to
-        // the table makes QHeaderView ignore setFont() on the header view, so
-        // the column titles otherwise fell back to the system Sans default
-        // instead of the monospaced editor font.
-        h->setFont(m_resultTable->font());
-        h->setToolTip(tip);
-        return h;
-    };
-    m_resultTable->setHorizontalHeaderItem(0, makeHeader(
-        QStringLiteral("Address"),
-        QStringLiteral("Click to sort by address. Shift+click for reverse order.")));
-    m_resultTable->setHorizontalHeaderItem(1, makeHeader(
-        QStringLiteral("Value"),
-        QStringLiteral("Click to sort by current value. Double-click a cell to edit it.")));
-    if (showPrevious)
-        m_resultTable->setHorizontalHeaderItem(2, makeHeader(
-            QStringLiteral("Previous"),
-            QStringLiteral("The value at the previous scan (for reference, de-emphasized). The "
-                           "current Value to the left is tinted and arrowed ↑/↓ to show "
-                           "which way it moved.")));
-    if (anyModule)
-        m_resultTable->setHorizontalHeaderItem(baseCols, makeHeader(
-            QStringLiteral("Module"),
-            QStringLiteral("Module (DLL/exe) the address falls inside, when known.")));
-
-    for (int i = 0; i < displayCount; i++) {
-        const auto& r = m_results[i];
-
-        // Address column — WinDbg backtick format: 00000000`00000000.
-        // Stash result index in UserRole so post-sort row→result lookup
-        // doesn't depend on row order matching m_results order.
-        QString hexPart = QStringLiteral("%1").arg(r.address, 16, 16, QLatin1Char('0')).toUpper();
-        hexPart.insert(8, '`');
-        auto* addrItem = new QTableWidgetItem(hexPart);
-        addrItem->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemIsEditable);
-        addrItem->setData(Qt::UserRole, i);
-        m_resultTable->setItem(i, 0, addrItem);
-
-        // Numeric values read far better right-aligned — digits line up by
-        // magnitude instead of the previous left-aligned "mishmash of
-        // lengths". Signature/hex byte strings stay left-aligned.
-        const bool numeric = (m_lastScanMode != 0);
-        const Qt::Alignment numAlign = numeric
-            ? (Qt::AlignRight | Qt::AlignVCenter)
-            : (Qt::AlignLeft  | Qt::AlignVCenter);
-
-        // Value column = the CURRENT value. Tinted green/red when it moved up
-        // or down vs the previous scan. (The direction is ALSO shown as a ↑/↓
-        // glyph in the read-only Previous column below, so color-blind users
-        // get the cue without color — we can't append it here because this
-        // cell is editable and the glyph would corrupt the parsed value.)
-        DeltaInfo delta;
-        if (showPrevious && !r.previousValue.isEmpty())
-            delta = computeDelta(m_lastValueType, r.previousValue, r.scanValue);
-        auto* valItem = new QTableWidgetItem(formatValue(r.scanValue));
-        valItem->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemIsEditable);
-        valItem->setTextAlignment(numAlign);
-        const auto& dt = ThemeManager::instance().current();
-        if (delta.direction > 0)
-            valItem->setForeground(dt.indDataChanged);   // increase
-        else if (delta.direction < 0)
-            valItem->setForeground(dt.markerPtr);         // decrease
-        m_resultTable->setItem(i, 1, valItem);
-
-        // Previous column = just the prior value (e.g. "46"). The old
-        // "<prev> → <delta>" form (e.g. "46 → -2") read as "previous →
-        // delta", which was confusing: users expect "old → new", and the
-        // new value is already right there in the Value column. Showing the
-        // bare previous value (de-emphasized) next to the tinted current
-        // value is the clear, non-redundant read.
-        if (showPrevious) {
-            QString prevText = r.previousValue.isEmpty()
-                ? QString() : formatValue(r.previousValue);
-            // Prefix a direction glyph so the up/down move reads WITHOUT color
-            // (color-blind safe). This cell is read-only, so the glyph is safe
-            // here (unlike the editable Value cell). e.g. "↑ 46" = value rose
-            // from 46; "↓ 46" = fell from 46.
-            if (!prevText.isEmpty()) {
-                if (delta.direction > 0)      prevText = QStringLiteral("↑ ") + prevText;
-                else if (delta.direction < 0) prevText = QStringLiteral("↓ ") + prevText;
-            }
-            auto* prevItem = new QTableWidgetItem(prevText);
-            prevItem->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
-            prevItem->setTextAlignment(numAlign);
-            prevItem->setForeground(dt.textDim);  // reference, not the live value
-            m_resultTable->setItem(i, 2, prevItem);
-        }
-
-        // Module column
-        if (anyModule) {
-            auto* modItem = new QTableWidgetItem(r.regionModule);
-            modItem->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
-            m_resultTable->setItem(i, baseCols, modItem);
-        }
-    }
-
-    // Re-enable click-to-sort on the headers now that fill is done.
-    m_resultTable->setSortingEnabled(true);
-
-    m_resultTable->blockSignals(false);
+    hdr->setVisible(anyModule || showPrevious);
 }
 
 void ScannerPanel::onUpdateClicked() {
@@ -2038,7 +2409,7 @@ void ScannerPanel::onUpdateClicked() {
     if (!filterPattern.isEmpty())
         m_lastPattern = filterPattern;
 
-    m_preRescanCount  = m_results.size();
+    m_preRescanCount  = m_results.candidateCount();
     m_lastResultCount = m_preRescanCount;
     m_scanGeneration  = qMax(2, m_scanGeneration + 1);  // Step 2+
     // Snapshot the pre-rescan list so Undo Scan can roll back if the new
@@ -2067,7 +2438,7 @@ void ScannerPanel::onUpdateClicked() {
                           filterPattern, filterMask);
 }
 
-void ScannerPanel::onRescanFinished(QVector<ScanResult> results) {
+void ScannerPanel::onRescanFinished(ScanResultStore results) {
     m_scanBtn->setEnabled(true);
     m_scanBtn->setText(QStringLiteral("&First Scan"));
     m_updateBtn->setText(QStringLiteral("&Next Scan"));
@@ -2087,8 +2458,8 @@ void ScannerPanel::onRescanFinished(QVector<ScanResult> results) {
                  << "results," << pt.elapsed() << "ms";
     }
 
-    int n = m_results.size();
-    int before = m_lastResultCount;
+    const qint64 n = m_results.candidateCount();
+    const qint64 before = m_lastResultCount;
     // [iter 31] Locale formatter for re-scan status counts too.
     QLocale loc;
     if (n == 0) {
@@ -2108,52 +2479,48 @@ void ScannerPanel::onRescanFinished(QVector<ScanResult> results) {
             .arg(loc.toString(n)).arg(n == 1 ? "" : "s"));
     }
     updateStageLabel();
+    updateTruncationBanner();
+
+    // The narrowed set starts unfiltered in the model; re-apply the box.
+    if (!m_resultFilter->text().isEmpty()) applyResultFilter();
 }
 
-// Helper: row index → m_results index via the UserRole stash on column 0.
-// Without this, sorting silently desyncs the result list from the table view.
-static int rowToResultIdx(QTableWidget* tbl, int row) {
-    if (row < 0) return -1;
-    auto* it = tbl->item(row, 0);
-    if (!it) return -1;
-    QVariant v = it->data(Qt::UserRole);
-    return v.isValid() ? v.toInt() : row;
+// Current view row → m_results index. Sorting and filtering permute rows in
+// the model, so a view row is never a result index by itself.
+int ScannerPanel::currentResultIndex() const {
+    return m_resultModel->resultIndex(m_resultTable->currentIndex().row());
 }
 
 void ScannerPanel::onGoToAddress() {
-    int row = m_resultTable->currentRow();
-    int idx = rowToResultIdx(m_resultTable, row);
+    int idx = currentResultIndex();
     if (idx < 0 || idx >= m_results.size()) return;
-    emit goToAddress(m_results[idx].address);
+    emit goToAddress(m_results.address(idx));
 }
 
 void ScannerPanel::onCopyAddress() {
-    int row = m_resultTable->currentRow();
-    int idx = rowToResultIdx(m_resultTable, row);
+    int idx = currentResultIndex();
     if (idx < 0 || idx >= m_results.size()) return;
 
     QString addr = QStringLiteral("0x%1")
-        .arg(m_results[idx].address, 0, 16, QLatin1Char('0')).toUpper();
+        .arg(m_results.address(idx), 0, 16, QLatin1Char('0')).toUpper();
     QApplication::clipboard()->setText(addr);
     m_statusLabel->setText(QStringLiteral("Copied: %1").arg(addr));
 }
 
-void ScannerPanel::onResultDoubleClicked(int row, int col) {
+void ScannerPanel::onResultDoubleClicked(const QModelIndex& index) {
     // Double-click on address column navigates (editing also starts via edit trigger)
     // Double-click on preview column only starts inline editing
-    Q_UNUSED(col);
-    Q_UNUSED(row);
+    Q_UNUSED(index);
     // Navigation is handled by Go to Address button or onCellEdited for address expressions
 }
 
-void ScannerPanel::onCellEdited(int row, int col) {
-    int idxResolved = rowToResultIdx(m_resultTable, row);
-    if (idxResolved < 0 || idxResolved >= m_results.size()) return;
-    const int row_idx = idxResolved;
-
-    auto* item = m_resultTable->item(row, col);
-    if (!item) return;
-    QString text = item->text().trimmed();
+// The model never writes the store itself: an edit arrives here as text,
+// and the cell repaints from m_results afterwards — so a rejected edit
+// simply shows the stored value again.
+void ScannerPanel::onCellEdited(int resultIndex, int col, const QString& edited) {
+    if (resultIndex < 0 || resultIndex >= m_results.size()) return;
+    const int row_idx = resultIndex;
+    const QString text = edited.trimmed();
 
     if (col == 0) {
         // Address column — evaluate expression via AddressParser
@@ -2178,30 +2545,18 @@ void ScannerPanel::onCellEdited(int row, int col) {
         int evalPtrSize = prov ? prov->pointerSize() : 8;
         auto result = AddressParser::evaluate(text, evalPtrSize, &cbs);
         if (result.ok) {
-            m_results[row_idx].address = result.value;
+            m_results.setAddress(row_idx, result.value);
             emit goToAddress(result.value);
-            // Reformat the address cell
-            m_resultTable->blockSignals(true);
-            QString hexPart = QStringLiteral("%1").arg(result.value, 16, 16, QLatin1Char('0')).toUpper();
-            hexPart.insert(8, '`');
-            item->setText(hexPart);
             // Re-read preview at new address and update cache
             if (prov) {
                 int readSize = (m_lastScanMode == 1) ? valueSize() : 16;
-                m_results[row_idx].scanValue = prov->readBytes(result.value, readSize);
-                if (auto* prevItem = m_resultTable->item(row, 1))
-                    prevItem->setText(formatValue(m_results[row_idx].scanValue));
+                m_results.setValue(row_idx, prov->readBytes(result.value, readSize));
             }
-            m_resultTable->blockSignals(false);
         } else {
             m_statusLabel->setText(QStringLiteral("Expression error: %1").arg(result.error));
-            // Restore original address
-            m_resultTable->blockSignals(true);
-            QString hexPart = QStringLiteral("%1").arg(m_results[row_idx].address, 16, 16, QLatin1Char('0')).toUpper();
-            hexPart.insert(8, '`');
-            item->setText(hexPart);
-            m_resultTable->blockSignals(false);
         }
+        // Repaint the row: the new address + value, or the original address.
+        m_resultModel->refreshResult(row_idx);
     } else if (col == 1) {
         // Preview column — parse hex bytes and write to provider
         std::shared_ptr<Provider> prov;
@@ -2212,7 +2567,7 @@ void ScannerPanel::onCellEdited(int row, int col) {
             return;
         }
         QByteArray bytes;
-        uint64_t addr = m_results[row_idx].address;
+        uint64_t addr = m_results.address(row_idx);
 
         if (m_lastScanMode == 0) {
             // Signature mode — parse space-separated hex bytes
@@ -2257,11 +2612,9 @@ void ScannerPanel::onCellEdited(int row, int col) {
                 .arg(bytes.size() == 1 ? "" : "s")
                 .arg(QString::number(addr, 16).toUpper()));
             // Re-read and update cache
-            m_resultTable->blockSignals(true);
             int readSize = (m_lastScanMode == 1) ? valueSize() : 16;
-            m_results[row_idx].scanValue = prov->readBytes(addr, readSize);
-            item->setText(formatValue(m_results[row_idx].scanValue));
-            m_resultTable->blockSignals(false);
+            m_results.setValue(row_idx, prov->readBytes(addr, readSize));
+            m_resultModel->refreshResult(row_idx);
         } else {
             m_statusLabel->setText(QStringLiteral("Write failed"));
         }
@@ -2287,18 +2640,18 @@ void ScannerPanel::applyTheme(const Theme& theme) {
     // [iter 17] Top border on the table — separates it from the result
     // filter input above so the two read as distinct widgets.
     m_resultTable->setStyleSheet(QStringLiteral(
-        "QTableWidget { background: %1; color: %2;"
+        "QTableView { background: %1; color: %2;"
         "  border: none; border-top: 1px solid %8;"
         "  alternate-background-color: %6; gridline-color: transparent; }"
-        "QTableWidget::item { padding: 2px 6px; border: none; }"
-        "QTableWidget::item:hover { background: %3; padding: 2px 6px; border: none; }"
+        "QTableView::item { padding: 2px 6px; border: none; }"
+        "QTableView::item:hover { background: %3; padding: 2px 6px; border: none; }"
         // Row selection = grey theme.selected (matches the editor's M_SELECTED).
-        "QTableWidget::item:selected { background: %5; color: %2; padding: 2px 6px; border: none; }"
+        "QTableView::item:selected { background: %5; color: %2; padding: 2px 6px; border: none; }"
         // In-cell editor TEXT selection = blue theme.selection — text selection
         // (selecting characters) is blue everywhere in the app (the Scintilla
         // editor, rename inputs); only ROW selection is grey. Keeping these
         // distinct matches the editor exactly.
-        "QTableWidget QLineEdit { background: %1; color: %2; border: 1px solid %4;"
+        "QTableView QLineEdit { background: %1; color: %2; border: 1px solid %4;"
         "  padding: 1px 4px; selection-background-color: %9; }"
         "QHeaderView::section { background: %1; color: %7; border: none;"
         "  border-bottom: 1px solid %8; padding: 4px 6px; }"
@@ -2571,14 +2924,14 @@ void ScannerPanel::onNewScanClicked() {
     // under 1000 results resets immediately — a CE-like pace for typical
     // narrowing chains. The cooldown auto-resets after 4s.
     constexpr int kConfirmThreshold = 1000;
-    if (m_results.size() >= kConfirmThreshold
+    if (m_results.candidateCount() >= kConfirmThreshold
         && m_newScanBtn->property("resetArmed").toBool() == false) {
         m_newScanBtn->setProperty("resetArmed", true);
         const QString prev = m_newScanBtn->text();
         m_newScanBtn->setText(QStringLiteral("Click again to reset"));
         m_statusLabel->setText(QStringLiteral(
             "About to discard %1 results — click Reset again to confirm.")
-            .arg(QLocale().toString(m_results.size())));
+            .arg(QLocale().toString(m_results.candidateCount())));
         QTimer::singleShot(4000, this, [this, prev]() {
             if (m_newScanBtn->property("resetArmed").toBool()) {
                 m_newScanBtn->setProperty("resetArmed", false);
@@ -2597,8 +2950,7 @@ void ScannerPanel::onNewScanClicked() {
     m_results.clear();
     m_undoStack.clear();
     m_undoBtn->setEnabled(false);
-    m_resultTable->setRowCount(0);
-    m_resultTable->horizontalHeader()->hide();
+    populateTable(false);
     m_updateBtn->setEnabled(false);
     m_newScanBtn->setVisible(false);
     m_truncBanner->setVisible(false);
@@ -2632,7 +2984,8 @@ void ScannerPanel::popUndoSnapshot() {
     if (m_scanGeneration > 1) --m_scanGeneration;
     m_undoBtn->setEnabled(!m_undoStack.isEmpty());
     populateTable(false);
-    int n = m_results.size();
+    updateTruncationBanner();
+    const qint64 n = m_results.candidateCount();
     m_statusLabel->setText(QStringLiteral("Restored — %1 result%2")
         .arg(n).arg(n == 1 ? "" : "s"));
     updateStageLabel();
@@ -2678,7 +3031,7 @@ void ScannerPanel::updateStageLabel(const QString& phase) {
         // [iter 65] Locale-format breadcrumb counts for consistency with the
         // status line and truncation banner.
         QLocale loc;
-        int n = m_results.size();
+        const qint64 n = m_results.candidateCount();
         if (n == 0) {
             phrase = QStringLiteral("0 results — try widening filters or check the value");
             dotColor = t.indHeatWarm.isValid() ? t.indHeatWarm : t.textMuted;
@@ -2690,8 +3043,8 @@ void ScannerPanel::updateStageLabel(const QString& phase) {
         }
     } else {
         QLocale loc;
-        int n = m_results.size();
-        int before = m_lastResultCount;
+        const qint64 n = m_results.candidateCount();
+        const qint64 before = m_lastResultCount;
         if (n == 0) {
             phrase = QStringLiteral("0 results — condition eliminated everything; click Reset to start over");
             dotColor = t.indHeatWarm.isValid() ? t.indHeatWarm : t.textMuted;
@@ -2726,45 +3079,29 @@ void ScannerPanel::onResultFilterChanged(const QString& /*text*/) {
 
 void ScannerPanel::applyResultFilter() {
     QString filt = m_resultFilter->text().trimmed();
-    int rows = m_resultTable->rowCount();
+    // Match against any column text — gives the user a single search box
+    // that hits address / value / module without needing per-column filters.
+    // The model drops non-matching rows from its row map (the store keeps
+    // them), so a filter over a huge list doesn't leave millions of hidden
+    // rows in the view.
+    const int matched = m_resultModel->setFilter(filt);
     if (filt.isEmpty()) {
-        for (int i = 0; i < rows; i++)
-            m_resultTable->setRowHidden(i, false);
         // [iter 67] When the filter clears, restore the regular result-count
         // status so the user doesn't see a stale "12 of 47 match" string.
         updateScanStatusLine();
         return;
     }
-    // Match against any column text — gives the user a single search box
-    // that hits address / value / module without needing per-column filters.
-    int matched = 0;
-    for (int i = 0; i < rows; i++) {
-        bool show = false;
-        int cols = m_resultTable->columnCount();
-        for (int c = 0; c < cols; c++) {
-            auto* it = m_resultTable->item(i, c);
-            if (it && it->text().contains(filt, Qt::CaseInsensitive)) {
-                show = true;
-                break;
-            }
-        }
-        m_resultTable->setRowHidden(i, !show);
-        if (show) ++matched;
-    }
     // [iter 67] Live "N of M match" so the user knows how aggressively
     // their filter is biting before they commit it via Enter / Next Scan.
     QLocale loc;
     m_statusLabel->setText(QStringLiteral("%1 of %2 match \"%3\"")
         .arg(loc.toString(matched))
-        .arg(loc.toString(rows))
+        .arg(loc.toString(m_results.size()))
         .arg(filt));
 }
 
 void ScannerPanel::updateModuleColumnVisibility() {
-    bool anyModule = false;
-    for (const auto& r : m_results) {
-        if (!r.regionModule.isEmpty()) { anyModule = true; break; }
-    }
+    const bool anyModule = m_results.hasModules();
     // The header visibility was already toggled inside populateTable; this
     // helper keeps the logic out of onScanFinished so future paths can call
     // it cheaply (e.g. result-list edits).
@@ -2775,7 +3112,7 @@ void ScannerPanel::updateScanStatusLine() {
     // Restore the resting result-count status (used when the post-scan filter
     // is cleared, so the user doesn't keep seeing a stale "12 of 47 match").
     QLocale loc;
-    const int n = m_results.size();
+    const qint64 n = m_results.candidateCount();
     if (n == 0)
         m_statusLabel->setText(QStringLiteral("Ready"));
     else
@@ -2785,11 +3122,12 @@ void ScannerPanel::updateScanStatusLine() {
 
 bool ScannerPanel::saveResultsTo(const QString& path) const {
     QJsonArray arr;
-    for (const auto& r : m_results) {
+    for (int i = 0; i < m_results.size(); i++) {
         QJsonObject o;
-        o["address"] = QString::number(r.address, 16);
-        o["value"]   = QString::fromLatin1(r.scanValue.toHex());
-        if (!r.regionModule.isEmpty()) o["module"] = r.regionModule;
+        o["address"] = QString::number(m_results.address(i), 16);
+        o["value"]   = QString::fromLatin1(m_results.value(i).toHex());
+        const QString module = m_results.regionModule(i);
+        if (!module.isEmpty()) o["module"] = module;
         arr.append(o);
     }
     QJsonObject root;
@@ -2817,16 +3155,17 @@ bool ScannerPanel::loadResultsFrom(const QString& path) {
     m_lastScanMode = root["scanMode"].toInt(0);
     m_lastValueType = (ValueType)root["valueType"].toInt((int)ValueType::Int32);
     auto arr = root["results"].toArray();
-    m_results.clear();
-    m_results.reserve(arr.size());
+    QVector<ScanResult> loaded;
+    loaded.reserve(arr.size());
     for (const auto& v : arr) {
         QJsonObject o = v.toObject();
         ScanResult r;
         r.address = o["address"].toString().toULongLong(nullptr, 16);
         r.scanValue = QByteArray::fromHex(o["value"].toString().toLatin1());
         r.regionModule = o["module"].toString();
-        m_results.append(r);
+        loaded.append(r);
     }
+    m_results = ScanResultStore::fromVector(loaded);
     populateTable(false);
     m_updateBtn->setEnabled(!m_results.isEmpty());
     m_newScanBtn->setVisible(!m_results.isEmpty());
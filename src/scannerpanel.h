@@ -7,11 +7,13 @@
 #include <QCheckBox>
 #include <QPushButton>
 #include <QProgressBar>
-#include <QTableWidget>
+#include <QTableView>
+#include <QAbstractTableModel>
 #include <QStyledItemDelegate>
 #include <QLabel>
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace rcx {
 
@@ -26,6 +28,81 @@ public:
                const QModelIndex& index) const override;
 };
 
+// Table model over the panel's ScanResultStore. Cells are formatted from the
+// store's columns when the view asks for them, so showing a million rows
+// costs no more than showing ten. Sorting and filtering permute a row →
+// result-index map; the store itself is never reordered.
+class ScanResultModel : public QAbstractTableModel {
+    Q_OBJECT
+public:
+    using Formatter = std::function<QString(const QByteArray&)>;
+
+    ScanResultModel(const ScanResultStore* store, Formatter format,
+                    QObject* parent = nullptr);
+
+    /** Rebuild against the store in its natural order. Drops sort and filter. */
+    void resetRows(ValueType valueType, bool numeric, bool showPrevious, bool showModule);
+    /** Store values changed in place: repaint the value columns. */
+    void refreshValues();
+    /** Repaint the row showing `resultIndex`, if it is visible. */
+    void refreshResult(int resultIndex);
+    /** The store grew by `count` rows at its end (a streamed batch). They
+     *  are inserted in place; under a sort or filter, matching rows join
+     *  the end unsorted until the next resetRows/sort. */
+    void appendRows(int count);
+
+    /** Keep rows with `text` in any column (case-insensitive); empty shows all.
+     *  Returns the visible row count. The current sort is re-applied. */
+    int  setFilter(const QString& text);
+    int  resultIndex(int row) const;
+    int  previousColumn() const { return m_showPrevious ? 2 : -1; }
+    int  moduleColumn() const   { return m_showModule ? (m_showPrevious ? 3 : 2) : -1; }
+    void setHeaderFont(const QFont& font);
+
+    int rowCount(const QModelIndex& parent = {}) const override;
+    int columnCount(const QModelIndex& parent = {}) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+    /** Stable, typed sort (numbers by value, addresses numerically). A column
+     *  outside the current set restores the natural scan order. */
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+signals:
+    /** An address or value cell was edited. The panel evaluates the text
+     *  and writes the store; the model never mutates it. */
+    void cellEdited(int resultIndex, int column, const QString& text);
+
+private:
+    QString cellText(int result, int column) const;
+    bool    matchesFilter(int result) const;
+    int     rowOfResult(int result) const;      // -1 when filtered out
+    int     deltaDirection(int result) const;   // +1 rose, -1 fell, 0 otherwise
+    void    orderRows(std::vector<int>& rows) const;
+
+    const ScanResultStore* m_store;
+    Formatter     m_format;
+    ValueType     m_valueType = ValueType::Int32;
+    bool          m_numeric = false;
+    bool          m_showPrevious = false;
+    bool          m_showModule = false;
+    QFont         m_headerFont;
+    // Visible rows in display order. Unused while m_natural: row == result.
+    std::vector<int> m_rows;
+    // Inverse of m_rows (result -> row, -1 if hidden), rebuilt on first
+    // lookup after the rows change; empty = stale.
+    mutable std::vector<int> m_rowOf;
+    bool          m_natural = true;
+    // Natural-order row count. The store grows before appendRows() runs,
+    // so rowCount() can't read its size directly.
+    int           m_naturalRows = 0;
+    QString       m_filter;
+    int           m_sortColumn = -1;
+    Qt::SortOrder m_sortOrder = Qt::AscendingOrder;
+};
+
 class ScannerPanel : public QWidget {
     Q_OBJECT
 public:
@@ -59,7 +136,8 @@ public:
     QPushButton*  newScanButton() const { return m_newScanBtn; }
     QPushButton*  undoButton()    const { return m_undoBtn; }
     QProgressBar* progressBar()  const { return m_progressBar; }
-    QTableWidget* resultsTable() const { return m_resultTable; }
+    QTableView*   resultsTable() const { return m_resultTable; }
+    ScanResultModel* resultsModel() const { return m_resultModel; }
     QLabel*       statusLabel()  const { return m_statusLabel; }
     QPushButton*  gotoButton()   const { return m_gotoBtn; }
     QPushButton*  copyButton()   const { return m_copyBtn; }
@@ -68,7 +146,7 @@ public:
     QComboBox*    condCombo()    const { return m_condCombo; }
     QLabel*       condLabel()    const { return m_condLabel; }
     QCheckBox*    structOnlyCheck() const { return m_structOnlyCheck; }
-    const QVector<ScanResult>& results() const { return m_results; }
+    const ScanResultStore& results() const { return m_results; }
 
     /** Save / load the result list to a JSON file. */
     bool saveResultsTo(const QString& path) const;
@@ -79,19 +157,19 @@ public:
     void loadSettings(const QString& key = QStringLiteral("scanner"));
 
     /** Run a value scan and block until done. For MCP / automation. Returns results; updates panel table. */
-    QVector<ScanResult> runValueScanAndWait(ValueType valueType, const QString& value,
-                                            bool filterExecutable = false, bool filterWritable = false,
-                                            const QVector<AddressRange>& constrainRegions = {});
+    ScanResultStore runValueScanAndWait(ValueType valueType, const QString& value,
+                                        bool filterExecutable = false, bool filterWritable = false,
+                                        const QVector<AddressRange>& constrainRegions = {});
 
     /** Run a pattern/signature scan and block until done. Pattern: space-separated hex bytes, e.g. "00 00 20 42 ?? ??". */
-    QVector<ScanResult> runPatternScanAndWait(const QString& pattern,
-                                              bool filterExecutable = false, bool filterWritable = false,
-                                              const QVector<AddressRange>& constrainRegions = {});
+    ScanResultStore runPatternScanAndWait(const QString& pattern,
+                                          bool filterExecutable = false, bool filterWritable = false,
+                                          const QVector<AddressRange>& constrainRegions = {});
 
     /** Run pattern scan using the given provider (for MCP: use tab's provider so scan runs on the right tab). */
-    QVector<ScanResult> runPatternScanAndWait(std::shared_ptr<Provider> provider, const QString& pattern,
-                                              bool filterExecutable = false, bool filterWritable = false,
-                                              const QVector<AddressRange>& constrainRegions = {});
+    ScanResultStore runPatternScanAndWait(std::shared_ptr<Provider> provider, const QString& pattern,
+                                          bool filterExecutable = false, bool filterWritable = false,
+                                          const QVector<AddressRange>& constrainRegions = {});
 
     /** Blocking value scan with an explicit condition. Drives the SAME result set the panel keeps
      *  (m_results), so a subsequent runRescanAndWait narrows it — this is the iterative-narrowing
@@ -99,28 +177,36 @@ public:
      *  (value ignored); Between uses value=lower, value2=upper; compare-against-previous conditions
      *  (Changed/Increased/...) have no baseline on a first scan and capture-all instead. A hard
      *  timeout aborts a runaway scan and returns the partial set. */
-    QVector<ScanResult> runValueScanAndWait(ValueType valueType, ScanCondition condition,
-                                            const QString& value, const QString& value2 = {},
-                                            bool filterExecutable = false, bool filterWritable = false,
-                                            bool skipSystemModules = false,
-                                            const QVector<AddressRange>& constrainRegions = {},
+    ScanResultStore runValueScanAndWait(ValueType valueType, ScanCondition condition,
+                                        const QString& value, const QString& value2 = {},
+                                        bool filterExecutable = false, bool filterWritable = false,
+                                        bool skipSystemModules = false,
+                                        const QVector<AddressRange>& constrainRegions = {},
+                                        int timeoutMs = 120000);
+
+    /** Blocking pointer-path scan (pointerscan.h) on the panel's engine, so the panel's progress
+     *  bar follows it and Stop / Esc abort it like any scan. Same hard timeout as the value scan;
+     *  an aborted or timed-out scan returns its partial paths with stats.aborted set. Empty, with
+     *  the reason in the status line, if the engine is busy or refuses the request. */
+    PointerScanResult runPointerScanAndWait(std::shared_ptr<Provider> provider,
+                                            const PointerScanRequest& req,
                                             int timeoutMs = 120000);
 
     /** Blocking re-scan over the current result set using the existing engine (the UI Next-Scan
      *  path). Narrows m_results in place. value/value2 used for typed conditions (Between uses both),
      *  delta for IncreasedBy/DecreasedBy. */
-    QVector<ScanResult> runRescanAndWait(ScanCondition condition, const QString& value = {},
-                                         const QString& value2 = {}, const QString& delta = {},
-                                         int timeoutMs = 120000);
+    ScanResultStore runRescanAndWait(ScanCondition condition, const QString& value = {},
+                                     const QString& value2 = {}, const QString& delta = {},
+                                     int timeoutMs = 120000);
 
     /** Blocking structure-aware scan for 4x4 affine view-matrix candidates (see matrixscan.h).
      *  Returns candidates ranked best-first; also populates the panel result set so the agent can
      *  then runRescanAndWait(Changed) while moving the camera to confirm the live one. */
-    QVector<ScanResult> runMatrixScanAndWait(const MatrixScanParams& params,
-                                             bool filterExecutable = false, bool filterWritable = true,
-                                             bool skipSystemModules = true, int maxCandidates = 64,
-                                             const QVector<AddressRange>& constrainRegions = {},
-                                             int timeoutMs = 120000);
+    ScanResultStore runMatrixScanAndWait(const MatrixScanParams& params,
+                                         bool filterExecutable = false, bool filterWritable = true,
+                                         bool skipSystemModules = true, int maxCandidates = 64,
+                                         const QVector<AddressRange>& constrainRegions = {},
+                                         int timeoutMs = 120000);
 
     // Accessors for the MCP bridge to build structured responses (formatValue/valueSize are private).
     int       scanGeneration()  const { return m_scanGeneration; }
@@ -143,22 +229,25 @@ protected:
 private slots:
     void onModeChanged(int index);
     void onScanClicked();
-    void onScanFinished(QVector<ScanResult> results);
+    void onScanPartial(rcx::ScanResultStore batch);
+    void onScanFinished(rcx::ScanResultStore results);
     void onGoToAddress();
     void onCopyAddress();
-    void onResultDoubleClicked(int row, int col);
-    void onCellEdited(int row, int col);
+    void onResultDoubleClicked(const QModelIndex& index);
+    void onCellEdited(int resultIndex, int col, const QString& text);
     void onUpdateClicked();
-    void onRescanFinished(QVector<ScanResult> results);
+    void onRescanFinished(rcx::ScanResultStore results);
     void onNewScanClicked();
     void onResultFilterChanged(const QString& text);
 
 private:
     ScanRequest buildRequest();
     void populateTable(bool showPrevious);
+    int  currentResultIndex() const;   // -1 when no row is current
     void updateComboWidth();
     void applyResultFilter();
     void updateScanStatusLine();
+    void updateTruncationBanner();
     void updateModuleColumnVisibility();
 
     void onConditionChanged(int index);
@@ -205,12 +294,13 @@ private:
     // Undo stack — snapshots of m_results before each Next Scan so the user
     // can step back when a re-scan over-narrows. Capped at 16 entries
     // (typical CE workflow rarely needs more).
-    QVector<QVector<ScanResult>> m_undoStack;
+    QVector<ScanResultStore> m_undoStack;
     void pushUndoSnapshot();
     void popUndoSnapshot();
 
     // Results
-    QTableWidget*    m_resultTable;
+    QTableView*      m_resultTable;
+    ScanResultModel* m_resultModel;
     AddressDelegate* m_addrDelegate;
     QLabel*          m_statusLabel;
     QLabel*          m_truncBanner;       // "Displaying N of M — narrow with Re-scan"
@@ -221,19 +311,21 @@ private:
 
     // Workflow tracking — drives the stage label.
     int m_scanGeneration = 0;             // 0 = no scan yet; 1 = first scan; 2+ = nth re-scan
-    int m_lastResultCount = 0;            // before-rescan count (for "narrowed N → M")
+    qint64 m_lastResultCount = 0;         // before-rescan count (for "narrowed N → M")
     void updateStageLabel(const QString& phase = {});
 
     // Engine
     ScanEngine*   m_engine;
     ProviderGetter m_providerGetter;
     BoundsGetter   m_boundsGetter;
-    QVector<ScanResult> m_results;
+    ScanResultStore m_results;
     int           m_lastScanMode = 0;   // 0=signature, 1=value
     ValueType     m_lastValueType = ValueType::Int32;
     ScanCondition m_lastCondition = ScanCondition::ExactValue;
     QByteArray    m_lastPattern;        // serialized search value
-    int           m_preRescanCount = 0; // result count before last rescan
+    qint64        m_preRescanCount = 0; // result count before last rescan
+    bool          m_streamingScan = false; // first scan running with partialResults
+    bool          m_streamedAny = false;   // a batch of it has been shown
 
     QString formatValue(const QByteArray& bytes) const;
     int     valueSize() const;
@@ -0,0 +1,68 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Bounded single-producer / single-consumer ring.
+//
+// push() and pop() never block and never allocate: each side owns one
+// monotonically increasing counter and only reads the other's with acquire
+// ordering, so a slot's contents are published before the counter that
+// hands it over. "Single producer" means one pusher at a time — callers
+// that serialize pushes behind their own lock (ScanEngine publishes under
+// a push mutex) are fine. Capacity is rounded up to a power of two.
+
+namespace rcx {
+
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity) {
+        size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        m_slots.resize(cap);
+        m_mask = cap - 1;
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    size_t capacity() const { return m_slots.size(); }
+
+    // Producer side. Returns false (and leaves `v` untouched) when full.
+    bool push(T&& v) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) >= m_slots.size())
+            return false;
+        m_slots[tail & m_mask] = std::move(v);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false when empty.
+    bool pop(T& out) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+            return false;
+        out = std::move(m_slots[head & m_mask]);
+        m_slots[head & m_mask] = T();   // drop the slot's share now, not on wrap
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Either side; a snapshot that may be stale by the time it's read.
+    size_t size() const {
+        return m_tail.load(std::memory_order_acquire)
+             - m_head.load(std::memory_order_acquire);
+    }
+    bool isFull() const { return size() >= m_slots.size(); }
+
+private:
+    std::vector<T> m_slots;
+    size_t m_mask = 0;
+    alignas(64) std::atomic<size_t> m_head{0};   // next slot to pop
+    alignas(64) std::atomic<size_t> m_tail{0};   // next slot to push
+};
+
+} // namespace rcx
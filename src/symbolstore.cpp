@@ -1,10 +1,11 @@
 #include "symbolstore.h"
 #include "providers/provider.h"
 #include <QDebug>
+#include <QThreadPool>
 
 namespace rcx {
 
-uint64_t SymbolStore::getModuleBase(const Provider* provider, const QString& canonical) const {
+uint64_t SymbolStore::getModuleBase(const Provider* provider, const QString& canonical) {
     if (!provider)
         return 0;
     uint64_t base = provider->symbolToAddress(canonical);
@@ -46,6 +47,7 @@ int SymbolStore::addModule(const QString& moduleName, const QString& pdbPath,
         m_aliases[rawLower] = canonical;
 
     m_modules[canonical] = std::move(set);
+    ++m_generation;
 
     qDebug() << "[SymbolStore] loaded" << count << "symbols for module" << canonical
              << "(from" << pdbPath << ")";
@@ -87,6 +89,7 @@ void SymbolStore::addRttiHits(const QString& moduleName,
         it->rvaToName.emplaceBack(h.second, h.first);
     }
     it->sortRvaIndex();
+    ++m_generation;
 }
 
 uint32_t SymbolStore::typeIndexForSymbol(const QString& qualifiedSymbol) const {
@@ -103,10 +106,11 @@ uint32_t SymbolStore::typeIndexForSymbol(const QString& qualifiedSymbol) const {
 
 void SymbolStore::unloadModule(const QString& moduleName) {
     QString canonical = resolveAlias(moduleName);
-    m_modules.remove(canonical);
+    if (m_modules.remove(canonical)) ++m_generation;
 }
 
-uint64_t SymbolStore::resolve(const QString& token, const Provider* provider, bool* ok) const {
+uint64_t SymbolStore::Snapshot::resolve(const QString& token, const Provider* provider,
+                                        bool* ok) const {
     *ok = false;
 
     // Check for "module!symbol" syntax
@@ -114,10 +118,10 @@ uint64_t SymbolStore::resolve(const QString& token, const Provider* provider, bo
     if (bangIdx > 0 && bangIdx < token.size() - 1) {
         QString modPart = token.left(bangIdx);
         QString symPart = token.mid(bangIdx + 1);
-        QString canonical = resolveAlias(modPart);
+        QString canonical = canonicalName(modPart, aliases);
 
-        auto modIt = m_modules.find(canonical);
-        if (modIt == m_modules.end())
+        auto modIt = modules.find(canonical);
+        if (modIt == modules.end())
             return 0;
 
         auto symIt = modIt->nameToRva.find(symPart);
@@ -139,7 +143,7 @@ uint64_t SymbolStore::resolve(const QString& token, const Provider* provider, bo
     QString foundModule;
     int matches = 0;
 
-    for (auto it = m_modules.begin(); it != m_modules.end(); ++it) {
+    for (auto it = modules.begin(); it != modules.end(); ++it) {
         auto symIt = it->nameToRva.find(token);
         if (symIt != it->nameToRva.end()) {
             foundRva = *symIt;
@@ -158,7 +162,7 @@ uint64_t SymbolStore::resolve(const QString& token, const Provider* provider, bo
 
     // Fallback: treat bare token as a module name (e.g. "ntdll" → ntdll base)
     if (matches == 0) {
-        QString canonical = resolveAlias(token);
+        QString canonical = canonicalName(token, aliases);
         uint64_t moduleBase = getModuleBase(provider, canonical);
         if (moduleBase != 0) {
             *ok = true;
@@ -169,48 +173,120 @@ uint64_t SymbolStore::resolve(const QString& token, const Provider* provider, bo
     return 0;
 }
 
-QString SymbolStore::getSymbolForAddress(uint64_t addr, const Provider* provider) const {
-    if (m_modules.isEmpty() || !provider)
-        return {};
-
-    for (auto it = m_modules.begin(); it != m_modules.end(); ++it) {
-        const PdbSymbolSet& set = *it;
-
-        uint64_t moduleBase = getModuleBase(provider, set.moduleName);
-        if (moduleBase == 0)
-            continue;
-
-        if (addr < moduleBase)
-            continue;
-
-        uint32_t rva = static_cast<uint32_t>(addr - moduleBase);
+uint64_t SymbolStore::resolve(const QString& token, const Provider* provider, bool* ok) const {
+    return snapshot().resolve(token, provider, ok);
+}
 
-        if (set.rvaToName.isEmpty())
-            continue;
+QHash<QString, uint64_t> SymbolStore::moduleBases(const QHash<QString, PdbSymbolSet>& modules,
+                                                  const Provider* provider) {
+    QHash<QString, uint64_t> bases;
+    for (auto it = modules.cbegin(); it != modules.cend(); ++it) {
+        uint64_t base = getModuleBase(provider, it->moduleName);
+        if (base != 0) bases.insert(it.key(), base);
+    }
+    return bases;
+}
 
-        // Binary search: find last entry with RVA <= target
-        auto upper = std::upper_bound(set.rvaToName.begin(), set.rvaToName.end(), rva,
-            [](uint32_t val, const QPair<uint32_t, QString>& entry) {
-                return val < entry.first;
-            });
+QVector<NameSpan> SymbolStore::spansAt(const QHash<QString, PdbSymbolSet>& modules,
+                                       const QHash<QString, uint64_t>& bases, bool humanize) {
+    QVector<NameSpan> out;
+    for (auto b = bases.cbegin(); b != bases.cend(); ++b) {
+        auto modIt = modules.constFind(b.key());
+        if (modIt == modules.cend()) continue;
+        const auto& syms = modIt->rvaToName;
+        const QString prefix = modIt->moduleName + QStringLiteral("!");
+        out.reserve(out.size() + syms.size());
+        for (int i = 0; i < syms.size(); ++i) {
+            const uint32_t rva = syms[i].first;
+            // Of several names at one RVA the last sorted one answers.
+            if (i + 1 < syms.size() && syms[i + 1].first == rva) continue;
+            uint64_t end = uint64_t(rva) + kMaxDisplacement + 1;
+            if (i + 1 < syms.size()) end = qMin(end, uint64_t(syms[i + 1].first));
+            NameSpan s;
+            s.lo = b.value() + rva;
+            s.hi = b.value() + end;
+            s.name = prefix + syms[i].second;
+            s.withOffset = true;
+            s.humanize = humanize;
+            out.append(std::move(s));
+        }
+    }
+    return out;
+}
 
-        if (upper == set.rvaToName.begin())
-            continue;
+QVector<NameSpan> SymbolStore::addressSpans(const Provider* provider, bool humanize) const {
+    if (m_modules.isEmpty() || !provider) return {};
+    return spansAt(m_modules, moduleBases(m_modules, provider), humanize);
+}
 
-        --upper;
-        uint32_t displacement = rva - upper->first;
+QString SymbolStore::searchModules(uint64_t addr, const QHash<QString, uint64_t>& bases) const {
+    const PdbSymbolSet* best = nullptr;
+    uint64_t bestLo = 0;
+    int bestIdx = -1;
+    for (auto b = bases.cbegin(); b != bases.cend(); ++b) {
+        auto modIt = m_modules.constFind(b.key());
+        if (modIt == m_modules.cend() || addr < b.value()) continue;
+        const uint64_t off = addr - b.value();
+        if (off > UINT32_MAX) continue;
+        const auto& syms = modIt->rvaToName;
+        // Last entry at or below `off`: the last sorted name at its RVA.
+        auto it = std::upper_bound(syms.cbegin(), syms.cend(), uint32_t(off),
+            [](uint32_t v, const QPair<uint32_t, QString>& e) { return v < e.first; });
+        if (it == syms.cbegin()) continue;
+        --it;
+        if (off - it->first > kMaxDisplacement) continue;
+        const uint64_t lo = b.value() + it->first;
+        if (!best || lo > bestLo) {
+            best = &*modIt;
+            bestLo = lo;
+            bestIdx = int(it - syms.cbegin());
+        }
+    }
+    if (!best) return {};
+    QString out = best->moduleName + QStringLiteral("!") + best->rvaToName[bestIdx].second;
+    if (addr != bestLo) out += QStringLiteral("+0x") + QString::number(addr - bestLo, 16);
+    return out;
+}
 
-        static constexpr uint32_t kMaxDisplacement = 0x1000;
-        if (displacement > kMaxDisplacement)
-            continue;
+QString SymbolStore::getSymbolForAddress(uint64_t addr, const Provider* provider) const {
+    if (m_modules.isEmpty() || !provider)
+        return {};
 
-        if (displacement == 0)
-            return set.moduleName + QStringLiteral("!") + upper->second;
-        return set.moduleName + QStringLiteral("!") + upper->second
-             + QStringLiteral("+0x") + QString::number(displacement, 16);
+    if (m_addrBuild && m_addrBuild->done.load(std::memory_order_acquire)) {
+        m_addrIndex = std::move(m_addrBuild->target);
+        m_addrBuild.reset();
     }
-
-    return {};
+    const auto matches = [&](const AddrIndex& i) {
+        return i.provider == provider && i.generation == m_generation;
+    };
+    const bool current = m_addrIndex.index && matches(m_addrIndex);
+    const bool building = m_addrBuild && matches(m_addrBuild->target);
+
+    // Module bases cost up to four provider round-trips each; ask at most
+    // once per kBaseRecheckMs, and only start a build when something moved.
+    // Sorting every module's symbols into the index happens on the pool.
+    if ((!current && !building)
+        || (!building && m_addrIndexChecked.hasExpired(kBaseRecheckMs))) {
+        QHash<QString, uint64_t> bases = moduleBases(m_modules, provider);
+        m_addrIndexChecked.start();
+        if (!current || bases != m_addrIndex.bases) {
+            // A superseded build still finishes; its result is dropped.
+            auto build = std::make_shared<AddrBuild>();
+            build->target.provider = provider;
+            build->target.generation = m_generation;
+            build->target.bases = bases;
+            m_addrBuild = build;
+            QThreadPool::globalInstance()->start(
+                [build, modules = m_modules, bases = std::move(bases)]() {
+                    build->target.index = NameIndex::build({spansAt(modules, bases, false)});
+                    build->done.store(true, std::memory_order_release);
+                });
+        }
+    }
+    // Until the build for these bases lands, search the modules directly.
+    if (m_addrBuild && matches(m_addrBuild->target))
+        return searchModules(addr, m_addrBuild->target.bases);
+    return m_addrIndex.index->nameFor(addr);
 }
 
 void SymbolStore::addAlias(const QString& alias, const QString& canonicalModule) {
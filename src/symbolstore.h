@@ -1,11 +1,15 @@
 #pragma once
 #include "imports/import_pdb.h"  // for PdbTypeInfo
+#include "names/name_index.h"
+#include <QElapsedTimer>
 #include <QString>
 #include <QStringList>
 #include <QHash>
 #include <QVector>
 #include <QPair>
 #include <algorithm>
+#include <atomic>
+#include <memory>
 
 namespace rcx {
 
@@ -75,8 +79,27 @@ public:
 
     // Reverse lookup: given an absolute address and a provider, find the nearest symbol.
     // Returns "module!symbol" or "module!symbol+0xN", or empty if no match.
+    // One binary search over a cached NameIndex of every module; while that
+    // index is (re)built on the thread pool, a binary search per module.
     QString getSymbolForAddress(uint64_t addr, const Provider* provider) const;
 
+    // Each symbol of every module attached to `provider` as a span named
+    // "module!symbol", reaching up to the next symbol or kMaxDisplacement
+    // past it — exactly the addresses getSymbolForAddress() names.
+    QVector<NameSpan> addressSpans(const Provider* provider, bool humanize = false) const;
+
+    // The pieces of addressSpans(), for laying spans out off the GUI
+    // thread: snapshot the modules here (an implicitly shared copy), then
+    // look up their bases and build the spans on any thread — both only
+    // touch their arguments.
+    QHash<QString, PdbSymbolSet> modulesSnapshot() const { return m_modules; }
+    static QHash<QString, uint64_t> moduleBases(const QHash<QString, PdbSymbolSet>& modules,
+                                                const Provider* provider);
+    static QVector<NameSpan> spansAt(const QHash<QString, PdbSymbolSet>& modules,
+                                     const QHash<QString, uint64_t>& bases, bool humanize);
+
+    static constexpr uint32_t kMaxDisplacement = 0x1000;
+
     // Check if any symbols are loaded.
     bool hasSymbols() const { return !m_modules.isEmpty(); }
 
@@ -97,15 +120,25 @@ public:
     void addAlias(const QString& alias, const QString& canonicalModule);
 
     // Resolve alias to canonical module name (public for callers that need it)
-    QString resolveAlias(const QString& name) const {
+    QString resolveAlias(const QString& name) const { return canonicalName(name, m_aliases); }
+    static QString canonicalName(const QString& name, const QHash<QString, QString>& aliases) {
         QString lower = name.toLower();
         if (lower.endsWith(QStringLiteral(".exe")) || lower.endsWith(QStringLiteral(".dll")) ||
             lower.endsWith(QStringLiteral(".sys")))
             lower = lower.left(lower.lastIndexOf('.'));
-        auto it = m_aliases.find(lower);
-        return it != m_aliases.end() ? *it : lower;
+        auto it = aliases.find(lower);
+        return it != aliases.end() ? *it : lower;
     }
 
+    // resolve() against a snapshot of the loaded modules and aliases
+    // (implicitly shared copies), for evaluating names off the GUI thread.
+    struct Snapshot {
+        QHash<QString, PdbSymbolSet> modules;
+        QHash<QString, QString>      aliases;
+        uint64_t resolve(const QString& token, const Provider* provider, bool* ok) const;
+    };
+    Snapshot snapshot() const { return {m_modules, m_aliases}; }
+
 private:
     SymbolStore() {
         // Common Windows kernel aliases
@@ -116,10 +149,35 @@ private:
     }
 
     // Get the module base address, trying various name forms
-    uint64_t getModuleBase(const Provider* provider, const QString& canonical) const;
+    static uint64_t getModuleBase(const Provider* provider, const QString& canonical);
+    // Nearest symbol below `addr` by a search of each module's RVA list,
+    // for lookups while the index builds. Same answers as the index.
+    QString searchModules(uint64_t addr, const QHash<QString, uint64_t>& bases) const;
 
     QHash<QString, PdbSymbolSet> m_modules;  // canonical lowercase name → symbol set
     QHash<QString, QString> m_aliases;        // alias → canonical name
+
+    // getSymbolForAddress index, built on the thread pool at the bases its
+    // provider reported. Rebuilt when m_generation moves (modules added or
+    // removed) or a base moves; bases are re-queried at most every
+    // kBaseRecheckMs, so a module that loads after its PDB still starts
+    // resolving.
+    struct AddrIndex {
+        std::shared_ptr<const NameIndex> index;
+        const Provider*                  provider = nullptr;
+        quint64                          generation = 0;
+        QHash<QString, uint64_t>         bases;
+    };
+    // A build in flight: the pool thread fills `index` and then sets `done`.
+    struct AddrBuild {
+        AddrIndex         target;
+        std::atomic<bool> done{false};
+    };
+    static constexpr int kBaseRecheckMs = 1000;
+    quint64 m_generation = 0;
+    mutable AddrIndex                  m_addrIndex;
+    mutable std::shared_ptr<AddrBuild> m_addrBuild;
+    mutable QElapsedTimer              m_addrIndexChecked;
 };
 
 } // namespace rcx
@@ -0,0 +1,569 @@
+#include "timeseries.h"
+#include "providers/provider.h"
+#include <QDebug>
+#include <QtEndian>
+#include <QTextStream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace rcx {
+
+namespace {
+
+constexpr char     kFileMagic[6]  = {'R', 'C', 'X', 'T', 'S', '\0'};
+constexpr char     kBlockMagic[4] = {'B', 'L', 'K', '\0'};
+constexpr uint16_t kVersion = 1;
+constexpr int      kBlockHeaderBytes = 4 + 4 + 8 + 8 + 4;
+
+template <typename T>
+void putLE(std::vector<uint8_t>& out, T v) {
+    uint8_t b[sizeof(T)];
+    qToLittleEndian(v, b);
+    out.insert(out.end(), b, b + sizeof(T));
+}
+
+template <typename T>
+T getLE(const uint8_t* p) { return qFromLittleEndian<T>(p); }
+
+void putVarint(std::vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(uint8_t(v) | 0x80);
+        v >>= 7;
+    }
+    out.push_back(uint8_t(v));
+}
+
+bool getVarint(const uint8_t*& p, const uint8_t* end, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (p >= end) return false;
+        uint8_t b = *p++;
+        v |= uint64_t(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+uint64_t zigzag(int64_t v)   { return (uint64_t(v) << 1) ^ uint64_t(v >> 63); }
+int64_t  unzigzag(uint64_t v) { return int64_t(v >> 1) ^ -int64_t(v & 1); }
+
+// Loads a 1..8 byte little-endian integer; Signed columns sign-extend so a
+// small negative step stays a small delta.
+uint64_t loadInt(const uint8_t* p, int width, bool isSigned) {
+    uint64_t v = 0;
+    memcpy(&v, p, width);
+    v = qFromLittleEndian(v);
+    if (isSigned && width < 8 && (v >> (width * 8 - 1)) & 1)
+        v |= ~uint64_t(0) << (width * 8);
+    return v;
+}
+
+void storeInt(uint8_t* p, int width, uint64_t v) {
+    v = qToLittleEndian(v);
+    memcpy(p, &v, width);
+}
+
+bool isInt(SeriesEncoding e) {
+    return e == SeriesEncoding::Signed || e == SeriesEncoding::Unsigned;
+}
+
+bool validColumn(const SeriesColumn& c) {
+    if (c.width <= 0 || c.width > 0xFFFF) return false;
+    if (isInt(c.encoding)) return c.width <= 8;
+    if (c.encoding == SeriesEncoding::Float) return c.width == 4 || c.width == 8;
+    return c.encoding == SeriesEncoding::Raw;
+}
+
+// Reserves a u32 size slot; patchSize() fills it once the section is done.
+size_t beginSection(std::vector<uint8_t>& out) {
+    size_t at = out.size();
+    out.resize(at + 4);
+    return at;
+}
+
+void patchSize(std::vector<uint8_t>& out, size_t at) {
+    qToLittleEndian(uint32_t(out.size() - at - 4), out.data() + at);
+}
+
+} // namespace
+
+// ── SeriesWriter ──
+
+bool SeriesWriter::open(const QString& path, const QVector<SeriesColumn>& columns,
+                        QString* err) {
+    close();
+    if (columns.isEmpty() || columns.size() > 0xFFFF) {
+        if (err) *err = QStringLiteral("A recording needs 1..65535 columns.");
+        return false;
+    }
+    for (const auto& c : columns) {
+        if (!validColumn(c)) {
+            if (err) *err = QStringLiteral("Column '%1' has an unsupported width (%2).")
+                                .arg(c.name).arg(c.width);
+            return false;
+        }
+    }
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (err) *err = m_file.errorString();
+        return false;
+    }
+
+    m_columns = columns;
+    m_colOffset.resize(columns.size());
+    m_rowBytes = 0;
+    for (int i = 0; i < columns.size(); i++) {
+        m_colOffset[i] = m_rowBytes;
+        m_rowBytes += columns[i].width;
+    }
+    m_pending = 0;
+    m_rows = 0;
+    m_failed = false;
+    m_times.assign(kBlockRows, 0);
+    m_block.assign(size_t(kBlockRows) * m_rowBytes, 0);
+
+    std::vector<uint8_t> header(kFileMagic, kFileMagic + sizeof(kFileMagic));
+    putLE<uint16_t>(header, kVersion);
+    putLE<uint16_t>(header, uint16_t(columns.size()));
+    for (const auto& c : columns) {
+        QByteArray name = c.name.toUtf8().left(0xFFFF);
+        putLE<uint64_t>(header, c.nodeId);
+        header.push_back(uint8_t(c.encoding));
+        putLE<uint16_t>(header, uint16_t(c.width));
+        putLE<uint16_t>(header, uint16_t(name.size()));
+        header.insert(header.end(), name.constData(), name.constData() + name.size());
+    }
+    if (m_file.write(reinterpret_cast<const char*>(header.data()), qint64(header.size()))
+            != qint64(header.size())) {
+        if (err) *err = m_file.errorString();
+        m_file.close();
+        return false;
+    }
+    m_bytesWritten = qint64(header.size());
+    return true;
+}
+
+void SeriesWriter::append(qint64 timeUs, const uint8_t* row) {
+    if (!m_file.isOpen() || m_failed) return;
+    m_times[m_pending] = timeUs;
+    memcpy(m_block.data() + size_t(m_pending) * m_rowBytes, row, m_rowBytes);
+    m_pending++;
+    m_rows++;
+    if (m_pending == kBlockRows)
+        writeBlock();
+}
+
+bool SeriesWriter::writeBlock() {
+    if (m_pending == 0) return true;
+    const int rows = m_pending;
+    m_pending = 0;
+
+    m_body.clear();
+    size_t at = beginSection(m_body);
+    int64_t prevT = 0;
+    for (int r = 0; r < rows; r++) {
+        putVarint(m_body, zigzag(m_times[r] - prevT));
+        prevT = m_times[r];
+    }
+    patchSize(m_body, at);
+
+    for (int c = 0; c < m_columns.size(); c++) {
+        const SeriesColumn& col = m_columns[c];
+        const uint8_t* base = m_block.data() + m_colOffset[c];
+        at = beginSection(m_body);
+        if (isInt(col.encoding)) {
+            const bool sgn = col.encoding == SeriesEncoding::Signed;
+            uint64_t prev = 0;
+            for (int r = 0; r < rows; r++) {
+                uint64_t v = loadInt(base + size_t(r) * m_rowBytes, col.width, sgn);
+                putVarint(m_body, zigzag(int64_t(v - prev)));
+                prev = v;
+            }
+        } else {
+            for (int r = 0; r < rows; r++) {
+                const uint8_t* p = base + size_t(r) * m_rowBytes;
+                m_body.insert(m_body.end(), p, p + col.width);
+            }
+        }
+        patchSize(m_body, at);
+    }
+
+    std::vector<uint8_t> header(kBlockMagic, kBlockMagic + sizeof(kBlockMagic));
+    putLE<uint32_t>(header, uint32_t(rows));
+    putLE<int64_t>(header, m_times[0]);
+    putLE<int64_t>(header, m_times[rows - 1]);
+    putLE<uint32_t>(header, uint32_t(m_body.size()));
+
+    bool ok = m_file.write(reinterpret_cast<const char*>(header.data()), qint64(header.size()))
+                  == qint64(header.size())
+           && m_file.write(reinterpret_cast<const char*>(m_body.data()), qint64(m_body.size()))
+                  == qint64(m_body.size());
+    if (!ok) {
+        // Disk full / revoked: stop appending rather than write torn blocks.
+        qWarning("[TimeSeries] write failed for %s: %s", qPrintable(m_file.fileName()),
+                 qPrintable(m_file.errorString()));
+        m_failed = true;
+        return false;
+    }
+    m_bytesWritten += qint64(header.size() + m_body.size());
+    return true;
+}
+
+bool SeriesWriter::flush() {
+    if (!m_file.isOpen() || m_failed) return false;
+    if (!writeBlock()) return false;
+    return m_file.flush();
+}
+
+void SeriesWriter::close() {
+    if (!m_file.isOpen()) return;
+    if (!m_failed) writeBlock();
+    m_file.close();
+}
+
+// ── SeriesReader ──
+
+bool SeriesReader::open(const QString& path, QString* err) {
+    m_path = path;
+    m_columns.clear();
+    m_colOffset.clear();
+    m_blocks.clear();
+    m_rowBytes = 0;
+    m_rowCount = 0;
+
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        if (err) *err = f.errorString();
+        return false;
+    }
+    auto fail = [&](const QString& why) {
+        if (err) *err = why;
+        m_columns.clear();
+        return false;
+    };
+
+    QByteArray head = f.read(sizeof(kFileMagic) + 4);
+    if (head.size() < int(sizeof(kFileMagic) + 4)
+        || memcmp(head.constData(), kFileMagic, sizeof(kFileMagic)) != 0)
+        return fail(QStringLiteral("Not a Reclass time-series recording."));
+    const uint8_t* hp = reinterpret_cast<const uint8_t*>(head.constData()) + sizeof(kFileMagic);
+    if (getLE<uint16_t>(hp) != kVersion)
+        return fail(QStringLiteral("Unsupported recording version %1.").arg(getLE<uint16_t>(hp)));
+    const int colCount = getLE<uint16_t>(hp + 2);
+
+    for (int i = 0; i < colCount; i++) {
+        QByteArray fixed = f.read(8 + 1 + 2 + 2);
+        if (fixed.size() < 13) return fail(QStringLiteral("Truncated recording header."));
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(fixed.constData());
+        SeriesColumn c;
+        c.nodeId   = getLE<uint64_t>(p);
+        c.encoding = SeriesEncoding(p[8]);
+        c.width    = getLE<uint16_t>(p + 9);
+        int nameLen = getLE<uint16_t>(p + 11);
+        QByteArray name = f.read(nameLen);
+        if (name.size() < nameLen) return fail(QStringLiteral("Truncated recording header."));
+        c.name = QString::fromUtf8(name);
+        if (!validColumn(c))
+            return fail(QStringLiteral("Corrupt column descriptor %1.").arg(i));
+        m_colOffset.append(m_rowBytes);
+        m_rowBytes += c.width;
+        m_columns.append(c);
+    }
+
+    const qint64 size = f.size();
+    qint64 pos = f.pos();
+    while (pos + kBlockHeaderBytes <= size) {
+        QByteArray bh = f.read(kBlockHeaderBytes);
+        if (bh.size() < kBlockHeaderBytes
+            || memcmp(bh.constData(), kBlockMagic, sizeof(kBlockMagic)) != 0)
+            break;
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(bh.constData()) + 4;
+        SeriesBlockInfo b;
+        b.rows      = int(getLE<uint32_t>(p));
+        b.firstUs   = getLE<int64_t>(p + 4);
+        b.lastUs    = getLE<int64_t>(p + 12);
+        b.bodyBytes = int(getLE<uint32_t>(p + 20));
+        b.offset    = pos + kBlockHeaderBytes;
+        if (b.rows <= 0 || b.rows > SeriesWriter::kBlockRows
+            || b.offset + b.bodyBytes > size)
+            break;   // torn trailing block from a live writer
+        m_blocks.append(b);
+        m_rowCount += b.rows;
+        pos = b.offset + b.bodyBytes;
+        if (!f.seek(pos)) break;
+    }
+    return true;
+}
+
+int SeriesReader::columnIndex(uint64_t nodeId) const {
+    for (int i = 0; i < m_columns.size(); i++)
+        if (m_columns[i].nodeId == nodeId) return i;
+    return -1;
+}
+
+bool SeriesReader::forEachRow(qint64 fromUs, qint64 toUs,
+                              const std::function<bool(qint64, const uint8_t*)>& fn) const {
+    if (m_columns.isEmpty()) return false;
+    QFile f(m_path);
+    if (!f.open(QIODevice::ReadOnly)) return false;
+
+    std::vector<qint64>  times;
+    std::vector<uint8_t> rows;
+    for (const auto& b : m_blocks) {
+        if (b.lastUs < fromUs) continue;
+        if (b.firstUs > toUs) break;
+        if (!f.seek(b.offset)) return false;
+        QByteArray body = f.read(b.bodyBytes);
+        if (body.size() != b.bodyBytes) return false;
+
+        const uint8_t* p   = reinterpret_cast<const uint8_t*>(body.constData());
+        const uint8_t* end = p + body.size();
+        auto section = [&](const uint8_t*& secEnd) {
+            if (end - p < 4) return false;
+            uint32_t len = getLE<uint32_t>(p);
+            p += 4;
+            if (uint32_t(end - p) < len) return false;
+            secEnd = p + len;
+            return true;
+        };
+
+        times.resize(b.rows);
+        rows.resize(size_t(b.rows) * m_rowBytes);
+        const uint8_t* secEnd = nullptr;
+        if (!section(secEnd)) return false;
+        int64_t t = 0;
+        for (int r = 0; r < b.rows; r++) {
+            uint64_t z;
+            if (!getVarint(p, secEnd, z)) return false;
+            t += unzigzag(z);
+            times[r] = t;
+        }
+        p = secEnd;
+
+        for (int c = 0; c < m_columns.size(); c++) {
+            const SeriesColumn& col = m_columns[c];
+            uint8_t* base = rows.data() + m_colOffset[c];
+            if (!section(secEnd)) return false;
+            if (isInt(col.encoding)) {
+                uint64_t v = 0;
+                for (int r = 0; r < b.rows; r++) {
+                    uint64_t z;
+                    if (!getVarint(p, secEnd, z)) return false;
+                    v += uint64_t(unzigzag(z));
+                    storeInt(base + size_t(r) * m_rowBytes, col.width, v);
+                }
+            } else {
+                if (secEnd - p < qint64(b.rows) * col.width) return false;
+                for (int r = 0; r < b.rows; r++, p += col.width)
+                    memcpy(base + size_t(r) * m_rowBytes, p, col.width);
+            }
+            p = secEnd;
+        }
+
+        for (int r = 0; r < b.rows; r++) {
+            if (times[r] < fromUs) continue;
+            if (times[r] > toUs) return true;
+            if (!fn(times[r], rows.data() + size_t(r) * m_rowBytes)) return true;
+        }
+    }
+    return true;
+}
+
+double SeriesReader::numericValue(int column, const uint8_t* row) const {
+    const SeriesColumn& c = m_columns[column];
+    const uint8_t* p = row + m_colOffset[column];
+    switch (c.encoding) {
+    case SeriesEncoding::Signed:   return double(int64_t(loadInt(p, c.width, true)));
+    case SeriesEncoding::Unsigned: return double(loadInt(p, c.width, false));
+    case SeriesEncoding::Float:
+        if (c.width == 4) {
+            uint32_t u = qFromLittleEndian<uint32_t>(p);
+            float f;
+            memcpy(&f, &u, 4);
+            return double(f);
+        } else {
+            uint64_t u = qFromLittleEndian<uint64_t>(p);
+            double d;
+            memcpy(&d, &u, 8);
+            return d;
+        }
+    case SeriesEncoding::Raw:      break;
+    }
+    return std::numeric_limits<double>::quiet_NaN();
+}
+
+// ── Queries / export ──
+
+QVector<SeriesBucket> downsampleSeries(const SeriesReader& reader, int column,
+                                       qint64 fromUs, qint64 toUs, int buckets) {
+    QVector<SeriesBucket> out;
+    if (column < 0 || column >= reader.columns().size() || reader.rowCount() == 0) return out;
+    fromUs = qMax(fromUs, reader.firstUs());
+    toUs   = qMin(toUs, reader.lastUs());
+    if (toUs < fromUs) return out;
+    buckets = qBound(1, buckets, 100000);
+    const qint64 span = toUs - fromUs + 1;
+    out.resize(buckets);
+    for (int i = 0; i < buckets; i++) {
+        out[i].fromUs = fromUs + span * i / buckets;
+        out[i].toUs   = fromUs + span * (i + 1) / buckets - 1;
+    }
+    reader.forEachRow(fromUs, toUs, [&](qint64 t, const uint8_t* row) {
+        int i = int((t - fromUs) * buckets / span);
+        SeriesBucket& b = out[qBound(0, i, buckets - 1)];
+        double v = reader.numericValue(column, row);
+        if (b.count == 0) {
+            b.min = b.max = v;
+        } else {
+            b.min = qMin(b.min, v);
+            b.max = qMax(b.max, v);
+        }
+        b.last = v;
+        b.lastUs = t;
+        b.count++;
+        return true;
+    });
+    out.erase(std::remove_if(out.begin(), out.end(),
+                             [](const SeriesBucket& b) { return b.count == 0; }),
+              out.end());
+    return out;
+}
+
+bool exportSeriesCsv(const SeriesReader& reader, const QString& path,
+                     qint64 fromUs, qint64 toUs, QString* err) {
+    QFile f(path);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        if (err) *err = f.errorString();
+        return false;
+    }
+    QTextStream out(&f);
+    out << "time_us";
+    for (const auto& c : reader.columns()) {
+        QString name = c.name.isEmpty() ? QString::number(c.nodeId) : c.name;
+        if (name.contains(QLatin1Char(',')) || name.contains(QLatin1Char('"')))
+            name = QLatin1Char('"') + name.replace(QLatin1Char('"'), QStringLiteral("\"\""))
+                 + QLatin1Char('"');
+        out << ',' << name;
+    }
+    out << '\n';
+
+    const auto& cols = reader.columns();
+    bool ok = reader.forEachRow(fromUs, toUs, [&](qint64 t, const uint8_t* row) {
+        out << t;
+        for (int c = 0; c < cols.size(); c++) {
+            out << ',';
+            const uint8_t* p = reader.columnBytes(c, row);
+            switch (cols[c].encoding) {
+            case SeriesEncoding::Signed:
+                out << qint64(loadInt(p, cols[c].width, true));
+                break;
+            case SeriesEncoding::Unsigned:
+                out << quint64(loadInt(p, cols[c].width, false));
+                break;
+            case SeriesEncoding::Float:
+                out << QString::number(reader.numericValue(c, row), 'g',
+                                       cols[c].width == 4 ? 9 : 17);
+                break;
+            case SeriesEncoding::Raw:
+                out << QByteArray(reinterpret_cast<const char*>(p), cols[c].width).toHex();
+                break;
+            }
+        }
+        out << '\n';
+        return true;
+    });
+    out.flush();
+    if (!ok && err) *err = QStringLiteral("Failed to decode %1.").arg(path);
+    return ok && f.error() == QFileDevice::NoError;
+}
+
+// ── SeriesRecorder ──
+
+bool SeriesRecorder::start(const QString& path, const QVector<Field>& fields,
+                           QString* err) {
+    QMutexLocker lock(&m_mutex);
+    QVector<SeriesColumn> cols;
+    cols.reserve(fields.size());
+    int widest = 0;
+    for (const auto& fd : fields) {
+        cols.append(fd.column);
+        widest = qMax(widest, fd.column.width);
+    }
+    if (!m_writer.open(path, cols, err)) return false;
+    m_fields = fields;
+    m_path = path;
+    m_row.assign(m_writer.rowBytes(), 0);
+    m_scratch.assign(widest, 0);
+    return true;
+}
+
+void SeriesRecorder::sample(const Provider& prov, qint64 timeUs) {
+    QMutexLocker lock(&m_mutex);
+    if (!m_writer.isOpen()) return;
+    uint8_t* p = m_row.data();
+    for (const auto& fd : m_fields) {
+        const int w = fd.column.width;
+        if (prov.read(fd.addr, m_scratch.data(), w)) {
+            memcpy(p, m_scratch.data(), w);
+            if (fd.bigEndian && fd.column.encoding != SeriesEncoding::Raw)
+                std::reverse(p, p + w);
+        }
+        p += w;
+    }
+    m_writer.append(timeUs, m_row.data());
+}
+
+// ── SeriesRecordThread ──
+
+SeriesRecordThread::SeriesRecordThread(std::shared_ptr<SeriesRecorder> rec,
+                                       std::shared_ptr<Provider> prov,
+                                       qint64 intervalUs, qint64 epochUs)
+    : m_rec(std::move(rec))
+    , m_prov(std::move(prov))
+    , m_intervalUs(qMax<qint64>(1, intervalUs))
+    , m_epochUs(epochUs)
+{
+    m_thread = std::thread([this]() { run(); });
+}
+
+SeriesRecordThread::~SeriesRecordThread() {
+    {
+        std::lock_guard<std::mutex> lock(m_stopMutex);
+        m_stop = true;
+    }
+    m_stopCv.notify_all();
+    if (m_thread.joinable()) m_thread.join();
+}
+
+void SeriesRecordThread::run() {
+    using Clock = std::chrono::steady_clock;
+    const auto period = std::chrono::microseconds(m_intervalUs);
+    const auto start = Clock::now();
+    auto next = start;
+    std::unique_lock<std::mutex> lock(m_stopMutex);
+    while (!m_stop) {
+        lock.unlock();
+        const auto now = Clock::now();
+        try {
+            m_rec->sample(*m_prov, m_epochUs
+                + std::chrono::duration_cast<std::chrono::microseconds>(now - start).count());
+        } catch (const std::exception& e) {
+            qWarning() << "[Recorder] read threw:" << e.what();
+        } catch (...) {
+            qWarning() << "[Recorder] read threw unknown exception";
+        }
+        m_passCount.fetch_add(1, std::memory_order_relaxed);
+        // Same pacing as PageSampler: an overrun slot starts the next
+        // sample immediately instead of bursting to catch up.
+        next += period;
+        if (next < now) next = now;
+        lock.lock();
+        m_stopCv.wait_until(lock, next, [this]() { return m_stop; });
+    }
+}
+
+} // namespace rcx
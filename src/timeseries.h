@@ -0,0 +1,225 @@
+#pragma once
+#include <QFile>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rcx {
+
+class Provider;  // forward declaration
+
+// ── Columnar time-series recording (.rcxts) ──
+//
+// Append-only capture of a fixed set of watched fields: one timestamp column
+// plus one column per field. Rows are buffered into blocks of up to
+// kBlockRows; a full block is encoded column by column and written, and the
+// buffers are reused, so a recording of any length holds one block in
+// memory. Layout (little-endian):
+//
+//   header  "RCXTS\0", u16 version, u16 columnCount,
+//           per column: u64 nodeId, u8 encoding, u16 width, u16 nameLen, UTF-8 name
+//   block*  "BLK\0", u32 rows, i64 firstUs, i64 lastUs, u32 bodyBytes, body
+//   body    time column, then each field column, each prefixed by its u32 size
+//
+// The time column (µs since epoch) and integer columns are delta-encoded
+// against the previous row as zigzag varints, so an unchanged field or a
+// counter stepping by one costs one byte per sample. Float and raw columns
+// are stored at their fixed width. Deltas restart at every block, which
+// lets a reader skip blocks outside a time range by their header alone.
+
+enum class SeriesEncoding : uint8_t {
+    Signed,     // two's-complement integer, width 1..8
+    Unsigned,   // unsigned integer / hex / pointer, width 1..8
+    Float,      // IEEE float (width 4) or double (width 8)
+    Raw         // opaque bytes (vectors, strings)
+};
+
+struct SeriesColumn {
+    uint64_t       nodeId = 0;
+    QString        name;
+    SeriesEncoding encoding = SeriesEncoding::Raw;
+    int            width = 0;   // bytes per sample, 1..65535
+};
+
+class SeriesWriter {
+public:
+    static constexpr int kBlockRows = 4096;
+
+    SeriesWriter() = default;
+    ~SeriesWriter() { close(); }
+    SeriesWriter(const SeriesWriter&) = delete;
+    SeriesWriter& operator=(const SeriesWriter&) = delete;
+
+    // Truncates `path` and writes the header. False (with *err) on I/O
+    // failure or an empty / malformed column list.
+    bool open(const QString& path, const QVector<SeriesColumn>& columns,
+              QString* err = nullptr);
+
+    // `row` holds every column's little-endian bytes back to back, in
+    // column order (rowBytes() total).
+    void append(qint64 timeUs, const uint8_t* row);
+
+    // Writes the pending partial block so a reader sees every row so far.
+    bool flush();
+    void close();
+
+    bool    isOpen() const { return m_file.isOpen(); }
+    QString path() const { return m_file.fileName(); }
+    int     rowBytes() const { return m_rowBytes; }
+    qint64  rows() const { return m_rows; }
+    qint64  bytesWritten() const { return m_bytesWritten; }
+    const QVector<SeriesColumn>& columns() const { return m_columns; }
+
+private:
+    bool writeBlock();
+
+    QFile                 m_file;
+    QVector<SeriesColumn> m_columns;
+    QVector<int>          m_colOffset;   // byte offset of each column in a row
+    int                   m_rowBytes = 0;
+    int                   m_pending  = 0;
+    qint64                m_rows     = 0;
+    qint64                m_bytesWritten = 0;
+    bool                  m_failed   = false;
+    std::vector<qint64>   m_times;       // kBlockRows
+    std::vector<uint8_t>  m_block;       // kBlockRows * m_rowBytes, row-major
+    std::vector<uint8_t>  m_body;        // reused encode buffer
+};
+
+struct SeriesBlockInfo {
+    qint64 offset  = 0;   // file offset of the block body
+    int    rows    = 0;
+    qint64 firstUs = 0;
+    qint64 lastUs  = 0;
+    int    bodyBytes = 0;
+};
+
+// Reads a recording without loading it: open() walks only the block
+// headers; forEachRow() decodes one block at a time. A file that is still
+// being written can be opened after SeriesWriter::flush(); a torn trailing
+// block is ignored.
+class SeriesReader {
+public:
+    bool open(const QString& path, QString* err = nullptr);
+
+    const QVector<SeriesColumn>& columns() const { return m_columns; }
+    int    columnIndex(uint64_t nodeId) const;
+    int    rowBytes() const { return m_rowBytes; }
+    qint64 rowCount() const { return m_rowCount; }
+    qint64 firstUs() const { return m_blocks.isEmpty() ? 0 : m_blocks.first().firstUs; }
+    qint64 lastUs() const { return m_blocks.isEmpty() ? 0 : m_blocks.last().lastUs; }
+    const QVector<SeriesBlockInfo>& blocks() const { return m_blocks; }
+
+    // Calls fn(timeUs, row) for every row with fromUs <= time <= toUs, in
+    // order; `row` has the writer's layout. fn returns false to stop.
+    // Returns false on a read or decode error.
+    bool forEachRow(qint64 fromUs, qint64 toUs,
+                    const std::function<bool(qint64, const uint8_t*)>& fn) const;
+
+    // Column value as a double; NaN for Raw columns.
+    double numericValue(int column, const uint8_t* row) const;
+    const uint8_t* columnBytes(int column, const uint8_t* row) const {
+        return row + m_colOffset[column];
+    }
+
+private:
+    QString                  m_path;
+    QVector<SeriesColumn>    m_columns;
+    QVector<int>             m_colOffset;
+    int                      m_rowBytes = 0;
+    qint64                   m_rowCount = 0;
+    QVector<SeriesBlockInfo> m_blocks;
+};
+
+// One downsampling bucket: min / max / last of a column over the rows whose
+// time falls in [fromUs, toUs].
+struct SeriesBucket {
+    qint64 fromUs = 0;
+    qint64 toUs   = 0;
+    int    count  = 0;
+    double min = 0, max = 0, last = 0;
+    qint64 lastUs = 0;
+};
+
+// Splits [fromUs, toUs] into `buckets` equal spans and aggregates `column`
+// per span. Empty spans are omitted.
+QVector<SeriesBucket> downsampleSeries(const SeriesReader& reader, int column,
+                                       qint64 fromUs, qint64 toUs, int buckets);
+
+// Writes rows in [fromUs, toUs] as CSV: time_us, then one column per field
+// (numbers as decimal, raw columns as hex).
+bool exportSeriesCsv(const SeriesReader& reader, const QString& path,
+                     qint64 fromUs, qint64 toUs, QString* err = nullptr);
+
+// Samples fixed addresses from a provider into a SeriesWriter. Fields that
+// fail to read repeat their previous sample, so every row stays complete.
+// Thread-safe: a sampling thread and the UI may share one recorder.
+class SeriesRecorder {
+public:
+    struct Field {
+        SeriesColumn column;
+        uint64_t     addr = 0;
+        bool         bigEndian = false;   // swapped to little-endian on record
+    };
+
+    bool start(const QString& path, const QVector<Field>& fields,
+               QString* err = nullptr);
+    void sample(const Provider& prov, qint64 timeUs);
+    bool flush() { QMutexLocker lock(&m_mutex); return m_writer.flush(); }
+    void stop() { QMutexLocker lock(&m_mutex); m_writer.close(); }
+
+    bool    isRecording() const { QMutexLocker lock(&m_mutex); return m_writer.isOpen(); }
+    QString path() const { return m_path; }
+    qint64  rows() const { QMutexLocker lock(&m_mutex); return m_writer.rows(); }
+    qint64  bytesWritten() const { QMutexLocker lock(&m_mutex); return m_writer.bytesWritten(); }
+    const QVector<Field>& fields() const { return m_fields; }
+
+private:
+    mutable QMutex       m_mutex;
+    SeriesWriter         m_writer;
+    QVector<Field>       m_fields;
+    QString              m_path;
+    std::vector<uint8_t> m_row;
+    std::vector<uint8_t> m_scratch;   // widest field
+};
+
+// Drives a recorder from its own thread at a fixed interval, reading the
+// provider there, so a high-rate recording neither waits on the UI thread
+// nor stalls it with live reads. Timestamps count from `epochUs` (µs since
+// epoch) at construction.
+class SeriesRecordThread {
+public:
+    SeriesRecordThread(std::shared_ptr<SeriesRecorder> rec,
+                       std::shared_ptr<Provider> prov, qint64 intervalUs,
+                       qint64 epochUs);
+    ~SeriesRecordThread();   // stops and joins the thread
+    SeriesRecordThread(const SeriesRecordThread&) = delete;
+    SeriesRecordThread& operator=(const SeriesRecordThread&) = delete;
+
+    quint64 passCount() const { return m_passCount.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+
+    std::shared_ptr<SeriesRecorder> m_rec;
+    std::shared_ptr<Provider>       m_prov;
+    const qint64                    m_intervalUs;
+    const qint64                    m_epochUs;
+    std::atomic<quint64>            m_passCount{0};
+
+    // Stop wakes the thread out of its wait, however long the interval.
+    std::mutex                      m_stopMutex;
+    std::condition_variable         m_stopCv;
+    bool                            m_stop = false;
+    std::thread                     m_thread;   // last: starts once the rest is built
+};
+
+} // namespace rcx
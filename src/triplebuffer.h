@@ -0,0 +1,61 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Latest-value handoff between one producer thread and one consumer.
+//
+// Three slots: the producer fills back(), the consumer reads front(), and
+// the third sits in the middle holding the newest published value. Both
+// sides swap with the middle through one atomic exchange, so neither ever
+// waits on the other or copies a slot — a double buffer whose swap can't
+// stall the writer while the reader is still looking at the old frame.
+// The consumer sees only the newest value; values published in between
+// are overwritten, and publish() reports that so the producer can carry
+// anything they held into its next value.
+
+namespace rcx {
+
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Producer side. back() is the slot being filled; publish() hands it
+    // over and returns true when the value it replaced was never taken
+    // (back() is now that stale value — the producer's to reuse).
+    T& back() { return m_slots[m_back]; }
+    bool publish() {
+        const uint8_t prev = m_middle.exchange(uint8_t(m_back | kFresh),
+                                               std::memory_order_acq_rel);
+        m_back = prev & kIndex;
+        return prev & kFresh;
+    }
+
+    // Consumer side. take() moves the newest value into front() and
+    // returns true, or returns false when nothing was published since the
+    // last take (front() keeps the previous value).
+    bool take() {
+        if (!(m_middle.load(std::memory_order_relaxed) & kFresh))
+            return false;
+        const uint8_t prev = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front = prev & kIndex;
+        return true;
+    }
+    T& front() { return m_slots[m_front]; }
+
+    // Either side; stale as soon as it returns.
+    bool hasFresh() const { return m_middle.load(std::memory_order_acquire) & kFresh; }
+
+private:
+    static constexpr uint8_t kIndex = 3;
+    static constexpr uint8_t kFresh = 4;
+
+    T m_slots[3];
+    uint8_t m_back  = 0;   // producer-owned
+    uint8_t m_front = 1;   // consumer-owned
+    alignas(64) std::atomic<uint8_t> m_middle{2};
+};
+
+} // namespace rcx
@@ -11,8 +11,9 @@ private slots:
     void benchImportAll();
 };
 
-static const QString kPdbPath = QStringLiteral(
-    "C:/Symbols/ntkrnlmp.pdb/0762CF42EF7F3E8116EF7329ADAA09A31/ntkrnlmp.pdb");
+// $RCX_TEST_PDB overrides the path so non-Windows CI can point at a copy.
+static const QString kPdbPath = qEnvironmentVariable("RCX_TEST_PDB", QStringLiteral(
+    "C:/Symbols/ntkrnlmp.pdb/0762CF42EF7F3E8116EF7329ADAA09A31/ntkrnlmp.pdb"));
 
 void BenchImportPdb::benchEnumerateAll() {
     if (!QFile::exists(kPdbPath))
@@ -7,6 +7,7 @@
 #include <QtTest/QtTest>
 #include <QElapsedTimer>
 #include "core.h"
+#include "diffutil.h"
 #include "editor.h"
 #include "providers/buffer_provider.h"
 
@@ -71,6 +72,7 @@ private slots:
     void benchApplyDocument45K();
     void benchRemoveNode45K();
     void benchChangeKind45K();
+    void benchValueTick5K();
     void benchHoverHighlight();
     void benchSelectionOverlay();
     void benchHoverHighlightRepeated();
@@ -355,6 +357,71 @@ void BenchLargeClass::benchChangeKind45K()
     QVERIFY(true);
 }
 
+void BenchLargeClass::benchValueTick5K()
+{
+    // A live refresh tick where 10 of 5000 fields changed: full compose +
+    // whole-text diff vs. recomposeChanged + changed-line patch.
+    NodeTree tree = buildLargeTree(5000);
+    QByteArray buf(0x40000, '\0');
+    for (int i = 0; i < buf.size(); ++i) buf[i] = (char)(i & 0xFF);
+    BufferProvider prov(buf, QStringLiteral("bench_tick"));
+
+    RcxEditor editor;
+    editor.resize(800, 600);
+    ComposeResult result = rcx::compose(tree, prov);
+    editor.applyDocument(result);
+
+    // Every 500th field changes each tick.
+    auto mutate = [&](ChangeBitmap& changed, int tick) {
+        changed.clear();
+        for (int k = 0; k < 10; ++k) {
+            const Node& n = tree.nodes[1 + k * 500];
+            prov.data()[n.offset] = (char)(tick + k);
+            changed.set(n.offset);
+        }
+    };
+
+    const int ITERS = 200;
+    ChangeBitmap changed;
+    QElapsedTimer timer;
+    qint64 fullCompose = 0, fullApply = 0, incCompose = 0, incApply = 0;
+
+    for (int i = 0; i < ITERS; ++i) {
+        mutate(changed, i);
+        timer.start();
+        result = rcx::compose(tree, prov);
+        fullCompose += timer.nsecsElapsed();
+        timer.start();
+        editor.applyDocument(result);
+        fullApply += timer.nsecsElapsed();
+    }
+    int incremental = 0;
+    for (int i = 0; i < ITERS; ++i) {
+        mutate(changed, ITERS + i);
+        timer.start();
+        if (rcx::recomposeChanged(result, tree, prov, changed))
+            ++incremental;
+        else
+            result = rcx::compose(tree, prov);
+        incCompose += timer.nsecsElapsed();
+        timer.start();
+        editor.applyDocument(result);
+        incApply += timer.nsecsElapsed();
+    }
+
+    auto perTick = [&](qint64 ns) { return ns / 1e6 / ITERS; };
+    qDebug() << "";
+    qDebug() << "=== Value Tick Benchmark (5000 fields, 10 changing) ===";
+    qDebug() << "  Lines:" << result.meta.size();
+    qDebug() << "  Full compose:       " << perTick(fullCompose) << "ms/tick";
+    qDebug() << "  Full applyDocument: " << perTick(fullApply) << "ms/tick";
+    qDebug() << "  recomposeChanged:   " << perTick(incCompose) << "ms/tick"
+             << "(" << incremental << "/" << ITERS << "incremental)";
+    qDebug() << "  Patch applyDocument:" << perTick(incApply) << "ms/tick";
+    QCOMPARE(incremental, ITERS);
+    QCOMPARE(result.text, rcx::compose(tree, prov).text);
+}
+
 void BenchLargeClass::benchHoverHighlight()
 {
     RcxEditor editor;
@@ -5,6 +5,8 @@
  *   - Workspace model building
  *   - Workspace search filtering
  *   - JSON parsing vs model building breakdown
+ *   - Binary .rcxb load of the same project
+ *   - Tree walks over a loaded project: child index, validate
  */
 #include <QtTest/QtTest>
 #include <QElapsedTimer>
@@ -13,6 +15,7 @@
 #include <QSortFilterProxyModel>
 #include "core.h"
 #include "controller.h"
+#include "rcxb.h"
 #include "workspace_model.h"
 
 using namespace rcx;
@@ -26,6 +29,8 @@ private slots:
     void benchLoadWinSDK();
     void benchJsonParse();
     void benchNodeTreeFromJson();
+    void benchRcxbLoad();
+    void benchTreeWalks();
     void benchBuildWorkspaceModel();
     void benchWorkspaceSearch();
 };
@@ -185,6 +190,101 @@ void BenchProject::benchNodeTreeFromJson()
     QVERIFY(true);
 }
 
+// ── Binary project: the same tree from .rcxb records ──
+
+void BenchProject::benchRcxbLoad()
+{
+    QString path = findExample("Vergilius_25H2.rcx");
+    if (path.isEmpty()) path = findExample("WinSDK.rcx");
+    if (path.isEmpty()) { QSKIP("No large .rcx found"); return; }
+
+    NodeTree source;
+    QVERIFY(loadRcx(path, source));
+    const QByteArray bin = encodeRcxb(source);
+
+    const int ITERS = 5;
+    QElapsedTimer timer;
+    timer.start();
+    NodeTree tree;
+    for (int i = 0; i < ITERS; ++i) {
+        RcxbReader reader;
+        QVERIFY(reader.openBytes(bin));
+        tree = reader.readTree();
+    }
+    qint64 loadMs = timer.elapsed();
+    QCOMPARE(tree.nodes.size(), source.nodes.size());
+
+    // One class out of the index, the way a lazy consumer would.
+    RcxbReader reader;
+    QVERIFY(reader.openBytes(bin));
+    timer.start();
+    int classNodes = 0;
+    for (int i = 0; i < ITERS; ++i)
+        classNodes = reader.readClass(reader.classCount() / 2).size();
+    qint64 classUs = timer.nsecsElapsed() / 1000;
+
+    qDebug() << "";
+    qDebug() << "=== .rcxb Load ===" << QFileInfo(path).fileName();
+    qDebug() << "  JSON:" << QFileInfo(path).size() / 1024 << "KB, rcxb:"
+             << bin.size() / 1024 << "KB," << tree.nodes.size() << "nodes,"
+             << reader.classCount() << "classes";
+    qDebug() << "  Full tree:" << (double)loadMs / ITERS << "ms/iter";
+    qDebug() << "  One class (" << classNodes << "nodes):"
+             << (double)classUs / ITERS << "us/iter";
+}
+
+// ── Tree walks: child index and validate on a loaded project ──
+
+void BenchProject::benchTreeWalks()
+{
+    QString path = findExample("Vergilius_25H2.rcx");
+    if (path.isEmpty()) path = findExample("WinSDK.rcx");
+    if (path.isEmpty()) { QSKIP("No large .rcx found"); return; }
+
+    NodeTree tree;
+    QVERIFY(loadRcx(path, tree));
+
+    const int ITERS = 20;
+    QElapsedTimer timer;
+
+    // Build the child index from scratch and visit every row.
+    timer.start();
+    qint64 visited = 0;
+    for (int i = 0; i < ITERS; ++i) {
+        tree.invalidateIdCache();
+        for (const Node& n : tree.nodes)
+            visited += tree.children(n.id).size();
+    }
+    qint64 indexMs = timer.elapsed();
+
+    // Importer pattern: append under one parent, ask for its children.
+    timer.start();
+    NodeTree grown = tree;
+    const uint64_t parent = grown.nodes[grown.children(0)[0]].id;
+    for (int i = 0; i < 10000; ++i) {
+        Node n;
+        n.parentId = parent;
+        n.offset = i * 4;
+        grown.addNode(n);
+        QVERIFY(!grown.children(parent).isEmpty());
+    }
+    qint64 growMs = timer.elapsed();
+
+    timer.start();
+    NodeTree::ValidateReport report;
+    for (int i = 0; i < ITERS; ++i)
+        report = tree.validate(false);
+    qint64 validateMs = timer.elapsed();
+
+    qDebug() << "";
+    qDebug() << "=== Tree Walks ===" << QFileInfo(path).fileName()
+             << tree.nodes.size() << "nodes";
+    qDebug() << "  Child index build + full walk:" << (double)indexMs / ITERS << "ms/iter,"
+             << visited / ITERS << "children";
+    qDebug() << "  10000 addNode + children():" << growMs << "ms";
+    qDebug() << "  validate():" << (double)validateMs / ITERS << "ms/iter," << report.summary();
+}
+
 // ── Workspace model building ──
 
 void BenchProject::benchBuildWorkspaceModel()
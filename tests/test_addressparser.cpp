@@ -4,6 +4,7 @@
 using rcx::AddressParser;
 using rcx::AddressParserCallbacks;
 using rcx::AddressParseResult;
+using rcx::AddressProgram;
 
 class TestAddressParser : public QObject {
     Q_OBJECT
@@ -406,6 +407,66 @@ private slots:
         QCOMPARE(r.value, 0x1400000DEULL);
     }
 
+    // -- Compiled programs --
+
+    void compiledRerunFollowsChain() {
+        int moduleLookups = 0;
+        uint64_t object = 0x500000;
+        AddressParserCallbacks cbs;
+        cbs.resolveModule = [&](const QString& name, bool* ok) -> uint64_t {
+            ++moduleLookups;
+            *ok = (name == "game.exe");
+            return *ok ? 0x140000000ULL : 0;
+        };
+        cbs.readPointer = [&](uint64_t addr, bool* ok) -> uint64_t {
+            *ok = true;
+            if (addr == 0x1400001A0ULL) return object;
+            return addr == object + 0x30 ? 0x7000 : 0;
+        };
+
+        AddressProgram prog = AddressParser::compile("[[<game.exe>+0x1A0]+0x30]");
+        QVERIFY(prog.ok());
+        QVERIFY(prog.dereferences());
+        QVERIFY(!prog.usesPaging());
+        QVERIFY(prog.bindNames(cbs));
+        QCOMPARE(moduleLookups, 1);
+
+        QVector<uint64_t> derefs;
+        auto r = prog.run(&cbs, &derefs);
+        QVERIFY(r.ok);
+        QCOMPARE(r.value, 0x7000ULL);
+        QCOMPARE(derefs, (QVector<uint64_t>{0x1400001A0ULL, 0x500030}));
+
+        // The object moves: the same program follows it, and the bound
+        // module base isn't looked up again.
+        object = 0x900000;
+        derefs.clear();
+        r = prog.run(&cbs, &derefs);
+        QVERIFY(r.ok);
+        QCOMPARE(derefs.last(), 0x900030ULL);
+        QCOMPARE(moduleLookups, 1);
+        QCOMPARE(r.value, AddressParser::evaluate("[[<game.exe>+0x1A0]+0x30]", 8, &cbs).value);
+    }
+
+    void compiledErrors() {
+        AddressProgram bad = AddressParser::compile("[0x1000");
+        QVERIFY(!bad.ok());
+        QVERIFY(bad.error().contains("']'"));
+        QVERIFY(!bad.run().ok);
+
+        AddressProgram prog = AddressParser::compile("<nope.dll> + 8");
+        QVERIFY(prog.ok());
+        QVERIFY(!prog.dereferences());
+        AddressParserCallbacks cbs;
+        cbs.resolveModule = [](const QString&, bool* ok) -> uint64_t { *ok = false; return 0; };
+        QString err;
+        QVERIFY(!prog.bindNames(cbs, &err));
+        QVERIFY(err.contains("not found"));
+        QVERIFY(!prog.namesBound());
+        QVERIFY(AddressParser::compile("vtop(4, 0x1000)").usesPaging());
+        QVERIFY(!AddressParser::compile("0x100 / 0").run().ok);
+    }
+
     // -- Validate with new syntax --
 
     void validateIdentifier() {
@@ -2,6 +2,7 @@
 #include <QJsonDocument>
 #include <QFile>
 #include "core.h"
+#include "diffutil.h"
 
 using namespace rcx;
 
@@ -2990,6 +2991,238 @@ private slots:
         }
         QVERIFY2(found, "rvaField line not found in compose output");
     }
+
+    // ── recomposeChanged: value-only ticks patch rows in place ──
+
+    static NodeTree valueTickTree(uint64_t* ptrTargetId = nullptr) {
+        NodeTree tree;
+        tree.baseAddress = 0;
+
+        Node root;
+        root.kind = NodeKind::Struct;
+        root.structTypeName = "Tick";
+        root.name = "tick";
+        root.collapsed = false;
+        uint64_t rootId = tree.nodes[tree.addNode(root)].id;
+
+        auto add = [&](NodeKind k, const char* name, int off) -> Node& {
+            Node n;
+            n.kind = k;
+            n.name = name;
+            n.parentId = rootId;
+            n.offset = off;
+            n.collapsed = false;
+            return tree.nodes[tree.addNode(n)];
+        };
+        add(NodeKind::Int32,  "counter", 0x00);
+        add(NodeKind::Float,  "speed",   0x04);
+        add(NodeKind::Hex64,  "raw",     0x08);
+        add(NodeKind::UInt64, "ticks",   0x10);
+        Node& arr = add(NodeKind::Array, "samples", 0x18);
+        arr.elementKind = NodeKind::UInt16;
+        arr.arrayLen = 6;
+        add(NodeKind::Int32,  "tail",    0x30);
+        if (ptrTargetId) {
+            Node target;
+            target.kind = NodeKind::Struct;
+            target.structTypeName = "Other";
+            target.name = "other";
+            target.collapsed = true;
+            *ptrTargetId = tree.nodes[tree.addNode(target)].id;
+            Node& p = add(NodeKind::Pointer64, "next", 0x38);
+            p.refId = *ptrTargetId;
+        }
+        return tree;
+    }
+
+    void testRecomposeChangedMatchesFullCompose() {
+        for (int mode = 0; mode < 4; ++mode) {
+            const bool compact = mode & 1, treeLines = mode & 2;
+            NodeTree tree = valueTickTree();
+            QByteArray before(0x40, '\0');
+            for (int i = 0; i < before.size(); ++i) before[i] = char(i * 7);
+            BufferProvider oldProv(before);
+            ComposeResult result = compose(tree, oldProv, 0, compact, treeLines);
+
+            // Widen the counter (longer text) and touch one array element;
+            // speed / raw / ticks / tail keep their bytes.
+            QByteArray after = before;
+            const int32_t counter = -1234567;
+            memcpy(after.data() + 0x00, &counter, 4);
+            after[0x1A] = char(0xFF);
+            BufferProvider newProv(after);
+
+            ChangeBitmap changed;
+            diffPageInto(changed, 0, before.constData(), after.constData(), before.size());
+            const uint64_t baseRev = result.revision;
+            QVERIFY(recomposeChanged(result, tree, newProv, changed, compact));
+
+            ComposeResult full = compose(tree, newProv, 0, compact, treeLines);
+            QCOMPARE(result.text, full.text);
+            QCOMPARE(result.lineStarts, full.lineStarts);
+            QCOMPARE(result.meta.size(), full.meta.size());
+            for (int i = 0; i < full.meta.size(); ++i) {
+                QCOMPARE(result.meta[i].nodeId, full.meta[i].nodeId);
+                QCOMPARE(result.meta[i].effectiveTypeW, full.meta[i].effectiveTypeW);
+                QCOMPARE(result.meta[i].chips.size(), full.meta[i].chips.size());
+            }
+            QCOMPARE(result.baseRevision, baseRev);
+            QVERIFY(result.revision != baseRev);
+
+            // Exactly the counter row and the one array element row.
+            QStringList lines = full.text.split('\n');
+            int rows = 0;
+            for (const auto& r : result.changedLines) {
+                for (int l = r.first; l <= r.second; ++l) {
+                    QVERIFY2(lines[l].contains("counter") || lines[l].contains("[1]"),
+                             qPrintable(lines[l]));
+                    ++rows;
+                }
+            }
+            QCOMPARE(rows, 2);
+        }
+    }
+
+    void testRecomposeChangedAtNonZeroBase() {
+        // The page diff records absolute addresses; a live target's struct
+        // sits far from 0, so rows must be matched by address, not offset.
+        NodeTree tree = valueTickTree();
+        tree.baseAddress = 0x2000;
+        QByteArray before(0x2040, '\0');
+        BufferProvider oldProv(before);
+        ComposeResult result = compose(tree, oldProv);
+
+        QByteArray after = before;
+        const int32_t counter = 77;
+        memcpy(after.data() + 0x2000, &counter, 4);
+        BufferProvider newProv(after);
+
+        ChangeBitmap changed;
+        diffPageInto(changed, 0, before.constData(), after.constData(), before.size());
+        QVERIFY(recomposeChanged(result, tree, newProv, changed));
+        QCOMPARE(result.text, compose(tree, newProv).text);
+        QCOMPARE(result.changedLines.size(), 1);
+    }
+
+    void testRecomposeChangedNoopWhenBytesOutsideView() {
+        NodeTree tree = valueTickTree();
+        QByteArray buf(0x40, '\0');
+        BufferProvider prov(buf);
+        ComposeResult result = compose(tree, prov);
+        const QString text = result.text;
+
+        ChangeBitmap changed;
+        changed.set(0x4000);   // far past the struct
+        QVERIFY(recomposeChanged(result, tree, prov, changed));
+        QCOMPARE(result.text, text);
+        QVERIFY(result.changedLines.isEmpty());
+    }
+
+    void testRecomposeChangedRefusesPointerValueChange() {
+        // A typed pointer's value decides what expands beneath it, so a
+        // change to it must fall back to a full compose.
+        uint64_t targetId = 0;
+        NodeTree tree = valueTickTree(&targetId);
+        QByteArray before(0x40, '\0');
+        QByteArray after = before;
+        after[0x38] = 0x10;
+        BufferProvider newProv(after);
+        BufferProvider oldProv(before);
+        ComposeResult result = compose(tree, oldProv);
+        const uint64_t rev = result.revision;
+        const QString text = result.text;
+
+        ChangeBitmap changed;
+        diffPageInto(changed, 0, before.constData(), after.constData(), before.size());
+        QVERIFY(!recomposeChanged(result, tree, newProv, changed));
+        QCOMPARE(result.revision, rev);
+        QCOMPARE(result.text, text);
+    }
+
+    // ── ComposeWindow: huge containers compose placeholders off-window ──
+
+    static void checkWindowedMatchesFull(const NodeTree& tree, const Provider& prov,
+                                         ComposeWindow window) {
+        ComposeResult full = compose(tree, prov);
+        ComposeResult virt = compose(tree, prov, 0, false, false, false, false, true,
+                                     {}, true, true, nullptr, window);
+        QCOMPARE(full.placeholderLines, 0);
+        QVERIFY(virt.placeholderLines > 0);
+        QCOMPARE(virt.meta.size(), full.meta.size());
+        const QStringList fullLines = full.text.split('\n');
+        const QStringList virtLines = virt.text.split('\n');
+        int placeholders = 0;
+        for (int i = 0; i < full.meta.size(); ++i) {
+            const LineMeta& v = virt.meta[i];
+            QCOMPARE(v.foldLevel, full.meta[i].foldLevel);
+            QCOMPARE(v.nodeId, full.meta[i].nodeId);
+            QCOMPARE(v.offsetAddr, full.meta[i].offsetAddr);
+            if (i >= window.first && i <= window.last) {
+                QVERIFY(!v.isPlaceholder);
+                QCOMPARE(virtLines[i], fullLines[i]);
+            }
+            if (v.isPlaceholder) {
+                ++placeholders;
+                QVERIFY(virtLines[i].trimmed().isEmpty());
+            }
+        }
+        QCOMPARE(placeholders, virt.placeholderLines);
+    }
+
+    void testWindowVirtualizesHugePrimitiveArray() {
+        NodeTree tree;
+        Node root;
+        root.kind = NodeKind::Struct;
+        root.name = "root";
+        root.collapsed = false;
+        uint64_t rootId = tree.nodes[tree.addNode(root)].id;
+        Node arr;
+        arr.kind = NodeKind::Array;
+        arr.name = "entities";
+        arr.parentId = rootId;
+        arr.elementKind = NodeKind::UInt32;
+        arr.arrayLen = 20000;
+        arr.collapsed = false;
+        tree.addNode(arr);
+
+        QByteArray buf(80000, '\0');
+        for (int i = 0; i < buf.size(); ++i) buf[i] = char(i * 13);
+        BufferProvider prov(buf);
+        checkWindowedMatchesFull(tree, prov, {0, 200});
+        checkWindowedMatchesFull(tree, prov, {9000, 9400});
+    }
+
+    void testWindowVirtualizesHugeLeafStruct() {
+        // A 64 KB hex region: 8192 Hex64 rows.
+        NodeTree tree;
+        Node root;
+        root.kind = NodeKind::Struct;
+        root.name = "page";
+        root.collapsed = false;
+        uint64_t rootId = tree.nodes[tree.addNode(root)].id;
+        for (int i = 0; i < 8192; ++i) {
+            Node n;
+            n.kind = NodeKind::Hex64;
+            n.name = QStringLiteral("h%1").arg(i);
+            n.parentId = rootId;
+            n.offset = i * 8;
+            tree.addNode(n);
+        }
+        QByteArray buf(0x10000, '\0');
+        for (int i = 0; i < buf.size(); ++i) buf[i] = char(i * 31);
+        BufferProvider prov(buf);
+        checkWindowedMatchesFull(tree, prov, {4000, 4300});
+    }
+
+    void testWindowLeavesSmallContainersAlone() {
+        NodeTree tree = valueTickTree();
+        QByteArray buf(0x40, '\0');
+        BufferProvider prov(buf);
+        ComposeResult r = compose(tree, prov, 0, false, false, false, false, true,
+                                  {}, true, true, nullptr, ComposeWindow{0, 1});
+        QCOMPARE(r.placeholderLines, 0);
+        QCOMPARE(r.text, compose(tree, prov).text);
+    }
 };
 
 QTEST_MAIN(TestCompose)
@@ -2,6 +2,7 @@
 #include <QtTest/QSignalSpy>
 #include <QApplication>
 #include <QSplitter>
+#include <QTemporaryDir>
 #include <QTemporaryFile>
 #include <QMouseEvent>
 #include <QKeyEvent>
@@ -81,6 +82,9 @@ static QByteArray makeSmallBuffer() {
     return data;
 }
 
+// Seeds a ValueHistory with a 4-byte value, as the refresh tick records one.
+static void recordU32(ValueHistory& h, uint32_t v) { h.record(&v, sizeof v); }
+
 class TestController : public QObject {
     Q_OBJECT
 private:
@@ -148,6 +152,160 @@ private slots:
         delete doc2;
     }
 
+    // ── .rcxb loads defer class bodies ──
+    // Only the roots are decoded at load; opening a class decodes it and
+    // the classes it references, and a save writes the whole project.
+    void testRcxbLoadDefersClassBodies() {
+        RcxDocument doc;
+        auto addClass = [&](const char* type, uint64_t refId) {
+            Node root; root.kind = NodeKind::Struct; root.name = type;
+            root.structTypeName = type;
+            const uint64_t id = doc.tree.nodes[doc.tree.addNode(root)].id;
+            Node f; f.kind = refId ? NodeKind::Pointer64 : NodeKind::UInt32;
+            f.name = "f"; f.parentId = id; f.refId = refId;
+            doc.tree.addNode(f);
+            return id;
+        };
+        const uint64_t leaf = addClass("Leaf", 0);
+        const uint64_t mid = addClass("Mid", leaf);
+        addClass("Other", 0);
+
+        QTemporaryDir dir;
+        const QString path = dir.filePath("lazy.rcxb");
+        QVERIFY(doc.save(path));
+
+        RcxDocument back;
+        QVERIFY(back.load(path));
+        QVERIFY(back.hasDeferredClasses());
+        QCOMPARE(back.tree.nodes.size(), 3);   // roots only
+
+        QVERIFY(back.ensureClassLoaded(mid));
+        QCOMPARE(back.tree.nodes.size(), 5);   // Mid, and Leaf through its pointer
+        QCOMPARE(back.tree.childrenOf(leaf).size(), 1);
+        QVERIFY(back.hasDeferredClasses());    // Other waits for the drain
+
+        const QString copy = dir.filePath("copy.rcxb");
+        QVERIFY(back.save(copy));
+        QVERIFY(!back.hasDeferredClasses());
+        QCOMPARE(back.tree.nodes.size(), doc.tree.nodes.size());
+        RcxDocument again;
+        QVERIFY(again.load(copy));
+        again.ensureFullyLoaded();
+        QCOMPARE(again.tree.nodes.size(), doc.tree.nodes.size());
+    }
+
+    // ── Background save, journal, crash recovery ──
+    // saveInBackground marks the doc saved at the snapshot and writes on the
+    // pool; later edits go to "<file>.journal", and a fresh load plus a
+    // journal replay reproduces them. A full save folds the journal away.
+    void testBackgroundSaveAndJournalReplay() {
+        QTemporaryFile f;
+        QVERIFY(f.open());
+        const QString path = f.fileName();
+        const QString journalPath = path + QStringLiteral(".journal");
+        f.close();
+
+        m_doc->saveInBackground(path);
+        QVERIFY(!m_doc->modified);
+        QVERIFY(m_doc->waitForSave());
+        QVERIFY(!m_doc->isSaving());
+
+        const uint64_t rootId = m_doc->tree.nodes[0].id;
+        const uint64_t u32Id = m_doc->tree.nodes[1].id;
+        Node added;
+        added.id = m_doc->tree.reserveId();
+        added.kind = NodeKind::Hex32;
+        added.name = QStringLiteral("tail");
+        added.parentId = rootId;
+        added.offset = 16;
+        m_doc->undoStack.push(new RcxCommand(m_ctrl,
+            cmd::Rename{u32Id, QStringLiteral("field_u32"), QStringLiteral("hp")}));
+        m_doc->undoStack.push(new RcxCommand(m_ctrl, cmd::Insert{added, {}}));
+        m_doc->undoStack.push(new RcxCommand(m_ctrl,
+            cmd::Collapse{rootId, false, true}));
+        m_doc->undoStack.undo();   // journaled too
+        QVERIFY(m_doc->modified);
+        QCOMPARE(CommandJournal::read(journalPath).size(), 4);
+
+        // "Crash": reload the saved file and replay.
+        auto* doc2 = new RcxDocument();
+        QVERIFY(doc2->load(path));
+        QCOMPARE(doc2->m_loadJournalSeq, uint64_t(0));
+        auto* ctrl2 = new RcxController(doc2, nullptr);
+        QCOMPARE(ctrl2->replayJournal(CommandJournal::read(journalPath)), 4);
+        QVERIFY(doc2->modified);
+        QCOMPARE(doc2->tree.nodes.size(), m_doc->tree.nodes.size());
+        QCOMPARE(doc2->tree.nodes[doc2->tree.indexOfId(u32Id)].name, QStringLiteral("hp"));
+        QVERIFY(doc2->tree.indexOfId(added.id) >= 0);
+        QCOMPARE(doc2->tree.nodes[doc2->tree.indexOfId(rootId)].collapsed, false);
+        delete ctrl2;
+        delete doc2;
+
+        // An autosave shadow records the seq it covers and compacts the
+        // journal past it.
+        QVERIFY(m_doc->autosaveInBackground());
+        QVERIFY(m_doc->waitForSave());
+        QVERIFY(m_doc->modified);
+        QVERIFY(!QFile::exists(journalPath));
+        auto* shadow = new RcxDocument();
+        QVERIFY(shadow->load(path + QStringLiteral(".autosave")));
+        QCOMPARE(shadow->m_loadJournalSeq, m_doc->journal.seq());
+        QVERIFY(shadow->tree.indexOfId(added.id) >= 0);
+        delete shadow;
+
+        // An explicit save drops both recovery files.
+        QVERIFY(m_doc->save(path));
+        QVERIFY(!QFile::exists(path + QStringLiteral(".autosave")));
+        QVERIFY(!QFile::exists(journalPath));
+    }
+
+    // A full save is stamped with the journal seq it covers, so a journal a
+    // crash left uncompacted replays only the edits made after it; a journal
+    // reopened on that file numbers on from the stamp. Bookmarks bypass the
+    // journal and keep the doc owing a shadow until one is written.
+    void testFullSaveStampsJournalSeq() {
+        QTemporaryFile f;
+        QVERIFY(f.open());
+        const QString path = f.fileName();
+        const QString journalPath = path + QStringLiteral(".journal");
+        f.close();
+
+        m_doc->saveInBackground(path);
+        QVERIFY(m_doc->waitForSave());
+        const uint64_t u32Id = m_doc->tree.nodes[1].id;
+        m_doc->undoStack.push(new RcxCommand(m_ctrl,
+            cmd::Rename{u32Id, QStringLiteral("field_u32"), QStringLiteral("hp")}));
+        m_doc->undoStack.push(new RcxCommand(m_ctrl,
+            cmd::Rename{u32Id, QStringLiteral("hp"), QStringLiteral("mp")}));
+        const uint64_t savedSeq = m_doc->journal.seq();
+        m_doc->saveInBackground(path);
+        QVERIFY(m_doc->waitForSave());
+        m_doc->undoStack.push(new RcxCommand(m_ctrl,
+            cmd::Rename{u32Id, QStringLiteral("mp"), QStringLiteral("sp")}));
+
+        auto* doc2 = new RcxDocument();
+        QVERIFY(doc2->load(path));
+        QCOMPARE(doc2->m_loadJournalSeq, savedSeq);
+        const auto entries = CommandJournal::read(journalPath, doc2->m_loadJournalSeq);
+        QCOMPARE(entries.size(), 1);
+        QCOMPARE(entries[0].seq, savedSeq + 1);
+        doc2->journal.open(journalPath + QStringLiteral(".2"), doc2->m_loadJournalSeq);
+        QCOMPARE(doc2->journal.seq(), savedSeq);
+        delete doc2;
+
+        QVERIFY(m_doc->save(path));
+        QVERIFY(!m_doc->hasUnjournaledEdits());
+        m_ctrl->addBookmark(QStringLiteral("player"), QStringLiteral("0x1000"));
+        QVERIFY(m_doc->modified);
+        QVERIFY(m_doc->hasUnjournaledEdits());
+        QVERIFY(!QFile::exists(journalPath));
+        QVERIFY(m_doc->autosaveInBackground());
+        QVERIFY(m_doc->waitForSave());
+        QVERIFY(!m_doc->hasUnjournaledEdits());
+        QVERIFY(m_doc->modified);
+        QFile::remove(path + QStringLiteral(".autosave"));
+    }
+
     // ── Test: setNodeValue writes bytes to provider ──
     void testSetNodeValueWritesData() {
         // Find field_u32 (index 1, child of root at index 0)
@@ -628,9 +786,9 @@ private slots:
         uint64_t nodeId = tree.nodes[idx].id;
 
         QHash<uint64_t, ValueHistory> history;
-        history[nodeId].record("100");
-        history[nodeId].record("200");
-        history[nodeId].record("300");
+        recordU32(history[nodeId], 100);
+        recordU32(history[nodeId], 200);
+        recordU32(history[nodeId], 300);
         QVERIFY(history[nodeId].uniqueCount() > 1);
 
         m_editor->setValueHistoryRef(&history);
@@ -717,17 +875,17 @@ private slots:
         // Seed value history for shifted siblings (simulate accumulated heat)
         auto& history = const_cast<QHash<uint64_t, ValueHistory>&>(m_ctrl->valueHistory());
         for (uint64_t id : shiftedIds) {
-            history[id].record("old_val_1");
-            history[id].record("old_val_2");
-            history[id].record("old_val_3");
+            recordU32(history[id], 1);
+            recordU32(history[id], 2);
+            recordU32(history[id], 3);
             QVERIFY2(history[id].heatLevel() >= 2,
                      qPrintable(QString("Pre-delete: %1 should have heat>=2")
                                 .arg(nameMap[id])));
         }
 
         // Also seed the to-be-deleted node
-        history[delId].record("del_1");
-        history[delId].record("del_2");
+        recordU32(history[delId], 1);
+        recordU32(history[delId], 2);
         QVERIFY(history.contains(delId));
 
         // Delete field_u32 — this shifts all subsequent siblings
@@ -752,44 +910,46 @@ private slots:
 
     // ── Test: value history records and cycles correctly ──
     void testValueHistoryRingBuffer() {
-        ValueHistory vh;
+        ValueHistory vh(10);
         QCOMPARE(vh.count, 0);
         QCOMPARE(vh.heatLevel(), 0);
 
-        vh.record("10");
+        recordU32(vh, 10);
         QCOMPARE(vh.count, 1);
         QCOMPARE(vh.heatLevel(), 0);  // 1 unique = static
 
         // Duplicate should not increase count
-        vh.record("10");
+        recordU32(vh, 10);
         QCOMPARE(vh.count, 1);
 
-        vh.record("20");
+        recordU32(vh, 20);
         QCOMPARE(vh.count, 2);
         QCOMPARE(vh.heatLevel(), 1);  // cold
 
-        vh.record("30");
+        recordU32(vh, 30);
         QCOMPARE(vh.count, 3);
         QCOMPARE(vh.heatLevel(), 2);  // warm
 
-        vh.record("40");
-        vh.record("50");
+        recordU32(vh, 40);
+        recordU32(vh, 50);
         QCOMPARE(vh.count, 5);
         QCOMPARE(vh.heatLevel(), 3);  // hot
 
-        QCOMPARE(vh.last(), QString("50"));
+        Node u32;
+        u32.kind = NodeKind::UInt32;
+        QCOMPARE(fmt::historyValue(u32, vh.at(0)), fmt::fmtUInt32(50));
 
-        // Ring buffer: uniqueCount() caps at kCapacity
+        // Ring buffer: uniqueCount() caps at capacity
         for (int i = 0; i < 20; i++)
-            vh.record(QString::number(100 + i));
-        QCOMPARE(vh.uniqueCount(), ValueHistory::kCapacity);
-        QVERIFY(vh.count > ValueHistory::kCapacity);
+            recordU32(vh, 100 + i);
+        QCOMPARE(vh.uniqueCount(), vh.capacity());
+        QVERIFY(vh.count > vh.capacity());
 
         // forEach iterates oldest→newest within ring
         QStringList vals;
-        vh.forEach([&](const QString& v) { vals.append(v); });
-        QCOMPARE(vals.size(), ValueHistory::kCapacity);
-        QCOMPARE(vals.last(), vh.last());
+        vh.forEach([&](const ValueHistory::Sample& s) { vals.append(fmt::historyValue(u32, s)); });
+        QCOMPARE(vals.size(), vh.capacity());
+        QCOMPARE(vals.last(), fmt::historyValue(u32, vh.at(0)));
     }
     // ── Test: inline edit "int32_t[4]" on primitive converts to array ──
     void testInlineEditPrimitiveArray() {
@@ -840,9 +1000,9 @@ private slots:
 
         // Seed value history with multiple changes to get heat > 0
         auto& history = const_cast<QHash<uint64_t, ValueHistory>&>(m_ctrl->valueHistory());
-        history[targetId].record("val_1");
-        history[targetId].record("val_2");
-        history[targetId].record("val_3");
+        recordU32(history[targetId], 1);
+        recordU32(history[targetId], 2);
+        recordU32(history[targetId], 3);
         QVERIFY2(history[targetId].heatLevel() >= 2,
                  "Pre-clear: should have heat >= 2 (warm)");
 
@@ -1510,8 +1670,8 @@ private slots:
 
     void testValueHistoryClear() {
         ValueHistory vh;
-        vh.record(QStringLiteral("1"));
-        vh.record(QStringLiteral("2"));
+        recordU32(vh, 1);
+        recordU32(vh, 2);
         QCOMPARE(vh.uniqueCount(), 2);
         vh.clear();
         QCOMPARE(vh.uniqueCount(), 0);
@@ -746,92 +746,173 @@ private slots:
 
     // ── ValueHistory tests ──
 
+    static bool rec(rcx::ValueHistory& h, int32_t v) { return h.record(&v, 4); }
+    static int32_t sampleI32(const rcx::ValueHistory::Sample& s) {
+        int32_t v; memcpy(&v, s.bytes, 4); return v;
+    }
+
     void testValueHistory_empty() {
         rcx::ValueHistory h;
         QCOMPARE(h.heatLevel(), 0);
         QCOMPARE(h.uniqueCount(), 0);
-        QCOMPARE(h.last(), QString());
+        QCOMPARE(h.capacity(), rcx::ValueHistory::defaultCapacity());
     }
 
     void testValueHistory_singleValue() {
         rcx::ValueHistory h;
-        h.record("42");
+        QVERIFY(rec(h, 42));
         QCOMPARE(h.heatLevel(), 0);  // only 1 unique → static
         QCOMPARE(h.uniqueCount(), 1);
-        QCOMPARE(h.last(), QString("42"));
+        QCOMPARE(h.width(), 4);
+        QCOMPARE(sampleI32(h.at(0)), 42);
     }
 
     void testValueHistory_duplicateIgnored() {
         rcx::ValueHistory h;
-        h.record("42");
-        h.record("42");
-        h.record("42");
+        rec(h, 42);
+        QVERIFY(!rec(h, 42));
+        QVERIFY(!rec(h, 42));
         QCOMPARE(h.count, 1);
         QCOMPARE(h.heatLevel(), 0);
     }
 
     void testValueHistory_heatLevels() {
         rcx::ValueHistory h;
-        h.record("a");
+        rec(h, 1);
         QCOMPARE(h.heatLevel(), 0);  // 1 unique
 
-        h.record("b");
+        rec(h, 2);
         QCOMPARE(h.heatLevel(), 1);  // 2 unique → cold
 
-        h.record("c");
+        rec(h, 3);
         QCOMPARE(h.heatLevel(), 2);  // 3 unique → warm
 
-        h.record("d");
+        rec(h, 4);
         QCOMPARE(h.heatLevel(), 2);  // 4 unique → warm
 
-        h.record("e");
+        rec(h, 5);
         QCOMPARE(h.heatLevel(), 3);  // 5 unique → hot
     }
 
     void testValueHistory_ringWrap() {
-        rcx::ValueHistory h;
+        rcx::ValueHistory h(10);
         // Fill beyond capacity
         for (int i = 0; i < 15; i++)
-            h.record(QString::number(i));
+            rec(h, i);
 
         QCOMPARE(h.count, 15);
-        QCOMPARE(h.uniqueCount(), 10);  // capped at kCapacity
+        QCOMPARE(h.uniqueCount(), 10);  // capped at capacity
         QCOMPARE(h.heatLevel(), 3);     // hot
-        QCOMPARE(h.last(), QString("14"));
+        QCOMPARE(sampleI32(h.at(0)), 14);
 
         // Verify oldest values were pushed out, newest 10 remain
-        QStringList collected;
-        h.forEach([&](const QString& v) { collected.append(v); });
+        QVector<int32_t> collected;
+        h.forEach([&](const rcx::ValueHistory::Sample& s) { collected.append(sampleI32(s)); });
         QCOMPARE(collected.size(), 10);
-        QCOMPARE(collected.first(), QString("5"));   // oldest surviving
-        QCOMPARE(collected.last(), QString("14"));    // newest
+        QCOMPARE(collected.first(), 5);    // oldest surviving
+        QCOMPARE(collected.last(), 14);    // newest
     }
 
     void testValueHistory_forEach() {
         rcx::ValueHistory h;
-        h.record("x");
-        h.record("y");
-        h.record("z");
+        rec(h, 7);
+        rec(h, 8);
+        rec(h, 9);
 
-        QStringList items;
-        h.forEach([&](const QString& v) { items.append(v); });
-        QCOMPARE(items.size(), 3);
-        QCOMPARE(items[0], QString("x"));
-        QCOMPARE(items[1], QString("y"));
-        QCOMPARE(items[2], QString("z"));
+        QVector<int32_t> items;
+        h.forEach([&](const rcx::ValueHistory::Sample& s) { items.append(sampleI32(s)); });
+        QCOMPARE(items, (QVector<int32_t>{7, 8, 9}));
+
+        // forEachWithTime runs newest → oldest and honors the limit.
+        items.clear();
+        h.forEachWithTime([&](const rcx::ValueHistory::Sample& s) { items.append(sampleI32(s)); }, 2);
+        QCOMPARE(items, (QVector<int32_t>{9, 8}));
     }
 
     void testValueHistory_oscillation() {
         // Values that oscillate (A → B → A → B) should still count each unique transition
         rcx::ValueHistory h;
-        h.record("A");
-        h.record("B");
-        h.record("A");
-        h.record("B");
+        rec(h, 1);
+        rec(h, 2);
+        rec(h, 1);
+        rec(h, 2);
         QCOMPARE(h.count, 4);       // 4 transitions
         QCOMPARE(h.heatLevel(), 2); // warm (count=4 → 3-4 range)
     }
 
+    void testValueHistory_growsThenWrapsInOrder() {
+        // The arena doubles up to capacity; samples recorded before each
+        // growth must survive it and the ring must wrap cleanly afterwards.
+        rcx::ValueHistory h(1024);
+        for (int i = 0; i < 1500; i++)
+            rec(h, i);
+        QCOMPARE(h.uniqueCount(), 1024);
+        int expect = 1500 - 1024;
+        bool ordered = true;
+        h.forEach([&](const rcx::ValueHistory::Sample& s) {
+            if (sampleI32(s) != expect++) ordered = false;
+        });
+        QVERIFY(ordered);
+        QCOMPARE(expect, 1500);
+    }
+
+    void testValueHistory_flagsAndWidth() {
+        rcx::ValueHistory h;
+        uint64_t v = 5;
+        h.record(&v, 8);
+        // Same bytes, but now the dereferenced target: a distinct value.
+        QVERIFY(h.record(&v, 8, rcx::ValueHistory::kDeref));
+        QCOMPARE(h.count, 2);
+        // A width change means the node was retyped — the ring restarts.
+        QVERIFY(rec(h, 5));
+        QCOMPARE(h.count, 1);
+        QCOMPARE(h.width(), 4);
+    }
+
+    void testValueHistory_derefKeepsRing() {
+        // A primitive pointer going null -> set -> null swaps between its
+        // own 8 bytes and a 4-byte target; that's one field, not a retype.
+        rcx::ValueHistory h;
+        uint64_t null = 0;
+        QVERIFY(h.record(&null, 8));
+        int32_t target = 42;
+        QVERIFY(h.record(&target, 4, rcx::ValueHistory::kDeref));
+        QCOMPARE(h.count, 2);
+        QCOMPARE(h.width(), 4);
+        QVERIFY(h.record(&null, 8));
+        QCOMPARE(h.count, 3);
+        QCOMPARE(h.at(1).len, 4);
+        QCOMPARE(*reinterpret_cast<const int32_t*>(h.at(1).bytes), 42);
+        QCOMPARE(h.at(2).len, 8);
+        QCOMPARE(h.heatLevel(), 2);
+    }
+
+    void testValueHistory_formatsOnDemand() {
+        rcx::Node n;
+        n.kind = rcx::NodeKind::Int32;
+        rcx::ValueHistory h;
+        rec(h, -7);
+        QCOMPARE(rcx::fmt::historyValue(n, h.at(0)), QStringLiteral("-7"));
+
+        // Retyping to UInt32 reformats the same bytes, no re-recording needed.
+        n.kind = rcx::NodeKind::UInt32;
+        QCOMPARE(rcx::fmt::historyValue(n, h.at(0)), rcx::fmt::fmtUInt32(uint32_t(-7)));
+
+        // Primitive pointer: its own bytes and its dereferenced target.
+        rcx::Node p;
+        p.kind = rcx::NodeKind::Pointer64;
+        p.ptrDepth = 1;
+        p.elementKind = rcx::NodeKind::Int32;
+        uint64_t ptr = 0;
+        rcx::ValueHistory ph;
+        ph.record(&ptr, 8);
+        QCOMPARE(rcx::fmt::historyValue(p, ph.at(0)), QStringLiteral("nullptr"));
+        int32_t target = 99;
+        rcx::ValueHistory th;
+        th.record(&target, 4, rcx::ValueHistory::kDeref);
+        QCOMPARE(rcx::fmt::historyValue(p, th.at(0)), QStringLiteral("-> 99"));
+    }
+
     // ── Test: comment field JSON round-trip ──
     void testCommentJsonRoundTrip() {
         rcx::Node n;
@@ -977,18 +1058,18 @@ private slots:
 
     void testValueHistoryDedup() {
         rcx::ValueHistory vh;
-        vh.record(QStringLiteral("42"));
-        vh.record(QStringLiteral("42"));  // same value, should not increment
+        rec(vh, 42);
+        rec(vh, 42);  // same value, should not increment
         QCOMPARE(vh.uniqueCount(), 1);
-        QCOMPARE(vh.last(), QStringLiteral("42"));
+        QCOMPARE(sampleI32(vh.at(0)), 42);
     }
 
     void testValueHistoryRingOverflow() {
-        rcx::ValueHistory vh;
+        rcx::ValueHistory vh(10);
         for (int i = 0; i < 15; i++)
-            vh.record(QString::number(i));
-        QCOMPARE(vh.uniqueCount(), rcx::ValueHistory::kCapacity);
-        QCOMPARE(vh.last(), QStringLiteral("14"));
+            rec(vh, i);
+        QCOMPARE(vh.uniqueCount(), vh.capacity());
+        QCOMPARE(sampleI32(vh.at(0)), 14);
     }
 
     void testStructSpanCycleDetection() {
@@ -1190,6 +1271,113 @@ private slots:
         QCOMPARE(kids.size(), 0);
     }
 
+    void testChildIndexFollowsAddNode() {
+        rcx::NodeTree tree;
+        rcx::Node a; a.kind = rcx::NodeKind::Struct;
+        const uint64_t aId = tree.nodes[tree.addNode(a)].id;
+        rcx::Node b; b.kind = rcx::NodeKind::Struct;
+        const uint64_t bId = tree.nodes[tree.addNode(b)].id;
+        for (int i = 0; i < 3; i++) {
+            rcx::Node c; c.parentId = (i % 2) ? bId : aId; c.offset = i * 4;
+            tree.addNode(c);
+        }
+        // Rows keep node order.
+        auto kids = tree.children(aId);
+        QCOMPARE(kids.size(), 2);
+        QCOMPARE(kids[0], 2);
+        QCOMPARE(kids[1], 4);
+        QCOMPARE(tree.children(bId).size(), 1);
+        QVERIFY(tree.children(12345).isEmpty());
+
+        // Appends after the index is built land in the right row without
+        // disturbing the others.
+        rcx::Node late; late.parentId = bId;
+        int li = tree.addNode(late);
+        QCOMPARE(tree.children(bId).size(), 2);
+        QCOMPARE(tree.children(bId)[1], li);
+        QCOMPARE(tree.children(aId).size(), 2);
+        QCOMPARE(tree.childIndex().spilled, 0);   // folded back in
+        QCOMPARE(tree.children(bId)[1], li);
+
+        // Re-parenting by hand is only seen after invalidateIdCache().
+        tree.nodes[li].parentId = aId;
+        tree.invalidateIdCache();
+        QCOMPARE(tree.children(aId).size(), 3);
+        QCOMPARE(tree.children(bId).size(), 1);
+        QCOMPARE(tree.childrenOf(aId), (QVector<int>{2, 4, li}));
+    }
+
+    void testChildIndexManyAppends() {
+        // Enough appends under one parent to force the spill to fold.
+        rcx::NodeTree tree;
+        rcx::Node root; root.kind = rcx::NodeKind::Struct;
+        const uint64_t rootId = tree.nodes[tree.addNode(root)].id;
+        for (int i = 0; i < 500; i++) {
+            rcx::Node c; c.parentId = rootId; c.offset = i;
+            int ci = tree.addNode(c);
+            auto kids = tree.children(rootId);
+            QCOMPARE(kids.size(), i + 1);
+            QCOMPARE(kids[i], ci);
+        }
+        QCOMPARE(tree.children(0).size(), 1);
+    }
+
+    void testValidateRepairsCycleAndOrphan() {
+        rcx::NodeTree tree;
+        // 1 → 2 → 3 → 1, plus 4 hanging off the cycle and 5 off nothing.
+        for (uint64_t id = 1; id <= 5; id++) {
+            rcx::Node n; n.id = id; n.kind = rcx::NodeKind::Struct;
+            tree.addNode(n);
+        }
+        tree.nodes[0].parentId = 3;
+        tree.nodes[1].parentId = 1;
+        tree.nodes[2].parentId = 2;
+        tree.nodes[3].parentId = 2;
+        tree.nodes[4].parentId = 777;
+        tree.invalidateIdCache();
+
+        auto dry = tree.validate(false);
+        QCOMPARE(dry.cycles, 1);
+        QCOMPARE(dry.orphans, 1);
+        QCOMPARE(tree.nodes[4].parentId, uint64_t(777));
+
+        auto r = tree.validate();
+        QCOMPARE(r.cycles, 1);
+        QCOMPARE(r.orphans, 1);
+        QCOMPARE(tree.nodes[4].parentId, uint64_t(0));
+        QCOMPARE(tree.childrenOf(0).size(), 2);
+        QVERIFY(tree.validate().clean());
+        QCOMPARE(tree.subtreeIndices(tree.nodes[tree.childrenOf(0)[0]].id).size() +
+                 tree.subtreeIndices(tree.nodes[tree.childrenOf(0)[1]].id).size(), 5);
+    }
+
+    void testFromJsonInternsStrings() {
+        rcx::NodeTree src;
+        rcx::Node root; root.kind = rcx::NodeKind::Struct;
+        root.structTypeName = "LIST_ENTRY"; root.classKeyword = "class";
+        const uint64_t rootId = src.nodes[src.addNode(root)].id;
+        for (int i = 0; i < 2; i++) {
+            rcx::Node n; n.kind = rcx::NodeKind::Struct; n.parentId = rootId;
+            n.name = "Flink"; n.structTypeName = "LIST_ENTRY"; n.classKeyword = "class";
+            n.offset = i * 8;
+            src.addNode(n);
+        }
+        // fromJson gets a separate QString per JSON value; after interning
+        // equal strings point at one buffer.
+        const rcx::NodeTree t = rcx::NodeTree::fromJson(src.toJson());
+        QCOMPARE(t.nodes.size(), 3);
+        QCOMPARE(t.nodes[1].name, QStringLiteral("Flink"));
+        QCOMPARE(t.nodes[1].name.constData(), t.nodes[2].name.constData());
+        QCOMPARE(t.nodes[0].structTypeName.constData(), t.nodes[2].structTypeName.constData());
+        QCOMPARE(t.nodes[0].classKeyword.constData(), t.nodes[1].classKeyword.constData());
+
+        rcx::StringInterner strings;
+        QVERIFY(strings.intern(QString()).isNull());
+        const QString a = strings.intern(QString::number(42));
+        QCOMPARE(strings.intern(QString::number(42)).constData(), a.constData());
+        QCOMPARE(strings.size(), 1);
+    }
+
     void testIndexOfIdNotFound() {
         rcx::NodeTree tree;
         rcx::Node n; tree.addNode(n);
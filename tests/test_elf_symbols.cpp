@@ -0,0 +1,161 @@
+#include <QTest>
+#include <QCoreApplication>
+#include <cstring>
+#include "imports/elf_symbols.h"
+
+using namespace rcx;
+
+extern "C" Q_DECL_EXPORT int elfProbeFunction(int x) { return x * 3 + 1; }
+
+namespace {
+
+// A little-endian ELF64 image with two PT_LOADs at 0x400000 and a symtab
+// covering the cases the loader has to filter.
+QByteArray buildElf64() {
+    struct Sym { const char* name; uint8_t info; uint16_t shndx; uint64_t value, size; };
+    const Sym syms[] = {
+        {"",            0x00, 0,      0,        0},      // null symbol
+        {"func_a",      0x12, 1,      0x401000, 0x20},   // GLOBAL FUNC
+        {"local_alias", 0x02, 1,      0x401000, 0x20},   // LOCAL FUNC, same address
+        {"data_b",      0x11, 1,      0x402000, 8},      // GLOBAL OBJECT
+        {"undef",       0x12, 0,      0,        0},      // undefined import
+        {"abs",         0x11, 0xfff1, 0x1234,   0},      // SHN_ABS
+        {"tls",         0x16, 1,      0x401100, 8},      // STT_TLS
+        {"label",       0x10, 1,      0x401200, 0},      // STT_NOTYPE
+        {"zero",        0x12, 1,      0x403000, 0},      // no size
+    };
+    const int nsyms = int(sizeof(syms) / sizeof(syms[0]));
+
+    QByteArray strtab(1, '\0');
+    QVector<uint32_t> nameOff;
+    for (const Sym& s : syms) {
+        nameOff.append(*s.name ? uint32_t(strtab.size()) : 0);
+        if (*s.name) strtab.append(s.name).append('\0');
+    }
+
+    const int ehSize = 64, phSize = 56, shSize = 64, symSize = 24;
+    const int phOff = ehSize;
+    const int symOff = phOff + 2 * phSize;
+    const int strOff = symOff + nsyms * symSize;
+    const int shOff = (strOff + strtab.size() + 7) & ~7;
+    QByteArray img(shOff + 4 * shSize, '\0');
+    auto put = [&img](int off, auto v) { std::memcpy(img.data() + off, &v, sizeof(v)); };
+
+    std::memcpy(img.data(), "\x7f" "ELF", 4);
+    img[4] = 2;   // ELFCLASS64
+    img[5] = 1;   // little-endian
+    img[6] = 1;
+    put(16, uint16_t(2));          // ET_EXEC
+    put(18, uint16_t(62));         // x86-64
+    put(32, uint64_t(phOff));
+    put(40, uint64_t(shOff));
+    put(52, uint16_t(ehSize));
+    put(54, uint16_t(phSize));
+    put(56, uint16_t(2));
+    put(58, uint16_t(shSize));
+    put(60, uint16_t(4));
+
+    const uint64_t loadVaddr[2] = {0x401010, 0x400000};   // lowest one page-aligned
+    for (int i = 0; i < 2; ++i) {
+        const int p = phOff + i * phSize;
+        put(p, uint32_t(1));                         // PT_LOAD
+        put(p + 16, loadVaddr[i]);
+    }
+
+    for (int i = 0; i < nsyms; ++i) {
+        const int p = symOff + i * symSize;
+        put(p, nameOff[i]);
+        img[p + 4] = char(syms[i].info);
+        put(p + 6, syms[i].shndx);
+        put(p + 8, syms[i].value);
+        put(p + 16, syms[i].size);
+    }
+    std::memcpy(img.data() + strOff, strtab.constData(), size_t(strtab.size()));
+
+    // [0] null, [1] .text stand-in, [2] .symtab → [3] .strtab
+    put(shOff + 1 * shSize + 4, uint32_t(1));        // SHT_PROGBITS
+    const int st = shOff + 2 * shSize;
+    put(st + 4, uint32_t(2));                        // SHT_SYMTAB
+    put(st + 24, uint64_t(symOff));
+    put(st + 32, uint64_t(nsyms * symSize));
+    put(st + 40, uint32_t(3));
+    put(st + 56, uint64_t(symSize));
+    const int ss = shOff + 3 * shSize;
+    put(ss + 4, uint32_t(3));                        // SHT_STRTAB
+    put(ss + 24, uint64_t(strOff));
+    put(ss + 32, uint64_t(strtab.size()));
+    return img;
+}
+
+std::shared_ptr<const ElfSymbols> parse(const QByteArray& img, QString* err = nullptr) {
+    return parseElfSymbols(reinterpret_cast<const uchar*>(img.constData()), img.size(), err);
+}
+
+} // namespace
+
+class TestElfSymbols : public QObject {
+    Q_OBJECT
+private slots:
+    void indexesFunctionsAndObjects() {
+        auto t = parse(buildElf64());
+        QVERIFY(t);
+        QCOMPARE(int(t->syms.size()), 3);
+
+        // RVAs are relative to the lowest PT_LOAD page, 0x400000.
+        QCOMPARE(t->syms[0].rva, uint64_t(0x1000));
+        QCOMPARE(t->nameStringAt(0), QString("func_a"));   // global beats the local alias
+        QCOMPARE(t->syms[0].size, uint32_t(0x20));
+        QCOMPARE(t->nameStringAt(1), QString("data_b"));
+        QCOMPARE(t->nameStringAt(2), QString("zero"));
+    }
+
+    void findUsesSymbolSize() {
+        auto t = parse(buildElf64());
+        QVERIFY(t);
+        QCOMPARE(t->find(0x0fff), -1);
+        QCOMPARE(t->find(0x1000), 0);
+        QCOMPARE(t->find(0x101f), 0);
+        QCOMPARE(t->find(0x1020), -1);
+        QCOMPARE(t->find(0x1100), -1);   // the TLS and NOTYPE symbols were dropped
+        QCOMPARE(t->find(0x2007), 1);
+        QCOMPARE(t->find(0x3000), 2);
+        QCOMPARE(t->find(0x3001), -1);   // size 0: exact address only
+    }
+
+    void rejectsBadImages() {
+        QString err;
+        QVERIFY(!parse(QByteArray("MZ\x90\x00", 4), &err));
+        QVERIFY(!err.isEmpty());
+
+        QByteArray img = buildElf64();
+        QVERIFY(!parse(img.left(40), &err));
+
+        QByteArray be = img;
+        be[5] = 2;
+        QVERIFY(!parse(be, &err));
+
+        // Section headers pointing past the end: no table, no crash.
+        QByteArray cut = img.left(img.size() - 8);
+        QVERIFY(!parse(cut, &err));
+    }
+
+    void loadsOwnExecutable() {
+#ifndef Q_OS_LINUX
+        QSKIP("ELF modules only on Linux");
+#else
+        QString err;
+        auto t = loadElfSymbols(QCoreApplication::applicationFilePath(), &err);
+        QVERIFY2(t, qPrintable(err));
+        int probe = -1;
+        for (int i = 0; i < int(t->syms.size()); ++i)
+            if (std::strcmp(t->nameAt(i), "elfProbeFunction") == 0) probe = i;
+        QVERIFY(probe >= 0);
+        QVERIFY(t->syms[size_t(probe)].size > 0);
+        QCOMPARE(t->find(t->syms[size_t(probe)].rva + 1), probe);
+        QCOMPARE(elfProbeFunction(1), 4);
+#endif
+    }
+};
+
+QTEST_MAIN(TestElfSymbols)
+#include "test_elf_symbols.moc"
@@ -14,10 +14,12 @@ private slots:
     void importFilteredStruct();
     void enumerateTypes();
     void importSelected();
+    void importSelectedManyKeepsTypesOnce();
 };
 
-static const QString kPdbPath = QStringLiteral(
-    "C:/Symbols/ntkrnlmp.pdb/0762CF42EF7F3E8116EF7329ADAA09A31/ntkrnlmp.pdb");
+// $RCX_TEST_PDB overrides the path so non-Windows CI can point at a copy.
+static const QString kPdbPath = qEnvironmentVariable("RCX_TEST_PDB", QStringLiteral(
+    "C:/Symbols/ntkrnlmp.pdb/0762CF42EF7F3E8116EF7329ADAA09A31/ntkrnlmp.pdb"));
 
 // Find a root struct by structTypeName
 static int findRootStruct(const NodeTree& tree, const QString& name) {
@@ -233,5 +235,50 @@ void TestImportPdb::importSelected() {
     QCOMPARE(rootCount, 1);
 }
 
+void TestImportPdb::importSelectedManyKeepsTypesOnce() {
+    if (!QFile::exists(kPdbPath))
+        QSKIP("ntkrnlmp.pdb not found at expected path");
+
+    QString err;
+    QVector<PdbTypeInfo> types = enumeratePdbTypes(kPdbPath, &err);
+    QVERIFY2(types.size() >= 1000, qPrintable(err));
+
+    // Enough types to split across threads; many share dependencies
+    // (_LIST_ENTRY, _KEVENT, ...) that each worker imports on its own.
+    QVector<uint32_t> indices;
+    for (int i = 0; i < 1000; i++) indices.append(types[i].typeIndex);
+    int lastCur = 0;
+    NodeTree tree = importPdbSelected(kPdbPath, indices, &err,
+        [&](int cur, int total) -> bool {
+            Q_ASSERT(cur >= lastCur && cur <= total);
+            lastCur = cur;
+            return true;
+        });
+    QVERIFY2(!tree.nodes.isEmpty(), qPrintable(err));
+    QCOMPARE(lastCur, indices.size());
+
+    // A type with a single definition in the TPI is imported once however
+    // many workers pulled it in; ids are unique, and every parent and
+    // refId resolves inside the merged tree.
+    QHash<QString, int> definitions;
+    for (const auto& t : types) definitions[t.name]++;
+    QSet<uint64_t> ids;
+    QHash<QString, int> rootsByName;
+    for (const auto& n : tree.nodes) {
+        QVERIFY(!ids.contains(n.id));
+        ids.insert(n.id);
+        if (n.parentId == 0) rootsByName[n.structTypeName]++;
+    }
+    for (auto it = rootsByName.cbegin(); it != rootsByName.cend(); ++it)
+        if (definitions.value(it.key()) == 1)
+            QVERIFY2(it.value() == 1, qPrintable(it.key()));
+    for (const auto& n : tree.nodes) {
+        if (n.parentId != 0) QVERIFY(ids.contains(n.parentId));
+        if (n.refId != 0) QVERIFY(ids.contains(n.refId));
+    }
+    for (const auto& t : types.mid(0, 1000))
+        QVERIFY2(findRootStruct(tree, t.name) >= 0 || t.isEnum, qPrintable(t.name));
+}
+
 QTEST_MAIN(TestImportPdb)
 #include "test_import_pdb.moc"
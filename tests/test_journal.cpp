@@ -0,0 +1,182 @@
+#include <QTest>
+#include <QDir>
+#include <QFile>
+#include <QJsonDocument>
+#include "core.h"
+#include "journal.h"
+
+using namespace rcx;
+
+namespace {
+
+QByteArray jsonOf(const Command& c) {
+    return QJsonDocument(commandToJson(c)).toJson(QJsonDocument::Compact);
+}
+
+// One of every command, with the awkward values: 64-bit ids past 2^53,
+// negative enum values, nested subtrees, bytes.
+QVector<Command> everyCommand() {
+    Node inserted;
+    inserted.id = 0x8000000000000001ull;
+    inserted.kind = NodeKind::Pointer64;
+    inserted.name = QStringLiteral("next");
+    inserted.parentId = 7;
+    inserted.offset = 0x18;
+    inserted.refId = 0x8000000000000002ull;
+    inserted.collapsed = false;
+    inserted.comment = QStringLiteral("linked list");
+
+    Node removedRoot;
+    removedRoot.id = 40;
+    removedRoot.kind = NodeKind::Struct;
+    removedRoot.structTypeName = QStringLiteral("Inner");
+    removedRoot.classKeyword = QStringLiteral("bitfield");
+    removedRoot.bitfieldMembers = {{QStringLiteral("a"), 0, 3}};
+    Node removedChild;
+    removedChild.id = 41;
+    removedChild.parentId = 40;
+    removedChild.kind = NodeKind::Array;
+    removedChild.arrayLen = 12;
+    removedChild.elementKind = NodeKind::Float;
+
+    const QVector<cmd::OffsetAdj> adjs = {{9, 4, 8}, {10, 8, 12}};
+    return {
+        cmd::ChangeKind{3, NodeKind::Hex64, NodeKind::Double, adjs},
+        cmd::Rename{3, QStringLiteral("field_08"), QStringLiteral("héalth")},
+        cmd::Collapse{3, true, false},
+        cmd::Insert{inserted, adjs},
+        cmd::Remove{40, {removedRoot, removedChild}, {}},
+        cmd::ChangeBase{0x140000000, 0xffffffffffff0000ull,
+                        QString(), QStringLiteral("<game.exe> + 0x10")},
+        cmd::WriteBytes{0x1000, QByteArray("\x00\x01", 2), QByteArray("\xff\xfe", 2)},
+        cmd::ChangeArrayMeta{5, NodeKind::UInt8, NodeKind::UInt32, 16, 4},
+        cmd::ChangePointerRef{6, 0, 0x8000000000000003ull},
+        cmd::ChangeStructTypeName{1, QStringLiteral("A"), QStringLiteral("B")},
+        cmd::ChangeClassKeyword{1, QStringLiteral("struct"), QStringLiteral("union")},
+        cmd::ChangeOffset{3, 8, -4},
+        cmd::ChangeEnumMembers{2, {}, {{QStringLiteral("None"), 0},
+                                       {QStringLiteral("Min"), INT64_MIN}}},
+        cmd::ToggleRelative{6, false, true},
+        cmd::ToggleBigEndian{3, false, true},
+        cmd::ChangeComment{3, QString(), QStringLiteral("// not a comment")},
+    };
+}
+
+QString tempJournal(const char* name) {
+    const QString path = QDir::tempPath() + QStringLiteral("/rcx_test_") + name + ".journal";
+    QFile::remove(path);
+    return path;
+}
+
+} // namespace
+
+class TestJournal : public QObject {
+    Q_OBJECT
+private slots:
+    void codecRoundTripsEveryCommand() {
+        const QVector<Command> cmds = everyCommand();
+        QCOMPARE(int(cmds.size()), int(std::variant_size_v<Command>));
+        for (const Command& c : cmds) {
+            Command back;
+            QVERIFY(commandFromJson(commandToJson(c), &back));
+            QCOMPARE(back.index(), c.index());
+            QCOMPARE(jsonOf(back), jsonOf(c));
+        }
+
+        // What the JSON can't show: exact ids and the collapsed state.
+        Command back;
+        QVERIFY(commandFromJson(commandToJson(cmds[3]), &back));
+        const Node& n = std::get<cmd::Insert>(back).node;
+        QCOMPARE(n.id, 0x8000000000000001ull);
+        QCOMPARE(n.refId, 0x8000000000000002ull);
+        QVERIFY(!n.collapsed);
+        QVERIFY(commandFromJson(commandToJson(cmds[12]), &back));
+        QCOMPARE(std::get<cmd::ChangeEnumMembers>(back).newMembers[1].second, int64_t(INT64_MIN));
+
+        QVERIFY(!commandFromJson(QJsonObject{{"op", "Teleport"}}, &back));
+        QVERIFY(!commandFromJson(QJsonObject{{"op", "Insert"}}, &back));
+    }
+
+    void appendsAndReadsBack() {
+        const QString path = tempJournal("append");
+        {
+            CommandJournal j;
+            QVERIFY(j.append(cmd::Rename{1, "a", "b"}, false));   // closed: no-op
+            j.open(path);
+            QVERIFY(!QFile::exists(path));   // nothing until the first append
+            QVERIFY(j.append(cmd::Rename{1, "a", "b"}, false));
+            QVERIFY(j.append(cmd::WriteBytes{0, "x", "y"}, false));   // not journaled
+            QVERIFY(j.append(cmd::Rename{1, "a", "b"}, true));
+            QCOMPARE(j.seq(), uint64_t(2));
+            QCOMPARE(j.pending(), 2);
+        }
+
+        const QVector<JournalEntry> all = CommandJournal::read(path);
+        QCOMPARE(all.size(), 2);
+        QVERIFY(!all[0].undo);
+        QVERIFY(all[1].undo);
+        QCOMPARE(std::get<cmd::Rename>(all[1].cmd).newName, QStringLiteral("b"));
+        QCOMPARE(CommandJournal::read(path, 1).size(), 1);
+
+        // Reopening continues the sequence instead of restarting it.
+        CommandJournal j;
+        j.open(path);
+        QCOMPARE(j.seq(), uint64_t(2));
+        QCOMPARE(j.pending(), 2);
+        QVERIFY(j.append(cmd::Collapse{1, true, false}, false));
+        QCOMPARE(CommandJournal::read(path).last().seq, uint64_t(3));
+        j.reset();
+        QVERIFY(!QFile::exists(path));
+        QVERIFY(j.isOpen());
+    }
+
+    void compactKeepsEntriesPastTheWrite() {
+        const QString path = tempJournal("compact");
+        CommandJournal j;
+        j.open(path);
+        for (int i = 0; i < 5; ++i)
+            QVERIFY(j.append(cmd::ChangeOffset{1, i, i + 1}, false));
+
+        QVERIFY(j.compact(3));
+        QCOMPARE(j.pending(), 2);
+        const QVector<JournalEntry> left = CommandJournal::read(path);
+        QCOMPARE(left.size(), 2);
+        QCOMPARE(left[0].seq, uint64_t(4));
+
+        // Appending after a compaction lands after the survivors.
+        QVERIFY(j.append(cmd::ChangeOffset{1, 5, 6}, false));
+        QCOMPARE(CommandJournal::read(path).size(), 3);
+
+        QVERIFY(j.compact(j.seq()));
+        QVERIFY(!QFile::exists(path));
+        QCOMPARE(j.pending(), 0);
+    }
+
+    void tornTailIsIgnored() {
+        const QString path = tempJournal("torn");
+        {
+            CommandJournal j;
+            j.open(path);
+            QVERIFY(j.append(cmd::Rename{1, "a", "b"}, false));
+            QVERIFY(j.append(cmd::Rename{1, "b", "c"}, false));
+        }
+        {
+            QFile f(path);
+            QVERIFY(f.open(QIODevice::Append));
+            f.write("{\"seq\":\"3\",\"undo\":false,\"cmd\":{\"op\":\"Ren");
+        }
+        QCOMPARE(CommandJournal::read(path).size(), 2);
+
+        // A garbled line ends the readable journal too.
+        {
+            QFile f(path);
+            QVERIFY(f.open(QIODevice::WriteOnly));
+            f.write("not json\n");
+        }
+        QVERIFY(CommandJournal::read(path).isEmpty());
+        QFile::remove(path);
+    }
+};
+
+QTEST_MAIN(TestJournal)
+#include "test_journal.moc"
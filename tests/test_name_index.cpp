@@ -0,0 +1,151 @@
+#include <QTest>
+#include <QThreadPool>
+#include "names/name_index.h"
+#include "names/name_provider.h"
+#include "providers/buffer_provider.h"
+#include "symbolstore.h"
+
+using namespace rcx;
+
+namespace {
+
+NameSpan span(uint64_t lo, uint64_t hi, const QString& name, bool withOffset = false) {
+    NameSpan s;
+    s.lo = lo;
+    s.hi = hi;
+    s.name = name;
+    s.withOffset = withOffset;
+    return s;
+}
+
+QString upperAfterBang(const QString& sym) {
+    return sym.startsWith(QLatin1Char('?')) ? sym.mid(1).toUpper() : QString();
+}
+
+class ListProvider : public NameProvider {
+public:
+    QVector<NamedAddress> list;
+    QString id() const override { return QStringLiteral("list"); }
+    QString displayName() const override { return QStringLiteral("List"); }
+    QVector<NamedAddress> entries(const Provider*) const override { return list; }
+};
+
+class ModuleProvider : public BufferProvider {
+public:
+    QHash<QString, uint64_t> modules;
+    ModuleProvider() : BufferProvider(QByteArray(16, '\0'), "test") {}
+    uint64_t symbolToAddress(const QString& name) const override {
+        return modules.value(name);
+    }
+};
+
+} // namespace
+
+class TestNameIndex : public QObject {
+    Q_OBJECT
+private slots:
+    void exactAndOffsetSpans() {
+        auto idx = NameIndex::build({{span(0x100, 0x101, "bm"),
+                                      span(0x200, 0x280, "mod!Func", true)}});
+        QCOMPARE(idx->nameFor(0x100), QString("bm"));
+        QCOMPARE(idx->nameFor(0x101), QString());
+        QCOMPARE(idx->nameFor(0x200), QString("mod!Func"));
+        QCOMPARE(idx->nameFor(0x212), QString("mod!Func+0x12"));
+        QCOMPARE(idx->nameFor(0x280), QString());
+        QCOMPARE(idx->nameFor(0xff), QString());
+        QCOMPARE(idx->segmentCount(), 2);
+    }
+
+    void lowerRankWins() {
+        auto idx = NameIndex::build({{span(0x100, 0x101, "bookmark")},
+                                     {span(0x0f0, 0x200, "mod!Big", true)}});
+        QCOMPARE(idx->nameFor(0x100), QString("bookmark"));
+        QCOMPARE(idx->nameFor(0x0f8), QString("mod!Big+0x8"));
+        QCOMPARE(idx->nameFor(0x101), QString("mod!Big+0x11"));
+    }
+
+    void nearestStartWithinRank() {
+        auto idx = NameIndex::build({{span(0x100, 0x400, "mod!Outer", true),
+                                      span(0x180, 0x190, "mod!Inner", true)}});
+        QCOMPARE(idx->nameFor(0x17f), QString("mod!Outer+0x7f"));
+        QCOMPARE(idx->nameFor(0x184), QString("mod!Inner+0x4"));
+        QCOMPARE(idx->nameFor(0x190), QString("mod!Outer+0x90"));
+    }
+
+    void equalStartsPreferFirstListed() {
+        auto idx = NameIndex::build({{span(0x100, 0x101, "first"),
+                                      span(0x100, 0x101, "second")}});
+        QCOMPARE(idx->nameFor(0x100), QString("first"));
+        QCOMPARE(idx->segmentCount(), 1);
+    }
+
+    void humanizesSymbolPart() {
+        NameSpan a = span(0x10, 0x20, "mod!?func", true);
+        a.humanize = true;
+        NameSpan b = span(0x20, 0x21, "?raw");   // not marked
+        NameSpan c = span(0x30, 0x31, "mod!plain");
+        c.humanize = true;                        // humanizer declines
+        auto idx = NameIndex::build({{a, b, c}}, &upperAfterBang);
+        QCOMPARE(idx->nameFor(0x14), QString("mod!FUNC+0x4"));
+        QCOMPARE(idx->nameFor(0x20), QString("?raw"));
+        QCOMPARE(idx->nameFor(0x30), QString("mod!plain"));
+    }
+
+    void emptyAndInvalid() {
+        auto idx = NameIndex::build({});
+        QVERIFY(idx->isEmpty());
+        QCOMPARE(idx->nameFor(0), QString());
+
+        idx = NameIndex::build({{span(0x10, 0x10, "empty"), span(0x20, 0x21, QString())}});
+        QVERIFY(idx->isEmpty());
+    }
+
+    void defaultSpansMatchNameFor() {
+        ListProvider p;
+        NamedAddress a;
+        a.name = "a";
+        a.address = 0x40;
+        NamedAddress typeOnly;
+        typeOnly.name = "T";
+        p.list = {a, typeOnly};
+
+        const auto spans = p.nameSpans(nullptr);
+        QCOMPARE(spans.size(), 1);
+        auto idx = NameIndex::build({spans});
+        for (uint64_t addr : {uint64_t(0), uint64_t(0x3f), uint64_t(0x40), uint64_t(0x41)})
+            QCOMPARE(idx->nameFor(addr), p.nameFor(addr, nullptr));
+    }
+
+    // getSymbolForAddress builds its index on the pool; until it lands the
+    // per-module search must give the index's answers, and it must again
+    // once a module moves.
+    void symbolStoreAnswersWhileIndexBuilds() {
+        SymbolStore& store = SymbolStore::instance();
+        store.addModule(QStringLiteral("game"), {},
+            {{QStringLiteral("Tick"), 0x1000}, {QStringLiteral("Alias"), 0x1000},
+             {QStringLiteral("Draw"), 0x1010}, {QStringLiteral("Far"), 0x8000}});
+        store.addModule(QStringLiteral("util"), {}, {{QStringLiteral("Helper"), 0x20}});
+        ModuleProvider prov;
+        prov.modules = {{QStringLiteral("game.exe"), 0x400000},
+                        {QStringLiteral("util.dll"), 0x401008}};
+
+        const QVector<uint64_t> probes = {0x400fff, 0x401000, 0x401004, 0x401010,
+            0x401028, 0x402010, 0x402011, 0x408000, 0x409001};
+        for (int pass = 0; pass < 2; ++pass) {
+            const auto idx = NameIndex::build({store.addressSpans(&prov)});
+            for (uint64_t a : probes)
+                QCOMPARE(store.getSymbolForAddress(a, &prov), idx->nameFor(a));
+            QThreadPool::globalInstance()->waitForDone();
+            for (uint64_t a : probes)
+                QCOMPARE(store.getSymbolForAddress(a, &prov), idx->nameFor(a));
+            prov.modules[QStringLiteral("util.dll")] = 0x409000;
+            QTest::qWait(1100);   // past the base recheck interval
+        }
+        QCOMPARE(store.getSymbolForAddress(0x409021, &prov), QStringLiteral("util!Helper+0x1"));
+        store.unloadModule(QStringLiteral("game"));
+        store.unloadModule(QStringLiteral("util"));
+    }
+};
+
+QTEST_MAIN(TestNameIndex)
+#include "test_name_index.moc"
@@ -0,0 +1,155 @@
+#include <QTest>
+#include <atomic>
+#include <cstring>
+#include "pagesampler.h"
+
+using namespace rcx;
+
+namespace {
+
+// Every read is one sampler pass (a single page is one span): byte 0x10
+// holds the pass number and byte 0x20 flips between 0 and 1, so a UI that
+// takes every other frame sees no net change there.
+class TickingProvider : public Provider {
+public:
+    mutable std::atomic<int> reads{0};
+
+    int size() const override { return 8192; }
+    bool isLive() const override { return true; }
+    bool read(uint64_t addr, void* buf, int len) const override {
+        if (!isReadable(addr, len)) return false;
+        const int n = ++reads;
+        auto* out = static_cast<uint8_t*>(buf);
+        std::memset(out, 0, size_t(len));
+        auto put = [&](uint64_t at, uint8_t v) {
+            if (at >= addr && at < addr + uint64_t(len)) out[at - addr] = v;
+        };
+        put(0x10, uint8_t(n));
+        put(0x20, uint8_t(n & 1));
+        return true;
+    }
+};
+
+} // namespace
+
+class TestPageSampler : public QObject {
+    Q_OBJECT
+private slots:
+    void tripleBufferHandsOverNewest() {
+        TripleBuffer<int> tb;
+        QVERIFY(!tb.take());
+
+        tb.back() = 1;
+        QVERIFY(!tb.publish());          // nothing was waiting
+        QVERIFY(tb.hasFresh());
+        QVERIFY(tb.take());
+        QCOMPARE(tb.front(), 1);
+        QVERIFY(!tb.take());
+        QCOMPARE(tb.front(), 1);         // front kept until the next take
+
+        tb.back() = 2;
+        tb.publish();
+        tb.back() = 3;
+        QVERIFY(tb.publish());           // 2 was never taken
+        QCOMPARE(tb.back(), 2);          // ...and comes back for reuse
+        QVERIFY(tb.take());
+        QCOMPARE(tb.front(), 3);
+    }
+
+    void changeBitmapMerge() {
+        ChangeBitmap a, b;
+        a.set(5);
+        b.set(5);
+        b.set(4096 + 9);
+        a.merge(b);
+        QVERIFY(a.test(5));
+        QVERIFY(a.test(4096 + 9));
+        QCOMPARE(a.count(), 2);
+    }
+
+    void idleWithoutTarget() {
+        auto prov = std::make_shared<TickingProvider>();
+        PageSampler s(prov, 1000);
+        QTest::qWait(20);
+        QCOMPARE(s.passCount(), quint64(0));
+        QCOMPARE(prov->reads.load(), 0);
+        QVERIFY(!s.take());
+    }
+
+    void foldsPassesTheUiMissed() {
+        auto prov = std::make_shared<TickingProvider>();
+        PageSampler s(prov, 1000);
+        QCOMPARE(s.hz(), 1000);
+        s.setTarget({0}, {{7, 0x10, 1}});
+        QTRY_VERIFY_WITH_TIMEOUT(s.passCount() >= 20, 5000);
+
+        QVERIFY(s.take());
+        PageSampler::Frame& f = s.frame();
+        QVERIFY(f.seq >= 20);
+        QCOMPARE(quint64(f.passes), f.seq);   // nothing taken before: every pass folded
+        QVERIFY(f.pages.contains(0));
+        QCOMPARE(uint8_t(f.pages.value(0)[0x10]), uint8_t(f.seq));
+
+        // 0x20 flipped back and forth; the fold still reports it.
+        QVERIFY(f.changed.test(0x20));
+        QVERIFY(!f.changed.test(0x30));
+
+        // One watch sample per distinct value, oldest first, ending at
+        // the frame's own pass.
+        const auto& seq = f.watches.value(7);
+        QCOMPARE(seq.size(), qMin(int(f.seq), PageSampler::kMaxWatchSamples));
+        for (int i = 1; i < seq.size(); ++i) {
+            QCOMPARE(seq[i].seq, seq[i - 1].seq + 1);
+            QVERIFY(seq[i].timeUs >= seq[i - 1].timeUs);
+        }
+        QCOMPARE(seq.last().seq, f.seq);
+        QCOMPARE(seq.last().addr, uint64_t(0x10));
+        QCOMPARE(uint8_t(seq.last().bytes[0]), uint8_t(f.seq));
+
+        // The next frame starts after the one just taken.
+        const quint64 firstSeq = f.seq;
+        QTRY_VERIFY_WITH_TIMEOUT(s.take(), 5000);
+        QVERIFY(s.frame().seq > firstSeq);
+        QVERIFY(s.frame().passes < int(s.frame().seq));
+        QCOMPARE(s.frame().watches.value(7).last().seq, s.frame().seq);
+    }
+
+    void retargetRestartsWatch() {
+        auto prov = std::make_shared<TickingProvider>();
+        PageSampler s(prov, 1000);
+        s.setTarget({0}, {{7, 0x10, 1}});
+        QTRY_VERIFY_WITH_TIMEOUT(s.passCount() >= 3, 5000);
+        s.setTarget({0}, {{7, 0x40, 1}});   // constant zero there
+        const quint64 after = s.passCount();
+        QTRY_VERIFY_WITH_TIMEOUT(s.passCount() >= after + 3, 5000);
+        QVERIFY(s.take());
+        const auto& seq = s.frame().watches.value(7);
+        QVERIFY(!seq.isEmpty());
+        QCOMPARE(seq.last().addr, uint64_t(0x40));
+        QCOMPARE(uint8_t(seq.last().bytes[0]), uint8_t(0));
+    }
+
+    void passHookSeesEveryPass() {
+        auto prov = std::make_shared<TickingProvider>();
+        PageSampler s(prov, 1000);
+        std::atomic<int> calls{0};
+        std::atomic<bool> inOrder{true};
+        s.setPassHook([&](const Provider& pages, qint64) {
+            uint8_t v = 0;
+            pages.read(0x10, &v, 1);
+            // Each pass is one read, so the hook sees passes 1, 2, 3...
+            if (v != uint8_t(calls + 1)) inOrder = false;
+            ++calls;
+        });
+        s.setTarget({0}, {});
+        QTRY_VERIFY_WITH_TIMEOUT(calls >= 10, 5000);
+        s.setPassHook({});
+        const int after = calls;
+        QTest::qWait(20);
+        QCOMPARE(calls.load(), after);   // cleared: no call in flight or after
+        QVERIFY(inOrder);
+    }
+};
+
+QTEST_MAIN(TestPageSampler)
+#include "test_pagesampler.moc"
@@ -0,0 +1,240 @@
+#include <QTest>
+#include <QSignalSpy>
+#include <QThreadPool>
+#include <cstring>
+#include "pointerscan.h"
+#include "scanner.h"
+#include "addressparser.h"
+#include "providers/buffer_provider.h"
+
+using namespace rcx;
+
+namespace {
+
+class RegionProvider : public BufferProvider {
+    QVector<MemoryRegion> m_regions;
+public:
+    RegionProvider(QByteArray data, QVector<MemoryRegion> regions)
+        : BufferProvider(std::move(data), "test")
+        , m_regions(std::move(regions)) {}
+
+    QVector<MemoryRegion> enumerateRegions() const override { return m_regions; }
+};
+
+MemoryRegion region(uint64_t base, uint64_t size, const QString& module = {}) {
+    MemoryRegion r;
+    r.base = base;
+    r.size = size;
+    r.readable = true;
+    r.writable = true;
+    r.moduleName = module;
+    return r;
+}
+
+void put64(QByteArray& mem, uint64_t addr, uint64_t v) {
+    std::memcpy(mem.data() + addr, &v, 8);
+}
+
+// game.exe is two regions at 0x1000..0x3000; the heap is 0x10000..0x20000.
+// The player object lives at `player` and is reached through
+//   [game.exe+0x1100] -> obj, [obj+0x30] -> player, target = player+0x8
+// and, when `direct` is set, also straight from [game.exe+0x1200].
+struct Session {
+    QByteArray            mem;
+    QVector<MemoryRegion> regions;
+    uint64_t              target = 0;
+};
+
+Session makeSession(uint64_t obj, uint64_t player, bool direct) {
+    Session s;
+    s.mem = QByteArray(0x20000, '\0');
+    s.regions = {region(0x1000, 0x1000, QStringLiteral("game.exe")),
+                 region(0x2000, 0x1000, QStringLiteral("game.exe")),
+                 region(0x10000, 0x10000)};
+    put64(s.mem, 0x2100, obj);
+    put64(s.mem, obj + 0x30, player);
+    if (direct) put64(s.mem, 0x2200, player);
+    put64(s.mem, 0x10100, 0x5000);               // lands outside every region
+    put64(s.mem, 0x10204, 0x11000);              // misaligned for 8
+    s.target = player + 0x8;
+    return s;
+}
+
+uint64_t evaluate(const PointerPath& p, const Provider& prov,
+                  const QVector<MemoryRegion>& regions) {
+    AddressParserCallbacks cb;
+    cb.resolveModule = [&regions](const QString& name, bool* ok) -> uint64_t {
+        for (const MemoryRegion& r : regions)
+            if (r.moduleName.compare(name, Qt::CaseInsensitive) == 0) { *ok = true; return r.base; }
+        *ok = false;
+        return 0;
+    };
+    cb.readPointer = [&prov](uint64_t addr, bool* ok) -> uint64_t {
+        uint64_t v = 0;
+        *ok = prov.read(addr, &v, 8);
+        return v;
+    };
+    const AddressParseResult r = AddressParser::evaluate(p.formula(), 8, &cb);
+    return r.ok ? r.value : ~0ull;
+}
+
+PointerPath path(uint64_t moduleOffset, QVector<int64_t> offsets) {
+    PointerPath p;
+    p.module = QStringLiteral("game.exe");
+    p.moduleOffset = moduleOffset;
+    p.offsets = std::move(offsets);
+    return p;
+}
+
+} // namespace
+
+class TestPointerScan : public QObject {
+    Q_OBJECT
+private slots:
+    void mapKeepsAlignedPointersIntoRegions() {
+        const Session s = makeSession(0x10000, 0x18000, true);
+        RegionProvider prov(s.mem, s.regions);
+        QThreadPool pool;
+
+        const PointerMap map = PointerMap::build(prov, s.regions, 8, 0, &pool);
+        QCOMPARE(map.size(), qint64(3));
+        for (const PointerMap::Entry* e = map.begin(); e + 1 < map.end(); ++e)
+            QVERIFY(e->value <= (e + 1)->value);
+        const PointerMap::Entry* e = map.lowerBound(0x10000);
+        QCOMPARE(e->value, uint64_t(0x10000));
+        QCOMPARE(e->addr, uint64_t(0x2100));
+        QVERIFY(map.lowerBound(0x18001) == map.end());
+
+        // A 4-byte stride picks up the misaligned one too; so does the
+        // single-threaded path.
+        QCOMPARE(PointerMap::build(prov, s.regions, 8, 4).size(), qint64(4));
+    }
+
+    void findsStaticPathsShortestFirst() {
+        const Session s = makeSession(0x10000, 0x18000, true);
+        RegionProvider prov(s.mem, s.regions);
+        QThreadPool pool;
+        PointerScanRequest req;
+        req.target = s.target;
+
+        const PointerScanResult r = scanPointerPaths(prov, s.regions, req, &pool);
+        QVERIFY(!r.stats.capped);
+        QCOMPARE(r.stats.pointers, qint64(3));
+        QCOMPARE(r.paths.size(), 2);
+        QCOMPARE(r.paths[0], path(0x1200, {0x8}));
+        QCOMPARE(r.paths[1], path(0x1100, {0x30, 0x8}));
+        QCOMPARE(r.paths[1].formula(), QStringLiteral("[[<game.exe>+0x1100]+0x30]+0x8"));
+        for (const PointerPath& p : r.paths)
+            QCOMPARE(evaluate(p, prov, s.regions), s.target);
+    }
+
+    void depthAndOffsetBound() {
+        const Session s = makeSession(0x10000, 0x18000, true);
+        RegionProvider prov(s.mem, s.regions);
+        PointerScanRequest req;
+        req.target = s.target;
+        const PointerMap map = PointerMap::build(prov, s.regions, 8);
+
+        req.maxDepth = 1;
+        PointerScanResult r = findPointerPaths(map, s.regions, req);
+        QCOMPARE(r.paths.size(), 1);
+        QCOMPARE(r.paths[0].offsets.size(), 1);
+
+        req.maxDepth = 5;
+        req.maxOffset = 0x20;   // the 0x30 hop no longer reaches
+        r = findPointerPaths(map, s.regions, req);
+        QCOMPARE(r.paths.size(), 1);
+
+        req.maxOffset = 0x1000;
+        req.maxResults = 1;
+        r = findPointerPaths(map, s.regions, req);
+        QCOMPARE(r.paths.size(), 1);
+        QVERIFY(r.stats.capped);
+    }
+
+    void cyclesExpandOnce() {
+        // obj points at itself and player points back into obj: neither
+        // loop may be walked more than once.
+        Session s = makeSession(0x10000, 0x18000, false);
+        put64(s.mem, 0x10000, 0x10000);
+        put64(s.mem, 0x18000, 0x10030);
+        RegionProvider prov(s.mem, s.regions);
+        PointerScanRequest req;
+        req.target = s.target;
+        req.maxDepth = 8;
+
+        const PointerScanResult r = scanPointerPaths(prov, s.regions, req);
+        QVERIFY(r.stats.nodesExpanded < 10);
+        QVERIFY(r.paths.contains(path(0x1100, {0x30, 0x8})));
+        for (const PointerPath& p : r.paths)
+            QCOMPARE(evaluate(p, prov, s.regions), s.target);
+    }
+
+    void saveAndIntersectAcrossSessions() {
+        PointerScanRequest req;
+        const Session first = makeSession(0x10000, 0x18000, true);
+        RegionProvider prov1(first.mem, first.regions);
+        req.target = first.target;
+        const PointerScanResult a = scanPointerPaths(prov1, first.regions, req);
+
+        // Round trip through the saved form.
+        PointerScanResult saved;
+        QString err;
+        QVERIFY2(PointerScanResult::fromJson(a.toJson(), &saved, &err), qPrintable(err));
+        QCOMPARE(saved.target, a.target);
+        QCOMPARE(saved.maxOffset, a.maxOffset);
+        QCOMPARE(saved.paths, a.paths);
+        QVERIFY(!PointerScanResult::fromJson(QJsonObject{{"format", "rcx"}}, &saved, &err));
+        QVERIFY(!err.isEmpty());
+
+        // The next run moved the heap and lost the direct pointer.
+        const Session second = makeSession(0x14000, 0x1C000, false);
+        RegionProvider prov2(second.mem, second.regions);
+        req.target = second.target;
+        PointerScanResult b = scanPointerPaths(prov2, second.regions, req);
+        for (PointerPath& p : b.paths)
+            p.module = p.module.toUpper();   // module names vary in case
+
+        const PointerScanResult both = PointerScanResult::intersect(saved, b);
+        QCOMPARE(both.target, second.target);
+        QCOMPARE(both.paths.size(), 1);
+        QCOMPARE(both.paths[0], path(0x1100, {0x30, 0x8}));
+    }
+
+    void abortStopsEarly() {
+        const Session s = makeSession(0x10000, 0x18000, true);
+        RegionProvider prov(s.mem, s.regions);
+        PointerScanRequest req;
+        req.target = s.target;
+        std::atomic<bool> abort{true};
+        int lastPct = -1;
+
+        const PointerScanResult r = scanPointerPaths(prov, s.regions, req, nullptr, &abort,
+                                                     [&lastPct](int pct) { lastPct = pct; });
+        QVERIFY(r.stats.aborted);
+        QVERIFY(r.paths.isEmpty());
+        QVERIFY(lastPct < 100);
+        QVERIFY(!scanPointerPaths(prov, s.regions, req).stats.aborted);
+    }
+
+    void engineRunsAsync() {
+        const Session s = makeSession(0x10000, 0x18000, true);
+        auto prov = std::make_shared<RegionProvider>(s.mem, s.regions);
+        ScanEngine engine;
+        QSignalSpy done(&engine, &ScanEngine::pointerScanFinished);
+        QSignalSpy progress(&engine, &ScanEngine::progress);
+        PointerScanRequest req;
+        req.target = s.target;
+
+        engine.startPointerScan(prov, req);
+        QVERIFY(done.wait(5000));
+        QVERIFY(!engine.isRunning());
+        const auto r = done.at(0).at(0).value<PointerScanResult>();
+        QCOMPARE(r.paths.size(), 2);
+        QVERIFY(!progress.isEmpty());
+        QCOMPARE(progress.last().at(0).toInt(), 100);
+    }
+};
+
+QTEST_MAIN(TestPointerScan)
+#include "test_pointerscan.moc"
@@ -5,10 +5,44 @@
 #include <cstring>
 #include "providers/provider.h"
 #include "providers/buffer_provider.h"
+#include "providers/mapped_file_provider.h"
 #include "providers/null_provider.h"
+#include "providers/snapshot_provider.h"
 
 using namespace rcx;
 
+// Flat buffer at `base` with one unreadable page; logs every read() span so
+// tests can assert how readPagesCoalesced() grouped the pages.
+class SpanLogProvider : public Provider {
+public:
+    uint64_t           base = 0x10000;
+    QByteArray         data;
+    uint64_t           holePage = ~0ULL;
+    mutable QVector<QPair<uint64_t,int>> calls;
+
+    bool read(uint64_t addr, void* buf, int len) const override {
+        calls.append({addr, len});
+        if (addr < base || addr + len > base + (uint64_t)data.size()) return false;
+        if (holePage >= addr && holePage < addr + (uint64_t)len) return false;
+        std::memcpy(buf, data.constData() + (addr - base), len);
+        return true;
+    }
+    int size() const override { return data.size(); }
+};
+
+static QString writeTempFile(const QString& name, const QByteArray& bytes) {
+    QString path = QDir::tempPath() + "/" + name;
+    QFile f(path);
+    if (!f.open(QIODevice::WriteOnly)) return {};
+    f.write(bytes);
+    return path;
+}
+
+static QByteArray fileBytes(const QString& path) {
+    QFile f(path);
+    return f.open(QIODevice::ReadOnly) ? f.readAll() : QByteArray();
+}
+
 class TestProvider : public QObject {
     Q_OBJECT
 
@@ -259,6 +293,169 @@ private slots:
         QFile::remove(path);
     }
 
+    // ---------------------------------------------------------------
+    // MappedFileProvider
+    // ---------------------------------------------------------------
+
+    void mapped_nonexistentOrEmpty() {
+        MappedFileProvider missing("/tmp/__rcx_test_nonexistent_file__");
+        QVERIFY(!missing.isMapped());
+        QVERIFY(!missing.isValid());
+
+        QString path = writeTempFile("rcx_test_mapped_empty.bin", {});
+        MappedFileProvider empty(path);
+        QVERIFY(!empty.isMapped());
+        QCOMPARE(empty.extent(), (uint64_t)0);
+        QFile::remove(path);
+    }
+
+    void mapped_readsAndDirectData() {
+        QByteArray d(3 * 4096 + 10, '\0');
+        for (int i = 0; i < d.size(); ++i) d[i] = char(i * 7);
+        QString path = writeTempFile("rcx_test_mapped_read.bin", d);
+        {
+            MappedFileProvider p(path);
+            QVERIFY(p.isMapped());
+            QCOMPARE(p.size(), d.size());
+            QCOMPARE(p.extent(), (uint64_t)d.size());
+            QCOMPARE(p.name(), QStringLiteral("rcx_test_mapped_read.bin"));
+            QCOMPARE(p.readBytes(4090, 20), d.mid(4090, 20));
+            QVERIFY(!p.read(d.size() - 4, QByteArray(8, '\0').data(), 8));
+
+            const uint8_t* view = p.directData(100, 4096);
+            QVERIFY(view);
+            QCOMPARE(std::memcmp(view, d.constData() + 100, 4096), 0);
+            QVERIFY(!p.directData(d.size() - 4, 8));
+
+            auto regions = p.enumerateRegions();
+            QCOMPARE(regions.size(), 1);
+            QCOMPARE(regions[0].size, (uint64_t)d.size());
+        }
+        QFile::remove(path);
+    }
+
+    void mapped_writeIsCopyOnWriteUntilSave() {
+        QByteArray d(3 * 4096 + 100, char(0x11));
+        QString path = writeTempFile("rcx_test_mapped_cow.bin", d);
+        {
+            MappedFileProvider p(path);
+            QVERIFY(p.isWritable());
+            QVERIFY(!p.isDirty());
+
+            // Straddles the first page boundary and touches the short tail page.
+            QVERIFY(p.writeBytes(4094, QByteArray(4, char(0x22))));
+            QVERIFY(p.writeBytes(3 * 4096 + 99, QByteArray(1, char(0x33))));
+            QVERIFY(!p.writeBytes(3 * 4096 + 99, QByteArray(2, char(0x33))));
+            QVERIFY(p.isDirty());
+
+            QCOMPARE(p.readBytes(4092, 8), QByteArray::fromHex("1111222222221111"));
+            QCOMPARE(p.readU8(3 * 4096 + 99), (uint8_t)0x33);
+            // Edited pages only exist in the overlay; clean ones stay direct.
+            QVERIFY(!p.directData(4000, 200));
+            QVERIFY(!p.directData(3 * 4096, 10));
+            QVERIFY(p.directData(2 * 4096 + 100, 100));
+            QCOMPARE(fileBytes(path), d);   // nothing written yet
+
+            QString err;
+            QVERIFY2(p.save(&err), qPrintable(err));
+            QVERIFY(!p.isDirty());
+            QByteArray expect = d;
+            expect.replace(4094, 4, QByteArray(4, char(0x22)));
+            expect[3 * 4096 + 99] = char(0x33);
+            QCOMPARE(fileBytes(path), expect);
+            // The shared mapping now shows the saved bytes directly.
+            const uint8_t* view = p.directData(4094, 4);
+            QVERIFY(view);
+            QCOMPARE(view[0], (uint8_t)0x22);
+        }
+        QFile::remove(path);
+    }
+
+    void mapped_extentPastTwoGigabytes() {
+        if (sizeof(void*) < 8)
+            QSKIP("needs a 64-bit address space");
+        QString path = QDir::tempPath() + "/rcx_test_mapped_large.bin";
+        const qint64 big = 3LL << 30;
+        {
+            QFile f(path);
+            QVERIFY(f.open(QIODevice::WriteOnly));
+            if (!f.resize(big)) {   // sparse on any sane filesystem
+                f.remove();
+                QSKIP("filesystem refused a 3 GB sparse file");
+            }
+            f.seek(big - 8);
+            const uint64_t tail = 0x1122334455667788ULL;
+            f.write(reinterpret_cast<const char*>(&tail), sizeof(tail));
+        }
+        {
+            MappedFileProvider p(path);
+            if (!p.isMapped()) {
+                QFile::remove(path);
+                QSKIP("could not map 3 GB");
+            }
+            QCOMPARE(p.extent(), (uint64_t)big);
+            QCOMPARE(p.size(), INT_MAX);
+            QVERIFY(p.isReadable((uint64_t)big - 8, 8));
+            QVERIFY(!p.isReadable((uint64_t)big - 4, 8));
+            QCOMPARE(p.readU64((uint64_t)big - 8), 0x1122334455667788ULL);
+            QCOMPARE(p.enumerateRegions().value(0).size, (uint64_t)big);
+        }
+        QFile::remove(path);
+    }
+
+    // ---------------------------------------------------------------
+    // readBatch / readPagesCoalesced
+    // ---------------------------------------------------------------
+
+    void readBatch_defaultLoopsRead() {
+        QByteArray d(16, '\0');
+        for (int i = 0; i < d.size(); ++i) d[i] = char(i);
+        BufferProvider p(d);
+        char a[4] = {}, b[4] = {}, c[4] = {};
+        QVector<ReadSpan> spans = {
+            {2, a, 4, false},
+            {20, b, 4, false},   // past end
+            {12, c, 4, false},
+        };
+        p.readBatch(spans);
+        QVERIFY(spans[0].ok);
+        QVERIFY(!spans[1].ok);
+        QVERIFY(spans[2].ok);
+        QCOMPARE(a[0], char(2));
+        QCOMPARE(c[3], char(15));
+    }
+
+    void readPagesCoalesced_mergesAdjacentPages() {
+        SpanLogProvider p;
+        p.data = QByteArray(8 * 4096, '\0');
+        for (int i = 0; i < p.data.size(); ++i) p.data[i] = char(i / 4096 + 1);
+        // Unsorted input with a gap: pages 0-2 form one run, page 5 another.
+        QVector<uint64_t> pages = {p.base + 2 * 4096, p.base, p.base + 5 * 4096,
+                                   p.base + 4096};
+        auto out = readPagesCoalesced(p, pages);
+        QCOMPARE(p.calls.size(), 2);
+        QCOMPARE(p.calls[0], qMakePair(p.base, 3 * 4096));
+        QCOMPARE(p.calls[1], qMakePair(p.base + 5 * 4096, 4096));
+        QCOMPARE(out.size(), 4);
+        for (uint64_t pg : pages) {
+            QCOMPARE(out.value(pg).size(), 4096);
+            QCOMPARE(out.value(pg)[0], char((pg - p.base) / 4096 + 1));
+        }
+    }
+
+    void readPagesCoalesced_holeOnlyBlanksItsOwnPage() {
+        SpanLogProvider p;
+        p.data = QByteArray(4 * 4096, char(0x5A));
+        p.holePage = p.base + 4096;
+        QVector<uint64_t> pages = {p.base, p.base + 4096, p.base + 2 * 4096};
+        auto out = readPagesCoalesced(p, pages);
+        // One failed 3-page run, then three single-page retries.
+        QCOMPARE(p.calls.size(), 4);
+        QCOMPARE(out.value(p.base), QByteArray(4096, char(0x5A)));
+        QCOMPARE(out.value(p.base + 4096), QByteArray(4096, '\0'));
+        QCOMPARE(out.value(p.base + 2 * 4096), QByteArray(4096, char(0x5A)));
+    }
+
     // ---------------------------------------------------------------
     // Polymorphism -- unique_ptr<Provider> usage
     // ---------------------------------------------------------------
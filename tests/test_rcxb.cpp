@@ -0,0 +1,228 @@
+#include <QTest>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QtEndian>
+#include <cstring>
+#include "core.h"
+#include "rcxb.h"
+
+using namespace rcx;
+
+namespace {
+
+Node makeNode(NodeKind kind, const QString& name, uint64_t parentId, int offset) {
+    Node n;
+    n.kind = kind;
+    n.name = name;
+    n.parentId = parentId;
+    n.offset = offset;
+    return n;
+}
+
+// Two classes exercising every serialized field, plus an orphan.
+NodeTree sampleTree() {
+    NodeTree t;
+    t.baseAddress = 0x140000000;
+    t.baseAddressFormula = QStringLiteral("<game.exe> + 0x100");
+    t.initialClass = QStringLiteral("Player");
+    t.pointerSize = 4;
+    t.bookmarks.append({QStringLiteral("hp"), QStringLiteral("<game.exe>+0x20")});
+
+    Node player = makeNode(NodeKind::Struct, QStringLiteral("player"), 0, 0);
+    player.structTypeName = QStringLiteral("Player");
+    player.classKeyword = QStringLiteral("class");
+    const uint64_t playerId = t.nodes[t.addNode(player)].id;
+
+    Node state = makeNode(NodeKind::Struct, QStringLiteral("State"), 0, 0);
+    state.structTypeName = QStringLiteral("State");
+    state.classKeyword = QStringLiteral("enum");
+    state.enumMembers = {{QStringLiteral("Idle"), 0}, {QStringLiteral("Dead"), -1}};
+    const uint64_t stateId = t.nodes[t.addNode(state)].id;
+
+    Node hp = makeNode(NodeKind::Float, QStringLiteral("health"), playerId, 0x10);
+    hp.comment = QStringLiteral("clamped to [0, 100]");
+    hp.bigEndian = true;
+    t.addNode(hp);
+
+    Node ptr = makeNode(NodeKind::Pointer64, QStringLiteral("state"), playerId, 0x18);
+    ptr.refId = stateId;
+    ptr.isRelative = true;
+    t.addNode(ptr);
+
+    Node flags = makeNode(NodeKind::Struct, QStringLiteral("flags"), stateId, 4);
+    flags.classKeyword = QStringLiteral("bitfield");
+    flags.elementKind = NodeKind::UInt32;
+    flags.bitfieldMembers = {{QStringLiteral("alive"), 0, 1}, {QStringLiteral("team"), 1, 3}};
+    t.addNode(flags);
+
+    Node arr = makeNode(NodeKind::Array, QStringLiteral("ammo"), playerId, 0x20);
+    arr.arrayLen = 6;
+    arr.elementKind = NodeKind::UInt16;
+    t.addNode(arr);
+
+    Node name = makeNode(NodeKind::UTF16, QStringLiteral("name"), playerId, 0x30);
+    name.strLen = 32;
+    t.addNode(name);
+
+    Node depth = makeNode(NodeKind::Pointer32, QStringLiteral("pp"), playerId, 0x70);
+    depth.ptrDepth = 2;
+    depth.elementKind = NodeKind::Int32;
+    t.addNode(depth);
+
+    t.addNode(makeNode(NodeKind::Hex32, QStringLiteral("lost"), 9999, 0));
+    return t;
+}
+
+QByteArray jsonOf(const NodeTree& t) {
+    return QJsonDocument(t.toJson()).toJson(QJsonDocument::Compact);
+}
+
+QString findExample(const QString& name) {
+    for (const QString& c : {
+             QCoreApplication::applicationDirPath() + "/examples/" + name,
+             QCoreApplication::applicationDirPath() + "/../src/examples/" + name,
+             QStringLiteral("src/examples/") + name,
+             QStringLiteral("../src/examples/") + name})
+        if (QFileInfo::exists(c)) return c;
+    return {};
+}
+
+} // namespace
+
+class TestRcxb : public QObject {
+    Q_OBJECT
+private slots:
+    void roundTripMatchesJson() {
+        const NodeTree t = sampleTree();
+        QJsonObject extras;
+        extras["typeAliases"] = QJsonObject{{"Float", "f32"}};
+        const QByteArray bin = encodeRcxb(t, extras);
+        QVERIFY(isRcxb(bin));
+
+        RcxbReader r;
+        QString err;
+        QVERIFY2(r.openBytes(bin, &err), qPrintable(err));
+        QCOMPARE(r.nodeCount(), t.nodes.size());
+        QCOMPARE(r.meta()["typeAliases"].toObject()["Float"].toString(), QStringLiteral("f32"));
+
+        const NodeTree back = r.readTree();
+        QCOMPARE(jsonOf(back), jsonOf(NodeTree::fromJson(t.toJson())));
+        QCOMPARE(back.m_nextId, t.m_nextId);
+        QCOMPARE(back.bookmarks.size(), 1);
+    }
+
+    void classIndexReadsOneSubtree() {
+        const NodeTree t = sampleTree();
+        RcxbReader r;
+        QVERIFY(r.openBytes(encodeRcxb(t)));
+        QCOMPARE(r.classCount(), 2);   // the orphan belongs to no class
+
+        const int player = r.findClass(QStringLiteral("Player"));
+        const int state = r.findClass(QStringLiteral("State"));
+        QCOMPARE(player, 0);
+        QCOMPARE(state, 1);
+        QCOMPARE(r.findClass(QStringLiteral("Nope")), -1);
+        QCOMPARE(r.classInfo(player).nodeCount, 6);
+
+        const QVector<Node> nodes = r.readClass(state);
+        QCOMPARE(nodes.size(), 2);
+        QCOMPARE(nodes[0].id, r.classInfo(state).id);
+        QCOMPARE(nodes[0].enumMembers.size(), 2);
+        QCOMPARE(nodes[0].enumMembers[1].second, int64_t(-1));
+        QCOMPARE(nodes[1].bitfieldMembers[1].name, QStringLiteral("team"));
+        QCOMPARE(nodes[1].bitfieldMembers[1].bitWidth, uint8_t(3));
+        QVERIFY(r.readClass(2).isEmpty());
+    }
+
+    void skeletonDefersClassBodies() {
+        const NodeTree t = sampleTree();
+        RcxbReader r;
+        QVERIFY(r.openBytes(encodeRcxb(t)));
+
+        // Two class roots and the orphan; new ids still start past the file.
+        const NodeTree skel = r.readSkeleton();
+        QCOMPARE(skel.nodes.size(), 3);
+        QCOMPARE(skel.nodes[0].structTypeName, QStringLiteral("Player"));
+        QCOMPARE(skel.nodes[2].name, QStringLiteral("lost"));
+        QCOMPARE(skel.m_nextId, t.m_nextId);
+        QCOMPARE(skel.baseAddressFormula, t.baseAddressFormula);
+
+        const int player = r.findClass(QStringLiteral("Player"));
+        const QVector<Node> body = r.readClassBody(player);
+        QCOMPARE(body.size(), r.classInfo(player).nodeCount - 1);
+        for (const Node& n : body) QCOMPARE(n.parentId, r.classInfo(player).id);
+
+        // Skeleton plus every body is the whole tree.
+        const QVector<QVector<Node>> bodies = r.readClassBodies({0, 1, 7});
+        QCOMPARE(bodies.size(), 3);
+        QVERIFY(bodies[2].isEmpty());
+        QCOMPARE(skel.nodes.size() + bodies[0].size() + bodies[1].size(), t.nodes.size());
+        QCOMPARE(bodies[0][0].comment, body[0].comment);
+    }
+
+    void examplesRoundTrip() {
+        int checked = 0;
+        for (const char* name : {"EPROCESS.rcx", "MMPFN.rcx", "PE_Headers.rcx", "png.rcx"}) {
+            const QString path = findExample(QString::fromLatin1(name));
+            if (path.isEmpty()) continue;
+            QFile f(path);
+            QVERIFY(f.open(QIODevice::ReadOnly));
+            const QJsonObject root = QJsonDocument::fromJson(f.readAll()).object();
+            const NodeTree t = NodeTree::fromJson(root);
+
+            QJsonObject extras = root;
+            extras.remove(QStringLiteral("nodes"));
+            RcxbReader r;
+            QVERIFY(r.openBytes(encodeRcxb(t, extras)));
+            QCOMPARE(jsonOf(r.readTree()), jsonOf(t));
+            QCOMPARE(r.meta().value("savedSources"), root.value("savedSources"));
+            ++checked;
+        }
+        if (!checked) QSKIP("bundled examples not found");
+    }
+
+    void mapsFromDisk() {
+        const QString path = QDir::tempPath() + "/rcx_test_project.rcxb";
+        {
+            QFile f(path);
+            QVERIFY(f.open(QIODevice::WriteOnly));
+            f.write(encodeRcxb(sampleTree()));
+        }
+        {
+            RcxbReader r;
+            QString err;
+            QVERIFY2(r.open(path, &err), qPrintable(err));
+            QCOMPARE(r.readTree().nodes.size(), sampleTree().nodes.size());
+        }
+        QFile::remove(path);
+    }
+
+    void rejectsDamagedFiles() {
+        const QByteArray bin = encodeRcxb(sampleTree());
+        RcxbReader r;
+        QString err;
+        QVERIFY(!r.openBytes(QByteArray("{\"nodes\":[]}"), &err));
+        QVERIFY(!err.isEmpty());
+        QVERIFY(!r.openBytes(bin.left(200), &err));
+
+        QByteArray badVersion = bin;
+        badVersion[4] = 9;
+        QVERIFY(!r.openBytes(badVersion, &err));
+
+        // Garbage string ids and kinds decode as empty / Hex8, not a crash.
+        QByteArray junk = bin;
+        const uint64_t nodeOff = qFromLittleEndian<uint64_t>(junk.constData() + 48);
+        std::memset(junk.data() + nodeOff + 24, 0xff, 4);
+        junk[int(nodeOff + 52)] = char(0xfe);
+        QVERIFY(r.openBytes(junk, &err));
+        const NodeTree t = r.readTree();
+        QVERIFY(t.nodes[0].name.isEmpty());
+        QCOMPARE(t.nodes[0].kind, NodeKind::Hex8);
+    }
+};
+
+QTEST_MAIN(TestRcxb)
+#include "test_rcxb.moc"
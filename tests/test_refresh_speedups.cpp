@@ -8,12 +8,15 @@
 //   4. permanent .rdata page cache   — pages in module-executable regions
 //                                      are read once per attach, never again
 //
+// Plus a dereferencing base formula following its pointer chain from the
+// same batched read.
 // Plus the adaptive refresh interval (idle backoff + focus/visibility).
 
 #include <QtTest/QTest>
 #include <QtTest/QSignalSpy>
 #include <QApplication>
 #include <QSplitter>
+#include <QElapsedTimer>
 #include <Qsci/qsciscintilla.h>
 #include <atomic>
 #include <chrono>
@@ -48,8 +51,10 @@ public:
     bool read(uint64_t addr, void* buf, int len) const override {
         if (addr + (uint64_t)len > (uint64_t)data.size()) return false;
         std::memcpy(buf, data.constData() + addr, len);
-        // Tally by page so a single 4 KB readBytes call counts as one.
-        readsPerPage[addr & ~uint64_t(4095)]++;
+        // Tally every page the span touches — the refresh coalesces
+        // adjacent pages into one read, which must still count per page.
+        for (uint64_t p = addr & ~uint64_t(4095); p < addr + (uint64_t)len; p += 4096)
+            readsPerPage[p]++;
         totalReads.fetch_add(1, std::memory_order_relaxed);
         return true;
     }
@@ -168,9 +173,11 @@ private:
     // — no race window between construction and the first refresh.
     void setupWithProvider(bool withPointer,
                            bool pointerCollapsed = true,
-                           uint64_t pointerTargetAddr = 0) {
+                           uint64_t pointerTargetAddr = 0,
+                           const QString& baseFormula = QString()) {
         m_doc = new RcxDocument();
         buildTree(m_doc->tree, withPointer, pointerCollapsed);
+        m_doc->tree.baseAddressFormula = baseFormula;
         auto prov = std::make_shared<CountingProvider>();
         m_prov = prov.get();
         // Pre-populate pointer bytes BEFORE the controller is born so
@@ -252,6 +259,26 @@ private slots:
                     if (a[i] != b[i]) { want.insert(int64_t(pageAddr) + i); wc = true; }
                 QCOMPARE(gc, wc);
                 QCOMPARE(got, want);
+
+                // The bitmap form holds the same set; probe it per byte and
+                // through the range queries refresh() uses.
+                ChangeBitmap bits;
+                QCOMPARE(diffPageInto(bits, pageAddr,
+                                      a.constData(), b.constData(), len), wc);
+                QCOMPARE(bits.count(), want.size());
+                const int64_t base = int64_t(pageAddr);
+                for (int i = 0; i < len; ++i)
+                    QCOMPARE(bits.test(base + i), want.contains(base + i));
+                const int lo = len ? int(rng() % len) : 0;
+                const int hi = lo + int(rng() % 80);
+                bool anyWant = false;
+                QVector<int64_t> listed, listWant;
+                for (int64_t o = base + lo; o < base + hi; ++o)
+                    if (want.contains(o)) { anyWant = true; listWant.append(o); }
+                bits.forEachInRange(base + lo, base + hi,
+                                    [&](int64_t o) { listed.append(o); });
+                QCOMPARE(bits.anyInRange(base + lo, base + hi), anyWant);
+                QCOMPARE(listed, listWant);
             }
         }
 
@@ -266,6 +293,66 @@ private slots:
         QCOMPARE(s.size(), 4096);
     }
 
+    // ── Change bitmap vs QSet on synthetic churn ──
+    // 64 pages, a quarter of their dwords rewritten each tick, then one
+    // refresh()'s worth of line marking: an 8-byte field per dword plus a
+    // 64-byte struct span per cache line. Both forms must mark the same
+    // lines; the timings are printed side by side.
+    void benchChangeBitmapVsSet() {
+        const int kPages = 64, kTicks = 50;
+        std::mt19937 rng(0xBADC0DEu);
+        QVector<QByteArray> prev(kPages), next(kPages);
+        for (int p = 0; p < kPages; ++p) {
+            prev[p] = QByteArray(4096, '\0');
+            for (int i = 0; i < 4096; ++i) prev[p][i] = char(rng() & 0xFF);
+        }
+
+        qint64 setNs = 0, bitNs = 0;
+        for (int tick = 0; tick < kTicks; ++tick) {
+            for (int p = 0; p < kPages; ++p) {
+                next[p] = prev[p];
+                for (int d = 0; d < 1024; ++d)
+                    if (rng() % 4 == 0) {
+                        const uint32_t v = rng();
+                        std::memcpy(next[p].data() + d * 4, &v, 4);
+                    }
+            }
+
+            QElapsedTimer t;
+            t.start();
+            QSet<int64_t> set;
+            for (int p = 0; p < kPages; ++p)
+                diffPageInto(set, uint64_t(p) * 4096,
+                             prev[p].constData(), next[p].constData(), 4096);
+            int setMarked = 0;
+            for (int64_t o = 0; o < kPages * 4096; o += 8)
+                for (int64_t b = o; b < o + 8; ++b)
+                    if (set.contains(b)) { ++setMarked; break; }
+            for (int64_t o = 0; o < kPages * 4096; o += 64)
+                for (int64_t b = o; b < o + 64; ++b)
+                    if (set.contains(b)) { ++setMarked; break; }
+            setNs += t.nsecsElapsed();
+
+            t.restart();
+            ChangeBitmap bits;
+            for (int p = 0; p < kPages; ++p)
+                diffPageInto(bits, uint64_t(p) * 4096,
+                             prev[p].constData(), next[p].constData(), 4096);
+            int bitMarked = 0;
+            for (int64_t o = 0; o < kPages * 4096; o += 8)
+                bitMarked += bits.anyInRange(o, o + 8);
+            for (int64_t o = 0; o < kPages * 4096; o += 64)
+                bitMarked += bits.anyInRange(o, o + 64);
+            bitNs += t.nsecsElapsed();
+
+            QCOMPARE(bitMarked, setMarked);
+            QCOMPARE(bits.count(), set.size());
+            std::swap(prev, next);
+        }
+        qDebug("change tracking, %d ticks x %d pages: QSet %.2f ms, bitmap %.2f ms",
+               kTicks, kPages, setNs / 1e6, bitNs / 1e6);
+    }
+
     // ── Speedup 4: permanent .rdata cache ───────────────────────────
     // After the first refresh, pages in the module's executable region
     // get marked permanent on the SnapshotProvider. Subsequent ticks
@@ -394,6 +481,78 @@ private slots:
         QCOMPARE(reads, 0);
     }
 
+    // ── Live base formula: the view follows a moving pointer chain ──
+    // The formula reads a pointer in the heap; when the "game" moves the
+    // object, the next tick re-runs the compiled formula against the page
+    // it already read and re-bases the view, without an undo entry.
+    void baseFormulaFollowsPointerChain() {
+        const uint64_t slot = CountingProvider::kHeapBase + 0x100;
+        const uint64_t first = CountingProvider::kHeapBase + 0x1000;
+        const uint64_t moved = CountingProvider::kHeapBase + 0x3000;
+        setupWithProvider(/*withPointer=*/false, true, 0,
+                          QStringLiteral("[%1]").arg(slot, 0, 16));
+        std::memcpy(m_prov->data.data() + slot, &first, sizeof(first));
+        QVERIFY(waitForOneTick());
+        QTRY_COMPARE_WITH_TIMEOUT(m_doc->tree.baseAddress, first, 2000);
+
+        std::memcpy(m_prov->data.data() + slot, &moved, sizeof(moved));
+        m_prov->resetCounters();
+        QTRY_COMPARE_WITH_TIMEOUT(m_doc->tree.baseAddress, moved, 2000);
+        // The slot's page came in with the tick's batch.
+        QVERIFY(m_prov->readsPerPage.value(slot & ~uint64_t(4095), 0) >= 1);
+        QCOMPARE(m_doc->undoStack.count(), 0);
+    }
+
+    // ── Base formula under the page sampler ──
+    // Sampled frames go through the same chain: the slot's page is in the
+    // sampler's target and a move retargets it.
+    void baseFormulaFollowsChainUnderSampler() {
+        const uint64_t slot = CountingProvider::kHeapBase + 0x100;
+        const uint64_t first = CountingProvider::kHeapBase + 0x1000;
+        const uint64_t moved = CountingProvider::kHeapBase + 0x3000;
+        setupWithProvider(/*withPointer=*/false, true, 0,
+                          QStringLiteral("[%1]").arg(slot, 0, 16));
+        std::memcpy(m_prov->data.data() + slot, &first, sizeof(first));
+        m_ctrl->setSamplerRate(200);
+        QTRY_COMPARE_WITH_TIMEOUT(m_doc->tree.baseAddress, first, 3000);
+
+        std::memcpy(m_prov->data.data() + slot, &moved, sizeof(moved));
+        QTRY_COMPARE_WITH_TIMEOUT(m_doc->tree.baseAddress, moved, 3000);
+        QCOMPARE(m_doc->undoStack.count(), 0);
+        m_ctrl->setSamplerRate(0);
+    }
+
+    // ── Value-only ticks at a non-zero base ──
+    // The page diff records absolute addresses; the view lives at
+    // kHeapBase, so a field's bytes must be looked up by address or the
+    // row freezes and its history never grows.
+    void valueTicksTrackFieldsAtNonZeroBase() {
+        setupWithProvider(/*withPointer=*/false);
+        uint64_t u32Id = 0;
+        for (const Node& n : m_doc->tree.nodes)
+            if (n.name == QLatin1String("u32")) u32Id = n.id;
+        QVERIFY(u32Id != 0);
+        auto rowText = [&]() {
+            const ComposeResult& r = m_ctrl->lastResult();
+            for (int i = 0; i < r.meta.size(); ++i)
+                if (r.meta[i].nodeId == u32Id)
+                    return r.text.split('\n').value(i);
+            return QString();
+        };
+        // Past the post-attach tracking cooldown.
+        for (int i = 0; i < 6; ++i)
+            QVERIFY(waitForOneTick());
+        QTRY_VERIFY_WITH_TIMEOUT(m_ctrl->valueHistory().value(u32Id).count >= 1, 2000);
+
+        const QString before = rowText();
+        for (uint32_t v = 1; v <= 3; ++v) {
+            std::memcpy(m_prov->data.data() + CountingProvider::kHeapBase, &v, sizeof(v));
+            QTRY_VERIFY_WITH_TIMEOUT(m_ctrl->valueHistory().value(u32Id).count >= int(v) + 1, 2000);
+        }
+        QCOMPARE(m_ctrl->valueHistory().value(u32Id).heatLevel(), 2);
+        QTRY_VERIFY_WITH_TIMEOUT(rowText() != before, 2000);
+    }
+
     // ── Adaptive refresh: focus / visibility / idle backoff ────────
     void adaptiveBackoffWidensInterval() {
         setupWithProvider(/*withPointer=*/false);
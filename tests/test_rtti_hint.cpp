@@ -117,6 +117,7 @@ public:
 
     bool read(uint64_t addr, void* buf, int len) const override {
         ++m_readCalls;
+        if (addr < m_holeEnd && addr + (uint64_t)len > m_holeBase) return false;
         return BufferProvider::read(addr, buf, len);
     }
 
@@ -124,6 +125,8 @@ public:
     // fixture). A wider module lets many DISTINCT candidate values land inside
     // it, exercising the per-candidate findOwningModule path.
     void setModule(uint64_t base, uint64_t size) const { m_modBase = base; m_modSize = size; }
+    // Reads touching [base, base + size) fail, like a page not yet paged in.
+    void setUnreadable(uint64_t base, uint64_t size) const { m_holeBase = base; m_holeEnd = base + size; }
 
     int enumCalls() const { return m_enumCalls; }
     int readCalls() const { return m_readCalls; }
@@ -134,6 +137,8 @@ private:
     mutable int m_readCalls = 0;
     mutable uint64_t m_modBase = kImageBase;
     mutable uint64_t m_modSize = 0x10000;
+    mutable uint64_t m_holeBase = 0;
+    mutable uint64_t m_holeEnd = 0;
 };
 
 // Build a minimal NodeTree with `nFields` Hex64 fields in a root struct.
@@ -309,6 +314,112 @@ private slots:
                 .arg(prov.enumCalls()).arg(kFieldCount).arg(kPasses)));
     }
 
+    // ── Cross-refresh cache ──
+    // With a long-lived RttiCache the walks happen on the first pass only:
+    // later passes over the same candidates (the negative ones included)
+    // read just the fields themselves.
+    void persistentCacheSkipsRewalksAcrossPasses() {
+        constexpr uint64_t kImg        = 0x10000;
+        constexpr uint64_t kModSize    = 0x100000;
+        constexpr uint64_t kStructBase = 0x130000;
+        constexpr int kFieldCount = 48;
+
+        QByteArray data(kStructBase + 0x1000, '\0');
+        const uint64_t fill = kImg + 0x500;
+        for (uint64_t off = kImg; off + 8 <= kImg + kModSize; off += 8)
+            std::memcpy(data.data() + off, &fill, 8);
+        for (int i = 0; i < kFieldCount; i++) {
+            uint64_t cand = kImg + 0x1000 + (uint64_t)i * 0x40;
+            std::memcpy(data.data() + kStructBase + i * 8, &cand, 8);
+        }
+        FakeModuleProvider prov(std::move(data), QStringLiteral("syn"));
+        prov.setModule(kImg, kModSize);
+        NodeTree tree = buildTreeWithHexFields(kStructBase, kFieldCount);
+
+        prov.resetCounts();
+        compose(tree, prov);
+        const int uncachedReads = prov.readCalls();
+
+        RttiCache cache;
+        auto pass = [&]() {
+            return compose(tree, prov, 0, false, false, false, false, true, {},
+                           /*showRtti=*/true, /*showEnumChips=*/true, &cache);
+        };
+        pass();
+        QVERIFY(cache.size() >= kFieldCount);   // every miss is remembered
+        prov.resetCounts();
+        for (int p = 0; p < 5; p++) pass();
+        const int warmReads = prov.readCalls() / 5;
+        qInfo("PROFILE: %d candidates: %d reads/pass uncached, %d warm",
+              kFieldCount, uncachedReads, warmReads);
+        QVERIFY2(warmReads * 4 < uncachedReads,
+            qPrintable(QStringLiteral("warm pass read %1×, uncached %2×")
+                .arg(warmReads).arg(uncachedReads)));
+    }
+
+    void persistentCacheDropsEntriesWhenModulesChange() {
+        QByteArray data = buildAddressSpaceWithRtti();
+        constexpr uint64_t kStructBase = 0x30000;
+        uint64_t vtableVa = kImageBase + 0x1000;
+        std::memcpy(data.data() + kStructBase, &vtableVa, 8);
+        FakeModuleProvider prov(std::move(data), QStringLiteral("synthetic"));
+        NodeTree tree = buildTreeWithHexFields(kStructBase, 1);
+
+        RttiCache cache;
+        auto hasChip = [&]() {
+            ComposeResult r = compose(tree, prov, 0, false, false, false, false,
+                                      true, {}, true, true, &cache);
+            for (const auto& lm : r.meta)
+                if (lm.offsetAddr == kStructBase && findChip(lm, ChipKind::Rtti))
+                    return true;
+            return false;
+        };
+        QVERIFY(hasChip());
+
+        // The module moves (unloaded + something else mapped): the cached
+        // positive must not survive the re-enumeration.
+        prov.setModule(0x200000, 0x10000);
+        prov.invalidateModuleCache();
+        QVERIFY(!hasChip());
+
+        prov.setModule(kImageBase, 0x10000);
+        prov.invalidateModuleCache();
+        QVERIFY(hasChip());
+
+        cache.clear();                  // what a re-attach does
+        QCOMPARE(cache.size(), 0);
+        QVERIFY(hasChip());
+    }
+
+    void persistentCacheRetriesFailedReads() {
+        // The COL sits on a page that can't be read yet: the walk fails on
+        // the read, which must not be remembered as "not RTTI" — once the
+        // page reads, the next pass finds the class.
+        QByteArray data = buildAddressSpaceWithRtti();
+        constexpr uint64_t kStructBase = 0x30000;
+        uint64_t vtableVa = kImageBase + 0x1000;
+        std::memcpy(data.data() + kStructBase, &vtableVa, 8);
+        FakeModuleProvider prov(std::move(data), QStringLiteral("synthetic"));
+        prov.setUnreadable(kImageBase + 0x1900, 0x100);   // the COL
+        NodeTree tree = buildTreeWithHexFields(kStructBase, 1);
+
+        RttiCache cache;
+        auto hasChip = [&]() {
+            ComposeResult r = compose(tree, prov, 0, false, false, false, false,
+                                      true, {}, true, true, &cache);
+            for (const auto& lm : r.meta)
+                if (lm.offsetAddr == kStructBase && findChip(lm, ChipKind::Rtti))
+                    return true;
+            return false;
+        };
+        QVERIFY(!hasChip());
+        QVERIFY(!cache.find(vtableVa));
+
+        prov.setUnreadable(0, 0);
+        QVERIFY(hasChip());
+        QVERIFY(cache.find(vtableVa));
+    }
+
     void itaniumAutoDetectFallsBack() {
         // Build an Itanium-shaped vtable in a buffer; compose's MSVC walker
         // will reject it (no COL signature), then the Itanium fallback in
@@ -0,0 +1,235 @@
+#include <QTest>
+#include <QByteArray>
+#include <QRandomGenerator>
+#include <QVector>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include "scankernels.h"
+
+using namespace rcx;
+
+// Reference matchers — the per-position loops scanner.cpp ran before the
+// kernels existed. Every level must agree with these hit-for-hit.
+
+static int refEqual(const uint8_t* d, int from, int last, int align,
+                    const uint8_t* pat, int width) {
+    for (int i = from; i <= last; i += align) {
+        bool match = true;
+        for (int j = 0; j < width; j++)
+            if (d[i + j] != pat[j]) { match = false; break; }
+        if (match) return i;
+    }
+    return -1;
+}
+
+static int refMasked(const uint8_t* d, int from, int last, int align,
+                     const uint8_t* pat, const uint8_t* msk, int n) {
+    for (int i = from; i <= last; i += align) {
+        bool match = true;
+        for (int j = 0; j < n; j++)
+            if ((d[i + j] & msk[j]) != (pat[j] & msk[j])) { match = false; break; }
+        if (match) return i;
+    }
+    return -1;
+}
+
+// Mirrors compareTyped(): (a > b) - (a < b) on the decoded values.
+template <typename T>
+static int cmp3(const uint8_t* a, const uint8_t* b) {
+    T va, vb;
+    memcpy(&va, a, sizeof(T));
+    memcpy(&vb, b, sizeof(T));
+    return (va > vb) - (va < vb);
+}
+
+static int cmpLane(LaneType t, const uint8_t* a, const uint8_t* b) {
+    switch (t) {
+    case LaneType::I32: return cmp3<int32_t>(a, b);
+    case LaneType::U32: return cmp3<uint32_t>(a, b);
+    case LaneType::F32: return cmp3<float>(a, b);
+    case LaneType::I64: return cmp3<int64_t>(a, b);
+    case LaneType::U64: return cmp3<uint64_t>(a, b);
+    case LaneType::F64: return cmp3<double>(a, b);
+    }
+    return 0;
+}
+
+static int refRange(const uint8_t* d, int from, int last, int align, LaneType t,
+                    RangeOp op, const uint8_t* lo, const uint8_t* hi) {
+    for (int i = from; i <= last; i += align) {
+        int cLo = cmpLane(t, d + i, lo);
+        bool ok = false;
+        if (op == RangeOp::Greater)   ok = cLo > 0;
+        else if (op == RangeOp::Less) ok = cLo < 0;
+        else                          ok = cLo >= 0 && cmpLane(t, d + i, hi) <= 0;
+        if (ok) return i;
+    }
+    return -1;
+}
+
+class TestScanKernels : public QObject {
+    Q_OBJECT
+
+    QRandomGenerator m_rng{0x5CA11u};
+    QVector<SimdLevel> m_levels;
+
+    int pick(int n) { return (int)m_rng.bounded(n); }
+
+    // Small alphabet so random buffers are dense with hits and near-misses;
+    // every eighth byte is fully random.
+    QByteArray randomBuffer(int len) {
+        QByteArray b(len, Qt::Uninitialized);
+        const int alphabet = 1 + pick(4);
+        for (int i = 0; i < len; ++i)
+            b[i] = (char)(pick(8) == 0 ? pick(256) : pick(alphabet));
+        return b;
+    }
+
+    int randomAlignment() {
+        static const int kAligns[] = {1, 2, 3, 4, 8, 12, 16, 32, 64};
+        return kAligns[pick(9)];
+    }
+
+    static const uint8_t* u8(const QByteArray& b) {
+        return reinterpret_cast<const uint8_t*>(b.constData());
+    }
+
+private slots:
+    void initTestCase() {
+        m_levels << SimdLevel::Scalar;
+        if (cpuSimdLevel() >= SimdLevel::SSE2) m_levels << SimdLevel::SSE2;
+        if (cpuSimdLevel() >= SimdLevel::AVX2) m_levels << SimdLevel::AVX2;
+        qDebug() << "kernel levels under test:" << m_levels.size();
+    }
+
+    void gridMask_selectsAlignedLanes() {
+        QCOMPARE(detail::gridMask(8, 4, 4),  0xFFu);
+        QCOMPARE(detail::gridMask(8, 4, 8),  0x55u);
+        QCOMPARE(detail::gridMask(16, 1, 4), 0x1111u);
+        QCOMPARE(detail::gridMask(4, 8, 16), 0x5u);
+    }
+
+    void equal_findsEveryAlignedHitInOrder() {
+        // Int32 12345 at every 4th dword in a 1 KB buffer; walk all hits.
+        QByteArray buf(1024, '\0');
+        const int32_t v = 12345;
+        for (int off = 16; off + 4 <= buf.size(); off += 64)
+            memcpy(buf.data() + off, &v, 4);
+        for (SimdLevel lvl : m_levels) {
+            int n = 0;
+            for (int i = 0; ; ) {
+                int hit = findEqual(u8(buf), i, buf.size() - 4, 4,
+                                    reinterpret_cast<const uint8_t*>(&v), 4, lvl);
+                if (hit < 0) break;
+                QCOMPARE(hit, 16 + 64 * n);
+                ++n;
+                i = hit + 4;
+            }
+            QCOMPARE(n, 16);
+        }
+    }
+
+    void equal_fuzz() {
+        for (int iter = 0; iter < 20000; ++iter) {
+            const int width = pick(2) ? 4 : 8;
+            const int len = width + pick(300);
+            QByteArray buf = randomBuffer(len);
+            uint8_t pat[8];
+            memcpy(pat, buf.constData() + pick(len - width + 1), width);
+            if (pick(4) == 0) pat[pick(width)] ^= 1;
+            const int align = randomAlignment();
+            const int last = len - width;
+            const int from = pick(last + 1);
+            const int expect = refEqual(u8(buf), from, last, align, pat, width);
+            for (SimdLevel lvl : m_levels)
+                QCOMPARE(findEqual(u8(buf), from, last, align, pat, width, lvl), expect);
+        }
+    }
+
+    void masked_fuzz() {
+        for (int iter = 0; iter < 20000; ++iter) {
+            const int patLen = 1 + pick(24);
+            const int len = patLen + pick(300);
+            QByteArray buf = randomBuffer(len);
+            const int src = pick(len - patLen + 1);
+            uint8_t pat[24], msk[24];
+            for (int j = 0; j < patLen; j++) {
+                pat[j] = (uint8_t)buf[src + j];
+                const int kind = pick(4);   // wildcard / partial nibble mask / exact
+                msk[j] = kind == 0 ? 0x00 : kind == 1 ? (uint8_t)pick(256) : 0xFF;
+                if (pick(6) == 0) pat[j] ^= (uint8_t)pick(256);
+            }
+            const int align = randomAlignment();
+            const int last = len - patLen;
+            const int from = pick(last + 1);
+            const int expect = refMasked(u8(buf), from, last, align, pat, msk, patLen);
+            for (SimdLevel lvl : m_levels)
+                QCOMPARE(findMasked(u8(buf), from, last, align, pat, msk, patLen, lvl), expect);
+        }
+    }
+
+    void masked_allWildcardsMatchFirstAlignedPosition() {
+        QByteArray buf = randomBuffer(100);
+        const uint8_t pat[3] = {1, 2, 3};
+        const uint8_t msk[3] = {0, 0, 0};
+        for (SimdLevel lvl : m_levels) {
+            QCOMPARE(findMasked(u8(buf), 5, 97, 4, pat, msk, 3, lvl), 5);
+            QCOMPARE(findMasked(u8(buf), 98, 97, 4, pat, msk, 3, lvl), -1);
+        }
+    }
+
+    void range_fuzz() {
+        const float  fSpecial[] = {std::numeric_limits<float>::quiet_NaN(),
+                                   std::numeric_limits<float>::infinity(),
+                                   -std::numeric_limits<float>::infinity(),
+                                   0.0f, -0.0f, 1e-40f /* denormal */};
+        const double dSpecial[] = {std::numeric_limits<double>::quiet_NaN(),
+                                   std::numeric_limits<double>::infinity(),
+                                   -0.0, 1e-310 /* denormal */};
+        const int64_t iSpecial[] = {INT64_MIN, INT64_MAX, -1, 0};
+        for (int iter = 0; iter < 30000; ++iter) {
+            const LaneType t = (LaneType)pick(6);
+            const RangeOp op = (RangeOp)pick(3);
+            const int w = laneWidth(t);
+            const int len = w + pick(300);
+            QByteArray buf = randomBuffer(len);
+            // Sprinkle NaN / inf / denormal / extreme ints at arbitrary offsets.
+            for (int k = 0; k < 4; k++) {
+                char* at = buf.data() + pick(len - w + 1);
+                if (t == LaneType::F32)      memcpy(at, &fSpecial[pick(6)], 4);
+                else if (t == LaneType::F64) memcpy(at, &dSpecial[pick(4)], 8);
+                else                         memcpy(at, &iSpecial[pick(4)], w);
+            }
+            uint8_t lo[8], hi[8];
+            memcpy(lo, buf.constData() + pick(len - w + 1), w);
+            memcpy(hi, buf.constData() + pick(len - w + 1), w);
+            const int align = randomAlignment();
+            const int last = len - w;
+            const int from = pick(last + 1);
+            const int expect = refRange(u8(buf), from, last, align, t, op, lo, hi);
+            for (SimdLevel lvl : m_levels)
+                QCOMPARE(findInRange(u8(buf), from, last, align, t, op, lo, hi, lvl), expect);
+        }
+    }
+
+    void range_nanSemanticsMatchCompareTyped() {
+        // NaN is never Greater/Less, but compareTyped reports 0 for it, so
+        // it satisfies Between.
+        QByteArray buf(64, '\0');
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        memcpy(buf.data() + 8, &nan, 4);
+        const float lo = 1.0f, hi = 2.0f;
+        const uint8_t* l = reinterpret_cast<const uint8_t*>(&lo);
+        const uint8_t* h = reinterpret_cast<const uint8_t*>(&hi);
+        for (SimdLevel lvl : m_levels) {
+            QCOMPARE(findInRange(u8(buf), 0, 60, 4, LaneType::F32, RangeOp::Greater, l, h, lvl), -1);
+            QCOMPARE(findInRange(u8(buf), 0, 60, 4, LaneType::F32, RangeOp::Between, l, h, lvl), 8);
+            // Every zero float is Less than 1.0.
+            QCOMPARE(findInRange(u8(buf), 0, 60, 4, LaneType::F32, RangeOp::Less, l, h, lvl), 0);
+        }
+    }
+};
+
+QTEST_MAIN(TestScanKernels)
+#include "test_scankernels.moc"
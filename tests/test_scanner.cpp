@@ -9,6 +9,8 @@
 #include <QJsonObject>
 #include <cstring>
 #include <cmath>
+#include <algorithm>
+#include <thread>
 #include "scanner.h"
 #include "providers/provider.h"
 #include "providers/buffer_provider.h"
@@ -33,6 +35,19 @@ public:
     QVector<MemoryRegion> enumerateRegions() const override { return m_regions; }
 };
 
+// Region provider with one page that never reads, like a guard page.
+class HoleProvider : public RegionProvider {
+    uint64_t m_hole;
+public:
+    HoleProvider(QByteArray data, QVector<MemoryRegion> regions, uint64_t hole)
+        : RegionProvider(std::move(data), std::move(regions)), m_hole(hole) {}
+
+    bool read(uint64_t addr, void* buf, int len) const override {
+        if (addr < m_hole + 4096 && addr + len > m_hole) return false;
+        return RegionProvider::read(addr, buf, len);
+    }
+};
+
 class TestScanner : public QObject {
     Q_OBJECT
 
@@ -486,6 +501,62 @@ private slots:
         QCOMPARE(results.size(), 10); // capped at maxResults
     }
 
+    void scan_multiChunkOrdered() {
+        // 3 x 5 MB regions -> several 2 MB chunks each, so workers finish
+        // out of order. Results must still come back in address order,
+        // including a hit straddling the first chunk boundary.
+        const int regSize = 5 * 1024 * 1024;
+        QByteArray data(3 * regSize, '\0');
+        const QByteArray sig("\xDE\xAD\xBE\xEF", 4);
+        QVector<uint64_t> expected;
+        for (uint64_t a = 0x1000; a + 4 <= (uint64_t)data.size(); a += 0x40000)
+            expected.append(a);
+        expected.append(2 * 1024 * 1024 - 2);   // straddles chunk 0 / chunk 1
+        std::sort(expected.begin(), expected.end());
+        for (uint64_t a : expected)
+            memcpy(data.data() + a, sig.constData(), 4);
+
+        QVector<MemoryRegion> regions;
+        for (int i = 0; i < 3; ++i)
+            regions.push_back(MemoryRegion{(uint64_t)i * regSize, (uint64_t)regSize,
+                                           true, true, false, "heap"});
+        auto prov = std::make_shared<RegionProvider>(data, regions);
+
+        ScanEngine engine;
+        QSignalSpy finSpy(&engine, &ScanEngine::finished);
+        ScanRequest req;
+        req.pattern = sig;
+        req.mask    = QByteArray(4, '\xFF');
+        engine.start(prov, req);
+        QVERIFY(finSpy.wait(10000));
+
+        auto results = finSpy.first().first().value<QVector<ScanResult>>();
+        QCOMPARE(results.size(), expected.size());
+        for (int i = 0; i < results.size(); ++i)
+            QCOMPARE(results[i].address, expected[i]);
+    }
+
+    void scan_multiChunkMaxResultsKeepsLowest() {
+        // Every byte matches across 8 MB: the cap must keep the first
+        // maxResults addresses even though later chunks race ahead.
+        QByteArray data(8 * 1024 * 1024, '\xAA');
+        auto prov = std::make_shared<BufferProvider>(data);
+
+        ScanEngine engine;
+        QSignalSpy finSpy(&engine, &ScanEngine::finished);
+        ScanRequest req;
+        req.pattern = QByteArray("\xAA", 1);
+        req.mask    = QByteArray("\xFF", 1);
+        req.maxResults = 1000;
+        engine.start(prov, req);
+        QVERIFY(finSpy.wait(10000));
+
+        auto results = finSpy.first().first().value<QVector<ScanResult>>();
+        QCOMPARE(results.size(), 1000);
+        QCOMPARE(results.first().address, (uint64_t)0);
+        QCOMPARE(results.last().address, (uint64_t)999);
+    }
+
     void scan_emptyProvider() {
         auto prov = std::make_shared<NullProvider>();
         ScanEngine engine;
@@ -2794,6 +2865,372 @@ private slots:
         QCOMPARE(out.size(), 0);
     }
 
+    // ── Multi-span rescan: workers + prefetch keep order and values ──
+
+    void rescan_changedAcrossManySpans() {
+        // 4 MB of Int32 slots = 16 spans of 256 KB. Every 3rd slot changes
+        // after the seed; Changed must keep exactly those, in seed order,
+        // with previousValue/scanValue rolled forward.
+        const int slots = 1024 * 1024;
+        QByteArray data(slots * 4, '\0');
+        QVector<ScanResult> seed;
+        seed.reserve(slots / 4);
+        for (int s = slots - 4; s >= 0; s -= 4) {   // descending: rescan must sort
+            ScanResult r;
+            r.address = (uint64_t)s * 4;
+            r.scanValue = QByteArray(4, '\0');
+            seed.append(r);
+        }
+        for (const auto& r : seed) {
+            if ((r.address / 16) % 3 == 0) {
+                int32_t v = (int32_t)r.address + 1;
+                memcpy(data.data() + r.address, &v, 4);
+            }
+        }
+        auto prov = std::make_shared<BufferProvider>(data, "x");
+        ScanEngine eng;
+        auto out = syncRescan(eng, prov, seed, 4, ScanCondition::Changed,
+                              ValueType::Int32, {}, {}, {}, 20000);
+
+        QVector<uint64_t> expected;
+        for (const auto& r : seed)
+            if ((r.address / 16) % 3 == 0) expected.append(r.address);
+        QCOMPARE(out.size(), expected.size());
+        for (int i = 0; i < out.size(); ++i) {
+            QCOMPARE(out[i].address, expected[i]);
+            int32_t now;
+            memcpy(&now, out[i].scanValue.constData(), 4);
+            QCOMPARE(now, (int32_t)out[i].address + 1);
+            QCOMPARE(out[i].previousValue, QByteArray(4, '\0'));
+        }
+    }
+
+    void rescan_noFilterRefreshesEveryValue() {
+        // No condition filter: every result survives, values refreshed,
+        // unchanged ones still compare equal to previousValue.
+        QByteArray data(600 * 1024, '\x11');
+        for (int off = 0; off < data.size(); off += 4096)
+            data[off] = '\x22';
+        QVector<ScanResult> seed;
+        for (int off = 0; off < data.size(); off += 1024) {
+            ScanResult r;
+            r.address = (uint64_t)off;
+            r.scanValue = QByteArray(2, '\x11');
+            seed.append(r);
+        }
+        auto prov = std::make_shared<BufferProvider>(data, "x");
+        ScanEngine eng;
+        auto out = syncRescan(eng, prov, seed, 2, ScanCondition::UnknownValue,
+                              ValueType::Int16);
+        QCOMPARE(out.size(), seed.size());
+        for (int i = 0; i < out.size(); ++i) {
+            QCOMPARE(out[i].address, seed[i].address);
+            QCOMPARE(out[i].previousValue, QByteArray(2, '\x11'));
+            QCOMPARE(out[i].scanValue,
+                     out[i].address % 4096 == 0 ? QByteArray("\x22\x11", 2)
+                                                : QByteArray(2, '\x11'));
+        }
+    }
+
+    // ── Columnar result store ──
+
+    void store_columnsAndLazyRows() {
+        ScanResultStore s(4);
+        const int game = s.internRegion("game.exe", 0x1000);
+        QCOMPARE(s.internRegion("game.exe", 0x1000), game);   // interned once
+        QCOMPARE(s.internRegion("", 0x5000), -1);             // unnamed: no entry
+        s.append(0x1010, "\x01\x00\x00\x00", 4, game);
+        s.append(0x1020, "\x02\x00\x00\x00", 4, game);
+        s.append(0x9000, "\x03\x00", 2);                      // short value, no module
+        s.append(0x1030, "\x04\x00\x00\x00", 4, game);
+
+        QCOMPARE(s.size(), 4);
+        QCOMPARE(s.valueWidth(), 4);
+        QVERIFY(!s.hasPrevious());
+        QCOMPARE(s.address(1), (uint64_t)0x1020);
+        QCOMPARE(s.regionModule(0), QStringLiteral("game.exe+0x10"));
+        QCOMPARE(s.regionModule(2), QString());
+        QCOMPARE(s.regionModule(3), QStringLiteral("game.exe+0x30"));
+        QCOMPARE(s.value(2), QByteArray("\x03\x00", 2));
+        QCOMPARE(s.value(3), QByteArray("\x04\x00\x00\x00", 4));
+
+        // Rows built on demand carry the same fields a ScanResult had.
+        ScanResult r = s[1];
+        QCOMPARE(r.address, (uint64_t)0x1020);
+        QCOMPARE(r.regionModule, QStringLiteral("game.exe+0x20"));
+        QCOMPARE(r.scanValue, QByteArray("\x02\x00\x00\x00", 4));
+        int rows = 0;
+        for (const auto& row : s) { QCOMPARE(row.address, s.address(rows)); ++rows; }
+        QCOMPARE(rows, 4);
+
+        // Copies share until written.
+        ScanResultStore snapshot = s;
+        const char keep[] = {1, 0, 1, 1};
+        s.compact(keep);
+        QCOMPARE(s.size(), 3);
+        QCOMPARE(snapshot.size(), 4);
+        QCOMPARE(s.address(1), (uint64_t)0x9000);
+        QCOMPARE(s.regionModule(1), QString());
+        QCOMPARE(s.regionModule(2), QStringLiteral("game.exe+0x30"));
+        QCOMPARE(snapshot.regionModule(1), QStringLiteral("game.exe+0x20"));
+
+        // Hand-built rows round-trip, including a free-form module label.
+        QVector<ScanResult> rowsIn(2);
+        rowsIn[0].address = 0x2004;
+        rowsIn[0].scanValue = QByteArray("\xAA\xBB", 2);
+        rowsIn[0].previousValue = QByteArray("\xCC", 1);
+        rowsIn[0].regionModule = "lib.so+0x4";
+        rowsIn[1].address = 0x10;
+        rowsIn[1].scanValue = QByteArray(8, '\x7F');
+        rowsIn[1].regionModule = "custom label";
+        rowsIn[1].matchScore = 90;
+        const QVector<ScanResult> rowsOut = ScanResultStore::fromVector(rowsIn).toVector();
+        QCOMPARE(rowsOut.size(), 2);
+        for (int i = 0; i < 2; ++i) {
+            QCOMPARE(rowsOut[i].address, rowsIn[i].address);
+            QCOMPARE(rowsOut[i].scanValue, rowsIn[i].scanValue);
+            QCOMPARE(rowsOut[i].previousValue, rowsIn[i].previousValue);
+            QCOMPARE(rowsOut[i].regionModule, rowsIn[i].regionModule);
+            QCOMPARE(rowsOut[i].matchScore, rowsIn[i].matchScore);
+        }
+    }
+
+    void store_unknownCaptureStaysCompact() {
+        // 1M Int32 captures in one named module: 12 bytes a hit in the
+        // columns, one region entry, module label still per-address.
+        const int n = 1024 * 1024;
+        QVector<MemoryRegion> regs;
+        regs.push_back(MemoryRegion{0, (uint64_t)n * 4, true, true, false, "game.exe",
+                                    RegionType::Private});
+        auto prov = std::make_shared<RegionProvider>(QByteArray(n * 4, '\0'), regs);
+        ScanRequest req;
+        req.condition = ScanCondition::UnknownValue;
+        req.valueSize = 4;
+        req.alignment = 4;
+        req.maxResults = n;
+
+        ScanEngine eng;
+        QSignalSpy ready(&eng, &ScanEngine::resultsReady);
+        eng.start(prov, req);
+        QVERIFY(ready.wait(20000));
+        const auto store = ready.first().first().value<ScanResultStore>();
+        QCOMPARE(store.size(), n);
+        QVERIFY(store.columnBytes() < (size_t)n * 16);
+        QCOMPARE(store.address(n - 1), (uint64_t)(n - 1) * 4);
+        QCOMPARE(store.regionModule(n - 1), QStringLiteral("game.exe+0x%1").arg((n - 1) * 4, 0, 16));
+
+        // Rescan the store directly; survivors gain a previous column.
+        int32_t v = 7;
+        QVERIFY(prov->write(4096, &v, 4));
+        QSignalSpy rescanned(&eng, &ScanEngine::rescanResultsReady);
+        eng.startRescan(prov, store, 4, ScanCondition::Changed, ValueType::Int32);
+        QVERIFY(rescanned.wait(20000));
+        const auto changed = rescanned.first().first().value<ScanResultStore>();
+        QCOMPARE(changed.size(), 1);
+        QCOMPARE(changed.address(0), (uint64_t)4096);
+        QCOMPARE(changed.value(0), QByteArray("\x07\x00\x00\x00", 4));
+        QCOMPARE(changed.previousValue(0), QByteArray(4, '\0'));
+        QCOMPARE(changed.regionModule(0), QStringLiteral("game.exe+0x1000"));
+        QCOMPARE(store.size(), n);   // the caller's copy is untouched
+    }
+
+    void snapshot_unknownCaptureNarrowsToList() {
+        // 1M slots over a 1000-candidate threshold: the first scan keeps a
+        // snapshot, rescans narrow it, and the set turns into rows once
+        // fewer than 1000 survive.
+        const int n = 1024 * 1024;
+        QVector<MemoryRegion> regs;
+        regs.push_back(MemoryRegion{0, (uint64_t)n * 4, true, true, false, "game.exe",
+                                    RegionType::Private});
+        auto prov = std::make_shared<RegionProvider>(QByteArray(n * 4, '\0'), regs);
+        ScanRequest req;
+        req.condition = ScanCondition::UnknownValue;
+        req.valueSize = 4;
+        req.alignment = 4;
+        req.maxResults = 1000;          // ignored once snapshotted
+        req.snapshotThreshold = 1000;
+
+        ScanEngine eng;
+        QSignalSpy ready(&eng, &ScanEngine::resultsReady);
+        eng.start(prov, req);
+        QVERIFY(ready.wait(20000));
+        const auto captured = ready.first().first().value<ScanResultStore>();
+        QVERIFY(captured.isSnapshot());
+        QCOMPARE(captured.candidateCount(), (qint64)n);
+        QCOMPARE(captured.size(), 0);
+        QVERIFY(!captured.isEmpty());
+
+        // Three values move: Unchanged keeps the rest in a sparse snapshot.
+        const int32_t moved = 5;
+        for (uint64_t a : {uint64_t(16), uint64_t(4096), uint64_t(n * 4 - 4)})
+            QVERIFY(prov->write(a, &moved, 4));
+        QSignalSpy rescanned(&eng, &ScanEngine::rescanResultsReady);
+        eng.startRescan(prov, captured, 4, ScanCondition::Unchanged, ValueType::Int32);
+        QVERIFY(rescanned.wait(20000));
+        const auto unchanged = rescanned.takeFirst().first().value<ScanResultStore>();
+        QVERIFY(unchanged.isSnapshot());
+        QCOMPARE(unchanged.candidateCount(), (qint64)n - 3);
+
+        // Changed against the capture lists the three movers with both bytes.
+        eng.startRescan(prov, captured, 4, ScanCondition::Changed, ValueType::Int32);
+        QVERIFY(rescanned.wait(20000));
+        const auto changed = rescanned.takeFirst().first().value<ScanResultStore>();
+        QVERIFY(!changed.isSnapshot());
+        QCOMPARE(changed.size(), 3);
+        QCOMPARE(changed.address(0), (uint64_t)16);
+        QCOMPARE(changed.address(2), (uint64_t)n * 4 - 4);
+        QCOMPARE(changed.value(1), QByteArray("\x05\x00\x00\x00", 4));
+        QCOMPARE(changed.previousValue(1), QByteArray(4, '\0'));
+        QCOMPARE(changed.regionModule(1), QStringLiteral("game.exe+0x1000"));
+
+        // Against the sparse snapshot only bitmap survivors are considered:
+        // the earlier movers stay out even though they change again.
+        const int32_t again = 9;
+        QVERIFY(prov->write(16, &again, 4));
+        QVERIFY(prov->write(8192, &again, 4));
+        eng.startRescan(prov, unchanged, 4, ScanCondition::Changed, ValueType::Int32);
+        QVERIFY(rescanned.wait(20000));
+        const auto narrowed = rescanned.takeFirst().first().value<ScanResultStore>();
+        QCOMPARE(narrowed.size(), 1);
+        QCOMPARE(narrowed.address(0), (uint64_t)8192);
+        QCOMPARE(narrowed.value(0), QByteArray("\x09\x00\x00\x00", 4));
+        QCOMPARE(narrowed.previousValue(0), QByteArray(4, '\0'));
+    }
+
+    void snapshot_partialChunkKeepsReadablePages() {
+        // Three pages, the middle one unreadable: the capture keeps the
+        // outer pages and counts only the hole as failed, and rescans drop
+        // the slots on the hole instead of comparing zeros.
+        QVector<MemoryRegion> regs;
+        regs.push_back(MemoryRegion{0, 3 * 4096, true, true, false, "game.exe",
+                                    RegionType::Private});
+        auto prov = std::make_shared<HoleProvider>(QByteArray(3 * 4096, '\0'), regs, 4096);
+        const int32_t seven = 7;
+        QVERIFY(prov->write(8, &seven, 4));
+        ScanRequest req;
+        req.condition = ScanCondition::UnknownValue;
+        req.valueSize = 4;
+        req.alignment = 4;
+        req.snapshotThreshold = 16;
+
+        ScanEngine eng;
+        QSignalSpy stats(&eng, &ScanEngine::scanStats);
+        QSignalSpy ready(&eng, &ScanEngine::resultsReady);
+        eng.start(prov, req);
+        QVERIFY(ready.wait(20000));
+        const auto captured = ready.first().first().value<ScanResultStore>();
+        QVERIFY(captured.isSnapshot());
+        QTRY_COMPARE(stats.size(), 1);
+        QCOMPARE(stats.takeFirst().first().value<ScanStats>().bytesFailed, (uint64_t)4096);
+
+        QSignalSpy rescanned(&eng, &ScanEngine::rescanResultsReady);
+        eng.startRescan(prov, captured, 4, ScanCondition::Unchanged, ValueType::Int32);
+        QVERIFY(rescanned.wait(20000));
+        const auto unchanged = rescanned.takeFirst().first().value<ScanResultStore>();
+        QCOMPARE(unchanged.candidateCount(), (qint64)2 * 1024);
+        QTRY_COMPARE(stats.size(), 1);
+        QCOMPARE(stats.takeFirst().first().value<ScanStats>().bytesFailed, (uint64_t)4096);
+
+        // The page before the hole was captured, not zeroed with it.
+        const int32_t nine = 9;
+        QVERIFY(prov->write(8, &nine, 4));
+        eng.startRescan(prov, unchanged, 4, ScanCondition::Changed, ValueType::Int32);
+        QVERIFY(rescanned.wait(20000));
+        const auto changed = rescanned.takeFirst().first().value<ScanResultStore>();
+        QCOMPARE(changed.size(), 1);
+        QCOMPARE(changed.address(0), (uint64_t)8);
+        QCOMPARE(changed.previousValue(0), QByteArray("\x07\x00\x00\x00", 4));
+    }
+
+    // ── Streamed first-scan batches ──
+
+    void spscRing_fifoFullAndRoundsUp() {
+        SpscRing<int> ring(3);
+        QCOMPARE(ring.capacity(), (size_t)4);
+        for (int i = 0; i < 4; ++i) QVERIFY(ring.push(int(i)));
+        QVERIFY(ring.isFull());
+        QVERIFY(!ring.push(99));
+        int v = -1;
+        for (int i = 0; i < 4; ++i) {
+            QVERIFY(ring.pop(v));
+            QCOMPARE(v, i);
+        }
+        QVERIFY(!ring.pop(v));
+        QCOMPARE(ring.size(), (size_t)0);
+    }
+
+    void spscRing_crossThreadKeepsOrder() {
+        const int n = 200000;
+        SpscRing<int> ring(64);
+        std::thread producer([&ring]() {
+            for (int i = 0; i < n; ++i)
+                while (!ring.push(int(i))) std::this_thread::yield();
+        });
+        int expect = 0, v = 0;
+        while (expect < n) {
+            if (!ring.pop(v)) { std::this_thread::yield(); continue; }
+            if (v != expect) break;
+            ++expect;
+        }
+        producer.join();
+        QCOMPARE(expect, n);
+    }
+
+    void stream_batchesConcatenateToFinalResults() {
+        // Every byte matches across 8 MB of chunks that finish out of order.
+        // The batches must arrive before resultsReady and, strung together,
+        // be exactly the final list — same rows, same order.
+        QByteArray data(8 * 1024 * 1024, '\xAA');
+        auto prov = std::make_shared<BufferProvider>(data);
+
+        ScanEngine engine;
+        ScanResultStore streamed;
+        int batches = 0;
+        bool lateBatch = false;
+        bool ready = false;
+        connect(&engine, &ScanEngine::partialResults, this,
+                [&](const ScanResultStore& b) {
+            lateBatch |= ready;
+            if (batches++ == 0) streamed = b;
+            else streamed.append(b, 0, b.size());
+        });
+        QSignalSpy readySpy(&engine, &ScanEngine::resultsReady);
+        connect(&engine, &ScanEngine::resultsReady, this, [&]() { ready = true; });
+
+        ScanRequest req;
+        req.pattern = QByteArray("\xAA", 1);
+        req.mask    = QByteArray("\xFF", 1);
+        req.maxResults = 300000;
+        req.streamBatchRows = 10000;
+        req.streamQueueDepth = 2;          // tiny ring: workers must wait
+        req.streamBlockWhenFull = true;
+        engine.start(prov, req);
+        QVERIFY(readySpy.wait(20000));
+
+        const auto all = readySpy.first().first().value<ScanResultStore>();
+        QCOMPARE(all.size(), 300000);
+        QVERIFY(batches > 1);
+        QVERIFY(!lateBatch);
+        QCOMPARE(streamed.size(), all.size());
+        for (int i = 0; i < all.size(); i += 997)
+            QCOMPARE(streamed.address(i), all.address(i));
+        QCOMPARE(streamed.address(all.size() - 1), (uint64_t)299999);
+    }
+
+    void stream_offByDefault() {
+        QByteArray data(64 * 1024, '\xAA');
+        auto prov = std::make_shared<BufferProvider>(data);
+        ScanEngine engine;
+        QSignalSpy partial(&engine, &ScanEngine::partialResults);
+        QSignalSpy readySpy(&engine, &ScanEngine::resultsReady);
+        ScanRequest req;
+        req.pattern = QByteArray("\xAA", 1);
+        req.mask    = QByteArray("\xFF", 1);
+        engine.start(prov, req);
+        QVERIFY(readySpy.wait(10000));
+        QCOMPARE(partial.count(), 0);
+    }
+
     // ── Save/load result list round-trip ──
     // Direct test of the JSON serialization helpers exposed from ScannerPanel.
     // We can't pull in the full panel without Widgets, but we can exercise the
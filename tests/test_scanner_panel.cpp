@@ -6,10 +6,13 @@
 // don't reintroduce that hang.
 #include <QtTest/QTest>
 #include <QApplication>
-#include <QTableWidget>
+#include <QTableView>
 #include <QLineEdit>
 #include <QPushButton>
 #include <QTemporaryFile>
+#include <QSignalSpy>
+#include <QElapsedTimer>
+#include <cstring>
 #include <memory>
 #include "scannerpanel.h"
 #include "themes/thememanager.h"
@@ -45,11 +48,11 @@ private slots:
         QVERIFY(loadOneRow(panel, f));
 
         auto* tbl = panel.resultsTable();
-        QVERIFY(tbl->rowCount() >= 1);
-        QTableWidgetItem* valItem = tbl->item(0, 1);
-        QVERIFY(valItem);
+        QVERIFY(tbl->model()->rowCount() >= 1);
+        const QModelIndex valItem = tbl->model()->index(0, 1);
+        QVERIFY(valItem.isValid());
         // Sanity: the cell DISPLAY is right-aligned for a value-mode scan.
-        QVERIFY(valItem->textAlignment() & Qt::AlignRight);
+        QVERIFY(valItem.data(Qt::TextAlignmentRole).toInt() & Qt::AlignRight);
 
         // The editor must match — this is what AlignedEditorDelegate guarantees.
         tbl->openPersistentEditor(valItem);
@@ -205,19 +208,15 @@ private slots:
         f.flush();
         QVERIFY(panel.loadResultsFrom(f.fileName()));
         auto* tbl = panel.resultsTable();
-        QCOMPARE(tbl->rowCount(), 2);
+        QCOMPARE(tbl->model()->rowCount(), 2);
 
         auto applyFilter = [&](const QString& text) {
             panel.resultFilter()->setText(text);  // applyResultFilter reads this
             QVERIFY(QMetaObject::invokeMethod(&panel, "onResultFilterChanged",
                         Qt::DirectConnection, Q_ARG(QString, text)));
         };
-        auto visibleRows = [&]() {
-            int n = 0;
-            for (int i = 0; i < tbl->rowCount(); ++i)
-                if (!tbl->isRowHidden(i)) ++n;
-            return n;
-        };
+        // The model drops filtered-out rows rather than hiding them.
+        auto visibleRows = [&]() { return tbl->model()->rowCount(); };
 
         applyFilter(QStringLiteral("engine"));   // matches engine.dll only
         QCOMPARE(visibleRows(), 1);
@@ -225,6 +224,101 @@ private slots:
         QCOMPARE(visibleRows(), 2);
     }
 
+    // Functional: header sorts are typed, not textual — Int32 values order
+    // 7 < 42 < 100 (a string sort gives "100" < "42" < "7"), and section -1
+    // puts the rows back in scan order. UserRole maps each row to its result.
+    void testResultSortIsTypedAndReversible() {
+        ScannerPanel panel;
+        QTemporaryFile f;
+        QVERIFY(f.open());
+        f.write("{\"version\":1,\"scanMode\":1,\"valueType\":2,\"results\":["
+                "{\"address\":\"1000\",\"value\":\"64000000\"},"
+                "{\"address\":\"2000\",\"value\":\"07000000\"},"
+                "{\"address\":\"3000\",\"value\":\"2a000000\"}]}");
+        f.flush();
+        QVERIFY(panel.loadResultsFrom(f.fileName()));
+        auto* model = panel.resultsTable()->model();
+        auto valueAt = [&](int row) { return model->index(row, 1).data().toString(); };
+        auto resultAt = [&](int row) { return model->index(row, 0).data(Qt::UserRole).toInt(); };
+
+        model->sort(1, Qt::AscendingOrder);
+        QCOMPARE(valueAt(0), QStringLiteral("7"));
+        QCOMPARE(valueAt(1), QStringLiteral("42"));
+        QCOMPARE(valueAt(2), QStringLiteral("100"));
+        QCOMPARE(resultAt(0), 1);
+
+        model->sort(0, Qt::DescendingOrder);
+        QCOMPARE(resultAt(0), 2);
+        QCOMPARE(resultAt(2), 0);
+
+        model->sort(-1);
+        for (int row = 0; row < 3; ++row)
+            QCOMPARE(resultAt(row), row);
+    }
+
+    // Timing guard for the lazy result model: populating a million rows
+    // formats only what is painted, and sorting permutes indices only.
+    void bench_model1MRowsPopulateAndSort() {
+        // 1M Int32 results with values falling as addresses rise, so both a
+        // value sort and a descending address sort reverse the whole set.
+        constexpr int kRows = 1000000;
+        ScanResultStore store(4);
+        store.reserve(kRows);
+        for (int i = 0; i < kRows; i++) {
+            const int32_t v = kRows - i;
+            store.append(0x10000000ull + (uint64_t)i * 4,
+                         reinterpret_cast<const char*>(&v), 4);
+        }
+        ScanResultModel resultModel(&store, [](const QByteArray& b) {
+            int32_t v = 0;
+            std::memcpy(&v, b.constData(), 4);
+            return QString::number(v);
+        });
+        QTableView view;
+        view.setModel(&resultModel);
+        view.resize(400, 600);
+        view.show();
+
+        QElapsedTimer t;
+        t.start();
+        resultModel.resetRows(ValueType::Int32, true, false, false);
+        QApplication::processEvents();   // first paint formats only the visible rows
+        const qint64 populateMs = t.elapsed();
+        QCOMPARE(resultModel.rowCount(), kRows);
+
+        t.restart();
+        resultModel.sort(1, Qt::AscendingOrder);
+        const qint64 valueSortMs = t.elapsed();
+        QCOMPARE(resultModel.index(0, 1).data().toString(), QStringLiteral("1"));
+        QCOMPARE(resultModel.resultIndex(0), kRows - 1);
+        QCOMPARE(resultModel.index(kRows - 1, 1).data().toString(), QString::number(kRows));
+
+        t.restart();
+        resultModel.sort(0, Qt::DescendingOrder);
+        const qint64 addressSortMs = t.elapsed();
+        QCOMPARE(resultModel.resultIndex(0), kRows - 1);
+        QCOMPARE(resultModel.resultIndex(kRows - 1), 0);
+
+        // refreshResult under a sort finds the row by index, not by a scan
+        // of the row map per call.
+        QSignalSpy changed(&resultModel, &QAbstractItemModel::dataChanged);
+        t.restart();
+        for (int i = 0; i < 10000; i++) resultModel.refreshResult(i * 100);
+        const qint64 refreshMs = t.elapsed();
+        QCOMPARE(changed.size(), 10000);
+        QCOMPARE(changed.last().first().toModelIndex().row(), kRows - 1 - 9999 * 100);
+
+        resultModel.sort(-1);
+        QCOMPARE(resultModel.resultIndex(12345), 12345);
+
+        qDebug() << "[bench] 1M rows: populate" << populateMs << "ms, value sort"
+                 << valueSortMs << "ms, address sort" << addressSortMs << "ms, 10k refreshes" << refreshMs << "ms";
+        QVERIFY2(populateMs < 1000, qPrintable(QString("populate took %1 ms").arg(populateMs)));
+        QVERIFY2(valueSortMs < 5000, qPrintable(QString("value sort took %1 ms").arg(valueSortMs)));
+        QVERIFY2(addressSortMs < 5000, qPrintable(QString("address sort took %1 ms").arg(addressSortMs)));
+        QVERIFY2(refreshMs < 1000, qPrintable(QString("10k refreshes took %1 ms").arg(refreshMs)));
+    }
+
     // Regression: clicking the SCAN FOR header toggles the collapse state, which
     // is reflected in the header's chevron (▾ expanded / ▸ collapsed).
     void testScanForHeaderTogglesChevron() {
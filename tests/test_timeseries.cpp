@@ -0,0 +1,287 @@
+#include <QTest>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QFileInfo>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include "timeseries.h"
+#include "providers/buffer_provider.h"
+
+using namespace rcx;
+
+class TestTimeSeries : public QObject {
+    Q_OBJECT
+
+    QTemporaryDir m_dir;
+
+    QString path(const char* name) const { return m_dir.filePath(QLatin1String(name)); }
+
+    static QVector<SeriesColumn> mixedColumns() {
+        return {
+            {1, QStringLiteral("health"),  SeriesEncoding::Signed,   4},
+            {2, QStringLiteral("ptr"),     SeriesEncoding::Unsigned, 8},
+            {3, QStringLiteral("speed"),   SeriesEncoding::Float,    4},
+            {4, QStringLiteral("tag"),     SeriesEncoding::Raw,      3},
+            {5, QStringLiteral("flags"),   SeriesEncoding::Signed,   1},
+        };
+    }
+
+    // Deterministic row i for mixedColumns(): values that cross sign,
+    // wrap the full u64 range and repeat, so every delta path is hit.
+    static void fillRow(int i, uint8_t* row) {
+        int32_t  health = (i % 7) - 3 - i;
+        uint64_t ptr    = (i % 3 == 0) ? ~uint64_t(0) - i : uint64_t(i) * 1000003u;
+        float    speed  = i * 0.5f;
+        uint8_t  tag[3] = {uint8_t(i), uint8_t(i >> 8), 7};
+        int8_t   flags  = int8_t(i);
+        memcpy(row, &health, 4);
+        memcpy(row + 4, &ptr, 8);
+        memcpy(row + 12, &speed, 4);
+        memcpy(row + 16, tag, 3);
+        memcpy(row + 19, &flags, 1);
+    }
+
+    static constexpr qint64 kT0 = 1700000000000000LL;
+    static constexpr qint64 kStepUs = 2500;   // 400 Hz
+
+    void writeMixed(const QString& file, int rows, int flushAt = -1) {
+        SeriesWriter w;
+        QString err;
+        QVERIFY2(w.open(file, mixedColumns(), &err), qPrintable(err));
+        QCOMPARE(w.rowBytes(), 20);
+        uint8_t row[20];
+        for (int i = 0; i < rows; i++) {
+            fillRow(i, row);
+            w.append(kT0 + i * kStepUs, row);
+            if (i == flushAt) QVERIFY(w.flush());
+        }
+        w.close();
+        QCOMPARE(w.rows(), qint64(rows));
+    }
+
+private slots:
+    void initTestCase() { QVERIFY(m_dir.isValid()); }
+
+    void roundTripAcrossBlocks() {
+        const int rows = SeriesWriter::kBlockRows * 2 + 123;
+        const QString file = path("mixed.rcxts");
+        writeMixed(file, rows, 5000);   // a mid-block flush leaves a short block
+
+        SeriesReader r;
+        QString err;
+        QVERIFY2(r.open(file, &err), qPrintable(err));
+        QCOMPARE(r.rowCount(), qint64(rows));
+        QCOMPARE(r.columns().size(), 5);
+        QCOMPARE(r.columns()[2].name, QStringLiteral("speed"));
+        QCOMPARE(r.firstUs(), kT0);
+        QCOMPARE(r.lastUs(), kT0 + (rows - 1) * kStepUs);
+        QVERIFY(r.blocks().size() >= 4);
+
+        int i = 0;
+        bool same = true;
+        uint8_t expect[20];
+        QVERIFY(r.forEachRow(r.firstUs(), r.lastUs(), [&](qint64 t, const uint8_t* row) {
+            fillRow(i, expect);
+            if (t != kT0 + i * kStepUs || memcmp(row, expect, 20) != 0) same = false;
+            i++;
+            return true;
+        }));
+        QCOMPARE(i, rows);
+        QVERIFY(same);
+    }
+
+    void integersAreDeltaEncoded() {
+        // A counter stepping by one and a constant: one varint byte each
+        // per row, plus one for the fixed-cadence time delta.
+        const QString file = path("counter.rcxts");
+        const int rows = 10000;
+        {
+            SeriesWriter w;
+            QVERIFY(w.open(file, {{1, QStringLiteral("tick"), SeriesEncoding::Unsigned, 8},
+                                  {2, QStringLiteral("const"), SeriesEncoding::Signed, 4}}));
+            uint8_t row[12] = {};
+            for (int i = 0; i < rows; i++) {
+                uint64_t tick = 1000000 + i;
+                int32_t k = -5;
+                memcpy(row, &tick, 8);
+                memcpy(row + 8, &k, 4);
+                w.append(kT0 + i * kStepUs, row);
+            }
+        }
+        const qint64 size = QFileInfo(file).size();
+        QVERIFY2(size < rows * 4, qPrintable(QString::number(size)));   // raw would be 20 B/row
+    }
+
+    void rangeReadSkipsOutsideRows() {
+        const QString file = path("range.rcxts");
+        writeMixed(file, 9000);
+        SeriesReader r;
+        QVERIFY(r.open(file));
+
+        QVector<qint64> times;
+        r.forEachRow(kT0 + 4500 * kStepUs, kT0 + 4599 * kStepUs,
+                     [&](qint64 t, const uint8_t*) { times.append(t); return true; });
+        QCOMPARE(times.size(), 100);
+        QCOMPARE(times.first(), kT0 + 4500 * kStepUs);
+        QCOMPARE(times.last(), kT0 + 4599 * kStepUs);
+
+        // fn returning false stops the walk.
+        int seen = 0;
+        r.forEachRow(r.firstUs(), r.lastUs(), [&](qint64, const uint8_t*) { return ++seen < 10; });
+        QCOMPARE(seen, 10);
+    }
+
+    void numericValueDecodesEveryEncoding() {
+        const QString file = path("numeric.rcxts");
+        writeMixed(file, 16);
+        SeriesReader r;
+        QVERIFY(r.open(file));
+        int i = 0;
+        r.forEachRow(r.firstUs(), r.lastUs(), [&](qint64, const uint8_t* row) {
+            int32_t health = (i % 7) - 3 - i;
+            QCOMPARE(r.numericValue(0, row), double(health));
+            QCOMPARE(r.numericValue(2, row), double(i * 0.5f));
+            QCOMPARE(r.numericValue(4, row), double(int8_t(i)));
+            QVERIFY(std::isnan(r.numericValue(3, row)));
+            i++;
+            return true;
+        });
+        QCOMPARE(i, 16);
+    }
+
+    void downsampleBucketsCoverEveryRow() {
+        const QString file = path("down.rcxts");
+        const int rows = 10000;
+        writeMixed(file, rows);
+        SeriesReader r;
+        QVERIFY(r.open(file));
+
+        auto buckets = downsampleSeries(r, 2, r.firstUs(), r.lastUs(), 10);
+        QCOMPARE(buckets.size(), 10);
+        int total = 0;
+        for (const auto& b : buckets) {
+            total += b.count;
+            QVERIFY(b.min <= b.last && b.last <= b.max);
+        }
+        QCOMPARE(total, rows);
+        QCOMPARE(buckets.first().min, 0.0);
+        QCOMPARE(buckets.last().max, (rows - 1) * 0.5);
+        QCOMPARE(buckets.last().lastUs, r.lastUs());
+    }
+
+    void tornTrailingBlockIsIgnored() {
+        const QString file = path("torn.rcxts");
+        writeMixed(file, SeriesWriter::kBlockRows + 10);
+        QFile f(file);
+        QVERIFY(f.open(QIODevice::ReadWrite));
+        QVERIFY(f.resize(f.size() - 3));
+        f.close();
+
+        SeriesReader r;
+        QVERIFY(r.open(file));
+        QCOMPARE(r.rowCount(), qint64(SeriesWriter::kBlockRows));
+    }
+
+    void exportCsvWritesHeaderAndRows() {
+        const QString file = path("csv.rcxts");
+        writeMixed(file, 3);
+        SeriesReader r;
+        QVERIFY(r.open(file));
+        const QString csv = path("out.csv");
+        QVERIFY(exportSeriesCsv(r, csv, r.firstUs(), r.lastUs()));
+
+        QFile f(csv);
+        QVERIFY(f.open(QIODevice::ReadOnly | QIODevice::Text));
+        QStringList lines = QString::fromUtf8(f.readAll()).split('\n', Qt::SkipEmptyParts);
+        QCOMPARE(lines.size(), 4);
+        QCOMPARE(lines[0], QStringLiteral("time_us,health,ptr,speed,tag,flags"));
+        QCOMPARE(lines[2], QStringLiteral("%1,-3,1000003,0.5,010007,1").arg(kT0 + kStepUs));
+    }
+
+    void rejectsMalformedColumns() {
+        SeriesWriter w;
+        QString err;
+        QVERIFY(!w.open(path("bad.rcxts"), {}, &err));
+        QVERIFY(!w.open(path("bad.rcxts"), {{1, QStringLiteral("x"), SeriesEncoding::Signed, 16}}, &err));
+        QVERIFY(!w.open(path("bad.rcxts"), {{1, QStringLiteral("x"), SeriesEncoding::Float, 2}}, &err));
+        QVERIFY(!err.isEmpty());
+    }
+
+    void recorderSamplesProviderAndSwapsBigEndian() {
+        QByteArray mem(16, '\0');
+        const uint32_t be = 0x01020304;
+        memcpy(mem.data(), &be, 4);
+        BufferProvider prov(mem);
+
+        QVector<SeriesRecorder::Field> fields;
+        SeriesRecorder::Field f;
+        f.column = {9, QStringLiteral("be"), SeriesEncoding::Unsigned, 4};
+        f.addr = 0;
+        f.bigEndian = true;
+        fields.append(f);
+        f.column = {10, QStringLiteral("unreadable"), SeriesEncoding::Unsigned, 4};
+        f.addr = 0x1000;
+        f.bigEndian = false;
+        fields.append(f);
+
+        SeriesRecorder rec;
+        const QString file = path("rec.rcxts");
+        QVERIFY(rec.start(file, fields));
+        rec.sample(prov, kT0);
+        rec.sample(prov, kT0 + 1);
+        QCOMPARE(rec.rows(), qint64(2));
+        rec.stop();
+
+        SeriesReader r;
+        QVERIFY(r.open(file));
+        QCOMPARE(r.rowCount(), qint64(2));
+        QCOMPARE(r.columnIndex(10), 1);
+        r.forEachRow(kT0, kT0 + 1, [&](qint64, const uint8_t* row) {
+            QCOMPARE(r.numericValue(0, row), double(0x04030201));
+            QCOMPARE(r.numericValue(1, row), 0.0);   // unreadable: previous (zero) sample
+            return true;
+        });
+    }
+
+    void recordThreadSamplesUntilDestroyed() {
+        QByteArray mem(8, '\0');
+        const uint32_t v = 42;
+        memcpy(mem.data(), &v, 4);
+        auto prov = std::make_shared<BufferProvider>(mem);
+
+        SeriesRecorder::Field f;
+        f.column = {1, QStringLiteral("v"), SeriesEncoding::Unsigned, 4};
+        auto rec = std::make_shared<SeriesRecorder>();
+        const QString file = path("thread.rcxts");
+        QVERIFY(rec->start(file, {f}));
+        {
+            SeriesRecordThread thread(rec, prov, 1000, kT0);
+            QTRY_VERIFY_WITH_TIMEOUT(thread.passCount() >= 5, 5000);
+        }
+        // Joined: the row count no longer moves.
+        const qint64 rows = rec->rows();
+        QVERIFY(rows >= 5);
+        QTest::qWait(20);
+        QCOMPARE(rec->rows(), rows);
+        rec->stop();
+
+        SeriesReader r;
+        QVERIFY(r.open(file));
+        QCOMPARE(r.rowCount(), rows);
+        QVector<qint64> times;
+        QVector<double> values;
+        r.forEachRow(kT0, std::numeric_limits<qint64>::max(), [&](qint64 us, const uint8_t* row) {
+            times.append(us);
+            values.append(r.numericValue(0, row));
+            return true;
+        });
+        QCOMPARE(times.size(), int(rows));
+        QVERIFY(std::is_sorted(times.begin(), times.end()));
+        QVERIFY(std::all_of(values.begin(), values.end(), [](double x) { return x == 42.0; }));
+    }
+};
+
+QTEST_MAIN(TestTimeSeries)
+#include "test_timeseries.moc"
@@ -8,7 +8,7 @@
 #include <QFont>
 #include <QPushButton>
 #include <QLineEdit>
-#include <QTableWidget>
+#include <QTableView>
 #include "scannerpanel.h"
 #include "themes/thememanager.h"
 
@@ -30,12 +30,12 @@ int main(int argc, char** argv) {
     if (arg2.endsWith(QStringLiteral(".json"))) {
         panel.loadResultsFrom(arg2);  // populate table + Reset
         auto* tbl = panel.resultsTable();
-        if (tbl->rowCount() > 0) {
+        if (tbl->model()->rowCount() > 0) {
             if (arg3 == QStringLiteral("edit")) {
                 // Open the value-cell editor inline and report its alignment —
                 // verifies AlignedEditorDelegate keeps it right-aligned
                 // (AlignRight|AlignVCenter == 0x82 == 130).
-                tbl->openPersistentEditor(tbl->item(0, 1));
+                tbl->openPersistentEditor(tbl->model()->index(0, 1));
                 app.processEvents();
                 if (auto* le = tbl->findChild<QLineEdit*>())
                     qInfo("VALUE EDITOR alignment = 0x%X (AlignRight=0x2)",